@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_alloc_policy.h"
+#include "GMS_dyn_array.h"
+#include "GMS_dyn_containers.h"
+
+/*
+    icpc -o perf_test_alloc_policy -O3 -fp-model fast=2 -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_half.h GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_fp16_bulk.h GMS_fp16_bulk.cpp \
+   GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+    GMS_dyn_array.h GMS_dyn_containers.h perf_test_alloc_policy.cpp -ltbbmalloc
+
+    Allocation churn of the dynamic containers: argv[1] frames (default 200), each of them
+    creating and destroying thousands of short-lived darray_r4_t/darray_c4_t/DC1D_r4_t/DC3D_r4_t
+    objects of mixed sizes (64 B .. 256 KiB), run under every allocation policy (ARENA: one
+    arena_frame per frame), single-threaded and by argv[2] threads (default: hardware threads),
+    the allocator counters are printed per policy.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       // mixed lengths of a frame, fixed seed
+       std::vector<std::size_t> frame_lengths(const std::size_t n)
+       {
+              std::vector<std::size_t> len(n);
+              uint64_t s{0x9E3779B97F4A7C15ull};
+              for(std::size_t __i{0ull}; __i != n; ++__i)
+              {
+                     s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+                     // mostly small, occasionally large
+                     const std::size_t sh{(s & 7ull) == 0ull ? 14ull : 6ull};
+                     len[__i] = 16ull+(s >> 40) % (std::size_t{1} << sh);
+              }
+              return (len);
+       }
+
+       float run_frame(const std::vector<std::size_t> & len)
+       {
+              using namespace gms;
+              float acc{0.0f};
+              for(std::size_t __i{0ull}; __i < len.size(); __i += 4ull)
+              {
+                     const std::size_t n{len[__i]};
+                     darray_r4_t a(n);
+                     darray_c4_t b(len[__i+1ull]);
+                     DC1D_r4_t   e(len[__i+2ull]);
+                     DC3D_r4_t   f(len[__i+3ull]/4ull+1ull,len[__i+3ull]/8ull+1ull,len[__i+3ull]/16ull+1ull);
+                     a.m_data[n-1ull] = 1.0f;
+                     b.m_data[0]      = {1.0f,0.0f};
+                     e.m_Exr[0]       = 2.0f;
+                     f.m_Ezi[0]       = 3.0f;
+                     acc += a.m_data[n-1ull]+b.m_data[0].real()+e.m_Exr[0]+f.m_Ezi[0];
+              }
+              return (acc);
+       }
+
+       double run_policy(const gms::common::alloc_policy pol,
+                         const std::vector<std::size_t> & len,
+                         const int32_t nframes,
+                         float & acc)
+       {
+              using namespace gms::common;
+              alloc_policy_scope scope(pol);
+              const auto t0{clk::now()};
+              for(int32_t __f{0}; __f != nframes; ++__f)
+              {
+                     if(pol == alloc_policy::ARENA)
+                     {
+                            arena_frame frame;
+                            acc += run_frame(len);
+                     }
+                     else
+                     {
+                            acc += run_frame(len);
+                     }
+              }
+              const auto t1{clk::now()};
+              return (std::chrono::duration<double>(t1-t0).count());
+       }
+
+}
+
+void perf_test_alloc_policy_churn(const int32_t);
+
+void perf_test_alloc_policy_churn(const int32_t nframes)
+{
+       using namespace gms::common;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       const std::vector<std::size_t> len{frame_lengths(4096ull)};
+       const double nobj{static_cast<double>(nframes)*static_cast<double>(len.size())};
+       float acc{0.0f};
+       double t_mm{0.0};
+       for(int32_t __p{0}; __p != N_ALLOC_POLICIES; ++__p)
+       {
+              const alloc_policy pol{static_cast<alloc_policy>(__p)};
+              alloc_counters_reset();
+              (void)run_policy(pol,len,1,acc); // warm-up
+              alloc_counters_reset();
+              const double dt{run_policy(pol,len,nframes,acc)};
+              if(__p == 0) t_mm = dt;
+              printf("--- %-12s: %8.3f ms, %7.1f ns/object, %5.2fx against MM_MALLOC\n",alloc_policy_name(pol),
+                     1.0e3*dt,1.0e9*dt/nobj,t_mm/dt);
+              alloc_counters_print(alloc_counters());
+              pool_trim();
+              arena_release();
+       }
+       printf("checksum: %g\n",static_cast<double>(acc));
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void perf_test_alloc_policy_churn_mt(const int32_t,const int32_t);
+
+void perf_test_alloc_policy_churn_mt(const int32_t nframes,const int32_t nthreads)
+{
+       using namespace gms::common;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       const std::vector<std::size_t> len{frame_lengths(4096ull)};
+       const double nobj{static_cast<double>(nframes)*static_cast<double>(len.size())*nthreads};
+       for(int32_t __p{0}; __p != N_ALLOC_POLICIES; ++__p)
+       {
+              const alloc_policy pol{static_cast<alloc_policy>(__p)};
+              std::vector<std::thread> team;
+              std::vector<float> acc(nthreads,0.0f);
+              const auto t0{clk::now()};
+              for(int32_t __t{0}; __t != nthreads; ++__t)
+                  team.emplace_back([&,__t]{ (void)run_policy(pol,len,nframes,acc[__t]);
+                                             pool_trim(); arena_release(); });
+              for(std::thread & th : team) th.join();
+              const double dt{std::chrono::duration<double>(clk::now()-t0).count()};
+              printf("--- %-12s, %d threads: %8.3f ms, %7.1f ns/object\n",alloc_policy_name(pol),nthreads,
+                     1.0e3*dt,1.0e9*dt/nobj);
+       }
+       printf("all threads:\n");
+       alloc_counters_print(alloc_counters_total());
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t nframes{(argc > 1) ? std::atoi(argv[1]) : 200};
+    const int32_t nthreads{(argc > 2) ? std::atoi(argv[2]) :
+                           std::max<int32_t>(1,static_cast<int32_t>(std::thread::hardware_concurrency()))};
+    perf_test_alloc_policy_churn(nframes);
+    perf_test_alloc_policy_churn_mt(nframes,nthreads);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <complex>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_par_team.h"
+#include "GMS_cmatrix4x4_batch_zmm16r4.h"
+
+/*
+    icpc -o perf_test_cmatrix4x4_batch_zmm16r4 -O3 -fp-model precise -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    -DENABLE_AVX512F GMS_config.h GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_par_team.h GMS_par_team.cpp \
+    GMS_cmatrix4x4_batch_zmm16r4.h GMS_cmatrix4x4_batch_zmm16r4.cpp perf_test_cmatrix4x4_batch_zmm16r4.cpp -lpthread
+
+    Layer transmission exp(-K*z) of argv[1] extinction matrices (default 2^20, layer x
+    angle x frequency) and the inversion of as many complex 4x4 matrices: one matrix
+    per call (std::complex<float>, the algorithms of the batch: closed-form eigen-
+    decomposition of K and Q*diag(exp)*inv(Q), Gauss-Jordan with partial pivoting)
+    against 16 matrices per call (serial and on the worker team).
+    Printed: best of 5 runs, ns per matrix and the speedup.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+       typedef std::complex<float> zf;
+
+       using namespace gms::math;
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 5; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+       void scalar_eigvec(const zf * m,const zf mu,const int32_t e,zf & u0,zf & u1)
+       {
+              const zf v0{m[1]},v1{mu-m[0]},w0{mu-m[3]},w1{m[2]};
+              const float nv{std::norm(v0)+std::norm(v1)},nw{std::norm(w0)+std::norm(w1)};
+              const float n{std::max(nv,nw)};
+              if(n <= 1.0e-30f) { u0 = (e == 0) ? 1.0f : 0.0f; u1 = (e == 0) ? 0.0f : 1.0f; return; }
+              const float r{1.0f/std::sqrt(n)};
+              u0 = ((nw > nv) ? w0 : v0)*r;
+              u1 = ((nw > nv) ? w1 : v1)*r;
+       }
+
+       // one matrix per call
+       void scalar_extinct_exp(const zf * m,const float z,float * E)
+       {
+              const zf diff{m[0]-m[3]};
+              zf r{std::sqrt(diff*diff+4.0f*m[1]*m[2])};
+              if((std::conj(diff)*r).real() < 0.0f) r = -r;
+              const zf mu[2] = {0.5f*(m[0]+m[3]+r),0.5f*(m[0]+m[3]-r)};
+              zf U[2][2];
+              scalar_eigvec(m,mu[0],0,U[0][0],U[1][0]);
+              scalar_eigvec(m,mu[1],1,U[0][1],U[1][1]);
+              const zf rd{1.0f/(U[0][0]*U[1][1]-U[0][1]*U[1][0])};
+              const zf V[2][2] = {{U[1][1]*rd,-U[0][1]*rd},{-U[1][0]*rd,U[0][0]*rd}};
+              const int32_t pa[4] = {0,1,0,1},pb[4] = {0,1,1,0};
+              zf Q[16],iQ[16];
+              for(int32_t __p{0}; __p != 4; ++__p)
+              {
+                     const int32_t a{pa[__p]},b{pb[__p]};
+                     const zf ex{std::exp((mu[a]+std::conj(mu[b]))*z)};       // exp(-l*z)
+                     const zf c01{U[0][a]*std::conj(U[1][b])},c10{U[1][a]*std::conj(U[0][b])};
+                     Q[__p]    = U[0][a]*std::conj(U[0][b])*ex;
+                     Q[4+__p]  = U[1][a]*std::conj(U[1][b])*ex;
+                     Q[8+__p]  = (c01+c10)*ex;
+                     Q[12+__p] = zf(0.0f,-1.0f)*(c01-c10)*ex;
+                     const zf p01{V[a][0]*std::conj(V[b][1])},p10{V[a][1]*std::conj(V[b][0])};
+                     iQ[4*__p]   = V[a][0]*std::conj(V[b][0]);
+                     iQ[4*__p+1] = V[a][1]*std::conj(V[b][1]);
+                     iQ[4*__p+2] = 0.5f*(p01+p10);
+                     iQ[4*__p+3] = zf(0.0f,0.5f)*(p01-p10);
+              }
+              for(int32_t __i{0}; __i != 4; ++__i)
+                     for(int32_t __j{0}; __j != 4; ++__j)
+                     {
+                            zf s{0.0f,0.0f};
+                            for(int32_t __k{0}; __k != 4; ++__k) s += Q[4*__i+__k]*iQ[4*__k+__j];
+                            E[4*__i+__j] = s.real();
+                     }
+       }
+
+       void scalar_inv(const zf * a,zf * inv)
+       {
+              zf w[16];
+              std::copy(a,a+16,w);
+              for(int32_t __i{0}; __i != 16; ++__i) inv[__i] = (__i%5 == 0) ? 1.0f : 0.0f;
+              for(int32_t __k{0}; __k != 4; ++__k)
+              {
+                     int32_t p{__k};
+                     for(int32_t __i{__k+1}; __i != 4; ++__i)
+                         if(std::abs(w[4*__i+__k].real())+std::abs(w[4*__i+__k].imag()) >
+                            std::abs(w[4*p+__k].real())+std::abs(w[4*p+__k].imag())) p = __i;
+                     for(int32_t __j{0}; __j != 4; ++__j) { std::swap(w[4*__k+__j],w[4*p+__j]); std::swap(inv[4*__k+__j],inv[4*p+__j]); }
+                     const zf r{1.0f/w[4*__k+__k]};
+                     for(int32_t __j{0}; __j != 4; ++__j) { w[4*__k+__j] *= r; inv[4*__k+__j] *= r; }
+                     for(int32_t __i{0}; __i != 4; ++__i)
+                     {
+                            if(__i == __k) continue;
+                            const zf f{w[4*__i+__k]};
+                            for(int32_t __j{0}; __j != 4; ++__j) { w[4*__i+__j] -= f*w[4*__k+__j]; inv[4*__i+__j] -= f*inv[4*__k+__j]; }
+                     }
+              }
+       }
+
+}
+
+void perf_test_cmatrix4x4_batch(const int32_t);
+
+void perf_test_cmatrix4x4_batch(const int32_t nmat)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       const int32_t nb{(nmat+15)/16};
+       const std::size_t n{static_cast<std::size_t>(nb)*16ull};
+       printf("matrices: %zu, workers: %d\n",n,gms::common::par_team_size());
+       std::mt19937 g(46);
+       std::uniform_real_distribution<float> att(-0.8f,-0.02f),ph(-1.0f,1.0f),x(-0.2f,0.2f),uz(0.0f,6.0f),u(-1.0f,1.0f);
+       std::vector<zf> ms(4ull*n),as(16ull*n),is(16ull*n);
+       std::vector<float> zs(n),Es(16ull*n);
+       std::vector<C2x2_ZMM16C4> M(nb);
+       std::vector<__m512> z(nb);
+       std::vector<R4x4_ZMM16R4> E(nb);
+       std::vector<C4x4_ZMM16C4> A(nb),I(nb);
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+       {
+              zf * m{&ms[4ull*__i]};
+              m[0] = {att(g),ph(g)}; m[1] = {x(g),x(g)}; m[2] = {x(g),x(g)}; m[3] = {att(g),ph(g)};
+              zs[__i] = uz(g);
+              for(int32_t __j{0}; __j != 16; ++__j) as[16ull*__i+__j] = {u(g),u(g)};
+              c2x2_set_lane(M[__i/16ull],static_cast<int32_t>(__i%16ull),m);
+              c4x4_set_lane(A[__i/16ull],static_cast<int32_t>(__i%16ull),&as[16ull*__i]);
+              reinterpret_cast<float*>(&z[__i/16ull])[__i%16ull] = zs[__i];
+       }
+       const double t_sexp{best_of([&]{ for(std::size_t __i{0ull}; __i != n; ++__i) scalar_extinct_exp(&ms[4ull*__i],zs[__i],&Es[16ull*__i]); })};
+       const double t_bexp{best_of([&]{ (void)extinct_exp4x4_batch(M.data(),z.data(),E.data(),nullptr,nb); })};
+       const double t_pexp{best_of([&]{ (void)extinct_exp4x4_batch_par(M.data(),z.data(),E.data(),nullptr,nb); })};
+       const double t_sinv{best_of([&]{ for(std::size_t __i{0ull}; __i != n; ++__i) scalar_inv(&as[16ull*__i],&is[16ull*__i]); })};
+       const double t_binv{best_of([&]{ (void)inv4x4_cmplx_batch(A.data(),I.data(),nullptr,nb); })};
+       const double dn{static_cast<double>(n)};
+       printf("--- exp(-K*z), scalar   : %8.2f ns/matrix\n",1.0e9*t_sexp/dn);
+       printf("--- exp(-K*z), batch    : %8.2f ns/matrix, %5.2fx\n",1.0e9*t_bexp/dn,t_sexp/t_bexp);
+       printf("--- exp(-K*z), team     : %8.2f ns/matrix, %5.2fx\n",1.0e9*t_pexp/dn,t_sexp/t_pexp);
+       printf("--- inverse, scalar     : %8.2f ns/matrix\n",1.0e9*t_sinv/dn);
+       printf("--- inverse, batch      : %8.2f ns/matrix, %5.2fx\n",1.0e9*t_binv/dn,t_sinv/t_binv);
+       double d{0.0};
+       for(std::size_t __i{0ull}; __i < n; __i += 997ull)
+              for(int32_t __j{0}; __j != 16; ++__j)
+                     d = std::max(d,static_cast<double>(std::abs(Es[16ull*__i+__j]-
+                                  reinterpret_cast<const float*>(&E[__i/16ull].m[__j])[__i%16ull])));
+       printf("max. |scalar-batch| of exp(-K*z) (sampled): %g\n",d);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t n{(argc > 1) ? std::atoi(argv[1]) : (1 << 20)};
+    perf_test_cmatrix4x4_batch(n);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_cpu_perf_online_analysis.h"
+
+/*
+    icpc -o perf_test_cpu_perf_online_analysis -O3 -fp-model precise -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    GMS_config.h GMS_cpu_perf_online_analysis.h GMS_cpu_perf_online_analysis.cpp perf_test_cpu_perf_online_analysis.cpp
+
+    argv[1] samples (default 2^22) of an AR(2) latency series pushed one at a
+    time into the analyzer (lags 8, 32, 128) against the batch analysis of the
+    same stored series (two-pass moments and the direct AUTCOR sum, what the
+    Timsac path of GMS_cpu_perf_time_series_analysis.h has to recompute for
+    every report). Printed: ns per sample, the cost of one snapshot (moments,
+    c(0..L), Levinson-Durbin over all orders) and the state size, which does not
+    depend on the number of samples.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       using namespace gms::system;
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 3; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+       double batch_analysis(const std::vector<double> & x,const int32_t L,std::vector<double> & c)
+       {
+              const std::size_t n{x.size()};
+              double m{0.0};
+              for(double v : x) m += v;
+              m /= static_cast<double>(n);
+              double m2{0.0},m3{0.0},m4{0.0};
+              for(double v : x) { const double d{v-m}; m2 += d*d; m3 += d*d*d; m4 += d*d*d*d; }
+              for(int32_t __k{0}; __k <= L; ++__k)
+              {
+                     double s{0.0};
+                     for(std::size_t __t{static_cast<std::size_t>(__k)}; __t < n; ++__t) s += (x[__t]-m)*(x[__t-__k]-m);
+                     c[__k] = s/static_cast<double>(n);
+              }
+              return (m2+m3+m4);
+       }
+
+}
+
+void perf_test_cpu_perf_online_analysis(const std::size_t);
+
+void perf_test_cpu_perf_online_analysis(const std::size_t n)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::mt19937_64 g(4848);
+       std::normal_distribution<double> e(0.0,25.0);
+       std::vector<double> x(n);
+       double x1{0.0},x2{0.0};
+       for(std::size_t __i{0}; __i != n; ++__i)
+       {
+              const double v{0.6*x1-0.3*x2+e(g)};
+              x2 = x1; x1 = v;
+              x[__i] = 1.0e4+v;
+       }
+       const double dn{static_cast<double>(n)};
+       const int32_t lags[3] = {8,32,128};
+       for(int32_t L : lags)
+       {
+              CpuPerfOnlineParams p;
+              p.m_lag = L;
+              CpuPerfOnlineAnalyzer an(p);
+              CpuPerfOnlineSnapshot s;
+              int32_t nalarm{0};
+              const double t_on{best_of([&]{ an.reset(); for(std::size_t __i{0}; __i != n; ++__i) nalarm += an.push(x[__i]) ? 1 : 0; })};
+              const double t_snap{best_of([&]{ for(int32_t __r{0}; __r != 100; ++__r) an.snapshot(s); })/100.0};
+              std::vector<double> c(static_cast<std::size_t>(L)+1ULL);
+              double sink{0.0};
+              const double t_bat{best_of([&]{ sink += batch_analysis(x,L,c); })};
+              double err{0.0};
+              for(int32_t __k{0}; __k <= L; ++__k) err = std::max(err,std::abs(c[__k]-s.m_acov[__k]));
+              const std::size_t state{sizeof(CpuPerfOnlineAnalyzer)+sizeof(double)*(an.m_ring.size()+an.m_first.size()+an.m_lagsum.size())};
+              printf("L=%3d: online %7.2f ns/sample, batch %7.2f ns/sample, snapshot %8.2f us, state %zu bytes, AR order %d, alarms %d, max. |c-c_batch|/c0 %g (%g)\n",
+                     L,1.0e9*t_on/dn,1.0e9*t_bat/dn,1.0e6*t_snap,state,s.m_ar_order,nalarm/3,err/c[0],sink);
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const std::size_t n{(argc > 1) ? static_cast<std::size_t>(std::atoll(argv[1])) : (1ULL << 22)};
+    perf_test_cpu_perf_online_analysis(n);
+    return 0;
+}
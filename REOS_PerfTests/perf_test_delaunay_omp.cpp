@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_delaunay_omp.h"
+#include <string>
+using std::string; // GMS_triangulation.h expects it
+#include "GMS_triangulation.h"
+
+/*
+    icpc -o perf_test_delaunay_omp -O3 -fp-model precise -no-fma -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_delaunay_omp.h GMS_delaunay_omp.cpp GMS_triangulation.h GMS_triangulation.cpp perf_test_delaunay_omp.cpp
+
+    Triangulation time of uniform random nodes and of a jittered terrain grid, N = 1e4 .. argv[1]
+    (default 10000000). r8tris2 is timed up to argv[2] nodes (default 100000).
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the task parallelism.
+*/
+
+void perf_test_delaunay_omp(const int32_t,const int32_t);
+
+void perf_test_delaunay_omp(const int32_t nmax,const int32_t nref)
+{
+       using namespace gms::math;
+       constexpr int32_t n_samples{3};
+       std::mt19937_64 rng(2026ULL);
+       std::uniform_real_distribution<double> u(0.0,1.0);
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("threads=%d\n",omp_get_max_threads());
+       printf("%-8s %9s %10s %12s %12s %12s %12s\n","nodes","N","triangles","dc [s]","dc Mnode/s","r8tris2 [s]","speedup");
+       for(const bool grid : {false,true})
+       {
+           for(int32_t n{10000}; n <= nmax; n *= 10)
+           {
+               std::vector<double> xy(2*static_cast<std::size_t>(n));
+               if(grid)
+               {
+                  // terrain like sampling: rows of a grid with a small jitter
+                  const int32_t m{static_cast<int32_t>(std::max(2.0,std::sqrt(static_cast<double>(n))))};
+                  for(int32_t __i{0}; __i != n; ++__i)
+                  {
+                      xy[2*__i]   = (__i%m)+0.05*u(rng);
+                      xy[2*__i+1] = (__i/m)+0.05*u(rng);
+                  }
+               }
+               else
+               {
+                  for(double & x : xy) x = u(rng);
+               }
+               std::vector<int32_t> tn(6*static_cast<std::size_t>(n)), tb(6*static_cast<std::size_t>(n));
+               int32_t ntri{0};
+               double best{1.0e+30};
+               for(int32_t __j{0}; __j != n_samples; ++__j)
+               {
+                   const double t0{omp_get_wtime()};
+                   const int32_t err{r8tris2_dc_omp(n,xy.data(),&ntri,tn.data(),tb.data())};
+                   const double t1{omp_get_wtime()};
+                   if(err != 0)
+                   {
+                      printf("r8tris2_dc_omp -- error %d\n",err);
+                      std::exit(EXIT_FAILURE);
+                   }
+                   best = std::min(best,t1-t0);
+               }
+               double tref{0.0};
+               if(n <= nref)
+               {
+                  int32_t rtri;
+                  const double t0{omp_get_wtime()};
+                  r8tris2(n,xy.data(),&rtri,tn.data(),tb.data());
+                  tref = omp_get_wtime()-t0;
+               }
+               printf("%-8s %9d %10d %12.4f %12.3f",grid ? "grid" : "uniform",n,ntri,best,1.0e-6*n/best);
+               if(n <= nref) printf(" %12.4f %12.1f\n",tref,tref/best);
+               else          printf(" %12s %12s\n","-","-");
+           }
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nmax{(argc > 1) ? std::atoi(argv[1]) : 10000000};
+    const int32_t nref{(argc > 2) ? std::atoi(argv[2]) : 100000};
+    perf_test_delaunay_omp(nmax,nref);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_par_team.h"
+#include "GMS_em_fields_fused_zmm16r4.h"
+
+/*
+    icpc -o perf_test_em_fields_fused_zmm16r4 -O3 -fp-model precise -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    -DENABLE_AVX512F GMS_config.h GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_par_team.h GMS_par_team.cpp GMS_em_fields_fused_zmm16r4.h GMS_em_fields_fused_zmm16r4.cpp perf_test_em_fields_fused_zmm16r4.cpp
+
+    Plane-wave chain direction -> polarization -> H -> B -> |H|,|B|,H.B over argv[1]
+    registers (default 2^16, 1M points), stage by stage (every intermediate stored
+    and reloaded) against the fused chain (serial and on the worker team), for the output
+    masks: norms and dot only, H and B fields, every output.
+    Printed per mask: best of 10 runs, bytes moved by each variant (per-stage
+    arrays counted in and out), effective GB/s and the traffic removed by the fusion.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       using gms::radiolocation::PW_ZMM16C4;
+       using gms::radiolocation::PW_Inputs;
+       using gms::radiolocation::PW_Outputs;
+
+       template<typename T>
+       T * alloc(const std::size_t n)
+       {
+              T * p{reinterpret_cast<T*>(_mm_malloc(sizeof(T)*n,64ull))};
+              if(p == nullptr) std::exit(EXIT_FAILURE);
+              return (p);
+       }
+
+       struct arrays_t
+       {
+              __m512     * r[7];   // tht,phi,psi,omg,px,py,pz
+              PW_ZMM16C4 * k;
+              __m512     * o[8];   // dvx,dvy,dvz,pvx,pvy,pvz,Hn,Bn
+              PW_ZMM16C4 * c[7];   // Hx,Hy,Hz,Bx,By,Bz,HB
+
+              explicit arrays_t(const std::size_t n)
+              {
+                     uint64_t s{0xA4093822299F31D0ull};
+                     for(auto & p : r) p = alloc<__m512>(n);
+                     k = alloc<PW_ZMM16C4>(n);
+                     for(auto & p : o) p = alloc<__m512>(n);
+                     for(auto & p : c) p = alloc<PW_ZMM16C4>(n);
+                     const float lo[7] = {0.0f,-3.14159265f,-3.14159265f,1.0e8f,-5.0f,-5.0f,-5.0f};
+                     const float hi[7] = {3.14159265f,3.14159265f,3.14159265f,1.0e10f,5.0f,5.0f,5.0f};
+                     for(std::size_t __i{0ull}; __i != n; ++__i)
+                     {
+                            alignas(64) float v[16];
+                            for(int32_t __a{0}; __a != 7; ++__a)
+                            {
+                                   for(int32_t __l{0}; __l != 16; ++__l)
+                                   {
+                                          s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+                                          v[__l] = lo[__a]+(hi[__a]-lo[__a])*static_cast<float>(s >> 40)*(1.0f/16777216.0f);
+                                   }
+                                   r[__a][__i] = _mm512_load_ps(v);
+                            }
+                            k[__i].re = _mm512_set1_ps(2.0f+static_cast<float>(__i%7ull));
+                            k[__i].im = _mm512_set1_ps(-0.01f);
+                            for(auto & p : o) p[__i] = _mm512_setzero_ps();
+                            for(auto & p : c) p[__i] = PW_ZMM16C4{_mm512_setzero_ps(),_mm512_setzero_ps()};
+                     }
+              }
+
+              ~arrays_t()
+              {
+                     for(auto & p : r) _mm_free(p);
+                     _mm_free(k);
+                     for(auto & p : o) _mm_free(p);
+                     for(auto & p : c) _mm_free(p);
+              }
+
+              PW_Inputs inputs() const
+              {
+                     return (PW_Inputs{r[0],r[1],r[2],r[3],r[4],r[5],r[6],k});
+              }
+
+              PW_Outputs outputs() const
+              {
+                     return (PW_Outputs{o[0],o[1],o[2],o[3],o[4],o[5],c[0],c[1],c[2],c[3],c[4],c[5],o[6],o[7],c[6]});
+              }
+       };
+
+       template<typename F>
+       double best_of(const int32_t nrep,F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != nrep; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+}
+
+void perf_test_em_fields_fused_chain(const int32_t);
+
+void perf_test_em_fields_fused_chain(const int32_t n)
+{
+       using namespace gms::radiolocation;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("workers: %d, %d registers (%d points), tile of %d registers\n",gms::common::par_team_size(),n,16*n,PW_FUSED_TILE);
+       arrays_t a(static_cast<std::size_t>(n));
+       const struct { uint32_t mask; const char * name; } cases[] = {
+              {PW_OUT__HNORM|PW_OUT__BNORM|PW_OUT__HBDOT,"|H|,|B|,H.B"},
+              {PW_OUT__H|PW_OUT__B,                      "H,B"},
+              {PW_OUT__ALL,                              "all outputs"}};
+       float chk{0.0f};
+       for(const auto & cs : cases)
+       {
+              const double b_unf{static_cast<double>(pw_bytes_unfused(cs.mask,n))};
+              const double b_fus{static_cast<double>(pw_bytes_fused(cs.mask,n))};
+              const double t_unf{best_of(10,[&]{ (void)pw_field_chain_zmm16r4(a.inputs(),a.outputs(),cs.mask,n); })};
+              const double t_fus{best_of(10,[&]{ (void)pw_field_chain_fused_zmm16r4(a.inputs(),a.outputs(),cs.mask,n); })};
+              const double t_omp{best_of(10,[&]{ (void)pw_field_chain_fused_omp(a.inputs(),a.outputs(),cs.mask,n); })};
+              printf("--- %-12s: bytes per-stage %8.1f MiB, fused %8.1f MiB (%4.1f%% of the traffic removed)\n",cs.name,
+                     b_unf/1048576.0,b_fus/1048576.0,100.0*(1.0-b_fus/b_unf));
+              printf("    per-stage   : %9.3f ms, %6.2f GB/s, %6.2f ns/point\n",1.0e3*t_unf,1.0e-9*b_unf/t_unf,1.0e9*t_unf/(16.0*n));
+              printf("    fused       : %9.3f ms, %6.2f GB/s, %6.2f ns/point, %5.2fx\n",1.0e3*t_fus,1.0e-9*b_fus/t_fus,
+                     1.0e9*t_fus/(16.0*n),t_unf/t_fus);
+              printf("    fused, team : %9.3f ms, %6.2f GB/s, %6.2f ns/point, %5.2fx\n",1.0e3*t_omp,1.0e-9*b_fus/t_omp,
+                     1.0e9*t_omp/(16.0*n),t_unf/t_omp);
+              alignas(64) float v[16];
+              _mm512_store_ps(v,a.o[7][n-1]);
+              chk += v[0];
+       }
+       printf("checksum: %g\n",static_cast<double>(chk));
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t n{(argc > 1) ? std::atoi(argv[1]) : (1 << 16)};
+    perf_test_em_fields_fused_chain(n);
+    return 0;
+}
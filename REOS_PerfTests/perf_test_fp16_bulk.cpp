@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_fp16_bulk.h"
+#include "GMS_dyn_array.h"
+#include "GMS_am_bb_cosine_signal.h"
+#include "GMS_am_bb_cosine_signal_fp16.h"
+
+/*
+    icpc -o perf_test_fp16_bulk -O3 -fp-model fast=2 -qopenmp -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    -DAM_BB_COSINE_SIGNAL_USE_PMC_INSTRUMENTATION=0 -DAM_BB_COSINE_SIGNAL_FP16_USE_PMC_INSTRUMENTATION=0 \
+    GMS_config.h GMS_malloc.h GMS_half.h GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_fp16_bulk.h GMS_fp16_bulk.cpp GMS_dyn_array.h GMS_cephes_sin_cos.h GMS_indices.h \
+    GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp \
+    GMS_sse_memcpy.h GMS_sse_memcpy.cpp GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp \
+    GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+    GMS_am_bb_cosine_signal.h GMS_am_bb_cosine_signal.cpp GMS_am_bb_cosine_signal_fp16.h GMS_am_bb_cosine_signal_fp16.cpp perf_test_fp16_bulk.cpp -ltbbmalloc
+
+    fp16 storage against fp32 storage, argv[1] elements (default 2^24):
+    float <-> half conversion element-wise (half_cast, half -> float operator) and in bulk,
+    streaming scale/axpy over darray_r2_t (fp16 load, fp32 compute, fp16 store) and darray_r4_t,
+    the AM baseband cosine generator with fp16 (per-sample half_cast as before, bulk tiles) and
+    fp32 storage.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       template<typename F>
+       double best_of(const int32_t nrep,F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != nrep; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     const auto t1{clk::now()};
+                     best = std::min(best,std::chrono::duration<double>(t1-t0).count());
+              }
+              return (best);
+       }
+
+       void report(const char * id,const double dt,const double bytes,const double n)
+       {
+              printf("%-44s: %8.3f ms, %7.2f GB/s, %8.1f Melem/s\n",id,1.0e3*dt,1.0e-9*bytes/dt,1.0e-6*n/dt);
+       }
+
+}
+
+void perf_test_fp16_bulk_cvt(const std::size_t);
+
+void perf_test_fp16_bulk_cvt(const std::size_t n)
+{
+       using namespace gms;
+       using namespace gms::common;
+       using namespace half_float;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("code path: %s\n",fp16_bulk_isa_name());
+       darray_r4_t f(n), g(n);
+       darray_r2_t h(n);
+       for(std::size_t __i{0ull}; __i != n; ++__i) f.m_data[__i] = std::sin(1.0e-3f*static_cast<float>(__i));
+       const double nb{static_cast<double>(n)};
+       double dt;
+       dt = best_of(5,[&]{ for(std::size_t __i{0ull}; __i != n; ++__i) h.m_data[__i] = half_cast<half>(f.m_data[__i]); });
+       report("float -> half, element-wise half_cast",dt,6.0*nb,nb);
+       const double dt0{dt};
+       dt = best_of(5,[&]{ cvt_f32_f16(f.m_data,h.m_data,n); });
+       report("float -> half, cvt_f32_f16",dt,6.0*nb,nb);
+       printf("speedup: %.2f\n",dt0/dt);
+       dt = best_of(5,[&]{ for(std::size_t __i{0ull}; __i != n; ++__i) g.m_data[__i] = static_cast<float>(h.m_data[__i]); });
+       report("half -> float, element-wise",dt,6.0*nb,nb);
+       const double dt1{dt};
+       dt = best_of(5,[&]{ cvt_f16_f32(h.m_data,g.m_data,n); });
+       report("half -> float, cvt_f16_f32",dt,6.0*nb,nb);
+       printf("speedup: %.2f\n",dt1/dt);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void perf_test_fp16_bulk_stream(const std::size_t);
+
+void perf_test_fp16_bulk_stream(const std::size_t n)
+{
+       using namespace gms;
+       using namespace gms::common;
+       using namespace half_float;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       darray_r4_t x4(n), y4(n);
+       darray_r2_t x2(n), y2(n);
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+       {
+              x4.m_data[__i] = std::cos(1.0e-3f*static_cast<float>(__i));
+              y4.m_data[__i] = 0.0f;
+       }
+       x2.load_r4(x4.m_data);
+       y2.load_r4(y4.m_data);
+       const double nb{static_cast<double>(n)};
+       constexpr float a{1.0e-3f};
+       double dt;
+       dt = best_of(5,[&]{ for(std::size_t __i{0ull}; __i != n; ++__i) y4.m_data[__i] += a*x4.m_data[__i]; });
+       report("axpy, fp32 storage (darray_r4_t)",dt,12.0*nb,nb);
+       const double dt4{dt};
+       dt = best_of(5,[&]{ for(std::size_t __i{0ull}; __i != n; ++__i)
+                                y2.m_data[__i] = half_cast<half>(a*static_cast<float>(x2.m_data[__i])+static_cast<float>(y2.m_data[__i])); });
+       report("axpy, fp16 storage, element-wise",dt,6.0*nb,nb);
+       dt = best_of(5,[&]{ axpy_f16(a,x2.m_data,y2.m_data,n); });
+       report("axpy, fp16 storage, axpy_f16",dt,6.0*nb,nb);
+       printf("fp16 bulk against fp32: %.2fx\n",dt4/dt);
+       dt = best_of(5,[&]{ for(std::size_t __i{0ull}; __i != n; ++__i) x4.m_data[__i] *= 0.999f; });
+       report("scale, fp32 storage (darray_r4_t)",dt,8.0*nb,nb);
+       const double ds4{dt};
+       dt = best_of(5,[&]{ scale_f16(x2.m_data,0.999f,n); });
+       report("scale, fp16 storage, scale_f16",dt,4.0*nb,nb);
+       printf("fp16 bulk against fp32: %.2fx\n",ds4/dt);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void perf_test_fp16_bulk_signal(const std::size_t);
+
+void perf_test_fp16_bulk_signal(const std::size_t n)
+{
+       using namespace gms::radiolocation;
+       using namespace half_float;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       constexpr std::uint32_t nK{4};
+       const std::size_t ns{std::min<std::size_t>(n,std::size_t{1} << 22)};
+       std::vector<float> sym(ns*nK);
+       for(std::size_t __i{0ull}; __i != sym.size(); ++__i) sym[__i] = (__i & 1ull) ? 1.0f : -1.0f;
+       am_bb_cosine_signal_t      s4(ns,nK,16.0f,1.0f,8.0f);
+       am_bb_cosine_signal_fp16_t s2(ns,nK,16.0f,1.0f,8.0f);
+       const double nb{static_cast<double>(ns)};
+       double dt;
+       dt = best_of(3,[&]{ s4.create_signal_user_data(sym.data(),static_cast<std::uint32_t>(ns),nK); });
+       report("cosine, fp32 storage",dt,4.0*nb,nb);
+       dt = best_of(3,[&]{ s4.create_signal_user_data_u4x(sym.data(),static_cast<std::uint32_t>(ns),nK); });
+       report("cosine, fp32 storage, u4x",dt,4.0*nb,nb);
+       // the former fp16 path, a half_cast per sample
+       const float T{static_cast<float>(ns)};
+       const float invT{8.0f/T};
+       dt = best_of(3,[&]{ for(std::size_t __t{0ull}; __t != ns; ++__t)
+                           {
+                               const float t{static_cast<float>(__t)};
+                               float sum{0.0f};
+                               for(std::uint32_t __k{0}; __k != nK; ++__k)
+                                   sum += s2.cos_sample(t-static_cast<float>(__k)*T,invT)*sym[__t*nK+__k];
+                               s2.m_sig_samples.m_data[__t] = half_cast<half>(sum);
+                           } });
+       report("cosine, fp16 storage, per-sample half_cast",dt,2.0*nb,nb);
+       dt = best_of(3,[&]{ s2.create_signal_user_data(sym.data(),static_cast<std::uint32_t>(ns),nK); });
+       report("cosine, fp16 storage, bulk tiles",dt,2.0*nb,nb);
+       dt = best_of(3,[&]{ s2.create_signal_user_data_u4x(sym.data(),static_cast<std::uint32_t>(ns),nK); });
+       report("cosine, fp16 storage, bulk tiles, u4x",dt,2.0*nb,nb);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const std::size_t n{(argc > 1) ? static_cast<std::size_t>(std::atoll(argv[1])) : (std::size_t{1} << 24)};
+    perf_test_fp16_bulk_cvt(n);
+    perf_test_fp16_bulk_stream(n);
+    perf_test_fp16_bulk_signal(n);
+    return 0;
+}
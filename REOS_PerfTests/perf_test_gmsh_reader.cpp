@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+#include "GMS_gmsh_reader.h"
+
+/*
+    icpc -o perf_test_gmsh_reader -O3 -fp-model precise -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_gmsh_reader.h GMS_gmsh_reader.c GMS_gmsh_reader_mmap.cpp perf_test_gmsh_reader.cpp
+
+    Writes an nx*ny triangulated grid (default 1500x1500, argv[1], argv[2]) as ASCII MSH 2.2,
+    ASCII MSH 4.1 and binary MSH 4.1 and reports the load time of the legacy
+    gmsh_size_read + gmsh_data_read pair and of gmsh_mmap_read.
+    The files are read once before timing, i.e. the times are page cache (parse) times.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the parallel parsing.
+*/
+
+static void perf_test_write_grid(const char * f22,const char * f41,const char * f41b,
+                                 const int32_t nx,const int32_t ny)
+{
+       const int32_t nnode{nx*ny};
+       const int32_t ntri{2*(nx-1)*(ny-1)};
+       auto tri = [nx](int32_t t,std::size_t * v) {
+            const int32_t q{t/2};
+            const std::size_t a{static_cast<std::size_t>((q/(nx-1))*nx+q%(nx-1)+1)};
+            if(t%2 == 0) {v[0] = a; v[1] = a+1;  v[2] = a+nx+1;}
+            else         {v[0] = a; v[1] = a+nx+1; v[2] = a+nx;}
+       };
+       auto xyz = [nx](int32_t i,double * c) {
+            c[0] = 0.001*static_cast<double>(i%nx)+1.0e-7*static_cast<double>(i%7);
+            c[1] = 0.001*static_cast<double>(i/nx)-3.0e-8*static_cast<double>(i%11);
+            c[2] = 0.25*c[0]*c[1];
+       };
+       double c[3];
+       std::size_t v[3];
+       FILE * fp{std::fopen(f22,"w")};
+       fprintf(fp,"$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n%d\n",nnode);
+       for(int32_t __i{0}; __i != nnode; ++__i) {xyz(__i,c); fprintf(fp,"%d %.16g %.16g %.16g\n",__i+1,c[0],c[1],c[2]);}
+       fprintf(fp,"$EndNodes\n$Elements\n%d\n",ntri);
+       for(int32_t __t{0}; __t != ntri; ++__t) {tri(__t,v); fprintf(fp,"%d 2 2 0 1 %zu %zu %zu\n",__t+1,v[0],v[1],v[2]);}
+       fprintf(fp,"$EndElements\n");
+       std::fclose(fp);
+       fp = std::fopen(f41,"w");
+       fprintf(fp,"$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$Nodes\n1 %d 1 %d\n2 1 0 %d\n",nnode,nnode,nnode);
+       for(int32_t __i{0}; __i != nnode; ++__i) fprintf(fp,"%d\n",__i+1);
+       for(int32_t __i{0}; __i != nnode; ++__i) {xyz(__i,c); fprintf(fp,"%.16g %.16g %.16g\n",c[0],c[1],c[2]);}
+       fprintf(fp,"$EndNodes\n$Elements\n1 %d 1 %d\n2 1 2 %d\n",ntri,ntri,ntri);
+       for(int32_t __t{0}; __t != ntri; ++__t) {tri(__t,v); fprintf(fp,"%d %zu %zu %zu\n",__t+1,v[0],v[1],v[2]);}
+       fprintf(fp,"$EndElements\n");
+       std::fclose(fp);
+       fp = std::fopen(f41b,"wb");
+       const int32_t hdr[3] = {2,1,0};
+       const int32_t ehdr[3] = {2,1,2};
+       const int32_t one{1};
+       std::size_t z[4] = {1ull,static_cast<std::size_t>(nnode),1ull,static_cast<std::size_t>(nnode)};
+       fprintf(fp,"$MeshFormat\n4.1 1 8\n"); std::fwrite(&one,4,1,fp); fprintf(fp,"\n$EndMeshFormat\n$Nodes\n");
+       std::fwrite(z,sizeof(z),1,fp);
+       std::fwrite(hdr,sizeof(hdr),1,fp); std::fwrite(&z[1],sizeof(std::size_t),1,fp);
+       for(std::size_t __i{1ull}; __i <= static_cast<std::size_t>(nnode); ++__i) std::fwrite(&__i,sizeof(__i),1,fp);
+       for(int32_t __i{0}; __i != nnode; ++__i) {xyz(__i,c); std::fwrite(c,sizeof(c),1,fp);}
+       fprintf(fp,"\n$EndNodes\n$Elements\n");
+       z[1] = z[3] = static_cast<std::size_t>(ntri);
+       std::fwrite(z,sizeof(z),1,fp);
+       std::fwrite(ehdr,sizeof(ehdr),1,fp); std::fwrite(&z[1],sizeof(std::size_t),1,fp);
+       for(int32_t __t{0}; __t != ntri; ++__t)
+       {
+            const std::size_t tag{static_cast<std::size_t>(__t+1)};
+            tri(__t,v);
+            std::fwrite(&tag,sizeof(tag),1,fp);
+            std::fwrite(v,sizeof(v),1,fp);
+       }
+       fprintf(fp,"\n$EndElements\n");
+       std::fclose(fp);
+}
+
+static std::size_t perf_test_file_size(const char * fname)
+{
+       FILE * fp{std::fopen(fname,"rb")};
+       std::fseek(fp,0L,SEEK_END);
+       const long sz{std::ftell(fp)};
+       std::fclose(fp);
+       return static_cast<std::size_t>(sz);
+}
+
+static double perf_test_mmap_read(const char * fname,const int32_t n_samples)
+{
+       double best{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+            GMSH_Mesh m;
+            const double t0{omp_get_wtime()};
+            gmsh_mmap_read(fname,&m,0);
+            const double t1{omp_get_wtime()};
+            best = std::min(best,t1-t0);
+            gmsh_mesh_free(&m);
+       }
+       return best;
+}
+
+void perf_test_gmsh_reader(const int32_t,const int32_t);
+
+void perf_test_gmsh_reader(const int32_t nx,const int32_t ny)
+{
+       char f22[]  = "perf_gmsh_grid22.msh";
+       char f41[]  = "perf_gmsh_grid41.msh";
+       char f41b[] = "perf_gmsh_grid41b.msh";
+       constexpr int32_t n_samples{3};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       perf_test_write_grid(f22,f41,f41b,nx,ny);
+       printf("grid %dx%d: nodes=%d, triangles=%d, threads=%d\n",nx,ny,nx*ny,2*(nx-1)*(ny-1),omp_get_max_threads());
+       // legacy: sizes pass + data pass, fgets/s_to_r8
+       int nn, nd, ne, eo;
+       double tl{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+            const double t0{omp_get_wtime()};
+            gmsh_size_read(f22,&nn,&nd,&ne,&eo);
+            std::vector<double> node_x(static_cast<std::size_t>(nd)*nn);
+            std::vector<int> elem(static_cast<std::size_t>(eo)*ne);
+            gmsh_data_read(f22,nd,nn,node_x.data(),eo,ne,elem.data());
+            const double t1{omp_get_wtime()};
+            tl = std::min(tl,t1-t0);
+       }
+       const double t22{perf_test_mmap_read(f22,n_samples)};
+       const double t41{perf_test_mmap_read(f41,n_samples)};
+       const double t41b{perf_test_mmap_read(f41b,n_samples)};
+       printf("%-28s %12s %10s %10s %9s\n","reader","file [MiB]","time [s]","[MiB/s]","speedup");
+       auto row = [tl](const char * name,const char * fname,const double t) {
+            const double mib{static_cast<double>(perf_test_file_size(fname))/1048576.0};
+            printf("%-28s %12.1f %10.4f %10.1f %9.1f\n",name,mib,t,mib/t,tl/t);
+       };
+       row("gmsh_data_read (2.2 ASCII)",f22,tl);
+       row("gmsh_mmap_read (2.2 ASCII)",f22,t22);
+       row("gmsh_mmap_read (4.1 ASCII)",f41,t41);
+       row("gmsh_mmap_read (4.1 binary)",f41b,t41b);
+       std::remove(f22);
+       std::remove(f41);
+       std::remove(f41b);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nx{(argc > 1) ? std::atoi(argv[1]) : 1500};
+    const int32_t ny{(argc > 2) ? std::atoi(argv[2]) : 1500};
+    perf_test_gmsh_reader(nx,ny);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_itm_p2p_avx512.h"
+#include "GMS_idealized_topo.h"
+
+/*
+    icpc -o perf_test_itm_p2p_avx512 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_idealized_topo.h GMS_idealized_topo.cpp GMS_itm_p2p_avx512.h GMS_itm_p2p_avx512.cpp perf_test_itm_p2p_avx512.cpp
+
+    Coverage of one transmitter over a raster of argv[1] receivers (default 1000000) on a 2048x2048
+    memory-mapped terrain grid (50 m), itm_p2p_coverage_omp versus the scalar itm_profile_extract +
+    itm_p2p_tls loop over the first argv[2] receivers (default 50000). Also the area mode batch.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the receiver parallelism.
+*/
+
+void perf_test_itm_p2p_avx512(const int32_t,const int32_t);
+
+void perf_test_itm_p2p_avx512(const int32_t nrx,const int32_t nref)
+{
+       using namespace gms::math;
+       constexpr int32_t n{2048};
+       constexpr double  step{50.0};
+       constexpr int32_t n_samples{3};
+       constexpr float   deg{0.0174532925199432957692f};
+       const char * fname{"/tmp/perf_test_itm_terrain.flt"};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       {
+          std::vector<float> lon(n), lat(n), z(static_cast<std::size_t>(n)*n);
+          for(int32_t __i{0}; __i != n; ++__i)
+          {
+              lat[__i] = deg*(90.0f*__i/(n-1));
+              lon[__i] = deg*(45.0f+90.0f*__i/(n-1));
+          }
+          gms::gaussian_topography_r4(lon.data(),n,lat.data(),n,z.data(),1200.0f);
+          for(int32_t __i{0}; __i != n; ++__i)
+              for(int32_t __j{0}; __j != n; ++__j)
+                  z[static_cast<std::size_t>(__i)*n+__j] += 40.0f*std::sin(0.037f*__j)*std::cos(0.051f*__i);
+          FILE * fp{std::fopen(fname,"wb")};
+          if(fp == nullptr)
+          {
+             printf("cannot write %s\n",fname);
+             std::exit(EXIT_FAILURE);
+          }
+          std::fwrite(z.data(),sizeof(float),z.size(),fp);
+          std::fclose(fp);
+       }
+       ITM_ElevGrid g;
+       if(itm_elev_grid_mmap(fname,n,n,0.0,0.0,step,step,g) != 0)
+       {
+          printf("cannot map %s\n",fname);
+          std::exit(EXIT_FAILURE);
+       }
+       ITM_Params p;
+       p.f_mhz        = 900.0;
+       p.N_0          = 301.0;
+       p.epsilon      = 15.0;
+       p.sigma        = 0.005;
+       p.polarization = POLARIZATION__VERTICAL;
+       p.climate      = CLIMATE__CONTINENTAL_TEMPERATE;
+       p.mdvar        = MDVAR__ACCIDENTAL;
+       p.time         = 50.0;
+       p.location     = 50.0;
+       p.situation    = 50.0;
+       const double ext{step*(n-1)};
+       const double tx{0.5*ext}, ty{0.5*ext};
+       const int32_t m{static_cast<int32_t>(std::sqrt(static_cast<double>(nrx)))};
+       std::vector<double> rx(static_cast<std::size_t>(m)*m), ry(static_cast<std::size_t>(m)*m);
+       for(int32_t __i{0}; __i != m; ++__i)
+           for(int32_t __j{0}; __j != m; ++__j)
+           {
+               rx[static_cast<std::size_t>(__i)*m+__j] = ext*(__j+0.5)/m;
+               ry[static_cast<std::size_t>(__i)*m+__j] = ext*(__i+0.5)/m;
+           }
+       const int32_t nr{m*m};
+       std::vector<float> A(nr);
+       std::vector<int8_t> mode(nr);
+       double best{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           const double t0{omp_get_wtime()};
+           itm_p2p_coverage_omp(g,p,tx,ty,30.0,2.0,rx.data(),ry.data(),nr,step,A.data(),mode.data(),nullptr);
+           best = std::min(best,omp_get_wtime()-t0);
+       }
+       int32_t cnt[4] = {0,0,0,0};
+       for(int32_t __i{0}; __i != nr; ++__i) ++cnt[mode[__i]];
+       printf("threads=%d, receivers=%d (LOS=%d DIFF=%d TROPO=%d)\n",omp_get_max_threads(),nr,cnt[1],cnt[2],cnt[3]);
+       printf("itm_p2p_coverage_omp : %10.4f s %12.1f links/s\n",best,nr/best);
+       const int32_t nr2{std::min(nref,nr)};
+       std::vector<double> pfl(static_cast<std::size_t>(4*n)+3);
+       double sink{0.0};
+       const double t0{omp_get_wtime()};
+       for(int32_t __i{0}; __i != nr2; ++__i)
+       {
+           const double d{std::hypot(rx[__i]-tx,ry[__i]-ty)};
+           const int32_t np{std::max(2,static_cast<int32_t>(std::ceil(d/step)))};
+           itm_profile_extract(g,tx,ty,rx[__i],ry[__i],np,pfl.data());
+           double a;
+           int32_t md;
+           itm_p2p_tls(30.0,2.0,pfl.data(),p,&a,&md);
+           sink += a;
+       }
+       const double tref{omp_get_wtime()-t0};
+       printf("itm_p2p_tls (1 thread): %9.4f s %12.1f links/s, speedup %.1f (sink=%g)\n",
+              tref,nr2/tref,(nr/best)/(nr2/tref),sink);
+       // area mode
+       std::vector<float> d(nr);
+       for(int32_t __i{0}; __i != nr; ++__i) d[__i] = 1.0f+1999.0f*static_cast<float>(__i)/nr;
+       best = 1.0e+30;
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           const double t1{omp_get_wtime()};
+           itm_area_batch_omp(30.0,2.0,SITING_CRITERIA__CAREFUL,SITING_CRITERIA__RANDOM,90.0,p,d.data(),nr,A.data(),nullptr,nullptr);
+           best = std::min(best,omp_get_wtime()-t1);
+       }
+       const double t2{omp_get_wtime()};
+       for(int32_t __i{0}; __i != nr2; ++__i)
+       {
+           double a;
+           int32_t md;
+           itm_area_tls(30.0,2.0,SITING_CRITERIA__CAREFUL,SITING_CRITERIA__RANDOM,d[__i],90.0,p,&a,&md);
+           sink += a;
+       }
+       const double tarea{omp_get_wtime()-t2};
+       printf("itm_area_batch_omp   : %10.4f s %12.1f links/s, itm_area_tls %12.1f links/s (sink=%g)\n",
+              best,nr/best,nr2/tarea,sink);
+       itm_elev_grid_unmap(g);
+       std::remove(fname);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nrx{(argc > 1) ? std::atoi(argv[1]) : 1000000};
+    const int32_t nref{(argc > 2) ? std::atoi(argv[2]) : 50000};
+    perf_test_itm_p2p_avx512(nrx,nref);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_large_alloc.h"
+
+/*
+    icpc -o perf_test_large_alloc -O3 -fp-model fast=2 -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    GMS_config.h GMS_large_alloc.h GMS_large_alloc.cpp perf_test_large_alloc.cpp
+
+    Bandwidth of the *_omp streaming kernels over the operands placed by the allocation variants:
+    _mm_malloc + serial zero-fill (GMS_INIT_ARRAYS), 4KiB pages + OpenMP first-touch, THP + serial,
+    THP + OpenMP first-touch, THP + interleaved NUMA placement.
+    The kernel reproduces the loop of sdotv_zmm16r4_unroll6x_omp (six __m512 streams in, one out,
+    remainder peeled, schedule(runtime) stepping by 6), argv[1] __m512 elements per stream
+    (default 2^21, 7 x 128 MiB). Run with OMP_SCHEDULE=static OMP_PROC_BIND=close OMP_PLACES=cores.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       // the loop of sdotv_zmm16r4_unroll6x_omp (GMS_em_fields_zmm16r4_omp.cpp)
+       void sdotv_unroll6x_omp(const __m512 * __restrict pv1x,const __m512 * __restrict pv1y,
+                               const __m512 * __restrict pv1z,const __m512 * __restrict pv2x,
+                               const __m512 * __restrict pv2y,const __m512 * __restrict pv2z,
+                               __m512 * __restrict pdtv,const int32_t n)
+       {
+              int32_t j,m;
+              m = n%6;
+              for(j = 0; j != m; ++j)
+                  pdtv[j] = _mm512_fmadd_ps(pv1x[j],pv2x[j],_mm512_fmadd_ps(pv1y[j],pv2y[j],_mm512_mul_ps(pv1z[j],pv2z[j])));
+              if(n<6) return;
+#pragma omp parallel for schedule(runtime) default(none) firstprivate(m) private(j) \
+        shared(n,pv1x,pv1y,pv1z,pv2x,pv2y,pv2z,pdtv)
+              for(j = m; j < n; j += 6)
+              {
+                     for(int32_t __u{0}; __u != 6; ++__u)
+                         pdtv[j+__u] = _mm512_fmadd_ps(pv1x[j+__u],pv2x[j+__u],
+                                       _mm512_fmadd_ps(pv1y[j+__u],pv2y[j+__u],_mm512_mul_ps(pv1z[j+__u],pv2z[j+__u])));
+              }
+       }
+
+       struct operands_t
+       {
+              __m512 * p[7];
+       };
+
+       enum class variant : int32_t
+       {
+              MM_MALLOC_SERIAL = 0,
+              PAGES_4KiB_OMP   = 1,
+              THP_SERIAL       = 2,
+              THP_OMP          = 3,
+              THP_INTERLEAVE   = 4
+       };
+
+       const char * variant_name(const variant v)
+       {
+              switch(v)
+              {
+                     case variant::MM_MALLOC_SERIAL : return "_mm_malloc, serial zero-fill";
+                     case variant::PAGES_4KiB_OMP   : return "4KiB pages, OpenMP first-touch";
+                     case variant::THP_SERIAL       : return "THP, serial first-touch";
+                     case variant::THP_OMP          : return "THP, OpenMP first-touch";
+                     case variant::THP_INTERLEAVE   : return "THP, interleaved, OpenMP first-touch";
+              }
+              return "";
+       }
+
+       operands_t allocate(const variant v,const std::size_t n,std::size_t & huge)
+       {
+              using namespace gms::common;
+              operands_t o;
+              huge = 0ull;
+              large_alloc_opts_t opts{};
+              opts.elem_bytes = sizeof(__m512);
+              opts.unroll     = 6;
+              opts.page       = (v == variant::PAGES_4KiB_OMP) ? page_kind::PAGES_4KiB : page_kind::THP;
+              opts.touch      = (v == variant::THP_SERIAL) ? touch_kind::SERIAL : touch_kind::OMP_PARALLEL;
+              opts.numa       = (v == variant::THP_INTERLEAVE) ? numa_place::INTERLEAVE : numa_place::NONE;
+              for(int32_t __a{0}; __a != 7; ++__a)
+              {
+                     if(v == variant::MM_MALLOC_SERIAL)
+                     {
+                            o.p[__a] = reinterpret_cast<__m512*>(_mm_malloc(sizeof(__m512)*n,64ull));
+                            std::memset(o.p[__a],0,sizeof(__m512)*n);
+                     }
+                     else
+                     {
+                            o.p[__a] = large_alloc<__m512>(n,opts);
+                            huge += hugepage_backed_bytes(o.p[__a],sizeof(__m512)*n);
+                     }
+              }
+              return (o);
+       }
+
+       void release(const variant v,operands_t & o)
+       {
+              for(int32_t __a{0}; __a != 7; ++__a)
+              {
+                     if(v == variant::MM_MALLOC_SERIAL) _mm_free(o.p[__a]);
+                     else gms::common::gms_large_free(o.p[__a]);
+              }
+       }
+
+}
+
+void perf_test_large_alloc_sdotv(const std::size_t);
+
+void perf_test_large_alloc_sdotv(const std::size_t n)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("threads: %d, NUMA nodes: %d, %zu elements x 7 streams\n",omp_get_max_threads(),
+              gms::common::numa_nodes_online(),n);
+       const double bytes{7.0*64.0*static_cast<double>(n)};
+       double bw0{0.0};
+       for(int32_t __v{0}; __v != 5; ++__v)
+       {
+              const variant v{static_cast<variant>(__v)};
+              std::size_t huge{0ull};
+              const auto ta{clk::now()};
+              operands_t o{allocate(v,n,huge)};
+              const double t_alloc{std::chrono::duration<double>(clk::now()-ta).count()};
+              for(int32_t __a{0}; __a != 6; ++__a)
+                  for(std::size_t __i{0ull}; __i != n; ++__i) o.p[__a][__i] = _mm512_set1_ps(1.0f+__a);
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 10; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     sdotv_unroll6x_omp(o.p[0],o.p[1],o.p[2],o.p[3],o.p[4],o.p[5],o.p[6],static_cast<int32_t>(n));
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              const double bw{1.0e-9*bytes/best};
+              if(__v == 0) bw0 = bw;
+              float chk[16];
+              _mm512_storeu_ps(chk,o.p[6][n-1ull]);
+              printf("%-38s: alloc+touch %8.2f ms, kernel %8.3f ms, %7.2f GB/s (%5.2fx), hugepage-backed %5.1f%%, chk %g\n",
+                     variant_name(v),1.0e3*t_alloc,1.0e3*best,bw,bw/bw0,
+                     100.0*static_cast<double>(huge)/bytes,static_cast<double>(chk[0]));
+              release(v,o);
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const std::size_t n{(argc > 1) ? static_cast<std::size_t>(std::atoll(argv[1])) : (std::size_t{1} << 21)};
+    perf_test_large_alloc_sdotv(n);
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_lsoda_ensemble_zmm8r8.h"
+
+/*
+    icpc -o perf_test_lsoda_ensemble_zmm8r8 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_lsoda_ensemble_zmm8r8.h GMS_lsoda_ensemble_zmm8r8.cpp perf_test_lsoda_ensemble_zmm8r8.cpp
+
+    Ensemble LSODA throughput (systems per second), argv[1] systems (default 16384):
+    Robertson kinetics (3 equations, user Jacobian) with a rate per cell and a 16 species
+    stiff decay chain (difference quotient Jacobian), 1..max threads, and the same systems
+    integrated one per block (a single busy lane) for the SIMD batching gain.
+*/
+
+namespace {
+
+       struct Robertson {
+              const double * k1;
+              void operator()(const int32_t,const __m512d,const __m512d * __restrict y,
+                              __m512d * __restrict yd,const __m256i sys) const
+              {
+                     const __m512d a  = _mm512_i32gather_pd(sys,k1,8);
+                     const __m512d y1 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[1]);
+                     yd[0] = _mm512_fmadd_pd(y1,y[2],_mm512_mul_pd(_mm512_sub_pd(_mm512_setzero_pd(),a),y[0]));
+                     yd[2] = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(3.0e7),y[1]),y[1]);
+                     yd[1] = _mm512_sub_pd(_mm512_sub_pd(_mm512_setzero_pd(),yd[0]),yd[2]);
+              }
+       };
+
+       struct RobertsonJac {
+              const double * k1;
+              void operator()(const int32_t neq,const __m512d,const __m512d * __restrict y,
+                              __m512d * __restrict pd,const __m256i sys) const
+              {
+                     const __m512d a   = _mm512_i32gather_pd(sys,k1,8);
+                     const __m512d c13 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[2]);
+                     const __m512d c12 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[1]);
+                     const __m512d c32 = _mm512_mul_pd(_mm512_set1_pd(6.0e7),y[1]);
+                     pd[0*neq+0] = _mm512_sub_pd(_mm512_setzero_pd(),a);
+                     pd[1*neq+0] = c13;
+                     pd[2*neq+0] = c12;
+                     pd[0*neq+1] = a;
+                     pd[1*neq+1] = _mm512_sub_pd(_mm512_sub_pd(_mm512_setzero_pd(),c13),c32);
+                     pd[2*neq+1] = _mm512_sub_pd(_mm512_setzero_pd(),c12);
+                     pd[1*neq+2] = c32;
+              }
+       };
+
+       // y0' = -k0*y0, yi' = k(i-1)*y(i-1) - ki*yi, ki = 10^(4-6i/15)*scale
+       struct DecayChain {
+              const double * scale;
+              void operator()(const int32_t neq,const __m512d,const __m512d * __restrict y,
+                              __m512d * __restrict yd,const __m256i sys) const
+              {
+                     const __m512d s = _mm512_i32gather_pd(sys,scale,8);
+                     __m512d prev = _mm512_setzero_pd();
+                     for(int32_t __i{0}; __i != neq; ++__i)
+                     {
+                            const __m512d ki  = _mm512_mul_pd(s,_mm512_set1_pd(std::pow(10.0,4.0-6.0*__i/15.0)));
+                            const __m512d out = _mm512_mul_pd(ki,y[__i]);
+                            yd[__i] = _mm512_sub_pd(prev,out);
+                            prev = out;
+                     }
+              }
+       };
+
+       template<typename F,typename J>
+       void run(const char * id,const F & f,const J & jac,const int32_t nsys,const int32_t neq,
+                const double * y0,const double tout,const gms::math::LsodaOpts & o)
+       {
+              using namespace gms::math;
+              std::vector<double> y(static_cast<std::size_t>(nsys)*neq);
+              std::vector<int32_t> ist(nsys);
+              std::vector<LsodaStats> st(nsys);
+              const int32_t nmax{omp_get_max_threads()};
+              double t1{0.0};
+              for(int32_t nt{1}; nt <= nmax; nt = (nt == nmax) ? nmax+1 : std::min(2*nt,nmax))
+              {
+                  omp_set_num_threads(nt);
+                  for(int32_t __s{0}; __s != nsys; ++__s) std::copy(y0,y0+neq,&y[static_cast<std::size_t>(__s)*neq]);
+                  const double t0{omp_get_wtime()};
+                  lsoda_ensemble_zmm8r8_omp(f,jac,nsys,neq,y.data(),0.0,tout,o,ist.data(),st.data());
+                  const double dt{omp_get_wtime()-t0};
+                  if(nt == 1) t1 = dt;
+                  int64_t nst{0}, bad{0};
+                  for(int32_t __s{0}; __s != nsys; ++__s)
+                  {
+                      nst += st[__s].nst;
+                      bad += ist[__s] != 2;
+                  }
+                  printf("%s: threads %d, %d systems in %.3f s, %.1f systems/s, speedup %.2f, %.1f steps/system, failed %lld\n",
+                         id,nt,nsys,dt,nsys/dt,t1/dt,static_cast<double>(nst)/nsys,static_cast<long long>(bad));
+              }
+              omp_set_num_threads(nmax);
+              // one system per block, the other seven lanes repeat it
+              const int32_t nsub{std::max(nsys/64,1)};
+              const double t0{omp_get_wtime()};
+              for(int32_t __s{0}; __s != nsub; ++__s)
+              {
+                  std::copy(y0,y0+neq,&y[0]);
+                  lsoda_ensemble_zmm8r8_omp(f,jac,1,neq,y.data(),0.0,tout,o,ist.data(),st.data());
+              }
+              const double dt{omp_get_wtime()-t0};
+              printf("%s: one system per block, %.1f systems/s, 8 per block (1 thread) %.2fx faster\n",
+                     id,nsub/dt,(nsys/t1)/(nsub/dt));
+       }
+
+}
+
+void perf_test_lsoda_ensemble_zmm8r8(const int32_t);
+
+void perf_test_lsoda_ensemble_zmm8r8(const int32_t nsys)
+{
+       using namespace gms::math;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::vector<double> k1(nsys), scale(nsys);
+       for(int32_t __s{0}; __s != nsys; ++__s)
+       {
+              k1[__s]    = 0.04*(1.0+0.5*std::sin(0.001*__s));
+              scale[__s] = 1.0+0.25*std::cos(0.003*__s);
+       }
+       {
+              const double rtol[1] = {1.0e-4}, atol[3] = {1.0e-8,1.0e-14,1.0e-8};
+              LsodaOpts o{};
+              o.itol = 2; o.jt = 1; o.rtol = rtol; o.atol = atol; o.mxstep = 10000;
+              const double y0[3] = {1.0,0.0,0.0};
+              run("Robertson, 3",Robertson{k1.data()},RobertsonJac{k1.data()},nsys,3,y0,1.0e5,o);
+       }
+       {
+              const double rtol[1] = {1.0e-5}, atol[1] = {1.0e-12};
+              LsodaOpts o{};
+              o.itol = 1; o.rtol = rtol; o.atol = atol; o.mxstep = 10000;
+              std::vector<double> y0(16,0.0);
+              y0[0] = 1.0;
+              run("decay chain, 16",DecayChain{scale.data()},LsodaNoJac{},nsys,16,y0.data(),1.0e2,o);
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t nsys{(argc > 1) ? std::atoi(argv[1]) : 16384};
+    perf_test_lsoda_ensemble_zmm8r8(nsys);
+    return 0;
+}
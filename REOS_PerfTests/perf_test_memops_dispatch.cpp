@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+#include <omp.h>
+#include <algorithm>
+#include "GMS_malloc.h"
+#include "GMS_memops_dispatch.h"
+#include "GMS_avx512_memcpy.h"
+#include "GMS_avx512_uncached_memcpy.h"
+
+/*
+    icpc -o perf_test_memops_dispatch -fp-model fast=2 -fno-exceptions -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_malloc.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+    GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+    GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp GMS_memops_dispatch.h GMS_memops_dispatch.cpp perf_test_memops_dispatch.cpp
+
+    Sweeps the copy size from 64 KiB to 256 MiB and reports the best-of-n_samples bandwidth
+    of glibc memcpy, the fixed AVX512 cached and non-temporal kernels and the calibrated dispatcher.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the multi-threaded path.
+*/
+
+__attribute__((hot))
+__attribute__((noinline))
+double perf_test_best_gibs(void (*)(float * __restrict__,float * __restrict__,std::size_t),
+                           float * __restrict__,
+                           float * __restrict__,
+                           const std::size_t,
+                           const int32_t);
+
+double perf_test_best_gibs(void (*copy)(float * __restrict__,float * __restrict__,std::size_t),
+                           float * __restrict__ dst,
+                           float * __restrict__ src,
+                           const std::size_t sz,
+                           const int32_t n_samples)
+{
+       const double data_size{static_cast<double>(sizeof(float)*sz)};
+       double best{1.0e+30};
+       copy(dst,src,sz); // warmup
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+            const double t0{omp_get_wtime()};
+            copy(dst,src,sz);
+            const double t1{omp_get_wtime()};
+            best = std::min(best,t1-t0);
+       }
+       return data_size/(best*1073741824.0);
+}
+
+static void glibc_copy(float * __restrict__ dst,float * __restrict__ src,std::size_t sz)
+{
+       std::memcpy(dst,src,sizeof(float)*sz);
+}
+
+static void dispatch_copy(float * __restrict__ dst,float * __restrict__ src,std::size_t sz)
+{
+       gms::common::memcpy_dispatch_ps(dst,src,sz);
+}
+
+void perf_test_memops_dispatch();
+
+void perf_test_memops_dispatch()
+{
+       using namespace gms::common;
+       constexpr std::size_t min_bytes{65536ull};
+       constexpr std::size_t max_bytes{268435456ull};
+       constexpr int32_t n_samples{16};
+       const std::size_t max_n{max_bytes/sizeof(float)};
+       float * __restrict__ src{reinterpret_cast<float*>(gms_mm_malloc(max_bytes,64ULL))};
+       float * __restrict__ dst{reinterpret_cast<float*>(gms_mm_malloc(max_bytes,64ULL))};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       memset_dispatch_ps(src,1.0f,max_n);
+       memset_dispatch_ps(dst,0.0f,max_n);
+       memops_print_tuning();
+       printf("%12s %12s %12s %12s %12s  [GiB/s]\n","bytes","glibc","avx512","avx512_nt","dispatch");
+       for(std::size_t nbytes{min_bytes}; nbytes <= max_bytes; nbytes *= 2ull)
+       {
+            const std::size_t sz{nbytes/sizeof(float)};
+            const int32_t ns{nbytes >= 16777216ull ? 4 : n_samples};
+            const double g{perf_test_best_gibs(&glibc_copy,dst,src,sz,ns)};
+            const double c{perf_test_best_gibs(&avx512_memcpy_unroll8x_ps,dst,src,sz,ns)};
+            const double u{perf_test_best_gibs(&avx512_uncached_memcpy_unroll8x_ps,dst,src,sz,ns)};
+            const double d{perf_test_best_gibs(&dispatch_copy,dst,src,sz,ns)};
+            printf("%12zu %12.3f %12.3f %12.3f %12.3f\n",nbytes,g,c,u,d);
+       }
+       gms_mm_free(dst);
+       gms_mm_free(src);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main()
+{
+    perf_test_memops_dispatch();
+    return 0;
+}
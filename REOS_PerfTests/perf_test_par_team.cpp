@@ -0,0 +1,179 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_par_team.h"
+
+/*
+    icpc -o perf_test_par_team -O3 -fp-model fast=2 -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+    GMS_config.h GMS_par_team.h GMS_par_team.cpp perf_test_par_team.cpp -lpthread
+
+    A pipeline of 200 short kernels (sdotv_zmm16r4 and scrossv_zmm16r4 loops of the
+    *_omp family, argv[1] __m512 elements per array, default 2048), every kernel
+    consuming the output of the previous one, run:
+    serially, one 'omp parallel for schedule(dynamic)' per kernel (as the *_omp entry
+    points), one 'omp parallel for schedule(static)' per kernel, one par_for per
+    kernel (worker team, calibrated threshold) and the whole pipeline as one
+    par_region (one dispatch, a barrier between the kernels).
+    The tuning of the team is printed first. Run with OMP_PROC_BIND=close OMP_PLACES=cores.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       constexpr int32_t NKERNELS{200};
+
+       struct arrays_t
+       {
+              __m512 * x;
+              __m512 * y;
+              __m512 * z;
+              __m512 * d;
+       };
+
+       // the loop bodies of sdotv_zmm16r4_unroll6x_omp and scrossv_zmm16r4_unroll6x_omp, [lo,hi)
+       __ATTR_ALWAYS_INLINE__
+       inline void sdotv_range(const arrays_t & a,const std::size_t lo,const std::size_t hi)
+       {
+              for(std::size_t __i{lo}; __i != hi; ++__i)
+                  a.d[__i] = _mm512_fmadd_ps(a.x[__i],a.y[__i],_mm512_fmadd_ps(a.y[__i],a.z[__i],_mm512_mul_ps(a.z[__i],a.x[__i])));
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void scrossv_range(const arrays_t & a,const std::size_t lo,const std::size_t hi)
+       {
+              for(std::size_t __i{lo}; __i != hi; ++__i)
+              {
+                  const __m512 c{_mm512_fmsub_ps(a.x[__i],a.d[__i],_mm512_mul_ps(a.y[__i],a.z[__i]))};
+                  a.z[__i] = _mm512_mul_ps(_mm512_set1_ps(0.5f),c);
+              }
+       }
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              f();
+              for(int32_t __r{0}; __r != 7; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+}
+
+void perf_test_par_team_pipeline(const std::size_t);
+
+void perf_test_par_team_pipeline(const std::size_t n)
+{
+       using namespace gms::common;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       par_print_tuning();
+       arrays_t a;
+       a.x = reinterpret_cast<__m512*>(_mm_malloc(sizeof(__m512)*n,64ull));
+       a.y = reinterpret_cast<__m512*>(_mm_malloc(sizeof(__m512)*n,64ull));
+       a.z = reinterpret_cast<__m512*>(_mm_malloc(sizeof(__m512)*n,64ull));
+       a.d = reinterpret_cast<__m512*>(_mm_malloc(sizeof(__m512)*n,64ull));
+       auto reset = [&]{
+              for(std::size_t __i{0ull}; __i != n; ++__i)
+              {
+                     a.x[__i] = _mm512_set1_ps(1.0f);
+                     a.y[__i] = _mm512_set1_ps(0.5f);
+                     a.z[__i] = _mm512_set1_ps(0.25f);
+                     a.d[__i] = _mm512_setzero_ps();
+              }
+       };
+       const int64_t ni{static_cast<int64_t>(n)};
+       const struct { const char * name; int32_t v; } variants[] = {
+              {"serial",                        0},
+              {"omp parallel for, dynamic",     1},
+              {"omp parallel for, static",      2},
+              {"par_for per kernel",            3},
+              {"par_region, whole pipeline",    4}};
+       double t_ser{0.0};
+       for(const auto & var : variants)
+       {
+              const double t{best_of([&]{
+                     reset();
+                     switch(var.v)
+                     {
+                            case 0 :
+                                 for(int32_t __k{0}; __k != NKERNELS; ++__k)
+                                 {
+                                     if(__k & 1) scrossv_range(a,0ull,n); else sdotv_range(a,0ull,n);
+                                 }
+                                 break;
+                            case 1 :
+                                 for(int32_t __k{0}; __k != NKERNELS; ++__k)
+                                 {
+#pragma omp parallel for schedule(dynamic) default(none) shared(a,ni,__k)
+                                     for(int64_t __i = 0; __i < ni; ++__i)
+                                     {
+                                         if(__k & 1) scrossv_range(a,__i,__i+1); else sdotv_range(a,__i,__i+1);
+                                     }
+                                 }
+                                 break;
+                            case 2 :
+                                 for(int32_t __k{0}; __k != NKERNELS; ++__k)
+                                 {
+#pragma omp parallel for schedule(static) default(none) shared(a,ni,__k)
+                                     for(int64_t __i = 0; __i < ni; ++__i)
+                                     {
+                                         if(__k & 1) scrossv_range(a,__i,__i+1); else sdotv_range(a,__i,__i+1);
+                                     }
+                                 }
+                                 break;
+                            case 3 :
+                                 for(int32_t __k{0}; __k != NKERNELS; ++__k)
+                                 {
+                                     if(__k & 1)
+                                        par_for(par_family::ARITH,n,sizeof(__m512),1,
+                                                [&](std::size_t lo,std::size_t hi) { scrossv_range(a,lo,hi); });
+                                     else
+                                        par_for(par_family::STREAM,n,sizeof(__m512),1,
+                                                [&](std::size_t lo,std::size_t hi) { sdotv_range(a,lo,hi); });
+                                 }
+                                 break;
+                            case 4 :
+                                 par_region(par_family::STREAM,n*NKERNELS,[&](const par_ctx_t & ctx) {
+                                      for(int32_t __k{0}; __k != NKERNELS; ++__k)
+                                      {
+                                          if(__k & 1)
+                                             ctx.for_static(n,sizeof(__m512),1,[&](std::size_t lo,std::size_t hi) { scrossv_range(a,lo,hi); });
+                                          else
+                                             ctx.for_static(n,sizeof(__m512),1,[&](std::size_t lo,std::size_t hi) { sdotv_range(a,lo,hi); });
+                                          // the chunks are the same in every kernel, the
+                                          // barrier stands for a kernel reading other chunks
+                                          ctx.barrier();
+                                      }
+                                 });
+                                 break;
+                     }
+              })};
+              if(var.v == 0) t_ser = t;
+              float chk[16];
+              _mm512_storeu_ps(chk,a.z[n-1ull]);
+              printf("--- %-28s: %9.3f ms, %8.2f us/kernel, %5.2fx against serial, chk %g\n",var.name,1.0e3*t,
+                     1.0e6*t/NKERNELS,t_ser/t,static_cast<double>(chk[0]));
+       }
+       _mm_free(a.x);
+       _mm_free(a.y);
+       _mm_free(a.z);
+       _mm_free(a.d);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const std::size_t n{(argc > 1) ? static_cast<std::size_t>(std::atoll(argv[1])) : 2048ull};
+    perf_test_par_team_pipeline(n);
+    return 0;
+}
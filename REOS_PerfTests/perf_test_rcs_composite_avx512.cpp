@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_rcs_composite_avx512.h"
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+/*
+    icpc -o perf_test_rcs_composite_avx512 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp GMS_rcs_composite_avx512.h GMS_rcs_composite_avx512.cpp \
+    perf_test_rcs_composite_avx512.cpp
+
+    Mixed target batch (argv[1] targets, default 1000000), k0a log-uniform in [0.01,100], unsorted:
+    exact solution on every lane (what a caller without region selection has to do), composite evaluated
+    register by register (masked blend) and the grouped batch driver.
+*/
+
+namespace {
+
+       template<typename F>
+       double time_best(F && f,const int32_t reps)
+       {
+              double best{std::numeric_limits<double>::max()};
+              for(int32_t __r{0}; __r != reps; ++__r)
+              {
+                  const double t0{omp_get_wtime()};
+                  f();
+                  best = std::min(best,omp_get_wtime()-t0);
+              }
+              return (best);
+       }
+
+       // register by register, no grouping (the small batch path for any n)
+       void composite_in_order(const float * __restrict k0,
+                               const float * __restrict a,
+                               const int32_t n,
+                               const int32_t body,
+                               const gms::radiolocation::RCS_RegionBounds & rb,
+                               float * __restrict rcs)
+       {
+              using namespace gms::radiolocation;
+#pragma omp parallel for schedule(dynamic,64) default(none) shared(k0,a,n,body,rb,rcs)
+              for(int32_t __i = 0; __i < n/16; ++__i)
+              {
+                  __m512 r;
+                  const __m512 vk{_mm512_loadu_ps(&k0[16*__i])};
+                  const __m512 va{_mm512_loadu_ps(&a[16*__i])};
+                  if(body == 0) rcs_sphere_composite_zmm16r4(vk,va,rb,&r,nullptr);
+                  else          rcs_cylinder_composite_zmm16r4(vk,va,RCS_CYL_POL__E,rb,&r,nullptr);
+                  _mm512_storeu_ps(&rcs[16*__i],r);
+              }
+       }
+
+}
+
+void perf_test_rcs_composite_avx512(const int32_t);
+
+void perf_test_rcs_composite_avx512(const int32_t n)
+{
+       using namespace gms::radiolocation;
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::mt19937 rng(77);
+       std::uniform_real_distribution<float> ul(-2.0f,2.0f);
+       std::vector<float> k0(n), a(n,0.1f), r0(n), r1(n), r2(n);
+       for(int32_t __i{0}; __i != n; ++__i) k0[__i] = std::pow(10.0f,ul(rng))/a[__i];
+       int32_t cnt[3] = {};
+       const RCS_RegionBounds sb{rcs_sphere_region_bounds()};
+       const RCS_RegionBounds cb{rcs_cylinder_region_bounds()};
+       for(int32_t __i{0}; __i != n; ++__i)
+       {
+           const float x{k0[__i]*a[__i]};
+           ++cnt[(x < sb.k0a_rayleigh) ? 0 : (x >= sb.k0a_optics) ? 2 : 1];
+       }
+       printf("%d targets, threads=%d, sphere regions: Rayleigh=%d resonance=%d optics=%d\n",
+              n,omp_get_max_threads(),cnt[0],cnt[1],cnt[2]);
+       const int32_t reps{3};
+       RCS_RegionBounds ex;                                   // every lane in the resonance region
+       ex.k0a_rayleigh = 0.0f;
+       ex.k0a_optics   = std::numeric_limits<float>::max();
+       for(int32_t __b{0}; __b != 2; ++__b)
+       {
+           const RCS_RegionBounds & rb{(__b == 0) ? sb : cb};
+           const double te{time_best([&]{ if(__b == 0) rcs_mie_sphere_sweep_zmm16r4_omp(k0.data(),a.data(),nullptr,nullptr,n,r0.data());
+                                          else         composite_in_order(k0.data(),a.data(),n,1,ex,r0.data());},reps)};
+           const double to{time_best([&]{ composite_in_order(k0.data(),a.data(),n,__b,rb,r1.data());},reps)};
+           const double tg{time_best([&]{ if(__b == 0) rcs_sphere_composite_omp(k0.data(),a.data(),n,rb,r2.data());
+                                          else         rcs_cylinder_composite_omp(k0.data(),a.data(),n,RCS_CYL_POL__E,rb,r2.data());},reps)};
+           double dmax{0.0};
+           for(int32_t __i{0}; __i != (n/16)*16; ++__i)
+               dmax = std::max(dmax,std::fabs(10.0*std::log10(static_cast<double>(r2[__i])/static_cast<double>(r0[__i]))));
+           printf("%s: exact on all lanes %.4f s (%.2f Mtargets/s), composite in order %.4f s (%.2f), grouped %.4f s (%.2f), "
+                  "speedup %.1fx, max |composite - exact| %.3f dB\n",
+                  (__b == 0) ? "sphere" : "cylinder E",te,1.0e-6*n/te,to,1.0e-6*n/to,tg,1.0e-6*n/tg,te/tg,dmax);
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t n{(argc > 1) ? std::atoi(argv[1]) : 1000000};
+    perf_test_rcs_composite_avx512(n);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_rcs_po_facets_bvh_omp.h"
+
+/*
+    icpc -o perf_test_rcs_po_facets_bvh_omp -O3 -fp-model precise -qopenmp -ggdb -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_rcs_po_facets_bvh_omp.h GMS_rcs_po_facets_bvh_omp.cpp perf_test_rcs_po_facets_bvh_omp.cpp
+
+    Geodesic sphere (20*4^nsub facets, nsub=argv[1], default 7) standing on a square ground
+    plate (non-convex scene, the sphere shadows part of the plate).
+    Reports the BVH build time and the aspects/s of a theta-phi sweep with and without
+    the shadow rays. Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the aspect parallelism.
+*/
+
+static void perf_test_scene(std::vector<double> & xs,std::vector<double> & ys,std::vector<double> & zs,
+                            std::vector<int32_t> & tri,const int32_t nsub)
+{
+       const double t{0.5*(1.0+std::sqrt(5.0))};
+       std::vector<double> v = {-1,t,0, 1,t,0, -1,-t,0, 1,-t,0, 0,-1,t, 0,1,t,
+                                0,-1,-t, 0,1,-t, t,0,-1, t,0,1, -t,0,-1, -t,0,1};
+       std::vector<int32_t> f = {0,11,5, 0,5,1, 0,1,7, 0,7,10, 0,10,11, 1,5,9, 5,11,4, 11,10,2, 10,7,6, 7,1,8,
+                                 3,9,4, 3,4,2, 3,2,6, 3,6,8, 3,8,9, 4,9,5, 2,4,11, 6,2,10, 8,6,7, 9,8,1};
+       auto norm = [&v](int32_t i) {
+            const double l{std::sqrt(v[3*i]*v[3*i]+v[3*i+1]*v[3*i+1]+v[3*i+2]*v[3*i+2])};
+            v[3*i] /= l; v[3*i+1] /= l; v[3*i+2] /= l;
+       };
+       for(int32_t __i{0}; __i != 12; ++__i) norm(__i);
+       for(int32_t __s{0}; __s != nsub; ++__s)
+       {
+           std::map<std::pair<int32_t,int32_t>,int32_t> mid;
+           auto midpoint = [&](int32_t a,int32_t b) {
+                const std::pair<int32_t,int32_t> key{std::min(a,b),std::max(a,b)};
+                auto it = mid.find(key);
+                if(it != mid.end()) return it->second;
+                const int32_t id{static_cast<int32_t>(v.size()/3)};
+                for(int32_t __k{0}; __k != 3; ++__k) v.push_back(0.5*(v[3*a+__k]+v[3*b+__k]));
+                norm(id);
+                mid.emplace(key,id);
+                return id;
+           };
+           std::vector<int32_t> g;
+           g.reserve(4*f.size());
+           for(std::size_t __t{0}; __t != f.size(); __t += 3)
+           {
+                const int32_t a{f[__t]}, b{f[__t+1]}, c{f[__t+2]};
+                const int32_t ab{midpoint(a,b)}, bc{midpoint(b,c)}, ca{midpoint(c,a)};
+                g.insert(g.end(),{a,ab,ca, b,bc,ab, c,ca,bc, ab,bc,ca});
+           }
+           f.swap(g);
+       }
+       // unit sphere centered at z=1.05, outward facets
+       for(std::size_t __i{0}; __i != v.size()/3; ++__i)
+       {
+           xs.push_back(v[3*__i]); ys.push_back(v[3*__i+1]); zs.push_back(v[3*__i+2]+1.05);
+       }
+       for(std::size_t __t{0}; __t != f.size(); __t += 3)
+       {
+           int32_t a{f[__t]}, b{f[__t+1]}, c{f[__t+2]};
+           double e1[3],e2[3],cn{0.0};
+           for(int32_t __k{0}; __k != 3; ++__k) {e1[__k] = v[3*b+__k]-v[3*a+__k]; e2[__k] = v[3*c+__k]-v[3*a+__k];}
+           const double n[3] = {e1[1]*e2[2]-e1[2]*e2[1],e1[2]*e2[0]-e1[0]*e2[2],e1[0]*e2[1]-e1[1]*e2[0]};
+           for(int32_t __k{0}; __k != 3; ++__k) cn += n[__k]*v[3*a+__k];
+           if(cn < 0.0) std::swap(b,c);
+           tri.insert(tri.end(),{a,b,c});
+       }
+       // 6x6 ground plate at z=0
+       const int32_t np{static_cast<int32_t>(std::sqrt(static_cast<double>(f.size()/3)/2.0))};
+       const int32_t base{static_cast<int32_t>(xs.size())};
+       for(int32_t __j{0}; __j <= np; ++__j)
+           for(int32_t __i{0}; __i <= np; ++__i)
+           {
+                xs.push_back(-3.0+6.0*__i/np); ys.push_back(-3.0+6.0*__j/np); zs.push_back(0.0);
+           }
+       for(int32_t __j{0}; __j != np; ++__j)
+           for(int32_t __i{0}; __i != np; ++__i)
+           {
+                const int32_t p{base+__j*(np+1)+__i};
+                tri.insert(tri.end(),{p,p+1,p+np+2, p,p+np+2,p+np+1});
+           }
+}
+
+void perf_test_rcs_po_facets_bvh_omp(const int32_t);
+
+void perf_test_rcs_po_facets_bvh_omp(const int32_t nsub)
+{
+       using namespace gms::radiolocation;
+       constexpr int32_t nth{32};
+       constexpr int32_t nph{32};
+       constexpr int32_t n_samples{3};
+       constexpr double k0{40.0};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::vector<double> xs,ys,zs;
+       std::vector<int32_t> tri;
+       perf_test_scene(xs,ys,zs,tri,nsub);
+       const int32_t ntri{static_cast<int32_t>(tri.size()/3)};
+       PO_Facets f;
+       const double t0{omp_get_wtime()};
+       if(!po_facets_build(xs.data(),ys.data(),zs.data(),tri.data(),ntri,3,0,f))
+       {
+          printf("po_facets_build -- allocation failure\n");
+          std::exit(EXIT_FAILURE);
+       }
+       const double t1{omp_get_wtime()};
+       printf("facets=%d, BVH nodes=%d, build=%.4f [s], threads=%d\n",f.nf,f.nnodes,t1-t0,omp_get_max_threads());
+       std::vector<double> th,ph,rcs(nth*nph);
+       for(int32_t __p{0}; __p != nph; ++__p)
+           for(int32_t __t{0}; __t != nth; ++__t)
+           {
+                th.push_back(1.4*static_cast<double>(__t)/nth);
+                ph.push_back(6.2831853071795864769*static_cast<double>(__p)/nph);
+           }
+       printf("%-24s %12s %12s %14s\n","mode","time [s]","aspects/s","facets*asp/s");
+       for(const bool shadowing : {false,true})
+       {
+           double best{1.0e+30};
+           for(int32_t __j{0}; __j != n_samples; ++__j)
+           {
+                const double s0{omp_get_wtime()};
+                po_rcs_monostatic_omp(f,th.data(),ph.data(),nth*nph,k0,shadowing,false,rcs.data());
+                const double s1{omp_get_wtime()};
+                best = std::min(best,s1-s0);
+           }
+           const double aps{static_cast<double>(nth*nph)/best};
+           printf("%-24s %12.4f %12.1f %14.4e\n",shadowing ? "back-face + shadow rays" : "back-face culling",
+                  best,aps,aps*static_cast<double>(f.nf));
+       }
+       po_facets_free(f);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nsub{(argc > 1) ? std::atoi(argv[1]) : 7};
+    perf_test_rcs_po_facets_bvh_omp(nsub);
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+/*
+    icpc -o perf_test_rcs_sphere_mie_avx512 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp perf_test_rcs_sphere_mie_avx512.cpp
+
+    Frequency sweep (argv[1] points, default 100000) of a PEC calibration sphere, k0a from 0.05 to
+    argv[2] (default 50): Mie series (zmm16r4, zmm8r8, scalar reference) versus the closed form
+    region approximations, Rayleigh (Handbook 3.2-5) and optics (pi*a^2), including their errors
+    against the exact series inside and outside of their regions.
+*/
+
+namespace {
+
+       // Handbook 1, formula 3.2-5, sigma/(pi*a^2) = 9*(k0a)^4*(1 - 0.185*(k0a)^2 + ...), 16 lanes
+       inline __m512 rcs_rayleigh_325_zmm16r4(const __m512 k0,
+                                              const __m512 a) {
+              const __m512 k0a{_mm512_mul_ps(k0,a)};
+              const __m512 x2{_mm512_mul_ps(k0a,k0a)};
+              const __m512 x4{_mm512_mul_ps(x2,x2)};
+              const __m512 s{_mm512_fmadd_ps(_mm512_fmsub_ps(_mm512_set1_ps(0.04635116598079561f),x2,
+                                                             _mm512_set1_ps(0.185185185185185185f)),x2,_mm512_set1_ps(1.0f))};
+              return (_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(28.274333882308139f),_mm512_mul_ps(a,a)),_mm512_mul_ps(x4,s)));
+       }
+
+       inline __m512 rcs_optics_zmm16r4(const __m512 a) {
+              return (_mm512_mul_ps(_mm512_set1_ps(3.14159265358979323846f),_mm512_mul_ps(a,a)));
+       }
+
+}
+
+void perf_test_rcs_sphere_mie_avx512(const int32_t,const float);
+
+void perf_test_rcs_sphere_mie_avx512(const int32_t n,const float xmax)
+{
+       using namespace gms::radiolocation;
+       constexpr int32_t n_samples{3};
+       constexpr float a{0.1f};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::vector<float> k4(n), a4(n,a), r4(n), ap(n);
+       std::vector<double> k8(n), a8(n,a), r8(n);
+       for(int32_t __i{0}; __i != n; ++__i)
+       {
+           k4[__i] = (0.05f+(xmax-0.05f)*static_cast<float>(__i)/(n-1))/a;
+           k8[__i] = static_cast<double>(k4[__i]);
+       }
+       double best4{1.0e+30}, best8{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           double t0{omp_get_wtime()};
+           rcs_mie_sphere_sweep_zmm16r4_omp(k4.data(),a4.data(),nullptr,nullptr,n,r4.data());
+           best4 = std::min(best4,omp_get_wtime()-t0);
+           t0 = omp_get_wtime();
+           rcs_mie_sphere_sweep_zmm8r8_omp(k8.data(),a8.data(),nullptr,nullptr,n,r8.data());
+           best8 = std::min(best8,omp_get_wtime()-t0);
+       }
+       const int32_t nref{std::min(n,20000)};
+       double sink{0.0};
+       double t0{omp_get_wtime()};
+       for(int32_t __i{0}; __i < n; __i += n/nref)
+           sink += rcs_mie_sphere_r8(k8[__i],a8[__i],{0.0,0.0},true,nullptr,nullptr,nullptr);
+       const double tref{omp_get_wtime()-t0};
+       printf("threads=%d, %d frequencies, k0a = 0.05 .. %.1f\n",omp_get_max_threads(),n,xmax);
+       printf("Mie zmm16r4 sweep : %10.4f s %14.1f spheres/s\n",best4,n/best4);
+       printf("Mie zmm8r8  sweep : %10.4f s %14.1f spheres/s\n",best8,n/best8);
+       printf("Mie scalar r8     : %10.4f s %14.1f spheres/s (1 thread, sink=%g)\n",tref,nref/tref,sink);
+       // closed form approximations
+       double bestr{1.0e+30}, besto{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           t0 = omp_get_wtime();
+           for(int32_t __i{0}; __i+16 <= n; __i += 16)
+               _mm512_storeu_ps(&ap[__i],rcs_rayleigh_325_zmm16r4(_mm512_loadu_ps(&k4[__i]),_mm512_loadu_ps(&a4[__i])));
+           bestr = std::min(bestr,omp_get_wtime()-t0);
+           t0 = omp_get_wtime();
+           for(int32_t __i{0}; __i+16 <= n; __i += 16)
+               _mm512_storeu_ps(&ap[__i],rcs_optics_zmm16r4(_mm512_loadu_ps(&a4[__i])));
+           besto = std::min(besto,omp_get_wtime()-t0);
+       }
+       printf("Rayleigh 3.2-5    : %10.4f s %14.1f spheres/s (1 thread)\n",bestr,n/bestr);
+       printf("Optics pi*a^2     : %10.4f s %14.1f spheres/s (1 thread)\n",besto,n/besto);
+       // accuracy of the approximations against the exact series (dB)
+       const float edges[5] = {0.0f,0.4f,1.0f,20.0f,1.0e+30f};
+       for(int32_t __r{0}; __r != 4; ++__r)
+       {
+           double er{0.0}, eo{0.0};
+           int32_t cnt{0};
+           for(int32_t __i{0}; __i+16 <= n; __i += 16)
+           {
+               const __m512 ray{rcs_rayleigh_325_zmm16r4(_mm512_loadu_ps(&k4[__i]),_mm512_loadu_ps(&a4[__i]))};
+               alignas(64) float rr[16];
+               _mm512_store_ps(rr,ray);
+               for(int32_t __k{0}; __k != 16; ++__k)
+               {
+                   const float x{k4[__i+__k]*a};
+                   if(x < edges[__r] || x >= edges[__r+1]) continue;
+                   er = std::max(er,std::fabs(10.0*std::log10(rr[__k]/r8[__i+__k])));
+                   eo = std::max(eo,std::fabs(10.0*std::log10(3.14159265358979323846*a*a/r8[__i+__k])));
+                   ++cnt;
+               }
+           }
+           if(cnt != 0)
+              printf("k0a in [%5.1f,%7.1f): max |error| Rayleigh %8.2f dB, optics %8.2f dB (%d points)\n",
+                     edges[__r],std::min(edges[__r+1],xmax),er,eo,cnt);
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t n{(argc > 1) ? std::atoi(argv[1]) : 100000};
+    const float xmax{(argc > 2) ? static_cast<float>(std::atof(argv[2])) : 50.0f};
+    perf_test_rcs_sphere_mie_avx512(n,xmax);
+    return 0;
+}
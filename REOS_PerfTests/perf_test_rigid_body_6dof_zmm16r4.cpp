@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_rigid_body_6dof_zmm16r4.h"
+#include "GMS_par_team.h"
+
+/*
+    icpc -o perf_test_rigid_body_6dof_zmm16r4 -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    -DENABLE_AVX512F GMS_config.h GMS_par_team.h GMS_par_team.cpp GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_rigid_body_6dof_zmm16r4.h GMS_rigid_body_6dof_zmm16r4.cpp \
+    perf_test_rigid_body_6dof_zmm16r4.cpp
+
+    argv[1] bodies (default 10^5, rounded up to a multiple of 16), argv[2]
+    steps per call (default 100): RK4 steps of the batched propagator (state
+    held in registers over the steps of a call) against a scalar double RK4
+    of a body at a time (array of structures), the emission of the 9x16
+    rotation matrices and of the LOS outputs after the steps, and the
+    propagator on the worker team. Printed: best of 5 runs, ns per body-step
+    (ns per body for the outputs).
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       using namespace gms::math;
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 5; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+       volatile double sink;
+
+       // x[0..12] state, c[0..8] ix,iy,iz,f,tau
+       inline void rhs(const double * x,const double * c,const double g,double * d)
+       {
+              const double q0{x[0]},q1{x[1]},q2{x[2]},q3{x[3]},wx{x[4]},wy{x[5]},wz{x[6]};
+              d[0] = -0.5*(q1*wx+q2*wy+q3*wz);
+              d[1] =  0.5*(q0*wx+q2*wz-q3*wy);
+              d[2] =  0.5*(q0*wy+q3*wx-q1*wz);
+              d[3] =  0.5*(q0*wz+q1*wy-q2*wx);
+              d[4] = ((c[1]-c[2])*wy*wz+c[6])/c[0];
+              d[5] = ((c[2]-c[0])*wz*wx+c[7])/c[1];
+              d[6] = ((c[0]-c[1])*wx*wy+c[8])/c[2];
+              d[7] = x[10]; d[8] = x[11]; d[9] = x[12];
+              const double fx{c[3]},fy{c[4]},fz{c[5]};
+              d[10] = (1.0-2.0*(q2*q2+q3*q3))*fx+2.0*(q1*q2-q0*q3)*fy+2.0*(q1*q3+q0*q2)*fz;
+              d[11] = 2.0*(q1*q2+q0*q3)*fx+(1.0-2.0*(q1*q1+q3*q3))*fy+2.0*(q2*q3-q0*q1)*fz;
+              d[12] = 2.0*(q1*q3-q0*q2)*fx+2.0*(q2*q3+q0*q1)*fy+(1.0-2.0*(q1*q1+q2*q2))*fz+g;
+       }
+
+       void rk4_scalar(double * x,const double * c,const double g,const double dt,const int32_t nsteps,const int32_t re)
+       {
+              double k1[13],k2[13],k3[13],k4[13],y[13];
+              for(int32_t __s{0}; __s != nsteps; ++__s)
+              {
+                     rhs(x,c,g,k1);
+                     for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+0.5*dt*k1[__i];
+                     rhs(y,c,g,k2);
+                     for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+0.5*dt*k2[__i];
+                     rhs(y,c,g,k3);
+                     for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+dt*k3[__i];
+                     rhs(y,c,g,k4);
+                     for(int32_t __i{0}; __i != 13; ++__i) x[__i] += dt/6.0*(k1[__i]+2.0*k2[__i]+2.0*k3[__i]+k4[__i]);
+                     if((__s+1)%re == 0)
+                     {
+                            const double nq{1.0/std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]+x[3]*x[3])};
+                            for(int32_t __i{0}; __i != 4; ++__i) x[__i] *= nq;
+                     }
+              }
+       }
+
+}
+
+void perf_test_rigid_body_6dof_zmm16r4(const int32_t,const int32_t);
+
+void perf_test_rigid_body_6dof_zmm16r4(const int32_t nbodies,const int32_t nsteps)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       const int32_t n{(nbodies+15)/16};
+       const int32_t nb{16*n};
+       // 13 state, 9 inertias and loads, 9 rows, 8 LOS outputs
+       std::vector<std::vector<__m512>> a(13+9+9+8,std::vector<__m512>(static_cast<std::size_t>(n)));
+       std::vector<double> aos(static_cast<std::size_t>(nb)*22);
+       std::mt19937 g(5050);
+       std::normal_distribution<double> nd(0.0,1.0);
+       std::uniform_real_distribution<double> ud(-1.0,1.0);
+       std::uniform_real_distribution<double> ui(1.0,10.0);
+       for(int32_t __b{0}; __b != nb; ++__b)
+       {
+              double * x{&aos[22*__b]};
+              const double q[4] = {nd(g),nd(g),nd(g),nd(g)};
+              const double nq{std::sqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3])};
+              for(int32_t __i{0}; __i != 4; ++__i) x[__i] = q[__i]/nq;
+              for(int32_t __i{4}; __i != 7; ++__i)  x[__i] = ud(g);
+              for(int32_t __i{7}; __i != 10; ++__i) x[__i] = 1000.0*ud(g);
+              for(int32_t __i{10}; __i != 13; ++__i) x[__i] = 100.0*ud(g);
+              for(int32_t __i{13}; __i != 16; ++__i) x[__i] = ui(g);
+              for(int32_t __i{16}; __i != 22; ++__i) x[__i] = 5.0*ud(g);
+              for(int32_t __k{0}; __k != 22; ++__k)
+                     reinterpret_cast<float*>(a[__k].data())[__b] = static_cast<float>(x[__k]);
+       }
+       RB6DofState s;
+       s.q0 = a[0].data(); s.q1 = a[1].data(); s.q2 = a[2].data(); s.q3 = a[3].data();
+       s.wx = a[4].data(); s.wy = a[5].data(); s.wz = a[6].data();
+       s.pn = a[7].data(); s.pe = a[8].data(); s.pd = a[9].data();
+       s.vn = a[10].data(); s.ve = a[11].data(); s.vd = a[12].data();
+       s.nstep = 0;
+       RB6DofLoads l;
+       l.ix = a[13].data(); l.iy = a[14].data(); l.iz = a[15].data();
+       l.fx = a[16].data(); l.fy = a[17].data(); l.fz = a[18].data();
+       l.tx = a[19].data(); l.ty = a[20].data(); l.tz = a[21].data();
+       RB6DofRMat9x16 m;
+       m.row1 = a[22].data(); m.row2 = a[23].data(); m.row3 = a[24].data();
+       m.row4 = a[25].data(); m.row5 = a[26].data(); m.row6 = a[27].data();
+       m.row7 = a[28].data(); m.row8 = a[29].data(); m.row9 = a[30].data();
+       RB6DofLOS los{};
+       los.tn = nullptr; los.te = nullptr; los.td = nullptr;
+       los.tgt[0] = 5000.0f; los.tgt[1] = -2000.0f; los.tgt[2] = -3000.0f;
+       los.ux  = a[31].data(); los.uy = a[32].data(); los.uz = a[33].data();
+       los.tht = a[34].data(); los.phi = a[35].data(); los.az = a[36].data();
+       los.el  = a[37].data(); los.rng = a[38].data();
+       RB6DofParams p;
+       const double bs{static_cast<double>(nb)*static_cast<double>(nsteps)};
+       auto ns  = [bs](const double t) { return (1.0e9*t/bs); };
+       auto nsb = [nb](const double t) { return (1.0e9*t/static_cast<double>(nb)); };
+       const double t_scl{best_of([&]{
+              for(int32_t __b{0}; __b != nb; ++__b)
+              {
+                     double * x{&aos[22*__b]};
+                     rk4_scalar(x,x+13,static_cast<double>(p.g),static_cast<double>(p.dt),nsteps,p.renorm_every);
+              }
+              sink = aos[7];
+       })};
+       const double t_simd{best_of([&]{ rb6dof_propagate_range_zmm16r4(s,l,p,nsteps,0,n,nullptr,nullptr); s.nstep += nsteps; })};
+       const double t_rm{best_of([&]{ rb6dof_rmat9x16_zmm16r4(s,n,m); sink = reinterpret_cast<const float*>(m.row9)[0]; })};
+       // a step with both outputs, less a step without
+       const double t_st1{best_of([&]{ rb6dof_propagate_range_zmm16r4(s,l,p,1,0,n,nullptr,nullptr); s.nstep += 1; })};
+       const double t_out{best_of([&]{ rb6dof_propagate_range_zmm16r4(s,l,p,1,0,n,&m,&los); s.nstep += 1; })};
+       gms::common::par_team_start();
+       const double t_par{best_of([&]{ rb6dof_propagate_zmm16r4(s,l,p,nsteps,n,nullptr,nullptr); })};
+       printf("%d bodies (%d registers), %d steps per call, dt %.3f s\n",nb,n,nsteps,static_cast<double>(p.dt));
+       printf("scalar double RK4, AoS               : %8.3f ns/body-step\n",ns(t_scl));
+       printf("zmm16r4 RK4                          : %8.3f ns/body-step, %5.2fx\n",ns(t_simd),t_scl/t_simd);
+       printf("rotation matrices 9x16 alone         : %8.3f ns/body\n",nsb(t_rm));
+       printf("rotation matrices and LOS after steps: %8.3f ns/body\n",nsb(std::max(0.0,t_out-t_st1)));
+       printf("zmm16r4 RK4 on the team of %2d        : %8.3f ns/body-step, %5.2fx\n",gms::common::par_team_size(),ns(t_par),t_scl/t_par);
+       gms::common::par_team_stop();
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t nb{(argc > 1) ? std::atoi(argv[1]) : 100000};
+    const int32_t ns{(argc > 2) ? std::atoi(argv[2]) : 100};
+    perf_test_rigid_body_6dof_zmm16r4(nb,ns);
+    return 0;
+}
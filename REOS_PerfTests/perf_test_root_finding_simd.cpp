@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_root_finding_simd.hpp"
+
+/*
+    icpc -o perf_test_root_finding_simd -O3 -fp-model precise -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_root_finding_simd.hpp perf_test_root_finding_simd.cpp
+
+    argv[1] root problems (default 2^20) x^3+p*x-q = 0, p and q per problem, the
+    brackets of a different width (so the iteration counts differ per problem):
+    scalar brentq one problem at a time against the array driver (16 floats,
+    4 doubles per register, refilled lanes) and against the block form on
+    consecutive groups of lanes (every group runs to its slowest lane).
+    Printed: best of 5 runs, ns per problem, the speedup and the lane
+    utilization (useful evaluations / (rounds * lanes)).
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       using namespace gms::math;
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 5; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+       // brentq (SciPy brentq.c), the algorithm of the lanes
+       template<typename T>
+       T scalar_brentq(const T p,const T q,const T xa,const T xb,const root_tol_t & tol,int32_t & iters)
+       {
+              auto f = [p,q](const T x) { return (x*(x*x+p)-q); };
+              T xpre{xa},xcur{xb},xblk{0},fblk{0},spre{0},scur{0};
+              T fpre{f(xpre)},fcur{f(xcur)};
+              iters = 0;
+              if(fpre*fcur > T(0)) return (xcur);
+              if(fpre == T(0)) return (xpre);
+              if(fcur == T(0)) return (xcur);
+              const T xtol{static_cast<T>(tol.xtol)},rtol{static_cast<T>(tol.rtol)};
+              for(int32_t __i{0}; __i != tol.maxiter; ++__i)
+              {
+                     if(fpre != T(0) && fcur != T(0) && (std::signbit(fpre) != std::signbit(fcur)))
+                     { xblk = xpre; fblk = fpre; spre = scur = xcur-xpre; }
+                     if(std::abs(fblk) < std::abs(fcur))
+                     { xpre = xcur; xcur = xblk; xblk = xpre; fpre = fcur; fcur = fblk; fblk = fpre; }
+                     const T delta{(xtol+rtol*std::abs(xcur))/T(2)};
+                     const T sbis{(xblk-xcur)/T(2)};
+                     if(fcur == T(0) || std::abs(sbis) < delta) return (xcur);
+                     if(std::abs(spre) > delta && std::abs(fcur) < std::abs(fpre))
+                     {
+                            T stry;
+                            if(xpre == xblk) stry = -fcur*(xcur-xpre)/(fcur-fpre);
+                            else
+                            {
+                                   const T dpre{(fpre-fcur)/(xpre-xcur)},dblk{(fblk-fcur)/(xblk-xcur)};
+                                   stry = -fcur*(fblk*dblk-fpre*dpre)/(dblk*dpre*(fblk-fpre));
+                            }
+                            if(T(2)*std::abs(stry) < std::min(std::abs(spre),T(3)*std::abs(sbis)-delta)) { spre = scur; scur = stry; }
+                            else { spre = sbis; scur = sbis; }
+                     }
+                     else { spre = sbis; scur = sbis; }
+                     xpre = xcur; fpre = fcur;
+                     if(std::abs(scur) > delta) xcur += scur;
+                     else xcur += (sbis > T(0)) ? delta : -delta;
+                     fcur = f(xcur);
+                     ++iters;
+              }
+              return (xcur);
+       }
+
+       inline __m512  gather_v(const float * p,const __m512i idx)   { return (_mm512_i32gather_ps(idx,p,4)); }
+       inline __m256d gather_v(const double * p,const __m128i idx)  { return (_mm256_i32gather_pd(p,idx,8)); }
+
+       template<typename L>
+       void run(const char * name,const int32_t n)
+       {
+              typedef root_simd_traits<L> S;
+              typedef typename S::V V;
+              typedef typename S::T T;
+              typedef typename S::I I;
+              constexpr int32_t NL{S::lanes};
+              std::mt19937 g(4747);
+              std::uniform_real_distribution<T> up(T(0.1),T(4)),uq(T(-20),T(20)),uw(T(0),T(6));
+              std::vector<T> p(n),q(n),a(n),b(n),x(n),fx(n),xs(n);
+              std::vector<int32_t> st(n),it(n),its(n);
+              for(int32_t __i{0}; __i != n; ++__i)
+              {
+                     p[__i] = up(g); q[__i] = uq(g);
+                     // 10^(0..6) wide bracket around [-4,4]
+                     const T w{std::pow(T(10),uw(g))};
+                     a[__i] = T(-4)-w; b[__i] = T(4)+w;
+              }
+              root_tol_t tol;
+              tol.xtol = (sizeof(T) == 8) ? 1.0e-12 : 1.0e-5;
+              tol.rtol = (sizeof(T) == 8) ? 1.0e-12 : 1.0e-6;
+              int64_t rounds{0};
+              auto f = [&](const V xv,const I idx)
+              {
+                     ++rounds;
+                     const V vp{gather_v(p.data(),idx)},vq{gather_v(q.data(),idx)};
+                     return (S::sub(S::mul(xv,S::add(S::mul(xv,xv),vp)),vq));
+              };
+              const double t_s{best_of([&]{ for(int32_t __i{0}; __i != n; ++__i) xs[__i] = scalar_brentq(p[__i],q[__i],a[__i],b[__i],tol,its[__i]); })};
+              rounds = 0;
+              const double t_a{best_of([&]{ (void)root_solve_array<L,root_method_t::BRENTQ>(f,a.data(),b.data(),nullptr,x.data(),fx.data(),st.data(),it.data(),n,tol); })};
+              const int64_t rounds_a{rounds/5};
+              rounds = 0;
+              const double t_b{best_of([&]{
+                     alignas(64) int32_t id[NL];
+                     alignas(64) T xb[NL];
+                     for(int32_t __i{0}; __i+NL <= n; __i += NL)
+                     {
+                            for(int32_t __l{0}; __l != NL; ++__l) id[__l] = __i+__l;
+                            const I idx{S::idx_load(id)};
+                            const V va{gather_v(a.data(),idx)},vb{gather_v(b.data(),idx)};
+                            auto fb = [&](const V xv) { return (f(xv,idx)); };
+                            S::store(xb,root_brentq_simd<L>(fb,va,vb,tol).x);
+                            x[__i] = xb[0];
+                     }
+              })};
+              const int64_t rounds_b{rounds/5};
+              // useful evaluations: f(a), f(b), one per iteration
+              int64_t evals{0};
+              int32_t diff{0};
+              for(int32_t __i{0}; __i != n; ++__i)
+              {
+                     evals += 2+it[__i];
+                     diff  += (its[__i] != it[__i]);
+              }
+              const double dn{static_cast<double>(n)};
+              printf("%s: scalar brentq      : %8.2f ns/problem\n",name,1.0e9*t_s/dn);
+              printf("%s: array driver       : %8.2f ns/problem, %5.2fx, lane utilization %5.1f%%\n",name,1.0e9*t_a/dn,t_s/t_a,
+                     100.0*static_cast<double>(evals)/static_cast<double>(rounds_a*NL));
+              printf("%s: blocks, no refill  : %8.2f ns/problem, %5.2fx, lane utilization %5.1f%%\n",name,1.0e9*t_b/dn,t_s/t_b,
+                     100.0*static_cast<double>(evals)/static_cast<double>(rounds_b*NL));
+              printf("%s: problems with a different iteration count than scalar: %d of %d\n",name,diff,n);
+       }
+
+}
+
+void perf_test_root_finding_simd(const int32_t);
+
+void perf_test_root_finding_simd(const int32_t n)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       run<root_zmm16r4>("__m512 ",n);
+       run<root_ymm4r8>("__m256d",n);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const int32_t n{(argc > 1) ? std::atoi(argv[1]) : (1 << 20)};
+    perf_test_root_finding_simd((n/16)*16);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_spatial_index.h"
+#include <string>
+using std::string; // GMS_triangulation.h expects it
+#include "GMS_triangulation.h"
+
+/*
+    icpc -o perf_test_spatial_index -O3 -fp-model precise -no-fma -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_spatial_index.h GMS_spatial_index.cpp GMS_triangulation.h GMS_triangulation.cpp perf_test_spatial_index.cpp
+
+    Scaling of the build and of the batched queries with the set size N (argv[1] = largest N,
+    default 4000000), nq queries per N. The naive O(N) routines are timed on a subset of the
+    queries and reported per query.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the batched (OpenMP) queries.
+*/
+
+template<typename Kernel>
+static double perf_test_best(Kernel kernel,const int32_t n_samples)
+{
+       double best{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+            const double t0{omp_get_wtime()};
+            kernel();
+            const double t1{omp_get_wtime()};
+            best = std::min(best,t1-t0);
+       }
+       return best;
+}
+
+void perf_test_points(const int32_t);
+
+void perf_test_points(const int32_t nmax)
+{
+       using namespace gms::math;
+       constexpr int32_t nq{1000000};
+       constexpr int32_t nnaive{200};
+       constexpr int32_t k{8};
+       constexpr int32_t n_samples{3};
+       std::mt19937_64 rng(1234ULL);
+       std::uniform_real_distribution<double> u(0.0,1.0);
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("threads=%d, queries=%d\n",omp_get_max_threads(),nq);
+       printf("%3s %9s %12s %12s %12s %12s %12s %12s %12s %12s  [Mquery/s, build: s]\n","dim","N",
+              "naive","kd build","kd near","kd knn8","kd radius","grid build","grid near","grid radius");
+       for(const int32_t dim : {2,3})
+       {
+           std::vector<double> q(static_cast<std::size_t>(dim)*nq);
+           for(double & x : q) x = u(rng);
+           for(int32_t n{10000}; n <= nmax; n *= 10)
+           {
+               std::vector<double> p(static_cast<std::size_t>(dim)*n);
+               for(double & x : p) x = u(rng);
+               // about 8 neighbours per radius query
+               const double r{(dim == 2) ? std::sqrt(8.0/(3.14159265358979*n)) : std::cbrt(6.0/(3.14159265358979*n))};
+               std::vector<int32_t> idx(static_cast<std::size_t>(nq)*k), offs(nq+1);
+               std::vector<double>  dst(static_cast<std::size_t>(nq)*k);
+               double d;
+               int32_t sink{0};
+               const double tn{perf_test_best([&]{
+                    for(int32_t __i{0}; __i != nnaive; ++__i)
+                        sink += points_point_near_naive_nd(dim,n,p.data(),&q[dim*__i],&d);},1)/nnaive};
+               KDTree t;
+               UniformGrid g;
+               const double tkb{perf_test_best([&]{kdtree_build(t,dim,n,p.data()); kdtree_free(t);},n_samples)};
+               const double tgb{perf_test_best([&]{grid_build(g,dim,n,p.data(),0.0); grid_free(g);},n_samples)};
+               kdtree_build(t,dim,n,p.data());
+               grid_build(g,dim,n,p.data(),0.0);
+               const double tkn{perf_test_best([&]{kdtree_knn_batch_omp(t,nq,q.data(),1,idx.data(),dst.data());},n_samples)};
+               const double tkk{perf_test_best([&]{kdtree_knn_batch_omp(t,nq,q.data(),k,idx.data(),dst.data());},n_samples)};
+               const double tkr{perf_test_best([&]{delete [] kdtree_radius_batch_omp(t,nq,q.data(),r,offs.data());},n_samples)};
+               const double tgn{perf_test_best([&]{grid_nearest_batch_omp(g,nq,q.data(),idx.data(),dst.data());},n_samples)};
+               const double tgr{perf_test_best([&]{delete [] grid_radius_batch_omp(g,nq,q.data(),r,offs.data());},n_samples)};
+               printf("%3d %9d %12.4f %12.4f %12.3f %12.3f %12.3f %12.4f %12.3f %12.3f\n",dim,n,1.0e-6/tn,tkb,
+                      1.0e-6*nq/tkn,1.0e-6*nq/tkk,1.0e-6*nq/tkr,tgb,1.0e-6*nq/tgn,1.0e-6*nq/tgr);
+               kdtree_free(t);
+               grid_free(g);
+               if(sink == -7) printf("\n");
+           }
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void perf_test_trilocator(const int32_t);
+
+void perf_test_trilocator(const int32_t nmax)
+{
+       using namespace gms::math;
+       constexpr int32_t np{1000000};
+       constexpr int32_t nnaive{200};
+       constexpr int32_t n_samples{3};
+       std::mt19937_64 rng(99ULL);
+       std::uniform_real_distribution<double> u(0.0,1.0);
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       printf("%10s %12s %12s %12s %12s  [Mpoint/s, build: s]\n","triangles","naive","delaunay walk","loc build","locator");
+       std::vector<double> p(2*np);
+       for(double & x : p) x = u(rng);
+       for(int32_t m{64}; 2*m*m <= 2*nmax; m *= 2)
+       {
+           // jittered m x m grid on the unit square, 2 triangles per cell
+           const int32_t nn{(m+1)*(m+1)};
+           std::vector<double> xy(2*nn);
+           for(int32_t __j{0}; __j <= m; ++__j)
+               for(int32_t __i{0}; __i <= m; ++__i)
+               {
+                   const bool edge{__i == 0 || __j == 0 || __i == m || __j == m};
+                   xy[2*(__j*(m+1)+__i)]   = (__i+(edge ? 0.0 : 0.3*(u(rng)-0.5)))/m;
+                   xy[2*(__j*(m+1)+__i)+1] = (__j+(edge ? 0.0 : 0.3*(u(rng)-0.5)))/m;
+               }
+           std::vector<int32_t> tn;
+           for(int32_t __j{0}; __j != m; ++__j)
+               for(int32_t __i{0}; __i != m; ++__i)
+               {
+                   const int32_t a{__j*(m+1)+__i};
+                   tn.insert(tn.end(),{a,a+1,a+m+2, a,a+m+2,a+m+1});
+               }
+           const int32_t ntri{2*m*m};
+           int32_t * nb{triangulation_neighbor_elements(3,ntri,tn.data())};
+           int32_t sink{0};
+           const double tn0{perf_test_best([&]{
+                for(int32_t __i{0}; __i != nnaive; ++__i)
+                    sink += triangulation_search_naive(nn,xy.data(),3,ntri,tn.data(),&p[2*__i]);},1)/nnaive};
+           const double tw{perf_test_best([&]{
+                for(int32_t __i{0}; __i != np/10; ++__i)
+                {
+                    int32_t ti,edge,steps;
+                    double al,be,ga;
+                    triangulation_search_delaunay(nn,xy.data(),3,ntri,tn.data(),nb,&p[2*__i],&ti,&al,&be,&ga,&edge,&steps);
+                    sink += ti;
+                }},1)/(np/10)};
+           TriLocator l;
+           const double tb{perf_test_best([&]{trilocator_build(l,nn,xy.data(),3,ntri,tn.data()); trilocator_free(l);},n_samples)};
+           trilocator_build(l,nn,xy.data(),3,ntri,tn.data());
+           std::vector<int32_t> ti(np);
+           const double tl{perf_test_best([&]{trilocator_search_batch_omp(l,np,p.data(),ti.data());},n_samples)};
+           printf("%10d %12.4f %12.4f %12.4f %12.3f\n",ntri,1.0e-6/tn0,1.0e-6/tw,tb,1.0e-6*np/tl);
+           trilocator_free(l);
+           delete [] nb;
+           if(sink == -7) printf("\n");
+       }
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nmax{(argc > 1) ? std::atoi(argv[1]) : 4000000};
+    perf_test_points(nmax);
+    perf_test_trilocator(nmax);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_stream_stats.h"
+#include "GMS_par_team.h"
+
+/*
+    icpc -o perf_test_stream_stats -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_par_team.h GMS_par_team.cpp GMS_stream_stats.h GMS_stream_stats.cpp perf_test_stream_stats.cpp
+
+    argv[1] samples (default 2^24) of a lognormal "latency": the one-pass
+    summary (moments, t-digest, 64-bin histogram) of float and of double data
+    against the path of GMS_descriptive_statistics / pmc_events_descriptive_stats
+    (copy, sort, two passes of moments, order statistics of the sorted copy),
+    the parts of the summary alone, a scalar Welford update for reference and
+    the summary on the worker team. Printed: best of 5 runs, ns per sample.
+*/
+
+namespace {
+
+       typedef std::chrono::steady_clock clk;
+
+       using namespace gms::stat;
+
+       template<typename F>
+       double best_of(F && f)
+       {
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 5; ++__r)
+              {
+                     const auto t0{clk::now()};
+                     f();
+                     best = std::min(best,std::chrono::duration<double>(clk::now()-t0).count());
+              }
+              return (best);
+       }
+
+       volatile double sink;
+
+}
+
+void perf_test_stream_stats(const std::size_t);
+
+void perf_test_stream_stats(const std::size_t n)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::mt19937_64 g(4949);
+       std::lognormal_distribution<double> d(5.0,0.5);
+       std::vector<double> x(n);
+       std::vector<float>  xf(n);
+       for(std::size_t __i{0}; __i != n; ++__i) { x[__i] = d(g); xf[__i] = static_cast<float>(x[__i]); }
+       const double dn{static_cast<double>(n)};
+       auto ns = [dn](const double t) { return (1.0e9*t/dn); };
+       // sort-based
+       std::vector<double> c(n);
+       const double t_sort{best_of([&]{
+              std::copy(x.begin(),x.end(),c.begin());
+              std::sort(c.begin(),c.end());
+              double m{0.0};
+              for(double v : c) m += v;
+              m /= dn;
+              double m2{0.0},m3{0.0},m4{0.0};
+              for(double v : c) { const double e{v-m}; const double e2{e*e}; m2 += e2; m3 += e2*e; m4 += e2*e2; }
+              sink = m2+m3+m4+c[n/2]+c[n/100]+c[n-n/100];
+       })};
+       // scalar Welford (moments only)
+       const double t_wel{best_of([&]{
+              double m{0.0},m2{0.0};
+              for(std::size_t __i{0}; __i != n; ++__i)
+              {
+                     const double e{x[__i]-m};
+                     m  += e/static_cast<double>(__i+1);
+                     m2 += e*(x[__i]-m);
+              }
+              sink = m+m2;
+       })};
+       stream_stats_t st{};
+       const double t_sum{best_of([&]{ stream_summary_t s(200.0,0.0,1000.0,64); s.add(x.data(),n); st = s.stats(); })};
+       const double t_sumf{best_of([&]{ stream_summary_t s(200.0,0.0,1000.0,64); s.add(xf.data(),n); sink = s.stats().med; })};
+       const double t_mom{best_of([&]{ stream_moments_t m; m.add(x.data(),n); sink = m.M2; })};
+       const double t_dig{best_of([&]{ tdigest_t t; t.init(200.0); t.add(x.data(),n); t.flush(); sink = t.quantile(0.5); })};
+       const double t_his{best_of([&]{ stream_hist_t h; h.init(0.0,1000.0,64); h.add(x.data(),n); sink = static_cast<double>(h.bin(10)); })};
+       gms::common::par_team_start();
+       const double t_par{best_of([&]{ stream_summary_t s(200.0,0.0,1000.0,64); stream_stats_par(x.data(),n,s); sink = s.stats().med; })};
+       printf("n=%zu: mean %.4f, sd %.4f, skew %.4f, kurt %.4f, median %.4f, midmean %.4f\n",n,st.mean,st.sd,st.skew,st.kurt,st.med,st.midm);
+       printf("sort-based (copy, sort, moments)    : %8.3f ns/sample\n",ns(t_sort));
+       printf("scalar Welford, mean+var only        : %8.3f ns/sample\n",ns(t_wel));
+       printf("summary, double                      : %8.3f ns/sample, %5.2fx\n",ns(t_sum),t_sort/t_sum);
+       printf("summary, float                       : %8.3f ns/sample, %5.2fx\n",ns(t_sumf),t_sort/t_sumf);
+       printf("  moments                            : %8.3f ns/sample\n",ns(t_mom));
+       printf("  t-digest                           : %8.3f ns/sample\n",ns(t_dig));
+       printf("  histogram                          : %8.3f ns/sample\n",ns(t_his));
+       printf("summary on the team of %2d            : %8.3f ns/sample, %5.2fx\n",gms::common::par_team_size(),ns(t_par),t_sort/t_par);
+       gms::common::par_team_stop();
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const std::size_t n{(argc > 1) ? static_cast<std::size_t>(std::atoll(argv[1])) : (1ULL << 24)};
+    perf_test_stream_stats(n);
+    return 0;
+}
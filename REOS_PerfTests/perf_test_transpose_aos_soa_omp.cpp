@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <complex>
+#include <omp.h>
+#include <algorithm>
+#include "GMS_malloc.h"
+#include "GMS_memops_dispatch.h"
+#include "GMS_transpose_aos_soa_omp.h"
+
+/*
+    icpc -o perf_test_transpose_aos_soa_omp -fp-model fast=2 -fno-exceptions -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_malloc.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+    GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+    GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp GMS_memops_dispatch.h GMS_memops_dispatch.cpp \
+    GMS_avx512_transposition_16x16.h GMS_avx512_transposition_16x16.cpp GMS_transpose_aos_soa_omp.h GMS_transpose_aos_soa_omp.cpp perf_test_transpose_aos_soa_omp.cpp
+
+    Reports the best-of-n_samples bandwidth (bytes read + bytes written) of the transposition
+    and of the layout converters next to the calibrated copy of the same volume, i.e. the
+    fraction of the copy bandwidth each reshuffle reaches.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the multi-threaded path.
+*/
+
+template<typename Kernel>
+double perf_test_best_gbs(Kernel kernel,
+                          const std::size_t nbytes,
+                          const int32_t n_samples)
+{
+       double best{1.0e+30};
+       kernel(); // warmup
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+            const double t0{omp_get_wtime()};
+            kernel();
+            const double t1{omp_get_wtime()};
+            best = std::min(best,t1-t0);
+       }
+       return (2.0*static_cast<double>(nbytes))/(best*1.0e+9);
+}
+
+void perf_test_transpose_aos_soa_omp();
+
+void perf_test_transpose_aos_soa_omp()
+{
+       using namespace gms::common;
+       using namespace gms::math;
+       constexpr std::size_t dims[] = {256ull,1024ull,2048ull,4096ull,8192ull};
+       constexpr std::size_t max_n{8192ull*8192ull};
+       constexpr int32_t n_samples{8};
+       float * __restrict__ A{reinterpret_cast<float*>(gms_mm_malloc(max_n*sizeof(float),64ULL))};
+       float * __restrict__ B{reinterpret_cast<float*>(gms_mm_malloc(max_n*sizeof(float),64ULL))};
+       float * __restrict__ C{reinterpret_cast<float*>(gms_mm_malloc(max_n*sizeof(float),64ULL))};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       memset_dispatch_ps(A,1.0f,max_n);
+       memset_dispatch_ps(B,0.0f,max_n);
+       memset_dispatch_ps(C,0.0f,max_n);
+       memops_print_tuning();
+       printf("threads=%d\n",omp_get_max_threads());
+       printf("%8s %12s %12s %12s  [GB/s]\n","n","memcpy","transpose","transpose_ip");
+       for(const std::size_t n : dims)
+       {
+            const std::size_t nb{n*n*sizeof(float)};
+            const double c{perf_test_best_gbs([=]{memcpy_dispatch_ps(B,A,n*n);},nb,n_samples)};
+            const double t{perf_test_best_gbs([=]{transpose_r4_omp(A,n,B,n,n,n);},nb,n_samples)};
+            const double i{perf_test_best_gbs([=]{transpose_r4_ip_omp(B,n,n);},nb,n_samples)};
+            printf("%8zu %12.3f %12.3f %12.3f\n",n,c,t,i);
+       }
+       printf("%12s %12s %12s %12s %12s %12s %12s  [GB/s]\n","records","memcpy","c->split","split->c","xyz->soa","soa->xyz","k5->soa");
+       for(std::size_t nrec{65536ull}; nrec <= max_n/5ull; nrec *= 4ull)
+       {
+            const std::size_t nb2{2ull*nrec*sizeof(float)};
+            const std::size_t nb3{3ull*nrec*sizeof(float)};
+            float * soa5[5] = {C,C+nrec,C+2ull*nrec,C+3ull*nrec,C+4ull*nrec};
+            const double c{perf_test_best_gbs([=]{memcpy_dispatch_ps(B,A,3ull*nrec);},nb3,n_samples)};
+            const double s{perf_test_best_gbs([=]{cinterleaved_to_split_r4_omp(reinterpret_cast<const std::complex<float>*>(A),C,C+nrec,nrec);},nb2,n_samples)};
+            const double m{perf_test_best_gbs([=]{csplit_to_interleaved_r4_omp(C,C+nrec,reinterpret_cast<std::complex<float>*>(B),nrec);},nb2,n_samples)};
+            const double a{perf_test_best_gbs([=]{aos3_to_soa_r4_omp(A,C,C+nrec,C+2ull*nrec,nrec);},nb3,n_samples)};
+            const double o{perf_test_best_gbs([=]{soa3_to_aos_r4_omp(C,C+nrec,C+2ull*nrec,B,nrec);},nb3,n_samples)};
+            const double k{perf_test_best_gbs([=]() mutable {aos_to_soa_r4_omp(A,5ull,&soa5[0],nrec);},5ull*nrec*sizeof(float),n_samples)};
+            printf("%12zu %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f\n",nrec,c,s,m,a,o,k);
+       }
+       gms_mm_free(C);
+       gms_mm_free(B);
+       gms_mm_free(A);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main()
+{
+    perf_test_transpose_aos_soa_omp();
+    return 0;
+}
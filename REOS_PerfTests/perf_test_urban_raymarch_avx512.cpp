@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_urban_raymarch_avx512.h"
+
+/*
+    icpc -o perf_test_urban_raymarch_avx512 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    GMS_config.h GMS_urban_raymarch_avx512.h GMS_urban_raymarch_avx512.cpp perf_test_urban_raymarch_avx512.cpp
+
+    Radar coverage of a 4096x4096 (1 m) synthetic city: argv[1] street receivers (default 1000000),
+    urban_los_batch_omp (max-mipmap march) versus the scalar cell by cell urban_los_r4 over the
+    first argv[2] receivers (default 100000), then urban_radar_coverage_omp with the reflections.
+    Run with OMP_NUM_THREADS/OMP_PLACES set to exercise the receiver parallelism.
+*/
+
+void perf_test_urban_raymarch_avx512(const int32_t,const int32_t);
+
+void perf_test_urban_raymarch_avx512(const int32_t nrx,const int32_t nref)
+{
+       using namespace gms::radiolocation;
+       constexpr int32_t n{4096};
+       constexpr int32_t n_samples{3};
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       std::mt19937_64 rng(1ULL);
+       std::vector<float> h(static_cast<std::size_t>(n)*n,0.0f);
+       {
+          std::uniform_real_distribution<float> uh(8.0f,80.0f);
+          for(int32_t __i{0}; __i < n; __i += 16)
+              for(int32_t __j{0}; __j < n; __j += 16)
+              {
+                  if((__i%80) >= 64 || (__j%80) >= 64) continue; // 16 m streets
+                  const float lot{uh(rng)};
+                  for(int32_t __y{__i}; __y != __i+16; ++__y)
+                      for(int32_t __x{__j}; __x != __j+16; ++__x)
+                          if((__y%80) < 64 && (__x%80) < 64) h[static_cast<std::size_t>(__y)*n+__x] = lot;
+              }
+       }
+       UrbanHMapMip_t m;
+       double t0{omp_get_wtime()};
+       if(urban_hmap_mip_build(h.data(),n,n,1.0f,1.0f,m) != 0)
+       {
+          printf("urban_hmap_mip_build failed\n");
+          std::exit(EXIT_FAILURE);
+       }
+       printf("urban_hmap_mip_build: %10.4f s (%d levels)\n",omp_get_wtime()-t0,m.nlev);
+       std::uniform_real_distribution<float> ux(0.0f,static_cast<float>(n));
+       std::vector<float> rx(nrx), ry(nrx), rz(nrx,1.5f);
+       for(int32_t __i{0}; __i != nrx; ++__i)
+       {
+           do
+           {
+              rx[__i] = ux(rng);
+              ry[__i] = ux(rng);
+           } while(h[static_cast<std::size_t>(ry[__i])*n+static_cast<std::size_t>(rx[__i])] > 0.0f);
+       }
+       const float radar[3] = {0.5f*n,0.5f*n,120.0f};
+       std::vector<float> ox(nrx,radar[0]), oy(nrx,radar[1]), oz(nrx,radar[2]);
+       std::vector<uint8_t> vis(nrx);
+       double best{1.0e+30};
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           t0 = omp_get_wtime();
+           urban_los_batch_omp(m,ox.data(),oy.data(),oz.data(),rx.data(),ry.data(),rz.data(),nrx,vis.data(),nullptr);
+           best = std::min(best,omp_get_wtime()-t0);
+       }
+       int32_t nv{0};
+       for(int32_t __i{0}; __i != nrx; ++__i) nv += vis[__i];
+       printf("threads=%d, receivers=%d, visible=%d\n",omp_get_max_threads(),nrx,nv);
+       printf("urban_los_batch_omp    : %10.4f s %14.1f rays/s\n",best,nrx/best);
+       const int32_t nr2{std::min(nref,nrx)};
+       int32_t sink{0};
+       t0 = omp_get_wtime();
+       for(int32_t __i{0}; __i != nr2; ++__i)
+       {
+           const float e[3] = {rx[__i],ry[__i],rz[__i]};
+           float th;
+           sink += urban_los_r4(m,radar,e,&th);
+       }
+       const double tref{omp_get_wtime()-t0};
+       printf("urban_los_r4 (1 thread): %9.4f s %14.1f rays/s, speedup %.1f (sink=%d)\n",
+              tref,nr2/tref,(nrx/best)/(nr2/tref),sink);
+       std::vector<UrbanReflPts_t> refl(nrx);
+       best = 1.0e+30;
+       for(int32_t __j{0}; __j != n_samples; ++__j)
+       {
+           t0 = omp_get_wtime();
+           urban_radar_coverage_omp(m,radar,rx.data(),ry.data(),rz.data(),nrx,0.0f,vis.data(),refl.data());
+           best = std::min(best,omp_get_wtime()-t0);
+       }
+       int32_t cnt[UREFL__COUNT] = {0,0,0,0,0};
+       for(int32_t __i{0}; __i != nrx; ++__i)
+           for(int32_t __c{0}; __c != UREFL__COUNT; ++__c) cnt[__c] += (refl[__i].valid >> __c) & 1U;
+       printf("urban_radar_coverage_omp: %9.4f s %14.1f receivers/s (ground=%d walls=%d/%d/%d/%d)\n",
+              best,nrx/best,cnt[0],cnt[1],cnt[2],cnt[3],cnt[4]);
+       t0 = omp_get_wtime();
+       for(int32_t __i{0}; __i != nr2; ++__i)
+       {
+           const float r[3] = {rx[__i],ry[__i],rz[__i]};
+           UrbanReflPts_t p;
+           urban_reflect_r4(m,radar,r,0.0f,p);
+           sink += p.valid;
+       }
+       const double tr2{omp_get_wtime()-t0};
+       printf("urban_reflect_r4 (1 thread): %9.4f s %14.1f receivers/s (sink=%d)\n",tr2,nr2/tr2,sink);
+       urban_hmap_mip_free(m);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main(int argc, char * argv[])
+{
+    const int32_t nrx{(argc > 1) ? std::atoi(argv[1]) : 1000000};
+    const int32_t nref{(argc > 2) ? std::atoi(argv[2]) : 100000};
+    perf_test_urban_raymarch_avx512(nrx,nref);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <omp.h>
+#include "vegasT_cpu.hh"
+
+/*
+    icpc -o perf_test_vegasT_cpu -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5 \
+    -I ../src/gpu/cuda-integration perf_test_vegasT_cpu.cpp
+
+    CPU m-Cubes backend throughput (integrand evaluations per second) for the 5D and 8D Genz demos
+    integrands, argv[1] calls per iteration (default 1.0e7), 10 iterations (5 adjusting the grid), 1..max threads.
+*/
+
+namespace {
+
+       class GENZ_4_5D {
+       public:
+              double operator()(double x, double y, double z, double w, double v)
+              {
+                     const double beta{0.5};
+                     return exp(-625.0 * ((x - beta) * (x - beta) + (y - beta) * (y - beta) +
+                                          (z - beta) * (z - beta) + (w - beta) * (w - beta) +
+                                          (v - beta) * (v - beta)));
+              }
+       };
+
+       class GENZ_3_8D {
+       public:
+              double operator()(double x, double y, double z, double w, double v, double u, double t, double s)
+              {
+                     return pow(1 + 8 * s + 7 * t + 6 * u + 5 * v + 4 * w + 3 * x + 2 * y + z, -9);
+              }
+       };
+
+       template<typename F,int ndim>
+       void run(const char * id,const double ncall)
+       {
+              const quad::Volume<double,ndim> vol;
+              const int32_t nmax{omp_get_max_threads()};
+              double t1{0.0};
+              for(int32_t nt{1}; nt <= nmax; nt = (nt == nmax) ? nmax+1 : std::min(2*nt,nmax))
+              {
+                  omp_set_num_threads(nt);
+                  const double t0{omp_get_wtime()};
+                  // epsrel = 0, all 10 iterations run
+                  const numint::integration_result r{cpu_mcubes::integrate<F,ndim>(F{},0.0,0.0,ncall,&vol,10,5,0,1U)};
+                  const double dt{omp_get_wtime()-t0};
+                  if(nt == 1) t1 = dt;
+                  printf("%s: threads %d, %zu evaluations in %.3f s, %.2f Mevals/s, speedup %.2f, estimate %.10e +- %.3e\n",
+                         id,nt,r.neval,dt,1.0e-6*r.neval/dt,t1/dt,r.estimate,r.errorest);
+              }
+              omp_set_num_threads(nmax);
+       }
+
+}
+
+void perf_test_vegasT_cpu(const double);
+
+void perf_test_vegasT_cpu(const double ncall)
+{
+       printf("[PERF-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+       run<GENZ_4_5D,5>("f4, 5",ncall);
+       run<GENZ_3_8D,8>("f3, 8",ncall);
+       printf("[PERF-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+int main(int argc, char * argv[])
+{
+    const double ncall{(argc > 1) ? std::atof(argv[1]) : 1.0e7};
+    perf_test_vegasT_cpu(ncall);
+    return 0;
+}
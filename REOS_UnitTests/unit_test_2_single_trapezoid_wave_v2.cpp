@@ -7,8 +7,12 @@
 #include "GMS_trapezoid_waveform.h"
 
 /*
-   icpc -o unit_test_2_trapezw_single_v2 -fp-model -std=c++17 fast=2 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_trapezoid_waveform.h GMS_trapezoid_waveform.cpp unit_test_2_single_trapezoid_wave_v2.cpp
+   icpc -o unit_test_2_trapezw_single_v2 -fp-model -std=c++17 fast=2 -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp \
+   GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_trapezoid_waveform.h GMS_trapezoid_waveform.cpp unit_test_2_single_trapezoid_wave_v2.cpp -ltbbmalloc
    ASM: 
    icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_trapezoid_waveform.h GMS_trapezoid_waveform.cpp unit_test_2_single_trapezoid_wave_v2.cpp
 
@@ -8,7 +8,7 @@
 
 /*
    icpc -o unit_test_DC3D_c4_t -fp-model fast=2 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h GMS_dyn_containers.h unit_test_DC3D_c4_t.cpp
+   GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_dyn_containers.h unit_test_DC3D_c4_t.cpp -ltbbmalloc
    ASM: 
    icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -falign-functions=32   GMS_config.h GMS_malloc.h GMS_dyn_containers.h unit_test_DC3D_c4_t.cpp
 
@@ -0,0 +1,238 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "GMS_config.h"
+#include "GMS_alloc_policy.h"
+#include "GMS_dyn_array.h"
+#include "GMS_dyn_containers.h"
+#include "GMS_stat_containers.h"
+
+/*
+   icpc -o unit_test_alloc_policy -fp-model fast=2 -std=c++17 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+   GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_half.h GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_fp16_bulk.h GMS_fp16_bulk.cpp \
+   GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_dyn_array.h GMS_dyn_containers.h GMS_stat_containers.h unit_test_alloc_policy.cpp -ltbbmalloc
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_alloc_policy.h GMS_alloc_policy.cpp
+
+   Every policy serves aligned blocks and frees the blocks of the other policies (and threads),
+   the arena rewinds and merges its chunks on reset, the pool reuses the freed blocks of the
+   same size class, the counters add up, the darray/DC containers allocate in an arena_frame
+   and a StatC container is constructed by policy_new.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     bool is_aligned(const void * p,const std::size_t a)
+     {
+          return ((reinterpret_cast<std::uintptr_t>(p) & (a-1ull)) == 0ull);
+     }
+
+}
+
+void unit_test_alloc_policy_cross_free();
+
+void unit_test_alloc_policy_cross_free()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     alloc_counters_reset();
+     constexpr int32_t np{N_ALLOC_POLICIES};
+     const std::size_t sizes[] = {1ull,63ull,64ull,100ull,4095ull,65536ull,1000001ull};
+     std::vector<void*> blk;
+     std::vector<std::size_t> len;
+     for(int32_t __p{0}; __p != np; ++__p)
+     {
+          alloc_policy_scope scope(static_cast<alloc_policy>(__p));
+          for(std::size_t n : sizes)
+          {
+               for(std::size_t a : {64ull,128ull,4096ull})
+               {
+                    unsigned char * p{reinterpret_cast<unsigned char*>(gms_policy_malloc(n,a))};
+                    if(!is_aligned(p,a)) test_fail(__PRETTY_FUNCTION__);
+                    std::memset(p,__p+1,n);
+                    blk.push_back(p);
+                    len.push_back(n);
+               }
+          }
+     }
+     if(alloc_policy_current() != alloc_policy::MM_MALLOC) test_fail(__PRETTY_FUNCTION__);
+     // no block overlaps another one
+     for(std::size_t __i{0ull}; __i != blk.size(); ++__i)
+     {
+          const unsigned char * p{reinterpret_cast<const unsigned char*>(blk[__i])};
+          const unsigned char v{static_cast<unsigned char>(__i/(3ull*7ull)+1ull)};
+          for(std::size_t __j{0ull}; __j != len[__i]; ++__j)
+              if(p[__j] != v) test_fail(__PRETTY_FUNCTION__);
+     }
+     // freed under a different policy than the one which served them
+     {
+          alloc_policy_scope scope(alloc_policy::POOL);
+          for(void * p : blk) gms_policy_free(p);
+     }
+     const alloc_counters_t c{alloc_counters()};
+     uint64_t na{0ull},nf{0ull};
+     for(int32_t __p{0}; __p != np; ++__p) { na += c.n_alloc[__p]; nf += c.n_free[__p];}
+     if(na != blk.size() || nf != blk.size()) test_fail(__PRETTY_FUNCTION__);
+     // the pool serves only the 64-byte aligned requests
+     if(c.n_alloc[static_cast<int32_t>(alloc_policy::POOL)] != 7ull ||
+        c.pool_oversize != 14ull) test_fail(__PRETTY_FUNCTION__);
+     if(c.n_alloc[static_cast<int32_t>(alloc_policy::ARENA)] != 21ull) test_fail(__PRETTY_FUNCTION__);
+     if(c.bytes_live != 0ull) test_fail(__PRETTY_FUNCTION__);
+     // the arena blocks were all freed, none is left at the reset
+     arena_reset();
+     if(alloc_counters().arena_live_at_reset != 0ull) test_fail(__PRETTY_FUNCTION__);
+     pool_trim();
+     arena_release();
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_alloc_policy_arena();
+
+void unit_test_alloc_policy_arena()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     arena_release();
+     alloc_counters_reset();
+     void * first{nullptr};
+     for(int32_t __f{0}; __f != 4; ++__f)
+     {
+          arena_frame frame;
+          // spills over several chunks in the first frame only
+          for(int32_t __i{0}; __i != 40; ++__i)
+          {
+               void * p{gms_policy_malloc(256ull*1024ull)};
+               if(!is_aligned(p,64ull)) test_fail(__PRETTY_FUNCTION__);
+               std::memset(p,0xA5,256ull*1024ull);
+               if(__i == 0 && __f == 1) first = p;
+               if(__i == 0 && __f > 1 && p != first) test_fail(__PRETTY_FUNCTION__);
+               if(__i & 1) gms_policy_free(p);
+          }
+          if(arena_bytes_used() < 40ull*256ull*1024ull) test_fail(__PRETTY_FUNCTION__);
+     }
+     const alloc_counters_t c{alloc_counters()};
+     if(c.arena_resets != 4ull) test_fail(__PRETTY_FUNCTION__);
+     // three chunks for the first frame, one merged chunk afterwards
+     if(c.arena_chunks != 4ull) test_fail(__PRETTY_FUNCTION__);
+     if(c.arena_bytes_reserved < 40ull*256ull*1024ull) test_fail(__PRETTY_FUNCTION__);
+     if(c.arena_live_at_reset != 4ull*20ull) test_fail(__PRETTY_FUNCTION__);
+     if(c.bytes_live != 0ull) test_fail(__PRETTY_FUNCTION__);
+     arena_release();
+     if(alloc_counters().arena_bytes_reserved != 0ull) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_alloc_policy_pool();
+
+void unit_test_alloc_policy_pool()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     pool_trim();
+     alloc_counters_reset();
+     alloc_policy_scope scope(alloc_policy::POOL);
+     for(int32_t __r{0}; __r != 100; ++__r)
+     {
+          void * a{gms_policy_malloc(1000ull)};
+          void * b{gms_policy_malloc(100000ull)};
+          gms_policy_free(b);
+          gms_policy_free(a);
+     }
+     alloc_counters_t c{alloc_counters()};
+     if(c.pool_misses != 2ull || c.pool_hits != 198ull) test_fail(__PRETTY_FUNCTION__);
+     // a request of the same size class reuses the block
+     void * a{gms_policy_malloc(1000ull)};
+     gms_policy_free(a);
+     void * b{gms_policy_malloc(1010ull)};
+     if(a != b) test_fail(__PRETTY_FUNCTION__);
+     gms_policy_free(b);
+     // a block freed by another thread is cached by that thread
+     void * r{gms_policy_malloc(5000ull)};
+     std::thread t([r]{
+          gms_policy_free(r);
+          const alloc_counters_t ct{alloc_counters()};
+          if(ct.remote_frees != 1ull || ct.pool_bytes_cached == 0ull) test_fail("remote free");
+     });
+     t.join();
+     c = alloc_counters();
+     // the live bytes move with the block to the freeing thread
+     const alloc_counters_t tot{alloc_counters_total()};
+     if(tot.bytes_live != 0ull) test_fail(__PRETTY_FUNCTION__);
+     if(tot.remote_frees < 1ull || tot.n_free[static_cast<int32_t>(alloc_policy::POOL)] < c.n_free[static_cast<int32_t>(alloc_policy::POOL)]+1ull)
+        test_fail(__PRETTY_FUNCTION__);
+     pool_trim();
+     if(alloc_counters().pool_bytes_cached != 0ull) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_alloc_policy_containers();
+
+void unit_test_alloc_policy_containers()
+{
+     using namespace gms;
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     arena_release();
+     alloc_counters_reset();
+     constexpr std::size_t n{1000ull};
+     for(int32_t __f{0}; __f != 3; ++__f)
+     {
+          arena_frame frame;
+          darray_r4_t x(n);
+          DC1D_r4_t   e(n);
+          DC3D_t<double> d(n,n/2ull,n/4ull);
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+          {
+               x.m_data[__i] = static_cast<float>(__i);
+               e.m_Exr[__i]  = -x.m_data[__i];
+               e.m_Exi[__i]  = 2.0f*x.m_data[__i];
+          }
+          for(std::size_t __i{0ull}; __i != n/4ull; ++__i) d.m_Ez[__i] = 1.0;
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+              if(e.m_Exr[__i]+x.m_data[__i] != 0.0f || e.m_Exi[__i] != 2.0f*x.m_data[__i]) test_fail(__PRETTY_FUNCTION__);
+          if(!is_aligned(x.m_data,64ull) || !is_aligned(e.m_Exi,64ull) || !is_aligned(d.m_Ey,64ull)) test_fail(__PRETTY_FUNCTION__);
+     }
+     alloc_counters_t c{alloc_counters()};
+     // darray: 1, DC1D_r4_t: 2, DC3D_t: 3 blocks per frame, all freed before the reset
+     if(c.n_alloc[static_cast<int32_t>(alloc_policy::ARENA)] != 18ull ||
+        c.n_free[static_cast<int32_t>(alloc_policy::ARENA)]  != 18ull ||
+        c.arena_live_at_reset != 0ull || c.arena_resets != 3ull) test_fail(__PRETTY_FUNCTION__);
+     // the default policy is unchanged outside of a frame
+     {
+          darray_r4_t y(n);
+          c = alloc_counters();
+          if(c.n_alloc[static_cast<int32_t>(alloc_policy::MM_MALLOC)] != 1ull) test_fail(__PRETTY_FUNCTION__);
+     }
+     // the in-object storage of the StatC*/StatV* containers
+     {
+          alloc_policy_scope scope(alloc_policy::POOL);
+          StatC1D_c4_t<64ull,0> * s{policy_new<StatC1D_c4_t<64ull,0>>()};
+          if(!is_aligned(s,64ull) || !is_aligned(&s->mx[0],64ull) || s->mnx != 64ull) test_fail(__PRETTY_FUNCTION__);
+          for(std::size_t __i{0ull}; __i != 64ull; ++__i) s->mx[__i] = {1.0f,-1.0f};
+          policy_delete(s);
+     }
+     pool_trim();
+     arena_release();
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_alloc_policy_cross_free();
+    unit_test_alloc_policy_arena();
+    unit_test_alloc_policy_pool();
+    unit_test_alloc_policy_containers();
+    return 0;
+}
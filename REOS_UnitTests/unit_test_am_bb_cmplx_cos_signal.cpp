@@ -7,8 +7,12 @@
 #include "GMS_am_bb_cmplx_cos_signal.h"
 
 /*
-   icpc -o unit_test_am_bb_cmplx_cos_signal -fp-model fast=2 -std=c++17 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_cmplx_cos_signal.h GMS_am_bb_cmplx_cos_signal.cpp unit_test_am_bb_cmplx_cos_signal.cpp
+   icpc -o unit_test_am_bb_cmplx_cos_signal -fp-model fast=2 -std=c++17 -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp \
+   GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_cmplx_cos_signal.h GMS_am_bb_cmplx_cos_signal.cpp unit_test_am_bb_cmplx_cos_signal.cpp -ltbbmalloc
    ASM: 
    icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_cmplx_cos_signal.h GMS_am_bb_cos_trapez_signal.cpp unit_test_am_bb_cmplx_cos_signal.cpp
 
@@ -7,10 +7,14 @@
 #include "GMS_am_bb_sine_signal_fp16.h"
 
 /*
-   icpc -o unit_test_am_bb_sine_signal_fp16 -fp-model fast=2 -std=c++17 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_sine_signal_fp16.h GMS_am_bb_sine_signal_fp16.cpp unit_test_am_bb_sine_signal_fp16.cpp
+   icpc -o unit_test_am_bb_sine_signal_fp16 -fp-model fast=2 -std=c++17 -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h GMS_half.h GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_memops_dispatch.h GMS_memops_dispatch.cpp \
+   GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_dyn_array.h GMS_fp16_bulk.h GMS_fp16_bulk.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_sine_signal_fp16.h GMS_am_bb_sine_signal_fp16.cpp unit_test_am_bb_sine_signal_fp16.cpp -ltbbmalloc
    ASM: 
-   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_sine_signal_fp16.h GMS_am_bb_sine_signal_fp16.cpp unit_test_am_bb_sine_signal_fp16.cpp
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_malloc.h GMS_fast_pmc_access.h  GMS_dyn_array.h GMS_fp16_bulk.h GMS_fp16_bulk.cpp GMS_cephes_sin_cos.h GMS_indices.h GMS_am_bb_sine_signal_fp16.h GMS_am_bb_sine_signal_fp16.cpp unit_test_am_bb_sine_signal_fp16.cpp
 
 */
 
@@ -0,0 +1,269 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_cbessel_jyh_vec.h"
+
+/*
+   icpc -o unit_test_cbessel_jyh_vec -fp-model fast=2 -ftz -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_cbessel_jyh_vec.h GMS_cbessel_jyh_vec.cpp unit_test_cbessel_jyh_vec.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_cbessel_jyh_vec.h GMS_cbessel_jyh_vec.cpp unit_test_cbessel_jyh_vec.cpp
+
+   References: ascending series of J_n and Y_n (DLMF 10.2.2, 10.8.1) in long double for |z| <= 12,
+   std::cyl_bessel_j/std::cyl_neumann on the real axis up to x = 100, the Wronskian
+   J_n+1*Y_n - J_n*Y_n+1 = 2/(pi*z) in the complex plane up to |z| = 100.
+   Errors are relative to |J_n| + |Y_n| of the reference (absolute near the zeros).
+*/
+
+namespace {
+
+     typedef std::complex<long double> CL;
+     typedef std::complex<double>      CD;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // J_n, Y_n, n = 0..N, ascending series
+     void jy_series(const CL z,const int32_t N,std::vector<CL> & J,std::vector<CL> & Y)
+     {
+          const long double pi{3.141592653589793238462643383279502884L};
+          const long double gam{0.577215664901532860606512090082402431L};
+          const CL h{0.5L*z}, q{-h*h};
+          J.assign(N+1,CL(0.0L,0.0L));
+          Y.assign(N+1,CL(0.0L,0.0L));
+          for(int32_t n{0}; n <= N; ++n)
+          {
+              long double fn{1.0L};                              // n!
+              for(int32_t __i{2}; __i <= n; ++__i) fn *= __i;
+              const CL hn{std::pow(h,n)};
+              // J_n and the digamma sum
+              CL t{1.0L/fn}, sj{0.0L,0.0L}, sy{0.0L,0.0L};
+              long double psk{-gam}, psnk{-gam};                 // psi(k+1), psi(n+k+1)
+              for(int32_t __i{1}; __i <= n; ++__i) psnk += 1.0L/__i;
+              for(int32_t k{0}; k < 400; ++k)
+              {
+                  sj += t;
+                  sy += (psk+psnk)*t;
+                  if(std::abs(t) < 1.0e-30L*std::abs(sj) && k > 2) break;
+                  t *= q/static_cast<long double>((k+1)*(n+k+1));
+                  psk  += 1.0L/(k+1);
+                  psnk += 1.0L/(n+k+1);
+              }
+              J[n] = hn*sj;
+              // finite part, -(z/2)^-n/pi*SUM_k<n (n-k-1)!/k!*(z^2/4)^k
+              CL sf{0.0L,0.0L}, p{1.0L,0.0L};
+              for(int32_t k{0}; k < n; ++k)
+              {
+                  long double f{1.0L};
+                  for(int32_t __i{2}; __i <= n-k-1; ++__i) f *= __i;
+                  long double kf{1.0L};
+                  for(int32_t __i{2}; __i <= k; ++__i) kf *= __i;
+                  sf += f/kf*p;
+                  p  *= h*h;
+              }
+              Y[n] = -sf/(pi*std::pow(h,n)) + 2.0L/pi*std::log(h)*J[n] - hn*sy/pi;
+          }
+     }
+
+     // one kernel call on W arguments, results as std::complex<double> [lane][order]
+     template<int32_t W,typename S,typename V,typename F>
+     void run(F && f,const std::vector<CD> & z,const int32_t N,
+              std::vector<std::vector<CD>> & J,std::vector<std::vector<CD>> & Y,std::vector<std::vector<CD>> & H)
+     {
+          alignas(64) S zr[W], zi[W];
+          for(int32_t __k{0}; __k != W; ++__k)
+          {
+              zr[__k] = static_cast<S>(z[__k].real());
+              zi[__k] = static_cast<S>(z[__k].imag());
+          }
+          std::vector<V> jr(N+1), ji(N+1), yr(N+1), yi(N+1), hr(N+1), hi(N+1);
+          V vzr, vzi;
+          std::copy(zr,zr+W,reinterpret_cast<S*>(&vzr));
+          std::copy(zi,zi+W,reinterpret_cast<S*>(&vzi));
+          f(vzr,vzi,N,jr.data(),ji.data(),yr.data(),yi.data(),hr.data(),hi.data());
+          J.assign(W,std::vector<CD>(N+1));
+          Y.assign(W,std::vector<CD>(N+1));
+          H.assign(W,std::vector<CD>(N+1));
+          for(int32_t n{0}; n <= N; ++n)
+          {
+              const S * a{reinterpret_cast<const S*>(&jr[n])}, * b{reinterpret_cast<const S*>(&ji[n])};
+              const S * c{reinterpret_cast<const S*>(&yr[n])}, * d{reinterpret_cast<const S*>(&yi[n])};
+              const S * e{reinterpret_cast<const S*>(&hr[n])}, * g{reinterpret_cast<const S*>(&hi[n])};
+              for(int32_t __k{0}; __k != W; ++__k)
+              {
+                  J[__k][n] = CD(a[__k],b[__k]);
+                  Y[__k][n] = CD(c[__k],d[__k]);
+                  H[__k][n] = CD(e[__k],g[__k]);
+              }
+          }
+     }
+
+     // arguments on rings |z| = r, all quadrants and both real half-axes
+     std::vector<CD> ring_args(const std::vector<double> & rs)
+     {
+          std::vector<CD> z;
+          for(const double r : rs)
+              for(int32_t __a{0}; __a != 16; ++__a)
+                  z.push_back(std::polar(r,-3.14159265358979323846+(__a+1)*3.14159265358979323846/8.0));
+          return (z);
+     }
+
+     struct err_t {
+          double ser{0.0};     // against the ascending series
+          double wr{0.0};      // Wronskian
+          double hk{0.0};      // H2 = J - jY
+          int32_t nan{0};      // NaN outputs (inf is legal once Y_n leaves the range)
+     };
+
+     template<int32_t W,typename S,typename V,typename F>
+     err_t check(F && f,const std::vector<CD> & zs,const int32_t N,const bool series)
+     {
+          err_t e;
+          std::vector<CL> JL, YL;
+          for(size_t __i{0}; __i < zs.size(); __i += W)
+          {
+              std::vector<CD> z(W);
+              for(int32_t __k{0}; __k != W; ++__k) z[__k] = zs[std::min(__i+__k,zs.size()-1)];
+              std::vector<std::vector<CD>> J, Y, H;
+              run<W,S,V>(f,z,N,J,Y,H);
+              for(int32_t __k{0}; __k != W; ++__k)
+              {
+                  for(int32_t n{0}; n <= N; ++n)
+                      e.nan += std::isnan(std::norm(J[__k][n])) || std::isnan(std::norm(Y[__k][n])) ||
+                               std::isnan(std::norm(H[__k][n]));
+                  const CD zz{static_cast<S>(z[__k].real()),static_cast<S>(z[__k].imag())};
+                  if(series)
+                  {
+                     jy_series(CL(zz.real(),zz.imag()),N,JL,YL);
+                     for(int32_t n{0}; n <= N; ++n)
+                     {
+                         const CD jl(JL[n]), yl(YL[n]);
+                         const double sc{std::abs(jl)+std::abs(yl)};
+                         if(!std::isfinite(sc) || sc > 1.0e30) continue;
+                         e.ser = std::max(e.ser,std::max(std::abs(J[__k][n]-jl),std::abs(Y[__k][n]-yl))/sc);
+                     }
+                  }
+                  const CD w0{2.0/(3.14159265358979323846*zz)};
+                  for(int32_t n{0}; n < N; ++n)
+                  {
+                      const CD a{J[__k][n+1]*Y[__k][n]}, b{J[__k][n]*Y[__k][n+1]};
+                      const double sc{std::abs(a)+std::abs(b)};
+                      if(!std::isfinite(sc) || sc > 1.0e30) continue;
+                      e.wr = std::max(e.wr,std::abs(a-b-w0)/sc);
+                  }
+                  for(int32_t n{0}; n <= N; ++n)
+                  {
+                      const CD h{J[__k][n]-CD(0.0,1.0)*Y[__k][n]};
+                      const double sc{std::abs(J[__k][n])+std::abs(Y[__k][n])};
+                      if(std::isfinite(sc) && sc < 1.0e30) e.hk = std::max(e.hk,std::abs(h-H[__k][n])/sc);
+                  }
+              }
+          }
+          return (e);
+     }
+
+}
+
+void unit_test_cbessel_jyh_series();
+
+void unit_test_cbessel_jyh_series()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::vector<CD> z{ring_args({0.05,0.3,1.0,2.5,5.0,8.0,12.0})};
+     const int32_t N{30};
+     const err_t e8{check<8,double,__m512d>(cbessel_jyh_zmm8r8,z,N,true)};
+     const err_t e4{check<4,double,__m256d>(cbessel_jyh_ymm4r8,z,N,true)};
+     const err_t e16{check<16,float,__m512>(cbessel_jyh_zmm16r4,z,N,true)};
+     const err_t e8f{check<8,float,__m256>(cbessel_jyh_ymm8r4,z,N,true)};
+     printf("|z| <= 12, N = %d, series: zmm8r8 %.2e ymm4r8 %.2e zmm16r4 %.2e ymm8r4 %.2e, H2 = J - jY: %.1e\n",
+            N,e8.ser,e4.ser,e16.ser,e8f.ser,std::max(e8.hk,e16.hk));
+     if(e8.ser > 1.0e-13 || e4.ser > 1.0e-13 || e16.ser > 2.0e-5 || e8f.ser > 2.0e-5 ||
+        e8.hk > 1.0e-15 || e16.hk > 1.0e-6 || e8.nan+e4.nan+e16.nan+e8f.nan != 0) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_cbessel_jyh_real_axis();
+
+void unit_test_cbessel_jyh_real_axis()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     double e8{0.0}, e16{0.0};
+     for(int32_t __i{0}; __i < 400; __i += 16)
+     {
+         std::vector<CD> z(16);
+         for(int32_t __k{0}; __k != 16; ++__k) z[__k] = 0.01*std::pow(1.0e+4,(__i+__k)/399.0);
+         const int32_t N{std::min(static_cast<int32_t>(z[15].real())+20,130)};
+         std::vector<std::vector<CD>> J8, Y8, H8, J16, Y16, H16;
+         run<8,double,__m512d>(cbessel_jyh_zmm8r8,std::vector<CD>(z.begin(),z.begin()+8),N,J8,Y8,H8);
+         std::vector<std::vector<CD>> J8b, Y8b, H8b;
+         run<8,double,__m512d>(cbessel_jyh_zmm8r8,std::vector<CD>(z.begin()+8,z.end()),N,J8b,Y8b,H8b);
+         J8.insert(J8.end(),J8b.begin(),J8b.end());
+         Y8.insert(Y8.end(),Y8b.begin(),Y8b.end());
+         run<16,float,__m512>(cbessel_jyh_zmm16r4,z,N,J16,Y16,H16);
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             const double x{z[__k].real()}, xf{static_cast<float>(x)};
+             for(int32_t n{0}; n <= N; ++n)
+             {
+                 const double j{std::cyl_bessel_j(static_cast<double>(n),x)}, y{std::cyl_neumann(static_cast<double>(n),x)};
+                 const double sc{std::fabs(j)+std::fabs(y)};
+                 if(!std::isfinite(sc) || sc > 1.0e30) continue;
+                 e8 = std::max(e8,std::max(std::abs(J8[__k][n]-j),std::abs(Y8[__k][n]-y))/sc);
+                 const double jf{std::cyl_bessel_j(static_cast<double>(n),xf)}, yf{std::cyl_neumann(static_cast<double>(n),xf)};
+                 const double scf{std::fabs(jf)+std::fabs(yf)};
+                 if(!std::isfinite(scf) || scf > 1.0e30 || xf > 50.0) continue;
+                 e16 = std::max(e16,std::max(std::abs(J16[__k][n]-jf),std::abs(Y16[__k][n]-yf))/scf);
+             }
+         }
+     }
+     printf("real axis 0.01 <= x <= 100 vs std::cyl_bessel_j/cyl_neumann: zmm8r8 %.2e, zmm16r4 (x <= 50) %.2e\n",e8,e16);
+     if(e8 > 2.0e-13 || e16 > 2.0e-5) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_cbessel_jyh_wronskian();
+
+void unit_test_cbessel_jyh_wronskian()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // large |z|, strongly absorbing arguments (|Im z| up to 40), zero argument lanes
+     const std::vector<CD> z8{ring_args({15.0,30.0,60.0,100.0})};
+     const std::vector<CD> z4{ring_args({15.0,30.0,50.0})};
+     const err_t e8{check<8,double,__m512d>(cbessel_jyh_zmm8r8,z8,120,false)};
+     const err_t e4{check<4,double,__m256d>(cbessel_jyh_ymm4r8,z8,120,false)};
+     const err_t e16{check<16,float,__m512>(cbessel_jyh_zmm16r4,z4,70,false)};
+     const err_t e8f{check<8,float,__m256>(cbessel_jyh_ymm8r4,z4,70,false)};
+     printf("Wronskian: zmm8r8 %.2e ymm4r8 %.2e (|z| <= 100), zmm16r4 %.2e ymm8r4 %.2e (|z| <= 50)\n",
+            e8.wr,e4.wr,e16.wr,e8f.wr);
+     bool fail{e8.wr > 1.0e-13 || e4.wr > 1.0e-13 || e16.wr > 2.0e-5 || e8f.wr > 2.0e-5 ||
+               e8.nan+e4.nan+e16.nan+e8f.nan != 0};
+     std::vector<std::vector<CD>> J, Y, H;
+     std::vector<CD> z(16,CD(0.0,0.0));
+     z[3] = CD(2.0,1.0);
+     run<16,float,__m512>(cbessel_jyh_zmm16r4,z,4,J,Y,H);
+     fail = fail || J[0][0] != CD(1.0,0.0) || J[0][1] != CD(0.0,0.0) || !(Y[0][2].real() < -1.0e38);
+     fail = fail || std::abs(J[3][0]-CD(std::cyl_bessel_j(0.0,2.0),0.0)) < 1.0e-3;  // lane 3 is not a zero lane
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_cbessel_jyh_series();
+    unit_test_cbessel_jyh_real_axis();
+    unit_test_cbessel_jyh_wronskian();
+    return 0;
+}
@@ -0,0 +1,349 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_cmatrix4x4_batch_zmm16r4.h"
+
+/*
+   icpc -o unit_test_cmatrix4x4_batch_zmm16r4 -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   -DENABLE_AVX512F GMS_config.h GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_par_team.h GMS_par_team.cpp \
+   GMS_cmatrix4x4_batch_zmm16r4.h GMS_cmatrix4x4_batch_zmm16r4.cpp unit_test_cmatrix4x4_batch_zmm16r4.cpp -lpthread
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_cmatrix4x4_batch_zmm16r4.h GMS_cmatrix4x4_batch_zmm16r4.cpp
+
+   Every lane against a scalar double precision reference of the same algorithm
+   (Gauss-Jordan with partial pivoting, the extinction matrix, scaling and squaring
+   of the degree 20 Taylor polynomial); the eigendecomposition against its defining
+   identities K*Q = Q*diag(l), inv(Q)*Q = I. The scalar routines of
+   GMS_matrix_computations are not used as the reference, that translation unit
+   does not compile (undeclared ipvt/det in invm4x4_cmplxr4, std::cabs, 'r' in
+   eigen4x4_cmplxr4).
+   Singular and defective lanes are detected, the defective ones are computed by
+   the scaling and squaring path, the parallel batch is bitwise the serial one.
+*/
+
+namespace {
+
+     using namespace gms::math;
+     typedef std::complex<double> zd;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     void ref_mul(const zd * a,const zd * b,zd * c)
+     {
+          for(int32_t __i{0}; __i != 4; ++__i)
+              for(int32_t __j{0}; __j != 4; ++__j)
+              {
+                   zd s{0.0,0.0};
+                   for(int32_t __k{0}; __k != 4; ++__k) s += a[4*__i+__k]*b[4*__k+__j];
+                   c[4*__i+__j] = s;
+              }
+     }
+
+     bool ref_inv(const zd * a,zd * inv)
+     {
+          zd w[16];
+          std::copy(a,a+16,w);
+          for(int32_t __i{0}; __i != 16; ++__i) inv[__i] = (__i%5 == 0) ? 1.0 : 0.0;
+          for(int32_t __k{0}; __k != 4; ++__k)
+          {
+               int32_t p{__k};
+               for(int32_t __i{__k+1}; __i != 4; ++__i) if(std::abs(w[4*__i+__k]) > std::abs(w[4*p+__k])) p = __i;
+               if(std::abs(w[4*p+__k]) == 0.0) return (false);
+               for(int32_t __j{0}; __j != 4; ++__j) { std::swap(w[4*__k+__j],w[4*p+__j]); std::swap(inv[4*__k+__j],inv[4*p+__j]); }
+               const zd r{1.0/w[4*__k+__k]};
+               for(int32_t __j{0}; __j != 4; ++__j) { w[4*__k+__j] *= r; inv[4*__k+__j] *= r; }
+               for(int32_t __i{0}; __i != 4; ++__i)
+               {
+                    if(__i == __k) continue;
+                    const zd f{w[4*__i+__k]};
+                    for(int32_t __j{0}; __j != 4; ++__j) { w[4*__i+__j] -= f*w[4*__k+__j]; inv[4*__i+__j] -= f*inv[4*__k+__j]; }
+               }
+          }
+          return (true);
+     }
+
+     // dI/ds = -K*I of dE/ds = M*E, M = (vv, vh, hv, hh)
+     void ref_K(const zd * M,double * K)
+     {
+          const double v[16] = { 2.0*M[0].real(), 0.0,             M[1].real(),               M[1].imag(),
+                                 0.0,             2.0*M[3].real(), M[2].real(),              -M[2].imag(),
+                                 2.0*M[2].real(), 2.0*M[1].real(), M[0].real()+M[3].real(),  -(M[0].imag()-M[3].imag()),
+                                -2.0*M[2].imag(), 2.0*M[1].imag(), M[0].imag()-M[3].imag(),   M[0].real()+M[3].real()};
+          for(int32_t __i{0}; __i != 16; ++__i) K[__i] = -v[__i];
+     }
+
+     void ref_expm(const zd * a,const double z,zd * e)
+     {
+          zd B[16],X[16],T[16];
+          double nrm{0.0};
+          for(int32_t __j{0}; __j != 4; ++__j)
+          {
+               double s{0.0};
+               for(int32_t __i{0}; __i != 4; ++__i) s += std::abs(a[4*__i+__j]*z);
+               nrm = std::max(nrm,s);
+          }
+          int32_t sq{0};
+          while(nrm > 0.25) { nrm *= 0.5; ++sq; }
+          for(int32_t __i{0}; __i != 16; ++__i) { B[__i] = a[__i]*z*std::ldexp(1.0,-sq); X[__i] = (__i%5 == 0) ? 1.0 : 0.0; }
+          for(int32_t __k{20}; __k != 0; --__k)
+          {
+               ref_mul(B,X,T);
+               for(int32_t __i{0}; __i != 16; ++__i) X[__i] = T[__i]/static_cast<double>(__k)+((__i%5 == 0) ? 1.0 : 0.0);
+          }
+          for(int32_t __q{0}; __q != sq; ++__q) { ref_mul(X,X,T); std::copy(T,T+16,X); }
+          std::copy(X,X+16,e);
+     }
+
+     float lane(const __m512 v,const int32_t l)
+     {
+          alignas(64) float t[16];
+          _mm512_store_ps(t,v);
+          return (t[l]);
+     }
+
+     void get_lane(const C4x4_ZMM16C4 & a,const int32_t l,zd * m)
+     {
+          std::complex<float> t[16];
+          c4x4_get_lane(a,l,t);
+          for(int32_t __i{0}; __i != 16; ++__i) m[__i] = zd(t[__i].real(),t[__i].imag());
+     }
+
+     double max_abs(const zd * a)
+     {
+          double m{0.0};
+          for(int32_t __i{0}; __i != 16; ++__i) m = std::max(m,std::abs(a[__i]));
+          return (m);
+     }
+
+     // attenuating medium: Re Mvv, Re Mhh < 0, moderate cross-polarization
+     void random_M(std::mt19937 & g,std::complex<float> * m)
+     {
+          std::uniform_real_distribution<float> att(-0.8f,-0.02f),ph(-1.0f,1.0f),x(-0.2f,0.2f);
+          m[0] = {att(g),ph(g)};
+          m[1] = {x(g),x(g)};
+          m[2] = {x(g),x(g)};
+          m[3] = {att(g),ph(g)};
+     }
+
+}
+
+void unit_test_cmatrix4x4_inverse();
+
+void unit_test_cmatrix4x4_inverse()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::mt19937 g(4646);
+     std::uniform_real_distribution<float> u(-1.0f,1.0f);
+     const int32_t nb{64};
+     std::vector<C4x4_ZMM16C4> a(nb),inv(nb);
+     std::vector<__mmask16> sing(nb);
+     for(int32_t __b{0}; __b != nb; ++__b)
+     {
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               std::complex<float> m[16];
+               for(int32_t __i{0}; __i != 16; ++__i) m[__i] = {u(g),u(g)};
+               if(__l == 3)                          // zero diagonal: needs every pivot swap
+               {
+                    for(int32_t __i{0}; __i != 16; ++__i) m[__i] = 0.0f;
+                    m[1] = {2.0f,1.0f}; m[6] = {-1.0f,0.5f}; m[11] = {0.0f,3.0f}; m[12] = {1.5f,0.0f};
+               }
+               if(__l == 7) for(int32_t __j{0}; __j != 4; ++__j) m[8+__j] = m[__j];            // singular
+               if(__l == 9) for(int32_t __i{0}; __i != 16; ++__i) m[__i] *= 1.0e-20f;         // tiny but regular
+               c4x4_set_lane(a[__b],__l,m);
+          }
+     }
+     const int32_t nsing{inv4x4_cmplx_batch(a.data(),inv.data(),sing.data(),nb)};
+     if(nsing != nb) test_fail(__PRETTY_FUNCTION__);
+     double err{0.0};
+     for(int32_t __b{0}; __b != nb; ++__b)
+     {
+          if(sing[__b] != (1u << 7)) test_fail(__PRETTY_FUNCTION__);
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               if(__l == 7) continue;
+               zd A[16],X[16],R[16];
+               get_lane(a[__b],__l,A);
+               get_lane(inv[__b],__l,X);
+               if(!ref_inv(A,R)) test_fail(__PRETTY_FUNCTION__);
+               double e{0.0};
+               for(int32_t __i{0}; __i != 16; ++__i) e = std::max(e,std::abs(X[__i]-R[__i]));
+               // error of a float inverse ~ cond*eps
+               double cond{0.0},ai{0.0};
+               for(int32_t __i{0}; __i != 16; ++__i) { cond = std::max(cond,std::abs(A[__i])); ai = std::max(ai,std::abs(R[__i])); }
+               err = std::max(err,e/(ai*std::max(1.0,cond*ai)));
+          }
+     }
+     printf("max. scaled inverse error: %g\n",err);
+     if(err > 1.0e-5) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_cmatrix4x4_eigen();
+
+void unit_test_cmatrix4x4_eigen()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::mt19937 g(1046);
+     const int32_t nb{64};
+     double err_k{0.0},err_eig{0.0},err_inv{0.0};
+     for(int32_t __b{0}; __b != nb; ++__b)
+     {
+          C2x2_ZMM16C4 M;
+          std::complex<float> m[16][4];
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               random_M(g,m[__l]);
+               if(__l == 1) { m[__l][1] = 0.0f; m[__l][2] = 0.0f; }                          // no cross-pol
+               if(__l == 2) { m[__l][1] = 0.0f; m[__l][2] = 0.0f; m[__l][3] = m[__l][0]; }    // M = a*I
+               if(__l == 4) { for(auto & x : m[__l]) x = 0.0f; }                               // M = 0
+               if(__l == 5) { m[__l][3] = m[__l][0]; m[__l][1] = 0.0f; }                       // Jordan block
+               if(__l == 6) { m[__l][3] = m[__l][0]; m[__l][2] = 0.0f; m[__l][1] = {0.3f,0.1f}; }
+               c2x2_set_lane(M,__l,m[__l]);
+          }
+          C4_ZMM16C4 l;
+          C4x4_ZMM16C4 Q,invQ;
+          R4x4_ZMM16R4 K;
+          const __mmask16 def{eigen4x4_extinct_zmm16r4(M,l,Q,invQ)};
+          extinct_m4x4_zmm16r4(M,K);
+          if((def & 0x60u) != 0x60u || (def & 0x16u) != 0u) test_fail(__PRETTY_FUNCTION__);
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               zd md[4];
+               for(int32_t __i{0}; __i != 4; ++__i) md[__i] = zd(m[__l][__i].real(),m[__l][__i].imag());
+               double kr[16];
+               ref_K(md,kr);
+               double kn{0.0};
+               for(int32_t __i{0}; __i != 16; ++__i)
+               {
+                    err_k = std::max(err_k,std::abs(static_cast<double>(lane(K.m[__i],__l))-kr[__i]));
+                    kn = std::max(kn,std::abs(kr[__i]));
+               }
+               if((def >> __l) & 1u) continue;
+               zd q[16],iq[16],lv[4],I[16];
+               get_lane(Q,__l,q);
+               get_lane(invQ,__l,iq);
+               for(int32_t __k{0}; __k != 4; ++__k) lv[__k] = zd(lane(l.re[__k],__l),lane(l.im[__k],__l));
+               // K*q_k = l_k*q_k
+               for(int32_t __k{0}; __k != 4; ++__k)
+                   for(int32_t __i{0}; __i != 4; ++__i)
+                   {
+                        zd s{0.0,0.0};
+                        for(int32_t __j{0}; __j != 4; ++__j) s += kr[4*__i+__j]*q[4*__j+__k];
+                        err_eig = std::max(err_eig,std::abs(s-lv[__k]*q[4*__i+__k])/(std::max(kn,1.0e-30)*max_abs(q)));
+                   }
+               ref_mul(iq,q,I);
+               for(int32_t __i{0}; __i != 16; ++__i) err_inv = std::max(err_inv,std::abs(I[__i]-((__i%5 == 0) ? 1.0 : 0.0)));
+          }
+     }
+     printf("max. error K: %g, K*Q-Q*L: %g, inv(Q)*Q-I: %g\n",err_k,err_eig,err_inv);
+     if(err_k > 1.0e-6 || err_eig > 1.0e-6 || err_inv > 1.0e-4) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_cmatrix4x4_exp();
+
+void unit_test_cmatrix4x4_exp()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::mt19937 g(4600);
+     std::uniform_real_distribution<float> uz(0.0f,6.0f),u(-1.0f,1.0f),us(0.1f,6.0f);
+     const int32_t nb{256};
+     std::vector<C2x2_ZMM16C4> M(nb);
+     std::vector<__m512> z(nb);
+     std::vector<R4x4_ZMM16R4> E(nb),Ep(nb);
+     std::vector<__mmask16> def(nb),defp(nb);
+     std::vector<std::complex<float>> mv(static_cast<std::size_t>(nb)*64ull);
+     for(int32_t __b{0}; __b != nb; ++__b)
+     {
+          alignas(64) float zl[16];
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               std::complex<float> * m{&mv[(static_cast<std::size_t>(__b)*16ull+__l)*4ull]};
+               random_M(g,m);
+               if(__l == 5) { m[3] = m[0]; m[1] = 0.0f; }          // defective
+               if(__l == 6) { m[3] = m[0]; m[1] = m[2]*1.0e-4f; }  // nearly defective
+               c2x2_set_lane(M[__b],__l,m);
+               zl[__l] = uz(g);
+          }
+          z[__b] = _mm512_load_ps(zl);
+     }
+     const int32_t nd{extinct_exp4x4_batch(M.data(),z.data(),E.data(),def.data(),nb)};
+     const int32_t ndp{extinct_exp4x4_batch_par(M.data(),z.data(),Ep.data(),defp.data(),nb)};
+     if(nd < nb || nd != ndp) test_fail(__PRETTY_FUNCTION__);
+     if(std::memcmp(E.data(),Ep.data(),sizeof(R4x4_ZMM16R4)*nb) != 0 ||
+        std::memcmp(def.data(),defp.data(),sizeof(__mmask16)*nb) != 0) test_fail(__PRETTY_FUNCTION__);
+     double err_eig{0.0},err_def{0.0};
+     for(int32_t __b{0}; __b != nb; ++__b)
+     {
+          if(((def[__b] >> 5) & 1u) == 0u) test_fail(__PRETTY_FUNCTION__);
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               const std::complex<float> * m{&mv[(static_cast<std::size_t>(__b)*16ull+__l)*4ull]};
+               zd md[4],A[16],R[16];
+               for(int32_t __i{0}; __i != 4; ++__i) md[__i] = zd(m[__i].real(),m[__i].imag());
+               double kr[16];
+               ref_K(md,kr);
+               for(int32_t __i{0}; __i != 16; ++__i) A[__i] = -kr[__i];
+               ref_expm(A,static_cast<double>(lane(z[__b],__l)),R);
+               double e{0.0};
+               for(int32_t __i{0}; __i != 16; ++__i) e = std::max(e,std::abs(static_cast<double>(lane(E[__b].m[__i],__l))-R[__i].real()));
+               e /= std::max(1.0,max_abs(R));
+               if((def[__b] >> __l) & 1u) err_def = std::max(err_def,e);
+               else err_eig = std::max(err_eig,e);
+          }
+     }
+     printf("defective lanes: %d of %d, max. error eigen path: %g, scaling and squaring path: %g\n",nd,16*nb,err_eig,err_def);
+     if(err_eig > 2.0e-5 || err_def > 2.0e-5) test_fail(__PRETTY_FUNCTION__);
+     // any complex matrix, norms up to ~40
+     double err_gen{0.0};
+     for(int32_t __b{0}; __b != 32; ++__b)
+     {
+          C4x4_ZMM16C4 a,e;
+          alignas(64) float zl[16];
+          std::vector<zd> ad(256);
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               std::complex<float> m[16];
+               const float s{us(g)};
+               for(int32_t __i{0}; __i != 16; ++__i) m[__i] = {s*u(g),s*u(g)};
+               for(int32_t __i{0}; __i != 4; ++__i) m[5*__i] -= 2.0f*s;     // keep exp(a) of order 1
+               c4x4_set_lane(a,__l,m);
+               for(int32_t __i{0}; __i != 16; ++__i) ad[16*__l+__i] = zd(m[__i].real(),m[__i].imag());
+               zl[__l] = (__l == 0) ? 0.0f : 1.0f;
+          }
+          exp4x4_cmplx_zmm16r4(a,_mm512_load_ps(zl),e);
+          for(int32_t __l{0}; __l != 16; ++__l)
+          {
+               zd R[16],X[16];
+               ref_expm(&ad[16*__l],static_cast<double>(zl[__l]),R);
+               get_lane(e,__l,X);
+               double d{0.0};
+               for(int32_t __i{0}; __i != 16; ++__i) d = std::max(d,std::abs(X[__i]-R[__i]));
+               err_gen = std::max(err_gen,d/std::max(1.0,max_abs(R)));
+          }
+     }
+     printf("max. error of exp(a*z), general matrices: %g\n",err_gen);
+     if(err_gen > 1.0e-4) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_cmatrix4x4_inverse();
+    unit_test_cmatrix4x4_eigen();
+    unit_test_cmatrix4x4_exp();
+    return 0;
+}
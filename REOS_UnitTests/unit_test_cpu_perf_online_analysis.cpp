@@ -0,0 +1,164 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_cpu_perf_online_analysis.h"
+
+/*
+   icpc -o unit_test_cpu_perf_online_analysis -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_cpu_perf_online_analysis.h GMS_cpu_perf_online_analysis.cpp unit_test_cpu_perf_online_analysis.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_cpu_perf_online_analysis.h GMS_cpu_perf_online_analysis.cpp
+
+   An AR(2) "latency" series pushed sample by sample: the moments against the
+   two-pass formulas, c(0..L) against the direct AUTCOR sum over the stored
+   series (also when fewer samples than lags were pushed), the AR fit of the
+   minimum AIC against the generating coefficients. Level shifts up and down
+   of 2 standard deviations are detected by the CUSUM of the block means within
+   a few blocks, the start estimated to a block; no alarm on the stationary
+   stretches, also not on the correlated AR(2) series.
+*/
+
+namespace {
+
+     using namespace gms::system;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     std::vector<double> ar2_series(const std::size_t n,const double mu,const double a1,const double a2,
+                                    const double sd,const uint32_t seed)
+     {
+          std::mt19937_64 g(seed);
+          std::normal_distribution<double> e(0.0,sd);
+          std::vector<double> x(n);
+          double x1{0.0},x2{0.0};
+          for(std::size_t __i{0}; __i != n; ++__i)
+          {
+               const double v{a1*x1+a2*x2+e(g)};
+               x2 = x1; x1 = v;
+               x[__i] = mu+v;
+          }
+          return (x);
+     }
+
+     void check_acov(const std::vector<double> & x,const std::size_t n,const CpuPerfOnlineSnapshot & s,const char * fn)
+     {
+          double m{0.0};
+          for(std::size_t __i{0}; __i != n; ++__i) m += x[__i];
+          m /= static_cast<double>(n);
+          double err{0.0},c0{0.0};
+          for(int32_t __k{0}; __k <= s.m_lag; ++__k)
+          {
+               double c{0.0};
+               for(std::size_t __t{static_cast<std::size_t>(__k)}; __t < n; ++__t) c += (x[__t]-m)*(x[__t-__k]-m);
+               c /= static_cast<double>(n);
+               if(__k == 0) c0 = c;
+               err = std::max(err,std::abs(c-s.m_acov[__k]));
+          }
+          printf("n=%zu, lags 0..%d: max. |c(k)-AUTCOR| / c(0) = %g\n",n,s.m_lag,err/c0);
+          if(err > 1.0e-9*c0) test_fail(fn);
+     }
+
+}
+
+void unit_test_cpu_perf_online_moments_acov_ar();
+
+void unit_test_cpu_perf_online_moments_acov_ar()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t n{200000};
+     const double a1{0.6},a2{-0.3};
+     const std::vector<double> x{ar2_series(n,1.0e4,a1,a2,25.0,48)};
+     CpuPerfOnlineParams p;
+     p.m_lag = 16;
+     CpuPerfOnlineAnalyzer an(p);
+     CpuPerfOnlineSnapshot s;
+     // fewer samples than lags
+     an.push(x.data(),5);
+     an.snapshot(s);
+     if(s.m_lag != 4) test_fail(__PRETTY_FUNCTION__);
+     check_acov(x,5,s,__PRETTY_FUNCTION__);
+     for(std::size_t __i{5}; __i != n; ++__i) (void)an.push(x[__i]);
+     an.snapshot(s);
+     // moments, two passes
+     double m{0.0},m2{0.0},m3{0.0},m4{0.0};
+     for(double v : x) m += v;
+     m /= static_cast<double>(n);
+     for(double v : x) { const double d{v-m}; m2 += d*d; m3 += d*d*d; m4 += d*d*d*d; }
+     const double dn{static_cast<double>(n)};
+     const double var{m2/(dn-1.0)},skew{std::sqrt(dn)*m3/std::pow(m2,1.5)},kurt{dn*m4/(m2*m2)-3.0};
+     printf("mean %.9f (%.9f), var %.6f (%.6f), skew %.6f (%.6f), kurt %.6f (%.6f)\n",
+            s.m_mean,m,s.m_var,var,s.m_skew,skew,s.m_kurt,kurt);
+     if(std::abs(s.m_mean-m) > 1.0e-9*m || std::abs(s.m_var-var) > 1.0e-9*var ||
+        std::abs(s.m_skew-skew) > 1.0e-7 || std::abs(s.m_kurt-kurt) > 1.0e-7) test_fail(__PRETTY_FUNCTION__);
+     if(s.m_min != *std::min_element(x.begin(),x.end()) || s.m_max != *std::max_element(x.begin(),x.end())) test_fail(__PRETTY_FUNCTION__);
+     check_acov(x,n,s,__PRETTY_FUNCTION__);
+     printf("AR order %d, a(1)=%.4f, a(2)=%.4f, sigma2=%.3f, parcor(3)=%.4f\n",s.m_ar_order,
+            s.m_ar_coef[0],s.m_ar_coef[1],s.m_ar_sigma2,s.m_parcor[2]);
+     if(s.m_ar_order < 2 || std::abs(s.m_ar_coef[0]-a1) > 0.02 || std::abs(s.m_ar_coef[1]-a2) > 0.02 ||
+        std::abs(s.m_ar_sigma2-625.0) > 0.02*625.0) test_fail(__PRETTY_FUNCTION__);
+     for(int32_t __i{2}; __i < s.m_ar_order; ++__i) if(std::abs(s.m_ar_coef[__i]) > 0.02) test_fail(__PRETTY_FUNCTION__);
+     if(s.m_nchange != 0ULL) test_fail(__PRETTY_FUNCTION__);
+     // parameters below the minimums are raised to them
+     CpuPerfOnlineParams q;
+     q.m_lag = 0; q.m_block = 0; q.m_warmup = 1;
+     const CpuPerfOnlineAnalyzer an0(q);
+     if(an0.m_params.m_lag != 1 || an0.m_params.m_block != 1 || an0.m_params.m_warmup != 2) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_cpu_perf_online_changepoints();
+
+void unit_test_cpu_perf_online_changepoints()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t seg{20000};
+     std::mt19937_64 g(480);
+     std::normal_distribution<double> e(0.0,5.0);
+     CpuPerfOnlineParams p;
+     p.m_lag = 8;
+     CpuPerfOnlineAnalyzer an(p);
+     const uint64_t B{static_cast<uint64_t>(p.m_block)};
+     // levels 100 -> 110 -> 100
+     const double lev[3] = {100.0,110.0,100.0};
+     std::vector<uint64_t> alarms;
+     for(int32_t __s{0}; __s != 3; ++__s)
+          for(std::size_t __i{0}; __i != seg; ++__i)
+               if(an.push(lev[__s]+e(g))) alarms.push_back(an.samples()-1ULL);
+     CpuPerfOnlineSnapshot s;
+     an.snapshot(s);
+     print_snapshot(stdout,"synthetic latency [ns]",s);
+     if(alarms.size() != 2 || s.m_nchange != 2ULL || s.m_changes.size() != 2) test_fail(__PRETTY_FUNCTION__);
+     for(int32_t __c{0}; __c != 2; ++__c)
+     {
+          const CpuPerfChangepoint & c{s.m_changes[__c]};
+          const uint64_t at{seg*static_cast<uint64_t>(__c+1)};
+          // a few blocks of delay, the start to a block
+          if(c.m_alarm != alarms[__c] || c.m_alarm < at || c.m_alarm > at+4ULL*B) test_fail(__PRETTY_FUNCTION__);
+          if(c.m_start+B < at || c.m_start > at+B) test_fail(__PRETTY_FUNCTION__);
+          if(c.m_dir != ((__c == 0) ? 1 : -1)) test_fail(__PRETTY_FUNCTION__);
+          if(std::abs(c.m_ref_mean-lev[__c]) > 0.5 || std::abs(c.m_ref_sd-5.0/std::sqrt(static_cast<double>(B))) > 0.3) test_fail(__PRETTY_FUNCTION__);
+     }
+     // reset: the state of a new series
+     an.reset();
+     if(an.push(1.0) || an.samples() != 1ULL) test_fail(__PRETTY_FUNCTION__);
+     an.snapshot(s);
+     if(s.m_nchange != 0ULL || s.m_mean != 1.0 || s.m_lag != 0) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_cpu_perf_online_moments_acov_ar();
+    unit_test_cpu_perf_online_changepoints();
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+extern "C" {
+#include "darknet.h"
+#include "gemm.h"
+#include "im2col.h"
+#include "blas.h"
+#include "direct_conv.h"
+#include "convolutional_layer.h"
+}
+
+/*
+   gcc -c -O3 -march=skylake-avx512 -fopenmp -I darknet/include -I darknet/src darknet/src/*.c (all but compare.c)
+   icpc -o unit_test_darknet_gemm_conv -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   -I darknet/include -I darknet/src unit_test_darknet_gemm_conv.cpp darknet/src/*.o -lm -lpthread
+
+   The packed SGEMM (gemm_cpu above its work threshold, gemm_cpu_fused with
+   the bias+activation epilogue) against the naive gemm_nn/nt/tn/tt over odd
+   M/N/K straddling the micro-kernel and cache blocks, all transposes and
+   leading dimensions larger than the rows. The inference path of
+   forward_convolutional_layer (im2col-free 3x3, 1x1 straight into the gemm,
+   fused gemm) against im2col_cpu + gemm_nn + bias + activation over
+   strides 1/2, pads 0/1, groups and spatial sizes down to 1x1, and the
+   direct 3x3 kernel alone on the narrow shapes W,H in {1,2,3} with pad 1.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     std::mt19937 rng(2626);
+
+     void fill_rand(std::vector<float> & v)
+     {
+          std::uniform_real_distribution<float> ud(-1.0f,1.0f);
+          for(auto & x : v) x = ud(rng);
+     }
+
+     // max |a-b| relative to 1+|b|
+     double max_err(const float * a,const float * b,const std::size_t n)
+     {
+          double e{0.0};
+          for(std::size_t __i{0}; __i != n; ++__i)
+          {
+               const double d{std::fabs(static_cast<double>(a[__i])-static_cast<double>(b[__i]))/
+                              (1.0+std::fabs(static_cast<double>(b[__i])))};
+               if(!(d <= e)) e = d; // NaN wins
+          }
+          return (e);
+     }
+
+     void gemm_naive(const int TA,const int TB,const int M,const int N,const int K,const float ALPHA,
+                     float * A,const int lda,float * B,const int ldb,float * C,const int ldc)
+     {
+          if(!TA && !TB)     gemm_nn(M,N,K,ALPHA,A,lda,B,ldb,C,ldc);
+          else if(TA && !TB) gemm_tn(M,N,K,ALPHA,A,lda,B,ldb,C,ldc);
+          else if(!TA && TB) gemm_nt(M,N,K,ALPHA,A,lda,B,ldb,C,ldc);
+          else               gemm_tt(M,N,K,ALPHA,A,lda,B,ldb,C,ldc);
+     }
+
+     // im2col_cpu + gemm_nn + bias + activation, the training path of the layer
+     void conv_reference(const layer & l,const float * in,float * out)
+     {
+          const int m{l.n/l.groups};
+          const int k{l.size*l.size*l.c/l.groups};
+          const int n{l.out_w*l.out_h};
+          const int cg{l.c/l.groups};
+          std::vector<float> col(static_cast<std::size_t>(k)*n);
+          std::fill(out,out+l.outputs*l.batch,0.0f);
+          for(int __i{0}; __i != l.batch; ++__i)
+          {
+               for(int __j{0}; __j != l.groups; ++__j)
+               {
+                    float * im{const_cast<float*>(in)+(__i*l.groups+__j)*cg*l.h*l.w};
+                    im2col_cpu(im,cg,l.h,l.w,l.size,l.stride,l.pad,col.data());
+                    gemm_nn(m,n,k,1.0f,l.weights+__j*l.nweights/l.groups,k,col.data(),n,
+                            out+(__i*l.groups+__j)*n*m,n);
+               }
+          }
+          for(int __i{0}; __i != l.batch; ++__i)
+               for(int __f{0}; __f != l.n; ++__f)
+                    for(int __p{0}; __p != n; ++__p) out[(__i*l.n+__f)*n+__p] += l.biases[__f];
+          activate_array(out,l.outputs*l.batch,l.activation);
+     }
+
+}
+
+void unit_test_darknet_gemm_packed();
+
+void unit_test_darknet_gemm_packed()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // M,N,K around the micro-kernel tiles (4x8, 6x16, 12x32) and the blocks (MC 144, KC 256, NB 256)
+     const int shapes[][3] = {{33,33,33},{37,41,29},{13,257,31},{145,35,257},{7,513,300},
+                              {150,260,61},{1,1031,97},{97,3,211},{49,49,513}};
+     double worst{0.0};
+     for(const auto & s : shapes)
+     {
+          const int M{s[0]},N{s[1]},K{s[2]};
+          for(int TA{0}; TA != 2; ++TA)
+          {
+               for(int TB{0}; TB != 2; ++TB)
+               {
+                    const int lda{(TA ? M : K)+3};
+                    const int ldb{(TB ? K : N)+5};
+                    const int ldc{N+7};
+                    std::vector<float> A(static_cast<std::size_t>(TA ? K : M)*lda);
+                    std::vector<float> B(static_cast<std::size_t>(TB ? N : K)*ldb);
+                    std::vector<float> C0(static_cast<std::size_t>(M)*ldc);
+                    fill_rand(A); fill_rand(B); fill_rand(C0);
+                    std::vector<float> Cr(C0),Cp(C0);
+                    const float alpha{0.75f},beta{0.5f};
+                    for(int __i{0}; __i != M; ++__i)
+                         for(int __j{0}; __j != N; ++__j) Cr[__i*ldc+__j] *= beta;
+                    gemm_naive(TA,TB,M,N,K,alpha,A.data(),lda,B.data(),ldb,Cr.data(),ldc);
+                    gemm_cpu(TA,TB,M,N,K,alpha,A.data(),lda,B.data(),ldb,beta,Cp.data(),ldc);
+                    // the padding columns of C are not touched by either
+                    const double e{max_err(Cp.data(),Cr.data(),Cp.size())};
+                    worst = std::max(worst,e);
+                    if(!(e <= 1.0e-5*K))
+                    {
+                         printf("gemm_cpu M=%d N=%d K=%d TA=%d TB=%d: err %.3e\n",M,N,K,TA,TB,e);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+                    // fused epilogue: leaky(C + bias[row])
+                    std::vector<float> bias(static_cast<std::size_t>(M));
+                    fill_rand(bias);
+                    std::vector<float> Cf(C0);
+                    gemm_cpu_fused(TA,TB,M,N,K,alpha,A.data(),lda,B.data(),ldb,0.0f,Cf.data(),ldc,bias.data(),LEAKY);
+                    std::vector<float> Cb(C0);
+                    for(int __i{0}; __i != M; ++__i)
+                         for(int __j{0}; __j != N; ++__j) Cb[__i*ldc+__j] = 0.0f;
+                    gemm_naive(TA,TB,M,N,K,alpha,A.data(),lda,B.data(),ldb,Cb.data(),ldc);
+                    for(int __i{0}; __i != M; ++__i)
+                         for(int __j{0}; __j != N; ++__j)
+                              Cb[__i*ldc+__j] = activate(Cb[__i*ldc+__j]+bias[__i],LEAKY);
+                    const double ef{max_err(Cf.data(),Cb.data(),Cf.size())};
+                    worst = std::max(worst,ef);
+                    if(!(ef <= 1.0e-5*K))
+                    {
+                         printf("gemm_cpu_fused M=%d N=%d K=%d TA=%d TB=%d: err %.3e\n",M,N,K,TA,TB,ef);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+               }
+          }
+     }
+     printf("kernel %s, %zu shapes x 4 transposes, max rel. error %.3e\n",gemm_cpu_kernel_name(),
+            sizeof(shapes)/sizeof(shapes[0]),worst);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_darknet_conv_fused();
+
+void unit_test_darknet_conv_fused()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // c,n,groups,size,stride,pad over spatial sizes (h,w)
+     const int cfg[][6] = {{1,5,1,3,1,1},{2,3,1,3,1,1},{3,8,1,3,2,1},{4,7,1,3,1,0},{3,6,1,3,2,0},
+                           {9,11,1,3,1,1},{16,5,1,3,2,1},{6,10,2,3,1,1},{8,12,4,3,1,1},
+                           {5,7,1,1,1,0},{33,17,1,1,1,0},{8,6,2,1,1,0},{7,9,1,1,2,0},
+                           {3,4,1,5,1,2},{6,5,1,5,2,2}};
+     const int hw[][2] = {{1,1},{1,2},{2,1},{2,2},{3,1},{1,3},{3,3},{5,1},{1,5},{4,7},{7,4},{13,11}};
+     int ncases{0};
+     double worst{0.0};
+     for(const auto & c : cfg)
+     {
+          for(const auto & s : hw)
+          {
+               const int h{s[0]},w{s[1]};
+               if(h+2*c[5] < c[3] || w+2*c[5] < c[3]) continue;
+               for(int batch{1}; batch != 3; ++batch)
+               {
+                    layer l{make_convolutional_layer(batch,h,w,c[0],c[1],c[2],c[3],c[4],c[5],LEAKY,0,0,0,0)};
+                    std::vector<float> wt(static_cast<std::size_t>(l.nweights)),bs(static_cast<std::size_t>(l.n));
+                    fill_rand(wt); fill_rand(bs);
+                    std::copy(wt.begin(),wt.end(),l.weights);
+                    std::copy(bs.begin(),bs.end(),l.biases);
+                    std::vector<float> in(static_cast<std::size_t>(l.inputs)*batch);
+                    fill_rand(in);
+                    std::vector<float> ws(std::max<std::size_t>(l.workspace_size/sizeof(float),1));
+                    network net{};
+                    net.input = in.data();
+                    net.workspace = ws.data();
+                    net.train = 0;
+                    forward_convolutional_layer(l,net);
+                    std::vector<float> ref(static_cast<std::size_t>(l.outputs)*batch);
+                    conv_reference(l,in.data(),ref.data());
+                    const double e{max_err(l.output,ref.data(),ref.size())};
+                    worst = std::max(worst,e);
+                    if(!(e <= 1.0e-5))
+                    {
+                         printf("c=%d n=%d groups=%d size=%d stride=%d pad=%d h=%d w=%d batch=%d: err %.3e\n",
+                                c[0],c[1],c[2],c[3],c[4],c[5],h,w,batch,e);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+                    free_layer(l);
+                    ++ncases;
+               }
+          }
+     }
+     printf("%d layer shapes, max rel. error %.3e\n",ncases,worst);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_darknet_conv3x3_direct_narrow();
+
+void unit_test_darknet_conv3x3_direct_narrow()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // narrow outputs make the left and right edge column ranges meet (xa >= xb+2)
+     int ncases{0};
+     for(int C{1}; C != 5; ++C)
+     {
+          for(int H{1}; H != 6; ++H)
+          {
+               for(int W{1}; W != 6; ++W)
+               {
+                    if(H > 3 && W > 3) continue;
+                    for(int stride{1}; stride != 3; ++stride)
+                    {
+                         const int pad{1},F{5};
+                         const int oh{(H+2*pad-3)/stride+1},ow{(W+2*pad-3)/stride+1};
+                         std::vector<float> im(static_cast<std::size_t>(C)*H*W),wt(static_cast<std::size_t>(F)*C*9),bs(F);
+                         fill_rand(im); fill_rand(wt); fill_rand(bs);
+                         std::vector<float> out(static_cast<std::size_t>(F)*oh*ow),col(static_cast<std::size_t>(C)*9*oh*ow),ref(out.size(),0.0f);
+                         conv3x3_direct_cpu(im.data(),C,H,W,stride,pad,wt.data(),F,bs.data(),LINEAR,out.data());
+                         im2col_cpu(im.data(),C,H,W,3,stride,pad,col.data());
+                         gemm_nn(F,oh*ow,C*9,1.0f,wt.data(),C*9,col.data(),oh*ow,ref.data(),oh*ow);
+                         for(int __f{0}; __f != F; ++__f)
+                              for(int __p{0}; __p != oh*ow; ++__p) ref[__f*oh*ow+__p] += bs[__f];
+                         const double e{max_err(out.data(),ref.data(),ref.size())};
+                         if(!(e <= 1.0e-5))
+                         {
+                              printf("C=%d H=%d W=%d stride=%d pad=%d: err %.3e\n",C,H,W,stride,pad,e);
+                              test_fail(__PRETTY_FUNCTION__);
+                         }
+                         ++ncases;
+                    }
+               }
+          }
+     }
+     printf("%d shapes\n",ncases);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+     unit_test_darknet_gemm_packed();
+     unit_test_darknet_conv_fused();
+     unit_test_darknet_conv3x3_direct_narrow();
+     return 0;
+}
@@ -0,0 +1,292 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <unistd.h>
+extern "C" {
+#include "darknet.h"
+#include "quantize.h"
+}
+
+/*
+   gcc -c -O3 -march=skylake-avx512 -fopenmp -I darknet/include -I darknet/src darknet/src/*.c (all but compare.c)
+   icpc -o unit_test_darknet_quantize -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   -I darknet/include -I darknet/src unit_test_darknet_quantize.cpp darknet/src/*.o -lm -lpthread
+
+   gemm_int8_nt against the exact integer dot products of the quantized
+   operands and against the fp32 product within the quantization error
+   bound; gemm_bf16_nt against fp32 on the bf16-rounded operands and within
+   the bf16 rounding bound of the fp32 product, over odd M/N and K padded
+   to QUANT_K_ALIGN. A small conv(+bn)/1x1 conv/connected/softmax network
+   quantized to INT8 and to BF16, saved and reloaded gives bitwise the
+   outputs of the quantized network and stays close to fp32; fp32 files
+   whose revision field is 1 or 2 still load as fp32.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     std::mt19937 rng(2727);
+
+     void fill_rand(float * v,const std::size_t n,const float lo,const float hi)
+     {
+          std::uniform_real_distribution<float> ud(lo,hi);
+          for(std::size_t __i{0}; __i != n; ++__i) v[__i] = ud(rng);
+     }
+
+     std::string temp_name(const char * tag)
+     {
+          char buf[64];
+          std::snprintf(buf,sizeof(buf),"/tmp/dkq_%s_XXXXXX",tag);
+          const int fd{mkstemp(buf)};
+          if(fd < 0) return (std::string());
+          close(fd);
+          return (std::string(buf));
+     }
+
+     const char * cfg_text =
+          "[net]\nbatch=1\nheight=9\nwidth=7\nchannels=3\n\n"
+          "[convolutional]\nbatch_normalize=1\nfilters=8\nsize=3\nstride=1\npad=1\nactivation=leaky\n\n"
+          "[convolutional]\nfilters=6\nsize=1\nstride=1\npad=1\nactivation=leaky\n\n"
+          "[connected]\noutput=5\nactivation=linear\n\n"
+          "[softmax]\n";
+
+     network * make_net(const std::string & cfg)
+     {
+          network * net{parse_network_cfg(const_cast<char*>(cfg.c_str()))};
+          for(int __i{0}; __i != net->n; ++__i)
+          {
+               layer & l{net->layers[__i]};
+               if(l.type == CONVOLUTIONAL)
+               {
+                    fill_rand(l.weights,l.nweights,-0.5f,0.5f);
+                    fill_rand(l.biases,l.n,-0.2f,0.2f);
+                    if(l.batch_normalize)
+                    {
+                         fill_rand(l.scales,l.n,0.5f,1.5f);
+                         fill_rand(l.rolling_mean,l.n,-0.2f,0.2f);
+                         fill_rand(l.rolling_variance,l.n,0.5f,2.0f);
+                    }
+               }
+               if(l.type == CONNECTED)
+               {
+                    fill_rand(l.weights,static_cast<std::size_t>(l.inputs)*l.outputs,-0.3f,0.3f);
+                    fill_rand(l.biases,l.outputs,-0.2f,0.2f);
+               }
+          }
+          return (net);
+     }
+
+     std::vector<float> predict(network * net,float * x)
+     {
+          const float * out{network_predict(net,x)};
+          return (std::vector<float>(out,out+net->outputs));
+     }
+
+}
+
+void unit_test_darknet_gemm_int8_bf16();
+
+void unit_test_darknet_gemm_int8_bf16()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int shapes[][3] = {{1,1,1},{3,5,17},{7,9,64},{13,11,65},{33,17,300},{5,70,27}};
+     double e8{0.0},e16{0.0};
+     for(const auto & s : shapes)
+     {
+          const int M{s[0]},N{s[1]},K{s[2]};
+          const int Kp{quant_padded_k(K)};
+          std::vector<float> A(static_cast<std::size_t>(M)*K),B(static_cast<std::size_t>(N)*K),bias(M);
+          fill_rand(A.data(),A.size(),-1.0f,1.0f);
+          fill_rand(B.data(),B.size(),-2.0f,2.0f);
+          fill_rand(bias.data(),bias.size(),-1.0f,1.0f);
+          // fp32 reference in double
+          std::vector<double> ref(static_cast<std::size_t>(M)*N);
+          for(int __m{0}; __m != M; ++__m)
+               for(int __n{0}; __n != N; ++__n)
+               {
+                    double acc{0.0};
+                    for(int __k{0}; __k != K; ++__k) acc += static_cast<double>(A[__m*K+__k])*B[__n*K+__k];
+                    ref[__m*N+__n] = acc+bias[__m];
+               }
+          // INT8: symmetric per row weights, u8 activations with zero point 128
+          std::vector<int8_t> qa(static_cast<std::size_t>(M)*Kp,0);
+          std::vector<uint8_t> qb(static_cast<std::size_t>(N)*Kp,128);
+          std::vector<int> sums(M,0);
+          std::vector<float> sa(M),scales(M);
+          const float sb{2.0f/127.0f};
+          for(int __m{0}; __m != M; ++__m)
+          {
+               float amax{0.0f};
+               for(int __k{0}; __k != K; ++__k) amax = std::max(amax,std::fabs(A[__m*K+__k]));
+               sa[__m] = amax/127.0f;
+               for(int __k{0}; __k != K; ++__k)
+               {
+                    qa[__m*Kp+__k] = static_cast<int8_t>(std::lround(A[__m*K+__k]/sa[__m]));
+                    sums[__m] += qa[__m*Kp+__k];
+               }
+               scales[__m] = sa[__m]*sb;
+          }
+          for(int __n{0}; __n != N; ++__n)
+               for(int __k{0}; __k != K; ++__k)
+                    qb[__n*Kp+__k] = static_cast<uint8_t>(std::lround(B[__n*K+__k]/sb)+128);
+          std::vector<float> C(static_cast<std::size_t>(M)*N);
+          gemm_int8_nt(M,N,Kp,qa.data(),Kp,qb.data(),Kp,sums.data(),scales.data(),bias.data(),C.data(),N,1);
+          for(int __m{0}; __m != M; ++__m)
+          {
+               for(int __n{0}; __n != N; ++__n)
+               {
+                    int64_t dot{0};
+                    for(int __k{0}; __k != K; ++__k)
+                         dot += static_cast<int64_t>(qa[__m*Kp+__k])*(static_cast<int>(qb[__n*Kp+__k])-128);
+                    const double exact{static_cast<double>(dot)*scales[__m]+bias[__m]};
+                    const double c{static_cast<double>(C[__m*N+__n])};
+                    if(!(std::fabs(c-exact) <= 1.0e-5*(1.0+std::fabs(exact))))
+                    {
+                         printf("int8 M=%d N=%d K=%d (%d,%d): %.7g, exact %.7g\n",M,N,K,__m,__n,c,exact);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+                    // |a*b - qa*qb| <= |a|*sb/2 + sa/2*|b| + sa*sb/4 per term
+                    const double bound{K*(1.0*sb*0.5+sa[__m]*0.5*2.0+sa[__m]*sb*0.25)};
+                    const double e{std::fabs(c-ref[__m*N+__n])};
+                    e8 = std::max(e8,e/bound);
+                    if(!(e <= bound))
+                    {
+                         printf("int8 M=%d N=%d K=%d (%d,%d): err %.3e > %.3e\n",M,N,K,__m,__n,e,bound);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+               }
+          }
+          // BF16
+          std::vector<uint16_t> ha(static_cast<std::size_t>(M)*Kp,0),hb(static_cast<std::size_t>(N)*Kp,0);
+          for(int __m{0}; __m != M; ++__m)
+               for(int __k{0}; __k != K; ++__k) ha[__m*Kp+__k] = float_to_bf16(A[__m*K+__k]);
+          for(int __n{0}; __n != N; ++__n)
+               for(int __k{0}; __k != K; ++__k) hb[__n*Kp+__k] = float_to_bf16(B[__n*K+__k]);
+          gemm_bf16_nt(M,N,Kp,ha.data(),Kp,hb.data(),Kp,bias.data(),C.data(),N,1);
+          for(int __m{0}; __m != M; ++__m)
+          {
+               for(int __n{0}; __n != N; ++__n)
+               {
+                    double exact{0.0},mag{0.0};
+                    for(int __k{0}; __k != K; ++__k)
+                    {
+                         const double p{static_cast<double>(bf16_to_float(ha[__m*Kp+__k]))*bf16_to_float(hb[__n*Kp+__k])};
+                         exact += p;
+                         mag += std::fabs(static_cast<double>(A[__m*K+__k])*B[__n*K+__k]);
+                    }
+                    exact += bias[__m];
+                    const double c{static_cast<double>(C[__m*N+__n])};
+                    if(!(std::fabs(c-exact) <= 1.0e-6*(mag+1.0)))
+                    {
+                         printf("bf16 M=%d N=%d K=%d (%d,%d): %.7g, exact %.7g\n",M,N,K,__m,__n,c,exact);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+                    // both operands rounded to 8 significant bits
+                    const double bound{(2.0*std::ldexp(1.0,-9)+std::ldexp(1.0,-18))*mag+1.0e-6*(mag+1.0)};
+                    const double e{std::fabs(c-ref[__m*N+__n])};
+                    e16 = std::max(e16,e/bound);
+                    if(!(e <= bound))
+                    {
+                         printf("bf16 M=%d N=%d K=%d (%d,%d): err %.3e > %.3e\n",M,N,K,__m,__n,e,bound);
+                         test_fail(__PRETTY_FUNCTION__);
+                    }
+               }
+          }
+     }
+     printf("kernels %s / %s, error / bound: int8 %.3f, bf16 %.3f\n",quant_kernel_name(QUANT_INT8),
+            quant_kernel_name(QUANT_BF16),e8,e16);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_darknet_quantized_weights_roundtrip();
+
+void unit_test_darknet_quantized_weights_roundtrip()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::string cfg{temp_name("cfg")},w32{temp_name("fp32")},wq{temp_name("quant")};
+     if(cfg.empty() || w32.empty() || wq.empty()) test_fail(__PRETTY_FUNCTION__);
+     FILE * fp{std::fopen(cfg.c_str(),"w")};
+     std::fputs(cfg_text,fp);
+     std::fclose(fp);
+     network * ref{make_net(cfg)};
+     save_weights(ref,const_cast<char*>(w32.c_str()));
+     const int ninp{ref->inputs};
+     data calib{};
+     calib.X = make_matrix(16,ninp);
+     for(int __r{0}; __r != 16; ++__r) fill_rand(calib.X.vals[__r],ninp,0.0f,1.0f);
+     std::vector<float> x(ninp);
+     const QUANT_TYPE types[2] = {QUANT_INT8,QUANT_BF16};
+     for(const QUANT_TYPE qt : types)
+     {
+          network * q{load_network(const_cast<char*>(cfg.c_str()),const_cast<char*>(w32.c_str()),0)};
+          quantize_network(q,qt,calib);
+          save_weights(q,const_cast<char*>(wq.c_str()));
+          network * r{load_network(const_cast<char*>(cfg.c_str()),const_cast<char*>(wq.c_str()),0)};
+          for(int __i{0}; __i != r->n; ++__i)
+          {
+               const layer & l{r->layers[__i]};
+               if((l.type == CONVOLUTIONAL || l.type == CONNECTED) && l.quantized != qt) test_fail(__PRETTY_FUNCTION__);
+          }
+          double e{0.0};
+          for(int __t{0}; __t != 8; ++__t)
+          {
+               fill_rand(x.data(),x.size(),0.0f,1.0f);
+               const std::vector<float> y32{predict(ref,x.data())};
+               const std::vector<float> yq{predict(q,x.data())};
+               const std::vector<float> yr{predict(r,x.data())};
+               if(std::memcmp(yq.data(),yr.data(),yq.size()*sizeof(float)) != 0)
+               {
+                    printf("%s: reloaded network differs from the quantized one\n",qt == QUANT_INT8 ? "int8" : "bf16");
+                    test_fail(__PRETTY_FUNCTION__);
+               }
+               for(std::size_t __j{0}; __j != y32.size(); ++__j) e = std::max(e,static_cast<double>(std::fabs(yq[__j]-y32[__j])));
+          }
+          printf("%s: reload bitwise equal, max |p-p32| %.3e\n",qt == QUANT_INT8 ? "int8" : "bf16",e);
+          if(!(e <= 0.05)) test_fail(__PRETTY_FUNCTION__);
+          free_network(q);
+          free_network(r);
+     }
+     // fp32 files with revision 1 or 2 are not taken for quantized ones
+     for(int rev{1}; rev != 3; ++rev)
+     {
+          fp = std::fopen(w32.c_str(),"r+b");
+          std::fseek(fp,2*sizeof(int),SEEK_SET);
+          std::fwrite(&rev,sizeof(int),1,fp);
+          std::fclose(fp);
+          network * r{load_network(const_cast<char*>(cfg.c_str()),const_cast<char*>(w32.c_str()),0)};
+          for(int __i{0}; __i != r->n; ++__i)
+               if(r->layers[__i].quantized != QUANT_NONE) test_fail(__PRETTY_FUNCTION__);
+          fill_rand(x.data(),x.size(),0.0f,1.0f);
+          const std::vector<float> y32{predict(ref,x.data())};
+          const std::vector<float> yr{predict(r,x.data())};
+          if(std::memcmp(y32.data(),yr.data(),y32.size()*sizeof(float)) != 0)
+          {
+               printf("revision %d: fp32 file misread\n",rev);
+               test_fail(__PRETTY_FUNCTION__);
+          }
+          free_network(r);
+     }
+     free_matrix(calib.X);
+     free_network(ref);
+     std::remove(cfg.c_str());
+     std::remove(w32.c_str());
+     std::remove(wq.c_str());
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+     unit_test_darknet_gemm_int8_bf16();
+     unit_test_darknet_quantized_weights_roundtrip();
+     return 0;
+}
@@ -0,0 +1,324 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_delaunay_omp.h"
+#include <string>
+using std::string; // GMS_triangulation.h expects it
+#include "GMS_triangulation.h"
+
+/*
+   icpc -o unit_test_delaunay_omp -fp-model precise -no-fma -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_delaunay_omp.h GMS_delaunay_omp.cpp GMS_triangulation.h GMS_triangulation.cpp unit_test_delaunay_omp.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_delaunay_omp.h GMS_delaunay_omp.cpp unit_test_delaunay_omp.cpp
+
+   The predicates are checked against exact integer (__int128) determinants of near degenerate
+   input, the triangulation against r8tris2 (random nodes) and, for degenerate node sets (grids,
+   circles, collinear rows), by the validity of the triangle_node/triangle_neighbor layout and the
+   local Delaunay property of every interior edge.
+*/
+
+static int32_t unit_test_sign(const __int128 v)
+{
+       return (v > 0) - (v < 0);
+}
+
+static int32_t unit_test_sign(const double v)
+{
+       return (v > 0.0) - (v < 0.0);
+}
+
+void unit_test_predicates();
+
+void unit_test_predicates()
+{
+     using namespace gms::math;
+     constexpr int32_t ntest{200000};
+     constexpr double  sc{1.0/1073741824.0}; // 2^-30, x = 1+k*2^-30 is exact
+     std::mt19937_64 rng(7ULL);
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     int32_t nzero{0};
+     // nearly collinear triples
+     std::uniform_int_distribution<int64_t> base((1LL<<28),(1LL<<29)-1);
+     std::uniform_int_distribution<int64_t> step(-(1LL<<12),(1LL<<12));
+     std::uniform_int_distribution<int64_t> mult(-(1LL<<12),(1LL<<12));
+     std::uniform_int_distribution<int64_t> pert(-2,2);
+     for(int32_t __i{0}; __i != ntest && !fail; ++__i)
+     {
+         // a, b = a+m*s, c = a+j*s (+ a perturbation of a few units)
+         int64_t k[6];
+         const int64_t sx{step(rng)}, sy{step(rng)}, m{mult(rng)}, j{mult(rng)};
+         k[0] = base(rng); k[1] = base(rng);
+         k[2] = k[0]+m*sx; k[3] = k[1]+m*sy;
+         k[4] = k[0]+j*sx+((__i%2 == 0) ? 0 : pert(rng));
+         k[5] = k[1]+j*sy+((__i%2 == 0) ? 0 : pert(rng));
+         const double a[2] = {1.0+k[0]*sc,1.0+k[1]*sc}, b[2] = {1.0+k[2]*sc,1.0+k[3]*sc}, c[2] = {1.0+k[4]*sc,1.0+k[5]*sc};
+         const __int128 det{static_cast<__int128>(k[0]-k[4])*(k[3]-k[5])-static_cast<__int128>(k[1]-k[5])*(k[2]-k[4])};
+         nzero += (det == 0);
+         if(unit_test_sign(orient2d_robust(a,b,c)) != unit_test_sign(det))
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, orient2d_robust test %d" ANSI_RESET_ALL "\n",__i);
+            fail = true;
+         }
+     }
+     printf("orient2d: %d tests, %d collinear\n",ntest,nzero);
+     // lattice quadruples (many cocircular) and larger near degenerate coordinates
+     nzero = 0;
+     for(int32_t __i{0}; __i != ntest && !fail; ++__i)
+     {
+         std::uniform_int_distribution<int64_t> lat(0,(__i%2 == 0) ? 15 : (1LL<<20)-1);
+         int64_t k[8];
+         for(int32_t __j{0}; __j != 8; ++__j) k[__j] = lat(rng);
+         double p[8];
+         for(int32_t __j{0}; __j != 8; ++__j) p[__j] = 1.0+k[__j]*sc;
+         const __int128 adx{k[0]-k[6]}, ady{k[1]-k[7]}, bdx{k[2]-k[6]}, bdy{k[3]-k[7]}, cdx{k[4]-k[6]}, cdy{k[5]-k[7]};
+         const __int128 det{(adx*adx+ady*ady)*(bdx*cdy-bdy*cdx)+(bdx*bdx+bdy*bdy)*(cdx*ady-cdy*adx)+
+                            (cdx*cdx+cdy*cdy)*(adx*bdy-ady*bdx)};
+         nzero += (det == 0);
+         if(unit_test_sign(incircle_robust(&p[0],&p[2],&p[4],&p[6])) != unit_test_sign(det))
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, incircle_robust test %d" ANSI_RESET_ALL "\n",__i);
+            fail = true;
+         }
+     }
+     printf("incircle: %d tests, %d cocircular\n",ntest,nzero);
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: orient2d_robust/incircle_robust -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+/*
+    Layout and Delaunay check: counterclockwise triangles, 2*n-nb-2 triangles, symmetric
+    neighbors, one counterclockwise cycle of boundary links, no node inside the
+    circumcircle of an adjacent triangle.
+*/
+static bool unit_test_check(const int32_t n,const double * xy,const int32_t ntri,
+                            const int32_t * tn,const int32_t * tb,const char * name)
+{
+       using namespace gms::math;
+       int32_t nb{0}, nbad{0}, nflip{0};
+       for(int32_t __t{0}; __t != ntri; ++__t)
+       {
+           if(orient2d_robust(&xy[2*tn[3*__t]],&xy[2*tn[3*__t+1]],&xy[2*tn[3*__t+2]]) <= 0.0) ++nbad;
+           for(int32_t __j{0}; __j != 3; ++__j)
+           {
+               const int32_t a{tn[3*__t+__j]}, b{tn[3*__t+(__j+1)%3]};
+               const int32_t nbr{tb[3*__t+__j]};
+               if(nbr > 0)
+               {
+                  const int32_t u{nbr-1};
+                  int32_t k{-1};
+                  for(int32_t __m{0}; __m != 3; ++__m)
+                      if(tn[3*u+__m] == b && tn[3*u+(__m+1)%3] == a) k = __m;
+                  if(k < 0 || tb[3*u+k] != __t+1) {++nbad; continue;}
+                  const int32_t d{tn[3*u+(k+2)%3]};
+                  if(incircle_robust(&xy[2*tn[3*__t]],&xy[2*tn[3*__t+1]],&xy[2*tn[3*__t+2]],&xy[2*d]) > 0.0) ++nflip;
+               }
+               else
+               {
+                  ++nb;
+                  const int32_t l{-nbr};
+                  const int32_t t2{l/3-1}, j2{l%3};
+                  if(t2 < 0 || t2 >= ntri || tb[3*t2+j2] > 0 || tn[3*t2+j2] != b) ++nbad;
+               }
+           }
+       }
+       // the boundary links form a single cycle
+       int32_t t0{-1}, j0{-1};
+       for(int32_t __t{0}; __t != ntri && t0 < 0; ++__t)
+           for(int32_t __j{0}; __j != 3; ++__j)
+               if(tb[3*__t+__j] < 0) {t0 = __t; j0 = __j; break;}
+       int32_t len{0};
+       if(t0 >= 0 && nbad == 0)
+       {
+          int32_t t{t0}, j{j0};
+          do {
+             const int32_t l{-tb[3*t+j]};
+             t = l/3-1; j = l%3;
+             ++len;
+          } while((t != t0 || j != j0) && len <= nb);
+       }
+       const bool ok{nbad == 0 && nflip == 0 && ntri == 2*n-nb-2 && len == nb};
+       printf("%-22s nodes=%8d triangles=%8d boundary=%6d cycle=%6d invalid=%d non-Delaunay=%d\n",
+              name,n,ntri,nb,len,nbad,nflip);
+       return ok;
+}
+
+static void unit_test_triangle_keys(const int32_t ntri,const int32_t * tn,std::vector<std::array<int32_t,3>> & keys)
+{
+       keys.resize(ntri);
+       for(int32_t __t{0}; __t != ntri; ++__t)
+       {
+           int32_t m{0};
+           for(int32_t __j{1}; __j != 3; ++__j) if(tn[3*__t+__j] < tn[3*__t+m]) m = __j;
+           keys[__t] = {tn[3*__t+m],tn[3*__t+(m+1)%3],tn[3*__t+(m+2)%3]};
+       }
+}
+
+void unit_test_delaunay_random();
+
+void unit_test_delaunay_random()
+{
+     using namespace gms::math;
+     constexpr int32_t n{20000};
+     std::mt19937_64 rng(1019ULL);
+     std::uniform_real_distribution<double> u(-1.0,1.0);
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     std::vector<double> xy(2*n);
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+         xy[2*__i]   = u(rng);
+         xy[2*__i+1] = u(rng);
+     }
+     std::vector<int32_t> tn(6*n), tb(6*n), rn(6*n), rb(6*n);
+     int32_t ntri,rtri;
+     if(r8tris2_dc_omp(n,xy.data(),&ntri,tn.data(),tb.data()) != 0 || !unit_test_check(n,xy.data(),ntri,tn.data(),tb.data(),"random"))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, r8tris2_dc_omp (random)" ANSI_RESET_ALL "\n");
+        std::exit(EXIT_FAILURE);
+     }
+     std::vector<double> xr(xy);
+     r8tris2(n,xr.data(),&rtri,rn.data(),rb.data());
+     std::vector<std::array<int32_t,3>> k1,k2;
+     unit_test_triangle_keys(ntri,tn.data(),k1);
+     unit_test_triangle_keys(rtri,rn.data(),k2);
+     // the neighbors must match too: compare the (triangle, neighbor) key pairs
+     std::map<std::array<int32_t,3>,std::array<std::array<int32_t,3>,3>> m1,m2;
+     auto neighbors = [](const int32_t ntr,const int32_t * nd,const int32_t * nb,
+                         const std::vector<std::array<int32_t,3>> & k,
+                         std::map<std::array<int32_t,3>,std::array<std::array<int32_t,3>,3>> & m) {
+          for(int32_t __t{0}; __t != ntr; ++__t)
+          {
+              std::array<std::array<int32_t,3>,3> a;
+              for(int32_t __j{0}; __j != 3; ++__j)
+              {
+                  const int32_t v{nd[3*__t+__j]};
+                  const int32_t jj{(k[__t][0] == v) ? 0 : ((k[__t][1] == v) ? 1 : 2)};
+                  const int32_t x{nb[3*__t+__j]};
+                  a[jj] = (x > 0) ? k[x-1] : std::array<int32_t,3>{-1,-1,-1};
+              }
+              m[k[__t]] = a;
+          }
+     };
+     neighbors(ntri,tn.data(),tb.data(),k1,m1);
+     neighbors(rtri,rn.data(),rb.data(),k2,m2);
+     if(ntri != rtri || m1 != m2)
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, r8tris2_dc_omp differs from r8tris2 (%d/%d triangles)" ANSI_RESET_ALL "\n",ntri,rtri);
+        fail = true;
+     }
+     // result independent of the thread count
+     const int32_t nth{omp_get_max_threads()};
+     omp_set_num_threads(1);
+     std::vector<int32_t> sn(6*n), sb(6*n);
+     int32_t stri;
+     r8tris2_dc_omp(n,xy.data(),&stri,sn.data(),sb.data());
+     omp_set_num_threads(nth);
+     if(stri != ntri || !std::equal(tn.begin(),tn.begin()+3*ntri,sn.begin()) || !std::equal(tb.begin(),tb.begin()+3*ntri,sb.begin()))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, 1 thread and %d threads results differ" ANSI_RESET_ALL "\n",nth);
+        fail = true;
+     }
+     // clustered nodes (r8tris2 loses the Delaunay property here, its tests are not exact)
+     for(int32_t __i{0}; __i < n; __i += 3)
+     {
+         xy[2*__i]   = 0.01*u(rng)+0.3;
+         xy[2*__i+1] = 0.01*u(rng)-0.2;
+     }
+     if(r8tris2_dc_omp(n,xy.data(),&ntri,tn.data(),tb.data()) != 0 || !unit_test_check(n,xy.data(),ntri,tn.data(),tb.data(),"random, clustered"))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, r8tris2_dc_omp (clustered)" ANSI_RESET_ALL "\n");
+        fail = true;
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: r8tris2_dc_omp == r8tris2 -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_delaunay_degenerate();
+
+void unit_test_delaunay_degenerate()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     std::vector<std::pair<const char*,std::vector<double>>> sets;
+     {   // regular grid, every cell is cocircular
+         std::vector<double> xy;
+         for(int32_t __j{0}; __j != 100; ++__j)
+             for(int32_t __i{0}; __i != 150; ++__i) {xy.push_back(0.5*__i); xy.push_back(0.5*__j);}
+         sets.emplace_back("grid 150x100",xy);
+     }
+     {   // rotated grid (inexact coordinates) with a large offset
+         std::vector<double> xy;
+         const double c{std::cos(0.5235987755982988)}, s{std::sin(0.5235987755982988)};
+         for(int32_t __j{0}; __j != 90; ++__j)
+             for(int32_t __i{0}; __i != 90; ++__i) {xy.push_back(1.0e6+c*__i-s*__j); xy.push_back(2.0e6+s*__i+c*__j);}
+         sets.emplace_back("rotated grid 90x90",xy);
+     }
+     {   // cocircular nodes and the center
+         std::vector<double> xy = {0.0,0.0};
+         for(int32_t __i{0}; __i != 64; ++__i)
+         {
+             const double a{6.283185307179586*__i/64.0};
+             xy.push_back(std::cos(a)); xy.push_back(std::sin(a));
+         }
+         // exactly cocircular lattice points of x^2+y^2 = 25^2
+         const int32_t pyth[12][2] = {{25,0},{24,7},{20,15},{15,20},{7,24},{0,25},{-7,24},{-15,20},{-20,15},{-24,7},{-25,0},{-24,-7}};
+         for(int32_t __i{0}; __i != 12; ++__i) {xy.push_back(10.0+pyth[__i][0]); xy.push_back(pyth[__i][1]);}
+         sets.emplace_back("circles",xy);
+     }
+     {   // collinear rows and a few scattered nodes
+         std::vector<double> xy;
+         for(int32_t __r{0}; __r != 5; ++__r)
+             for(int32_t __i{0}; __i != 400; ++__i) {xy.push_back(0.25*__i+0.1*__r); xy.push_back(3.0*__r+0.01*__i);}
+         xy.push_back(50.0); xy.push_back(-7.0);
+         xy.push_back(-3.0); xy.push_back(20.0);
+         sets.emplace_back("collinear rows",xy);
+     }
+     for(auto & st : sets)
+     {
+         const int32_t n{static_cast<int32_t>(st.second.size()/2)};
+         std::vector<int32_t> tn(6*n), tb(6*n);
+         int32_t ntri;
+         const int32_t err{r8tris2_dc_omp(n,st.second.data(),&ntri,tn.data(),tb.data())};
+         if(err != 0 || !unit_test_check(n,st.second.data(),ntri,tn.data(),tb.data(),st.first))
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, %s (error %d)" ANSI_RESET_ALL "\n",st.first,err);
+            fail = true;
+         }
+     }
+     {   // error returns
+         std::vector<double> col, dup = {0.0,0.0, 1.0,0.0, 0.0,1.0, 1.0,0.0};
+         for(int32_t __i{0}; __i != 100; ++__i) {col.push_back(0.5*__i); col.push_back(0.25*__i);}
+         std::vector<int32_t> tn(600), tb(600);
+         int32_t ntri;
+         const int32_t e1{r8tris2_dc_omp(100,col.data(),&ntri,tn.data(),tb.data())};
+         const int32_t e2{r8tris2_dc_omp(4,dup.data(),&ntri,tn.data(),tb.data())};
+         if(e1 != 225 || e2 != 224)
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, error returns collinear=%d, coincident=%d" ANSI_RESET_ALL "\n",e1,e2);
+            fail = true;
+         }
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: r8tris2_dc_omp degenerate input -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+int main()
+{
+    unit_test_predicates();
+    unit_test_delaunay_random();
+    unit_test_delaunay_degenerate();
+    return 0;
+}
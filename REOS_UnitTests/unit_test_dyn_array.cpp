@@ -6,8 +6,12 @@
 #include "GMS_dyn_array.h"
 
 /*
-   icpc -o unit_test_dyn_array -fp-model fast=2 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h GMS_dyn_array.h unit_test_dyn_array.cpp
+   icpc -o unit_test_dyn_array -fp-model fast=2 -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_alloc_policy.h GMS_alloc_policy.cpp \
+   GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp \
+   GMS_sse_memcpy.h GMS_sse_memcpy.cpp GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp \
+   GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_dyn_array.h unit_test_dyn_array.cpp -ltbbmalloc
    ASM: 
    icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -falign-functions=32   GMS_config.h GMS_malloc.h GMS_dyn_array.h unit_test_dyn_array.cpp
 
@@ -0,0 +1,265 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_em_fields_fused_zmm16r4.h"
+
+/*
+   icpc -o unit_test_em_fields_fused_zmm16r4 -fp-model precise -std=c++17 -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+   -DENABLE_AVX512F GMS_config.h GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_par_team.h GMS_par_team.cpp GMS_em_fields_fused_zmm16r4.h GMS_em_fields_fused_zmm16r4.cpp unit_test_em_fields_fused_zmm16r4.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 -qopenmp -DENABLE_AVX512F GMS_config.h GMS_em_fields_fused_zmm16r4.h GMS_em_fields_fused_zmm16r4.cpp
+
+   The fused chain (serial and on the worker team) stores, for every output mask and length
+   (full tiles and remainders), the bit patterns of the per-stage chain (inputs
+   with NaN, Inf, signed zeros and huge arguments included, NaN lanes NaN in both)
+   and references only the selected outputs. The per-stage chain is checked against the plane-wave
+   identities: |dir| = |pol| = 1, dir.pol = 0, |H| = |exp(i*k*(dir.r))|,
+   |B| = |k|/(omega*mu0)*|H| and H.B = 0.
+*/
+
+namespace {
+
+     using gms::radiolocation::PW_ZMM16C4;
+     using gms::radiolocation::PW_Inputs;
+     using gms::radiolocation::PW_Outputs;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     float rnd(uint64_t & s,const float lo,const float hi)
+     {
+          s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+          return (lo+(hi-lo)*static_cast<float>(s >> 40)*(1.0f/16777216.0f));
+     }
+
+     // the arrays of the inputs and of every output, n registers each
+     struct buffers_t
+     {
+          std::vector<__m512>     r[7];   // tht,phi,psi,omg,px,py,pz
+          std::vector<PW_ZMM16C4> k;
+          std::vector<__m512>     o[8];   // dvx,dvy,dvz,pvx,pvy,pvz,Hn,Bn
+          std::vector<PW_ZMM16C4> c[7];   // Hx,Hy,Hz,Bx,By,Bz,HB
+
+          explicit buffers_t(const int32_t n)
+          {
+               const std::size_t m{static_cast<std::size_t>(n)};
+               for(auto & v : r) v.resize(m);
+               k.resize(m);
+               for(auto & v : o) v.assign(m,_mm512_set1_ps(-7.0f));
+               for(auto & v : c) v.assign(m,PW_ZMM16C4{_mm512_set1_ps(-7.0f),_mm512_set1_ps(-7.0f)});
+          }
+
+          PW_Inputs inputs() const
+          {
+               return (PW_Inputs{r[0].data(),r[1].data(),r[2].data(),r[3].data(),
+                                 r[4].data(),r[5].data(),r[6].data(),k.data()});
+          }
+
+          // outputs of mask, the others nullptr
+          PW_Outputs outputs(const uint32_t mask)
+          {
+               PW_Outputs p{};
+               if(mask & PW_OUT__DIR)   { p.dvx = o[0].data(); p.dvy = o[1].data(); p.dvz = o[2].data(); }
+               if(mask & PW_OUT__POL)   { p.pvx = o[3].data(); p.pvy = o[4].data(); p.pvz = o[5].data(); }
+               if(mask & PW_OUT__H)     { p.Hx  = c[0].data(); p.Hy  = c[1].data(); p.Hz  = c[2].data(); }
+               if(mask & PW_OUT__B)     { p.Bx  = c[3].data(); p.By  = c[4].data(); p.Bz  = c[5].data(); }
+               if(mask & PW_OUT__HNORM) p.Hn = o[6].data();
+               if(mask & PW_OUT__BNORM) p.Bn = o[7].data();
+               if(mask & PW_OUT__HBDOT) p.HB = c[6].data();
+               return (p);
+          }
+     };
+
+     void fill_inputs(buffers_t & b,const int32_t n,uint64_t seed,const bool special)
+     {
+          float * f[7];
+          for(int32_t __a{0}; __a != 7; ++__a) f[__a] = reinterpret_cast<float*>(b.r[__a].data());
+          float * kk{reinterpret_cast<float*>(b.k.data())};
+          for(int32_t __i{0}; __i != 16*n; ++__i)
+          {
+               f[0][__i] = rnd(seed,0.0f,3.14159265f);
+               f[1][__i] = rnd(seed,-3.14159265f,3.14159265f);
+               f[2][__i] = rnd(seed,-3.14159265f,3.14159265f);
+               f[3][__i] = rnd(seed,1.0e8f,1.0e10f);
+               f[4][__i] = rnd(seed,-5.0f,5.0f);
+               f[5][__i] = rnd(seed,-5.0f,5.0f);
+               f[6][__i] = rnd(seed,-5.0f,5.0f);
+               const std::size_t r{static_cast<std::size_t>(__i/16)*32ull+static_cast<std::size_t>(__i%16)};
+               kk[r]      = rnd(seed,0.1f,20.0f);   // k.re
+               kk[r+16ull] = rnd(seed,-0.5f,0.0f);  // k.im, attenuating
+          }
+          if(special)
+          {
+               const float sv[] = {NAN,INFINITY,-INFINITY,0.0f,-0.0f,1.0e30f,-1.0e30f,1.0e-40f};
+               for(int32_t __i{0}; __i < 16*n; __i += 5)
+               {
+                    const float v{sv[(__i/5)%8]};
+                    f[(__i/5)%7][__i] = v;
+                    if((__i/5)%3 == 0) kk[static_cast<std::size_t>(__i/16)*32ull+static_cast<std::size_t>(__i%16)] = v;
+               }
+          }
+     }
+
+     // bitwise equal, a NaN equal to any NaN (the payload of a NaN produced from two
+     // NaN operands depends on the operand order, which the compiler may commute)
+     bool same_bits(const void * a,const void * b,const std::size_t nbytes)
+     {
+          const float * fa{reinterpret_cast<const float*>(a)};
+          const float * fb{reinterpret_cast<const float*>(b)};
+          for(std::size_t __i{0ull}; __i != nbytes/sizeof(float); ++__i)
+          {
+               if(std::isnan(fa[__i]) && std::isnan(fb[__i])) continue;
+               if(std::memcmp(&fa[__i],&fb[__i],sizeof(float)) != 0) return (false);
+          }
+          return (true);
+     }
+
+     // selected outputs of x bitwise equal to the ones of y, the others untouched in x
+     bool compare(buffers_t & x,buffers_t & y,const uint32_t mask,const int32_t n)
+     {
+          const std::size_t br{sizeof(__m512)*static_cast<std::size_t>(n)};
+          const std::size_t bc{sizeof(PW_ZMM16C4)*static_cast<std::size_t>(n)};
+          const uint32_t om[8] = {PW_OUT__DIR,PW_OUT__DIR,PW_OUT__DIR,PW_OUT__POL,PW_OUT__POL,PW_OUT__POL,
+                                  PW_OUT__HNORM,PW_OUT__BNORM};
+          const uint32_t cm[7] = {PW_OUT__H,PW_OUT__H,PW_OUT__H,PW_OUT__B,PW_OUT__B,PW_OUT__B,PW_OUT__HBDOT};
+          for(int32_t __a{0}; __a != 8; ++__a)
+          {
+               if(mask & om[__a])
+               {
+                    if(!same_bits(x.o[__a].data(),y.o[__a].data(),br)) return (false);
+               }
+               else
+               {
+                    for(const __m512 & v : x.o[__a])
+                        if(_mm512_cmpneq_ps_mask(v,_mm512_set1_ps(-7.0f)) != 0) return (false);
+               }
+          }
+          for(int32_t __a{0}; __a != 7; ++__a)
+          {
+               if(mask & cm[__a])
+               {
+                    if(!same_bits(x.c[__a].data(),y.c[__a].data(),bc)) return (false);
+               }
+               else
+               {
+                    for(const PW_ZMM16C4 & v : x.c[__a])
+                        if(_mm512_cmpneq_ps_mask(v.re,_mm512_set1_ps(-7.0f)) != 0) return (false);
+               }
+          }
+          return (true);
+     }
+
+}
+
+void unit_test_em_fields_fused_bitexact();
+
+void unit_test_em_fields_fused_bitexact()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t lens[] = {1,2,3,PW_FUSED_TILE*4+1,37};
+     int32_t ncmp{0};
+     for(int32_t n : lens)
+     {
+          for(int32_t __s{0}; __s != 2; ++__s)
+          {
+               buffers_t ref(n);
+               fill_inputs(ref,n,0x243F6A8885A308D3ull+static_cast<uint64_t>(n),__s == 1);
+               if(pw_field_chain_zmm16r4(ref.inputs(),ref.outputs(PW_OUT__ALL),PW_OUT__ALL,n) != 0)
+                  test_fail(__PRETTY_FUNCTION__);
+               for(uint32_t mask{1u}; mask <= PW_OUT__ALL; ++mask)
+               {
+                    for(int32_t __v{0}; __v != 3; ++__v)
+                    {
+                         buffers_t x(n);
+                         for(int32_t __a{0}; __a != 7; ++__a) x.r[__a] = ref.r[__a];
+                         x.k = ref.k;
+                         int32_t rc{0};
+                         if(__v == 0)      rc = pw_field_chain_fused_zmm16r4(x.inputs(),x.outputs(mask),mask,n);
+                         else if(__v == 1) rc = pw_field_chain_fused_omp(x.inputs(),x.outputs(mask),mask,n);
+                         else
+                         {
+                              // the per-stage chain with only the stages of the mask
+                              rc = pw_field_chain_zmm16r4(x.inputs(),x.outputs(mask|pw_stages_of(mask)),mask,n);
+                         }
+                         if(rc != 0) test_fail(__PRETTY_FUNCTION__);
+                         if(!compare(x,ref,(__v == 2) ? (mask|pw_stages_of(mask)) : mask,n))
+                         {
+                              printf("n=%d, special=%d, mask=0x%02x, variant=%d\n",n,__s,mask,__v);
+                              test_fail(__PRETTY_FUNCTION__);
+                         }
+                         ++ncmp;
+                    }
+               }
+          }
+     }
+     printf("%d comparisons, all bitwise equal\n",ncmp);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_em_fields_fused_identities();
+
+void unit_test_em_fields_fused_identities()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t n{16};
+     buffers_t b(n);
+     fill_inputs(b,n,0x13198A2E03707344ull,false);
+     if(pw_field_chain_zmm16r4(b.inputs(),b.outputs(PW_OUT__ALL),PW_OUT__ALL,n) != 0)
+        test_fail(__PRETTY_FUNCTION__);
+     const float * f[7];
+     for(int32_t __a{0}; __a != 7; ++__a) f[__a] = reinterpret_cast<const float*>(b.r[__a].data());
+     const float * o[8];
+     for(int32_t __a{0}; __a != 8; ++__a) o[__a] = reinterpret_cast<const float*>(b.o[__a].data());
+     const float * c[7];
+     for(int32_t __a{0}; __a != 7; ++__a) c[__a] = reinterpret_cast<const float*>(b.c[__a].data());
+     const float * kk{reinterpret_cast<const float*>(b.k.data())};
+     double err{0.0};
+     for(int32_t __i{0}; __i != 16*n; ++__i)
+     {
+          const std::size_t j{static_cast<std::size_t>(__i)};
+          const std::size_t r{static_cast<std::size_t>(__i/16)*32ull+static_cast<std::size_t>(__i%16)};
+          const double d[3] = {o[0][j],o[1][j],o[2][j]};
+          const double p[3] = {o[3][j],o[4][j],o[5][j]};
+          const double kre{kk[r]},kim{kk[r+16ull]};
+          const double dr{d[0]*f[4][j]+d[1]*f[5][j]+d[2]*f[6][j]};
+          // |exp(i*k*dr)| = exp(-Im(k)*dr)
+          const double eh{std::exp(-kim*dr)};
+          const double hn{o[6][j]},bn{o[7][j]};
+          const double kn{std::sqrt(kre*kre+kim*kim)/(static_cast<double>(f[3][j])*1.2566370614359173e-6)};
+          const double hb{std::hypot(static_cast<double>(c[6][r]),static_cast<double>(c[6][r+16ull]))};
+          err = std::max(err,std::fabs(d[0]*d[0]+d[1]*d[1]+d[2]*d[2]-1.0));
+          err = std::max(err,std::fabs(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]-1.0));
+          err = std::max(err,std::fabs(d[0]*p[0]+d[1]*p[1]+d[2]*p[2]));
+          err = std::max(err,std::fabs(hn/eh-1.0));
+          err = std::max(err,std::fabs(bn/(kn*hn)-1.0));
+          err = std::max(err,hb/(hn*bn));
+     }
+     printf("max. relative error of the identities: %g\n",err);
+     if(!(err < 1.0e-5)) test_fail(__PRETTY_FUNCTION__);
+     // a selected output without its array
+     PW_Outputs p{b.outputs(PW_OUT__ALL)};
+     p.Bn = nullptr;
+     if(pw_field_chain_fused_zmm16r4(b.inputs(),p,PW_OUT__BNORM,n) != 1) test_fail(__PRETTY_FUNCTION__);
+     if(pw_field_chain_fused_zmm16r4(b.inputs(),p,PW_OUT__HNORM,n) != 0) test_fail(__PRETTY_FUNCTION__);
+     // the per-stage chain needs the arrays of the intermediate stages
+     if(pw_field_chain_zmm16r4(b.inputs(),b.outputs(PW_OUT__HNORM),PW_OUT__HNORM,n) != 1) test_fail(__PRETTY_FUNCTION__);
+     if(pw_field_chain_fused_zmm16r4(b.inputs(),b.outputs(PW_OUT__HNORM),PW_OUT__HNORM,n) != 0) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_em_fields_fused_bitexact();
+    unit_test_em_fields_fused_identities();
+    return 0;
+}
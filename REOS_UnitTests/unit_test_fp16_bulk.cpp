@@ -0,0 +1,306 @@
+// The reference conversions shall be the software (bit-manipulation) path of GMS_half.h.
+#if !defined(HALF_ENABLE_F16C_INTRINSICS)
+#define HALF_ENABLE_F16C_INTRINSICS 0
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <random>
+#include <type_traits>
+#include "GMS_config.h"
+#include "GMS_fp16_bulk.h"
+#include "GMS_dyn_array.h"
+#include "GMS_am_bb_cosine_signal_fp16.h"
+#include "GMS_am_bb_sine_signal_fp16.h"
+
+/*
+   icpc -o unit_test_fp16_bulk -DHALF_ENABLE_F16C_INTRINSICS=0 -fp-model fast=2 -std=c++17 -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_half.h GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_fp16_bulk.h GMS_fp16_bulk.cpp GMS_dyn_array.h GMS_cephes_sin_cos.h GMS_indices.h \
+   GMS_alloc_policy.h GMS_alloc_policy.cpp GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp \
+   GMS_sse_memcpy.h GMS_sse_memcpy.cpp GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp \
+   GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_am_bb_cosine_signal_fp16.h GMS_am_bb_cosine_signal_fp16.cpp GMS_am_bb_sine_signal_fp16.h GMS_am_bb_sine_signal_fp16.cpp unit_test_fp16_bulk.cpp -ltbbmalloc
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 GMS_config.h GMS_half.h GMS_fp16_bulk.h GMS_fp16_bulk.cpp unit_test_fp16_bulk.cpp
+
+   The bulk kernels against the element-wise software conversions of half_float::half:
+   all 65536 binary16 patterns (half -> float), a strided sweep of the binary32 patterns
+   and the rounding/overflow/subnormal edge cases (float -> half), every remainder length,
+   the fp32-compute kernels, the darray_r2_t/darray_c2_t bulk members and the fp16 signal
+   generators against the per-sample half_cast.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     inline std::uint16_t hbits(const half_float::half h)
+     {
+          std::uint16_t b;
+          std::memcpy(&b,&h,sizeof(b));
+          return (b);
+     }
+
+     // half is trivially copyable (its only member is the uint16 pattern), the bits are
+     // copied into its raw storage
+     static_assert(std::is_trivially_copyable<half_float::half>::value,"half_float::half");
+
+     inline half_float::half hbfrom(const std::uint16_t b)
+     {
+          half_float::half h;
+          std::memcpy(static_cast<void*>(&h),&b,sizeof(b));
+          return (h);
+     }
+
+     inline std::uint32_t fbits(const float f)
+     {
+          std::uint32_t b;
+          std::memcpy(&b,&f,sizeof(b));
+          return (b);
+     }
+
+     inline float bfloat(const std::uint32_t b)
+     {
+          float f;
+          std::memcpy(&f,&b,sizeof(f));
+          return (f);
+     }
+
+     // Distance in units of the last place, binary16 patterns of the same sign.
+     inline int32_t hulps(const half_float::half a,const half_float::half b)
+     {
+          const int32_t ia{hbits(a)}, ib{hbits(b)};
+          if((ia ^ ib) & 0x8000) return ((ia & 0x7FFF) + (ib & 0x7FFF));
+          return (std::abs(ia-ib));
+     }
+
+}
+
+void unit_test_fp16_bulk_cvt();
+
+void unit_test_fp16_bulk_cvt()
+{
+     using namespace gms::common;
+     using namespace half_float;
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: code path: %s\n",fp16_bulk_isa_name());
+     // half -> float, every pattern, NaN payloads compared bitwise (the hardware conversion quiets
+     // the signaling NaNs, the software one of GMS_half.h does not, i.e. the quiet bit is ignored)
+     {
+          std::vector<half>  h(65536);
+          std::vector<float> f(65536);
+          for(std::uint32_t __i{0}; __i != 65536u; ++__i) h[__i] = hbfrom(static_cast<std::uint16_t>(__i));
+          cvt_f16_f32(h.data(),f.data(),h.size());
+          for(std::uint32_t __i{0}; __i != 65536u; ++__i)
+          {
+               const std::uint32_t qnan{std::isnan(f[__i]) ? 0x00400000u : 0u};
+               if((fbits(f[__i]) | qnan) != (fbits(static_cast<float>(h[__i])) | qnan))
+               {
+                    printf("half -> float: 0x%04x -> 0x%08x, expected 0x%08x\n",__i,fbits(f[__i]),fbits(static_cast<float>(h[__i])));
+                    fail = true;
+                    break;
+               }
+          }
+     }
+     // float -> half, strided sweep of all binary32 patterns plus the edge cases
+     {
+          std::vector<float> f;
+          for(std::uint64_t __b{0ull}; __b < 0x100000000ull; __b += 4099ull) f.push_back(bfloat(static_cast<std::uint32_t>(__b)));
+          const float edge[] = {0.0f,-0.0f,65504.0f,65519.99f,65520.0f,-65520.0f,1.0e9f,
+                                std::numeric_limits<float>::infinity(),-std::numeric_limits<float>::infinity(),
+                                std::numeric_limits<float>::quiet_NaN(),bfloat(0x7F800001u),bfloat(0xFFC12345u),
+                                5.9604645e-8f,2.9802322e-8f,2.9802326e-8f,8.940697e-8f,6.1035156e-5f,6.097555e-5f,
+                                1.0f+0.00048828125f,1.0f+0.00146484375f,1.0e-30f,std::numeric_limits<float>::denorm_min()};
+          f.insert(f.end(),std::begin(edge),std::end(edge));
+          std::vector<half> h(f.size());
+          cvt_f32_f16(f.data(),h.data(),f.size());
+          for(std::size_t __i{0ull}; __i != f.size(); ++__i)
+          {
+               if(hbits(h[__i]) != hbits(half_cast<half>(f[__i])))
+               {
+                    printf("float -> half: 0x%08x -> 0x%04x, expected 0x%04x\n",fbits(f[__i]),hbits(h[__i]),hbits(half_cast<half>(f[__i])));
+                    fail = true;
+                    break;
+               }
+          }
+     }
+     // every remainder length, the guard elements stay untouched
+     {
+          std::mt19937 rng(1234u);
+          std::uniform_real_distribution<float> u(-100.0f,100.0f);
+          for(std::size_t n{0ull}; n != 70ull; ++n)
+          {
+               std::vector<float> f(n+2), g(n+2,-7.0f);
+               std::vector<half>  h(n+2,half_cast<half>(3.0f));
+               for(float & x : f) x = u(rng);
+               cvt_f32_f16(&f[1],&h[1],n);
+               cvt_f16_f32(&h[1],&g[1],n);
+               fail |= hbits(h[0]) != hbits(half_cast<half>(3.0f)) || hbits(h[n+1]) != hbits(half_cast<half>(3.0f));
+               fail |= g[0] != -7.0f || g[n+1] != -7.0f;
+               for(std::size_t __i{1ull}; __i != n+1ull; ++__i)
+                    fail |= hbits(h[__i]) != hbits(half_cast<half>(f[__i])) || g[__i] != static_cast<float>(h[__i]);
+               std::vector<half> c(n+2,half_cast<half>(0.0f));
+               fill_f16(&c[1],half_cast<half>(-2.5f),n);
+               fail |= hbits(c[0]) != 0u || hbits(c[n+1]) != 0u;
+               for(std::size_t __i{1ull}; __i != n+1ull; ++__i) fail |= hbits(c[__i]) != hbits(half_cast<half>(-2.5f));
+          }
+     }
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_fp16_bulk_compute();
+
+void unit_test_fp16_bulk_compute()
+{
+     using namespace gms::common;
+     using namespace half_float;
+     bool fail{false};
+     int32_t worst{0};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::mt19937 rng(4321u);
+     std::uniform_real_distribution<float> u(-8.0f,8.0f);
+     for(std::size_t n{0ull}; n < 100ull; n += 1ull+n/8ull)
+     {
+          std::vector<half> x(n), y(n), z(n), w(n);
+          std::vector<std::complex<half>> cx(n), cy(n), cz(n);
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+          {
+               x[__i]  = half_cast<half>(u(rng));
+               y[__i]  = half_cast<half>(u(rng));
+               cx[__i] = std::complex<half>(half_cast<half>(u(rng)),half_cast<half>(u(rng)));
+               cy[__i] = std::complex<half>(half_cast<half>(u(rng)),half_cast<half>(u(rng)));
+          }
+          const float a{-0.37f};
+          // the products of two binary16 values are exact in fp32, the results shall be bit-identical
+          mul_f16(x.data(),y.data(),z.data(),n);
+          w = x;
+          scale_f16(w.data(),a,n);
+          double dref{0.0};
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+          {
+               const float xi{static_cast<float>(x[__i])}, yi{static_cast<float>(y[__i])};
+               fail |= hbits(z[__i]) != hbits(half_cast<half>(xi*yi));
+               fail |= hbits(w[__i]) != hbits(half_cast<half>(a*xi));
+               dref += static_cast<double>(xi)*static_cast<double>(yi);
+          }
+          const float d{dot_f16(x.data(),y.data(),n)};
+          fail |= std::fabs(d-dref) > 1.0e-5*(1.0+std::fabs(dref));
+          // fused/unfused multiply-add, at most one ulp apart
+          z = y;
+          axpy_f16(a,x.data(),z.data(),n);
+          cmul_c2(cx.data(),cy.data(),cz.data(),n);
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+          {
+               const float xi{static_cast<float>(x[__i])}, yi{static_cast<float>(y[__i])};
+               worst = std::max(worst,hulps(z[__i],half_cast<half>(a*xi+yi)));
+               const std::complex<float> p{std::complex<float>(static_cast<float>(cx[__i].real()),static_cast<float>(cx[__i].imag()))*
+                                           std::complex<float>(static_cast<float>(cy[__i].real()),static_cast<float>(cy[__i].imag()))};
+               worst = std::max(worst,hulps(cz[__i].real(),half_cast<half>(p.real())));
+               worst = std::max(worst,hulps(cz[__i].imag(),half_cast<half>(p.imag())));
+          }
+     }
+     printf("[UNIT-TEST]: axpy_f16/cmul_c2 worst deviation: %d ulp(s)\n",worst);
+     fail |= worst > 1;
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_fp16_bulk_darray();
+
+void unit_test_fp16_bulk_darray()
+{
+     using namespace gms;
+     using namespace half_float;
+     constexpr std::size_t n{1029ull};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::vector<float> f(n), g(n);
+     std::vector<std::complex<float>> cf(n), cg(n);
+     for(std::size_t __i{0ull}; __i != n; ++__i)
+     {
+          f[__i]  = std::sin(0.01f*static_cast<float>(__i));
+          cf[__i] = std::complex<float>(std::cos(0.02f*static_cast<float>(__i)),-f[__i]);
+     }
+     darray_r2_t r2(n);
+     r2.load_r4(f.data());
+     // copy of a half array copies sizeof(half)*n bytes
+     const darray_r2_t r2c(r2);
+     r2c.store_r4(g.data());
+     for(std::size_t __i{0ull}; __i != n; ++__i) fail |= g[__i] != static_cast<float>(half_cast<half>(f[__i]));
+     r2.fill(half_cast<half>(1.5f));
+     for(std::size_t __i{0ull}; __i != n; ++__i) fail |= static_cast<float>(r2.m_data[__i]) != 1.5f;
+     darray_c2_t c2(n);
+     c2.load_c4(cf.data());
+     c2.store_c4(cg.data());
+     for(std::size_t __i{0ull}; __i != n; ++__i)
+          fail |= cg[__i].real() != static_cast<float>(half_cast<half>(cf[__i].real())) ||
+                  cg[__i].imag() != static_cast<float>(half_cast<half>(cf[__i].imag()));
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_fp16_bulk_signals();
+
+void unit_test_fp16_bulk_signals()
+{
+     using namespace gms::radiolocation;
+     using namespace half_float;
+     // not a multiple of the tile nor of the unroll factor
+     constexpr std::size_t   n_samples{1293ull};
+     constexpr std::uint32_t n_K{5};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::vector<float> sym(n_samples*n_K);
+     std::mt19937 rng(77u);
+     std::uniform_real_distribution<float> u(-1.0f,1.0f);
+     for(float & s : sym) s = u(rng);
+     am_bb_cosine_signal_fp16_t cs(n_samples,n_K,16.0f,1.0f,8.0f), cs4(n_samples,n_K,16.0f,1.0f,8.0f);
+     am_bb_sine_signal_fp16_t   ss(n_samples,n_K,16.0f,1.0f,8.0f), ss4(n_samples,n_K,16.0f,1.0f,8.0f);
+     cs.init_storage(half_cast<half>(0.0f));
+     fail |= cs.create_signal_user_data(sym.data(),n_samples,n_K) != 0;
+     fail |= cs4.create_signal_user_data_u4x(sym.data(),n_samples,n_K) != 0;
+     fail |= ss.create_signal_user_data(sym.data(),n_samples,n_K) != 0;
+     fail |= ss4.create_signal_user_data_u4x(sym.data(),n_samples,n_K) != 0;
+     const float T{static_cast<float>(n_samples)};
+     const float invT{8.0f/T};
+     std::size_t nbad{0ull};
+     for(std::size_t __t{0ull}; __t != n_samples; ++__t)
+     {
+          const float t{static_cast<float>(__t)};
+          float sc{0.0f}, sn{0.0f};
+          for(std::uint32_t __k{0}; __k != n_K; ++__k)
+          {
+               const float k{static_cast<float>(__k)};
+               const float arg{t-k*T};
+               sc += cs.cos_sample(arg,invT)*sym[__t*n_K+__k];
+               sn += ss.sin_sample(arg,invT)*sym[__t*n_K+__k];
+          }
+          nbad += hbits(cs.m_sig_samples.m_data[__t])  != hbits(half_cast<half>(sc));
+          nbad += hbits(cs4.m_sig_samples.m_data[__t]) != hbits(cs.m_sig_samples.m_data[__t]);
+          nbad += hbits(ss.m_sig_samples.m_data[__t])  != hbits(half_cast<half>(sn));
+          nbad += hbits(ss4.m_sig_samples.m_data[__t]) != hbits(ss.m_sig_samples.m_data[__t]);
+     }
+     printf("[UNIT-TEST]: %llu mismatching samples\n",static_cast<unsigned long long>(nbad));
+     fail |= nbad != 0ull;
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_fp16_bulk_cvt();
+    unit_test_fp16_bulk_compute();
+    unit_test_fp16_bulk_darray();
+    unit_test_fp16_bulk_signals();
+    return 0;
+}
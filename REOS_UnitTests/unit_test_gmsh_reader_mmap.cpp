@@ -0,0 +1,219 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include "GMS_gmsh_reader.h"
+
+/*
+   icpc -o unit_test_gmsh_reader_mmap -fp-model precise -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_gmsh_reader.h GMS_gmsh_reader.c GMS_gmsh_reader_mmap.cpp unit_test_gmsh_reader_mmap.cpp
+*/
+
+static void write_text(const char * fname,const char * text)
+{
+     FILE * fp{std::fopen(fname,"wb")};
+     std::fputs(text,fp);
+     std::fclose(fp);
+}
+
+/*
+   Unit square of 2 triangles (1,2,3),(1,3,4) surrounded by points and lines.
+*/
+static bool check_square(const GMSH_Mesh & m,const char * what)
+{
+     static const double x[4] = {0.0,1.0,1.0,0.0};
+     static const double y[4] = {0.0,0.0,1.0,1.0};
+     static const int32_t e[6] = {1,2,3,1,3,4};
+     bool ok{m.node_num == 4 && m.node_dim == 2 && m.element_num == 2 &&
+             m.element_order == 3 && m.element_type == 2};
+     for(int32_t __i{0}; ok && __i != 4; ++__i)
+         ok = (m.node_xs[__i] == x[__i] && m.node_ys[__i] == y[__i] && m.node_zs[__i] == 0.0);
+     for(int32_t __i{0}; ok && __i != 6; ++__i)
+         ok = (m.element_node[__i] == e[__i]);
+     if(!ok) printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, %s" ANSI_RESET_ALL "\n",what);
+     return ok;
+}
+
+void unit_test_gmsh_mmap_read_small();
+
+void unit_test_gmsh_mmap_read_small()
+{
+     bool fail{false};
+     GMSH_Mesh m;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // MSH 2.2, mixed types, 2 and 3 tags
+     write_text("ut_gmsh_22.msh",
+                "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+                "$Nodes\n4\n1 0 0 0\n2 1 0 0\n3 1.0 1e0 0\n4 0 1 -0.0e-3\n$EndNodes\n"
+                "$Elements\n5\n1 15 2 0 1 1\n2 1 2 0 1 1 2\n3 2 2 0 1 1 2 3\n4 2 3 0 1 7 1 3 4\n5 1 2 0 2 2 3\n$EndElements\n");
+     gmsh_mmap_read("ut_gmsh_22.msh",&m,0);
+     fail |= !check_square(m,"MSH 2.2 ASCII") || m.file_version != 22;
+     gmsh_mesh_free(&m);
+     // explicit element type: the lines
+     gmsh_mmap_read("ut_gmsh_22.msh",&m,1);
+     fail |= !(m.element_num == 2 && m.element_order == 2 && m.element_node[2] == 2 && m.element_node[3] == 3);
+     gmsh_mesh_free(&m);
+     // MSH 4.1 ASCII, CRLF, sparse node tags, parametric block
+     write_text("ut_gmsh_41.msh",
+                "$MeshFormat\r\n4.1 0 8\r\n$EndMeshFormat\r\n"
+                "$Entities\r\n0 0 1 0\r\n1 0 0 0 1 1 0 0\r\n$EndEntities\r\n"
+                "$Nodes\r\n2 4 10 40\r\n0 1 0 1\r\n10\r\n0 0 0\r\n2 1 1 3\r\n20\r\n30\r\n40\r\n"
+                "1 0 0 0.5 0\r\n1 1 0 0.5 0.5\r\n0 1 0 0 1\r\n$EndNodes\r\n"
+                "$Elements\r\n2 3 1 3\r\n1 1 1 1\r\n1 10 20\r\n2 1 2 2\r\n2 10 20 30\r\n3 10 30 40\r\n$EndElements\r\n");
+     gmsh_mmap_read("ut_gmsh_41.msh",&m,0);
+     fail |= !check_square(m,"MSH 4.1 ASCII") || m.file_version != 41;
+     gmsh_mesh_free(&m);
+     // MSH 4.1 binary, same mesh
+     {
+          std::vector<char> buf;
+          auto put = [&buf](const void * p,std::size_t n) {buf.insert(buf.end(),(const char*)p,(const char*)p+n);};
+          auto puts_ = [&put](const char * s) {put(s,std::strlen(s));};
+          auto putz = [&put](std::size_t v) {put(&v,sizeof(v));};
+          auto puti = [&put](int32_t v) {put(&v,sizeof(v));};
+          auto putd = [&put](double v) {put(&v,sizeof(v));};
+          const int32_t one{1};
+          puts_("$MeshFormat\n4.1 1 8\n"); put(&one,4); puts_("\n$EndMeshFormat\n$Nodes\n");
+          putz(2); putz(4); putz(10); putz(40);
+          puti(0); puti(1); puti(0); putz(1); putz(10); putd(0.0); putd(0.0); putd(0.0);
+          puti(2); puti(1); puti(1); putz(3); putz(20); putz(30); putz(40);
+          putd(1.0); putd(0.0); putd(0.0); putd(0.5); putd(0.0);
+          putd(1.0); putd(1.0); putd(0.0); putd(0.5); putd(0.5);
+          putd(0.0); putd(1.0); putd(0.0); putd(0.0); putd(1.0);
+          puts_("\n$EndNodes\n$Elements\n");
+          putz(2); putz(3); putz(1); putz(3);
+          puti(1); puti(1); puti(1); putz(1); putz(1); putz(10); putz(20);
+          puti(2); puti(1); puti(2); putz(2); putz(2); putz(10); putz(20); putz(30); putz(3); putz(10); putz(30); putz(40);
+          puts_("\n$EndElements\n");
+          FILE * fp{std::fopen("ut_gmsh_41b.msh","wb")};
+          std::fwrite(buf.data(),1,buf.size(),fp);
+          std::fclose(fp);
+     }
+     gmsh_mmap_read("ut_gmsh_41b.msh",&m,0);
+     fail |= !check_square(m,"MSH 4.1 binary");
+     gmsh_mesh_free(&m);
+     std::remove("ut_gmsh_22.msh");
+     std::remove("ut_gmsh_41.msh");
+     std::remove("ut_gmsh_41b.msh");
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: gmsh_mmap_read (small) -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_gmsh_mmap_read_vs_legacy();
+
+void unit_test_gmsh_mmap_read_vs_legacy()
+{
+     // nx*ny grid of triangles, large enough for several parallel chunks
+     constexpr int32_t nx{600};
+     constexpr int32_t ny{400};
+     char fname22[] = "ut_gmsh_grid22.msh";
+     const char * fname41{"ut_gmsh_grid41.msh"};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     srand(17);
+     std::vector<double> xyz(3ull*nx*ny);
+     for(double & v : xyz) {v = (static_cast<double>(rand())/RAND_MAX-0.5)*std::pow(10.0,rand()%9-4);}
+     const int32_t nnode{nx*ny};
+     const int32_t ntri{2*(nx-1)*(ny-1)};
+     auto tri = [](int32_t t,int32_t * v) {
+          const int32_t q{t/2};
+          const int32_t i{q%(nx-1)}, j{q/(nx-1)};
+          const int32_t a{j*nx+i+1};
+          if(t%2 == 0) {v[0] = a; v[1] = a+1;  v[2] = a+nx+1;}
+          else         {v[0] = a; v[1] = a+nx+1; v[2] = a+nx;}
+     };
+     FILE * fp{std::fopen(fname22,"w")};
+     fprintf(fp,"$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n%d\n",nnode);
+     for(int32_t __i{0}; __i != nnode; ++__i)
+         fprintf(fp,"%d %.16g %.16g %.17g\n",__i+1,xyz[3*__i],xyz[3*__i+1],xyz[3*__i+2]);
+     fprintf(fp,"$EndNodes\n$Elements\n%d\n",ntri);
+     for(int32_t __t{0}; __t != ntri; ++__t)
+     {
+         int32_t v[3]; tri(__t,v);
+         fprintf(fp,"%d 2 2 0 1 %d %d %d\n",__t+1,v[0],v[1],v[2]);
+     }
+     fprintf(fp,"$EndElements\n");
+     std::fclose(fp);
+     // same mesh in MSH 4.1, nodes split into two blocks, reversed tag order
+     fp = std::fopen(fname41,"w");
+     fprintf(fp,"$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$Nodes\n2 %d 1 %d\n",nnode,nnode);
+     const int32_t h{nnode/2};
+     fprintf(fp,"2 1 0 %d\n",h);
+     for(int32_t __i{0}; __i != h; ++__i) fprintf(fp,"%d\n",nnode-__i);
+     for(int32_t __i{0}; __i != h; ++__i)
+         fprintf(fp,"%.16g %.16g %.17g\n",xyz[3*(nnode-1-__i)],xyz[3*(nnode-1-__i)+1],xyz[3*(nnode-1-__i)+2]);
+     fprintf(fp,"3 1 0 %d\n",nnode-h);
+     for(int32_t __i{h}; __i != nnode; ++__i) fprintf(fp,"%d\n",nnode-__i);
+     for(int32_t __i{h}; __i != nnode; ++__i)
+         fprintf(fp,"%.16g %.16g %.17g\n",xyz[3*(nnode-1-__i)],xyz[3*(nnode-1-__i)+1],xyz[3*(nnode-1-__i)+2]);
+     fprintf(fp,"$EndNodes\n$Elements\n1 %d 1 %d\n2 1 2 %d\n",ntri,ntri,ntri);
+     for(int32_t __t{0}; __t != ntri; ++__t)
+     {
+         int32_t v[3]; tri(__t,v);
+         fprintf(fp,"%d %d %d %d\n",__t+1,v[0],v[1],v[2]);
+     }
+     fprintf(fp,"$EndElements\n");
+     std::fclose(fp);
+     // legacy reader
+     int nn, nd, ne, eo;
+     gmsh_size_read(fname22,&nn,&nd,&ne,&eo);
+     std::vector<double> node_x(static_cast<std::size_t>(nd)*nn);
+     std::vector<int> elem(static_cast<std::size_t>(eo)*ne);
+     gmsh_data_read(fname22,nd,nn,node_x.data(),eo,ne,elem.data());
+     GMSH_Mesh m22, m41;
+     gmsh_mmap_read(fname22,&m22,0);
+     gmsh_mmap_read(fname41,&m41,0);
+     if(m22.node_num != nn || m22.node_dim != nd || m22.element_num != ne || m22.element_order != eo)
+     {
+         printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, MSH 2.2 sizes differ from gmsh_size_read" ANSI_RESET_ALL "\n");
+         fail = true;
+     }
+     for(int32_t __i{0}; !fail && __i != nn; ++__i)
+     {
+         // exact: strtod of the written text (16/17 significant digits),
+         // legacy s_to_r8 is not correctly rounded, compared to 2 ulp
+         char txt[3][32];
+         std::snprintf(txt[0],32,"%.16g",xyz[3*__i]);
+         std::snprintf(txt[1],32,"%.16g",xyz[3*__i+1]);
+         std::snprintf(txt[2],32,"%.17g",xyz[3*__i+2]);
+         const double r[3] = {std::strtod(txt[0],nullptr),std::strtod(txt[1],nullptr),std::strtod(txt[2],nullptr)};
+         const double * l{&node_x[3ull*__i]};
+         const int32_t p{nnode-1-__i}; // position of node __i+1 in the 4.1 file
+         bool ok{m22.node_xs[__i] == r[0] && m22.node_ys[__i] == r[1] && m22.node_zs[__i] == r[2] &&
+                 m41.node_xs[p] == r[0] && m41.node_ys[p] == r[1] && m41.node_zs[p] == r[2]};
+         for(int32_t __k{0}; __k != 3; ++__k) ok &= std::fabs(l[__k]-r[__k]) <= 4.5e-16*std::fabs(r[__k]);
+         if(!ok)
+         {
+              printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, node %d: (%.17g,%.17g,%.17g), (%.17g,%.17g,%.17g), expected (%.17g,%.17g,%.17g)" ANSI_RESET_ALL "\n",
+                     __i+1,m22.node_xs[__i],m22.node_ys[__i],m22.node_zs[__i],m41.node_xs[p],m41.node_ys[p],m41.node_zs[p],r[0],r[1],r[2]);
+              fail = true;
+         }
+     }
+     for(std::size_t __i{0ull}; !fail && __i != elem.size(); ++__i)
+     {
+         // 4.1 nodes are stored in reversed tag order
+         if(m22.element_node[__i] != elem[__i] || m41.element_node[__i] != nnode+1-elem[__i])
+         {
+              printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, element node %llu: %d, %d, legacy %d" ANSI_RESET_ALL "\n",
+                     __i,m22.element_node[__i],m41.element_node[__i],elem[__i]);
+              fail = true;
+         }
+     }
+     gmsh_mesh_free(&m22);
+     gmsh_mesh_free(&m41);
+     std::remove(fname22);
+     std::remove(fname41);
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: gmsh_mmap_read vs gmsh_data_read -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main()
+{
+
+    unit_test_gmsh_mmap_read_small();
+    unit_test_gmsh_mmap_read_vs_legacy();
+    return 0;
+}
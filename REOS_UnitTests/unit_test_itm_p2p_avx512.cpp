@@ -0,0 +1,330 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_itm_p2p_avx512.h"
+#include "GMS_idealized_topo.h"
+
+/*
+   icpc -o unit_test_itm_p2p_avx512 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_idealized_topo.h GMS_idealized_topo.cpp GMS_itm_p2p_avx512.h GMS_itm_p2p_avx512.cpp unit_test_itm_p2p_avx512.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_itm_p2p_avx512.h GMS_itm_p2p_avx512.cpp unit_test_itm_p2p_avx512.cpp
+
+   The terrain is the Gaussian mountain of GMS_idealized_topo (plus a small ripple), written to a raw
+   float32 file and memory-mapped. The 16-lane single precision paths are checked against the scalar
+   double precision reference on the same profiles (loss difference statistics, mode of propagation),
+   the area mode against its scalar reference and for the LOS -> diffraction -> troposcatter sequence.
+*/
+
+namespace {
+
+     constexpr int32_t test_n{1024};      // grid nodes per side
+     constexpr double  test_step{100.0};  // grid spacing (m)
+
+     gms::math::ITM_Params test_params()
+     {
+          gms::math::ITM_Params p;
+          p.f_mhz        = 900.0;
+          p.N_0          = 301.0;
+          p.epsilon      = 15.0;
+          p.sigma        = 0.005;
+          p.polarization = POLARIZATION__VERTICAL;
+          p.climate      = CLIMATE__CONTINENTAL_TEMPERATE;
+          p.mdvar        = MDVAR__ACCIDENTAL;
+          p.time         = 50.0;
+          p.location     = 50.0;
+          p.situation    = 50.0;
+          return (p);
+     }
+
+     // Writes the test terrain to fname, returns false on failure.
+     bool test_write_terrain(const char * fname)
+     {
+          using namespace gms::math;
+          constexpr float deg{0.0174532925199432957692f};
+          float * lon{reinterpret_cast<float*>(_mm_malloc(test_n*sizeof(float),64))};
+          float * lat{reinterpret_cast<float*>(_mm_malloc(test_n*sizeof(float),64))};
+          float * z{reinterpret_cast<float*>(_mm_malloc(static_cast<std::size_t>(test_n)*test_n*sizeof(float),64))};
+          // x <-> latitude 0..90 deg, y <-> longitude 45..135 deg (the bump at the center)
+          for(int32_t __i{0}; __i != test_n; ++__i)
+          {
+              lat[__i] = deg*(90.0f*__i/(test_n-1));
+              lon[__i] = deg*(45.0f+90.0f*__i/(test_n-1));
+          }
+          gms::gaussian_topography_r4(lon,test_n,lat,test_n,z,1200.0f);
+          for(int32_t __i{0}; __i != test_n; ++__i)
+              for(int32_t __j{0}; __j != test_n; ++__j)
+                  z[__i*test_n+__j] += 40.0f*std::sin(0.037f*__j)*std::cos(0.051f*__i)+
+                                       15.0f*std::sin(0.31f*__j+0.17f*__i);
+          FILE * fp{std::fopen(fname,"wb")};
+          bool ok{fp != nullptr};
+          if(ok)
+          {
+             ok = std::fwrite(z,sizeof(float),static_cast<std::size_t>(test_n)*test_n,fp) ==
+                  static_cast<std::size_t>(test_n)*test_n;
+             std::fclose(fp);
+          }
+          _mm_free(z);
+          _mm_free(lat);
+          _mm_free(lon);
+          return (ok);
+     }
+
+}
+
+void unit_test_itm_p2p_zmm16r4(const gms::math::ITM_ElevGrid &);
+
+void unit_test_itm_p2p_zmm16r4(const gms::math::ITM_ElevGrid & g)
+{
+     using namespace gms::math;
+     constexpr int32_t nbatch{2000};
+     const ITM_Params p{test_params()};
+     std::mt19937_64 rng(2026ULL);
+     const double ext{test_step*(test_n-1)};
+     std::uniform_real_distribution<double> ux(0.0,ext);
+     std::uniform_real_distribution<double> uh(2.0,60.0);
+     std::uniform_int_distribution<int32_t> unp(20,1400);
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     std::vector<double> pfl(1600);
+     float * pfl16{reinterpret_cast<float*>(_mm_malloc(16*1600*sizeof(float),64))};
+     std::vector<double> err;
+     int32_t nmode{0}, nkwx{0}, nmodes[4] = {0,0,0,0};
+     for(int32_t __b{0}; __b != nbatch; ++__b)
+     {
+         const int32_t np{unp(rng)};
+         alignas(64) float xi[16], htx[16], hrx[16];
+         double ref[16];
+         int32_t mref[16], kref[16];
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             double xa,ya,xb,yb;
+             do
+             {
+                xa = ux(rng); ya = ux(rng); xb = ux(rng); yb = ux(rng);
+             } while(std::hypot(xb-xa,yb-ya) < 2.0e+3);
+             htx[__k] = static_cast<float>(uh(rng));
+             hrx[__k] = static_cast<float>(uh(rng));
+             itm_profile_extract(g,xa,ya,xb,yb,np,pfl.data());
+             xi[__k] = static_cast<float>(pfl[1]);
+             pfl[1]  = static_cast<double>(xi[__k]);
+             for(int32_t __i{0}; __i <= np; ++__i) pfl16[16*__i+__k] = static_cast<float>(pfl[__i+2]);
+             kref[__k] = itm_p2p_tls(htx[__k],hrx[__k],pfl.data(),p,&ref[__k],&mref[__k]);
+         }
+         __m512i vm,vk;
+         const __m512 A{itm_p2p_zmm16r4(_mm512_load_ps(htx),_mm512_load_ps(hrx),np,_mm512_load_ps(xi),pfl16,p,vm,vk)};
+         alignas(64) float a[16];
+         alignas(64) int32_t m[16], k[16];
+         _mm512_store_ps(a,A);
+         _mm512_store_si512(m,vm);
+         _mm512_store_si512(k,vk);
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             ++nmodes[mref[__k]];
+             if(m[__k] != mref[__k]) { ++nmode; continue; }
+             if(k[__k] != kref[__k]) ++nkwx;
+             err.push_back(std::fabs(a[__k]-ref[__k]));
+         }
+     }
+     _mm_free(pfl16);
+     std::sort(err.begin(),err.end());
+     const std::size_t ne{err.size()};
+     const double e50{err[ne/2]}, e99{err[(99*ne)/100]}, e999{err[(999*ne)/1000]}, emax{err[ne-1]};
+     printf("links=%d LOS=%d DIFF=%d TROPO=%d, mode mismatch=%d, kwx mismatch=%d\n",
+            16*nbatch,nmodes[1],nmodes[2],nmodes[3],nmode,nkwx);
+     printf("|A_zmm16r4-A_tls| [dB]: median=%.2e p99=%.2e p99.9=%.2e max=%.2e\n",e50,e99,e999,emax);
+     if(nmodes[1] == 0 || nmodes[2] == 0 || nmode > 16*nbatch/500 || e99 > 0.05 || e999 > 0.5)
+     {
+        printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n", __PRETTY_FUNCTION__);
+        std::exit(EXIT_FAILURE);
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_itm_area_zmm16r4();
+
+void unit_test_itm_area_zmm16r4()
+{
+     using namespace gms::math;
+     constexpr int32_t n{1024};
+     ITM_Params p{test_params()};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     const int32_t sit[3] = {SITING_CRITERIA__RANDOM,SITING_CRITERIA__CAREFUL,SITING_CRITERIA__VERY_CAREFUL};
+     const double dhs[3] = {0.0,90.0,400.0};
+     const double fs[3] = {100.0,900.0,5000.0};
+     std::vector<float> d(n), A(n);
+     std::vector<int8_t> m(n), k(n);
+     double emax{0.0};
+     // 1 .. 2000 km, logarithmic
+     for(int32_t __i{0}; __i != n; ++__i) d[__i] = static_cast<float>(std::pow(10.0,3.3*__i/(n-1)));
+     for(const double f : fs)
+     {
+         p.f_mhz = f;
+         for(int32_t __s{0}; __s != 3; ++__s)
+         {
+             for(const double dh : dhs)
+             {
+                 itm_area_batch_omp(10.0,3.0,sit[__s],sit[2-__s],dh,p,d.data(),n,A.data(),m.data(),k.data());
+                 int32_t prev{MODE__LINE_OF_SIGHT};
+                 for(int32_t __i{0}; __i != n; ++__i)
+                 {
+                     double ref;
+                     int32_t mref;
+                     const int32_t kref{itm_area_tls(10.0,3.0,sit[__s],sit[2-__s],d[__i],dh,p,&ref,&mref)};
+                     if(m[__i] < prev)
+                     {
+                        printf("f=%.0f dh=%.0f d=%.1f km -- mode %d after %d\n",f,dh,d[__i],m[__i],prev);
+                        fail = true;
+                     }
+                     prev = m[__i];
+                     if(m[__i] != mref) continue; // at the region boundaries only
+                     if(k[__i] != kref)
+                     {
+                        printf("f=%.0f dh=%.0f d=%.1f km -- kwx %d, ref %d\n",f,dh,d[__i],k[__i],kref);
+                        fail = true;
+                     }
+                     emax = std::max(emax,std::fabs(A[__i]-ref));
+                 }
+                 if(prev != MODE__TROPOSCATTER)
+                 {
+                    printf("f=%.0f dh=%.0f -- no troposcatter at 2000 km\n",f,dh);
+                    fail = true;
+                 }
+             }
+         }
+     }
+     printf("max |A_zmm16r4-A_tls| = %.3e dB\n",emax);
+     if(fail || emax > 0.1)
+     {
+        printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n", __PRETTY_FUNCTION__);
+        std::exit(EXIT_FAILURE);
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_itm_p2p_coverage_omp(const gms::math::ITM_ElevGrid &);
+
+void unit_test_itm_p2p_coverage_omp(const gms::math::ITM_ElevGrid & g)
+{
+     using namespace gms::math;
+     constexpr int32_t nr{128};
+     const ITM_Params p{test_params()};
+     const double ext{test_step*(test_n-1)};
+     const double tx{0.31*ext}, ty{0.27*ext};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // receivers on a ring-ordered raster, the transmitter itself included
+     std::vector<double> rx, ry;
+     for(int32_t __i{0}; __i != nr; ++__i)
+         for(int32_t __j{0}; __j != nr; ++__j)
+         {
+             rx.push_back(ext*(__j+0.5)/nr);
+             ry.push_back(ext*(__i+0.5)/nr);
+         }
+     rx.push_back(tx);
+     ry.push_back(ty);
+     const int32_t n{static_cast<int32_t>(rx.size())};
+     std::vector<float> A(n);
+     std::vector<int8_t> m(n), k(n);
+     bool fail{itm_p2p_coverage_omp(g,p,tx,ty,15.0,2.0,rx.data(),ry.data(),n,test_step,A.data(),m.data(),k.data()) != 0};
+     std::vector<double> pfl(2000);
+     int32_t nmode{0}, nbad{0};
+     double emax{0.0};
+     for(int32_t __b{0}; __b < n; __b += 16)
+     {
+         // the batch profile length, as in itm_p2p_coverage_omp
+         double dm{0.0};
+         for(int32_t __k{__b}; __k != std::min(n,__b+16); ++__k) dm = std::max(dm,std::hypot(rx[__k]-tx,ry[__k]-ty));
+         const int32_t np{std::max(2,static_cast<int32_t>(std::ceil(dm/test_step)))};
+         for(int32_t __k{__b}; __k != std::min(n,__b+16); ++__k)
+         {
+             if(std::hypot(rx[__k]-tx,ry[__k]-ty) < 1.0)
+             {
+                if(!std::isnan(A[__k]) || m[__k] != MODE__NOT_SET) fail = true;
+                continue;
+             }
+             itm_profile_extract(g,tx,ty,rx[__k],ry[__k],np,pfl.data());
+             double ref;
+             int32_t mref;
+             itm_p2p_tls(15.0,2.0,pfl.data(),p,&ref,&mref);
+             if(mref != m[__k]) { ++nmode; continue; }
+             const double e{std::fabs(A[__k]-ref)};
+             emax = std::max(emax,e);
+             if(e > 0.5) ++nbad;
+         }
+     }
+     printf("receivers=%d threads=%d, mode mismatch=%d, |dA|>0.5 dB: %d, max |dA|=%.3e dB\n",
+            n,omp_get_max_threads(),nmode,nbad,emax);
+     if(fail || nmode > n/500 || nbad > n/1000)
+     {
+        printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n", __PRETTY_FUNCTION__);
+        std::exit(EXIT_FAILURE);
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_itm_elev_grid_mmap();
+
+void unit_test_itm_elev_grid_mmap()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     ITM_ElevGrid g;
+     bool fail{itm_elev_grid_mmap("/nonexistent/itm_terrain.flt",16,16,0.0,0.0,1.0,1.0,g) != 1};
+     FILE * fp{std::fopen("/tmp/unit_test_itm_small.flt","wb")};
+     const float z[8] = {0.0f,1.0f,2.0f,3.0f,4.0f,5.0f,6.0f,7.0f};
+     if(fp != nullptr)
+     {
+        std::fwrite(z,sizeof(float),8,fp);
+        std::fclose(fp);
+     }
+     fail = fail || itm_elev_grid_mmap("/tmp/unit_test_itm_small.flt",4,4,0.0,0.0,1.0,1.0,g) != 2;
+     fail = fail || itm_elev_grid_mmap("/tmp/unit_test_itm_small.flt",4,2,0.0,0.0,1.0,1.0,g) != 0;
+     if(!fail)
+     {
+        // bilinear profile along the diagonal (0,0) -> (3,1), clamped beyond
+        double pfl[8];
+        itm_profile_extract(g,0.0,0.0,3.0,1.0,2,pfl);
+        fail = std::fabs(pfl[3]-3.5) > 1.0e-6 || std::fabs(pfl[4]-7.0) > 1.0e-6;
+        itm_elev_grid_unmap(g);
+        fail = fail || g.z != nullptr;
+     }
+     std::remove("/tmp/unit_test_itm_small.flt");
+     if(fail)
+     {
+        printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n", __PRETTY_FUNCTION__);
+        std::exit(EXIT_FAILURE);
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    using namespace gms::math;
+    const char * fname{"/tmp/unit_test_itm_terrain.flt"};
+    if(!test_write_terrain(fname))
+    {
+       printf("cannot write %s\n",fname);
+       return (EXIT_FAILURE);
+    }
+    ITM_ElevGrid g;
+    if(itm_elev_grid_mmap(fname,test_n,test_n,0.0,0.0,test_step,test_step,g) != 0)
+    {
+       printf("cannot map %s\n",fname);
+       return (EXIT_FAILURE);
+    }
+    unit_test_itm_elev_grid_mmap();
+    unit_test_itm_p2p_zmm16r4(g);
+    unit_test_itm_area_zmm16r4();
+    unit_test_itm_p2p_coverage_omp(g);
+    itm_elev_grid_unmap(g);
+    std::remove(fname);
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_large_alloc.h"
+
+/*
+   icpc -o unit_test_large_alloc -fp-model fast=2 -std=c++17 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+   GMS_config.h GMS_large_alloc.h GMS_large_alloc.cpp unit_test_large_alloc.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 -qopenmp GMS_config.h GMS_large_alloc.h GMS_large_alloc.cpp
+
+   Every step of the page chain returns zeroed, writable, 2MiB-aligned memory (a step
+   which is not available falls through to the next one), the NUMA placement is applied,
+   the first-touch faults in every page (serial and OpenMP, any unroll factor and length),
+   the options are parsed from the environment.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // pages of [p,p+n) resident in memory
+     std::size_t resident_pages(const void * p,const std::size_t n)
+     {
+          const std::size_t np{(n+4095ull)/4096ull};
+          std::vector<unsigned char> v(np);
+          if(mincore(const_cast<void*>(p),n,v.data()) != 0) return (0ull);
+          std::size_t r{0ull};
+          for(unsigned char b : v) r += (b & 1u);
+          return (r);
+     }
+
+}
+
+void unit_test_large_alloc_pages();
+
+void unit_test_large_alloc_pages()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     printf("NUMA nodes online: %d\n",numa_nodes_online());
+     const std::size_t sizes[] = {1ull,4095ull,3ull*1048576ull+17ull,16ull*1048576ull};
+     for(int32_t __k{0}; __k <= static_cast<int32_t>(page_kind::PAGES_4KiB); ++__k)
+     {
+          for(std::size_t n : sizes)
+          {
+               large_alloc_opts_t o{};
+               o.page  = static_cast<page_kind>(__k);
+               o.touch = touch_kind::NONE;
+               large_alloc_info_t info{};
+               unsigned char * p{reinterpret_cast<unsigned char*>(gms_large_malloc(n,o,&info))};
+               if((reinterpret_cast<std::uintptr_t>(p) & 2097151ull) != 0ull) test_fail(__PRETTY_FUNCTION__);
+               if(info.bytes_mapped < n || info.bytes_req != n) test_fail(__PRETTY_FUNCTION__);
+               // the chain never goes backwards
+               if(o.page != page_kind::AUTO && static_cast<int32_t>(info.page) < __k) test_fail(__PRETTY_FUNCTION__);
+               for(std::size_t __i{0ull}; __i != n; ++__i) if(p[__i] != 0u) test_fail(__PRETTY_FUNCTION__);
+               std::memset(p,0x5A,n);
+               if(n == sizes[3])
+                  printf("requested %-12s: got %-12s, mapped %zu bytes, hugepage-backed %zu bytes\n",
+                         page_kind_name(o.page),page_kind_name(info.page),info.bytes_mapped,
+                         hugepage_backed_bytes(p,info.bytes_mapped));
+               gms_large_free(p);
+          }
+     }
+     // the typed front-end takes the element size of the consuming loop
+     double * d{large_alloc<double>(1000ull)};
+     d[999] = 1.0;
+     gms_large_free(d);
+     gms_large_free(nullptr);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_large_alloc_numa();
+
+void unit_test_large_alloc_numa()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(int32_t __m{0}; __m != 3; ++__m)
+     {
+          large_alloc_opts_t o{};
+          o.numa = static_cast<numa_place>(__m);
+          large_alloc_info_t info{};
+          float * p{reinterpret_cast<float*>(gms_large_malloc(8ull*1048576ull,o,&info))};
+          printf("%-10s: mbind %s, %d node(s)\n",numa_place_name(info.numa),info.mbind_ok ? "applied" : "failed",info.n_nodes);
+          // mbind is refused only when the kernel is built without NUMA
+          if(!info.mbind_ok && info.n_nodes > 1) test_fail(__PRETTY_FUNCTION__);
+          for(std::size_t __i{0ull}; __i != 2097152ull; ++__i) p[__i] = static_cast<float>(__i);
+          gms_large_free(p);
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_large_alloc_first_touch();
+
+void unit_test_large_alloc_first_touch()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t sizes[] = {4096ull,64ull*1000ull+8ull,5ull*1048576ull+4096ull*3ull+40ull};
+     for(std::size_t n : sizes)
+     {
+          for(int32_t u : {1,6,10})
+          {
+               for(std::size_t e : {8ull,64ull,128ull,10000ull})
+               {
+                    for(touch_kind t : {touch_kind::SERIAL,touch_kind::OMP_PARALLEL})
+                    {
+                         large_alloc_opts_t o{};
+                         o.page       = page_kind::PAGES_4KiB;
+                         o.touch      = touch_kind::NONE;
+                         o.elem_bytes = e;
+                         o.unroll     = u;
+                         void * p{gms_large_malloc(n,o)};
+                         if(resident_pages(p,n) != 0ull) test_fail(__PRETTY_FUNCTION__);
+                         o.touch = t;
+                         gms_first_touch(p,n,o);
+                         if(resident_pages(p,n) != (n+4095ull)/4096ull) test_fail(__PRETTY_FUNCTION__);
+                         gms_large_free(p);
+                    }
+               }
+          }
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_large_alloc_env();
+
+void unit_test_large_alloc_env()
+{
+     using namespace gms::common;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     large_alloc_opts_t o{large_alloc_opts_from_env()};
+     setenv("GMS_PAGES","thp",1);
+     setenv("GMS_NUMA","interleave",1);
+     setenv("GMS_FIRST_TOUCH","serial",1);
+     o = large_alloc_opts_from_env();
+     if(o.page != page_kind::THP || o.numa != numa_place::INTERLEAVE || o.touch != touch_kind::SERIAL) test_fail(__PRETTY_FUNCTION__);
+     setenv("GMS_PAGES","1g",1);
+     setenv("GMS_NUMA","local",1);
+     setenv("GMS_FIRST_TOUCH","none",1);
+     o = large_alloc_opts_from_env();
+     if(o.page != page_kind::HUGETLB_1GiB || o.numa != numa_place::LOCAL || o.touch != touch_kind::NONE) test_fail(__PRETTY_FUNCTION__);
+     unsetenv("GMS_PAGES");
+     unsetenv("GMS_NUMA");
+     unsetenv("GMS_FIRST_TOUCH");
+     o = large_alloc_opts_from_env();
+     if(o.page != page_kind::AUTO || o.numa != numa_place::NONE || o.touch != touch_kind::OMP_PARALLEL) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_large_alloc_pages();
+    unit_test_large_alloc_numa();
+    unit_test_large_alloc_first_touch();
+    unit_test_large_alloc_env();
+    return 0;
+}
@@ -0,0 +1,341 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_lsoda_ensemble_zmm8r8.h"
+
+/*
+   icpc -o unit_test_lsoda_ensemble_zmm8r8 -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_lsoda_ensemble_zmm8r8.h GMS_lsoda_ensemble_zmm8r8.cpp unit_test_lsoda_ensemble_zmm8r8.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_lsoda_ensemble_zmm8r8.h GMS_lsoda_ensemble_zmm8r8.cpp unit_test_lsoda_ensemble_zmm8r8.cpp
+
+   Robertson chemical kinetics (ODE_2/JAC_2 of GMS_cudlsoda_ode.cuh, the DLSODA demo problem)
+   against the reference solution at t = 40, output times 0.4*10^k up to 4.0e10 through the
+   continuation call, one system per lane against the same system alone, the difference
+   quotient Jacobian against the user one, the Adams/BDF switch (Van der Pol, mu = 1000) and
+   no switch on a non-stiff oscillator, the batched LU against the residual.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // y1' = -k1*y1 + 1.0e4*y2*y3, y3' = 3.0e7*y2^2, y2' = -y1' - y3', k1 per system
+     struct Robertson {
+          const double * k1;
+          void operator()(const int32_t,const __m512d,const __m512d * __restrict y,
+                          __m512d * __restrict yd,const __m256i sys) const
+          {
+               const __m512d a  = _mm512_i32gather_pd(sys,k1,8);
+               const __m512d y1 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[1]);
+               yd[0] = _mm512_fmadd_pd(y1,y[2],_mm512_mul_pd(_mm512_sub_pd(_mm512_setzero_pd(),a),y[0]));
+               yd[2] = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(3.0e7),y[1]),y[1]);
+               yd[1] = _mm512_sub_pd(_mm512_sub_pd(_mm512_setzero_pd(),yd[0]),yd[2]);
+          }
+     };
+
+     struct RobertsonJac {
+          const double * k1;
+          void operator()(const int32_t neq,const __m512d,const __m512d * __restrict y,
+                          __m512d * __restrict pd,const __m256i sys) const
+          {
+               const __m512d a   = _mm512_i32gather_pd(sys,k1,8);
+               const __m512d c13 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[2]);
+               const __m512d c12 = _mm512_mul_pd(_mm512_set1_pd(1.0e4),y[1]);
+               const __m512d c32 = _mm512_mul_pd(_mm512_set1_pd(6.0e7),y[1]);
+               pd[0*neq+0] = _mm512_sub_pd(_mm512_setzero_pd(),a);
+               pd[1*neq+0] = c13;
+               pd[2*neq+0] = c12;
+               pd[0*neq+1] = a;
+               pd[1*neq+1] = _mm512_sub_pd(_mm512_sub_pd(_mm512_setzero_pd(),c13),c32);
+               pd[2*neq+1] = _mm512_sub_pd(_mm512_setzero_pd(),c12);
+               pd[1*neq+2] = c32;
+          }
+     };
+
+     // Van der Pol, y1' = y2, y2' = mu*(1 - y1^2)*y2 - y1
+     struct VanDerPol {
+          double mu;
+          void operator()(const int32_t,const __m512d,const __m512d * __restrict y,
+                          __m512d * __restrict yd,const __m256i) const
+          {
+               const __m512d q = _mm512_fnmadd_pd(y[0],y[0],_mm512_set1_pd(1.0));
+               yd[0] = y[1];
+               yd[1] = _mm512_fmsub_pd(_mm512_mul_pd(_mm512_set1_pd(mu),q),y[1],y[0]);
+          }
+     };
+
+     // y1' = y2, y2' = -y1
+     struct Oscillator {
+          void operator()(const int32_t,const __m512d,const __m512d * __restrict y,
+                          __m512d * __restrict yd,const __m256i) const
+          {
+               yd[0] = y[1];
+               yd[1] = _mm512_sub_pd(_mm512_setzero_pd(),y[0]);
+          }
+     };
+
+     gms::math::LsodaOpts robertson_opts(const double * rtol,const double * atol,const int32_t itol)
+     {
+          gms::math::LsodaOpts o{};
+          o.itol = itol;
+          o.jt   = 1;
+          o.rtol = rtol;
+          o.atol = atol;
+          return o;
+     }
+
+}
+
+void unit_test_lsoda_ensemble_robertson();
+
+void unit_test_lsoda_ensemble_robertson()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     const int32_t nsys{19};
+     const std::vector<double> k1(nsys,0.04);
+     const Robertson f{k1.data()};
+     const RobertsonJac jac{k1.data()};
+     // reference solution at t = 40 (test set for IVP solvers, Mazzia et al.)
+     const double yref[3] = {0.7158270687193772,9.185534764557551e-06,0.2841637457458586};
+     const double rt_tight[1] = {1.0e-10}, at_tight[3] = {1.0e-14,1.0e-18,1.0e-14};
+     const double rt_demo[1]  = {1.0e-4},  at_demo[3]  = {1.0e-6,1.0e-10,1.0e-6};
+     std::vector<double> y(3*nsys);
+     std::vector<int32_t> ist(nsys);
+     std::vector<LsodaStats> st(nsys);
+     for(int32_t pass{0}; pass != 2; ++pass)
+     {
+         for(int32_t __s{0}; __s != nsys; ++__s)
+         {
+             y[3*__s] = 1.0; y[3*__s+1] = 0.0; y[3*__s+2] = 0.0;
+         }
+         LsodaOpts o{(pass == 0) ? robertson_opts(rt_tight,at_tight,2) : robertson_opts(rt_demo,at_demo,2)};
+         o.mxstep = 100000;
+         lsoda_ensemble_zmm8r8_omp(f,jac,nsys,3,y.data(),0.0,40.0,o,ist.data(),st.data());
+         double err{0.0};
+         for(int32_t __s{0}; __s != nsys; ++__s)
+         {
+             fail |= ist[__s] != 2;
+             for(int32_t __i{0}; __i != 3; ++__i)
+             {
+                 fail |= y[3*__s+__i] != y[__i];
+                 err = std::max(err,std::fabs(y[3*__s+__i]-yref[__i])/std::fabs(yref[__i]));
+             }
+         }
+         printf("rtol %.1e: y(40) = %.15e %.15e %.15e, max rel err %.3e, nst %d nfe %d nje %d, tsw %.4e\n",
+                o.rtol[0],y[0],y[1],y[2],err,st[0].nst,st[0].nfe,st[0].nje,st[0].tsw);
+         fail |= err > ((pass == 0) ? 1.0e-7 : 5.0e-3);
+     }
+     // DLSODA demo, output at 0.4*10^k, continuation calls
+     LsodaBlock b;
+     LsodaOpts o{robertson_opts(rt_demo,at_demo,2)};
+     if(!lsoda_block_alloc(b,3,o)) test_fail(__PRETTY_FUNCTION__);
+     const double y0[3] = {1.0,0.0,0.0};
+     Robertson fl{f};
+     RobertsonJac jl{jac};
+     double tout{0.4};
+     for(int32_t __k{0}; __k != 8; ++__k) lsoda_lane_start(b,__k,0,0.0,tout,y0);
+     for(int32_t iout{0}; iout != 12; ++iout)
+     {
+         lsoda_block_run(b,fl,jl,0xFF);
+         double yo[3], t;
+         LsodaStats s;
+         const int32_t is{lsoda_lane_result(b,0,yo,&t,&s)};
+         printf("t = %.4e y = %.6e %.6e %.6e  nst %d nq %d meth %d\n",t,yo[0],yo[1],yo[2],s.nst,s.nqu,s.mused);
+         fail |= is != 2 || t != tout || std::fabs(yo[0]+yo[1]+yo[2]-1.0) > 1.0e-5 ||
+                 yo[0] < -1.0e-5 || yo[1] < -1.0e-9;
+         if(iout == 0)  fail |= std::fabs(yo[0]-9.851712e-01) > 1.0e-4 || std::fabs(yo[1]-3.386380e-05) > 1.0e-7;
+         if(iout == 11) fail |= yo[2] < 0.9999 || s.mused != 2;
+         for(int32_t __k{1}; __k != 8; ++__k)
+         {
+             double yk[3], tk;
+             lsoda_lane_result(b,__k,yk,&tk,nullptr);
+             fail |= yk[0] != yo[0] || yk[1] != yo[1] || yk[2] != yo[2];
+         }
+         tout *= 10.0;
+         for(int32_t __k{0}; __k != 8; ++__k) lsoda_lane_continue(b,__k,tout);
+     }
+     lsoda_block_free(b);
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_lsoda_ensemble_lanes();
+
+void unit_test_lsoda_ensemble_lanes()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     const int32_t nsys{21};
+     std::vector<double> k1(nsys);
+     for(int32_t __s{0}; __s != nsys; ++__s) k1[__s] = 0.04*(1.0+0.25*__s);
+     const Robertson f{k1.data()};
+     const RobertsonJac jac{k1.data()};
+     const double rtol[1] = {1.0e-6}, atol[3] = {1.0e-10,1.0e-14,1.0e-10};
+     const LsodaOpts o{robertson_opts(rtol,atol,2)};
+     std::vector<double> ye(3*nsys), yd(3*nsys);
+     std::vector<int32_t> ist(nsys), isd(nsys);
+     for(int32_t __s{0}; __s != nsys; ++__s)
+     {
+         ye[3*__s] = yd[3*__s] = 1.0; ye[3*__s+1] = yd[3*__s+1] = 0.0; ye[3*__s+2] = yd[3*__s+2] = 0.0;
+     }
+     lsoda_ensemble_zmm8r8_omp(f,jac,nsys,3,ye.data(),0.0,1.0e3,o,ist.data(),nullptr);
+     // difference quotient Jacobian
+     lsoda_ensemble_zmm8r8_omp(f,LsodaNoJac{},nsys,3,yd.data(),0.0,1.0e3,o,isd.data(),nullptr);
+     double dmax{0.0};
+     for(int32_t __s{0}; __s != nsys; ++__s)
+     {
+         // the same system alone, in another lane and block
+         double y1[3] = {1.0,0.0,0.0};
+         int32_t is1;
+         const Robertson fs{&k1[__s]};
+         const RobertsonJac js{&k1[__s]};
+         lsoda_ensemble_zmm8r8_omp(fs,js,1,3,y1,0.0,1.0e3,o,&is1,nullptr);
+         fail |= ist[__s] != 2 || isd[__s] != 2 || is1 != 2;
+         for(int32_t __i{0}; __i != 3; ++__i)
+         {
+             fail |= y1[__i] != ye[3*__s+__i];
+             dmax = std::max(dmax,std::fabs(yd[3*__s+__i]-ye[3*__s+__i])/(rtol[0]*std::fabs(ye[3*__s+__i])+atol[__i]));
+         }
+     }
+     printf("system 0: %.15e %.15e %.15e, system %d: %.15e %.15e %.15e\n",ye[0],ye[1],ye[2],
+            nsys-1,ye[3*nsys-3],ye[3*nsys-2],ye[3*nsys-1]);
+     printf("difference quotient Jacobian: max |y_dq - y_jac|/(rtol*|y|+atol) = %.3e\n",dmax);
+     fail |= dmax > 100.0;
+     // systems with different rates differ
+     fail |= ye[0] == ye[3*nsys-3];
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_lsoda_ensemble_switching();
+
+void unit_test_lsoda_ensemble_switching()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     const double rtol[1] = {1.0e-8}, atol[1] = {1.0e-10};
+     LsodaOpts o{};
+     o.itol = 1;
+     o.rtol = rtol;
+     o.atol = atol;
+     // stiff: Van der Pol mu = 1000 on the slow branch
+     const int32_t nsys{9};
+     std::vector<double> y(2*nsys);
+     std::vector<int32_t> ist(nsys);
+     std::vector<LsodaStats> st(nsys);
+     for(int32_t __s{0}; __s != nsys; ++__s)
+     {
+         y[2*__s] = 2.0; y[2*__s+1] = 0.0;
+     }
+     lsoda_ensemble_zmm8r8_omp(VanDerPol{1000.0},LsodaNoJac{},nsys,2,y.data(),0.0,500.0,o,ist.data(),st.data());
+     printf("Van der Pol mu = 1000: y(500) = %.10e %.10e, nst %d nfe %d nje %d, method %d, switch at %.4e\n",
+            y[0],y[1],st[0].nst,st[0].nfe,st[0].nje,st[0].mused,st[0].tsw);
+     fail |= ist[0] != 2 || st[0].mused != 2 || st[0].tsw <= 0.0 || st[0].nst > 2000;
+     // on the slow branch, ln|y1| - y1^2/2 = ln 2 - 2 + t/mu until the jump at y1 = 1
+     {
+         const double yt{y[0]};
+         const double g{std::log(std::fabs(yt))-0.5*yt*yt-(std::log(2.0)-2.0+500.0/1000.0)};
+         printf("slow manifold residual %.3e\n",g);
+         fail |= std::fabs(g) > 1.0e-3;
+     }
+     // non-stiff: harmonic oscillator, Adams throughout
+     for(int32_t __s{0}; __s != nsys; ++__s)
+     {
+         y[2*__s] = 1.0; y[2*__s+1] = 0.0;
+     }
+     lsoda_ensemble_zmm8r8_omp(Oscillator{},LsodaNoJac{},nsys,2,y.data(),0.0,10.0,o,ist.data(),st.data());
+     const double e0{std::fabs(y[0]-std::cos(10.0))}, e1{std::fabs(y[1]+std::sin(10.0))};
+     printf("oscillator: y(10) = %.15e %.15e, err %.3e %.3e, nst %d nje %d, method %d\n",
+            y[0],y[1],e0,e1,st[0].nst,st[0].nje,st[0].mused);
+     fail |= ist[0] != 2 || st[0].mused != 1 || st[0].nje != 0 || e0 > 1.0e-6 || e1 > 1.0e-6;
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_lsoda_ensemble_lu();
+
+void unit_test_lsoda_ensemble_lu()
+{
+     using namespace gms::math;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     std::mt19937_64 rng(42);
+     std::uniform_real_distribution<double> u(-1.0,1.0);
+     for(int32_t n{2}; n <= 18; n += 4)
+     {
+         __m512d * a  = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n*n,64));
+         __m512d * a0 = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n*n,64));
+         __m512d * x  = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n,64));
+         __m512d * b0 = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n,64));
+         __m512i * ip = reinterpret_cast<__m512i*>(_mm_malloc(sizeof(__m512i)*n,64));
+         double * pa{reinterpret_cast<double*>(a)}, * px{reinterpret_cast<double*>(x)};
+         for(int32_t __i{0}; __i != 8*n*n; ++__i) pa[__i] = u(rng);
+         for(int32_t __i{0}; __i != 8*n; ++__i) px[__i] = u(rng);
+         // lane 5 singular (zero column 0), lane 6 needs pivoting everywhere (zero diagonal)
+         for(int32_t __i{0}; __i != n; ++__i) pa[8*__i+5] = 0.0;
+         for(int32_t __i{0}; __i != n; ++__i) pa[8*(__i*n+__i)+6] = 0.0;
+         std::copy(a,a+n*n,a0);
+         std::copy(x,x+n,b0);
+         int32_t info[8] = {-1,-1,-1,-1,-1,-1,-1,-1};
+         const __mmask8 msk{0x7F};   // lane 7 not requested
+         lsoda_dgefa_zmm8r8(a,ip,info,n,msk);
+         lsoda_dgesl_zmm8r8(a,ip,x,n,0x5F);
+         const double * pa0{reinterpret_cast<const double*>(a0)}, * pb0{reinterpret_cast<const double*>(b0)};
+         double res{0.0};
+         for(int32_t __k{0}; __k != 8; ++__k)
+         {
+             if(__k == 7)
+             {
+                 // untouched
+                 for(int32_t __i{0}; __i != n*n; ++__i) fail |= pa[8*__i+7] != pa0[8*__i+7];
+                 for(int32_t __i{0}; __i != n; ++__i)   fail |= px[8*__i+7] != pb0[8*__i+7];
+                 fail |= info[7] != -1;
+                 continue;
+             }
+             if(__k == 5)
+             {
+                 fail |= info[5] != 1;
+                 for(int32_t __i{0}; __i != n; ++__i) fail |= px[8*__i+5] != pb0[8*__i+5];
+                 continue;
+             }
+             fail |= info[__k] != 0;
+             for(int32_t __i{0}; __i != n; ++__i)
+             {
+                 double r{-pb0[8*__i+__k]};
+                 for(int32_t __j{0}; __j != n; ++__j) r += pa0[8*(__j*n+__i)+__k]*px[8*__j+__k];
+                 res = std::max(res,std::fabs(r));
+             }
+         }
+         printf("n = %2d: max residual %.3e, info %d %d %d %d %d %d %d %d\n",n,res,
+                info[0],info[1],info[2],info[3],info[4],info[5],info[6],info[7]);
+         fail |= res > 1.0e-10;
+         _mm_free(a); _mm_free(a0); _mm_free(x); _mm_free(b0); _mm_free(ip);
+     }
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_lsoda_ensemble_robertson();
+    unit_test_lsoda_ensemble_lanes();
+    unit_test_lsoda_ensemble_switching();
+    unit_test_lsoda_ensemble_lu();
+    return 0;
+}
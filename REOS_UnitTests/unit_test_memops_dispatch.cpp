@@ -0,0 +1,126 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "GMS_memops_dispatch.h"
+#include "GMS_malloc.h"
+
+/*
+   icpc -o unit_test_memops_dispatch -fp-model fast=2 -qopenmp -qopt-zmm-usage=high -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp GMS_memops_dispatch.h GMS_memops_dispatch.cpp unit_test_memops_dispatch.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -qopenmp -falign-functions=32 -qopt-zmm-usage=high \
+   GMS_config.h GMS_malloc.h GMS_memops_dispatch.h GMS_memops_dispatch.cpp unit_test_memops_dispatch.cpp
+
+*/
+
+void unit_test_memcpy_dispatch_ps();
+
+void unit_test_memcpy_dispatch_ps()
+{
+     using namespace gms::common;
+     // sizes straddle the small-size cut-off, the unrolled loop bodies and the tails
+     constexpr std::size_t sizes[] = {1ULL,5ULL,63ULL,64ULL,145ULL,489ULL,4000ULL,65537ULL,1048579ULL};
+     constexpr std::size_t offs[]  = {0ULL,1ULL,3ULL,4ULL,8ULL};  // relative misalignment of src (in floats)
+     constexpr memops_hint hints[] = {memops_hint::AUTO,memops_hint::CACHED,memops_hint::STREAM};
+     constexpr std::size_t maxn{1048579ULL+16ULL};
+     float * __restrict__ src{reinterpret_cast<float*>(gms_mm_malloc(maxn*sizeof(float),64ULL))};
+     float * __restrict__ dst{reinterpret_cast<float*>(gms_mm_malloc(maxn*sizeof(float),64ULL))};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     memops_print_tuning();
+     for(std::size_t __i{0ULL}; __i != maxn; ++__i) {src[__i] = static_cast<float>(__i)+0.5f;}
+     for(const memops_hint h : hints)
+     {
+         for(const std::size_t off : offs)
+         {
+             for(const std::size_t n : sizes)
+             {
+                  memset_dispatch_ps(&dst[0],-1.0f,maxn,h);
+                  memcpy_dispatch_ps(&dst[1],&src[off],n,h);
+                  if(dst[0] != -1.0f || dst[n+1] != -1.0f)
+                  {
+                       printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, n=%llu, off=%llu, hint=%d -- write out of bounds" ANSI_RESET_ALL "\n",
+                              n,off,static_cast<int>(h));
+                       fail = true;
+                  }
+                  for(std::size_t __i{0ULL}; __i != n; ++__i)
+                  {
+                       if(dst[__i+1ULL] != src[__i+off])
+                       {
+                            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, n=%llu, off=%llu, hint=%d, found value of %.7f at pos: %llu, but expected: %.7f" ANSI_RESET_ALL "\n",
+                                   n,off,static_cast<int>(h),dst[__i+1ULL],__i,src[__i+off]);
+                            fail = true;
+                            break;
+                       }
+                  }
+             }
+         }
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: memcpy_dispatch_ps -- PASSED!!" ANSI_RESET_ALL "\n");}
+     gms_mm_free(dst);
+     gms_mm_free(src);
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_memset_memcpy_dispatch_pd();
+
+void unit_test_memset_memcpy_dispatch_pd()
+{
+     using namespace gms::common;
+     constexpr std::size_t sizes[] = {3ULL,31ULL,32ULL,1000ULL,262147ULL};
+     constexpr memops_hint hints[] = {memops_hint::AUTO,memops_hint::CACHED,memops_hint::STREAM};
+     constexpr std::size_t maxn{262147ULL+8ULL};
+     double * __restrict__ src{reinterpret_cast<double*>(gms_mm_malloc(maxn*sizeof(double),64ULL))};
+     double * __restrict__ dst{reinterpret_cast<double*>(gms_mm_malloc(maxn*sizeof(double),64ULL))};
+     const double fill{3.14159265358979323846264338328};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(const memops_hint h : hints)
+     {
+         for(const std::size_t n : sizes)
+         {
+              memset_dispatch_pd(&src[0],0.0,maxn,h);
+              memset_dispatch_pd(&src[1],fill,n,h);
+              memcpy_dispatch_pd(&dst[1],&src[1],n,h);
+              if(src[0] != 0.0 || src[n+1] != 0.0)
+              {
+                   printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, n=%llu, hint=%d -- fill out of bounds" ANSI_RESET_ALL "\n",
+                          n,static_cast<int>(h));
+                   fail = true;
+              }
+              for(std::size_t __i{1ULL}; __i != n+1ULL; ++__i)
+              {
+                   if(src[__i] != fill || dst[__i] != fill)
+                   {
+                        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, n=%llu, hint=%d, found values of %.15f,%.15f at pos: %llu, but expected: %.15f" ANSI_RESET_ALL "\n",
+                               n,static_cast<int>(h),src[__i],dst[__i],__i,fill);
+                        fail = true;
+                        break;
+                   }
+              }
+         }
+     }
+     // byte interface: odd length falls back, 4-byte granular length uses the kernels
+     const char msg[] = "memcpy_dispatch -- byte interface";
+     char buf[sizeof(msg)] = {};
+     memcpy_dispatch(&buf[0],&msg[0],sizeof(msg));
+     if(std::strcmp(buf,msg) != 0) {fail = true;}
+     memcpy_dispatch(&dst[0],&src[0],8ULL*1024ULL);
+     if(std::memcmp(&dst[0],&src[0],8ULL*1024ULL) != 0) {fail = true;}
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: memset/memcpy_dispatch_pd -- PASSED!!" ANSI_RESET_ALL "\n");}
+     gms_mm_free(dst);
+     gms_mm_free(src);
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main()
+{
+
+    unit_test_memcpy_dispatch_ps();
+    unit_test_memset_memcpy_dispatch_pd();
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_par_team.h"
+
+/*
+   icpc -o unit_test_par_team -fp-model fast=2 -std=c++17 -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5 -qopenmp \
+   GMS_config.h GMS_par_team.h GMS_par_team.cpp unit_test_par_team.cpp -lpthread
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -std=c++17 -march=skylake-avx512 -mavx512f -falign-functions=32 -qopenmp GMS_config.h GMS_par_team.h GMS_par_team.cpp
+
+   The static chunks cover the iteration space once, start on cache-line and unroll
+   boundaries and are given in order to the workers; par_for and the barriers of a
+   par_region sequence are correct with more workers than CPUs; the jobs submitted
+   from a worker, from an OpenMP region, below the threshold or by two threads at
+   once run (serially when needed) without deadlock; the team restarts and stops.
+*/
+
+namespace {
+
+     using namespace gms::common;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // element i written by the worker owning it, every element once
+     bool run_par_for(const std::size_t n,const int32_t unroll,std::vector<int32_t> & owner)
+     {
+          owner.assign(n,-1);
+          std::atomic<int32_t> calls{0};
+          par_for(par_family::STREAM,n,sizeof(float),unroll,[&](const std::size_t lo,const std::size_t hi) {
+                  calls.fetch_add(1);
+                  const int32_t id{static_cast<int32_t>(calls.load())};
+                  for(std::size_t __i{lo}; __i != hi; ++__i)
+                  {
+                      if(owner[__i] != -1) owner[__i] = -2;
+                      else owner[__i] = id;
+                  }
+          });
+          for(std::size_t __i{0ull}; __i != n; ++__i) if(owner[__i] < 0) return (false);
+          return (true);
+     }
+
+}
+
+void unit_test_par_team_chunks();
+
+void unit_test_par_team_chunks()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     if(par_granule(4ull,1) != 16ull || par_granule(64ull,6) != 6ull || par_granule(8ull,6) != 24ull ||
+        par_granule(128ull,1) != 1ull || par_granule(24ull,1) != 8ull || par_granule(4ull,0) != 16ull)
+        test_fail(__PRETTY_FUNCTION__);
+     for(std::size_t n : {0ull,1ull,15ull,16ull,17ull,1000ull,4099ull,65536ull})
+     {
+          for(std::size_t g : {1ull,6ull,16ull,24ull})
+          {
+               for(int32_t nw : {1,2,3,7,16,64})
+               {
+                    std::size_t next{0ull};
+                    for(int32_t id{0}; id != nw; ++id)
+                    {
+                         std::size_t lo,hi;
+                         par_static_chunk(n,g,nw,id,lo,hi);
+                         // contiguous, ordered, granule boundaries (but the end)
+                         if(lo != next || hi < lo) test_fail(__PRETTY_FUNCTION__);
+                         if(lo%g != 0ull || (hi != n && hi%g != 0ull)) test_fail(__PRETTY_FUNCTION__);
+                         next = hi;
+                    }
+                    if(next != n) test_fail(__PRETTY_FUNCTION__);
+               }
+          }
+     }
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_par_team_for();
+
+void unit_test_par_team_for()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     par_team_start(4);
+     if(par_team_size() != 4) test_fail(__PRETTY_FUNCTION__);
+     par_set_threshold(par_family::STREAM,1ull);
+     std::vector<int32_t> owner;
+     for(std::size_t n : {1ull,5ull,64ull,65ull,1000ull,100003ull})
+     {
+          for(int32_t u : {1,6})
+          {
+               for(int32_t __r{0}; __r != 50; ++__r)
+                   if(!run_par_for(n,u,owner)) test_fail(__PRETTY_FUNCTION__);
+          }
+     }
+     // below the threshold: one serial call
+     par_set_threshold(par_family::STREAM,1000000ull);
+     std::atomic<int32_t> calls{0};
+     par_for(par_family::STREAM,1000ull,4ull,1,[&](std::size_t,std::size_t) { calls.fetch_add(1); });
+     if(calls.load() != 1) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_par_team_region();
+
+void unit_test_par_team_region()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     par_set_threshold(par_family::ARITH,1ull);
+     const std::size_t n{10007ull};
+     std::vector<float> a(n),b(n),c(n);
+     for(int32_t __r{0}; __r != 500; ++__r)
+     {
+          // three kernels in one dispatch, each one reads the chunks of the others
+          std::atomic<int32_t> nctx{0};
+          par_region(par_family::ARITH,n,[&](const par_ctx_t & ctx) {
+                 if(ctx.master()) nctx.store(ctx.size());
+                 ctx.for_static(n,sizeof(float),1,[&](std::size_t lo,std::size_t hi) {
+                      for(std::size_t __i{lo}; __i != hi; ++__i) a[__i] = static_cast<float>(__i+__r);
+                 });
+                 ctx.barrier();
+                 ctx.for_static(n,sizeof(float),1,[&](std::size_t lo,std::size_t hi) {
+                      for(std::size_t __i{lo}; __i != hi; ++__i) b[__i] = a[n-1ull-__i];
+                 });
+                 ctx.barrier();
+                 ctx.for_static(n,sizeof(float),1,[&](std::size_t lo,std::size_t hi) {
+                      for(std::size_t __i{lo}; __i != hi; ++__i) c[__i] = b[(__i*7919ull)%n]-a[__i];
+                 });
+          });
+          if(nctx.load() != 4) test_fail(__PRETTY_FUNCTION__);
+          for(std::size_t __i{0ull}; __i != n; ++__i)
+          {
+               const float ai{static_cast<float>(__i+__r)};
+               const float bj{static_cast<float>(n-1ull-(__i*7919ull)%n+__r)};
+               if(a[__i] != ai || c[__i] != bj-ai) test_fail(__PRETTY_FUNCTION__);
+          }
+     }
+     // below the threshold: a one-worker context
+     par_set_threshold(par_family::ARITH,SIZE_MAX);
+     int32_t sz{0};
+     par_region(par_family::ARITH,n,[&](const par_ctx_t & ctx) { ctx.barrier(); sz = ctx.size(); });
+     if(sz != 1) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_par_team_nesting();
+
+void unit_test_par_team_nesting()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     par_set_threshold(par_family::STREAM,1ull);
+     const std::size_t n{4096ull};
+     // par_for from within a job: serial on the worker
+     std::vector<int32_t> hits(n*n/64ull,0);
+     par_for(par_family::STREAM,n/64ull,4ull,1,[&](std::size_t lo,std::size_t hi) {
+          for(std::size_t __j{lo}; __j != hi; ++__j)
+              par_for(par_family::STREAM,n,4ull,1,[&](std::size_t l,std::size_t h) {
+                   for(std::size_t __i{l}; __i != h; ++__i) hits[__j*n+__i] += 1;
+              });
+     });
+     for(int32_t h : hits) if(h != 1) test_fail(__PRETTY_FUNCTION__);
+     // from an OpenMP region
+     std::vector<int32_t> owner;
+     bool ok{true};
+#pragma omp parallel num_threads(2) shared(ok)
+     {
+          std::vector<int32_t> own;
+          if(!run_par_for(1000ull,1,own)) ok = false;
+     }
+     if(!ok) test_fail(__PRETTY_FUNCTION__);
+     // two submitting threads
+     std::vector<std::thread> th;
+     std::atomic<int32_t> bad{0};
+     for(int32_t __t{0}; __t != 2; ++__t)
+         th.emplace_back([&]{ std::vector<int32_t> own;
+                              for(int32_t __r{0}; __r != 200; ++__r) if(!run_par_for(5000ull,6,own)) bad.fetch_add(1); });
+     for(std::thread & t : th) t.join();
+     if(bad.load() != 0) test_fail(__PRETTY_FUNCTION__);
+     // restart and stop
+     par_team_start(2);
+     if(par_team_size() != 2 || !run_par_for(777ull,1,owner)) test_fail(__PRETTY_FUNCTION__);
+     par_team_stop();
+     if(par_team_size() != 1 || !run_par_for(777ull,1,owner)) test_fail(__PRETTY_FUNCTION__);
+     par_team_start(0);
+     par_print_tuning();
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_par_team_chunks();
+    unit_test_par_team_for();
+    unit_test_par_team_region();
+    unit_test_par_team_nesting();
+    return 0;
+}
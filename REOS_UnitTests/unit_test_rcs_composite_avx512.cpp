@@ -0,0 +1,198 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_rcs_composite_avx512.h"
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+/*
+   icpc -o unit_test_rcs_composite_avx512 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp GMS_rcs_composite_avx512.h GMS_rcs_composite_avx512.cpp \
+   unit_test_rcs_composite_avx512.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp GMS_rcs_composite_avx512.h GMS_rcs_composite_avx512.cpp \
+   unit_test_rcs_composite_avx512.cpp
+
+   Composite sphere and cylinder RCS against the exact solutions (Mie series, cylinder series with the
+   std:: Bessel functions), region selection per lane, and the grouped batch drivers against the
+   register by register evaluation.
+*/
+
+namespace {
+
+     constexpr double PI{3.14159265358979323846};
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // Broadside scattering width of the PEC cylinder, 4/k0*|SUM eps_n*(-1)^n*c_n|^2.
+     double cyl_exact_r8(const double k0,const double a,const int32_t pol)
+     {
+          const double x{k0*a};
+          const int32_t nstop{static_cast<int32_t>(x+4.0*std::cbrt(x)+10.0)};
+          std::complex<double> s{0.0,0.0};
+          for(int32_t __n{0}; __n <= nstop; ++__n)
+          {
+              double j{std::cyl_bessel_j(static_cast<double>(__n),x)};
+              double y{std::cyl_neumann(static_cast<double>(__n),x)};
+              if(pol == RCS_CYL_POL__H)
+              {
+                 j = (__n == 0) ? -std::cyl_bessel_j(1.0,x) : std::cyl_bessel_j(__n-1.0,x)-__n/x*j;
+                 y = (__n == 0) ? -std::cyl_neumann(1.0,x)  : std::cyl_neumann(__n-1.0,x)-__n/x*y;
+              }
+              const double w{(__n == 0) ? 1.0 : ((__n & 1) ? -2.0 : 2.0)};
+              s += w*j/std::complex<double>(j,-y);
+          }
+          return (4.0*std::norm(s)/k0);
+     }
+
+     double db(const double r,const double e)
+     {
+          return (std::fabs(10.0*std::log10(r/e)));
+     }
+
+}
+
+void unit_test_rcs_composite_regions_zmm16r4();
+
+void unit_test_rcs_composite_regions_zmm16r4()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const RCS_RegionBounds sb{rcs_sphere_region_bounds()};
+     const RCS_RegionBounds cb{rcs_cylinder_region_bounds()};
+     // k0a from 0.01 to 60, the registers straddle the region boundaries
+     constexpr int32_t n{16*64};
+     double es[3] = {}, ec[2][3] = {}, esr{0.0}, ecr[2] = {};
+     bool fail{false};
+     for(int32_t __i{0}; __i < n; __i += 16)
+     {
+         alignas(64) float k0[16], a[16], rs[16], rc[2][16];
+         alignas(64) int32_t gs[16], gc[16];
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             a[__k]  = 0.05f;
+             k0[__k] = static_cast<float>(0.01*std::pow(6000.0,static_cast<double>(__i+__k)/(n-1))/0.05);
+         }
+         k0[3] = (__i == 0) ? 0.0f : k0[3];
+         __m512 r;
+         __m512i g;
+         fail = fail || rcs_sphere_composite_zmm16r4(_mm512_load_ps(k0),_mm512_load_ps(a),sb,&r,&g) != 0;
+         _mm512_store_ps(rs,r);
+         _mm512_store_si512(gs,g);
+         for(int32_t __p{0}; __p != 2; ++__p)
+         {
+             fail = fail || rcs_cylinder_composite_zmm16r4(_mm512_load_ps(k0),_mm512_load_ps(a),__p,cb,&r,
+                                                           (__p == 0) ? &g : nullptr) != 0;
+             _mm512_store_ps(rc[__p],r);
+         }
+         _mm512_store_si512(gc,g);
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             const double k{k0[__k]}, aa{a[__k]}, x{k*aa};
+             if(!(x > 0.0))
+             {
+                fail = fail || rs[__k] != 0.0f || rc[0][__k] != 0.0f || gs[__k] != -1 || gc[__k] != -1;
+                continue;
+             }
+             const int32_t es_g{(x < sb.k0a_rayleigh) ? RCS_REGION__RAYLEIGH :
+                                (x >= sb.k0a_optics) ? RCS_REGION__OPTICS : RCS_REGION__RESONANCE};
+             const int32_t ec_g{(x < cb.k0a_rayleigh) ? RCS_REGION__RAYLEIGH :
+                                (x >= cb.k0a_optics) ? RCS_REGION__OPTICS : RCS_REGION__RESONANCE};
+             fail = fail || gs[__k] != es_g || gc[__k] != ec_g;
+             // deviation from the exact solution per region (dB)
+             const double rsx{rcs_mie_sphere_r8(k,aa,{0.0,0.0},true,nullptr,nullptr,nullptr)};
+             es[es_g] = std::max(es[es_g],db(rs[__k],rsx));
+             if(es_g == RCS_REGION__RESONANCE) esr = std::max(esr,std::fabs(rs[__k]-rsx)/rsx);
+             for(int32_t __p{0}; __p != 2; ++__p)
+             {
+                 const double rcx{cyl_exact_r8(k,aa,__p)};
+                 ec[__p][ec_g] = std::max(ec[__p][ec_g],db(rc[__p][__k],rcx));
+                 if(ec_g == RCS_REGION__RESONANCE) ecr[__p] = std::max(ecr[__p],std::fabs(rc[__p][__k]-rcx)/rcx);
+             }
+         }
+     }
+     printf("sphere   max |dB| Rayleigh=%.3f resonance=%.2e optics=%.3f (resonance rel. error %.2e)\n",
+            es[0],es[1],es[2],esr);
+     printf("cyl E    max |dB| Rayleigh=%.3f resonance=%.2e optics=%.3f (resonance rel. error %.2e)\n",
+            ec[0][0],ec[0][1],ec[0][2],ecr[0]);
+     printf("cyl H    max |dB| Rayleigh=%.3f resonance=%.2e optics=%.3f (resonance rel. error %.2e)\n",
+            ec[1][0],ec[1][1],ec[1][2],ecr[1]);
+     fail = fail || esr > 1.0e-4 || ecr[0] > 1.0e-4 || ecr[1] > 1.0e-4;
+     fail = fail || es[0] > 0.25 || es[2] > 0.5 || ec[0][0] > 0.25 || ec[1][0] > 0.25 || ec[0][2] > 0.1 || ec[1][2] > 0.1;
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_rcs_composite_omp();
+
+void unit_test_rcs_composite_omp()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // random targets (k0a from 0.01 to 100, unsorted), the small batch path and the grouped path
+     std::mt19937 rng(1234);
+     std::uniform_real_distribution<float> ua(0.01f,1.0f), ul(-2.0f,2.0f);
+     bool fail{false};
+     double eg[2] = {};
+     for(const int32_t n : {77,5003})
+     {
+         std::vector<float> k0(n), a(n), rs(n,-1.0f), rc(n,-1.0f), rh(n,-1.0f);
+         for(int32_t __i{0}; __i != n; ++__i)
+         {
+             a[__i]  = ua(rng);
+             k0[__i] = std::pow(10.0f,ul(rng))/a[__i];
+         }
+         k0[n/2] = 0.0f;
+         const RCS_RegionBounds sb{rcs_sphere_region_bounds()};
+         const RCS_RegionBounds cb{rcs_cylinder_region_bounds()};
+         fail = fail || rcs_sphere_composite_omp(k0.data(),a.data(),n,sb,rs.data()) != 0;
+         fail = fail || rcs_cylinder_composite_omp(k0.data(),a.data(),n,RCS_CYL_POL__E,cb,rc.data()) != 0;
+         fail = fail || rcs_cylinder_composite_omp(k0.data(),a.data(),n,RCS_CYL_POL__H,cb,rh.data()) != 0;
+         for(int32_t __i{0}; __i < n; __i += 16)
+         {
+             const int32_t m{std::min(16,n-__i)};
+             alignas(64) float kk[16] = {}, aa[16] = {}, r[3][16];
+             std::copy(&k0[__i],&k0[__i]+m,kk);
+             std::copy(&a[__i],&a[__i]+m,aa);
+             __m512 v;
+             rcs_sphere_composite_zmm16r4(_mm512_load_ps(kk),_mm512_load_ps(aa),sb,&v,nullptr);
+             _mm512_store_ps(r[0],v);
+             rcs_cylinder_composite_zmm16r4(_mm512_load_ps(kk),_mm512_load_ps(aa),RCS_CYL_POL__E,cb,&v,nullptr);
+             _mm512_store_ps(r[1],v);
+             rcs_cylinder_composite_zmm16r4(_mm512_load_ps(kk),_mm512_load_ps(aa),RCS_CYL_POL__H,cb,&v,nullptr);
+             _mm512_store_ps(r[2],v);
+             const float * o[3] = {&rs[__i],&rc[__i],&rh[__i]};
+             for(int32_t __j{0}; __j != 3; ++__j)
+             {
+                 for(int32_t __k{0}; __k != m; ++__k)
+                 {
+                     const float ref{r[__j][__k]};
+                     if(ref == 0.0f) { fail = fail || o[__j][__k] != 0.0f; continue; }
+                     eg[n > 100] = std::max(eg[n > 100],static_cast<double>(std::fabs(o[__j][__k]-ref)/ref));
+                 }
+             }
+         }
+     }
+     // the grouped resonance registers run the series to other lengths (last bits differ)
+     printf("batch vs register max rel. difference: n=77 %.3e, n=5003 %.3e\n",eg[0],eg[1]);
+     if(fail || eg[0] != 0.0 || eg[1] > 1.0e-5) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_rcs_composite_regions_zmm16r4();
+    unit_test_rcs_composite_omp();
+    return 0;
+}
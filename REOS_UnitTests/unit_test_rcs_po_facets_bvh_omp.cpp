@@ -0,0 +1,286 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_rcs_po_facets_bvh_omp.h"
+
+/*
+   icpc -o unit_test_rcs_po_facets_bvh_omp -fp-model precise -qopenmp -qopt-zmm-usage=high -ggdb -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_rcs_po_facets_bvh_omp.h GMS_rcs_po_facets_bvh_omp.cpp unit_test_rcs_po_facets_bvh_omp.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -qopenmp -falign-functions=32 -qopt-zmm-usage=high \
+   GMS_config.h GMS_rcs_po_facets_bvh_omp.h GMS_rcs_po_facets_bvh_omp.cpp unit_test_rcs_po_facets_bvh_omp.cpp
+
+   The reference values are the closed forms of GMS_rcs_planar_surf_zmm16r4.hpp (formula 7.5-33,
+   rectangular plate) and GMS_rcs_sphere_zmm16r4.hpp (formula 3.2-24, high frequency limit),
+   re-expressed in scalar double precision.
+*/
+
+constexpr double PI{3.14159265358979323846264338328};
+
+struct test_mesh_t {
+
+       std::vector<double>  xs,ys,zs;
+       std::vector<int32_t> tri;
+};
+
+// Rectangular plate a x b in the plane z=z0, centered at the origin, normal +z.
+static void unit_test_plate(test_mesh_t & m,const double a,const double b,const double z0,
+                            const int32_t nx,const int32_t ny)
+{
+       const int32_t base{static_cast<int32_t>(m.xs.size())};
+       for(int32_t __j{0}; __j <= ny; ++__j)
+           for(int32_t __i{0}; __i <= nx; ++__i)
+           {
+                m.xs.push_back(-0.5*a+a*static_cast<double>(__i)/nx);
+                m.ys.push_back(-0.5*b+b*static_cast<double>(__j)/ny);
+                m.zs.push_back(z0);
+           }
+       for(int32_t __j{0}; __j != ny; ++__j)
+           for(int32_t __i{0}; __i != nx; ++__i)
+           {
+                const int32_t p{base+__j*(nx+1)+__i};
+                m.tri.insert(m.tri.end(),{p,p+1,p+nx+2});
+                m.tri.insert(m.tri.end(),{p,p+nx+2,p+nx+1});
+           }
+}
+
+// Geodesic sphere of radius r, 20*4^nsub outward oriented facets.
+static void unit_test_icosphere(test_mesh_t & m,const double r,const int32_t nsub)
+{
+       const double t{0.5*(1.0+std::sqrt(5.0))};
+       std::vector<double> v = {-1,t,0, 1,t,0, -1,-t,0, 1,-t,0, 0,-1,t, 0,1,t,
+                                0,-1,-t, 0,1,-t, t,0,-1, t,0,1, -t,0,-1, -t,0,1};
+       std::vector<int32_t> f = {0,11,5, 0,5,1, 0,1,7, 0,7,10, 0,10,11, 1,5,9, 5,11,4, 11,10,2, 10,7,6, 7,1,8,
+                                 3,9,4, 3,4,2, 3,2,6, 3,6,8, 3,8,9, 4,9,5, 2,4,11, 6,2,10, 8,6,7, 9,8,1};
+       auto norm = [&v](int32_t i) {
+            const double l{std::sqrt(v[3*i]*v[3*i]+v[3*i+1]*v[3*i+1]+v[3*i+2]*v[3*i+2])};
+            v[3*i] /= l; v[3*i+1] /= l; v[3*i+2] /= l;
+       };
+       for(int32_t __i{0}; __i != 12; ++__i) norm(__i);
+       for(int32_t __s{0}; __s != nsub; ++__s)
+       {
+           std::map<std::pair<int32_t,int32_t>,int32_t> mid;
+           auto midpoint = [&](int32_t a,int32_t b) {
+                const std::pair<int32_t,int32_t> key{std::min(a,b),std::max(a,b)};
+                auto it = mid.find(key);
+                if(it != mid.end()) return it->second;
+                const int32_t id{static_cast<int32_t>(v.size()/3)};
+                for(int32_t __k{0}; __k != 3; ++__k) v.push_back(0.5*(v[3*a+__k]+v[3*b+__k]));
+                norm(id);
+                mid.emplace(key,id);
+                return id;
+           };
+           std::vector<int32_t> g;
+           g.reserve(4*f.size());
+           for(std::size_t __t{0}; __t != f.size(); __t += 3)
+           {
+                const int32_t a{f[__t]}, b{f[__t+1]}, c{f[__t+2]};
+                const int32_t ab{midpoint(a,b)}, bc{midpoint(b,c)}, ca{midpoint(c,a)};
+                g.insert(g.end(),{a,ab,ca, b,bc,ab, c,ca,bc, ab,bc,ca});
+           }
+           f.swap(g);
+       }
+       const int32_t base{static_cast<int32_t>(m.xs.size())};
+       for(std::size_t __i{0}; __i != v.size()/3; ++__i)
+       {
+           m.xs.push_back(r*v[3*__i]); m.ys.push_back(r*v[3*__i+1]); m.zs.push_back(r*v[3*__i+2]);
+       }
+       for(std::size_t __t{0}; __t != f.size(); __t += 3)
+       {
+           int32_t a{f[__t]}, b{f[__t+1]}, c{f[__t+2]};
+           double e1[3],e2[3],cn{0.0};
+           for(int32_t __k{0}; __k != 3; ++__k) {e1[__k] = v[3*b+__k]-v[3*a+__k]; e2[__k] = v[3*c+__k]-v[3*a+__k];}
+           const double n[3] = {e1[1]*e2[2]-e1[2]*e2[1],e1[2]*e2[0]-e1[0]*e2[2],e1[0]*e2[1]-e1[1]*e2[0]};
+           for(int32_t __k{0}; __k != 3; ++__k) cn += n[__k]*v[3*a+__k];
+           if(cn < 0.0) std::swap(b,c);
+           m.tri.insert(m.tri.end(),{base+a,base+b,base+c});
+       }
+}
+
+// Formula 7.5-33, a,b are the side lengths.
+static double unit_test_rcs_f7533(const double a,const double b,const double k0,
+                                  const double tht,const double phi)
+{
+       auto sinc = [](const double x) {return (std::fabs(x) < 1.0e-12) ? 1.0 : std::sin(x)/x;};
+       const double lam{2.0*PI/k0};
+       const double A{a*b};
+       const double st{std::sin(tht)};
+       const double ct{std::cos(tht)};
+       const double x{sinc(k0*a*st*std::cos(phi))};
+       const double y{sinc(k0*b*st*std::sin(phi))};
+       return (4.0*PI*A*A/(lam*lam)*ct*ct*x*x*y*y);
+}
+
+void unit_test_po_rcs_plate();
+
+void unit_test_po_rcs_plate()
+{
+     using namespace gms::radiolocation;
+     constexpr double a{1.0};
+     constexpr double b{0.7};
+     constexpr double k0{2.0*PI/0.1};
+     constexpr int32_t nth{31};
+     constexpr int32_t nph{7};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     test_mesh_t m;
+     unit_test_plate(m,a,b,0.0,13,9);
+     // 1-based indices, the same plate must give the same result
+     std::vector<int32_t> tri1(m.tri);
+     for(int32_t & t : tri1) t += 1;
+     PO_Facets f0,f1;
+     if(!po_facets_build(m.xs.data(),m.ys.data(),m.zs.data(),m.tri.data(),
+                         static_cast<int32_t>(m.tri.size()/3),3,0,f0) ||
+        !po_facets_build(m.xs.data(),m.ys.data(),m.zs.data(),tri1.data(),
+                         static_cast<int32_t>(tri1.size()/3),3,1,f1))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, po_facets_build" ANSI_RESET_ALL "\n");
+        std::exit(EXIT_FAILURE);
+     }
+     std::vector<double> th,ph,r0(nth*nph),r1(nth*nph);
+     for(int32_t __p{0}; __p != nph; ++__p)
+         for(int32_t __t{0}; __t != nth; ++__t)
+         {
+              th.push_back(static_cast<double>(__t)*(1.3/(nth-1)));
+              ph.push_back(static_cast<double>(__p)*(PI/(nph-1))+0.01);
+         }
+     po_rcs_monostatic_omp(f0,th.data(),ph.data(),nth*nph,k0,true,false,r0.data());
+     po_rcs_monostatic_omp(f1,th.data(),ph.data(),nth*nph,k0,false,false,r1.data());
+     const double smax{unit_test_rcs_f7533(a,b,k0,0.0,0.0)};
+     double emax{0.0};
+     for(int32_t __i{0}; __i != nth*nph; ++__i)
+     {
+         const double ref{unit_test_rcs_f7533(a,b,k0,th[__i],ph[__i])};
+         const double err{std::fabs(r0[__i]-ref)};
+         emax = std::max(emax,err/smax);
+         if(err > 1.0e-9*smax+1.0e-9*ref || std::fabs(r1[__i]-r0[__i]) > 1.0e-12*smax)
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, plate (tht=%.4f,phi=%.4f): rcs=%.12e, rcs(base 1)=%.12e, ref=%.12e" ANSI_RESET_ALL "\n",
+                   th[__i],ph[__i],r0[__i],r1[__i],ref);
+            fail = true;
+         }
+     }
+     printf("plate %gx%g, ka=%.1f, max |rcs-f7533|/rcs(0) = %.3e\n",a,b,k0*a,emax);
+     po_facets_free(f1);
+     po_facets_free(f0);
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: po_rcs_monostatic_omp (plate, f7533) -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_po_rcs_sphere();
+
+void unit_test_po_rcs_sphere()
+{
+     using namespace gms::radiolocation;
+     constexpr double r{1.0};
+     constexpr double k0{40.0};
+     constexpr int32_t na{9};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     test_mesh_t m;
+     unit_test_icosphere(m,r,6);
+     PO_Facets f;
+     if(!po_facets_build(m.xs.data(),m.ys.data(),m.zs.data(),m.tri.data(),
+                         static_cast<int32_t>(m.tri.size()/3),3,0,f))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, po_facets_build" ANSI_RESET_ALL "\n");
+        std::exit(EXIT_FAILURE);
+     }
+     std::vector<double> th(na),ph(na),rs(na),rn(na);
+     for(int32_t __i{0}; __i != na; ++__i)
+     {
+         th[__i] = 0.37*static_cast<double>(__i);
+         ph[__i] = 0.71*static_cast<double>(__i);
+     }
+     po_rcs_monostatic_omp(f,th.data(),ph.data(),na,k0,true,false,rs.data());
+     po_rcs_monostatic_omp(f,th.data(),ph.data(),na,k0,false,false,rn.data());
+     // Formula 3.2-24 (k0a >> 1): sigma -> pi*a^2. The PO integral of the sphere oscillates
+     // around it as pi*a^2*(1-sin(2k0a)/(k0a)+sin^2(k0a)/(k0a)^2).
+     const double ka{k0*r};
+     const double opt{PI*r*r};
+     const double po{opt*(1.0-std::sin(2.0*ka)/ka+std::sin(ka)*std::sin(ka)/(ka*ka))};
+     printf("sphere k0a=%.1f, facets=%d, f3224=%.6f, PO closed form=%.6f\n",ka,f.nf,opt,po);
+     for(int32_t __i{0}; __i != na; ++__i)
+     {
+         printf("tht=%.3f phi=%.3f rcs=%.6f (shadow rays off: %.6f)\n",th[__i],ph[__i],rs[__i],rn[__i]);
+         // convex body: the shadow rays must not remove any facet
+         if(std::fabs(rs[__i]-rn[__i]) > 1.0e-12*opt ||
+            std::fabs(rs[__i]-opt) > 0.05*opt)
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, sphere (tht=%.4f,phi=%.4f): rcs=%.9f, f3224=%.9f" ANSI_RESET_ALL "\n",
+                   th[__i],ph[__i],rs[__i],opt);
+            fail = true;
+         }
+     }
+     po_facets_free(f);
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: po_rcs_monostatic_omp (sphere, f3224) -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_po_rcs_shadowing();
+
+void unit_test_po_rcs_shadowing()
+{
+     using namespace gms::radiolocation;
+     constexpr double a{0.8};
+     constexpr double k0{2.0*PI/0.05};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // the plate at z=1 hides the one at z=0 near normal incidence
+     test_mesh_t m;
+     unit_test_plate(m,a,a,0.0,10,10);
+     unit_test_plate(m,a,a,1.0,10,10);
+     PO_Facets f;
+     if(!po_facets_build(m.xs.data(),m.ys.data(),m.zs.data(),m.tri.data(),
+                         static_cast<int32_t>(m.tri.size()/3),3,0,f))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, po_facets_build" ANSI_RESET_ALL "\n");
+        std::exit(EXIT_FAILURE);
+     }
+     const double th[3] = {0.0,0.01,0.02};
+     const double ph[3] = {0.0,0.3,1.1};
+     double rs[3],rn[3];
+     po_rcs_monostatic_omp(f,th,ph,3,k0,true,false,rs);
+     po_rcs_monostatic_omp(f,th,ph,3,k0,false,false,rn);
+     for(int32_t __i{0}; __i != 3; ++__i)
+     {
+         // every centroid ray of the lower plate hits the upper plate (offset < 1*tan(0.02)*...)
+         const double ref{unit_test_rcs_f7533(a,a,k0,th[__i],ph[__i])};
+         // no shadowing: two equal plates, phase difference 2*k0*cos(tht)
+         const double two{2.0*ref*(1.0+std::cos(2.0*k0*std::cos(th[__i])))};
+         printf("tht=%.3f: shadowed=%.6f, single plate=%.6f, unshadowed=%.6f, two plates=%.6f\n",
+                th[__i],rs[__i],ref,rn[__i],two);
+         if(std::fabs(rs[__i]-ref) > 1.0e-6*ref || std::fabs(rn[__i]-two) > 1.0e-6*ref)
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, shadowing tht=%.4f" ANSI_RESET_ALL "\n",th[__i]);
+            fail = true;
+         }
+     }
+     // direct occlusion queries
+     const float dir[3] = {0.0f,0.0f,1.0f};
+     const float o1[3] = {0.1f,0.1f,0.5f};
+     const float o2[3] = {0.6f,0.1f,0.5f};
+     if(!po_ray_occluded(f,o1,dir,0.0f,1.0e+30f,-1) || po_ray_occluded(f,o1,dir,0.0f,0.4f,-1) ||
+         po_ray_occluded(f,o2,dir,0.0f,1.0e+30f,-1))
+     {
+        printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, po_ray_occluded" ANSI_RESET_ALL "\n");
+        fail = true;
+     }
+     po_facets_free(f);
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: po_rcs_monostatic_omp (shadowing) -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+int main()
+{
+    unit_test_po_rcs_plate();
+    unit_test_po_rcs_sphere();
+    unit_test_po_rcs_shadowing();
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+/*
+   icpc -o unit_test_rcs_sphere_mie_avx512 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp unit_test_rcs_sphere_mie_avx512.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_rcs_sphere_mie_avx512.h GMS_rcs_sphere_mie_avx512.cpp unit_test_rcs_sphere_mie_avx512.cpp
+
+   Scalar reference against the Bohren-Huffman test case and the PEC limits (Rayleigh 9*pi*a^2*(k0a)^4,
+   optics pi*a^2), then the zmm8r8/zmm16r4 kernels and the sweep drivers against the scalar reference.
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     struct case_t {
+          double x;
+          std::complex<double> m;
+          bool pec;
+     };
+
+     // PEC, lossless dielectric, lossy dielectric, water-like at the radar bands
+     std::vector<case_t> mie_cases(const double xmax, const int32_t n)
+     {
+          const std::complex<double> ms[3] = {{1.5,0.0},{1.33,0.01},{8.0,2.5}};
+          std::vector<case_t> c;
+          for(int32_t __i{0}; __i != n; ++__i)
+          {
+              const double x{0.01*std::pow(xmax/0.01,static_cast<double>(__i)/(n-1))};
+              c.push_back({x,{0.0,0.0},true});
+              for(const auto & m : ms) c.push_back({x,m,false});
+          }
+          return (c);
+     }
+
+}
+
+void unit_test_rcs_mie_sphere_r8();
+
+void unit_test_rcs_mie_sphere_r8()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     // Bohren & Huffman, appendix A: m = 1.55, x = 5.213 -> Qext = Qsca = 3.10543, Qback = 2.92534
+     {
+        const double lambda{0.6328}, a{0.525};
+        const double k0{2.0*3.14159265358979323846/lambda};
+        double qe, qs;
+        std::complex<double> F;
+        const double sig{rcs_mie_sphere_r8(k0,a,{1.55,0.0},false,&F,&qe,&qs)};
+        const double qb{sig/(3.14159265358979323846*a*a)};
+        printf("BH case: Qext=%.5f Qsca=%.5f Qback=%.5f\n",qe,qs,qb);
+        fail = fail || std::fabs(qe-3.10543) > 2.0e-5 || std::fabs(qs-3.10543) > 2.0e-5 || std::fabs(qb-2.92534) > 2.0e-5;
+     }
+     // PEC: Rayleigh limit, optical limit, lossless -> Qext = Qsca
+     {
+        const double x{0.01};
+        const double qb{rcs_mie_sphere_r8(x,1.0,{0.0,0.0},true,nullptr,nullptr,nullptr)/3.14159265358979323846};
+        fail = fail || std::fabs(qb/(9.0*x*x*x*x)-1.0) > 1.0e-3;
+        const double qb2{rcs_mie_sphere_r8(400.0,1.0,{0.0,0.0},true,nullptr,nullptr,nullptr)/3.14159265358979323846};
+        fail = fail || std::fabs(qb2-1.0) > 1.0e-2;
+        double qe, qs;
+        rcs_mie_sphere_r8(7.3,1.0,{0.0,0.0},true,nullptr,&qe,&qs);
+        fail = fail || std::fabs(qe-qs) > 1.0e-10*qe;
+        printf("PEC: Qb(0.01)/9x^4=%.6f Qb(400)=%.5f Qext-Qsca(7.3)=%.3e\n",qb/(9.0*x*x*x*x),qb2,qe-qs);
+     }
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_rcs_mie_sphere_zmm8r8_zmm16r4();
+
+void unit_test_rcs_mie_sphere_zmm8r8_zmm16r4()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::vector<case_t> c{mie_cases(500.0,301)};
+     const int32_t n{static_cast<int32_t>(c.size())};
+     double e8{0.0}, e16{0.0}, e16q{0.0}, e16l{0.0};
+     // the lanes of a register mix all sizes and materials of a block
+     for(int32_t __i{0}; __i < n; __i += 16)
+     {
+         alignas(64) double k8[16], a8[16], mr8[16], mi8[16];
+         alignas(64) float  k4[16], a4[16], mr4[16], mi4[16];
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             const case_t & cc{c[std::min(__i+__k,n-1)]};
+             k8[__k] = cc.x/0.1; a8[__k] = 0.1; mr8[__k] = cc.m.real(); mi8[__k] = cc.m.imag();
+             k4[__k] = static_cast<float>(k8[__k]); a4[__k] = 0.1f;
+             mr4[__k] = static_cast<float>(mr8[__k]); mi4[__k] = static_cast<float>(mi8[__k]);
+         }
+         for(int32_t __p{0}; __p != 2; ++__p)
+         {
+             const bool pec{__p == 0};
+             alignas(64) double s8[16], q8[16];
+             alignas(64) float  s4[16], q4[16];
+             for(int32_t __h{0}; __h != 2; ++__h)
+             {
+                 __m512d r, fr, fi, qe, qs;
+                 rcs_mie_sphere_zmm8r8(_mm512_load_pd(&k8[8*__h]),_mm512_load_pd(&a8[8*__h]),_mm512_load_pd(&mr8[8*__h]),
+                                       _mm512_load_pd(&mi8[8*__h]),pec,&r,&fr,&fi,&qe,&qs);
+                 _mm512_store_pd(&s8[8*__h],r);
+                 _mm512_store_pd(&q8[8*__h],qe);
+             }
+             __m512 r, fr, fi, qe, qs;
+             rcs_mie_sphere_zmm16r4(_mm512_load_ps(k4),_mm512_load_ps(a4),_mm512_load_ps(mr4),_mm512_load_ps(mi4),
+                                    pec,&r,&fr,&fi,&qe,&qs);
+             _mm512_store_ps(s4,r);
+             _mm512_store_ps(q4,qe);
+             for(int32_t __k{0}; __k != 16 && __i+__k < n; ++__k)
+             {
+                 if(pec != c[__i+__k].pec) continue;
+                 double qer, qer4;
+                 const double ref{rcs_mie_sphere_r8(k8[__k],a8[__k],c[__i+__k].m,pec,nullptr,&qer,nullptr)};
+                 // the float kernel against the reference at the rounded inputs
+                 const std::complex<double> m4{mr4[__k],mi4[__k]};
+                 const double ref4{rcs_mie_sphere_r8(k4[__k],a4[__k],m4,pec,nullptr,&qer4,nullptr)};
+                 // relative to max(sigma, 1e-3*pi*a^2*min(1,9x^4)): absolute near the deep resonance nulls
+                 const double x{c[__i+__k].x};
+                 const double fl{1.0e-3*3.14159265358979323846*0.01*std::min(1.0,9.0*x*x*x*x)};
+                 e8   = std::max(e8,std::fabs(s8[__k]-ref)/std::max(ref,fl));
+                 const double e{std::fabs(static_cast<double>(s4[__k])-ref4)/std::max(ref4,fl)};
+                 if(!pec && m4.imag() == 0.0 && x > 30.0) e16l = std::max(e16l,e); // lossless, resonant
+                 else                                     e16  = std::max(e16,e);
+                 // Re(a_n+b_n) ~ x^6 of a non-absorbing Rayleigh sphere cancels in float
+                 if(x > 0.1 || (!pec && m4.imag() > 0.0))
+                    e16q = std::max(e16q,std::fabs(static_cast<double>(q4[__k])-qer4)/qer4);
+             }
+         }
+     }
+     printf("max rel. error: zmm8r8=%.3e zmm16r4=%.3e (lossless x > 30: %.3e, Qext: %.3e), %d cases, x <= 500\n",
+            e8,e16,e16l,e16q,n);
+     if(e8 > 1.0e-9 || e16 > 1.0e-4 || e16l > 5.0e-2 || e16q > 1.0e-4) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_rcs_mie_sphere_sweep_omp();
+
+void unit_test_rcs_mie_sphere_sweep_omp()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // 1..40 GHz sweep of a 15 cm calibration sphere (PEC), tail lanes and x = 0 lanes
+     constexpr int32_t n{1003};
+     std::vector<double> k8(n), a8(n,0.15), r8(n,-1.0), mr8(n,1.8), mi8(n,0.3);
+     std::vector<float> k4(n), a4(n,0.15f), r4(n,-1.0f);
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+         k8[__i] = 2.0*3.14159265358979323846*(1.0e+9+39.0e+9*__i/(n-1))/299792458.0;
+         k4[__i] = static_cast<float>(k8[__i]);
+     }
+     k8[5] = 0.0;
+     k4[5] = 0.0f;
+     bool fail{rcs_mie_sphere_sweep_zmm8r8_omp(k8.data(),a8.data(),nullptr,nullptr,n,r8.data()) != 0 ||
+               rcs_mie_sphere_sweep_zmm16r4_omp(k4.data(),a4.data(),nullptr,nullptr,n,r4.data()) != 0};
+     double e8{0.0}, e4{0.0};
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+         const double ref{rcs_mie_sphere_r8(k8[__i],a8[__i],{0.0,0.0},true,nullptr,nullptr,nullptr)};
+         if(__i == 5) { fail = fail || r8[__i] != 0.0 || r4[__i] != 0.0f; continue; }
+         e8 = std::max(e8,std::fabs(r8[__i]-ref)/ref);
+         const double ref4{rcs_mie_sphere_r8(k4[__i],a4[__i],{0.0,0.0},true,nullptr,nullptr,nullptr)};
+         e4 = std::max(e4,std::fabs(r4[__i]-ref4)/ref4);
+     }
+     // dielectric
+     rcs_mie_sphere_sweep_zmm8r8_omp(k8.data(),a8.data(),mr8.data(),mi8.data(),n,r8.data());
+     double e8d{0.0};
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+         if(__i == 5) continue;
+         const double ref{rcs_mie_sphere_r8(k8[__i],a8[__i],{1.8,0.3},false,nullptr,nullptr,nullptr)};
+         e8d = std::max(e8d,std::fabs(r8[__i]-ref)/ref);
+     }
+     printf("sweep max rel. error: PEC zmm8r8=%.3e zmm16r4=%.3e, dielectric zmm8r8=%.3e\n",e8,e4,e8d);
+     if(fail || e8 > 1.0e-9 || e4 > 1.0e-4 || e8d > 1.0e-9) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_rcs_mie_sphere_r8();
+    unit_test_rcs_mie_sphere_zmm8r8_zmm16r4();
+    unit_test_rcs_mie_sphere_sweep_omp();
+    return 0;
+}
@@ -0,0 +1,391 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_rigid_body_6dof_zmm16r4.h"
+#include "GMS_par_team.h"
+
+/*
+   icpc -o unit_test_rigid_body_6dof_zmm16r4 -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   -DENABLE_AVX512F GMS_config.h GMS_par_team.h GMS_par_team.cpp GMS_sleefsimdsp.h GMS_sleefsimdsp.cpp GMS_rigid_body_6dof_zmm16r4.h GMS_rigid_body_6dof_zmm16r4.cpp \
+   unit_test_rigid_body_6dof_zmm16r4.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_rigid_body_6dof_zmm16r4.h GMS_rigid_body_6dof_zmm16r4.cpp
+
+   Random bodies (attitudes, rates, triaxial inertias, loads) against a scalar
+   double RK4 of the same equations; the torque-free axisymmetric spin against
+   the analytic nutation of the rates, the torque-free triaxial body conserves
+   the angular momentum in NED and the kinetic energy; a thrusting body
+   without rotation against the closed form trajectory. The rotation matrices
+   are orthonormal with det +1 and rotate a body vector as q*v*conj(q), the
+   LOS outputs against the scalar geometry. The worker team gives the same
+   bits as the serial range kernel over two calls (the renormalization
+   phase kept by nstep).
+*/
+
+namespace {
+
+     using namespace gms::math;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     inline float lane(const __m512 * v,const int32_t b) { return (reinterpret_cast<const float*>(v)[b]); }
+     inline float & lane(__m512 * v,const int32_t b)     { return (reinterpret_cast<float*>(v)[b]); }
+
+     // the arrays of n registers of every member
+     struct Bodies
+     {
+          int32_t n;
+          std::vector<__m512> a[13+9+12];
+
+          explicit Bodies(const int32_t nr) : n(nr)
+          {
+               for(auto & v : a) v.assign(static_cast<std::size_t>(nr),_mm512_setzero_ps());
+          }
+
+          RB6DofState state()
+          {
+               RB6DofState s;
+               s.q0 = a[0].data(); s.q1 = a[1].data(); s.q2 = a[2].data(); s.q3 = a[3].data();
+               s.wx = a[4].data(); s.wy = a[5].data(); s.wz = a[6].data();
+               s.pn = a[7].data(); s.pe = a[8].data(); s.pd = a[9].data();
+               s.vn = a[10].data(); s.ve = a[11].data(); s.vd = a[12].data();
+               s.nstep = 0;
+               return (s);
+          }
+
+          RB6DofLoads loads()
+          {
+               RB6DofLoads l;
+               l.ix = a[13].data(); l.iy = a[14].data(); l.iz = a[15].data();
+               l.fx = a[16].data(); l.fy = a[17].data(); l.fz = a[18].data();
+               l.tx = a[19].data(); l.ty = a[20].data(); l.tz = a[21].data();
+               return (l);
+          }
+
+          // the state and the inertias and loads of the body b
+          void get(const int32_t b,double x[22]) const
+          {
+               for(int32_t __k{0}; __k != 22; ++__k) x[__k] = static_cast<double>(lane(a[__k].data(),b));
+          }
+
+          void set(const int32_t b,const double x[22])
+          {
+               for(int32_t __k{0}; __k != 22; ++__k) lane(a[__k].data(),b) = static_cast<float>(x[__k]);
+          }
+     };
+
+     // x[0..12] state, x[13..21] ix,iy,iz,f,tau
+     void rhs(const double * x,const double * c,const double g,double * d)
+     {
+          const double q0{x[0]},q1{x[1]},q2{x[2]},q3{x[3]},wx{x[4]},wy{x[5]},wz{x[6]};
+          d[0] = -0.5*(q1*wx+q2*wy+q3*wz);
+          d[1] =  0.5*(q0*wx+q2*wz-q3*wy);
+          d[2] =  0.5*(q0*wy+q3*wx-q1*wz);
+          d[3] =  0.5*(q0*wz+q1*wy-q2*wx);
+          d[4] = ((c[1]-c[2])*wy*wz+c[6])/c[0];
+          d[5] = ((c[2]-c[0])*wz*wx+c[7])/c[1];
+          d[6] = ((c[0]-c[1])*wx*wy+c[8])/c[2];
+          d[7] = x[10]; d[8] = x[11]; d[9] = x[12];
+          const double fx{c[3]},fy{c[4]},fz{c[5]};
+          d[10] = (1.0-2.0*(q2*q2+q3*q3))*fx+2.0*(q1*q2-q0*q3)*fy+2.0*(q1*q3+q0*q2)*fz;
+          d[11] = 2.0*(q1*q2+q0*q3)*fx+(1.0-2.0*(q1*q1+q3*q3))*fy+2.0*(q2*q3-q0*q1)*fz;
+          d[12] = 2.0*(q1*q3-q0*q2)*fx+2.0*(q2*q3+q0*q1)*fy+(1.0-2.0*(q1*q1+q2*q2))*fz+g;
+     }
+
+     void rk4_ref(double * x,const double * c,const double g,const double dt,const int32_t nsteps)
+     {
+          double k1[13],k2[13],k3[13],k4[13],y[13];
+          for(int32_t __s{0}; __s != nsteps; ++__s)
+          {
+               rhs(x,c,g,k1);
+               for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+0.5*dt*k1[__i];
+               rhs(y,c,g,k2);
+               for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+0.5*dt*k2[__i];
+               rhs(y,c,g,k3);
+               for(int32_t __i{0}; __i != 13; ++__i) y[__i] = x[__i]+dt*k3[__i];
+               rhs(y,c,g,k4);
+               for(int32_t __i{0}; __i != 13; ++__i) x[__i] += dt/6.0*(k1[__i]+2.0*k2[__i]+2.0*k3[__i]+k4[__i]);
+               const double nq{std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]+x[3]*x[3])};
+               for(int32_t __i{0}; __i != 4; ++__i) x[__i] /= nq;
+          }
+     }
+
+     // v_ned = q*v_b*conj(q)
+     void qrot(const double * q,const double * v,double * o)
+     {
+          const double t[3] = {2.0*(q[2]*v[2]-q[3]*v[1]),2.0*(q[3]*v[0]-q[1]*v[2]),2.0*(q[1]*v[1]-q[2]*v[0])};
+          o[0] = v[0]+q[0]*t[0]+q[2]*t[2]-q[3]*t[1];
+          o[1] = v[1]+q[0]*t[1]+q[3]*t[0]-q[1]*t[2];
+          o[2] = v[2]+q[0]*t[2]+q[1]*t[1]-q[2]*t[0];
+     }
+
+     void random_bodies(Bodies & B,const uint32_t seed,const bool loads)
+     {
+          std::mt19937 g(seed);
+          std::normal_distribution<double> nd(0.0,1.0);
+          std::uniform_real_distribution<double> ud(-1.0,1.0);
+          std::uniform_real_distribution<double> ui(1.0,10.0);
+          for(int32_t __b{0}; __b != 16*B.n; ++__b)
+          {
+               double x[22];
+               double q[4] = {nd(g),nd(g),nd(g),nd(g)};
+               const double nq{std::sqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3])};
+               for(int32_t __i{0}; __i != 4; ++__i) x[__i] = q[__i]/nq;
+               for(int32_t __i{4}; __i != 7; ++__i)  x[__i] = ud(g);
+               for(int32_t __i{7}; __i != 10; ++__i) x[__i] = 1000.0*ud(g);
+               for(int32_t __i{10}; __i != 13; ++__i) x[__i] = 100.0*ud(g);
+               for(int32_t __i{13}; __i != 16; ++__i) x[__i] = ui(g);
+               for(int32_t __i{16}; __i != 22; ++__i) x[__i] = loads ? 5.0*ud(g) : 0.0;
+               B.set(__b,x);
+          }
+     }
+
+}
+
+void unit_test_rb6dof_against_reference();
+
+void unit_test_rb6dof_against_reference()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t n{8};
+     Bodies B(n);
+     random_bodies(B,5050,true);
+     std::vector<double> x0(16*n*22);
+     for(int32_t __b{0}; __b != 16*n; ++__b) B.get(__b,&x0[22*__b]);
+     RB6DofState s{B.state()};
+     const RB6DofLoads l{B.loads()};
+     RB6DofParams p;
+     p.dt = 0.005f;
+     p.renorm_every = 1;
+     const int32_t nsteps{400};
+     rb6dof_propagate_zmm16r4(s,l,p,nsteps,n,nullptr,nullptr);
+     if(s.nstep != nsteps) test_fail(__PRETTY_FUNCTION__);
+     double eq{0.0},ew{0.0},ep{0.0},ev{0.0};
+     for(int32_t __b{0}; __b != 16*n; ++__b)
+     {
+          double * x{&x0[22*__b]};
+          rk4_ref(x,x+13,static_cast<double>(p.g),static_cast<double>(p.dt),nsteps);
+          double y[22];
+          B.get(__b,y);
+          // q and -q are the same attitude, but RK4 does not flip the sign
+          for(int32_t __i{0}; __i != 4; ++__i)   eq = std::max(eq,std::abs(y[__i]-x[__i]));
+          for(int32_t __i{4}; __i != 7; ++__i)   ew = std::max(ew,std::abs(y[__i]-x[__i]));
+          for(int32_t __i{7}; __i != 10; ++__i)  ep = std::max(ep,std::abs(y[__i]-x[__i]));
+          for(int32_t __i{10}; __i != 13; ++__i) ev = std::max(ev,std::abs(y[__i]-x[__i]));
+     }
+     printf("after %d steps of %g s: max. |dq| %.2e, |dw| %.2e rad/s, |dp| %.2e m, |dv| %.2e m/s\n",
+            nsteps,static_cast<double>(p.dt),eq,ew,ep,ev);
+     if(eq > 2.0e-5 || ew > 5.0e-5 || ep > 5.0e-4 || ev > 5.0e-4) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_rb6dof_invariants();
+
+void unit_test_rb6dof_invariants()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t n{2};
+     Bodies B(n);
+     random_bodies(B,5151,false);
+     // register 0: axisymmetric ix = iy = 1, iz = 2, w = (0.3,0,w3); register 1: triaxial, torque-free
+     for(int32_t __b{0}; __b != 16; ++__b)
+     {
+          double x[22];
+          B.get(__b,x);
+          x[4] = 0.3; x[5] = 0.0; x[6] = 0.5+0.1*__b;
+          x[13] = 1.0; x[14] = 1.0; x[15] = 2.0;
+          B.set(__b,x);
+     }
+     std::vector<double> H0(16*3),T0(16);
+     auto momentum = [&](const int32_t b,double * H,double & T) {
+          double x[22];
+          B.get(b,x);
+          const double Jw[3] = {x[13]*x[4],x[14]*x[5],x[15]*x[6]};
+          qrot(x,Jw,H);
+          T = 0.5*(Jw[0]*x[4]+Jw[1]*x[5]+Jw[2]*x[6]);
+     };
+     for(int32_t __b{16}; __b != 32; ++__b) momentum(__b,&H0[3*(__b-16)],T0[__b-16]);
+     RB6DofState s{B.state()};
+     const RB6DofLoads l{B.loads()};
+     RB6DofParams p;
+     p.dt = 0.01f;
+     const int32_t nsteps{1000};
+     rb6dof_propagate_zmm16r4(s,l,p,nsteps,n,nullptr,nullptr);
+     const double t{static_cast<double>(nsteps)*static_cast<double>(p.dt)};
+     double enu{0.0},eH{0.0},eT{0.0},eqn{0.0};
+     for(int32_t __b{0}; __b != 16; ++__b)
+     {
+          double x[22];
+          B.get(__b,x);
+          const double W{0.5+0.1*__b};   // (iz-ix)/ix*w3
+          enu = std::max(enu,std::max(std::abs(x[4]-0.3*std::cos(W*t)),std::abs(x[5]-0.3*std::sin(W*t))));
+          enu = std::max(enu,std::abs(x[6]-W));
+     }
+     for(int32_t __b{16}; __b != 32; ++__b)
+     {
+          double H[3],T;
+          momentum(__b,H,T);
+          const double * h0{&H0[3*(__b-16)]};
+          const double nh{std::sqrt(h0[0]*h0[0]+h0[1]*h0[1]+h0[2]*h0[2])};
+          eH = std::max(eH,std::sqrt((H[0]-h0[0])*(H[0]-h0[0])+(H[1]-h0[1])*(H[1]-h0[1])+(H[2]-h0[2])*(H[2]-h0[2]))/nh);
+          eT = std::max(eT,std::abs(T-T0[__b-16])/T0[__b-16]);
+     }
+     for(int32_t __b{0}; __b != 32; ++__b)
+     {
+          double x[22];
+          B.get(__b,x);
+          eqn = std::max(eqn,std::abs(std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]+x[3]*x[3])-1.0));
+     }
+     printf("t=%g s: nutation error %.2e rad/s, |dH|/|H| %.2e, |dT|/T %.2e, ||q|-1| %.2e\n",t,enu,eH,eT,eqn);
+     if(enu > 1.0e-4 || eH > 1.0e-4 || eT > 1.0e-4 || eqn > 1.0e-6) test_fail(__PRETTY_FUNCTION__);
+     // thrust along the body x of a non-rotating body: p = p0+v0*t+(R*f+g)*t^2/2
+     Bodies C(1);
+     random_bodies(C,5252,false);
+     std::vector<double> y0(16*22);
+     for(int32_t __b{0}; __b != 16; ++__b)
+     {
+          double x[22];
+          C.get(__b,x);
+          x[4] = x[5] = x[6] = 0.0;
+          x[16] = 20.0+__b; x[17] = x[18] = 0.0;
+          C.set(__b,x);
+          C.get(__b,&y0[22*__b]);
+     }
+     RB6DofState sc{C.state()};
+     rb6dof_propagate_zmm16r4(sc,C.loads(),p,200,1,nullptr,nullptr);
+     double ep{0.0};
+     for(int32_t __b{0}; __b != 16; ++__b)
+     {
+          const double * x{&y0[22*__b]};
+          double a[3];
+          qrot(x,x+16,a);
+          a[2] += static_cast<double>(p.g);
+          double y[22];
+          C.get(__b,y);
+          const double T{200.0*static_cast<double>(p.dt)};
+          for(int32_t __i{0}; __i != 3; ++__i)
+               ep = std::max(ep,std::abs(y[7+__i]-(x[7+__i]+x[10+__i]*T+0.5*a[__i]*T*T)));
+     }
+     printf("thrusting body, t=2 s: max. |dp| %.2e m\n",ep);
+     if(ep > 2.0e-3) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_rb6dof_rmat_los_determinism();
+
+void unit_test_rb6dof_rmat_los_determinism()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t n{64};
+     Bodies A(n),B2(n);
+     random_bodies(A,5353,true);
+     random_bodies(B2,5353,true);
+     // outputs
+     std::vector<__m512> r[9],o[8];
+     for(auto & v : r) v.assign(n,_mm512_setzero_ps());
+     for(auto & v : o) v.assign(n,_mm512_setzero_ps());
+     RB6DofRMat9x16 m{r[0].data(),r[1].data(),r[2].data(),r[3].data(),r[4].data(),r[5].data(),r[6].data(),r[7].data(),r[8].data()};
+     std::vector<__m512> tn(n),te(n),td(n);
+     std::mt19937 g(5454);
+     std::uniform_real_distribution<float> ut(-5000.0f,5000.0f);
+     for(int32_t __i{0}; __i != n; ++__i)
+          for(int32_t __l{0}; __l != 16; ++__l) { lane(&tn[__i],__l) = ut(g); lane(&te[__i],__l) = ut(g); lane(&td[__i],__l) = ut(g); }
+     RB6DofLOS los;
+     los.tn = tn.data(); los.te = te.data(); los.td = td.data();
+     los.tgt[0] = los.tgt[1] = los.tgt[2] = 0.0f;
+     los.ux = o[0].data(); los.uy = o[1].data(); los.uz = o[2].data();
+     los.tht = o[3].data(); los.phi = o[4].data(); los.az = o[5].data(); los.el = o[6].data(); los.rng = o[7].data();
+     RB6DofParams p;
+     p.dt = 0.01f;
+     p.renorm_every = 7;
+     // serial, 25+35 steps (the second call in the renormalization phase 25)
+     RB6DofState sa{A.state()};
+     rb6dof_propagate_range_zmm16r4(sa,A.loads(),p,25,0,n,nullptr,nullptr);
+     sa.nstep = 25;
+     rb6dof_propagate_range_zmm16r4(sa,A.loads(),p,35,0,n,&m,&los);
+     // team, 25+35 steps
+     gms::common::par_team_start();
+     gms::common::par_set_threshold(gms::common::par_family::SERIES,1);
+     gms::common::par_set_threshold(gms::common::par_family::ARITH,1);
+     RB6DofState sb{B2.state()};
+     rb6dof_propagate_zmm16r4(sb,B2.loads(),p,25,n,nullptr,nullptr);
+     rb6dof_propagate_zmm16r4(sb,B2.loads(),p,35,n,nullptr,nullptr);
+     printf("team of %d workers against the serial range kernel\n",gms::common::par_team_size());
+     if(sb.nstep != 60) test_fail(__PRETTY_FUNCTION__);
+     for(int32_t __k{0}; __k != 13; ++__k)
+          if(std::memcmp(A.a[__k].data(),B2.a[__k].data(),sizeof(__m512)*n) != 0) test_fail(__PRETTY_FUNCTION__);
+     gms::common::par_team_stop();
+     // the matrices of the final state
+     std::vector<__m512> r2[9];
+     for(auto & v : r2) v.assign(n,_mm512_setzero_ps());
+     RB6DofRMat9x16 m2{r2[0].data(),r2[1].data(),r2[2].data(),r2[3].data(),r2[4].data(),r2[5].data(),r2[6].data(),r2[7].data(),r2[8].data()};
+     rb6dof_rmat9x16_zmm16r4(sb,n,m2);
+     for(int32_t __k{0}; __k != 9; ++__k)
+          if(std::memcmp(r[__k].data(),r2[__k].data(),sizeof(__m512)*n) != 0) test_fail(__PRETTY_FUNCTION__);
+     double eo{0.0},ed{0.0},er{0.0},eu{0.0},ea{0.0},erg{0.0};
+     for(int32_t __b{0}; __b != 16*n; ++__b)
+     {
+          const int32_t i{__b/16},l{__b%16};
+          double R[9],x[22];
+          for(int32_t __k{0}; __k != 9; ++__k) R[__k] = lane(&r[__k][i],l);
+          A.get(__b,x);
+          const double nq{std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]+x[3]*x[3])};
+          for(int32_t __k{0}; __k != 4; ++__k) x[__k] /= nq;
+          // R*R^T = I
+          for(int32_t __a{0}; __a != 3; ++__a)
+               for(int32_t __c{0}; __c != 3; ++__c)
+               {
+                    const double d{R[3*__a]*R[3*__c]+R[3*__a+1]*R[3*__c+1]+R[3*__a+2]*R[3*__c+2]};
+                    eo = std::max(eo,std::abs(d-((__a == __c) ? 1.0 : 0.0)));
+               }
+          const double det{R[0]*(R[4]*R[8]-R[5]*R[7])-R[1]*(R[3]*R[8]-R[5]*R[6])+R[2]*(R[3]*R[7]-R[4]*R[6])};
+          ed = std::max(ed,std::abs(det-1.0));
+          // columns = q*e_k*conj(q)
+          for(int32_t __c{0}; __c != 3; ++__c)
+          {
+               double e[3] = {0.0,0.0,0.0},v[3];
+               e[__c] = 1.0;
+               qrot(x,e,v);
+               for(int32_t __a{0}; __a != 3; ++__a) er = std::max(er,std::abs(v[__a]-R[3*__a+__c]));
+          }
+          // LOS: d = t-p in NED, u = R^T*d/|d|
+          const double d[3] = {lane(&tn[i],l)-x[7],lane(&te[i],l)-x[8],lane(&td[i],l)-x[9]};
+          const double rg{std::sqrt(d[0]*d[0]+d[1]*d[1]+d[2]*d[2])};
+          double u[3];
+          for(int32_t __c{0}; __c != 3; ++__c) u[__c] = (R[__c]*d[0]+R[3+__c]*d[1]+R[6+__c]*d[2])/rg;
+          eu  = std::max(eu,std::max(std::abs(u[0]-lane(&o[0][i],l)),std::max(std::abs(u[1]-lane(&o[1][i],l)),std::abs(u[2]-lane(&o[2][i],l)))));
+          erg = std::max(erg,std::abs(rg-lane(&o[7][i],l))/rg);
+          const double tht{std::acos(std::min(std::max(u[2],-1.0),1.0))},phi{std::atan2(u[1],u[0])};
+          const double el{std::asin(std::min(std::max(-u[2],-1.0),1.0))};
+          // the reconstructed unit vector of (tht,phi)
+          const double ft{lane(&o[3][i],l)},fp{lane(&o[4][i],l)};
+          const double w[3] = {std::sin(ft)*std::cos(fp),std::sin(ft)*std::sin(fp),std::cos(ft)};
+          ea = std::max(ea,std::max(std::abs(w[0]-u[0]),std::max(std::abs(w[1]-u[1]),std::abs(w[2]-u[2]))));
+          ea = std::max(ea,std::max(std::abs(ft-tht),std::abs(lane(&o[6][i],l)-el)));
+          if(std::sin(tht) > 1.0e-2) ea = std::max(ea,std::min(std::abs(fp-phi),2.0*M_PI-std::abs(fp-phi)));
+          if(lane(&o[5][i],l) != fp) test_fail(__PRETTY_FUNCTION__);
+     }
+     printf("|R*R^T-I| %.2e, |det-1| %.2e, |R*e-q*e*q'| %.2e, |u| %.2e, rel. range %.2e, angles %.2e rad\n",eo,ed,er,eu,erg,ea);
+     if(eo > 1.0e-6 || ed > 1.0e-6 || er > 1.0e-6 || eu > 1.0e-4 || erg > 1.0e-6 || ea > 2.0e-3) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_rb6dof_against_reference();
+    unit_test_rb6dof_invariants();
+    unit_test_rb6dof_rmat_los_determinism();
+    return 0;
+}
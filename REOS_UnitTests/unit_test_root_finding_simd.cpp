@@ -0,0 +1,245 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_config.h"
+#include "GMS_root_finding_simd.hpp"
+
+/*
+   icpc -o unit_test_root_finding_simd -O3 -fp-model precise -ftz -std=c++17 -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_root_finding_simd.hpp unit_test_root_finding_simd.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_root_finding_simd.hpp unit_test_root_finding_simd.cpp
+
+   The three methods on one vector of problems (x^3+p*x-q, a different p, q per
+   lane, __m256d and __m512) against the root refined in long double; the array
+   driver on Kepler's equation E-e*sin(E)-M (eccentricity and mean anomaly per
+   problem) against a scalar Newton iteration in long double; lanes without a
+   sign change get ROOT_NO_BRACKET, the lanes out of iterations ROOT_MAXITER.
+   Every problem of the array driver is bitwise the result of the same problem
+   solved in a block, whichever lane and round it was refilled into.
+*/
+
+namespace {
+
+     using namespace gms::math;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     // root of x^3+p*x-q, p > 0 (monotone)
+     long double ref_cubic(const long double p,const long double q)
+     {
+          long double lo{-10.0L},hi{10.0L};
+          for(int32_t __i{0}; __i != 200; ++__i)
+          {
+               const long double m{0.5L*(lo+hi)};
+               if(m*m*m+p*m-q < 0.0L) lo = m; else hi = m;
+          }
+          return (0.5L*(lo+hi));
+     }
+
+     long double ref_kepler(const long double e,const long double M)
+     {
+          long double E{M+e*std::sin(M)};
+          for(int32_t __i{0}; __i != 60; ++__i)
+               E -= (E-e*std::sin(E)-M)/(1.0L-e*std::cos(E));
+          return (E);
+     }
+
+     inline void load_v(const double * p,__m256d & v) { v = _mm256_loadu_pd(p); }
+     inline void load_v(const float * p,__m512 & v)   { v = _mm512_loadu_ps(p); }
+
+     template<typename L>
+     struct cubic_f
+     {
+          typedef root_simd_traits<L> S;
+          typedef typename S::V V;
+          V p,q;
+          V operator()(const V x) const
+          {
+               return (S::sub(S::mul(x,S::add(S::mul(x,x),p)),q));
+          }
+          V operator()(const V x,V & df) const
+          {
+               typedef typename S::T T;
+               df = S::add(S::mul(S::set1(T(3)),S::mul(x,x)),p);
+               return (S::sub(S::mul(x,S::add(S::mul(x,x),p)),q));
+          }
+     };
+
+     template<typename L>
+     void check_block(const char * name,const double tol_x)
+     {
+          typedef root_simd_traits<L> S;
+          typedef typename S::V V;
+          typedef typename S::T T;
+          constexpr int32_t NL{S::lanes};
+          alignas(64) T p[NL],q[NL],a[NL],b[NL],x0[NL],xr[NL],fr[NL],it[NL];
+          std::mt19937 g(47);
+          std::uniform_real_distribution<T> up(T(0.1),T(4)),uq(T(-20),T(20));
+          for(int32_t __l{0}; __l != NL; ++__l) { p[__l] = up(g); q[__l] = uq(g); a[__l] = T(-4); b[__l] = T(4); x0[__l] = T(0.5); }
+          // lanes 1,2: f(a) = 0, f(b) = 0
+          p[1] = T(1); q[1] = T(-2); a[1] = T(-1);
+          p[2] = T(1); q[2] = T(10); b[2] = T(2);
+          // lane 3: no sign change
+          a[3] = T(5); b[3] = T(6);
+          cubic_f<L> f;
+          load_v(p,f.p);
+          load_v(q,f.q);
+          root_tol_t tol;
+          tol.xtol = (sizeof(T) == 8) ? 1.0e-13 : 1.0e-6;
+          tol.rtol = (sizeof(T) == 8) ? 4.0e-15 : 2.0e-7;
+          V va,vb,vx0;
+          load_v(a,va);
+          load_v(b,vb);
+          load_v(x0,vx0);
+          for(int32_t __m{0}; __m != 3; ++__m)
+          {
+               root_block_t<L> r;
+               if(__m == 0) r = root_brentq_simd<L>(f,va,vb,tol);
+               else if(__m == 1) r = root_newton_simd<L>(f,va,vb,vx0,tol);
+               else r = root_illinois_simd<L>(f,va,vb,tol);
+               S::store(xr,r.x); S::store(fr,r.fx); S::store(it,r.iters);
+               const char * mname[3] = {"brentq","newton","illinois"};
+               double err{0.0},maxit{0.0};
+               for(int32_t __l{0}; __l != NL; ++__l)
+               {
+                    const bool nb{((S::bits(r.no_bracket) >> __l) & 1u) != 0u};
+                    if(nb != (__l == 3)) test_fail(__PRETTY_FUNCTION__);
+                    if(nb) continue;
+                    if(((S::bits(r.maxiter) >> __l) & 1u) != 0u) test_fail(__PRETTY_FUNCTION__);
+                    const long double ref{ref_cubic(p[__l],q[__l])};
+                    err   = std::max(err,static_cast<double>(std::abs(xr[__l]-ref)/std::max(1.0L,std::abs(ref))));
+                    maxit = std::max(maxit,static_cast<double>(it[__l]));
+                    // f(x) is the residual at x
+                    const long double xl{xr[__l]};
+                    const T fx{static_cast<T>(xl*xl*xl+p[__l]*xl-q[__l])};
+                    if(std::abs(fx-fr[__l]) > T(1.0e4)*std::numeric_limits<T>::epsilon()) test_fail(__PRETTY_FUNCTION__);
+               }
+               if(xr[1] != T(-1) || xr[2] != T(2) || it[1] != T(0) || it[2] != T(0)) test_fail(__PRETTY_FUNCTION__);
+               printf("%s, %-8s: max. rel. error %g, max. iterations %g\n",name,mname[__m],err,maxit);
+               if(err > tol_x) test_fail(__PRETTY_FUNCTION__);
+          }
+     }
+
+}
+
+void unit_test_root_finding_simd_block();
+
+void unit_test_root_finding_simd_block()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     check_block<root_ymm4r8>("__m256d",1.0e-13);
+     check_block<root_zmm16r4>("__m512 ",1.0e-6);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_root_finding_simd_array();
+
+void unit_test_root_finding_simd_array()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     constexpr int32_t n{1003};
+     std::vector<double> e(n),M(n),a(n),b(n),x0(n),x(n),fx(n);
+     std::vector<int32_t> st(n),it(n);
+     std::mt19937 g(470);
+     std::uniform_real_distribution<double> ue(0.0,0.99),uM(0.0,2.0*M_PI);
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+          e[__i]  = ue(g);
+          M[__i]  = uM(g);
+          // E in [M-e, M+e]
+          a[__i]  = M[__i]-1.0;
+          b[__i]  = M[__i]+1.0;
+          x0[__i] = M[__i]+e[__i]*std::sin(M[__i]);
+          if(__i%101 == 7) { a[__i] = M[__i]+1.5; b[__i] = M[__i]+2.5; }     // no sign change
+     }
+     // idx -- the problem of every lane, e and M gathered
+     auto kep   = [&](const __m256d E,const __m128i idx)
+     {
+          const __m256d ve{_mm256_i32gather_pd(e.data(),idx,8)},vM{_mm256_i32gather_pd(M.data(),idx,8)};
+          alignas(32) double s[4];
+          _mm256_store_pd(s,E);
+          for(int32_t __l{0}; __l != 4; ++__l) s[__l] = std::sin(s[__l]);
+          return (_mm256_sub_pd(_mm256_sub_pd(E,_mm256_mul_pd(ve,_mm256_load_pd(s))),vM));
+     };
+     auto kepdf = [&](const __m256d E,const __m128i idx,__m256d & df)
+     {
+          const __m256d ve{_mm256_i32gather_pd(e.data(),idx,8)},vM{_mm256_i32gather_pd(M.data(),idx,8)};
+          alignas(32) double s[4],c[4];
+          _mm256_store_pd(s,E);
+          for(int32_t __l{0}; __l != 4; ++__l) { c[__l] = std::cos(s[__l]); s[__l] = std::sin(s[__l]); }
+          df = _mm256_sub_pd(_mm256_set1_pd(1.0),_mm256_mul_pd(ve,_mm256_load_pd(c)));
+          return (_mm256_sub_pd(_mm256_sub_pd(E,_mm256_mul_pd(ve,_mm256_load_pd(s))),vM));
+     };
+     root_tol_t tol;
+     tol.xtol = 1.0e-14;
+     tol.rtol = 4.0e-15;
+     const char * mname[3] = {"brentq","newton","illinois"};
+     for(int32_t __m{0}; __m != 3; ++__m)
+     {
+          std::fill(st.begin(),st.end(),99);
+          int32_t nbad{0};
+          if(__m == 0)      nbad = root_solve_array<root_ymm4r8,root_method_t::BRENTQ>(kep,a.data(),b.data(),nullptr,x.data(),fx.data(),st.data(),it.data(),n,tol);
+          else if(__m == 1) nbad = root_solve_array<root_ymm4r8,root_method_t::NEWTON>(kepdf,a.data(),b.data(),x0.data(),x.data(),fx.data(),st.data(),it.data(),n,tol);
+          else              nbad = root_solve_array<root_ymm4r8,root_method_t::ILLINOIS>(kep,a.data(),b.data(),nullptr,x.data(),fx.data(),st.data(),it.data(),n,tol);
+          double err{0.0};
+          int32_t nnb{0},maxit{0};
+          for(int32_t __i{0}; __i != n; ++__i)
+          {
+               const int32_t want{(__i%101 == 7) ? ROOT_NO_BRACKET : ROOT_OK};
+               if(st[__i] != want) test_fail(__PRETTY_FUNCTION__);
+               if(want != ROOT_OK) { ++nnb; continue; }
+               err   = std::max(err,static_cast<double>(std::abs(x[__i]-ref_kepler(e[__i],M[__i]))));
+               maxit = std::max(maxit,it[__i]);
+          }
+          if(nbad != nnb) test_fail(__PRETTY_FUNCTION__);
+          // the same problems in blocks of 4 (lanes of the block form)
+          for(int32_t __i{0}; __i < n; __i += 17)
+          {
+               alignas(32) int32_t id[4] = {__i,__i,__i,__i};
+               const __m128i vid{_mm_load_si128(reinterpret_cast<const __m128i*>(id))};
+               auto f1  = [&](const __m256d E) { return (kep(E,vid)); };
+               auto f1d = [&](const __m256d E,__m256d & df) { return (kepdf(E,vid,df)); };
+               const __m256d va{_mm256_set1_pd(a[__i])},vb{_mm256_set1_pd(b[__i])};
+               root_block_t<root_ymm4r8> r;
+               if(__m == 0) r = root_brentq_simd<root_ymm4r8>(f1,va,vb,tol);
+               else if(__m == 1) r = root_newton_simd<root_ymm4r8>(f1d,va,vb,_mm256_set1_pd(x0[__i]),tol);
+               else r = root_illinois_simd<root_ymm4r8>(f1,va,vb,tol);
+               alignas(32) double xb[4];
+               _mm256_store_pd(xb,r.x);
+               if(st[__i] == ROOT_OK && std::memcmp(&xb[0],&x[__i],sizeof(double)) != 0) test_fail(__PRETTY_FUNCTION__);
+          }
+          printf("Kepler, %-8s: %d problems, %d without sign change, max. error %g, max. iterations %d\n",mname[__m],n,nnb,err,maxit);
+          if(err > 1.0e-13) test_fail(__PRETTY_FUNCTION__);
+     }
+     // out of iterations
+     tol.maxiter = 2;
+     const int32_t nbad{root_solve_array<root_ymm4r8,root_method_t::ILLINOIS>(kep,a.data(),b.data(),nullptr,x.data(),fx.data(),st.data(),it.data(),n,tol)};
+     int32_t nmax{0};
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+          if(st[__i] == ROOT_MAXITER) { ++nmax; if(it[__i] != 2) test_fail(__PRETTY_FUNCTION__); }
+          else if(st[__i] == ROOT_OK && it[__i] > 2) test_fail(__PRETTY_FUNCTION__);
+     }
+     printf("maxiter = 2: %d of %d problems ROOT_MAXITER\n",nmax,n);
+     if(nmax == 0 || nbad < nmax) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_root_finding_simd_block();
+    unit_test_root_finding_simd_array();
+    return 0;
+}
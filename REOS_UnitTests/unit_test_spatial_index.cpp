@@ -0,0 +1,242 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "GMS_config.h"
+#include "GMS_spatial_index.h"
+#include <string>
+using std::string; // GMS_triangulation.h expects it
+#include "GMS_triangulation.h"
+
+/*
+   icpc -o unit_test_spatial_index -fp-model precise -no-fma -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_spatial_index.h GMS_spatial_index.cpp GMS_triangulation.h GMS_triangulation.cpp unit_test_spatial_index.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_spatial_index.h GMS_spatial_index.cpp unit_test_spatial_index.cpp
+
+   The k-d tree and the grid are checked against points_point_near_naive_nd (nearest point,
+   lowest index on ties) and a brute force k-nearest/radius search, the triangle locator
+   against triangulation_search_naive.
+*/
+
+// clustered points with duplicates, a regular lattice part (equal distances) and outliers
+static void unit_test_points(std::vector<double> & p,const int32_t dim,const int32_t n,std::mt19937_64 & rng)
+{
+       std::uniform_real_distribution<double> u(-1.0,1.0);
+       p.resize(static_cast<std::size_t>(dim)*n);
+       for(int32_t __j{0}; __j != n; ++__j)
+       {
+           for(int32_t __d{0}; __d != dim; ++__d)
+           {
+               double x;
+               if(__j%5 == 0)      x = 0.125*std::floor(8.0*u(rng));     // lattice
+               else if(__j%7 == 0) x = 0.05*u(rng)+0.5;                 // cluster
+               else                x = u(rng);
+               p[static_cast<std::size_t>(dim)*__j+__d] = x;
+           }
+           if(__j%11 == 3 && __j > 0)
+              for(int32_t __d{0}; __d != dim; ++__d) // duplicate
+                  p[static_cast<std::size_t>(dim)*__j+__d] = p[static_cast<std::size_t>(dim)*(__j-1)+__d];
+       }
+}
+
+static double unit_test_d2(const double * a,const double * b,const int32_t dim)
+{
+       double d{0.0};
+       for(int32_t __d{0}; __d != dim; ++__d) d += (a[__d]-b[__d])*(a[__d]-b[__d]);
+       return d;
+}
+
+void unit_test_kdtree_grid();
+
+void unit_test_kdtree_grid()
+{
+     using namespace gms::math;
+     std::mt19937_64 rng(20261019ULL);
+     constexpr int32_t n{20000};
+     constexpr int32_t nq{2000};
+     constexpr int32_t k{7};
+     constexpr double r{0.09};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(const int32_t dim : {2,3,5})
+     {
+         std::vector<double> p,q;
+         unit_test_points(p,dim,n,rng);
+         unit_test_points(q,dim,nq,rng);
+         for(std::size_t __i{0}; __i < q.size(); __i += 97) q[__i] *= 3.0; // outside the set
+         for(int32_t __i{0}; __i != 50; ++__i) // queries on set points
+             for(int32_t __d{0}; __d != dim; ++__d) q[dim*__i+__d] = p[dim*(37*__i)+__d];
+         KDTree t;
+         UniformGrid g;
+         if(!kdtree_build(t,dim,n,p.data()) || (dim <= 3 && !grid_build(g,dim,n,p.data(),0.0)))
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, build dim=%d" ANSI_RESET_ALL "\n",dim);
+            std::exit(EXIT_FAILURE);
+         }
+         std::vector<int32_t> ki(static_cast<std::size_t>(nq)*k), gi(nq), offs(nq+1), goffs(nq+1);
+         std::vector<double>  kd(static_cast<std::size_t>(nq)*k), gd(nq);
+         kdtree_knn_batch_omp(t,nq,q.data(),k,ki.data(),kd.data());
+         int32_t * __restrict kr{kdtree_radius_batch_omp(t,nq,q.data(),r,offs.data())};
+         int32_t * __restrict gr{nullptr};
+         if(dim <= 3)
+         {
+            grid_nearest_batch_omp(g,nq,q.data(),gi.data(),gd.data());
+            gr = grid_radius_batch_omp(g,nq,q.data(),r,goffs.data());
+         }
+         int32_t nerr{0};
+         for(int32_t __i{0}; __i != nq && nerr < 5; ++__i)
+         {
+             const double * qi{&q[dim*__i]};
+             double dn;
+             // the GMS_triangulation version is 1-based, GMS_geometry (and the index) 0-based
+             const int32_t in{points_point_near_naive_nd(dim,n,p.data(),const_cast<double*>(qi),&dn)-1};
+             // brute force k nearest, (distance,index) order
+             std::vector<std::pair<double,int32_t>> all(n);
+             for(int32_t __j{0}; __j != n; ++__j) all[__j] = {unit_test_d2(qi,&p[dim*__j],dim),__j};
+             std::partial_sort(all.begin(),all.begin()+k,all.end());
+             std::vector<int32_t> rin;
+             for(int32_t __j{0}; __j != n; ++__j) if(all[__j].first <= r*r) rin.push_back(all[__j].second);
+             bool ok{ki[k*__i] == in && std::fabs(kd[k*__i]-dn) <= 1.0e-15};
+             for(int32_t __j{0}; __j != k; ++__j)
+                 ok = ok && (ki[k*__i+__j] == all[__j].second) && (std::fabs(kd[k*__i+__j]-std::sqrt(all[__j].first)) <= 1.0e-15);
+             std::vector<int32_t> kk(kr+offs[__i],kr+offs[__i+1]);
+             std::sort(kk.begin(),kk.end());
+             std::sort(rin.begin(),rin.end());
+             ok = ok && (kk == rin);
+             if(dim <= 3)
+             {
+                std::vector<int32_t> gg(gr+goffs[__i],gr+goffs[__i+1]);
+                std::sort(gg.begin(),gg.end());
+                ok = ok && (gi[__i] == in) && (std::fabs(gd[__i]-dn) <= 1.0e-15) && (gg == rin);
+             }
+             if(!ok)
+             {
+                printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, dim=%d query %d: naive=%d (%.17g), kd=%d (%.17g), grid=%d (%.17g), radius %zu/%d/%d" ANSI_RESET_ALL "\n",
+                       dim,__i,in,dn,ki[k*__i],kd[k*__i],gi[__i],gd[__i],rin.size(),offs[__i+1]-offs[__i],
+                       (dim <= 3) ? goffs[__i+1]-goffs[__i] : -1);
+                fail = true;
+                ++nerr;
+             }
+         }
+         printf("dim=%d: n=%d, queries=%d, k-d tree nodes=%d, radius hits=%d\n",dim,n,nq,t.nnodes,offs[nq]);
+         delete [] kr;
+         if(gr != nullptr) {delete [] gr; grid_free(g);}
+         kdtree_free(t);
+     }
+     // drop-in wrappers
+     {
+         std::vector<double> p,q;
+         unit_test_points(p,2,3000,rng);
+         unit_test_points(q,2,500,rng);
+         q[2*17] = p[2*41]; q[2*17+1] = p[2*41+1];
+         int32_t * __restrict near{points_points_near_kdtree_2d(3000,p.data(),500,q.data())};
+         bool * __restrict avoid{new bool[500]};
+         points_avoid_point_grid_2d(3000,p.data(),500,q.data(),avoid);
+         for(int32_t __i{0}; __i != 500; ++__i)
+         {
+             double dn;
+             const int32_t in{points_point_near_naive_nd(2,3000,p.data(),&q[2*__i],&dn)-1};
+             const bool naive_avoid{dn >= 100.0*DBL_EPSILON};
+             if(near[__i] != in || avoid[__i] != naive_avoid)
+             {
+                printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, points_points_near_kdtree_2d/points_avoid_point_grid_2d query %d" ANSI_RESET_ALL "\n",__i);
+                fail = true;
+                break;
+             }
+         }
+         if(avoid[17]) {printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, points_avoid_point_grid_2d" ANSI_RESET_ALL "\n"); fail = true;}
+         delete [] avoid;
+         delete [] near;
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: kdtree/grid nearest, knn, radius -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_trilocator();
+
+void unit_test_trilocator()
+{
+     using namespace gms::math;
+     constexpr int32_t nx{120};
+     constexpr int32_t ny{90};
+     constexpr int32_t np{20000};
+     std::mt19937_64 rng(7ULL);
+     std::uniform_real_distribution<double> u(0.0,1.0);
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // jittered structured triangulation, order 3 and order 6 (midside nodes appended)
+     std::vector<double> xy;
+     for(int32_t __j{0}; __j != ny; ++__j)
+         for(int32_t __i{0}; __i != nx; ++__i)
+         {
+             const bool edge{__i == 0 || __j == 0 || __i == nx-1 || __j == ny-1};
+             xy.push_back(static_cast<double>(__i)+(edge ? 0.0 : 0.3*(u(rng)-0.5)));
+             xy.push_back(0.5*static_cast<double>(__j)+(edge ? 0.0 : 0.15*(u(rng)-0.5)));
+         }
+     std::vector<int32_t> t3,t6;
+     for(int32_t __j{0}; __j != ny-1; ++__j)
+         for(int32_t __i{0}; __i != nx-1; ++__i)
+         {
+             const int32_t a{__j*nx+__i};
+             t3.insert(t3.end(),{a,a+1,a+nx+1, a,a+nx+1,a+nx});
+             t6.insert(t6.end(),{a,a+1,a+nx+1,0,0,0, a,a+nx+1,a+nx,0,0,0});
+         }
+     const int32_t ntri{static_cast<int32_t>(t3.size()/3)};
+     const int32_t nnode{nx*ny};
+     std::vector<double> p(2*np);
+     for(int32_t __i{0}; __i != np; ++__i)
+     {
+         p[2*__i]   = -3.0+(nx+5.0)*u(rng);
+         p[2*__i+1] = -2.0+(0.5*ny+3.0)*u(rng);
+     }
+     for(int32_t __i{0}; __i != 200; ++__i) // on the nodes and the edge midpoints
+     {
+         const int32_t a{(__i*131)%nnode};
+         p[2*__i]   = xy[2*a];
+         p[2*__i+1] = xy[2*a+1];
+         if(__i%2 == 1 && a+1 < nnode) {p[2*__i] = 0.5*(xy[2*a]+xy[2*a+2]); p[2*__i+1] = 0.5*(xy[2*a+1]+xy[2*a+3]);}
+     }
+     for(const int32_t order : {3,6})
+     {
+         int32_t * tn{(order == 3) ? t3.data() : t6.data()};
+         TriLocator l;
+         if(!trilocator_build(l,nnode,xy.data(),order,ntri,tn))
+         {
+            printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, trilocator_build" ANSI_RESET_ALL "\n");
+            std::exit(EXIT_FAILURE);
+         }
+         std::vector<int32_t> ti(np);
+         trilocator_search_batch_omp(l,np,p.data(),ti.data());
+         int32_t inside{0};
+         for(int32_t __i{0}; __i != np; ++__i)
+         {
+             const int32_t ref{triangulation_search_naive(nnode,xy.data(),order,ntri,tn,&p[2*__i])};
+             inside += (ref > 0);
+             if(ti[__i] != ref)
+             {
+                printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, order %d point (%.17g,%.17g): naive=%d, locator=%d" ANSI_RESET_ALL "\n",
+                       order,p[2*__i],p[2*__i+1],ref,ti[__i]);
+                fail = true;
+                break;
+             }
+         }
+         printf("order %d: triangles=%d, cells=%dx%d, slots=%d, points inside=%d/%d\n",order,ntri,l.nc[0],l.nc[1],l.nslots,inside,np);
+         trilocator_free(l);
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: trilocator_search -- PASSED!!" ANSI_RESET_ALL "\n");}
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+int main()
+{
+    unit_test_kdtree_grid();
+    unit_test_trilocator();
+    return 0;
+}
@@ -8,8 +8,12 @@
 #include "GMS_stat_containers_ymm4r8.h"
 
 /*
-   icpc -o unit_test_stat_containers_ymm4r8 -std=c++17 -fp-model fast=2 -fno-exceptions -qopt-zmm-usage=high -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
-   GMS_config.h GMS_malloc.h  GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_simd_utils.h GMS_complex_ymm4r8.h GMS_stat_containers_ymm4r8.h unit_test_stat_containers_ymm4r8.cpp
+   icpc -o unit_test_stat_containers_ymm4r8 -std=c++17 -fp-model fast=2 -fno-exceptions -qopt-zmm-usage=high -qopenmp -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h \
+   GMS_memops_dispatch.h GMS_memops_dispatch.cpp GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp \
+   GMS_sse_memcpy.h GMS_sse_memcpy.cpp GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp \
+   GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_simd_utils.h GMS_complex_ymm4r8.h GMS_stat_containers_ymm4r8.h unit_test_stat_containers_ymm4r8.cpp
    ASM: 
    icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -fno-exceptions -falign-functions=32 -qopt-zmm-usage=high \ 
    GMS_config.h GMS_malloc.h GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp GMS_simd_utils.h GMS_complex_ymm4r8.h GMS_stat_containers_ymm4r8.h unit_test_stat_containers_ymm4r8.cpp
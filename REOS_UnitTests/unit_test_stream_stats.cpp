@@ -0,0 +1,262 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include "GMS_config.h"
+#include "GMS_stream_stats.h"
+#include "GMS_par_team.h"
+
+/*
+   icpc -o unit_test_stream_stats -O3 -fp-model precise -ftz -std=c++17 -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_par_team.h GMS_par_team.cpp GMS_stream_stats.h GMS_stream_stats.cpp unit_test_stream_stats.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -falign-functions=32 \
+   GMS_config.h GMS_stream_stats.h GMS_stream_stats.cpp
+
+   A lognormal sample with a large offset (the naive sum of powers loses all
+   digits there) of a length which is not a multiple of the chunk or of the
+   vector: the moments against two passes in long double, the summary of 7
+   unequal pieces merged (also through serialize/deserialize) against the
+   summary of the whole, float data against its double copy, the quantiles
+   of the t-digest against the order statistics of the sorted sample within
+   the rank error of the compression (tighter at the tails), the histogram
+   against scalar binning, NaN and +-inf counted apart from the moments of
+   the finite values, and the team-parallel summary against the serial.
+*/
+
+namespace {
+
+     using namespace gms::stat;
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     std::vector<double> sample(const std::size_t n,const uint32_t seed)
+     {
+          std::mt19937_64 g(seed);
+          std::lognormal_distribution<double> d(0.0,0.75);
+          std::vector<double> x(n);
+          for(std::size_t __i{0}; __i != n; ++__i) x[__i] = 1.0e6+d(g);
+          return (x);
+     }
+
+     bool rel_ok(const double a,const double b,const double tol)
+     {
+          return (std::abs(a-b) <= tol*std::max(std::abs(b),1.0e-300));
+     }
+
+     // rank error of the quantile q: |rank(x_q)/n - q|, the rank by the sorted sample
+     double rank_err(const std::vector<double> & s,const double v,const double q)
+     {
+          const double lo{static_cast<double>(std::lower_bound(s.begin(),s.end(),v)-s.begin())};
+          const double hi{static_cast<double>(std::upper_bound(s.begin(),s.end(),v)-s.begin())};
+          const double r{q*static_cast<double>(s.size())};
+          const double e{(r < lo) ? lo-r : ((r > hi) ? r-hi : 0.0)};
+          return (e/static_cast<double>(s.size()));
+     }
+
+}
+
+void unit_test_stream_stats_moments_merge();
+
+void unit_test_stream_stats_moments_merge()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t n{1000003};
+     const std::vector<double> x{sample(n,49)};
+     stream_summary_t all(200.0,1.0e6,1.0e6+8.0,64);
+     all.add(x.data(),n);
+     const stream_stats_t s{all.stats()};
+     long double m{0.0L};
+     for(double v : x) m += v;
+     m /= static_cast<long double>(n);
+     long double m2{0.0L},m3{0.0L},m4{0.0L};
+     for(double v : x) { const long double d{v-m}; m2 += d*d; m3 += d*d*d; m4 += d*d*d*d; }
+     const double dn{static_cast<double>(n)};
+     const double var{static_cast<double>(m2)/(dn-1.0)};
+     const double skew{std::sqrt(dn)*static_cast<double>(m3/(m2*std::sqrt(m2)))};
+     const double kurt{dn*static_cast<double>(m4/(m2*m2))};
+     printf("mean %.9f (%.9f), var %.9f (%.9f), skew %.9f (%.9f), kurt %.9f (%.9f)\n",
+            s.mean,static_cast<double>(m),s.var,var,s.skew,skew,s.kurt,kurt);
+     if(!rel_ok(s.mean,static_cast<double>(m),1.0e-15) || !rel_ok(s.var,var,1.0e-10) ||
+        !rel_ok(s.skew,skew,1.0e-8) || !rel_ok(s.kurt,kurt,1.0e-8)) test_fail(__PRETTY_FUNCTION__);
+     if(s.n != n || s.min != *std::min_element(x.begin(),x.end()) || s.max != *std::max_element(x.begin(),x.end()) ||
+        s.range != s.max-s.min || s.mid != 0.5*(s.min+s.max)) test_fail(__PRETTY_FUNCTION__);
+     // 7 unequal pieces, every other through a byte buffer
+     const std::size_t cut[8] = {0,1,17,4096,100000,100001,777777,n};
+     stream_summary_t mrg(200.0,1.0e6,1.0e6+8.0,64);
+     for(int32_t __p{0}; __p != 7; ++__p)
+     {
+          stream_summary_t part(200.0,1.0e6,1.0e6+8.0,64);
+          part.add(x.data()+cut[__p],cut[__p+1]-cut[__p]);
+          if(__p&1)
+          {
+             std::vector<unsigned char> b(part.serialized_size());
+             if(part.serialize(b.data()) != b.size()) test_fail(__PRETTY_FUNCTION__);
+             stream_summary_t rcv;
+             if(!rcv.deserialize(b.data(),b.size()) || rcv.deserialize(b.data(),b.size()-1)) test_fail(__PRETTY_FUNCTION__);
+             if(!mrg.merge(rcv)) test_fail(__PRETTY_FUNCTION__);
+          }
+          else if(!mrg.merge(part)) test_fail(__PRETTY_FUNCTION__);
+     }
+     const stream_stats_t t{mrg.stats()};
+     printf("merged: mean %.9f, var %.9f, skew %.9f, kurt %.9f, median %.6f (%.6f), midmean %.6f (%.6f)\n",
+            t.mean,t.var,t.skew,t.kurt,t.med,s.med,t.midm,s.midm);
+     if(!rel_ok(t.mean,s.mean,1.0e-15) || !rel_ok(t.var,s.var,1.0e-10) || !rel_ok(t.skew,s.skew,1.0e-8) ||
+        !rel_ok(t.kurt,s.kurt,1.0e-8) || t.n != n || t.min != s.min || t.max != s.max) test_fail(__PRETTY_FUNCTION__);
+     for(int32_t __b{-1}; __b <= 64; ++__b)
+     {
+          const uint64_t a{(__b < 0) ? all.hist.underflow() : ((__b == 64) ? all.hist.overflow() : all.hist.bin(__b))};
+          const uint64_t c{(__b < 0) ? mrg.hist.underflow() : ((__b == 64) ? mrg.hist.overflow() : mrg.hist.bin(__b))};
+          if(a != c) test_fail(__PRETTY_FUNCTION__);
+     }
+     // a summary of other binning or of other compression is not merged
+     stream_summary_t other(200.0,0.0,1.0,64);
+     if(mrg.merge(other)) test_fail(__PRETTY_FUNCTION__);
+     stream_summary_t coarse(100.0,1.0e6,1.0e6+8.0,64);
+     coarse.add(x.data(),1000);
+     if(mrg.merge(coarse) || mrg.mom.n != n || mrg.dig.merge(coarse.dig)) test_fail(__PRETTY_FUNCTION__);
+     // float data against its double copy
+     std::vector<float> xf(n);
+     std::vector<double> xd(n);
+     for(std::size_t __i{0}; __i != n; ++__i) { xf[__i] = static_cast<float>(x[__i]-1.0e6); xd[__i] = static_cast<double>(xf[__i]); }
+     stream_summary_t sf,sd;
+     sf.add(xf.data(),n);
+     sd.add(xd.data(),n);
+     const stream_stats_t u{sf.stats()},v{sd.stats()};
+     if(u.mean != v.mean || u.var != v.var || u.kurt != v.kurt || u.med != v.med || u.midm != v.midm) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_stream_stats_quantiles_hist();
+
+void unit_test_stream_stats_quantiles_hist()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t n{500009};
+     std::vector<double> x{sample(n,4949)};
+     for(double & v : x) v -= 1.0e6;
+     // a few NaN: underflow of the histogram, not ranked
+     x[7] = x[70001] = std::numeric_limits<double>::quiet_NaN();
+     stream_summary_t s(200.0,0.0,6.0,48);
+     s.add(x.data(),n);
+     s.dig.flush();
+     std::vector<double> srt;
+     for(double v : x) if(v == v) srt.push_back(v);
+     std::sort(srt.begin(),srt.end());
+     if(s.dig.n != srt.size() || s.dig.min != srt.front() || s.dig.max != srt.back()) test_fail(__PRETTY_FUNCTION__);
+     printf("centroids: %zu (compression %g)\n",s.dig.centroids(),s.dig.delta);
+     if(s.dig.centroids() > static_cast<std::size_t>(s.dig.delta)) test_fail(__PRETTY_FUNCTION__);
+     const double qs[] = {1.0e-4,1.0e-3,0.01,0.05,0.1,0.25,0.5,0.75,0.9,0.95,0.99,0.999,0.9999};
+     for(double q : qs)
+     {
+          const double v{s.dig.quantile(q)};
+          const double e{rank_err(srt,v,q)};
+          // k1: centroids of at most pi/delta*sqrt(q(1-q))*n samples
+          const double tol{3.14159265358979/s.dig.delta*std::sqrt(q*(1.0-q))+0.5/static_cast<double>(srt.size())};
+          printf("q=%-7g  x=%12.6f  sorted %12.6f  rank error %.2e (tol %.2e)\n",q,v,
+                 srt[static_cast<std::size_t>(q*static_cast<double>(srt.size()))],e,tol);
+          if(e > tol) test_fail(__PRETTY_FUNCTION__);
+          if(std::abs(s.dig.cdf(v)-q) > tol) test_fail(__PRETTY_FUNCTION__);
+     }
+     if(s.dig.quantile(0.0) != srt.front() || s.dig.quantile(1.0) != srt.back()) test_fail(__PRETTY_FUNCTION__);
+     // midmean as loc(): the mean of the sorted quartiles 1..3
+     double mm{0.0};
+     const std::size_t q1{srt.size()/4},q3{srt.size()-srt.size()/4};
+     for(std::size_t __i{q1}; __i != q3; ++__i) mm += srt[__i];
+     mm /= static_cast<double>(q3-q1);
+     const stream_stats_t t{s.stats()};
+     printf("midmean %.6f (%.6f), median %.6f (%.6f)\n",t.midm,mm,t.med,srt[srt.size()/2]);
+     if(std::abs(t.midm-mm) > 1.0e-3*mm) test_fail(__PRETTY_FUNCTION__);
+     // histogram against scalar binning
+     std::vector<uint64_t> ref(50,0ULL);
+     for(double v : x)
+     {
+          if(!(v >= 0.0))    ++ref[0];
+          else if(v >= 6.0)  ++ref[49];
+          else ++ref[1+std::min(static_cast<int32_t>(v*8.0),47)];
+     }
+     if(s.hist.underflow() != ref[0] || s.hist.overflow() != ref[49]) test_fail(__PRETTY_FUNCTION__);
+     for(int32_t __b{0}; __b != 48; ++__b) if(s.hist.bin(__b) != ref[__b+1]) test_fail(__PRETTY_FUNCTION__);
+     // small samples are exact
+     tdigest_t d;
+     d.init(100.0);
+     const double v5[5] = {5.0,1.0,4.0,2.0,3.0};
+     d.add(v5,5);
+     d.flush();
+     if(d.centroids() != 5 || d.quantile(0.5) != 3.0 || d.quantile(0.0) != 1.0 || d.quantile(1.0) != 5.0) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_stream_stats_nonfinite();
+
+void unit_test_stream_stats_nonfinite()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t n{100003};
+     std::vector<double> x{sample(n,4040)};
+     for(double & v : x) v -= 1.0e6;
+     const double inf{std::numeric_limits<double>::infinity()};
+     // scattered, and a whole chunk of +inf
+     x[3] = inf; x[7000] = -inf; x[60000] = std::numeric_limits<double>::quiet_NaN();
+     for(std::size_t __i{2*STREAM_STATS_CHUNK}; __i != 3*STREAM_STATS_CHUNK; ++__i) x[__i] = inf;
+     std::vector<double> fin;
+     for(double v : x) if(std::isfinite(v)) fin.push_back(v);
+     const uint64_t nnf{static_cast<uint64_t>(n-fin.size())};
+     stream_summary_t s(200.0,0.0,6.0,48),f(200.0,0.0,6.0,48);
+     s.add(x.data(),n);
+     f.add(fin.data(),fin.size());
+     const stream_stats_t a{s.stats()},b{f.stats()};
+     printf("non-finite %llu: mean %.9f (%.9f), var %.9f (%.9f), median %.6f (%.6f)\n",
+            static_cast<unsigned long long>(a.nonfinite),a.mean,b.mean,a.var,b.var,a.med,b.med);
+     if(a.nonfinite != nnf || a.n != fin.size() || b.nonfinite != 0ULL || !rel_ok(a.mean,b.mean,1.0e-13) ||
+        !rel_ok(a.var,b.var,1.0e-10) || !rel_ok(a.kurt,b.kurt,1.0e-8) || a.min != b.min || a.max != b.max ||
+        s.dig.n != fin.size() || a.med != b.med) test_fail(__PRETTY_FUNCTION__);
+     // -inf and NaN to the underflow, +inf to the overflow
+     if(s.hist.underflow() != f.hist.underflow()+2ULL || s.hist.overflow() != f.hist.overflow()+nnf-2ULL) test_fail(__PRETTY_FUNCTION__);
+     // the count survives the byte buffer and the merge
+     std::vector<unsigned char> buf(s.serialized_size());
+     stream_summary_t r(200.0,0.0,6.0,48);
+     if(s.serialize(buf.data()) != buf.size() || !r.deserialize(buf.data(),buf.size()) || r.mom.nonfinite != nnf) test_fail(__PRETTY_FUNCTION__);
+     stream_summary_t e(200.0,0.0,6.0,48);
+     const double nan1{std::numeric_limits<double>::quiet_NaN()};
+     e.add(&nan1,1);
+     if(!e.merge(r) || e.mom.nonfinite != nnf+1ULL || e.mom.n != fin.size() || e.mom.mean != r.mom.mean) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_stream_stats_par();
+
+void unit_test_stream_stats_par()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::size_t n{2000001};
+     const std::vector<double> x{sample(n,494949)};
+     stream_summary_t ser,par;
+     ser.add(x.data(),n);
+     gms::common::par_team_start();
+     stream_stats_par(x.data(),n,par);
+     const stream_stats_t a{ser.stats()},b{par.stats()};
+     printf("team of %d: mean %.9f (%.9f), var %.9f (%.9f), median %.6f (%.6f)\n",gms::common::par_team_size(),
+            b.mean,a.mean,b.var,a.var,b.med,a.med);
+     if(b.n != n || !rel_ok(b.mean,a.mean,1.0e-15) || !rel_ok(b.var,a.var,1.0e-10) || !rel_ok(b.kurt,a.kurt,1.0e-8) ||
+        b.min != a.min || b.max != a.max || std::abs(par.dig.cdf(b.med)-0.5) > 2.0e-3) test_fail(__PRETTY_FUNCTION__);
+     gms::common::par_team_stop();
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_stream_stats_moments_merge();
+    unit_test_stream_stats_quantiles_hist();
+    unit_test_stream_stats_nonfinite();
+    unit_test_stream_stats_par();
+    return 0;
+}
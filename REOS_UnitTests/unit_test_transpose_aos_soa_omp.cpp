@@ -0,0 +1,188 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <complex>
+#include "GMS_transpose_aos_soa_omp.h"
+#include "GMS_malloc.h"
+
+/*
+   icpc -o unit_test_transpose_aos_soa_omp -fp-model fast=2 -qopenmp -qopt-zmm-usage=high -ftz -ggdb -ipo -march=skylake-avx512 -mavx512f -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_malloc.h GMS_avx512_transposition_16x16.h GMS_avx512_transposition_16x16.cpp GMS_memops_dispatch.h GMS_memops_dispatch.cpp \
+   GMS_sse_memset.h GMS_sse_memset.cpp GMS_setv_avx512_unroll16x.h GMS_setv_avx512_unroll16x.cpp GMS_sse_memcpy.h GMS_sse_memcpy.cpp \
+   GMS_sse_uncached_memcpy.h GMS_sse_uncached_memcpy.cpp GMS_avx_memcpy.h GMS_avx_memcpy.cpp GMS_avx_uncached_memcpy.h GMS_avx_uncached_memcpy.cpp \
+   GMS_avx512_memcpy.h GMS_avx512_memcpy.cpp GMS_avx512_uncached_memcpy.h GMS_avx512_uncached_memcpy.cpp \
+   GMS_transpose_aos_soa_omp.h GMS_transpose_aos_soa_omp.cpp unit_test_transpose_aos_soa_omp.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -mavx512f -qopenmp -falign-functions=32 -qopt-zmm-usage=high \
+   GMS_config.h GMS_malloc.h GMS_transpose_aos_soa_omp.h GMS_transpose_aos_soa_omp.cpp unit_test_transpose_aos_soa_omp.cpp
+*/
+
+void unit_test_transpose_r4_omp();
+
+void unit_test_transpose_r4_omp()
+{
+     using namespace gms::math;
+     using namespace gms::common;
+     // shapes straddle the tile size, the recursion leaf and the task/OpenMP thresholds
+     constexpr std::size_t shapes[][2] = {{1ULL,1ULL},{1ULL,37ULL},{7ULL,5ULL},{16ULL,16ULL},{17ULL,33ULL},
+                                          {64ULL,65ULL},{129ULL,63ULL},{300ULL,211ULL},{1031ULL,517ULL},
+                                          {1035ULL,603ULL}}; // ldb%16 == 0, large enough to stream
+     constexpr std::size_t maxn{1035ULL*603ULL+64ULL};
+     float * __restrict__ A{reinterpret_cast<float*>(gms_mm_malloc(maxn*sizeof(float),64ULL))};
+     float * __restrict__ B{reinterpret_cast<float*>(gms_mm_malloc(maxn*sizeof(float),64ULL))};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(const auto & s : shapes)
+     {
+         const std::size_t rows{s[0]};
+         const std::size_t cols{s[1]};
+         const std::size_t lda{cols+3ULL}; // padded leading dimensions
+         const std::size_t ldb{rows+5ULL};
+         if(rows*lda > maxn || cols*ldb > maxn) continue;
+         for(std::size_t __i{0ULL}; __i != maxn; ++__i) {A[__i] = static_cast<float>(__i); B[__i] = -1.0f;}
+         transpose_r4_omp(&A[0],lda,&B[0],ldb,rows,cols);
+         for(std::size_t __j{0ULL}; __j != cols && !fail; ++__j)
+         {
+             for(std::size_t __i{0ULL}; __i != ldb; ++__i)
+             {
+                  const float ref{(__i < rows) ? A[__i*lda+__j] : -1.0f}; // padding must be left untouched
+                  if(B[__j*ldb+__i] != ref)
+                  {
+                       printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, rows=%llu, cols=%llu, found value of %.7f at (%llu,%llu), but expected: %.7f" ANSI_RESET_ALL "\n",
+                              rows,cols,B[__j*ldb+__i],__j,__i,ref);
+                       fail = true;
+                       break;
+                  }
+             }
+         }
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: transpose_r4_omp -- PASSED!!" ANSI_RESET_ALL "\n");}
+     gms_mm_free(B);
+     gms_mm_free(A);
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_transpose_r4_ip_omp();
+
+void unit_test_transpose_r4_ip_omp()
+{
+     using namespace gms::math;
+     using namespace gms::common;
+     constexpr std::size_t sizes[] = {2ULL,15ULL,16ULL,31ULL,64ULL,65ULL,127ULL,257ULL,1029ULL};
+     constexpr std::size_t rects[][2] = {{3ULL,7ULL},{33ULL,17ULL},{600ULL,451ULL}};
+     constexpr std::size_t maxn{1029ULL*1031ULL};
+     float * __restrict__ A{reinterpret_cast<float*>(gms_mm_malloc(maxn*sizeof(float),64ULL))};
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(const std::size_t n : sizes)
+     {
+         const std::size_t ld{n+2ULL};
+         for(std::size_t __i{0ULL}; __i != n*ld; ++__i) {A[__i] = static_cast<float>(__i);}
+         transpose_r4_ip_omp(&A[0],ld,n);
+         for(std::size_t __i{0ULL}; __i != n && !fail; ++__i)
+         {
+             for(std::size_t __j{0ULL}; __j != ld; ++__j)
+             {
+                  const float ref{static_cast<float>((__j < n) ? __j*ld+__i : __i*ld+__j)};
+                  if(A[__i*ld+__j] != ref)
+                  {
+                       printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, n=%llu, found value of %.7f at (%llu,%llu), but expected: %.7f" ANSI_RESET_ALL "\n",
+                              n,A[__i*ld+__j],__i,__j,ref);
+                       fail = true;
+                       break;
+                  }
+             }
+         }
+     }
+     for(const auto & s : rects)
+     {
+         const std::size_t rows{s[0]};
+         const std::size_t cols{s[1]};
+         for(std::size_t __i{0ULL}; __i != rows*cols; ++__i) {A[__i] = static_cast<float>(__i);}
+         transpose_r4_ip_rect_omp(&A[0],rows,cols);
+         for(std::size_t __j{0ULL}; __j != cols*rows; ++__j)
+         {
+              const std::size_t c{__j/rows};
+              const std::size_t r{__j%rows};
+              if(A[__j] != static_cast<float>(r*cols+c))
+              {
+                   printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, rect %llux%llu, found value of %.7f at pos: %llu" ANSI_RESET_ALL "\n",
+                          rows,cols,A[__j],__j);
+                   fail = true;
+                   break;
+              }
+         }
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: transpose_r4_ip_omp -- PASSED!!" ANSI_RESET_ALL "\n");}
+     gms_mm_free(A);
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_aos_soa_r4_omp();
+
+void unit_test_aos_soa_r4_omp()
+{
+     using namespace gms::math;
+     using namespace gms::common;
+     // n straddles the 16-record permute blocks, the parallel block size and the streaming threshold
+     constexpr std::size_t sizes[] = {1ULL,15ULL,17ULL,4099ULL,1048583ULL};
+     constexpr std::size_t comps[] = {1ULL,2ULL,3ULL,4ULL,7ULL};
+     constexpr std::size_t offs[]  = {0ULL,1ULL}; // misaligns the SoA arrays (in floats)
+     constexpr std::size_t maxn{1048583ULL};
+     constexpr std::size_t maxk{7ULL};
+     float * __restrict__ aos{reinterpret_cast<float*>(gms_mm_malloc((maxk*maxn+16ULL)*sizeof(float),64ULL))};
+     float * __restrict__ back{reinterpret_cast<float*>(gms_mm_malloc((maxk*maxn+16ULL)*sizeof(float),64ULL))};
+     float * __restrict__ soa_buf{reinterpret_cast<float*>(gms_mm_malloc(maxk*(maxn+32ULL)*sizeof(float),64ULL))};
+     float * soa[maxk];
+     bool fail{false};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     for(std::size_t __i{0ULL}; __i != maxk*maxn+16ULL; ++__i) {aos[__i] = static_cast<float>(__i)+0.25f;}
+     for(const std::size_t off : offs)
+     {
+         for(const std::size_t k : comps)
+         {
+             for(const std::size_t n : sizes)
+             {
+                  for(std::size_t c{0ULL}; c != k; ++c) {soa[c] = &soa_buf[c*(maxn+32ULL)+off];}
+                  std::memset(back,0,(k*n+2ULL)*sizeof(float));
+                  aos_to_soa_r4_omp(&aos[off],k,&soa[0],n);
+                  for(std::size_t __i{0ULL}; __i != n && !fail; ++__i)
+                  {
+                      for(std::size_t c{0ULL}; c != k; ++c)
+                      {
+                          if(soa[c][__i] != aos[off+__i*k+c])
+                          {
+                               printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, aos->soa k=%llu, n=%llu, off=%llu, found value of %.7f at (%llu,%llu)" ANSI_RESET_ALL "\n",
+                                      k,n,off,soa[c][__i],c,__i);
+                               fail = true;
+                               break;
+                          }
+                      }
+                  }
+                  soa_to_aos_r4_omp(&soa[0],k,&back[off],n);
+                  if(std::memcmp(&back[off],&aos[off],k*n*sizeof(float)) != 0 || back[off+k*n] != 0.0f)
+                  {
+                       printf(ANSI_COLOR_RED "[UNIT-TEST]: FAILED, soa->aos k=%llu, n=%llu, off=%llu -- round trip mismatch" ANSI_RESET_ALL "\n",
+                              k,n,off);
+                       fail = true;
+                  }
+             }
+         }
+     }
+     if(fail==false) {printf(ANSI_COLOR_GREEN "[UNIT-TEST]: aos_to_soa/soa_to_aos_r4_omp -- PASSED!!" ANSI_RESET_ALL "\n");}
+     gms_mm_free(soa_buf);
+     gms_mm_free(back);
+     gms_mm_free(aos);
+     printf("[UNIT-TEST]: %s ---> ENDED CORRECTLY\n", __PRETTY_FUNCTION__);
+}
+
+
+
+int main()
+{
+
+    unit_test_transpose_r4_omp();
+    unit_test_transpose_r4_ip_omp();
+    unit_test_aos_soa_r4_omp();
+    return 0;
+}
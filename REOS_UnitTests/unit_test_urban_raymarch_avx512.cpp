@@ -0,0 +1,276 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_config.h"
+#include "GMS_urban_raymarch_avx512.h"
+
+/*
+   icpc -o unit_test_urban_raymarch_avx512 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   GMS_config.h GMS_urban_raymarch_avx512.h GMS_urban_raymarch_avx512.cpp unit_test_urban_raymarch_avx512.cpp
+   ASM:
+   icpc -S -fverbose-asm -masm=intel  -march=skylake-avx512 -qopenmp -falign-functions=32 \
+   GMS_config.h GMS_urban_raymarch_avx512.h GMS_urban_raymarch_avx512.cpp unit_test_urban_raymarch_avx512.cpp
+
+   Synthetic city (street grid, 8x8 cell lots of random height). The max-mipmap march is checked
+   against the scalar cell by cell traversal, the reflections against the scalar image method
+   and against closed form points on an empty map and on a single wall.
+*/
+
+namespace {
+
+     constexpr int32_t city_n{256};
+     constexpr float   city_dx{2.0f};
+
+     std::vector<float> city_map(const uint64_t seed)
+     {
+          std::mt19937_64 rng(seed);
+          std::uniform_real_distribution<float> uh(6.0f,60.0f);
+          std::vector<float> h(static_cast<std::size_t>(city_n)*city_n,0.0f);
+          for(int32_t __i{0}; __i < city_n; __i += 8)
+              for(int32_t __j{0}; __j < city_n; __j += 8)
+              {
+                  if((__i%40) >= 32 || (__j%40) >= 32) continue; // streets
+                  const float lot{uh(rng)};
+                  for(int32_t __y{__i}; __y != std::min(__i+8,city_n); ++__y)
+                      for(int32_t __x{__j}; __x != std::min(__j+8,city_n); ++__x)
+                          if((__y%40) < 32 && (__x%40) < 32) h[__y*city_n+__x] = lot;
+              }
+          return (h);
+     }
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+}
+
+void unit_test_urban_hmap_mip_build();
+
+void unit_test_urban_hmap_mip_build()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     // odd sizes exercise the partial blocks
+     const int32_t nx{213}, ny{77};
+     std::mt19937_64 rng(11ULL);
+     std::uniform_real_distribution<float> u(0.0f,100.0f);
+     std::vector<float> h(static_cast<std::size_t>(nx)*ny);
+     for(float & v : h) v = u(rng);
+     UrbanHMapMip_t m;
+     if(urban_hmap_mip_build(h.data(),nx,ny,1.0f,1.0f,m) != 0) test_fail(__PRETTY_FUNCTION__);
+     bool fail{m.nlev != 9 || m.lnx[m.nlev-1] != 1 || m.lny[m.nlev-1] != 1};
+     for(int32_t __l{0}; __l != m.nlev && !fail; ++__l)
+         for(int32_t __i{0}; __i != m.lny[__l]; ++__i)
+             for(int32_t __j{0}; __j != m.lnx[__l]; ++__j)
+             {
+                 float mx{-1.0f};
+                 for(int32_t __y{__i<<__l}; __y < std::min((__i+1)<<__l,ny); ++__y)
+                     for(int32_t __x{__j<<__l}; __x < std::min((__j+1)<<__l,nx); ++__x)
+                         mx = std::max(mx,h[__y*nx+__x]);
+                 if(m.buf[m.base[__l]+__i*m.lnx[__l]+__j] != mx) fail = true;
+             }
+     urban_hmap_mip_free(m);
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_urban_los_zmm16r4();
+
+void unit_test_urban_los_zmm16r4()
+{
+     using namespace gms::radiolocation;
+     constexpr int32_t nbatch{20000};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::vector<float> h{city_map(3ULL)};
+     UrbanHMapMip_t m;
+     if(urban_hmap_mip_build(h.data(),city_n,city_n,city_dx,city_dx,m) != 0) test_fail(__PRETTY_FUNCTION__);
+     std::mt19937_64 rng(5ULL);
+     const float ext{city_n*city_dx};
+     std::uniform_real_distribution<float> ux(-0.1f*ext,1.1f*ext);
+     std::uniform_real_distribution<float> uz(0.5f,120.0f);
+     int32_t nvis{0}, nmis{0}, nth{0};
+     for(int32_t __b{0}; __b != nbatch; ++__b)
+     {
+         alignas(64) float o[3][16], e[3][16];
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             o[0][__k] = ux(rng); o[1][__k] = ux(rng); o[2][__k] = uz(rng);
+             e[0][__k] = ux(rng); e[1][__k] = ux(rng); e[2][__k] = (__k & 1) ? 1.5f : uz(rng);
+             if(__k == 15) { e[0][__k] = o[0][__k]; } // axis parallel rays
+             if(__k == 14) { e[1][__k] = o[1][__k]; }
+         }
+         __m512 th;
+         const __mmask16 vis{urban_los_zmm16r4(m,_mm512_load_ps(o[0]),_mm512_load_ps(o[1]),_mm512_load_ps(o[2]),
+                                               _mm512_load_ps(e[0]),_mm512_load_ps(e[1]),_mm512_load_ps(e[2]),th)};
+         alignas(64) float tv[16];
+         _mm512_store_ps(tv,th);
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             const float oo[3] = {o[0][__k],o[1][__k],o[2][__k]};
+             const float ee[3] = {e[0][__k],e[1][__k],e[2][__k]};
+             float tr;
+             const bool ref{urban_los_r4(m,oo,ee,&tr)};
+             const bool v{((vis >> __k) & 1) != 0};
+             nvis += ref;
+             if(v != ref) { ++nmis; continue; }
+             if(std::fabs(tv[__k]-tr) > 1.0e-3f) ++nth;
+         }
+     }
+     const int32_t nt{16*nbatch};
+     printf("rays=%d visible=%d, visibility mismatch=%d, |t_hit-t_ref|>1e-3: %d\n",nt,nvis,nmis,nth);
+     urban_hmap_mip_free(m);
+     // grazing rays only
+     if(nvis < nt/10 || nvis > 9*nt/10 || nmis > nt/20000 || nth > nt/5000) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_urban_reflect_zmm16r4();
+
+void unit_test_urban_reflect_zmm16r4()
+{
+     using namespace gms::radiolocation;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     const float ext{city_n*city_dx};
+     // closed form: empty map, and a single wall x = 300 m (cells 150..159, 40 m high)
+     {
+        std::vector<float> h(static_cast<std::size_t>(city_n)*city_n,0.0f);
+        for(int32_t __i{100}; __i != 160; ++__i)
+            for(int32_t __j{150}; __j != 160; ++__j) h[__i*city_n+__j] = 40.0f;
+        UrbanHMapMip_t m;
+        urban_hmap_mip_build(h.data(),city_n,city_n,city_dx,city_dx,m);
+        const float t[3] = {100.0f,250.0f,30.0f};
+        const float r[3] = {200.0f,270.0f,2.0f};
+        UrbanRefl_zmm16r4_t v;
+        urban_reflect_zmm16r4(m,_mm512_set1_ps(t[0]),_mm512_set1_ps(t[1]),_mm512_set1_ps(t[2]),
+                              _mm512_set1_ps(r[0]),_mm512_set1_ps(r[1]),_mm512_set1_ps(r[2]),0.0f,v);
+        alignas(64) float px[16], py[16], pz[16], pl[16];
+        // ground: s = 30/32 from t
+        _mm512_store_ps(px,v.px[UREFL__GROUND]); _mm512_store_ps(py,v.py[UREFL__GROUND]); _mm512_store_ps(pl,v.len[UREFL__GROUND]);
+        fail = fail || v.valid[UREFL__GROUND] != 0xFFFF || std::fabs(px[0]-193.75f) > 1.0e-3f || std::fabs(py[0]-268.75f) > 1.0e-3f ||
+               std::fabs(pl[0]-std::sqrt(100.0f*100.0f+20.0f*20.0f+32.0f*32.0f)) > 1.0e-2f;
+        // wall x = 300 m facing -x: image of t at x = 500, s = (300-200)/(500-200) from r
+        _mm512_store_ps(px,v.px[UREFL__WALL_XN]); _mm512_store_ps(py,v.py[UREFL__WALL_XN]);
+        _mm512_store_ps(pz,v.pz[UREFL__WALL_XN]); _mm512_store_ps(pl,v.len[UREFL__WALL_XN]);
+        fail = fail || v.valid[UREFL__WALL_XN] != 0xFFFF || std::fabs(px[0]-300.0f) > 1.0e-2f ||
+               std::fabs(py[0]-(270.0f-20.0f/3.0f)) > 1.0e-3f || std::fabs(pz[0]-(2.0f+28.0f/3.0f)) > 1.0e-3f ||
+               std::fabs(pl[0]-std::sqrt(300.0f*300.0f+20.0f*20.0f+28.0f*28.0f)) > 1.0e-2f;
+        fail = fail || v.valid[UREFL__WALL_XP] != 0 || v.valid[UREFL__WALL_YN] != 0 || v.valid[UREFL__WALL_YP] != 0;
+        if(fail) printf("closed form reflections -- mismatch\n");
+        urban_hmap_mip_free(m);
+     }
+     // city: vector versus scalar
+     const std::vector<float> h{city_map(9ULL)};
+     UrbanHMapMip_t m;
+     urban_hmap_mip_build(h.data(),city_n,city_n,city_dx,city_dx,m);
+     std::mt19937_64 rng(17ULL);
+     std::uniform_real_distribution<float> ux(0.0f,ext);
+     constexpr int32_t nbatch{4000};
+     int32_t nval[UREFL__COUNT] = {0,0,0,0,0}, nmis{0}, npt{0};
+     for(int32_t __b{0}; __b != nbatch; ++__b)
+     {
+         const float t[3] = {ux(rng),ux(rng),70.0f};
+         alignas(64) float r[3][16];
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             // street receivers
+             do
+             {
+                r[0][__k] = ux(rng);
+                r[1][__k] = ux(rng);
+             } while(h[static_cast<int32_t>(r[1][__k]/city_dx)*city_n+static_cast<int32_t>(r[0][__k]/city_dx)] > 0.0f);
+             r[2][__k] = 1.5f;
+         }
+         UrbanRefl_zmm16r4_t v;
+         urban_reflect_zmm16r4(m,_mm512_set1_ps(t[0]),_mm512_set1_ps(t[1]),_mm512_set1_ps(t[2]),
+                               _mm512_load_ps(r[0]),_mm512_load_ps(r[1]),_mm512_load_ps(r[2]),0.0f,v);
+         alignas(64) float px[UREFL__COUNT][16], py[UREFL__COUNT][16], pz[UREFL__COUNT][16];
+         for(int32_t __c{0}; __c != UREFL__COUNT; ++__c)
+         {
+             _mm512_store_ps(px[__c],v.px[__c]);
+             _mm512_store_ps(py[__c],v.py[__c]);
+             _mm512_store_ps(pz[__c],v.pz[__c]);
+         }
+         for(int32_t __k{0}; __k != 16; ++__k)
+         {
+             const float rr[3] = {r[0][__k],r[1][__k],r[2][__k]};
+             UrbanReflPts_t ref;
+             urban_reflect_r4(m,t,rr,0.0f,ref);
+             for(int32_t __c{0}; __c != UREFL__COUNT; ++__c)
+             {
+                 const bool a{((v.valid[__c] >> __k) & 1) != 0};
+                 const bool b{((ref.valid >> __c) & 1U) != 0};
+                 nval[__c] += b;
+                 if(a != b) { ++nmis; continue; }
+                 if(a && (std::fabs(px[__c][__k]-ref.p[__c][0]) > 1.0e-2f || std::fabs(py[__c][__k]-ref.p[__c][1]) > 1.0e-2f ||
+                          std::fabs(pz[__c][__k]-ref.p[__c][2]) > 1.0e-2f)) ++npt;
+             }
+         }
+     }
+     printf("pairs=%d valid: ground=%d wall-x=%d wall+x=%d wall-y=%d wall+y=%d, mismatch=%d, point mismatch=%d\n",
+            16*nbatch,nval[0],nval[1],nval[2],nval[3],nval[4],nmis,npt);
+     urban_hmap_mip_free(m);
+     if(fail || nval[0] == 0 || nval[1] == 0 || nval[4] == 0 || nmis > 16*nbatch*UREFL__COUNT/10000 || npt != 0)
+        test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_urban_radar_coverage_omp();
+
+void unit_test_urban_radar_coverage_omp()
+{
+     using namespace gms::radiolocation;
+     constexpr int32_t n{10007};
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const std::vector<float> h{city_map(21ULL)};
+     UrbanHMapMip_t m;
+     urban_hmap_mip_build(h.data(),city_n,city_n,city_dx,city_dx,m);
+     std::mt19937_64 rng(23ULL);
+     std::uniform_real_distribution<float> ux(0.0f,city_n*city_dx);
+     std::vector<float> rx(n), ry(n), rz(n,1.5f), ox(n), oy(n), oz(n);
+     for(int32_t __i{0}; __i != n; ++__i) { rx[__i] = ux(rng); ry[__i] = ux(rng); }
+     const float radar[3] = {256.0f,256.0f,90.0f};
+     std::fill(ox.begin(),ox.end(),radar[0]);
+     std::fill(oy.begin(),oy.end(),radar[1]);
+     std::fill(oz.begin(),oz.end(),radar[2]);
+     std::vector<uint8_t> vis(n+1,7), vis2(n+1,7);
+     std::vector<float> th(n);
+     std::vector<UrbanReflPts_t> refl(n);
+     urban_radar_coverage_omp(m,radar,rx.data(),ry.data(),rz.data(),n,0.0f,vis.data(),refl.data());
+     urban_los_batch_omp(m,ox.data(),oy.data(),oz.data(),rx.data(),ry.data(),rz.data(),n,vis2.data(),th.data());
+     bool fail{vis[n] != 7 || vis2[n] != 7};
+     int32_t nv{0};
+     for(int32_t __i{0}; __i != n; ++__i)
+     {
+         nv += vis[__i];
+         if(vis[__i] != vis2[__i] || (vis[__i] != 0) != (th[__i] == 1.0f)) fail = true;
+         if(__i%97 == 0)
+         {
+            const float r[3] = {rx[__i],ry[__i],rz[__i]};
+            UrbanReflPts_t ref;
+            urban_reflect_r4(m,radar,r,0.0f,ref);
+            if(ref.valid != refl[__i].valid) printf("receiver %d: valid %x, ref %x\n",__i,refl[__i].valid,ref.valid);
+         }
+     }
+     printf("receivers=%d visible=%d threads=%d\n",n,nv,omp_get_max_threads());
+     urban_hmap_mip_free(m);
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_urban_hmap_mip_build();
+    unit_test_urban_los_zmm16r4();
+    unit_test_urban_reflect_zmm16r4();
+    unit_test_urban_radar_coverage_omp();
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <omp.h>
+#include "vegasT_cpu.hh"
+
+/*
+   icpc -o unit_test_vegasT_cpu -O3 -fp-model fast=2 -ftz -qopenmp -ggdb -march=skylake-avx512 -falign-functions=32 -w1 -qopt-report=5  \
+   -I ../src/gpu/cuda-integration unit_test_vegasT_cpu.cpp
+
+   CPU m-Cubes backend: the gpu/cuda-integration demos integrands at the demos settings (true values,
+   epsrel = 1.0e-3, GPU Custom_generator samples), bitwise reproducibility over the number of threads
+   and seeds, batched integrand member against the scalar operator().
+*/
+
+namespace {
+
+     void test_fail(const char * fn)
+     {
+          printf("[UNIT-TEST]: %s ---> \033[1;31mFAILED\033[0m\n",fn);
+          std::exit(EXIT_FAILURE);
+     }
+
+     class GENZ_3_3D {
+     public:
+          double operator()(double x, double y, double z)
+          {
+              return pow(1 + 3 * x + 2 * y + z, -4);
+          }
+     };
+
+     class GENZ_2_6D {
+     public:
+          double operator()(double x, double y, double z, double k, double l, double m)
+          {
+              const double a{50.0}, b{0.5};
+              const double term_1 = 1. / ((1. / pow(a, 2)) + pow(x - b, 2));
+              const double term_2 = 1. / ((1. / pow(a, 2)) + pow(y - b, 2));
+              const double term_3 = 1. / ((1. / pow(a, 2)) + pow(z - b, 2));
+              const double term_4 = 1. / ((1. / pow(a, 2)) + pow(k - b, 2));
+              const double term_5 = 1. / ((1. / pow(a, 2)) + pow(l - b, 2));
+              const double term_6 = 1. / ((1. / pow(a, 2)) + pow(m - b, 2));
+              return term_1 * term_2 * term_3 * term_4 * term_5 * term_6;
+          }
+     };
+
+     class GENZ_4_5D {
+     public:
+          double operator()(double x, double y, double z, double w, double v)
+          {
+              const double beta{0.5};
+              return exp(-1.0 *
+                         (pow(25, 2) * pow(x - beta, 2) + pow(25, 2) * pow(y - beta, 2) +
+                          pow(25, 2) * pow(z - beta, 2) + pow(25, 2) * pow(w - beta, 2) +
+                          pow(25, 2) * pow(v - beta, 2)));
+          }
+     };
+
+     class GENZ_5_2D {
+     public:
+          double operator()(double x, double y)
+          {
+              const double beta{0.5};
+              return exp(-10. * fabs(x - beta) - 10. * fabs(y - beta));
+          }
+     };
+
+     // GENZ_3_3D with a batched member, the backend has to take it
+     struct GENZ_3_3D_batch {
+          int32_t nbatch{0};
+          double operator()(double x, double y, double z)
+          {
+              return pow(1 + 3 * x + 2 * y + z, -4);
+          }
+          void eval_batch(double const* const* x, int n, double* f)
+          {
+              ++nbatch;
+              for(int __i = 0; __i < n; ++__i)
+                  f[__i] = pow(1 + 3 * x[0][__i] + 2 * x[1][__i] + x[2][__i], -4);
+          }
+     };
+
+     template<typename F,int ndim,typename G = cpu_mcubes::Custom_generator>
+     numint::integration_result run(const F & f,const double ncall,const int titer,const int itmax,
+                                    const int skip,const unsigned int seed = 0)
+     {
+          const quad::Volume<double,ndim> vol;
+          return cpu_mcubes::integrate<F,ndim,false,G>(f,1.0e-3,1.0e-20,ncall,&vol,titer,itmax,skip,seed);
+     }
+
+     bool check_demo(const char * id,const numint::integration_result & r,const double tv)
+     {
+          const double rel{std::fabs(r.estimate-tv)/std::fabs(tv)};
+          printf("%s: estimate %.10e true %.10e errorest %.3e (rel %.2e) chi2 %.3f iters %zu status %d\n",
+                 id,r.estimate,tv,r.errorest,rel,r.chi_sq,r.iters,r.status);
+          // converged to epsrel, and the estimate within 4 errorest (or 3*epsrel) of the true value
+          return (r.status == 0 && std::fabs(r.errorest/r.estimate) <= 1.0e-3 &&
+                  (std::fabs(r.estimate-tv) <= 4.0*r.errorest || rel <= 3.0e-3));
+     }
+
+}
+
+void unit_test_vegasT_cpu_demos();
+
+void unit_test_vegasT_cpu_demos()
+{
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool ok{true};
+     ok &= check_demo("f3, 3",run<GENZ_3_3D,3>(GENZ_3_3D{},1.0e7,100,20,0),0.010846560846560846561);
+     ok &= check_demo("f2, 6",run<GENZ_2_6D,6>(GENZ_2_6D{},1.0e7,100,40,10),1.286889807581113e+13);
+     ok &= check_demo("f4, 5",run<GENZ_4_5D,5>(GENZ_4_5D{},1.0e7,100,20,5),1.79132603674879e-06);
+     ok &= check_demo("f5, 2",run<GENZ_5_2D,2>(GENZ_5_2D{},1.0e7,100,20,5),0.039462780237263662026);
+     if(!ok) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_vegasT_cpu_determinism();
+
+void unit_test_vegasT_cpu_determinism()
+{
+     using namespace cpu_mcubes;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     const int32_t nthr{omp_get_max_threads()};
+     numint::integration_result r[4], c[3];
+     const int32_t thr[4] = {1,2,3,std::max(nthr,4)};
+     for(int32_t __i{0}; __i != 4; ++__i)
+     {
+         omp_set_num_threads(thr[__i]);
+         r[__i] = run<GENZ_4_5D,5,Counter_generator>(GENZ_4_5D{},2.0e6,20,10,5,7U);
+     }
+     omp_set_num_threads(nthr);
+     c[0] = run<GENZ_4_5D,5,Counter_generator>(GENZ_4_5D{},2.0e6,20,10,5,8U);
+     omp_set_num_threads(1);
+     c[1] = run<GENZ_3_3D,3>(GENZ_3_3D{},1.0e6,20,10,0);
+     omp_set_num_threads(nthr);
+     c[2] = run<GENZ_3_3D,3>(GENZ_3_3D{},1.0e6,20,10,0);
+     bool fail{false};
+     for(int32_t __i{1}; __i != 4; ++__i)
+         fail |= r[__i].estimate != r[0].estimate || r[__i].errorest != r[0].errorest ||
+                 r[__i].chi_sq != r[0].chi_sq || r[__i].iters != r[0].iters;
+     fail |= c[1].estimate != c[2].estimate || c[1].errorest != c[2].errorest;
+     // another seed: another sample, the same integral within the errors
+     fail |= c[0].estimate == r[0].estimate ||
+             std::fabs(c[0].estimate-r[0].estimate) > 5.0*(c[0].errorest+r[0].errorest);
+     printf("seed 7, threads 1/2/3/%d: %.17e %.17e %.17e %.17e\n",thr[3],
+            r[0].estimate,r[1].estimate,r[2].estimate,r[3].estimate);
+     printf("seed 8: %.17e, Custom_generator threads 1/%d: %.17e %.17e\n",
+            c[0].estimate,nthr,c[1].estimate,c[2].estimate);
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+void unit_test_vegasT_cpu_batch_and_generator();
+
+void unit_test_vegasT_cpu_batch_and_generator()
+{
+     using namespace cpu_mcubes;
+     printf("[UNIT-TEST]: %s ---> STARTED\n", __PRETTY_FUNCTION__);
+     bool fail{false};
+     // the LCG of the GPU ::Custom_generator, reseeded per cube
+     Custom_generator g(0U);
+     g.SetSeed(12345U);
+     uint32_t s{12345U};
+     for(int32_t __i{0}; __i != 1000; ++__i)
+     {
+         const uint64_t t{static_cast<uint32_t>(1103515245U*s+12345U)};
+         s = static_cast<uint32_t>(t & 0x7FFFFFFFU);
+         fail |= g() != static_cast<double>(s)/2147483648.0;
+     }
+     GENZ_3_3D_batch fb;
+     static_assert(detail::has_eval_batch<GENZ_3_3D_batch>::value,"eval_batch not detected");
+     static_assert(!detail::has_eval_batch<GENZ_3_3D>::value,"eval_batch detected");
+     double fv[4];
+     const double x0[4] = {0.1,0.2,0.3,0.4}, x1[4] = {0.5,0.6,0.7,0.8}, x2[4] = {0.9,0.0,0.25,0.75};
+     const double * xp[3] = {x0,x1,x2};
+     detail::eval_batch<GENZ_3_3D_batch,3>(fb,xp,4,fv);
+     fail |= fb.nbatch != 1 || std::fabs(fv[3]/pow(1 + 3 * 0.4 + 2 * 0.8 + 0.75, -4)-1.0) > 1.0e-14;
+     const numint::integration_result a{run<GENZ_3_3D,3>(GENZ_3_3D{},1.0e6,20,10,0)};
+     const numint::integration_result b{run<GENZ_3_3D_batch,3>(GENZ_3_3D_batch{},1.0e6,20,10,0)};
+     printf("scalar operator() %.17e, eval_batch %.17e\n",a.estimate,b.estimate);
+     fail |= std::fabs(a.estimate-b.estimate) > 1.0e-12*std::fabs(a.estimate);
+     if(fail) test_fail(__PRETTY_FUNCTION__);
+     printf("[UNIT-TEST]: %s ---> \033[1;32mPASSED\033[0m\n", __PRETTY_FUNCTION__);
+}
+
+int main()
+{
+    unit_test_vegasT_cpu_demos();
+    unit_test_vegasT_cpu_determinism();
+    unit_test_vegasT_cpu_batch_and_generator();
+    return 0;
+}
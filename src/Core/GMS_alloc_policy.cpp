@@ -0,0 +1,596 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#include <immintrin.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include "GMS_alloc_policy.h"
+
+namespace
+{
+
+       using gms::common::alloc_policy;
+       using gms::common::alloc_counters_t;
+
+       constexpr std::uint32_t BLK_MAGIC{0x474D5341u};
+       constexpr std::size_t   HDR_BYTES{64ull};
+
+       // The last 64 bytes in front of every block.
+       struct blk_hdr_t
+       {
+              void *        base;   // start of the underlying allocation (chunk for the arena)
+              const void *  owner;  // thread state which allocated the block
+              std::uint64_t bytes;  // requested bytes
+              std::uint32_t magic;
+              std::uint8_t  kind;   // alloc_policy which served the block
+              std::uint8_t  cls;    // pool size class
+              std::uint8_t  pad[HDR_BYTES-2ull*sizeof(void*)-sizeof(std::uint64_t)-sizeof(std::uint32_t)-2ull];
+       };
+
+       static_assert(sizeof(blk_hdr_t) == HDR_BYTES,"blk_hdr_t shall occupy exactly 64 bytes");
+
+       constexpr std::size_t NCNT{sizeof(alloc_counters_t)/sizeof(std::uint64_t)};
+
+#define ALLOC_CIX(f) (offsetof(gms::common::alloc_counters_t,f)/sizeof(std::uint64_t))
+
+       // Pool size classes: 128 bytes, then four classes per power of two up to the limit.
+       constexpr std::size_t POOL_MIN_LOG2{7ull};
+
+       constexpr std::size_t pool_nclasses()
+       {
+              std::size_t k{POOL_MIN_LOG2};
+              while((std::size_t{1} << (k+1ull)) < GMS_ALLOC_POOL_MAX_BLOCK_BYTES) ++k;
+              return (1ull+4ull*(k-POOL_MIN_LOG2+1ull));
+       }
+
+       constexpr std::size_t NCLS{pool_nclasses()};
+
+       __ATTR_ALWAYS_INLINE__
+       inline std::size_t pool_class(const std::size_t n)
+       {
+              if(n <= (std::size_t{1} << POOL_MIN_LOG2)) return (0ull);
+              const std::size_t k{63ull-static_cast<std::size_t>(__builtin_clzll(n-1ull))};
+              const std::size_t step{std::size_t{1} << (k-2ull)};
+              const std::size_t j{(n-(std::size_t{1} << k)+step-1ull)/step-1ull};
+              return (1ull+4ull*(k-POOL_MIN_LOG2)+j);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline std::size_t pool_class_bytes(const std::size_t c)
+       {
+              if(c == 0ull) return (std::size_t{1} << POOL_MIN_LOG2);
+              const std::size_t k{POOL_MIN_LOG2+(c-1ull)/4ull};
+              const std::size_t j{(c-1ull)%4ull};
+              return ((std::size_t{1} << k)+(j+1ull)*(std::size_t{1} << (k-2ull)));
+       }
+
+       struct arena_chunk_t
+       {
+              char *      base;
+              std::size_t size;
+       };
+
+       struct tstate_t;
+
+       std::mutex               g_registry_mtx;
+       std::vector<tstate_t*>   g_registry;
+       std::uint64_t            g_retired[NCNT] = {};
+
+       thread_local bool        tls_dead{false};
+
+       [[noreturn]] __ATTR_COLD__
+       void alloc_failed(const std::size_t nbytes,const char * who)
+       {
+              std::fprintf(stderr,"[%s:%s]: %s -- failed to allocate %zu bytes!!\n",__DATE__,__TIME__,who,nbytes);
+              std::exit(EXIT_FAILURE);
+       }
+
+       struct tstate_t
+       {
+              std::atomic<std::uint64_t>  cnt[NCNT];
+              alloc_policy                pol;
+              // arena
+              std::vector<arena_chunk_t>  chunks;
+              std::size_t                 cur;
+              std::size_t                 off;
+              std::size_t                 frame_bytes;  // bytes consumed in the current frame (all chunks)
+              std::uint64_t               arena_live_blocks;
+              std::uint64_t               arena_live_bytes;
+              // pool
+              void *                      free_list[NCLS];
+              std::size_t                 cached;
+
+              tstate_t()
+              :
+              pol{alloc_policy::MM_MALLOC},
+              cur{0ull},
+              off{0ull},
+              frame_bytes{0ull},
+              arena_live_blocks{0ull},
+              arena_live_bytes{0ull},
+              cached{0ull}
+              {
+                     for(std::size_t __i{0ull}; __i != NCNT; ++__i) cnt[__i].store(0ull,std::memory_order_relaxed);
+                     for(std::size_t __i{0ull}; __i != NCLS; ++__i) free_list[__i] = nullptr;
+                     std::lock_guard<std::mutex> lck(g_registry_mtx);
+                     g_registry.push_back(this);
+              }
+
+              ~tstate_t()
+              {
+                     tls_dead = true;
+                     pool_release();
+                     arena_free_chunks();
+                     std::lock_guard<std::mutex> lck(g_registry_mtx);
+                     for(std::size_t __i{0ull}; __i != NCNT; ++__i)
+                     {
+                            if(__i == ALLOC_CIX(bytes_peak))
+                               g_retired[__i] = std::max(g_retired[__i],cnt[__i].load(std::memory_order_relaxed));
+                            else
+                               g_retired[__i] += cnt[__i].load(std::memory_order_relaxed);
+                     }
+                     g_registry.erase(std::remove(g_registry.begin(),g_registry.end(),this),g_registry.end());
+              }
+
+              // single writer, hence no read-modify-write is needed
+              __ATTR_ALWAYS_INLINE__
+              inline void add(const std::size_t ix,const std::uint64_t v)
+              {
+                     cnt[ix].store(cnt[ix].load(std::memory_order_relaxed)+v,std::memory_order_relaxed);
+              }
+
+              __ATTR_ALWAYS_INLINE__
+              inline std::uint64_t get(const std::size_t ix) const
+              {
+                     return (cnt[ix].load(std::memory_order_relaxed));
+              }
+
+              __ATTR_ALWAYS_INLINE__
+              inline void on_alloc(const alloc_policy k,const std::size_t bytes)
+              {
+                     const std::size_t ik{static_cast<std::size_t>(k)};
+                     add(ALLOC_CIX(n_alloc)+ik,1ull);
+                     add(ALLOC_CIX(bytes_alloc)+ik,bytes);
+                     add(ALLOC_CIX(bytes_live),bytes);
+                     const std::uint64_t live{get(ALLOC_CIX(bytes_live))};
+                     if(static_cast<std::int64_t>(live) > static_cast<std::int64_t>(get(ALLOC_CIX(bytes_peak))))
+                        cnt[ALLOC_CIX(bytes_peak)].store(live,std::memory_order_relaxed);
+              }
+
+              void arena_free_chunks()
+              {
+                     for(const arena_chunk_t & c : chunks) _mm_free(c.base);
+                     add(ALLOC_CIX(arena_bytes_reserved),-get(ALLOC_CIX(arena_bytes_reserved)));
+                     chunks.clear();
+                     cur = 0ull;
+                     off = 0ull;
+              }
+
+              void arena_new_chunk(const std::size_t size)
+              {
+                     char * base{reinterpret_cast<char*>(_mm_malloc(size,4096ull))};
+                     if(base == nullptr) alloc_failed(size,"arena");
+                     chunks.push_back(arena_chunk_t{base,size});
+                     add(ALLOC_CIX(arena_chunks),1ull);
+                     add(ALLOC_CIX(arena_bytes_reserved),size);
+              }
+
+              void * arena_alloc(const std::size_t bytes,const std::size_t align)
+              {
+                     const std::size_t need{HDR_BYTES+bytes+align};
+                     for(;;)
+                     {
+                            if(cur < chunks.size())
+                            {
+                                   const arena_chunk_t & c{chunks[cur]};
+                                   const std::uintptr_t top{reinterpret_cast<std::uintptr_t>(c.base)+off};
+                                   const std::uintptr_t p{(top+HDR_BYTES+align-1ull) & ~static_cast<std::uintptr_t>(align-1ull)};
+                                   const std::size_t end{static_cast<std::size_t>(p-reinterpret_cast<std::uintptr_t>(c.base))+bytes};
+                                   if(end <= c.size)
+                                   {
+                                          frame_bytes += end-off;
+                                          off = end;
+                                          blk_hdr_t * h{reinterpret_cast<blk_hdr_t*>(p-HDR_BYTES)};
+                                          h->base  = c.base;
+                                          h->owner = this;
+                                          h->bytes = bytes;
+                                          h->magic = BLK_MAGIC;
+                                          h->kind  = static_cast<std::uint8_t>(alloc_policy::ARENA);
+                                          h->cls   = 0;
+                                          ++arena_live_blocks;
+                                          arena_live_bytes += bytes;
+                                          return (reinterpret_cast<void*>(p));
+                                   }
+                                   // the rest of this chunk is lost for the current frame
+                                   frame_bytes += c.size-off;
+                                   ++cur;
+                                   off = 0ull;
+                                   continue;
+                            }
+                            arena_new_chunk(std::max<std::size_t>(GMS_ALLOC_ARENA_CHUNK_BYTES,
+                                                                  (need+4095ull) & ~std::size_t{4095}));
+                            cur = chunks.size()-1ull;
+                            off = 0ull;
+                     }
+              }
+
+              void arena_reset()
+              {
+                     add(ALLOC_CIX(arena_resets),1ull);
+                     add(ALLOC_CIX(arena_live_at_reset),arena_live_blocks);
+                     add(ALLOC_CIX(bytes_live),-arena_live_bytes);
+                     arena_live_blocks = 0ull;
+                     arena_live_bytes  = 0ull;
+                     // the frame spilled over several chunks, merge them for the next one
+                     if(cur > 0ull && cur < chunks.size())
+                     {
+                            const std::size_t total{(frame_bytes+GMS_ALLOC_ARENA_CHUNK_BYTES-1ull)/
+                                                     GMS_ALLOC_ARENA_CHUNK_BYTES*GMS_ALLOC_ARENA_CHUNK_BYTES};
+                            arena_free_chunks();
+                            arena_new_chunk(total);
+                     }
+                     cur = 0ull;
+                     off = 0ull;
+                     frame_bytes = 0ull;
+              }
+
+              void * pool_alloc(const std::size_t bytes)
+              {
+                     const std::size_t n{HDR_BYTES+bytes};
+                     const std::size_t c{pool_class(n)};
+                     const std::size_t sz{pool_class_bytes(c)};
+                     void * base{free_list[c]};
+                     if(base != nullptr)
+                     {
+                            free_list[c] = *reinterpret_cast<void**>(base);
+                            cached -= sz;
+                            add(ALLOC_CIX(pool_hits),1ull);
+                            add(ALLOC_CIX(pool_bytes_cached),-static_cast<std::uint64_t>(sz));
+                     }
+                     else
+                     {
+                            base = _mm_malloc(sz,64ull);
+                            if(base == nullptr) alloc_failed(sz,"pool");
+                            add(ALLOC_CIX(pool_misses),1ull);
+                     }
+                     blk_hdr_t * h{reinterpret_cast<blk_hdr_t*>(base)};
+                     h->base  = base;
+                     h->owner = this;
+                     h->bytes = bytes;
+                     h->magic = BLK_MAGIC;
+                     h->kind  = static_cast<std::uint8_t>(alloc_policy::POOL);
+                     h->cls   = static_cast<std::uint8_t>(c);
+                     return (reinterpret_cast<char*>(base)+HDR_BYTES);
+              }
+
+              void pool_free(blk_hdr_t * h)
+              {
+                     const std::size_t c{h->cls};
+                     const std::size_t sz{pool_class_bytes(c)};
+                     if(h->owner != this) add(ALLOC_CIX(remote_frees),1ull);
+                     void * base{h->base};
+                     h->magic = 0u;
+                     if(cached+sz > GMS_ALLOC_POOL_MAX_CACHED_BYTES)
+                     {
+                            _mm_free(base);
+                            return;
+                     }
+                     *reinterpret_cast<void**>(base) = free_list[c];
+                     free_list[c] = base;
+                     cached += sz;
+                     add(ALLOC_CIX(pool_bytes_cached),sz);
+              }
+
+              void pool_release()
+              {
+                     for(std::size_t __c{0ull}; __c != NCLS; ++__c)
+                     {
+                            void * p{free_list[__c]};
+                            while(p != nullptr)
+                            {
+                                   void * next{*reinterpret_cast<void**>(p)};
+                                   _mm_free(p);
+                                   p = next;
+                            }
+                            free_list[__c] = nullptr;
+                     }
+                     add(ALLOC_CIX(pool_bytes_cached),-get(ALLOC_CIX(pool_bytes_cached)));
+                     cached = 0ull;
+              }
+       };
+
+       thread_local tstate_t tls;
+
+       // _mm_malloc/TBB: [align bytes: header at the end][user block]
+       void * aligned_alloc_hdr(const alloc_policy k,const std::size_t bytes,const std::size_t align,const void * owner)
+       {
+              const std::size_t off{std::max(align,HDR_BYTES)};
+              void * base{nullptr};
+#if (GMS_ALLOC_POLICY_USE_TBB) == 1
+              if(k == alloc_policy::TBB_SCALABLE)
+                 base = scalable_aligned_malloc(off+bytes,off);
+              else
+#endif
+                 base = _mm_malloc(off+bytes,off);
+              if(base == nullptr) alloc_failed(off+bytes,gms::common::alloc_policy_name(k));
+              char * p{reinterpret_cast<char*>(base)+off};
+              blk_hdr_t * h{reinterpret_cast<blk_hdr_t*>(p-HDR_BYTES)};
+              h->base  = base;
+              h->owner = owner;
+              h->bytes = bytes;
+              h->magic = BLK_MAGIC;
+              h->kind  = static_cast<std::uint8_t>(k);
+              h->cls   = 0;
+              return (p);
+       }
+
+       void aligned_free_hdr(const blk_hdr_t * h)
+       {
+#if (GMS_ALLOC_POLICY_USE_TBB) == 1
+              if(h->kind == static_cast<std::uint8_t>(alloc_policy::TBB_SCALABLE))
+              {
+                     scalable_aligned_free(h->base);
+                     return;
+              }
+#endif
+              _mm_free(h->base);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void to_counters(const std::atomic<std::uint64_t> * src,alloc_counters_t & dst)
+       {
+              std::uint64_t v[NCNT];
+              for(std::size_t __i{0ull}; __i != NCNT; ++__i) v[__i] = src[__i].load(std::memory_order_relaxed);
+              std::memcpy(&dst,&v[0],sizeof(dst));
+       }
+
+}
+
+const char *
+gms::common::alloc_policy_name(const alloc_policy pol)
+{
+       switch(pol)
+       {
+              case alloc_policy::MM_MALLOC    : return "MM_MALLOC";
+              case alloc_policy::TBB_SCALABLE : return "TBB_SCALABLE";
+              case alloc_policy::ARENA        : return "ARENA";
+              case alloc_policy::POOL         : return "POOL";
+       }
+       return "UNKNOWN";
+}
+
+gms::common::alloc_policy
+gms::common::alloc_policy_current()
+{
+       if(tls_dead) return (alloc_policy::MM_MALLOC);
+       return (tls.pol);
+}
+
+void
+gms::common::alloc_policy_set(const alloc_policy pol)
+{
+       if(tls_dead) return;
+#if (GMS_ALLOC_POLICY_USE_TBB) == 0
+       if(pol == alloc_policy::TBB_SCALABLE) { tls.pol = alloc_policy::MM_MALLOC; return;}
+#endif
+       tls.pol = pol;
+}
+
+void *
+gms::common::gms_policy_malloc(const std::size_t nbytes,
+                               const std::size_t alignment)
+{
+       const std::size_t align{std::max<std::size_t>(alignment,64ull)};
+       if(__builtin_expect(tls_dead,0))
+          return (aligned_alloc_hdr(alloc_policy::MM_MALLOC,nbytes,align,nullptr));
+       tstate_t & s{tls};
+       void * p{nullptr};
+       alloc_policy k{s.pol};
+       switch(k)
+       {
+              case alloc_policy::ARENA :
+                   p = s.arena_alloc(nbytes,align);
+              break;
+              case alloc_policy::POOL :
+                   if(align == 64ull && HDR_BYTES+nbytes <= GMS_ALLOC_POOL_MAX_BLOCK_BYTES)
+                   {
+                          p = s.pool_alloc(nbytes);
+                   }
+                   else
+                   {
+                          s.add(ALLOC_CIX(pool_oversize),1ull);
+                          k = alloc_policy::MM_MALLOC;
+                          p = aligned_alloc_hdr(k,nbytes,align,&s);
+                   }
+              break;
+              default :
+                   p = aligned_alloc_hdr(k,nbytes,align,&s);
+       }
+       s.on_alloc(k,nbytes);
+       return (p);
+}
+
+void
+gms::common::gms_policy_free(void * __restrict ptr)
+{
+       if(ptr == nullptr) return;
+       blk_hdr_t * h{reinterpret_cast<blk_hdr_t*>(reinterpret_cast<char*>(ptr)-HDR_BYTES)};
+       if(__builtin_expect(h->magic != BLK_MAGIC,0))
+       {
+              std::fprintf(stderr,"[%s:%s]: %s -- block %p was not allocated by gms_policy_malloc (or freed twice)!!\n",
+                           __DATE__,__TIME__,__PRETTY_FUNCTION__,ptr);
+              std::abort();
+       }
+       const alloc_policy k{static_cast<alloc_policy>(h->kind)};
+       if(__builtin_expect(tls_dead,0))
+       {
+              // thread exit: the arena chunks are gone already, the pool blocks are released at once
+              if(k == alloc_policy::POOL) { h->magic = 0u; _mm_free(h->base);}
+              else if(k != alloc_policy::ARENA) { h->magic = 0u; aligned_free_hdr(h);}
+              return;
+       }
+       tstate_t & s{tls};
+       s.add(ALLOC_CIX(n_free)+static_cast<std::size_t>(k),1ull);
+       switch(k)
+       {
+              case alloc_policy::ARENA :
+                   // released by arena_reset(), only the owner keeps the gauges
+                   if(h->owner == &s)
+                   {
+                          --s.arena_live_blocks;
+                          s.arena_live_bytes -= h->bytes;
+                          s.add(ALLOC_CIX(bytes_live),-h->bytes);
+                   }
+                   else
+                   {
+                          s.add(ALLOC_CIX(remote_frees),1ull);
+                   }
+                   h->magic = 0u;
+              break;
+              case alloc_policy::POOL :
+                   s.add(ALLOC_CIX(bytes_live),-h->bytes);
+                   s.pool_free(h);
+              break;
+              default :
+                   s.add(ALLOC_CIX(bytes_live),-h->bytes);
+                   h->magic = 0u;
+                   aligned_free_hdr(h);
+       }
+}
+
+void
+gms::common::arena_reset()
+{
+       if(tls_dead) return;
+       tls.arena_reset();
+}
+
+void
+gms::common::arena_reserve(const std::size_t nbytes)
+{
+       if(tls_dead) return;
+       tstate_t & s{tls};
+       std::size_t cap{0ull};
+       for(const arena_chunk_t & c : s.chunks) cap += c.size;
+       if(cap >= nbytes) return;
+       if(s.frame_bytes == 0ull)
+       {
+              // nothing allocated in this frame, one chunk for all
+              s.arena_free_chunks();
+              s.arena_new_chunk((nbytes+4095ull) & ~std::size_t{4095});
+       }
+       else
+       {
+              s.arena_new_chunk((nbytes-cap+4095ull) & ~std::size_t{4095});
+       }
+}
+
+void
+gms::common::arena_release()
+{
+       if(tls_dead) return;
+       tls.arena_reset();
+       tls.arena_free_chunks();
+}
+
+std::size_t
+gms::common::arena_bytes_used()
+{
+       if(tls_dead) return (0ull);
+       return (tls.frame_bytes);
+}
+
+void
+gms::common::pool_trim()
+{
+       if(tls_dead) return;
+       tls.pool_release();
+}
+
+gms::common::alloc_counters_t
+gms::common::alloc_counters()
+{
+       alloc_counters_t c{};
+       if(tls_dead) return (c);
+       to_counters(&tls.cnt[0],c);
+       return (c);
+}
+
+gms::common::alloc_counters_t
+gms::common::alloc_counters_total()
+{
+       if(!tls_dead) (void)tls.pol; // registers the calling thread
+       std::uint64_t v[NCNT];
+       std::lock_guard<std::mutex> lck(g_registry_mtx);
+       std::memcpy(&v[0],&g_retired[0],sizeof(v));
+       for(const tstate_t * s : g_registry)
+       {
+              for(std::size_t __i{0ull}; __i != NCNT; ++__i)
+              {
+                     const std::uint64_t x{s->get(__i)};
+                     if(__i == ALLOC_CIX(bytes_peak)) v[__i] = std::max(v[__i],x);
+                     else v[__i] += x;
+              }
+       }
+       alloc_counters_t c;
+       std::memcpy(&c,&v[0],sizeof(c));
+       return (c);
+}
+
+void
+gms::common::alloc_counters_reset()
+{
+       if(tls_dead) return;
+       tstate_t & s{tls};
+       // the gauges describe the present state and are kept
+       const std::size_t keep[] = {ALLOC_CIX(bytes_live),ALLOC_CIX(arena_bytes_reserved),ALLOC_CIX(pool_bytes_cached)};
+       for(std::size_t __i{0ull}; __i != NCNT; ++__i)
+       {
+              if(std::find(std::begin(keep),std::end(keep),__i) != std::end(keep)) continue;
+              s.cnt[__i].store(0ull,std::memory_order_relaxed);
+       }
+       s.cnt[ALLOC_CIX(bytes_peak)].store(s.get(ALLOC_CIX(bytes_live)),std::memory_order_relaxed);
+}
+
+void
+gms::common::alloc_counters_print(const alloc_counters_t & c)
+{
+       std::printf("%-14s %14s %14s %18s\n","policy","allocs","frees","bytes allocated");
+       for(int32_t __i{0}; __i != N_ALLOC_POLICIES; ++__i)
+       {
+              std::printf("%-14s %14llu %14llu %18llu\n",alloc_policy_name(static_cast<alloc_policy>(__i)),
+                          static_cast<unsigned long long>(c.n_alloc[__i]),static_cast<unsigned long long>(c.n_free[__i]),
+                          static_cast<unsigned long long>(c.bytes_alloc[__i]));
+       }
+       std::printf("bytes live: %lld, peak: %llu\n",static_cast<long long>(c.bytes_live),
+                   static_cast<unsigned long long>(c.bytes_peak));
+       std::printf("arena: resets %llu, chunks %llu, reserved %llu bytes, blocks live at reset %llu\n",
+                   static_cast<unsigned long long>(c.arena_resets),static_cast<unsigned long long>(c.arena_chunks),
+                   static_cast<unsigned long long>(c.arena_bytes_reserved),static_cast<unsigned long long>(c.arena_live_at_reset));
+       std::printf("pool: hits %llu, misses %llu, oversize %llu, cached %llu bytes, remote frees %llu\n",
+                   static_cast<unsigned long long>(c.pool_hits),static_cast<unsigned long long>(c.pool_misses),
+                   static_cast<unsigned long long>(c.pool_oversize),static_cast<unsigned long long>(c.pool_bytes_cached),
+                   static_cast<unsigned long long>(c.remote_frees));
+}
@@ -0,0 +1,261 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#ifndef __GMS_ALLOC_POLICY_H__
+#define __GMS_ALLOC_POLICY_H__ 201020260900
+
+
+namespace  file_info
+{
+
+    const unsigned int GMS_ALLOC_POLICY_MAJOR = 1U;
+    const unsigned int GMS_ALLOC_POLICY_MINOR = 0U;
+    const unsigned int GMS_ALLOC_POLICY_MICRO = 0U;
+    const unsigned int GMS_ALLOC_POLICY_FULLVER =
+      1000U*GMS_ALLOC_POLICY_MAJOR+100U*GMS_ALLOC_POLICY_MINOR+10U*GMS_ALLOC_POLICY_MICRO;
+    const char * const GMS_ALLOC_POLICY_CREATE_DATE = "20-10-2026 09:00 +00200 (TUE 20 OCT 2026 GMT+2)";
+    const char * const GMS_ALLOC_POLICY_BUILD_DATE  = __DATE__ ":" __TIME__;
+    const char * const GMS_ALLOC_POLICY_AUTHOR      =  "Programmer: Bernard Gingold, e-mail: beniekg@gmail.com";
+    const char * const GMS_ALLOC_POLICY_DESCRIPT    =  "Per-thread allocation policy (aligned malloc, TBB, bump arena, size-class pool) for the dynamic containers.";
+
+}
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "GMS_config.h"
+#include "GMS_malloc.h"
+
+/*
+    The heap storage of the dynamic containers (DC1D/2D/3D_*_t, darray_*_t)
+    is requested through gms_container_malloc()/gms_container_free(), which
+    forward to the allocation policy selected by the calling thread:
+    MM_MALLOC    -- _mm_malloc/_mm_free (the former behaviour, the default).
+    TBB_SCALABLE -- scalable_aligned_malloc of the TBB scalable allocator.
+    ARENA        -- thread-local 64-byte aligned bump arena, free is a no-op,
+                    the memory is reclaimed at once by arena_reset() (per frame).
+    POOL         -- thread-local size-class pool (four classes per power of two)
+                    caching the freed blocks for reuse.
+    Every block carries a 64-byte header in front of it, recording its origin,
+    hence a block is freed correctly regardless of the policy (or the thread)
+    in effect at the free. A pool block freed by another thread is cached by
+    that thread.
+    The counters are kept per thread (single writer) and summed on request.
+*/
+
+// Route the container storage through the allocation policy (1) or call
+// gms_mm_malloc/gms_mm_free directly (0).
+#if !defined(GMS_CONTAINERS_USE_ALLOC_POLICY)
+#define GMS_CONTAINERS_USE_ALLOC_POLICY 1
+#endif
+
+// Enable the TBB_SCALABLE policy (needs libtbbmalloc), otherwise it falls back to MM_MALLOC.
+#if !defined(GMS_ALLOC_POLICY_USE_TBB)
+#define GMS_ALLOC_POLICY_USE_TBB 1
+#endif
+
+// Size of an arena chunk (bytes). An oversized request gets a chunk of its own.
+#if !defined(GMS_ALLOC_ARENA_CHUNK_BYTES)
+#define GMS_ALLOC_ARENA_CHUNK_BYTES 4194304ull
+#endif
+
+// Largest block (bytes, header included) served by the pool, larger go to _mm_malloc.
+#if !defined(GMS_ALLOC_POOL_MAX_BLOCK_BYTES)
+#define GMS_ALLOC_POOL_MAX_BLOCK_BYTES 33554432ull
+#endif
+
+// Upper bound of the bytes cached (per thread) by the pool, the excess is released.
+#if !defined(GMS_ALLOC_POOL_MAX_CACHED_BYTES)
+#define GMS_ALLOC_POOL_MAX_CACHED_BYTES 268435456ull
+#endif
+
+namespace gms
+{
+namespace common
+{
+
+enum class alloc_policy : int32_t
+{
+      MM_MALLOC    = 0,
+      TBB_SCALABLE = 1,
+      ARENA        = 2,
+      POOL         = 3
+};
+
+constexpr int32_t N_ALLOC_POLICIES{4};
+
+struct alloc_counters_t
+{
+       uint64_t n_alloc[N_ALLOC_POLICIES];     // by the policy which served the request
+       uint64_t n_free[N_ALLOC_POLICIES];      // by the origin of the freed block
+       uint64_t bytes_alloc[N_ALLOC_POLICIES]; // requested bytes
+       uint64_t bytes_live;                    // requested bytes not yet freed (arena: not yet reset)
+       uint64_t bytes_peak;
+       uint64_t arena_resets;
+       uint64_t arena_chunks;                  // chunks obtained from _mm_malloc
+       uint64_t arena_bytes_reserved;          // current capacity of the arena
+       uint64_t arena_live_at_reset;           // blocks still referenced when the arena was reset
+       uint64_t pool_hits;                     // served from a cached block
+       uint64_t pool_misses;                   // a new block had to be obtained
+       uint64_t pool_oversize;                 // larger than the biggest class (served by _mm_malloc)
+       uint64_t pool_bytes_cached;
+       uint64_t remote_frees;                  // pool blocks freed by another thread
+};
+
+const char * alloc_policy_name(const alloc_policy);
+
+// The policy of the calling thread (MM_MALLOC unless set).
+alloc_policy alloc_policy_current();
+
+void alloc_policy_set(const alloc_policy);
+
+__ATTR_HOT__
+void * gms_policy_malloc(const std::size_t,
+                         const std::size_t alignment = 64ull);
+
+__ATTR_HOT__
+void gms_policy_free(void * __restrict);
+
+/*
+    Rewinds the arena of the calling thread, all of its blocks become invalid.
+    When the previous frame spilled over several chunks these are merged into
+    one chunk large enough for the whole frame.
+*/
+void arena_reset();
+
+// Grows the arena of the calling thread to hold at least the given number of bytes.
+__ATTR_COLD__
+void arena_reserve(const std::size_t);
+
+// Returns the arena chunks of the calling thread to the system.
+__ATTR_COLD__
+void arena_release();
+
+std::size_t arena_bytes_used();
+
+// Returns the blocks cached by the pool of the calling thread to the system.
+__ATTR_COLD__
+void pool_trim();
+
+// Counters of the calling thread.
+alloc_counters_t alloc_counters();
+
+// Counters summed over all threads (live and exited ones).
+alloc_counters_t alloc_counters_total();
+
+// Zeroes the counters of the calling thread (the byte gauges are kept).
+void alloc_counters_reset();
+
+__ATTR_COLD__
+void alloc_counters_print(const alloc_counters_t &);
+
+/*
+    Sets the policy of the calling thread for the lifetime of the object
+    and restores the previous one.
+*/
+struct alloc_policy_scope
+{
+       alloc_policy m_prev;
+
+       explicit alloc_policy_scope(const alloc_policy pol)
+       :
+       m_prev{alloc_policy_current()}
+       {
+              alloc_policy_set(pol);
+       }
+
+       alloc_policy_scope(const alloc_policy_scope &) = delete;
+
+       alloc_policy_scope & operator=(const alloc_policy_scope &) = delete;
+
+       ~alloc_policy_scope()
+       {
+              alloc_policy_set(this->m_prev);
+       }
+};
+
+/*
+    One processing frame (e.g. one dwell): the containers created in its
+    scope by the calling thread live in the arena, which is reset on exit.
+    The containers shall not outlive the frame.
+*/
+struct arena_frame
+{
+       alloc_policy m_prev;
+
+       arena_frame()
+       :
+       m_prev{alloc_policy_current()}
+       {
+              alloc_policy_set(alloc_policy::ARENA);
+       }
+
+       arena_frame(const arena_frame &) = delete;
+
+       arena_frame & operator=(const arena_frame &) = delete;
+
+       ~arena_frame()
+       {
+              alloc_policy_set(this->m_prev);
+              arena_reset();
+       }
+};
+
+// Single objects (e.g. the StatC*/StatV* containers) constructed in the policy storage.
+template<typename T,typename... Args>
+T * policy_new(Args &&... args)
+{
+       void * ptr{gms_policy_malloc(sizeof(T),alignof(T) > 64ull ? alignof(T) : 64ull)};
+       return (::new(ptr) T(std::forward<Args>(args)...));
+}
+
+template<typename T>
+void policy_delete(T * ptr)
+{
+       if(ptr == nullptr) return;
+       ptr->~T();
+       gms_policy_free(ptr);
+}
+
+__ATTR_ALWAYS_INLINE__
+inline void * gms_container_malloc(const std::size_t len,
+                                   const std::size_t alignment)
+{
+#if (GMS_CONTAINERS_USE_ALLOC_POLICY) == 1
+       return (gms_policy_malloc(len,alignment));
+#else
+       return (gms_mm_malloc(len,alignment));
+#endif
+}
+
+__ATTR_ALWAYS_INLINE__
+inline void gms_container_free(void * __restrict ptr)
+{
+#if (GMS_CONTAINERS_USE_ALLOC_POLICY) == 1
+       gms_policy_free(ptr);
+#else
+       gms_mm_free(ptr);
+#endif
+}
+
+} // common
+} // gms
+
+#endif /*__GMS_ALLOC_POLICY_H__*/
@@ -102,6 +102,12 @@ namespace file_info {
    #define USE_MMAP_1GiB 0
 #endif
 
+// gms_mmap_2MiB/gms_mmap_1GiB: when no hugepages are reserved map the 4KiB pages
+// and advise the transparent hugepages instead of terminating.
+#if !defined(GMS_MMAP_HUGEPAGE_FALLBACK)
+   #define GMS_MMAP_HUGEPAGE_FALLBACK 1
+#endif
+
 // For Modified OpenBLAS kernels
 
 #define CONJ 
@@ -50,11 +50,14 @@ namespace file_info
 #include <vector>
 #include <exception> //std::terminate
 #include <valarray>
-#include <cstring> // std::memcpy
+#include <cstring>
 #include <iostream>
 #include "GMS_config.h"
 #include "GMS_malloc.h"
+#include "GMS_alloc_policy.h"
 #include "GMS_half.h"
+#include "GMS_memops_dispatch.h"
+#include "GMS_fp16_bulk.h"
 
 
 // Enable non-temporal stores for this class only( used with free-standing operators)
@@ -180,7 +183,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -200,7 +203,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                    HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -223,7 +226,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(std::complex<half>)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                 HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -251,8 +254,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -282,7 +285,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -333,12 +336,23 @@ namespace gms
                          return (this->size() == 0ull);
                     }
 
+                    // Bulk (F16C/AVX512) conversions of the whole array, see GMS_fp16_bulk.h
+                    inline void load_c4(const std::complex<float> * __restrict data) noexcept(true)
+                    {
+                         gms::common::cvt_c4_c2(data,this->m_data,this->mnx);
+                    }
+
+                    inline void store_c4(std::complex<float> * __restrict data) const noexcept(true)
+                    {
+                         gms::common::cvt_c2_c4(this->m_data,data,this->mnx);
+                    }
+
                     private:
                     inline void allocate() noexcept(false)
                     {
                           using namespace gms::common;
                           this->m_data  = (std::complex<half>*)
-                                         gms_mm_malloc( sizeof(std::complex<half>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<half>)*this->mnx,64ULL);
                        
                      }
                      public: 
@@ -439,7 +453,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -459,7 +473,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                    HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -482,7 +496,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(std::complex<float>)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                 HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -510,8 +524,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -541,7 +555,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -597,7 +611,7 @@ namespace gms
                     {
                           using namespace gms::common;
                           this->m_data  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
                        
                      }
                      public: 
@@ -698,7 +712,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -718,7 +732,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -741,7 +755,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(std::complex<double>)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -769,8 +783,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -800,7 +814,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -856,7 +870,7 @@ namespace gms
                     {
                           using namespace gms::common;
                           this->m_data  = (std::complex<double>*)
-                                         gms_mm_malloc( sizeof(std::complex<double>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<double>)*this->mnx,64ULL);
                        
                     }
                     public: 
@@ -957,7 +971,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -977,7 +991,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1000,7 +1014,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(half)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1028,8 +1042,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1061,7 +1075,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -1089,7 +1103,7 @@ namespace gms
 
                     inline std::size_t bytes_mnx() const noexcept(true)
                     {
-                         return (sizeof(float)*this->mnx);
+                         return (sizeof(half)*this->mnx);
                     }
 
                     inline half * begin() const noexcept
@@ -1112,12 +1126,28 @@ namespace gms
                          return (this->size() == 0ull);
                     }
 
+                    // Bulk (F16C/AVX512) conversions of the whole array, see GMS_fp16_bulk.h
+                    inline void load_r4(const float * __restrict data) noexcept(true)
+                    {
+                         gms::common::cvt_f32_f16(data,this->m_data,this->mnx);
+                    }
+
+                    inline void store_r4(float * __restrict data) const noexcept(true)
+                    {
+                         gms::common::cvt_f16_f32(this->m_data,data,this->mnx);
+                    }
+
+                    inline void fill(const half h) noexcept(true)
+                    {
+                         gms::common::fill_f16(this->m_data,h,this->mnx);
+                    }
+
                     private:
                     inline void allocate() noexcept(false)
                     {
                           using namespace gms::common;
                           this->m_data  = (half*)
-                                         gms_mm_malloc( sizeof(half)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(half)*this->mnx,64ULL);
                        
                      }
                      public: 
@@ -1217,7 +1247,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1237,7 +1267,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1260,7 +1290,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(float)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1288,8 +1318,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1321,7 +1351,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -1377,7 +1407,7 @@ namespace gms
                     {
                           using namespace gms::common;
                           this->m_data  = (float*)
-                                         gms_mm_malloc( sizeof(float)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(float)*this->mnx,64ULL);
                        
                      }
                      public: 
@@ -1478,7 +1508,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1498,7 +1528,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx{bytes_mnx()};
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1521,7 +1551,7 @@ namespace gms
                           allocate();
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(float)*this->mnx;
-                          std::memcpy(this->m_data,&data[0],lenx);
+                          memcpy_dispatch(this->m_data,&data[0],lenx);
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1549,8 +1579,8 @@ namespace gms
 #endif                  
                            this->mnx = rhs.mnx;
                            this->allocate();
-                           this->ismmap = rhs.ismmap;
-                           std::memcpy(this->m_data,&rhs.m_data[0],this->mnx);
+                           this->ismmap = false; // the copy is always heap-allocated
+                           memcpy_dispatch(this->m_data,&rhs.m_data[0],this->bytes_mnx());
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
 
@@ -1580,7 +1610,7 @@ namespace gms
                           }
                           else 
                           {
-                             gms_mm_free(this->m_data); this->m_data = NULL;  
+                             gms_container_free(this->m_data); this->m_data = NULL;  
                           }  
 #if (DYN_ARRAY_USE_PMC_INSTRUMENTATION) == 1
                HW_PMC_COLLECTION_EPILOGE_BODY
@@ -1636,7 +1666,7 @@ namespace gms
                     {
                           using namespace gms::common;
                           this->m_data  = (double*)
-                                         gms_mm_malloc( sizeof(double)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(double)*this->mnx,64ULL);
                        
                      }
                      public: 
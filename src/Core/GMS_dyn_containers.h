@@ -31,6 +31,7 @@ namespace file_info {
 #include <iostream>
 #include "GMS_config.h"
 #include "GMS_malloc.h"
+#include "GMS_alloc_policy.h"
 
 
 // Enable non-temporal stores for this class only( used with free-standing operators)
@@ -222,9 +223,9 @@ namespace gms {
                              }
                           }
                           else {
-                              gms_mm_free(this->m_Ex); this->m_Ex = NULL;
-                              gms_mm_free(this->m_Ey); this->m_Ey = NULL;
-                              gms_mm_free(this->m_Ez); this->m_Ez = NULL;
+                              gms_container_free(this->m_Ex); this->m_Ex = NULL;
+                              gms_container_free(this->m_Ey); this->m_Ey = NULL;
+                              gms_container_free(this->m_Ez); this->m_Ez = NULL;
                           }
                       }
                       
@@ -271,11 +272,11 @@ namespace gms {
                       {
                           using namespace gms::common;
                           this->m_Ex  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
                           this->m_Ey  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mny,64ULL);
                           this->m_Ez  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mnz,64ULL);
                       }
                      public:
                      inline void info_size_alignment() const 
@@ -452,8 +453,8 @@ namespace gms {
                           }
                           else 
                           {
-                              gms_mm_free(this->m_Ex); this->m_Ex = NULL;
-                              gms_mm_free(this->m_Ey); this->m_Ey = NULL; 
+                              gms_container_free(this->m_Ex); this->m_Ex = NULL;
+                              gms_container_free(this->m_Ey); this->m_Ey = NULL; 
                              
                           }
                       }
@@ -491,9 +492,9 @@ namespace gms {
                       {
                           using namespace gms::common;
                           this->m_Ex  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
                           this->m_Ey  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mny,64ULL);
                      }
 
                      public:
@@ -634,7 +635,7 @@ namespace gms {
                           }
                           else 
                           {
-                             gms_mm_free(this->m_Ex); this->m_Ex = NULL;  
+                             gms_container_free(this->m_Ex); this->m_Ex = NULL;  
                           }  
                      }    
                          
@@ -663,7 +664,7 @@ namespace gms {
                       {
                           using namespace gms::common;
                           this->m_Ex  = (std::complex<float>*)
-                                         gms_mm_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(std::complex<float>)*this->mnx,64ULL);
                        
                      }
                      public: 
@@ -913,12 +914,12 @@ namespace gms {
                               }
                            }
                            else {
-                               gms_mm_free(this->m_Exr);this->m_Exr = NULL;
-                               gms_mm_free(this->m_Exi);this->m_Exi = NULL;
-                               gms_mm_free(this->m_Eyr);this->m_Eyr = NULL;
-                               gms_mm_free(this->m_Eyi);this->m_Eyi = NULL;
-                               gms_mm_free(this->m_Ezr);this->m_Ezr = NULL;
-                               gms_mm_free(this->m_Ezi);this->m_Ezi = NULL;
+                               gms_container_free(this->m_Exr);this->m_Exr = NULL;
+                               gms_container_free(this->m_Exi);this->m_Exi = NULL;
+                               gms_container_free(this->m_Eyr);this->m_Eyr = NULL;
+                               gms_container_free(this->m_Eyi);this->m_Eyi = NULL;
+                               gms_container_free(this->m_Ezr);this->m_Ezr = NULL;
+                               gms_container_free(this->m_Ezi);this->m_Ezi = NULL;
                            }
                       }
                       
@@ -969,12 +970,12 @@ namespace gms {
                    inline void allocate() noexcept(false)
                    {
                         using namespace gms::common;
-                        this->m_Exr  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
-                        this->m_Exi  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
-                        this->m_Eyr  = (float*)gms_mm_malloc(sizeof(float)*this->mny,64ULL);
-                        this->m_Eyi  = (float*)gms_mm_malloc(sizeof(float)*this->mny,64ULL);
-                        this->m_Ezr  = (float*)gms_mm_malloc(sizeof(float)*this->mnz,64ULL);
-                        this->m_Ezi  = (float*)gms_mm_malloc(sizeof(float)*this->mnz,64ULL);
+                        this->m_Exr  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Exi  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Eyr  = (float*)gms_container_malloc(sizeof(float)*this->mny,64ULL);
+                        this->m_Eyi  = (float*)gms_container_malloc(sizeof(float)*this->mny,64ULL);
+                        this->m_Ezr  = (float*)gms_container_malloc(sizeof(float)*this->mnz,64ULL);
+                        this->m_Ezi  = (float*)gms_container_malloc(sizeof(float)*this->mnz,64ULL);
                    }    
                    public:
                    inline void info_size_alignment() const
@@ -1182,10 +1183,10 @@ namespace gms {
                               }
                            }
                            else {
-                               gms_mm_free(this->m_Exr);this->m_Exr = NULL;
-                               gms_mm_free(this->m_Exi);this->m_Exi = NULL;
-                               gms_mm_free(this->m_Eyr);this->m_Eyr = NULL;
-                               gms_mm_free(this->m_Eyi);this->m_Eyi = NULL;
+                               gms_container_free(this->m_Exr);this->m_Exr = NULL;
+                               gms_container_free(this->m_Exi);this->m_Exi = NULL;
+                               gms_container_free(this->m_Eyr);this->m_Eyr = NULL;
+                               gms_container_free(this->m_Eyi);this->m_Eyi = NULL;
                                
                            }
                       }
@@ -1226,10 +1227,10 @@ namespace gms {
                    inline void allocate() noexcept(false)
                    {
                         using namespace gms::common;
-                        this->m_Exr  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
-                        this->m_Exi  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
-                        this->m_Eyr  = (float*)gms_mm_malloc(sizeof(float)*this->mny,64ULL);
-                        this->m_Eyi  = (float*)gms_mm_malloc(sizeof(float)*this->mny,64ULL);
+                        this->m_Exr  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Exi  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Eyr  = (float*)gms_container_malloc(sizeof(float)*this->mny,64ULL);
+                        this->m_Eyi  = (float*)gms_container_malloc(sizeof(float)*this->mny,64ULL);
                        
                    }  
                    public: 
@@ -1387,8 +1388,8 @@ namespace gms {
                               }                             
                            }
                            else {
-                               gms_mm_free(this->m_Exr);this->m_Exr = NULL;
-                               gms_mm_free(this->m_Exi);this->m_Exi = NULL;
+                               gms_container_free(this->m_Exr);this->m_Exr = NULL;
+                               gms_container_free(this->m_Exi);this->m_Exi = NULL;
                                                            
                            }
                       }
@@ -1418,8 +1419,8 @@ namespace gms {
                    inline void allocate() noexcept(false)
                    {
                         using namespace gms::common;
-                        this->m_Exr  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
-                        this->m_Exi  = (float*)gms_mm_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Exr  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
+                        this->m_Exi  = (float*)gms_container_malloc(sizeof(float)*this->mnx,64ULL);
                                              
                    }    
                    public: 
@@ -1457,7 +1458,7 @@ namespace gms {
                           
                           this->m_nx      = 0ULL;
                           this->m_ny      = 0ULL;
-                          this->m_nz      = 0ULL
+                          this->m_nz      = 0ULL;
                           this->m_Ex      = NULL;
                           this->m_Ey      = NULL;
                           this->m_Ez      = NULL;
@@ -1468,9 +1469,9 @@ namespace gms {
                                     const std::size_t nz) noexcept(false)
                     {
                                  
-                          this->m_nx = _nx;
-                          this->m_ny = _ny;
-                          this->m_nz = _nz;
+                          this->m_nx = nx;
+                          this->m_ny = ny;
+                          this->m_nz = nz;
                           allocate();
                           this->ismmap = false;
                       }  
@@ -1586,7 +1587,7 @@ namespace gms {
                           
                           this->m_nx     = rhs.m_nx;
                           this->m_ny     = rhs.m_ny;
-                          this->m_nz     = rhs.m_nz
+                          this->m_nz     = rhs.m_nz;
                           this->m_Ex     = &rhs.m_Ex[0];
                           this->m_Ey     = &rhs.m_Ey[0];
                           this->m_Ez     = &rhs.m_Ez[0];
@@ -1623,9 +1624,9 @@ namespace gms {
                           }
                           else 
                           {
-                              gms_mm_free(this->m_nx); this->m_Ex = NULL;
-                              gms_mm_free(this->m_ny); this->m_Ey = NULL;
-                              gms_mm_free(this->m_nz); this->m_Ez = NULL;
+                              gms_container_free(this->m_Ex); this->m_Ex = NULL;
+                              gms_container_free(this->m_Ey); this->m_Ey = NULL;
+                              gms_container_free(this->m_Ez); this->m_Ez = NULL;
                           }
                       }
                       
@@ -1655,11 +1656,11 @@ namespace gms {
                     {
                         using namespace gms::common;
                         this->m_Ex =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->m_nx,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->m_nx,64ULL);
                         this->m_Ey =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->m_ny,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->m_ny,64ULL);
                         this->m_Ez =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->m_nz,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->m_nz,64ULL);
                        
                     }
 
@@ -1784,8 +1785,6 @@ namespace gms {
                           this->ismmap = false;
                           const std::size_t lenx = sizeof(T)*this->nx;
                           const std::size_t leny = sizeof(T)*this->ny;
-                          const std::size_t lenx = sizeof(T)*this->nx;
-                          const std::size_t leny = sizeof(T)*this->ny;
                           std::memcpy(this->m_Ex,&Ex[0],lenx);
                           std::memcpy(this->m_Ey,&Ey[0],leny); 
                    }  
@@ -1825,8 +1824,8 @@ namespace gms {
                           }
                           else 
                           {
-                              gms_mm_free(this->m_Ex); this->m_Ex = NULL;
-                              gms_mm_free(this->m_Ey); this->m_Ey = NULL; 
+                              gms_container_free(this->m_Ex); this->m_Ex = NULL;
+                              gms_container_free(this->m_Ey); this->m_Ey = NULL; 
                            
                           }
                       }
@@ -1853,9 +1852,9 @@ namespace gms {
                     {
                         using namespace gms::common;
                         this->m_Ex =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->nx,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->nx,64ULL);
                         this->m_Ey =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->ny,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->ny,64ULL);
                                               
                     }
            };
@@ -1980,7 +1979,7 @@ namespace gms {
                           }
                           else 
                           {
-                              gms_mm_free(this->m_Ex); this->m_Ex = NULL;
+                              gms_container_free(this->m_Ex); this->m_Ex = NULL;
                           }                            
                                                                                         
                    }
@@ -2003,7 +2002,7 @@ namespace gms {
                     {
                         using namespace gms::common;
                         this->m_Ex =   (T*)
-                                         gms_mm_malloc(sizeof(T)*this->nx,64ULL);
+                                         gms_container_malloc(sizeof(T)*this->nx,64ULL);
                                                                     
                     }
            };
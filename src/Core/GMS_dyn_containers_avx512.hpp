@@ -26,6 +26,7 @@ namespace file_info {
 #include "GMS_complex_zmm8r8.hpp"
 #include "GMS_complex_zmm16r4.hpp"
 #include "GMS_malloc.h"
+#include "GMS_alloc_policy.h"
 #include "GMS_simd_memops.h"
 
 // Enable non-temporal stores for this class only( used with free-standing operators)
@@ -170,9 +171,9 @@ namespace gms {
                              gms_unmap<zmm8c8_t>(this->mz,this->mnz);
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
-                              gms_mm_free(this->mz);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
+                              gms_container_free(this->mz);
                           }
                       }
                       
@@ -187,9 +188,9 @@ namespace gms {
                              gms_unmap<zmm8c8_t>(this->mz,this->mnz);
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
-                             gms_mm_free(this->mz);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
+                             gms_container_free(this->mz);
                            }
                            this->mnx   = rhs.mnx;
                            this->mny   = rhs.mny;
@@ -209,11 +210,11 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
                           this->my  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
                           this->mz  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
                       }
                       
                      
@@ -335,8 +336,8 @@ namespace gms {
                              
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
                               
                           }
                       }
@@ -352,8 +353,8 @@ namespace gms {
                             
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
                            
                            }
                            this->mnx   = rhs.mnx;
@@ -370,9 +371,9 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
                           this->my  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mny,64ULL);
                     }
                       
                      
@@ -471,7 +472,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<zmm8c8_t>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -484,7 +485,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<zmm8c8_t>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -496,7 +497,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm8c8_t*)
-                                         gms_mm_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm8c8_t)*this->mnx,64ULL);
                          
                     }
                       
@@ -639,9 +640,9 @@ namespace gms {
                              gms_unmap<zmm16c4_t>(this->mz,this->mnz);
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
-                              gms_mm_free(this->mz);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
+                              gms_container_free(this->mz);
                           }
                       }
                       
@@ -656,9 +657,9 @@ namespace gms {
                              gms_unmap<zmm16c4_t>(this->mz,this->mnz);
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
-                             gms_mm_free(this->mz);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
+                             gms_container_free(this->mz);
                            }
                            this->mnx   = rhs.mnx;
                            this->mny   = rhs.mny;
@@ -678,11 +679,11 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
                           this->my  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
                           this->mz  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
                       }
                       
                      
@@ -805,8 +806,8 @@ namespace gms {
                              
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
                               
                           }
                       }
@@ -822,8 +823,8 @@ namespace gms {
                             
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
                            
                            }
                            this->mnx   = rhs.mnx;
@@ -840,9 +841,9 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
                           this->my  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mny,64ULL);
                     }
                       
                      
@@ -941,7 +942,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<zmm16c4_t>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -954,7 +955,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<zmm16c4_t>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -966,7 +967,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (zmm16c4_t*)
-                                         gms_mm_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(zmm16c4_t)*this->mnx,64ULL);
                          
                     }
                       
@@ -1066,7 +1067,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<__m512>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -1079,7 +1080,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<__m512>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -1091,7 +1092,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (__m512*)
-                                         gms_mm_malloc( sizeof(__m512)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(__m512)*this->mnx,64ULL);
                          
                     }
                       
@@ -1192,7 +1193,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<__m512d>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -1205,7 +1206,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<__m512d>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -1217,7 +1218,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (__m512d*)
-                                         gms_mm_malloc( sizeof(__m512d)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(__m512d)*this->mnx,64ULL);
                          
                     }
                       
@@ -26,6 +26,7 @@ namespace file_info {
 #include "GMS_complex_xmm2r8.hpp"
 #include "GMS_complex_xmm4r4.hpp"
 #include "GMS_malloc.h"
+#include "GMS_alloc_policy.h"
 #include "GMS_simd_memops.h"
 
 // Enable non-temporal stores for this class only( used with free-standing operators)
@@ -171,9 +172,9 @@ namespace gms {
                              gms_unmap<xmm2c8_t>(this->mz,this->mnz);
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
-                              gms_mm_free(this->mz);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
+                              gms_container_free(this->mz);
                           }
                       }
                       
@@ -188,9 +189,9 @@ namespace gms {
                              gms_unmap<xmm2c8_t>(this->mz,this->mnz);
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
-                             gms_mm_free(this->mz);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
+                             gms_container_free(this->mz);
                            }
                            this->mnx   = rhs.mnx;
                            this->mny   = rhs.mny;
@@ -210,11 +211,11 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
                           this->my  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
                           this->mz  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
                       }
                       
                      
@@ -336,8 +337,8 @@ namespace gms {
                              
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
                               
                           }
                       }
@@ -353,8 +354,8 @@ namespace gms {
                             
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
                            
                            }
                            this->mnx   = rhs.mnx;
@@ -371,9 +372,9 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
                           this->my  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mny,64ULL);
                     }
                       
                      
@@ -472,7 +473,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<xmm2c8_t>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -485,7 +486,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<xmm2c8_t>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -497,7 +498,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm2c8_t*)
-                                         gms_mm_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm2c8_t)*this->mnx,64ULL);
                          
                     }
                       
@@ -640,9 +641,9 @@ namespace gms {
                              gms_unmap<xmm4c4_t>(this->mz,this->mnz);
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
-                              gms_mm_free(this->mz);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
+                              gms_container_free(this->mz);
                           }
                       }
                       
@@ -657,9 +658,9 @@ namespace gms {
                              gms_unmap<xmm4c4_t>(this->mz,this->mnz);
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
-                             gms_mm_free(this->mz);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
+                             gms_container_free(this->mz);
                            }
                            this->mnx   = rhs.mnx;
                            this->mny   = rhs.mny;
@@ -679,11 +680,11 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
                           this->my  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
                           this->mz  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
                       }
                       
                      
@@ -806,8 +807,8 @@ namespace gms {
                              
                           }
                           else {
-                              gms_mm_free(this->mx);
-                              gms_mm_free(this->my);
+                              gms_container_free(this->mx);
+                              gms_container_free(this->my);
                               
                           }
                       }
@@ -823,8 +824,8 @@ namespace gms {
                             
                            }
                            else {
-                             gms_mm_free(this->mx);
-                             gms_mm_free(this->my);
+                             gms_container_free(this->mx);
+                             gms_container_free(this->my);
                            
                            }
                            this->mnx   = rhs.mnx;
@@ -841,9 +842,9 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
                           this->my  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mny,64ULL);
                     }
                       
                      
@@ -942,7 +943,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<xmm4c4_t>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -955,7 +956,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<xmm4c4_t>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -967,7 +968,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (xmm4c4_t*)
-                                         gms_mm_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(xmm4c4_t)*this->mnx,64ULL);
                          
                     }
                       
@@ -1067,7 +1068,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<__m128>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -1080,7 +1081,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<__m128>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -1092,7 +1093,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (__m128*)
-                                         gms_mm_malloc( sizeof(__m128)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(__m128)*this->mnx,64ULL);
                          
                     }
                       
@@ -1193,7 +1194,7 @@ namespace gms {
                           if(this->issmap) 
                              gms_unmap<__m128d>(this->mx,this->mnx);
                           else 
-                              gms_mm_free(this->mx);   
+                              gms_container_free(this->mx);   
                      }        
                           
                                                  
@@ -1206,7 +1207,7 @@ namespace gms {
                            if(this->ismmap) 
                               gms_unmap<__m128d>(this->mx,this->mnx);
                            else 
-                             gms_mm_free(this->mx); 
+                             gms_container_free(this->mx); 
                                                                                                                          
                            this->mnx   = rhs.mnx;
                            this->mx    = &rhs.mx[0];
@@ -1218,7 +1219,7 @@ namespace gms {
                       inline void allocate() {
                           using namespace gms::common;
                           this->mx  = (__m128d*)
-                                         gms_mm_malloc( sizeof(__m128d)*this->mnx,64ULL);
+                                         gms_container_malloc( sizeof(__m128d)*this->mnx,64ULL);
                          
                     }
                       
@@ -16,6 +16,11 @@ typedef struct __ATTR_ALIGN__(64) GMSH_Mesh {
        double  * __restrict node_x;  //NODE_X[NODE_DIM*NODE_NUM], the node coordinates
        int32_t * __restrict element_node; //ELEMENT_NODE[ELEMENT_ORDER*ELEMENT_NUM], 
                                           //the nodes that make up each element.
+       double  * __restrict node_xs; //NODE_XS[NODE_NUM], x coordinates (SoA, filled by gmsh_mmap_read)
+       double  * __restrict node_ys; //NODE_YS[NODE_NUM], y coordinates
+       double  * __restrict node_zs; //NODE_ZS[NODE_NUM], z coordinates
+       int32_t element_type;         //Gmsh element type code of ELEMENT_NODE (gmsh_mmap_read)
+       int32_t file_version;         //22 (MSH 2.2) or 41 (MSH 4.1)
 }GMSH_mesh;
 
 char ch_cap ( char ch );
@@ -53,5 +58,22 @@ int s_to_i4 ( char *s, int *last, int *error );
 double s_to_r8 ( char *s, int *lchar, int *error );
 void timestamp ( );
 
+/*
+   Single pass, memory mapped reader of ASCII MSH 2.2, ASCII MSH 4.1 and
+   binary (little-endian, 8-byte size_t) MSH 4.1 files.
+   Nodes are returned as SoA arrays (node_xs,node_ys,node_zs), node_x is left NULL.
+   Only the elements of one type are returned: element_type, or if
+   element_type is 0, the most numerous type of the highest dimension.
+   ELEMENT_NODE holds 1-based indices into the node arrays (equal to the
+   node tags of densely numbered files).
+   The ASCII sections are parsed in parallel (OpenMP) chunks of lines.
+   On malformed input a diagnostic is printed and the program exits,
+   as gmsh_data_read does.
+*/
+void gmsh_mmap_read ( const char * gmsh_filename, GMSH_Mesh * mesh, 
+  int32_t element_type );
+// Releases the arrays allocated by gmsh_mmap_read.
+void gmsh_mesh_free ( GMSH_Mesh * mesh );
+
 
 #endif /*__GMS_GMSH_READER_H__*/
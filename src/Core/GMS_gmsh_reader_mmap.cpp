@@ -0,0 +1,933 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <immintrin.h>
+#include <omp.h>
+#include "GMS_gmsh_reader.h"
+
+/*
+   Memory mapped MSH reader.
+   ASCII sections are split into chunks on line boundaries, the lines of
+   each chunk are counted in parallel and the prefix sums give every chunk
+   its first line number. MSH 4.1 block headers are located by a cheap
+   serial walk over those line numbers; the node/element lines themselves
+   are parsed in parallel straight into the output arrays.
+   Binary MSH 4.1 sections are walked block by block and the payload of
+   every block is copied/converted in parallel.
+*/
+
+// Minimal ASCII chunk (bytes), smaller sections are parsed by one thread.
+#if !defined(GMSH_MMAP_MIN_CHUNK)
+#define GMSH_MMAP_MIN_CHUNK 1048576ull
+#endif
+
+// Chunks per thread (load balance of the line parsing).
+#if !defined(GMSH_MMAP_CHUNKS_PER_THREAD)
+#define GMSH_MMAP_CHUNKS_PER_THREAD 8
+#endif
+
+namespace {
+
+struct msh_file_t
+{
+       const char * name;
+       const char * base;
+       const char * end;
+       std::size_t  size;
+       int          fd;
+       int32_t      version;  // 22, 41
+       bool         binary;
+};
+
+[[noreturn]]
+void gmsh_fatal(const msh_file_t & f,const char * what)
+{
+       fprintf ( stderr, "\n" );
+       fprintf ( stderr, "GMSH_MMAP_READ - Fatal error!\n" );
+       fprintf ( stderr, "  %s, file \"%s\"\n", what, f.name );
+       exit ( 1 );
+}
+
+struct elem_info_t
+{
+       int32_t dim;
+       int32_t nnodes;
+};
+
+// Gmsh element types 1..31, 92, 93 (dimension, number of nodes).
+inline elem_info_t elem_info(const int64_t type)
+{
+       static const elem_info_t tab[32] = {
+              {-1,0},
+              {1,2}, {2,3}, {2,4}, {3,4}, {3,8}, {3,6}, {3,5}, {1,3},
+              {2,6}, {2,9}, {3,10},{3,27},{3,18},{3,14},{0,1}, {2,8},
+              {3,20},{3,15},{3,13},{2,9}, {2,10},{2,12},{2,15},{2,15},
+              {2,21},{1,4}, {1,5}, {1,6}, {3,20},{3,35},{3,56}};
+       if(type > 0 && type < 32) return tab[type];
+       if(type == 92) return {3,64};
+       if(type == 93) return {3,125};
+       return {-1,0};
+}
+
+/*
+    Number parsing -- fields are separated by blanks, lines by '\n' ('\r' is a blank).
+*/
+
+inline bool is_digit(const char c)
+{
+       return static_cast<unsigned char>(c-'0') < 10u;
+}
+
+inline const char * skip_blank(const char * p)
+{
+       while(*p == ' ' || *p == '\t' || *p == '\r') ++p;
+       return p;
+}
+
+inline const char * next_line(const char * p,const char * e)
+{
+       const char * q{reinterpret_cast<const char*>(std::memchr(p,'\n',static_cast<std::size_t>(e-p)))};
+       return (q != nullptr) ? q+1 : e;
+}
+
+inline const char * skip_lines(const char * p,const char * e,std::size_t n)
+{
+       while(n-- && p < e) p = next_line(p,e);
+       return p;
+}
+
+inline const char * parse_i64(const char * p,int64_t & v,bool & ok)
+{
+       p = skip_blank(p);
+       const bool neg{*p == '-'};
+       if(*p == '-' || *p == '+') ++p;
+       if(!is_digit(*p)) { ok = false; v = 0; return p; }
+       uint64_t m{0ull};
+       while(is_digit(*p)) { m = 10ull*m + static_cast<uint64_t>(*p-'0'); ++p; }
+       v = neg ? -static_cast<int64_t>(m) : static_cast<int64_t>(m);
+       return p;
+}
+
+inline const char * skip_field(const char * p)
+{
+       p = skip_blank(p);
+       while(*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+       return p;
+}
+
+/*
+    Decimal to double. Mantissas of at most 2^53 scaled by 10^[-22,22] are
+    exact (a single correctly rounded multiply or divide), everything else
+    (long mantissas, large exponents, inf/nan) goes to strtod.
+*/
+inline const char * parse_f64(const char * p,double & v,bool & ok)
+{
+       static const double p10[23] = {1.0e+0,1.0e+1,1.0e+2,1.0e+3,1.0e+4,1.0e+5,1.0e+6,1.0e+7,
+                                      1.0e+8,1.0e+9,1.0e+10,1.0e+11,1.0e+12,1.0e+13,1.0e+14,1.0e+15,
+                                      1.0e+16,1.0e+17,1.0e+18,1.0e+19,1.0e+20,1.0e+21,1.0e+22};
+       const char * s{skip_blank(p)};
+       const char * q{s};
+       const bool neg{*q == '-'};
+       if(*q == '-' || *q == '+') ++q;
+       uint64_t m{0ull};
+       int32_t  nd{0};
+       int32_t  e10{0};
+       bool     dropped{false};
+       bool     any{false};
+       while(is_digit(*q))
+       {
+            any = true;
+            if(nd < 19) { m = 10ull*m + static_cast<uint64_t>(*q-'0'); nd += (m != 0ull); }
+            else        { ++e10; dropped |= (*q != '0'); }
+            ++q;
+       }
+       if(*q == '.')
+       {
+            ++q;
+            while(is_digit(*q))
+            {
+                any = true;
+                if(nd < 19) { m = 10ull*m + static_cast<uint64_t>(*q-'0'); nd += (m != 0ull); --e10; }
+                else        { dropped |= (*q != '0'); }
+                ++q;
+            }
+       }
+       if(any && (*q == 'e' || *q == 'E'))
+       {
+            const char * r{q+1};
+            const bool eneg{*r == '-'};
+            if(*r == '-' || *r == '+') ++r;
+            if(is_digit(*r))
+            {
+                int32_t x{0};
+                while(is_digit(*r)) { if(x < 100000) x = 10*x + (*r-'0'); ++r; }
+                e10 += eneg ? -x : x;
+                q = r;
+            }
+       }
+       if(any && !dropped && m <= 9007199254740992ull && e10 >= -22 && e10 <= 22)
+       {
+            const double d{static_cast<double>(m)};
+            v = (e10 < 0) ? d/p10[-e10] : d*p10[e10];
+            if(neg) v = -v;
+            return q;
+       }
+       char * end{nullptr};
+       v = std::strtod(s,&end);
+       if(end == s) ok = false;
+       return end;
+}
+
+// First byte after the "<tag>" line, nullptr if there is no such section.
+const char * find_section(const char * b,const char * e,const char * tag)
+{
+       const std::size_t tl{std::strlen(tag)};
+       const char * p{b};
+       while(p < e)
+       {
+            const char * q{reinterpret_cast<const char*>(memmem(p,static_cast<std::size_t>(e-p),tag,tl))};
+            if(q == nullptr) return nullptr;
+            const char * r{q+tl};
+            if((q == b || q[-1] == '\n') && r < e && (*r == '\n' || *r == '\r')) return next_line(r,e);
+            p = q+1;
+       }
+       return nullptr;
+}
+
+// Start of the "<tag>" line.
+const char * find_section_end(const char * b,const char * e,const char * tag)
+{
+       const std::size_t tl{std::strlen(tag)};
+       const char * p{b};
+       while(p < e)
+       {
+            const char * q{reinterpret_cast<const char*>(memmem(p,static_cast<std::size_t>(e-p),tag,tl))};
+            if(q == nullptr) return nullptr;
+            if(q == b || q[-1] == '\n') return q;
+            p = q+1;
+       }
+       return nullptr;
+}
+
+void msh_open(msh_file_t & f,const char * name)
+{
+       f.name = name;
+       f.fd   = open(name,O_RDONLY);
+       if(f.fd < 0) gmsh_fatal(f,"Could not open input file");
+       struct stat st;
+       if(fstat(f.fd,&st) != 0 || st.st_size <= 0) gmsh_fatal(f,"Empty or unreadable input file");
+       f.size = static_cast<std::size_t>(st.st_size);
+       void * m{mmap(nullptr,f.size,PROT_READ,MAP_PRIVATE,f.fd,0)};
+       if(m == MAP_FAILED) gmsh_fatal(f,"mmap failed");
+       madvise(m,f.size,MADV_WILLNEED);
+       f.base = reinterpret_cast<const char*>(m);
+       f.end  = f.base+f.size;
+       // $MeshFormat: version file-type data-size
+       const char * p{find_section(f.base,f.end,"$MeshFormat")};
+       if(p == nullptr) gmsh_fatal(f,"Missing $MeshFormat section");
+       bool ok{true};
+       double ver{0.0};
+       int64_t ftype{0}, dsize{0};
+       p = parse_f64(p,ver,ok);
+       p = parse_i64(p,ftype,ok);
+       p = parse_i64(p,dsize,ok);
+       if(!ok) gmsh_fatal(f,"Malformed $MeshFormat section");
+       if(ver >= 2.0 && ver < 3.0)     f.version = 22;
+       else if(ver >= 4.1 && ver < 5.0) f.version = 41;
+       else gmsh_fatal(f,"Unsupported MSH version (2.x and 4.1 are supported)");
+       f.binary = (ftype == 1);
+       if(f.binary)
+       {
+            if(f.version != 41) gmsh_fatal(f,"Binary MSH 2.x is not supported");
+            if(dsize != static_cast<int64_t>(sizeof(std::size_t))) gmsh_fatal(f,"Binary data-size must be 8");
+            p = next_line(p,f.end);
+            int32_t one{0};
+            if(p+sizeof(one) > f.end) gmsh_fatal(f,"Truncated $MeshFormat section");
+            std::memcpy(&one,p,sizeof(one));
+            if(one != 1) gmsh_fatal(f,"Byte-swapped binary MSH is not supported");
+       }
+}
+
+void msh_close(msh_file_t & f)
+{
+       munmap(const_cast<char*>(f.base),f.size);
+       close(f.fd);
+}
+
+/*
+    Line chunks of an ASCII section.
+*/
+struct chunk_t
+{
+       const char * b;
+       const char * e;
+       std::size_t  line0;
+};
+
+std::vector<chunk_t> split_lines(const char * b,const char * e,std::size_t & nlines)
+{
+       const std::size_t len{static_cast<std::size_t>(e-b)};
+       const std::size_t maxc{static_cast<std::size_t>(GMSH_MMAP_CHUNKS_PER_THREAD*omp_get_max_threads())};
+       const std::size_t nc{std::max<std::size_t>(1ull,std::min<std::size_t>(len/GMSH_MMAP_MIN_CHUNK,maxc))};
+       std::vector<chunk_t> ch(nc);
+       const char * prev{b};
+       for(std::size_t k{0ull}; k != nc; ++k)
+       {
+            ch[k].b = prev;
+            const char * q{(k+1ull == nc) ? e : b+((k+1ull)*len)/nc};
+            if(q < prev) q = prev;
+            if(k+1ull != nc && q > b && q < e && q[-1] != '\n') q = next_line(q,e);
+            ch[k].e = q;
+            prev = q;
+       }
+       std::vector<std::size_t> cnt(nc);
+       chunk_t * __restrict pch{ch.data()};
+       std::size_t * __restrict pcnt{cnt.data()};
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(pch,pcnt,nc) if(nc > 1ull)
+       for(std::size_t k = 0ull; k < nc; ++k)
+           pcnt[k] = static_cast<std::size_t>(std::count(pch[k].b,pch[k].e,'\n'));
+       std::size_t s{0ull};
+       for(std::size_t k{0ull}; k != nc; ++k) { ch[k].line0 = s; s += cnt[k]; }
+       nlines = s;
+       return ch;
+}
+
+// Pointer to the line L, sequential from the hint when the hint is in the same chunk.
+struct line_seeker_t
+{
+       const std::vector<chunk_t> & ch;
+       const char * e;
+       const char * hp;
+       std::size_t  hl;
+
+       const char * seek(const std::size_t L)
+       {
+            std::size_t c{static_cast<std::size_t>(std::upper_bound(ch.begin(),ch.end(),L,
+                               [](const std::size_t l,const chunk_t & x){return l < x.line0;}) - ch.begin())};
+            c = (c == 0ull) ? 0ull : c-1ull;
+            if(!(hl >= ch[c].line0 && hl <= L))
+            {
+                hp = ch[c].b;
+                hl = ch[c].line0;
+            }
+            hp = skip_lines(hp,e,L-hl);
+            hl = L;
+            return hp;
+       }
+};
+
+enum run_kind_t : int32_t
+{
+       RUN_SKIP,
+       RUN_NODE_TAG,
+       RUN_NODE_XYZ,
+       RUN_NODE_TAG_XYZ,
+       RUN_ELEM
+};
+
+struct run_t
+{
+       std::size_t line0;
+       std::size_t base;
+       int32_t     kind;
+       int32_t     nn;
+};
+
+struct node_out_t
+{
+       double   * __restrict xs;
+       double   * __restrict ys;
+       double   * __restrict zs;
+       uint64_t * __restrict tags;
+};
+
+/*
+    Parses all lines of the section according to the line runs.
+    Returns false on a malformed line.
+*/
+bool parse_runs(const std::vector<chunk_t> & ch,
+                const std::vector<run_t> & runs,
+                const node_out_t & nd,
+                int32_t * __restrict elem)
+{
+       const std::size_t nc{ch.size()};
+       const chunk_t * __restrict pch{ch.data()};
+       const run_t * __restrict pr{runs.data()};
+       const std::size_t nr{runs.size()};
+       int32_t bad{0};
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(pch,pr,nr,nc,nd,elem) \
+        reduction(|:bad) if(nc > 1ull)
+       for(std::size_t k = 0ull; k < nc; ++k)
+       {
+           const char * p{pch[k].b};
+           const char * const e{pch[k].e};
+           std::size_t L{pch[k].line0};
+           std::size_t r{static_cast<std::size_t>(std::upper_bound(pr,pr+nr,L,
+                             [](const std::size_t l,const run_t & x){return l < x.line0;}) - pr)};
+           r = (r == 0ull) ? 0ull : r-1ull;
+           bool ok{true};
+           while(p < e)
+           {
+                while(r+1ull < nr && pr[r+1ull].line0 <= L) ++r;
+                const run_t & ru{pr[r]};
+                const std::size_t i{ru.base+(L-ru.line0)};
+                switch(ru.kind)
+                {
+                     case RUN_NODE_TAG :
+                     {
+                          int64_t t;
+                          parse_i64(p,t,ok);
+                          nd.tags[i] = static_cast<uint64_t>(t);
+                     }
+                     break;
+                     case RUN_NODE_TAG_XYZ :
+                     {
+                          int64_t t;
+                          p = parse_i64(p,t,ok);
+                          nd.tags[i] = static_cast<uint64_t>(t);
+                     }
+                     // fall through
+                     case RUN_NODE_XYZ :
+                          p = parse_f64(p,nd.xs[i],ok);
+                          p = parse_f64(p,nd.ys[i],ok);
+                          parse_f64(p,nd.zs[i],ok);
+                     break;
+                     case RUN_ELEM :
+                     {
+                          int64_t t;
+                          p = skip_field(p); // element tag
+                          int32_t * __restrict o{&elem[i*static_cast<std::size_t>(ru.nn)]};
+                          for(int32_t j{0}; j != ru.nn; ++j)
+                          {
+                              p = parse_i64(p,t,ok);
+                              o[j] = static_cast<int32_t>(t);
+                          }
+                     }
+                     break;
+                     default :
+                     break;
+                }
+                p = next_line(p,e);
+                ++L;
+           }
+           bad |= !ok;
+       }
+       return bad == 0;
+}
+
+/*
+    Automatic element type: most numerous type of the highest dimension.
+*/
+int32_t select_type(const std::vector<std::size_t> & count)
+{
+       int32_t best{0};
+       int32_t bdim{-1};
+       std::size_t bcnt{0ull};
+       for(std::size_t t{1ull}; t < count.size(); ++t)
+       {
+            if(count[t] == 0ull) continue;
+            const elem_info_t ei{elem_info(static_cast<int64_t>(t))};
+            if(ei.dim < 0) continue;
+            if(ei.dim > bdim || (ei.dim == bdim && count[t] > bcnt))
+            {
+                best = static_cast<int32_t>(t);
+                bdim = ei.dim;
+                bcnt = count[t];
+            }
+       }
+       return best;
+}
+
+constexpr std::size_t MAX_TYPE{128ull};
+
+void alloc_nodes(const msh_file_t & f,GMSH_Mesh * mesh,node_out_t & nd,const std::size_t n)
+{
+       if(n > static_cast<std::size_t>(INT32_MAX)) gmsh_fatal(f,"Too many nodes");
+       const std::size_t nb{std::max<std::size_t>(n,1ull)};
+       nd.xs   = reinterpret_cast<double*>(_mm_malloc(nb*sizeof(double),64ull));
+       nd.ys   = reinterpret_cast<double*>(_mm_malloc(nb*sizeof(double),64ull));
+       nd.zs   = reinterpret_cast<double*>(_mm_malloc(nb*sizeof(double),64ull));
+       nd.tags = reinterpret_cast<uint64_t*>(_mm_malloc(nb*sizeof(uint64_t),64ull));
+       if(!nd.xs || !nd.ys || !nd.zs || !nd.tags) gmsh_fatal(f,"Memory allocation failure (nodes)");
+       mesh->node_num = static_cast<int32_t>(n);
+       mesh->node_xs  = nd.xs;
+       mesh->node_ys  = nd.ys;
+       mesh->node_zs  = nd.zs;
+}
+
+int32_t * alloc_elements(const msh_file_t & f,GMSH_Mesh * mesh,const int32_t type,const std::size_t n)
+{
+       const int32_t nn{elem_info(type).nnodes};
+       if(n*static_cast<std::size_t>(nn) > static_cast<std::size_t>(INT32_MAX)) gmsh_fatal(f,"Too many elements");
+       const std::size_t nb{std::max<std::size_t>(n*static_cast<std::size_t>(nn),1ull)};
+       int32_t * e{reinterpret_cast<int32_t*>(_mm_malloc(nb*sizeof(int32_t),64ull))};
+       if(e == nullptr) gmsh_fatal(f,"Memory allocation failure (elements)");
+       mesh->element_type  = type;
+       mesh->element_order = nn;
+       mesh->element_num   = static_cast<int32_t>(n);
+       mesh->element_node  = e;
+       return e;
+}
+
+/*
+    Node tags -> 1-based node indices. Densely numbered files (tag of node i == i+1)
+    need no map, otherwise a tag indexed map is built.
+    Element references are then checked/translated in place.
+*/
+void finalize_refs(const msh_file_t & f,GMSH_Mesh * mesh,node_out_t & nd)
+{
+       const std::size_t n{static_cast<std::size_t>(mesh->node_num)};
+       const uint64_t * __restrict tags{nd.tags};
+       int32_t dense{1};
+       uint64_t maxtag{0ull};
+#pragma omp parallel for schedule(static) default(none) shared(tags,n) \
+        reduction(&:dense) reduction(max:maxtag)
+       for(std::size_t i = 0ull; i < n; ++i)
+       {
+           dense &= (tags[i] == i+1ull);
+           maxtag = std::max(maxtag,tags[i]);
+       }
+       const std::size_t ne{static_cast<std::size_t>(mesh->element_num)*static_cast<std::size_t>(mesh->element_order)};
+       int32_t * __restrict en{mesh->element_node};
+       int32_t bad{0};
+       if(dense)
+       {
+           const int64_t nn{static_cast<int64_t>(n)};
+#pragma omp parallel for schedule(static) default(none) shared(en,ne,nn) reduction(|:bad)
+           for(std::size_t i = 0ull; i < ne; ++i)
+               bad |= (en[i] < 1 || en[i] > nn);
+       }
+       else
+       {
+           if(maxtag > static_cast<uint64_t>(INT32_MAX)) gmsh_fatal(f,"Node tags beyond 2^31-1 are not supported");
+           const std::size_t nm{static_cast<std::size_t>(maxtag)+1ull};
+           int32_t * __restrict map{reinterpret_cast<int32_t*>(_mm_malloc(nm*sizeof(int32_t),64ull))};
+           if(map == nullptr) gmsh_fatal(f,"Memory allocation failure (node map)");
+#pragma omp parallel default(none) shared(map,nm,tags,n,en,ne) reduction(|:bad)
+           {
+#pragma omp for schedule(static)
+               for(std::size_t i = 0ull; i < nm; ++i) map[i] = 0;
+#pragma omp for schedule(static)
+               for(std::size_t i = 0ull; i < n; ++i) map[tags[i]] = static_cast<int32_t>(i+1ull);
+#pragma omp for schedule(static)
+               for(std::size_t i = 0ull; i < ne; ++i)
+               {
+                   const int32_t t{en[i]};
+                   const int32_t v{(t > 0 && static_cast<std::size_t>(t) < nm) ? map[t] : 0};
+                   bad |= (v == 0);
+                   en[i] = v;
+               }
+           }
+           _mm_free(map);
+       }
+       _mm_free(nd.tags);
+       nd.tags = nullptr;
+       if(bad) gmsh_fatal(f,"Element references an undefined node");
+}
+
+// Spatial dimension guess of gmsh_size_read (constant z -> 2D, constant y as well -> 1D).
+void guess_node_dim(GMSH_Mesh * mesh)
+{
+       const std::size_t n{static_cast<std::size_t>(mesh->node_num)};
+       const double * __restrict ys{mesh->node_ys};
+       const double * __restrict zs{mesh->node_zs};
+       double ymin{1.0e+300}, ymax{-1.0e+300}, zmin{1.0e+300}, zmax{-1.0e+300};
+#pragma omp parallel for schedule(static) default(none) shared(ys,zs,n) \
+        reduction(min:ymin,zmin) reduction(max:ymax,zmax)
+       for(std::size_t i = 0ull; i < n; ++i)
+       {
+           ymin = std::min(ymin,ys[i]); ymax = std::max(ymax,ys[i]);
+           zmin = std::min(zmin,zs[i]); zmax = std::max(zmax,zs[i]);
+       }
+       mesh->node_dim = 3;
+       if(zmax == zmin)
+       {
+           mesh->node_dim = 2;
+           if(ymax == ymin) mesh->node_dim = 1;
+       }
+}
+
+/*
+    ASCII MSH 2.2
+*/
+void read_ascii22(const msh_file_t & f,GMSH_Mesh * mesh,const int32_t req_type)
+{
+       node_out_t nd;
+       bool ok{true};
+       // $Nodes: count, then "tag x y z" lines
+       const char * b{find_section(f.base,f.end,"$Nodes")};
+       const char * e{(b != nullptr) ? find_section_end(b,f.end,"$EndNodes") : nullptr};
+       if(e == nullptr) gmsh_fatal(f,"Missing $Nodes/$EndNodes section");
+       int64_t cnt{0};
+       b = next_line(parse_i64(b,cnt,ok),e);
+       if(!ok || cnt < 0) gmsh_fatal(f,"Malformed $Nodes section");
+       std::size_t nlines{0ull};
+       std::vector<chunk_t> ch{split_lines(b,e,nlines)};
+       if(nlines != static_cast<std::size_t>(cnt)) gmsh_fatal(f,"Node count does not match the $Nodes section");
+       alloc_nodes(f,mesh,nd,static_cast<std::size_t>(cnt));
+       std::vector<run_t> runs{{0ull,0ull,RUN_NODE_TAG_XYZ,0}};
+       if(!parse_runs(ch,runs,nd,nullptr)) gmsh_fatal(f,"Malformed node line");
+       // $Elements: count, then "tag type ntags <tags> <nodes>" lines
+       b = find_section(e,f.end,"$Elements");
+       e = (b != nullptr) ? find_section_end(b,f.end,"$EndElements") : nullptr;
+       if(e == nullptr) gmsh_fatal(f,"Missing $Elements/$EndElements section");
+       b = next_line(parse_i64(b,cnt,ok),e);
+       if(!ok || cnt < 0) gmsh_fatal(f,"Malformed $Elements section");
+       ch = split_lines(b,e,nlines);
+       if(nlines != static_cast<std::size_t>(cnt)) gmsh_fatal(f,"Element count does not match the $Elements section");
+       // pass 1: per chunk histogram of the element types
+       const std::size_t nc{ch.size()};
+       std::vector<std::size_t> hist(nc*MAX_TYPE,0ull);
+       const chunk_t * __restrict pch{ch.data()};
+       std::size_t * __restrict ph{hist.data()};
+       int32_t bad{0};
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(pch,ph,nc) reduction(|:bad) if(nc > 1ull)
+       for(std::size_t k = 0ull; k < nc; ++k)
+       {
+           bool lok{true};
+           const char * p{pch[k].b};
+           while(p < pch[k].e)
+           {
+                int64_t t;
+                p = skip_field(p);
+                parse_i64(p,t,lok);
+                if(t > 0 && static_cast<std::size_t>(t) < MAX_TYPE) ++ph[k*MAX_TYPE+static_cast<std::size_t>(t)];
+                p = next_line(p,pch[k].e);
+           }
+           bad |= !lok;
+       }
+       if(bad) gmsh_fatal(f,"Malformed element line");
+       std::vector<std::size_t> tot(MAX_TYPE,0ull);
+       for(std::size_t k{0ull}; k != nc; ++k)
+           for(std::size_t t{0ull}; t != MAX_TYPE; ++t) tot[t] += hist[k*MAX_TYPE+t];
+       const int32_t type{(req_type > 0) ? req_type : select_type(tot)};
+       if(type <= 0 || elem_info(type).nnodes == 0 || static_cast<std::size_t>(type) >= MAX_TYPE)
+           gmsh_fatal(f,"No supported elements");
+       std::vector<std::size_t> base(nc+1ull,0ull);
+       for(std::size_t k{0ull}; k != nc; ++k) base[k+1ull] = base[k]+hist[k*MAX_TYPE+static_cast<std::size_t>(type)];
+       int32_t * __restrict elem{alloc_elements(f,mesh,type,base[nc])};
+       const int32_t nn{mesh->element_order};
+       const std::size_t * __restrict pb{base.data()};
+       // pass 2: the lines of the selected type
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(pch,pb,nc,elem,nn,type) reduction(|:bad) if(nc > 1ull)
+       for(std::size_t k = 0ull; k < nc; ++k)
+       {
+           bool lok{true};
+           std::size_t i{pb[k]};
+           const char * p{pch[k].b};
+           while(p < pch[k].e)
+           {
+                int64_t t, ntags;
+                p = skip_field(p);
+                p = parse_i64(p,t,lok);
+                if(t == type)
+                {
+                    p = parse_i64(p,ntags,lok);
+                    for(int64_t j{0}; j < ntags; ++j) p = skip_field(p);
+                    int32_t * __restrict o{&elem[i*static_cast<std::size_t>(nn)]};
+                    for(int32_t j{0}; j != nn; ++j)
+                    {
+                        int64_t v;
+                        p = parse_i64(p,v,lok);
+                        o[j] = static_cast<int32_t>(v);
+                    }
+                    ++i;
+                }
+                p = next_line(p,pch[k].e);
+           }
+           bad |= !lok;
+       }
+       if(bad) gmsh_fatal(f,"Malformed element line");
+       finalize_refs(f,mesh,nd);
+}
+
+/*
+    ASCII MSH 4.1
+*/
+void read_ascii41(const msh_file_t & f,GMSH_Mesh * mesh,const int32_t req_type)
+{
+       node_out_t nd;
+       bool ok{true};
+       // $Nodes: numBlocks numNodes minTag maxTag, blocks of
+       // "dim tag parametric n", n tag lines, n coordinate lines
+       const char * b{find_section(f.base,f.end,"$Nodes")};
+       const char * e{(b != nullptr) ? find_section_end(b,f.end,"$EndNodes") : nullptr};
+       if(e == nullptr) gmsh_fatal(f,"Missing $Nodes/$EndNodes section");
+       std::size_t nlines{0ull};
+       std::vector<chunk_t> ch{split_lines(b,e,nlines)};
+       int64_t nblk{0}, nnod{0}, tmin{0}, tmax{0};
+       const char * p{parse_i64(b,nblk,ok)};
+       p = parse_i64(p,nnod,ok);
+       p = parse_i64(p,tmin,ok);
+       parse_i64(p,tmax,ok);
+       if(!ok || nblk < 0 || nnod < 0) gmsh_fatal(f,"Malformed $Nodes section");
+       alloc_nodes(f,mesh,nd,static_cast<std::size_t>(nnod));
+       std::vector<run_t> runs;
+       runs.reserve(3ull*static_cast<std::size_t>(nblk)+2ull);
+       runs.push_back({0ull,0ull,RUN_SKIP,0});
+       line_seeker_t sk{ch,e,b,0ull};
+       std::size_t L{1ull};
+       std::size_t base{0ull};
+       for(int64_t k{0}; k != nblk; ++k)
+       {
+            int64_t dim, tag, par, n;
+            if(L >= nlines) gmsh_fatal(f,"Truncated $Nodes section");
+            p = parse_i64(sk.seek(L),dim,ok);
+            p = parse_i64(p,tag,ok);
+            p = parse_i64(p,par,ok);
+            parse_i64(p,n,ok);
+            if(!ok || n < 0) gmsh_fatal(f,"Malformed node block header");
+            const std::size_t un{static_cast<std::size_t>(n)};
+            runs.push_back({L,0ull,RUN_SKIP,0});
+            runs.push_back({L+1ull,base,RUN_NODE_TAG,0});
+            runs.push_back({L+1ull+un,base,RUN_NODE_XYZ,0});
+            L += 1ull+2ull*un;
+            base += un;
+       }
+       if(L != nlines || base != static_cast<std::size_t>(nnod)) gmsh_fatal(f,"Node count does not match the $Nodes section");
+       runs.push_back({L,0ull,RUN_SKIP,0});
+       if(!parse_runs(ch,runs,nd,nullptr)) gmsh_fatal(f,"Malformed node line");
+       // $Elements: numBlocks numElements minTag maxTag, blocks of
+       // "dim tag type n", n lines of "tag node..."
+       b = find_section(e,f.end,"$Elements");
+       e = (b != nullptr) ? find_section_end(b,f.end,"$EndElements") : nullptr;
+       if(e == nullptr) gmsh_fatal(f,"Missing $Elements/$EndElements section");
+       ch = split_lines(b,e,nlines);
+       p = parse_i64(b,nblk,ok);
+       if(!ok || nblk < 0) gmsh_fatal(f,"Malformed $Elements section");
+       struct eblk_t { std::size_t L; std::size_t n; int32_t type; };
+       std::vector<eblk_t> blks(static_cast<std::size_t>(nblk));
+       std::vector<std::size_t> tot(MAX_TYPE,0ull);
+       line_seeker_t ske{ch,e,b,0ull};
+       L = 1ull;
+       for(eblk_t & bk : blks)
+       {
+            int64_t dim, tag, type, n;
+            if(L >= nlines) gmsh_fatal(f,"Truncated $Elements section");
+            p = parse_i64(ske.seek(L),dim,ok);
+            p = parse_i64(p,tag,ok);
+            p = parse_i64(p,type,ok);
+            parse_i64(p,n,ok);
+            if(!ok || n < 0 || type <= 0) gmsh_fatal(f,"Malformed element block header");
+            bk = {L,static_cast<std::size_t>(n),static_cast<int32_t>(type)};
+            if(static_cast<std::size_t>(type) < MAX_TYPE) tot[static_cast<std::size_t>(type)] += bk.n;
+            L += 1ull+bk.n;
+       }
+       if(L != nlines) gmsh_fatal(f,"Element count does not match the $Elements section");
+       const int32_t type{(req_type > 0) ? req_type : select_type(tot)};
+       const int32_t nn{elem_info(type).nnodes};
+       if(nn == 0) gmsh_fatal(f,"No supported elements");
+       runs.clear();
+       runs.push_back({0ull,0ull,RUN_SKIP,0});
+       base = 0ull;
+       for(const eblk_t & bk : blks)
+       {
+            runs.push_back({bk.L,0ull,RUN_SKIP,0});
+            if(bk.type == type)
+            {
+                runs.push_back({bk.L+1ull,base,RUN_ELEM,nn});
+                base += bk.n;
+            }
+       }
+       runs.push_back({L,0ull,RUN_SKIP,0});
+       int32_t * __restrict elem{alloc_elements(f,mesh,type,base)};
+       if(!parse_runs(ch,runs,nd,elem)) gmsh_fatal(f,"Malformed element line");
+       finalize_refs(f,mesh,nd);
+}
+
+/*
+    Binary MSH 4.1 (little endian, sizeof(size_t) == 8, unaligned payload).
+*/
+struct bin_reader_t
+{
+       const msh_file_t & f;
+       const char * p;
+
+       template<typename T>
+       T get()
+       {
+            T v;
+            if(p+sizeof(T) > f.end) gmsh_fatal(f,"Truncated binary section");
+            std::memcpy(&v,p,sizeof(T));
+            p += sizeof(T);
+            return v;
+       }
+
+       const char * take(const std::size_t nbytes)
+       {
+            if(nbytes > static_cast<std::size_t>(f.end-p)) gmsh_fatal(f,"Truncated binary section");
+            const char * q{p};
+            p += nbytes;
+            return q;
+       }
+};
+
+void read_binary41(const msh_file_t & f,GMSH_Mesh * mesh,const int32_t req_type)
+{
+       node_out_t nd;
+       const char * b{find_section(f.base,f.end,"$Nodes")};
+       if(b == nullptr) gmsh_fatal(f,"Missing $Nodes section");
+       bin_reader_t br{f,b};
+       const std::size_t nblk{br.get<std::size_t>()};
+       const std::size_t nnod{br.get<std::size_t>()};
+       br.get<std::size_t>(); // min tag
+       br.get<std::size_t>(); // max tag
+       alloc_nodes(f,mesh,nd,nnod);
+       struct nblk_t { const char * tags; const char * xyz; std::size_t n; std::size_t stride; std::size_t base; };
+       std::vector<nblk_t> nb(nblk);
+       std::size_t base{0ull};
+       for(nblk_t & bk : nb)
+       {
+            const int32_t dim{br.get<int32_t>()};
+            br.get<int32_t>();
+            const int32_t par{br.get<int32_t>()};
+            bk.n      = br.get<std::size_t>();
+            bk.stride = 3ull+((par != 0) ? static_cast<std::size_t>(dim) : 0ull);
+            bk.base   = base;
+            if(bk.n > nnod-base) gmsh_fatal(f,"Node count does not match the $Nodes section");
+            bk.tags   = br.take(bk.n*sizeof(std::size_t));
+            bk.xyz    = br.take(bk.n*bk.stride*sizeof(double));
+            base += bk.n;
+       }
+       if(base != nnod) gmsh_fatal(f,"Node count does not match the $Nodes section");
+       const nblk_t * __restrict pnb{nb.data()};
+#pragma omp parallel default(none) shared(pnb,nblk,nd)
+       for(std::size_t k = 0ull; k < nblk; ++k)
+       {
+           const nblk_t bk{pnb[k]};
+#pragma omp for schedule(static) nowait
+           for(std::size_t i = 0ull; i < bk.n; ++i)
+           {
+               double c[3];
+               std::memcpy(&nd.tags[bk.base+i],bk.tags+i*sizeof(std::size_t),sizeof(std::size_t));
+               std::memcpy(&c[0],bk.xyz+i*bk.stride*sizeof(double),sizeof(c));
+               nd.xs[bk.base+i] = c[0];
+               nd.ys[bk.base+i] = c[1];
+               nd.zs[bk.base+i] = c[2];
+           }
+       }
+       // $Elements
+       b = find_section(br.p,f.end,"$Elements");
+       if(b == nullptr) gmsh_fatal(f,"Missing $Elements section");
+       br.p = b;
+       const std::size_t neblk{br.get<std::size_t>()};
+       br.get<std::size_t>(); // number of elements
+       br.get<std::size_t>(); // min tag
+       br.get<std::size_t>(); // max tag
+       struct eblk_t { const char * data; std::size_t n; std::size_t base; int32_t type; int32_t nn; };
+       std::vector<eblk_t> eb(neblk);
+       std::vector<std::size_t> tot(MAX_TYPE,0ull);
+       for(eblk_t & bk : eb)
+       {
+            br.get<int32_t>();
+            br.get<int32_t>();
+            bk.type = br.get<int32_t>();
+            bk.n    = br.get<std::size_t>();
+            bk.nn   = elem_info(bk.type).nnodes;
+            if(bk.nn == 0) gmsh_fatal(f,"Unsupported element type in binary file");
+            bk.data = br.take(bk.n*(1ull+static_cast<std::size_t>(bk.nn))*sizeof(std::size_t));
+            if(static_cast<std::size_t>(bk.type) < MAX_TYPE) tot[static_cast<std::size_t>(bk.type)] += bk.n;
+       }
+       const int32_t type{(req_type > 0) ? req_type : select_type(tot)};
+       const int32_t nn{elem_info(type).nnodes};
+       if(nn == 0) gmsh_fatal(f,"No supported elements");
+       base = 0ull;
+       for(eblk_t & bk : eb)
+       {
+            bk.base = base;
+            if(bk.type == type) base += bk.n;
+       }
+       int32_t * __restrict elem{alloc_elements(f,mesh,type,base)};
+       const eblk_t * __restrict peb{eb.data()};
+       int32_t bad{0};
+#pragma omp parallel default(none) shared(peb,neblk,elem,type,nn) reduction(|:bad)
+       for(std::size_t k = 0ull; k < neblk; ++k)
+       {
+           const eblk_t bk{peb[k]};
+           if(bk.type != type) continue;
+           const std::size_t rec{1ull+static_cast<std::size_t>(nn)};
+#pragma omp for schedule(static) nowait
+           for(std::size_t i = 0ull; i < bk.n; ++i)
+           {
+               const char * __restrict s{bk.data+(i*rec+1ull)*sizeof(std::size_t)};
+               int32_t * __restrict o{&elem[(bk.base+i)*static_cast<std::size_t>(nn)]};
+               for(int32_t j{0}; j != nn; ++j)
+               {
+                   std::size_t t;
+                   std::memcpy(&t,s+static_cast<std::size_t>(j)*sizeof(std::size_t),sizeof(t));
+                   bad |= (t > static_cast<std::size_t>(INT32_MAX));
+                   o[j] = static_cast<int32_t>(t);
+               }
+           }
+       }
+       if(bad) gmsh_fatal(f,"Node tags beyond 2^31-1 are not supported");
+       finalize_refs(f,mesh,nd);
+}
+
+} // anonymous
+
+/******************************************************************************/
+
+void gmsh_mmap_read ( const char * gmsh_filename, GMSH_Mesh * mesh,
+  int32_t element_type )
+
+/******************************************************************************/
+{
+       msh_file_t f{};
+       std::memset(mesh,0,sizeof(GMSH_Mesh));
+       msh_open(f,gmsh_filename);
+       mesh->file_version = f.version;
+       if(f.version == 22)
+           read_ascii22(f,mesh,element_type);
+       else if(f.binary)
+           read_binary41(f,mesh,element_type);
+       else
+           read_ascii41(f,mesh,element_type);
+       guess_node_dim(mesh);
+       msh_close(f);
+}
+
+/******************************************************************************/
+
+void gmsh_mesh_free ( GMSH_Mesh * mesh )
+
+/******************************************************************************/
+{
+       if(mesh->node_xs)      _mm_free(mesh->node_xs);
+       if(mesh->node_ys)      _mm_free(mesh->node_ys);
+       if(mesh->node_zs)      _mm_free(mesh->node_zs);
+       if(mesh->element_node) _mm_free(mesh->element_node);
+       mesh->node_xs      = nullptr;
+       mesh->node_ys      = nullptr;
+       mesh->node_zs      = nullptr;
+       mesh->element_node = nullptr;
+       mesh->node_num     = 0;
+       mesh->element_num  = 0;
+}
@@ -0,0 +1,348 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#include <sys/mman.h>
+#include <linux/mman.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_large_alloc.h"
+
+namespace
+{
+
+       using gms::common::page_kind;
+       using gms::common::numa_place;
+       using gms::common::touch_kind;
+       using gms::common::large_alloc_opts_t;
+
+       constexpr std::size_t PAGE_4KiB{4096ull};
+       constexpr std::size_t PAGE_2MiB{2097152ull};
+       constexpr std::size_t PAGE_1GiB{1073741824ull};
+
+       __ATTR_ALWAYS_INLINE__
+       inline std::size_t round_up(const std::size_t x,const std::size_t a)
+       {
+              return ((x+a-1ull)/a*a);
+       }
+
+       // base -> mapped length
+       std::mutex                              g_map_mtx;
+       std::unordered_map<void*,std::size_t>   g_maps;
+
+       void * map_hugetlb(const std::size_t len,const int32_t flag)
+       {
+              void * ptr{mmap(NULL,len,PROT_READ | PROT_WRITE,
+                              MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB | flag,-1,0)};
+              return ((ptr == MAP_FAILED) ? nullptr : ptr);
+       }
+
+       // 4KiB pages, the start aligned to 2MiB (a precondition of the THP)
+       void * map_aligned(const std::size_t len)
+       {
+              const std::size_t over{len+PAGE_2MiB};
+              void * ptr{mmap(NULL,over,PROT_READ | PROT_WRITE,MAP_ANONYMOUS | MAP_PRIVATE,-1,0)};
+              if(ptr == MAP_FAILED) return (nullptr);
+              const std::uintptr_t b{reinterpret_cast<std::uintptr_t>(ptr)};
+              const std::uintptr_t a{round_up(b,PAGE_2MiB)};
+              if(a != b) munmap(ptr,a-b);
+              const std::size_t tail{over-(a-b)-len};
+              if(tail != 0ull) munmap(reinterpret_cast<void*>(a+len),tail);
+              return (reinterpret_cast<void*>(a));
+       }
+
+       constexpr int32_t MAX_NODES{1024};
+
+       /*
+            The mask of the online nodes from the node list of the sysfs (e.g.
+            "0-1" or "0,2-3", the ids need not be contiguous), returns their
+            number; node 0 alone when the list is not available.
+       */
+       int32_t online_node_mask(unsigned long (&mask)[MAX_NODES/64])
+       {
+              std::fill(&mask[0],&mask[0]+MAX_NODES/64,0ul);
+              int32_t cnt{0};
+              FILE * fp{std::fopen("/sys/devices/system/node/online","r")};
+              if(fp != nullptr)
+              {
+                     char buf[256] = {};
+                     const bool ok{std::fgets(buf,sizeof(buf),fp) != nullptr};
+                     std::fclose(fp);
+                     const char * s{buf};
+                     while(ok && *s != '\0')
+                     {
+                            char * e{nullptr};
+                            const long a{std::strtol(s,&e,10)};
+                            if(e == s) break;
+                            long b{a};
+                            if(*e == '-')
+                            {
+                                   s = e+1;
+                                   b = std::strtol(s,&e,10);
+                                   if(e == s) break;
+                            }
+                            for(long __n{std::max(a,0l)}; __n <= b && __n < MAX_NODES; ++__n)
+                            {
+                                   const unsigned long bit{1ul << (__n%64)};
+                                   if((mask[__n/64] & bit) == 0ul) ++cnt;
+                                   mask[__n/64] |= bit;
+                            }
+                            if(*e != ',') break;
+                            s = e+1;
+                     }
+              }
+              if(cnt == 0)
+              {
+                     mask[0] = 1ul;
+                     cnt = 1;
+              }
+              return (cnt);
+       }
+
+       bool apply_numa(void * ptr,const std::size_t len,const numa_place numa,const unsigned long (&nodes)[MAX_NODES/64])
+       {
+              if(numa == numa_place::NONE) return (true);
+              const int32_t mode{(numa == numa_place::INTERLEAVE) ? MPOL_INTERLEAVE : MPOL_LOCAL};
+              const long ret{syscall(SYS_mbind,ptr,len,mode,
+                                     (mode == MPOL_LOCAL) ? nullptr : &nodes[0],
+                                     (mode == MPOL_LOCAL) ? 0ul : static_cast<unsigned long>(MAX_NODES)+1ul,0u)};
+              return (ret == 0l);
+       }
+
+       // one store per page start within [a,b)
+       __ATTR_ALWAYS_INLINE__
+       inline void touch_range(volatile char * p,const std::size_t a,const std::size_t b)
+       {
+              for(std::size_t __o{round_up(a,PAGE_4KiB)}; __o < b; __o += PAGE_4KiB) p[__o] = 0;
+       }
+
+}
+
+const char *
+gms::common::page_kind_name(const page_kind k)
+{
+       switch(k)
+       {
+              case page_kind::AUTO         : return "AUTO";
+              case page_kind::HUGETLB_1GiB : return "HUGETLB_1GiB";
+              case page_kind::HUGETLB_2MiB : return "HUGETLB_2MiB";
+              case page_kind::THP          : return "THP";
+              case page_kind::PAGES_4KiB   : return "PAGES_4KiB";
+       }
+       return "UNKNOWN";
+}
+
+const char *
+gms::common::numa_place_name(const numa_place k)
+{
+       switch(k)
+       {
+              case numa_place::NONE       : return "NONE";
+              case numa_place::LOCAL      : return "LOCAL";
+              case numa_place::INTERLEAVE : return "INTERLEAVE";
+       }
+       return "UNKNOWN";
+}
+
+int32_t
+gms::common::numa_nodes_online()
+{
+       unsigned long mask[MAX_NODES/64];
+       return (online_node_mask(mask));
+}
+
+gms::common::large_alloc_opts_t
+gms::common::large_alloc_opts_from_env()
+{
+       large_alloc_opts_t o{};
+       if(const char * v = std::getenv("GMS_PAGES"))
+       {
+              if(!std::strcmp(v,"1g"))       o.page = page_kind::HUGETLB_1GiB;
+              else if(!std::strcmp(v,"2m"))  o.page = page_kind::HUGETLB_2MiB;
+              else if(!std::strcmp(v,"thp")) o.page = page_kind::THP;
+              else if(!std::strcmp(v,"4k"))  o.page = page_kind::PAGES_4KiB;
+       }
+       if(const char * v = std::getenv("GMS_NUMA"))
+       {
+              if(!std::strcmp(v,"local"))           o.numa = numa_place::LOCAL;
+              else if(!std::strcmp(v,"interleave")) o.numa = numa_place::INTERLEAVE;
+       }
+       if(const char * v = std::getenv("GMS_FIRST_TOUCH"))
+       {
+              if(!std::strcmp(v,"none"))        o.touch = touch_kind::NONE;
+              else if(!std::strcmp(v,"serial")) o.touch = touch_kind::SERIAL;
+       }
+       return (o);
+}
+
+void *
+gms::common::gms_large_malloc(const std::size_t nbytes,
+                              const large_alloc_opts_t & opts,
+                              large_alloc_info_t * info)
+{
+       const std::size_t req{nbytes == 0ull ? 1ull : nbytes};
+       void * ptr{nullptr};
+       std::size_t len{0ull};
+       page_kind got{page_kind::PAGES_4KiB};
+       // HUGETLB_1GiB -> HUGETLB_2MiB -> THP -> PAGES_4KiB, AUTO skips the 1GiB step
+       const int32_t first{opts.page == page_kind::AUTO ? static_cast<int32_t>(page_kind::HUGETLB_2MiB) :
+                                                          static_cast<int32_t>(opts.page)};
+       for(int32_t __k{first}; ptr == nullptr && __k <= static_cast<int32_t>(page_kind::PAGES_4KiB); ++__k)
+       {
+              got = static_cast<page_kind>(__k);
+              switch(got)
+              {
+                     case page_kind::HUGETLB_1GiB :
+                          len = round_up(req,PAGE_1GiB);
+                          ptr = map_hugetlb(len,MAP_HUGE_1GB);
+                     break;
+                     case page_kind::HUGETLB_2MiB :
+                          len = round_up(req,PAGE_2MiB);
+                          ptr = map_hugetlb(len,MAP_HUGE_2MB);
+                     break;
+                     case page_kind::THP :
+                          len = round_up(req,PAGE_2MiB);
+                          ptr = map_aligned(len);
+                          if(ptr != nullptr && madvise(ptr,len,MADV_HUGEPAGE) != 0)
+                          {
+                                 // THP disabled, kept as the 4KiB pages
+                                 got = page_kind::PAGES_4KiB;
+                          }
+                     break;
+                     default :
+                          len = round_up(req,PAGE_4KiB);
+                          ptr = map_aligned(len);
+              }
+       }
+       if(ptr == nullptr)
+       {
+              std::fprintf(stderr,"[%s:%s]: %s -- failed to map %zu bytes: %s!!\n",__DATE__,__TIME__,
+                           __PRETTY_FUNCTION__,req,std::strerror(errno));
+              std::exit(EXIT_FAILURE);
+       }
+       unsigned long nodes[MAX_NODES/64];
+       const int32_t nnodes{online_node_mask(nodes)};
+       const bool mb{apply_numa(ptr,len,opts.numa,nodes)};
+       {
+              std::lock_guard<std::mutex> lck(g_map_mtx);
+              g_maps[ptr] = len;
+       }
+       gms_first_touch(ptr,len,opts);
+       if(info != nullptr)
+       {
+              info->bytes_req    = nbytes;
+              info->bytes_mapped = len;
+              info->page         = got;
+              info->numa         = opts.numa;
+              info->mbind_ok     = mb;
+              info->n_nodes      = nnodes;
+       }
+       return (ptr);
+}
+
+void
+gms::common::gms_large_free(void * ptr)
+{
+       if(ptr == nullptr) return;
+       std::size_t len{0ull};
+       {
+              std::lock_guard<std::mutex> lck(g_map_mtx);
+              auto it{g_maps.find(ptr)};
+              if(it == g_maps.end())
+              {
+                     std::fprintf(stderr,"[%s:%s]: %s -- %p was not allocated by gms_large_malloc!!\n",
+                                  __DATE__,__TIME__,__PRETTY_FUNCTION__,ptr);
+                     std::abort();
+              }
+              len = it->second;
+              g_maps.erase(it);
+       }
+       munmap(ptr,len);
+}
+
+void
+gms::common::gms_first_touch(void * __restrict p,
+                             const std::size_t nbytes,
+                             const large_alloc_opts_t & opts)
+{
+       volatile char * c{reinterpret_cast<volatile char*>(p)};
+       if(opts.touch == touch_kind::NONE) return;
+       if(opts.touch == touch_kind::SERIAL)
+       {
+              touch_range(c,0ull,nbytes);
+              return;
+       }
+       // the iteration space of the *_unrollNx_omp kernels: for(j = m; j < n; j += U)
+       const std::size_t E{opts.elem_bytes == 0ull ? 64ull : opts.elem_bytes};
+       const std::size_t U{opts.unroll < 1 ? 1ull : static_cast<std::size_t>(opts.unroll)};
+       const std::size_t n{nbytes/E};
+       const std::size_t m{n%U};
+       touch_range(c,0ull,m*E);
+       const int64_t nsteps{static_cast<int64_t>((n-m)/U)};
+#pragma omp parallel for schedule(runtime) default(none) firstprivate(c,E,U,m,nsteps)
+       for(int64_t __s = 0; __s < nsteps; ++__s)
+       {
+              const std::size_t j{m+static_cast<std::size_t>(__s)*U};
+              touch_range(c,j*E,(j+U)*E);
+       }
+       // the bytes beyond the last whole element
+       touch_range(c,n*E,nbytes);
+}
+
+std::size_t
+gms::common::hugepage_backed_bytes(const void * p,
+                                   const std::size_t nbytes)
+{
+       FILE * fp{std::fopen("/proc/self/smaps","r")};
+       if(fp == nullptr) return (0ull);
+       const std::uintptr_t a{reinterpret_cast<std::uintptr_t>(p)};
+       const std::uintptr_t b{a+nbytes};
+       std::size_t total{0ull};
+       std::size_t overlap{0ull};
+       char line[512];
+       while(std::fgets(line,sizeof(line),fp) != nullptr)
+       {
+              unsigned long lo,hi;
+              if(std::sscanf(line,"%lx-%lx ",&lo,&hi) == 2)
+              {
+                     const std::uintptr_t s{std::max<std::uintptr_t>(lo,a)};
+                     const std::uintptr_t e{std::min<std::uintptr_t>(hi,b)};
+                     overlap = (s < e) ? static_cast<std::size_t>(e-s) : 0ull;
+                     continue;
+              }
+              if(overlap == 0ull) continue;
+              unsigned long kb;
+              if(std::sscanf(line,"AnonHugePages: %lu kB",&kb) == 1 ||
+                 std::sscanf(line,"Private_Hugetlb: %lu kB",&kb) == 1)
+              {
+                     // a mapping merged with its neighbours is clipped to the range
+                     total += std::min<std::size_t>(1024ull*kb,overlap);
+              }
+       }
+       std::fclose(fp);
+       return (std::min(total,nbytes));
+}
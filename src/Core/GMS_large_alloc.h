@@ -0,0 +1,155 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#ifndef __GMS_LARGE_ALLOC_H__
+#define __GMS_LARGE_ALLOC_H__ 211020260900
+
+
+namespace  file_info
+{
+
+    const unsigned int GMS_LARGE_ALLOC_MAJOR = 1U;
+    const unsigned int GMS_LARGE_ALLOC_MINOR = 0U;
+    const unsigned int GMS_LARGE_ALLOC_MICRO = 0U;
+    const unsigned int GMS_LARGE_ALLOC_FULLVER =
+      1000U*GMS_LARGE_ALLOC_MAJOR+100U*GMS_LARGE_ALLOC_MINOR+10U*GMS_LARGE_ALLOC_MICRO;
+    const char * const GMS_LARGE_ALLOC_CREATE_DATE = "21-10-2026 09:00 +00200 (WED 21 OCT 2026 GMT+2)";
+    const char * const GMS_LARGE_ALLOC_BUILD_DATE  = __DATE__ ":" __TIME__;
+    const char * const GMS_LARGE_ALLOC_AUTHOR      =  "Programmer: Bernard Gingold, e-mail: beniekg@gmail.com";
+    const char * const GMS_LARGE_ALLOC_DESCRIPT    =  "Huge-page and NUMA aware allocation of the large arrays with the OpenMP parallel first-touch.";
+
+}
+
+#include <cstdint>
+#include <cstddef>
+#include "GMS_config.h"
+
+/*
+    Large arrays (the operands of the *_omp kernels) mapped with the page size
+    and NUMA placement selected at runtime:
+    page_kind::AUTO tries the explicit hugepages (2MiB, hugetlbfs pool), then
+    the transparent hugepages (madvise(MADV_HUGEPAGE)) and at last the 4KiB pages,
+    HUGETLB_1GiB/HUGETLB_2MiB/THP start the same chain at the given step.
+    numa_place::INTERLEAVE spreads the pages round-robin over the online nodes,
+    LOCAL places every page on the node of the thread touching it first
+    (mbind, without libnuma).
+    The first-touch of touch_kind::OMP_PARALLEL runs the iteration space of the
+    consuming kernel (remainder peeled serially, then a schedule(runtime) loop
+    stepping by the unroll factor), hence with a static OMP_SCHEDULE every page
+    is faulted in by the thread which will stream it.
+    The options are read from the environment by large_alloc_opts_from_env():
+    GMS_PAGES=auto|1g|2m|thp|4k, GMS_NUMA=none|local|interleave,
+    GMS_FIRST_TOUCH=none|serial|omp.
+*/
+
+namespace gms
+{
+namespace common
+{
+
+enum class page_kind : int32_t
+{
+      AUTO         = 0,
+      HUGETLB_1GiB = 1,
+      HUGETLB_2MiB = 2,
+      THP          = 3,
+      PAGES_4KiB   = 4
+};
+
+enum class numa_place : int32_t
+{
+      NONE       = 0,  // the process policy (usually local on the first touch)
+      LOCAL      = 1,
+      INTERLEAVE = 2
+};
+
+enum class touch_kind : int32_t
+{
+      NONE         = 0,
+      SERIAL       = 1,
+      OMP_PARALLEL = 2
+};
+
+struct large_alloc_opts_t
+{
+       page_kind   page       = page_kind::AUTO;
+       numa_place  numa       = numa_place::NONE;
+       touch_kind  touch      = touch_kind::OMP_PARALLEL;
+       std::size_t elem_bytes = 64ull; // bytes of an element of the consuming loop (sizeof(__m512), sizeof(zmm16c4_t))
+       int32_t     unroll     = 1;     // elements per step of the consuming loop (6 for *_unroll6x_omp)
+};
+
+struct large_alloc_info_t
+{
+       std::size_t bytes_req;
+       std::size_t bytes_mapped;
+       page_kind   page;        // the step of the chain which succeeded
+       numa_place  numa;
+       bool        mbind_ok;
+       int32_t     n_nodes;
+};
+
+const char * page_kind_name(const page_kind);
+
+const char * numa_place_name(const numa_place);
+
+// Number of the online NUMA nodes, the ids need not be contiguous (1 when not available).
+__ATTR_COLD__
+int32_t numa_nodes_online();
+
+__ATTR_COLD__
+large_alloc_opts_t large_alloc_opts_from_env();
+
+/*
+    Returns 2MiB (or 1GiB) aligned memory of at least nbytes, zero-filled.
+    Terminates the program when even the 4KiB mapping fails.
+*/
+__ATTR_COLD__
+void * gms_large_malloc(const std::size_t nbytes,
+                        const large_alloc_opts_t & opts = large_alloc_opts_t{},
+                        large_alloc_info_t * info = nullptr);
+
+__ATTR_COLD__
+void gms_large_free(void *);
+
+// Faults in the pages of [p,p+nbytes) in the order of the consuming loop.
+void gms_first_touch(void * __restrict p,
+                     const std::size_t nbytes,
+                     const large_alloc_opts_t & opts);
+
+// Bytes of [p,p+nbytes) backed by the transparent or explicit hugepages (from /proc/self/smaps).
+__ATTR_COLD__
+std::size_t hugepage_backed_bytes(const void * p,
+                                  const std::size_t nbytes);
+
+// Allocates n elements of T.
+template<typename T>
+T * large_alloc(const std::size_t n,
+                const large_alloc_opts_t & opts = large_alloc_opts_t{},
+                large_alloc_info_t * info = nullptr)
+{
+       large_alloc_opts_t o{opts};
+       if(o.elem_bytes == 0ull) o.elem_bytes = sizeof(T);
+       return (reinterpret_cast<T*>(gms_large_malloc(sizeof(T)*n,o,info)));
+}
+
+} // common
+} // gms
+
+#endif /*__GMS_LARGE_ALLOC_H__*/
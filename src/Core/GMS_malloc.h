@@ -255,6 +255,14 @@ namespace gms {
                       if(totmem != nlargep*2097152ULL) nlargep++;
                       totmem = nlargep*2097152ULL;           
                       ptr = mmap(NULL,totmem,prot,flags,fd,offset); 
+#if (GMS_MMAP_HUGEPAGE_FALLBACK) == 1
+                      if((ptr == (void*)(-1)) && (flags & MAP_HUGETLB) && (errno == ENOMEM || errno == EINVAL)) {
+                           // no hugepages reserved, munmap by gms_ummap covers the 4KiB-rounded length
+                           totmem = ALIGN_TO_PAGE_4KiB(sizeof(T)*length);
+                           ptr = mmap(NULL,totmem,prot,flags & ~(MAP_HUGETLB | (MAP_HUGE_MASK << MAP_HUGE_SHIFT)),fd,offset);
+                           if(ptr != (void*)(-1)) madvise(ptr,totmem,MADV_HUGEPAGE);
+                      }
+#endif
 		              if((ptr == (void*)(-1))) {
 #if (PRINT_CALLSTACK_ON_ERROR) == 1
 	                           std::cerr << "Requested stack-backtrace -- not implemented yet!!" << "\n";
@@ -282,6 +290,14 @@ namespace gms {
                       if(totmem != nlargep*1073741824ULL) nlargep++;
                       totmem = nlargep*1073741824ULL;           
                       ptr = mmap(NULL,totmem,prot,flags,fd,offset); 
+#if (GMS_MMAP_HUGEPAGE_FALLBACK) == 1
+                      if((ptr == (void*)(-1)) && (flags & MAP_HUGETLB) && (errno == ENOMEM || errno == EINVAL)) {
+                           // no hugepages reserved, munmap by gms_ummap covers the 4KiB-rounded length
+                           totmem = ALIGN_TO_PAGE_4KiB(sizeof(T)*length);
+                           ptr = mmap(NULL,totmem,prot,flags & ~(MAP_HUGETLB | (MAP_HUGE_MASK << MAP_HUGE_SHIFT)),fd,offset);
+                           if(ptr != (void*)(-1)) madvise(ptr,totmem,MADV_HUGEPAGE);
+                      }
+#endif
 		              if((ptr == (void*)(-1))) {
 #if (PRINT_CALLSTACK_ON_ERROR) == 1
 	                         std::cerr << "Requested stack-backtrace -- not implemented yet!!" << "\n";
@@ -0,0 +1,524 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#include <sched.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_par_team.h"
+
+namespace
+{
+
+       using gms::common::par_family;
+       using gms::common::par_ctx_t;
+       using gms::common::par_job_fn;
+       using gms::common::par_tuning_t;
+       using gms::common::N_PAR_FAMILIES;
+
+       constexpr std::size_t CACHE_LINE{64ull};
+
+       struct alignas(64) padded_u32_t
+       {
+              std::atomic<uint32_t> v{0u};
+       };
+
+       struct team_t
+       {
+              int32_t                    nw;
+              std::vector<std::thread>   th;
+              std::vector<padded_u32_t>  sense;   // barrier sense per worker
+              par_job_fn                 job{nullptr};
+              void *                     arg{nullptr};
+              alignas(64) std::atomic<uint64_t> epoch{0ull};
+              alignas(64) std::atomic<int32_t>  done{0};
+              alignas(64) std::atomic<int32_t>  bar_count{0};
+              alignas(64) std::atomic<uint32_t> bar_sense{0u};
+              alignas(64) std::atomic<int32_t>  sleepers{0};
+              std::atomic<bool>          stop{false};
+              std::mutex                 mtx;
+              std::condition_variable    cv;
+              std::mutex                 busy;    // one submitting thread at a time
+
+              explicit team_t(const int32_t n) : nw(n), sense(static_cast<std::size_t>(n)) {}
+       };
+
+       std::atomic<team_t*> g_team{nullptr};
+       std::mutex           g_team_mtx;
+       std::once_flag       g_team_once;
+       std::once_flag       g_cal_once;
+       std::mutex           g_cal_mtx;
+       par_tuning_t         g_tuning{};
+       std::atomic<std::size_t> g_threshold[N_PAR_FAMILIES];  // read by every par_for
+       thread_local bool    tls_in_team{false};
+
+       // pause, and give the CPU away now and then (more workers than CPUs)
+       __ATTR_ALWAYS_INLINE__
+       inline void relax(uint32_t & s)
+       {
+              if((++s & 255u) == 0u)
+                 std::this_thread::yield();
+              else
+                 _mm_pause();
+       }
+
+       std::vector<int32_t> affinity_cpus()
+       {
+              std::vector<int32_t> cpus;
+              cpu_set_t set;
+              CPU_ZERO(&set);
+              if(sched_getaffinity(0,sizeof(set),&set) == 0)
+              {
+                 for(int32_t __i{0}; __i != CPU_SETSIZE; ++__i)
+                     if(CPU_ISSET(__i,&set)) cpus.push_back(__i);
+              }
+              if(cpus.empty()) cpus.push_back(0);
+              return (cpus);
+       }
+
+       void worker_loop(team_t * t,const int32_t id)
+       {
+              tls_in_team = true;
+              uint64_t seen{0ull};
+              for(;;)
+              {
+                     uint32_t s{0u};
+                     while(t->epoch.load(std::memory_order_acquire) == seen &&
+                           !t->stop.load(std::memory_order_relaxed))
+                     {
+                            if(s < PAR_TEAM_SPIN_ITERS)
+                            {
+                               relax(s);
+                               continue;
+                            }
+                            std::unique_lock<std::mutex> lk(t->mtx);
+                            t->sleepers.fetch_add(1);
+                            t->cv.wait(lk,[&]{ return (t->epoch.load() != seen || t->stop.load()); });
+                            t->sleepers.fetch_sub(1);
+                     }
+                     if(t->stop.load(std::memory_order_relaxed)) return;
+                     seen = t->epoch.load(std::memory_order_acquire);
+                     t->job(t->arg,par_ctx_t(id,t->nw));
+                     t->done.fetch_add(1,std::memory_order_release);
+              }
+       }
+
+       int32_t default_workers()
+       {
+              const char * e{std::getenv("GMS_PAR_THREADS")};
+              if(e != nullptr && std::atoi(e) > 0) return (std::atoi(e));
+              return (static_cast<int32_t>(affinity_cpus().size()));
+       }
+
+       team_t * start_team(const int32_t n)
+       {
+              team_t * t{new team_t(std::max<int32_t>(1,n))};
+              const std::vector<int32_t> cpus{affinity_cpus()};
+              for(int32_t __i{1}; __i < t->nw; ++__i)
+              {
+                     t->th.emplace_back(worker_loop,t,__i);
+#if (PAR_TEAM_PIN_WORKERS) == 1
+                     cpu_set_t set;
+                     CPU_ZERO(&set);
+                     CPU_SET(cpus[static_cast<std::size_t>(__i)%cpus.size()],&set);
+                     (void)pthread_setaffinity_np(t->th.back().native_handle(),sizeof(set),&set);
+#endif
+              }
+              return (t);
+       }
+
+       void stop_team(team_t * t)
+       {
+              if(t == nullptr) return;
+              {
+                     std::lock_guard<std::mutex> lk(t->mtx);
+                     t->stop.store(true);
+              }
+              t->cv.notify_all();
+              for(std::thread & th : t->th) th.join();
+              delete t;
+       }
+
+       void ensure_team()
+       {
+              std::call_once(g_team_once,[]{
+                     std::lock_guard<std::mutex> lk(g_team_mtx);
+                     if(g_team.load() == nullptr) g_team.store(start_team(default_workers()));
+              });
+       }
+
+       struct team_guard_t
+       {
+              ~team_guard_t()
+              {
+                     std::lock_guard<std::mutex> lk(g_team_mtx);
+                     stop_team(g_team.exchange(nullptr));
+              }
+       } g_team_guard;
+
+       typedef std::chrono::steady_clock clk;
+
+       // Serial time of an element (16 lanes) of the stand-in loop of the family.
+       double elem_ns_of(const par_family f)
+       {
+              constexpr int32_t NE{256};
+              constexpr int32_t NL{16*NE};
+              std::vector<float> a(NL),b(NL),c(NL),d(NL),z(NL);
+              for(int32_t __i{0}; __i != NL; ++__i)
+              {
+                     a[__i] = 0.5f+0.001f*static_cast<float>(__i%97);
+                     b[__i] = 0.25f+0.002f*static_cast<float>(__i%89);
+                     c[__i] = 1.5f-0.001f*static_cast<float>(__i%83);
+                     d[__i] = 0.75f+0.003f*static_cast<float>(__i%79);
+              }
+              float * __restrict pa{a.data()};
+              float * __restrict pb{b.data()};
+              float * __restrict pc{c.data()};
+              float * __restrict pd{d.data()};
+              float * __restrict pz{z.data()};
+              auto loop = [&]{
+                   switch(f)
+                   {
+                          case par_family::STREAM :
+                               for(int32_t __i{0}; __i != NL; ++__i)
+                                   pz[__i] = pa[__i]*pb[__i]+pc[__i]*pd[__i]+pa[__i]*pd[__i];
+                               break;
+                          case par_family::ARITH :
+                               // three complex products and a cross term per lane
+                               for(int32_t __i{0}; __i != NL; ++__i)
+                               {
+                                   float re{pa[__i]},im{pb[__i]};
+                                   for(int32_t __k{0}; __k != 6; ++__k)
+                                   {
+                                       const float r{re*pc[__i]-im*pd[__i]};
+                                       im = re*pd[__i]+im*pc[__i];
+                                       re = r;
+                                   }
+                                   pz[__i] = re-im;
+                               }
+                               break;
+                          case par_family::TRANSC :
+                               // three polynomial sin/exp evaluations and a division per lane
+                               for(int32_t __i{0}; __i != NL; ++__i)
+                               {
+                                   float acc{0.0f};
+                                   float x{pa[__i]};
+                                   for(int32_t __k{0}; __k != 3; ++__k)
+                                   {
+                                       const float x2{x*x};
+                                       const float s{x*(1.0f+x2*(-0.16666667f+x2*(0.0083333f+x2*(-0.00019841f+x2*2.7557e-6f))))};
+                                       const float e{1.0f+x*(1.0f+x*(0.5f+x*(0.16666667f+x*(0.041666668f+x*0.0083333f))))};
+                                       acc += s*e;
+                                       x = pb[__i]/(x+pc[__i]);
+                                   }
+                                   pz[__i] = acc;
+                               }
+                               break;
+                          case par_family::SERIES :
+                               // downward ratio recurrence, 64 terms per lane
+                               for(int32_t __i{0}; __i != NL; ++__i)
+                               {
+                                   float r{0.0f};
+                                   const float x{pa[__i]};
+                                   for(int32_t __k{64}; __k != 0; --__k)
+                                       r = x/(2.0f*static_cast<float>(__k)-x*r);
+                                   pz[__i] = r;
+                               }
+                               break;
+                   }
+              };
+              loop(); // warm-up
+              double best{1.0e30};
+              for(int32_t __r{0}; __r != 5; ++__r)
+              {
+                     int32_t reps{0};
+                     const auto t0{clk::now()};
+                     double dt{0.0};
+                     do
+                     {
+                            loop();
+                            ++reps;
+                            dt = std::chrono::duration<double>(clk::now()-t0).count();
+                     } while(dt < 2.0e-4);
+                     best = std::min(best,dt/static_cast<double>(reps));
+              }
+              volatile float sink{z[NL-1]};
+              (void)sink;
+              return (1.0e9*best/static_cast<double>(NE));
+       }
+
+       void empty_job(void *,const par_ctx_t &) {}
+
+       // median of 9 batches of 100 calls (ns per call)
+       template<typename F>
+       double median_call_ns(F && f)
+       {
+              double t[9];
+              for(int32_t __b{0}; __b != 9; ++__b)
+              {
+                     const auto t0{clk::now()};
+                     for(int32_t __r{0}; __r != 100; ++__r) f();
+                     t[__b] = 1.0e7*std::chrono::duration<double>(clk::now()-t0).count();
+              }
+              std::nth_element(t,t+4,t+9);
+              return (t[4]);
+       }
+
+       std::size_t env_threshold(const par_family f)
+       {
+              char name[64];
+              std::snprintf(name,sizeof(name),"GMS_PAR_THRESHOLD_%s",gms::common::par_family_name(f));
+              const char * e{std::getenv(name)};
+              if(e == nullptr) return (0ull);
+              return (static_cast<std::size_t>(std::strtoull(e,nullptr,10)));
+       }
+
+       void measure(par_tuning_t & t)
+       {
+              team_t * team{g_team.load()};
+              t.n_workers = (team != nullptr) ? team->nw : 1;
+              t.dispatch_ns = 0.0;
+              t.omp_fork_ns = 0.0;
+              if(t.n_workers > 1)
+              {
+                     (void)gms::common::par_team_run(&empty_job,nullptr);
+                     t.dispatch_ns = median_call_ns([]{ (void)gms::common::par_team_run(&empty_job,nullptr); });
+                     const int32_t nw{t.n_workers};
+                     t.omp_fork_ns = median_call_ns([nw]{
+#pragma omp parallel for schedule(static) num_threads(nw)
+                            for(int32_t __i = 0; __i < nw; ++__i) __asm__ __volatile__ ("" ::: "memory");
+                     });
+              }
+              for(int32_t __f{0}; __f != N_PAR_FAMILIES; ++__f)
+              {
+                     const par_family f{static_cast<par_family>(__f)};
+                     t.elem_ns[__f] = elem_ns_of(f);
+                     std::size_t thr{SIZE_MAX};
+                     if(t.n_workers > 1)
+                     {
+                        // n*c > margin*(dispatch + n*c/nw)
+                        const double gain{t.elem_ns[__f]*(1.0-1.0/static_cast<double>(t.n_workers))};
+                        thr = static_cast<std::size_t>(std::ceil(PAR_TEAM_THRESHOLD_MARGIN*t.dispatch_ns/gain));
+                        thr = std::max<std::size_t>(thr,static_cast<std::size_t>(t.n_workers));
+                     }
+                     const std::size_t e{env_threshold(f)};
+                     t.threshold[__f] = (e != 0ull) ? e : thr;
+              }
+              t.measured = true;
+       }
+
+       void publish_thresholds()
+       {
+              for(int32_t __f{0}; __f != N_PAR_FAMILIES; ++__f)
+                  g_threshold[__f].store(g_tuning.threshold[__f],std::memory_order_relaxed);
+       }
+
+       void calibrate_once()
+       {
+              ensure_team();
+              std::lock_guard<std::mutex> lk(g_cal_mtx);
+              par_tuning_t t{};
+              measure(t);
+              g_tuning = t;
+              publish_thresholds();
+       }
+
+} // anonymous
+
+
+const char *
+gms::common::par_family_name(const par_family f)
+{
+      switch(f)
+      {
+           case par_family::STREAM : return "STREAM";
+           case par_family::ARITH  : return "ARITH";
+           case par_family::TRANSC : return "TRANSC";
+           case par_family::SERIES : return "SERIES";
+      }
+      return ("");
+}
+
+void
+gms::common::par_team_start(const int32_t n_workers)
+{
+      ensure_team();
+      {
+           std::lock_guard<std::mutex> lk(g_team_mtx);
+           stop_team(g_team.exchange(nullptr));
+           g_team.store(start_team((n_workers > 0) ? n_workers : default_workers()));
+      }
+      std::lock_guard<std::mutex> lk(g_cal_mtx);
+      if(g_tuning.measured)
+      {
+         measure(g_tuning);
+         publish_thresholds();
+      }
+}
+
+void
+gms::common::par_team_stop()
+{
+      ensure_team();
+      std::lock_guard<std::mutex> lk(g_team_mtx);
+      stop_team(g_team.exchange(nullptr));
+}
+
+int32_t
+gms::common::par_team_size()
+{
+      ensure_team();
+      const team_t * t{g_team.load()};
+      return ((t != nullptr) ? t->nw : 1);
+}
+
+void
+gms::common::par_calibrate()
+{
+      std::call_once(g_cal_once,&calibrate_once);
+}
+
+const gms::common::par_tuning_t &
+gms::common::par_tuning()
+{
+      par_calibrate();
+      return (g_tuning);
+}
+
+void
+gms::common::par_set_threshold(const par_family f,
+                               const std::size_t n)
+{
+      par_calibrate();
+      std::lock_guard<std::mutex> lk(g_cal_mtx);
+      g_tuning.threshold[static_cast<int32_t>(f)] = n;
+      publish_thresholds();
+}
+
+void
+gms::common::par_print_tuning()
+{
+      const par_tuning_t & t{par_tuning()};
+      std::printf("[PAR-TEAM]: workers=%d, dispatch+join=%.0f ns (omp parallel for: %.0f ns), measured=%d\n",
+                  t.n_workers,t.dispatch_ns,t.omp_fork_ns,static_cast<int32_t>(t.measured));
+      for(int32_t __f{0}; __f != N_PAR_FAMILIES; ++__f)
+      {
+          if(t.threshold[__f] == SIZE_MAX)
+             std::printf("[PAR-TEAM]: %-6s: %8.2f ns/element, serial always\n",
+                         par_family_name(static_cast<par_family>(__f)),t.elem_ns[__f]);
+          else
+             std::printf("[PAR-TEAM]: %-6s: %8.2f ns/element, team from %zu elements\n",
+                         par_family_name(static_cast<par_family>(__f)),t.elem_ns[__f],t.threshold[__f]);
+      }
+}
+
+std::size_t
+gms::common::par_threshold(const par_family f)
+{
+      par_calibrate();
+      return (g_threshold[static_cast<int32_t>(f)].load(std::memory_order_relaxed));
+}
+
+std::size_t
+gms::common::par_granule(const std::size_t elem_bytes,
+                         const int32_t unroll)
+{
+      // elements filling whole cache lines: 64/gcd(64,elem_bytes)
+      std::size_t a{CACHE_LINE},b{std::max<std::size_t>(1ull,elem_bytes)};
+      while(b != 0ull) { const std::size_t r{a%b}; a = b; b = r; }
+      const std::size_t g{CACHE_LINE/a};
+      const std::size_t u{static_cast<std::size_t>(std::max<int32_t>(1,unroll))};
+      // lcm(g,u)
+      std::size_t x{g},y{u};
+      while(y != 0ull) { const std::size_t r{x%y}; x = y; y = r; }
+      return (g/x*u);
+}
+
+void
+gms::common::par_static_chunk(const std::size_t n,
+                              const std::size_t granule,
+                              const int32_t nw,
+                              const int32_t id,
+                              std::size_t & lo,
+                              std::size_t & hi)
+{
+      const std::size_t g{std::max<std::size_t>(1ull,granule)};
+      const std::size_t nb{(n+g-1ull)/g};
+      const std::size_t w{static_cast<std::size_t>(std::max<int32_t>(1,nw))};
+      const std::size_t i{static_cast<std::size_t>(id)};
+      lo = std::min<std::size_t>(n,(nb*i/w)*g);
+      hi = std::min<std::size_t>(n,(nb*(i+1ull)/w)*g);
+}
+
+void
+gms::common::par_ctx_t::barrier() const
+{
+      if(m_nw < 2) return;
+      team_t * t{g_team.load(std::memory_order_relaxed)};
+      const uint32_t s{t->sense[static_cast<std::size_t>(m_id)].v.load(std::memory_order_relaxed) ^ 1u};
+      t->sense[static_cast<std::size_t>(m_id)].v.store(s,std::memory_order_relaxed);
+      if(t->bar_count.fetch_add(1,std::memory_order_acq_rel) == m_nw-1)
+      {
+         t->bar_count.store(0,std::memory_order_relaxed);
+         t->bar_sense.store(s,std::memory_order_release);
+      }
+      else
+      {
+         uint32_t sp{0u};
+         while(t->bar_sense.load(std::memory_order_acquire) != s) relax(sp);
+      }
+}
+
+bool
+gms::common::par_team_run(par_job_fn job,
+                          void * arg)
+{
+      if(tls_in_team || omp_in_parallel()) return (false);
+      ensure_team();
+      team_t * t{g_team.load()};
+      if(t == nullptr || t->nw < 2) return (false);
+      std::unique_lock<std::mutex> lk(t->busy,std::try_to_lock);
+      if(!lk.owns_lock()) return (false);
+      t->job = job;
+      t->arg = arg;
+      t->done.store(0,std::memory_order_relaxed);
+      t->epoch.fetch_add(1ull);               // seq_cst, pairs with the sleepers count
+      if(t->sleepers.load() != 0)
+      {
+         { std::lock_guard<std::mutex> lm(t->mtx); }
+         t->cv.notify_all();
+      }
+      tls_in_team = true;
+      job(arg,par_ctx_t(0,t->nw));
+      tls_in_team = false;
+      uint32_t s{0u};
+      while(t->done.load(std::memory_order_acquire) != t->nw-1) relax(s);
+      return (true);
+}
@@ -0,0 +1,250 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#ifndef __GMS_PAR_TEAM_H__
+#define __GMS_PAR_TEAM_H__ 221020261400
+
+
+namespace  file_info
+{
+
+    const unsigned int GMS_PAR_TEAM_MAJOR = 1U;
+    const unsigned int GMS_PAR_TEAM_MINOR = 0U;
+    const unsigned int GMS_PAR_TEAM_MICRO = 0U;
+    const unsigned int GMS_PAR_TEAM_FULLVER =
+      1000U*GMS_PAR_TEAM_MAJOR+100U*GMS_PAR_TEAM_MINOR+10U*GMS_PAR_TEAM_MICRO;
+    const char * const GMS_PAR_TEAM_CREATE_DATE = "22-10-2026 14:00 +00200 (THR 22 OCT 2026 GMT+2)";
+    const char * const GMS_PAR_TEAM_BUILD_DATE  = __DATE__ ":" __TIME__;
+    const char * const GMS_PAR_TEAM_AUTHOR      =  "Programmer: Bernard Gingold, e-mail: beniekg@gmail.com";
+    const char * const GMS_PAR_TEAM_DESCRIPT    =  "Persistent pinned worker team with static cache-line chunking and calibrated per-family thresholds.";
+
+}
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "GMS_config.h"
+
+/*
+    Replacement of the per-call '#pragma omp parallel for' of the *_omp kernels
+    for the short arrays: a team of worker threads started once (lazily), each
+    worker pinned to one CPU of the process affinity mask, the calling thread
+    being the worker 0. Between the jobs the workers spin for PAR_TEAM_SPIN_ITERS
+    pauses and then block, a dispatch costs a store and (when some worker sleeps)
+    a notify, the join a counter.
+    The iteration space is split statically, each worker takes one contiguous
+    chunk whose boundaries are multiples of the granule: the number of elements
+    filling whole cache lines, rounded up to the unroll factor of the kernel
+    (the operands are 64-byte aligned), so no line is written by two workers
+    and only the last chunk has a remainder.
+    par_for runs serially below the threshold of the kernel family (elements at
+    which the team is faster than the serial loop, from the measured dispatch+join
+    cost and the per-element cost of the family), par_region runs a sequence of
+    kernels (for_static steps separated by barrier() where they depend on each
+    other) within one dispatch of the team.
+    Environment: GMS_PAR_THREADS=<workers>, GMS_PAR_THRESHOLD_<FAMILY>=<elements>
+    (FAMILY: STREAM, ARITH, TRANSC, SERIES).
+    A job submitted from a worker, from an OpenMP parallel region or while another
+    thread owns the team runs serially on the calling thread.
+*/
+
+// Pauses a worker spins for the next job before it blocks.
+#if !defined(PAR_TEAM_SPIN_ITERS)
+#define PAR_TEAM_SPIN_ITERS 20000
+#endif
+
+// Pin the workers 1..n-1 to the CPUs of the affinity mask (the caller is not re-pinned).
+#if !defined(PAR_TEAM_PIN_WORKERS)
+#define PAR_TEAM_PIN_WORKERS 1
+#endif
+
+// The team is used when its estimated time times this margin is below the serial one.
+#if !defined(PAR_TEAM_THRESHOLD_MARGIN)
+#define PAR_TEAM_THRESHOLD_MARGIN 1.5
+#endif
+
+namespace gms
+{
+namespace common
+{
+
+/*
+    Kernel families by the serial cost of an element (one __m512 or zmm16c4_t
+    of the kernel loop).
+*/
+enum class par_family : int32_t
+{
+      STREAM = 0,  // a few flops per element, memory bound (sdotv, array add/mul)
+      ARITH  = 1,  // tens of flops (cross products, complex mul/div, projections)
+      TRANSC = 2,  // sin/cos/exp per element (dir/pol vectors, plane-wave fields, RCS)
+      SERIES = 3   // hundreds of flops (Bessel/Mie series, quadratures)
+};
+
+constexpr int32_t N_PAR_FAMILIES = 4;
+
+struct par_tuning_t
+{
+       int32_t     n_workers;                   // team size, the caller included
+       double      dispatch_ns;                 // empty job: dispatch + join of the team
+       double      omp_fork_ns;                 // empty 'omp parallel for', for comparison
+       double      elem_ns[N_PAR_FAMILIES];     // serial time of an element
+       std::size_t threshold[N_PAR_FAMILIES];   // elements from which the team is used
+       bool        measured;
+};
+
+const char * par_family_name(const par_family);
+
+/*
+    Starts (or restarts with another size) the team, n_workers <= 0: GMS_PAR_THREADS
+    or the number of CPUs in the affinity mask. Not to be called while a job runs.
+*/
+__ATTR_COLD__
+void par_team_start(const int32_t n_workers = 0);
+
+__ATTR_COLD__
+void par_team_stop();
+
+int32_t par_team_size();
+
+/*
+    Measures the dispatch cost and the per-element cost of every family (stand-in
+    loops), derives the thresholds. Thread-safe, idempotent, lazily on the first use.
+*/
+__ATTR_COLD__
+void par_calibrate();
+
+const par_tuning_t & par_tuning();
+
+__ATTR_COLD__
+void par_set_threshold(const par_family,
+                       const std::size_t);
+
+__ATTR_COLD__
+void par_print_tuning();
+
+// Threshold of the family (calibrates on the first call).
+std::size_t par_threshold(const par_family);
+
+// Elements per chunk boundary: whole cache lines, multiple of the unroll factor.
+std::size_t par_granule(const std::size_t elem_bytes,
+                        const int32_t unroll);
+
+// Chunk [lo,hi) of the worker id of nw.
+void par_static_chunk(const std::size_t n,
+                      const std::size_t granule,
+                      const int32_t nw,
+                      const int32_t id,
+                      std::size_t & lo,
+                      std::size_t & hi);
+
+class par_ctx_t
+{
+      public:
+
+      par_ctx_t(const int32_t id,
+                const int32_t nw) : m_id(id), m_nw(nw) {}
+
+      int32_t id()     const { return (m_id); }
+      int32_t size()   const { return (m_nw); }
+      bool    master() const { return (m_id == 0); }
+
+      // This worker's chunk of [0,n), fn(lo,hi).
+      template<typename F>
+      void for_static(const std::size_t n,
+                      const std::size_t elem_bytes,
+                      const int32_t unroll,
+                      F && fn) const
+      {
+           std::size_t lo,hi;
+           par_static_chunk(n,par_granule(elem_bytes,unroll),m_nw,m_id,lo,hi);
+           if(lo < hi) fn(lo,hi);
+      }
+
+      // All the workers of the job (no-op for a serial context).
+      void barrier() const;
+
+      private:
+
+      int32_t m_id;
+      int32_t m_nw;
+};
+
+typedef void (*par_job_fn)(void *,const par_ctx_t &);
+
+/*
+    Runs job(arg,ctx) on every worker of the team and returns after all of them
+    finished. Returns false (nothing run) when the team has one worker or is not
+    available to the calling thread.
+*/
+bool par_team_run(par_job_fn job,
+                  void * arg);
+
+/*
+    fn(lo,hi) over [0,n): serially below the threshold of the family, otherwise
+    one static chunk per worker.
+*/
+template<typename F>
+void par_for(const par_family fam,
+             const std::size_t n,
+             const std::size_t elem_bytes,
+             const int32_t unroll,
+             F && fn)
+{
+       if(n == 0ull) return;
+       if(n >= par_threshold(fam))
+       {
+          struct arg_t
+          {
+                 std::remove_reference_t<F> * f;
+                 std::size_t n;
+                 std::size_t e;
+                 int32_t     u;
+          } a{&fn,n,elem_bytes,unroll};
+          if(par_team_run([](void * p,const par_ctx_t & c) {
+                               arg_t * pa{static_cast<arg_t*>(p)};
+                               c.for_static(pa->n,pa->e,pa->u,*pa->f);
+                          },&a)) return;
+       }
+       fn(std::size_t{0},n);
+}
+
+/*
+    fn(ctx) on every worker within one dispatch, n -- elements of the
+    region, summed over its steps (serially with a one-worker context below
+    the threshold).
+*/
+template<typename F>
+void par_region(const par_family fam,
+                const std::size_t n,
+                F && fn)
+{
+       if(n >= par_threshold(fam))
+       {
+          if(par_team_run([](void * p,const par_ctx_t & c) {
+                               (*static_cast<std::remove_reference_t<F>*>(p))(c);
+                          },const_cast<void*>(static_cast<const void*>(&fn)))) return;
+       }
+       const par_ctx_t c(0,1);
+       fn(c);
+}
+
+} // common
+} // gms
+
+#endif /*__GMS_PAR_TEAM_H__*/
@@ -28,16 +28,7 @@ namespace file_info
 #include <valarray>
 #include <algorithm>
 #include "GMS_config.h"
-#if defined (__AVX512F__)
-#include "GMS_avx512_memcpy.h"
-#include "GMS_avx512_uncached_memcpy.h"
-#elif defined (__AVX__) || defined (__AVX2__)
-#include "GMS_avx_memcpy.h"
-#include "GMS_avx_uncached_memcpy.h"
-#elif defined (SSE)
-#include "GMS_sse_memcpy.h"
-#include "GMS_sse_uncached_memcpy.h"
-#endif 
+#include "GMS_memops_dispatch.h"
 
 
 
@@ -70,33 +61,9 @@ namespace gms
                   {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                                reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                                reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#endif                             
-                        }
+                        memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                           reinterpret_cast<const float *>(&m_x[0]),2ull*this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                       }  
@@ -107,33 +74,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                                reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                       reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x.data()),2ull*this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                             reinterpret_cast<const float *>(m_x.data()),2ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -142,33 +85,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                                reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                       reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x[0]),2ull*this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                             reinterpret_cast<const float *>(&m_x[0]),2ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
@@ -246,33 +165,9 @@ namespace gms
                   {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                                reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                                reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#endif                             
-                        }
+                        memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                           reinterpret_cast<const double *>(&m_x[0]),2ull*this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                       }  
@@ -283,33 +178,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                                reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                       reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x.data()),2ull*this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(m_x.data()),2ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -319,33 +190,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                                reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(reinterpret_cast<double  *>(&this->mx[0]),
-                                                       reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),2ull*this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(&m_x[0]),2ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
@@ -425,33 +272,9 @@ namespace gms
                   {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                                &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(&this->mx[0],
-                                                       &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#endif                             
-                        }
+                        memcpy_dispatch_ps(&this->mx[0],
+                                           &m_x[0],this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                       }  
@@ -462,33 +285,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                                &m_x.data(),this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x.data(),this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x.data(),this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(&this->mx[0],
-                                                       &m_x.data(),this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x.data(),this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x.data(),this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_ps(&this->mx[0],
+                                             m_x.data(),this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -497,33 +296,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                                &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_ps(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_ps(&this->mx[0],
-                                                       &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_ps(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_ps(&this->mx[0],
+                                             &m_x[0],this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
@@ -603,33 +378,9 @@ namespace gms
                   {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                                &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_pd(&this->mx[0],
-                                                       &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#endif                             
-                        }
+                        memcpy_dispatch_pd(&this->mx[0],
+                                           &m_x[0],this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                       }  
@@ -640,33 +391,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                                &m_x.data(),this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x.data(),this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x.data(),this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_pd(&this->mx[0],
-                                                       &m_x.data(),this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x.data(),this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x.data(),this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_pd(&this->mx[0],
+                                             m_x.data(),this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -675,33 +402,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-#if defined (__AVX512F__)
-	                       avx512_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                                &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_uncached_memcpy_unroll8x_pd(&this->mx[0],
-                                                             &m_x[0],this->mnx);
-	                      
-#endif
-                        }
-                        else 
-                        {
-#if defined (__AVX512F__)
-	                       avx512_memcpy_unroll8x_pd(&this->mx[0],
-                                                       &m_x[0],this->mnx);
-#elif defined (__AVX__) || defined (__AVX2__) 
-                             avx_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#elif defined (__SSE__)
-                             sse_memcpy_unroll8x_pd(&this->mx[0],
-                                                    &m_x[0],this->mnx);
-#endif                             
-                        }
+                          memcpy_dispatch_pd(&this->mx[0],
+                                             &m_x[0],this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
@@ -23,11 +23,11 @@ namespace file_info
 
 
 #include <cstdint>
+#include <vector>
 #include <valarray>
 #include <algorithm>
 #include "GMS_config.h"
-#include "GMS_sse_memcpy.h"
-#include "GMS_sse_uncached_memcpy.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_complex_xmm2r8.h"
 
 
@@ -50,17 +50,9 @@ namespace gms
                 {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),4ull*this->mnx);
-	                  }
-                        else 
-                        {
-                             sse_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),4ull*this->mnx);
-                        }
+                        memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                           reinterpret_cast<const double *>(&m_x[0]),4ull*this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                   }  
@@ -71,17 +63,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x.data()),4ull*this->mnx);
-	                    }
-                          else 
-                          {
-                             sse_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x.data()),4ull*this->mnx);
-                          }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(m_x.data()),4ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -90,18 +74,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             sse_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),4ull*this->mnx);
-	                    }
-                          else 
-                          {
-
-                             sse_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),4ull*this->mnx);
-                          }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(&m_x[0]),4ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
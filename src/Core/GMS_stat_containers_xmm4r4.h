@@ -23,11 +23,11 @@ namespace file_info
 
 
 #include <cstdint>
+#include <vector>
 #include <valarray>
 #include <algorithm>
 #include "GMS_config.h"
-#include "GMS_sse_memcpy.h"
-#include "GMS_sse_uncached_memcpy.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_complex_xmm4r4.h"
 
 
@@ -54,17 +54,9 @@ namespace gms
                 {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),8ull*this->mnx);
-	                  }
-                        else 
-                        {
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x[0]),8ull*this->mnx);
-                        }
+                        memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                           reinterpret_cast<const float *>(&m_x[0]),8ull*this->mnx,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                   }  
@@ -75,17 +67,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x.data()),8ull*this->mnx);
-	                    }
-                          else 
-                          {
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x.data()),8ull*this->mnx);
-                          }
+                          memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                             reinterpret_cast<const float *>(m_x.data()),8ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -94,18 +78,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             sse_uncached_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                             reinterpret_cast<float  *>(&m_x[0]),8ull*this->mnx);
-	                    }
-                          else 
-                          {
-
-                             sse_memcpy_unroll8x_ps(reinterpret_cast<float  *>(&this->mx[0]),
-                                                    reinterpret_cast<float  *>(&m_x[0]),8ull*this->mnx);
-                          }
+                          memcpy_dispatch_ps(reinterpret_cast<float *>(&this->mx[0]),
+                                             reinterpret_cast<const float *>(&m_x[0]),8ull*this->mnx,
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
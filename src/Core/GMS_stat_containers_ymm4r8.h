@@ -20,11 +20,11 @@ namespace file_info
 
 
 #include <cstdint>
+#include <vector>
 #include <valarray>
 #include <algorithm>
 #include "GMS_config.h"
-#include "GMS_avx_memcpy.h"
-#include "GMS_avx_uncached_memcpy.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_complex_ymm4r8.h"
 
 
@@ -47,17 +47,9 @@ namespace gms
                 {
                         using namespace gms::common;
                         if(__builtin_expect(this->mnx!=n,0)) return;
-                        if constexpr (stream_store) // case: non-temporal store is true 
-                        {
-
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),8ull*n);
-	                  }
-                        else 
-                        {
-                             avx_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),8ull*n);
-                        }
+                        memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                           reinterpret_cast<const double *>(&m_x[0]),8ull*n,
+                                           stream_store ? memops_hint::STREAM : memops_hint::AUTO);
 
                      
                   }  
@@ -68,17 +60,9 @@ namespace gms
                   {                 
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x.data()),8ull*m_x.size());
-	                    }
-                          else 
-                          {
-                             avx_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x.data()),8ull*m_x.size());
-                          }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(m_x.data()),8ull*m_x.size(),
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                           
                   }
                      
@@ -87,18 +71,9 @@ namespace gms
                          
                           using namespace gms::common;
                           if(__builtin_expect(this->mnx!=m_x.size(),0)) return;
-                          if constexpr (stream_store) // case: non-temporal store is true 
-                          {
-
-                             avx_uncached_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                             reinterpret_cast<double  *>(&m_x[0]),8ull*m_x.size());
-	                    }
-                          else 
-                          {
-
-                             avx_memcpy_unroll8x_pd(reinterpret_cast<double  *>(&this->mx[0]),
-                                                    reinterpret_cast<double  *>(&m_x[0]),8ull*m_x.size());
-                          }
+                          memcpy_dispatch_pd(reinterpret_cast<double *>(&this->mx[0]),
+                                             reinterpret_cast<const double *>(&m_x[0]),8ull*m_x.size(),
+                                             stream_store ? memops_hint::STREAM : memops_hint::AUTO);
                                  
                   }
                              
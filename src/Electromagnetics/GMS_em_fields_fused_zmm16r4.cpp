@@ -0,0 +1,564 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#if !defined(ENABLE_AVX512F)
+#define ENABLE_AVX512F
+#endif
+
+#include <immintrin.h>
+#include "GMS_em_fields_fused_zmm16r4.h"
+#include "GMS_par_team.h"
+#include "GMS_sleefsimdsp.h"
+
+
+namespace {
+
+        using gms::radiolocation::PW_ZMM16C4;
+        using gms::radiolocation::PW_Inputs;
+        using gms::radiolocation::PW_Outputs;
+
+        constexpr float MU0f = 1.2566370614359173e-6f;
+
+        /*
+             Stage outputs are contraction barriers: the value is forced into a
+             register, so a mul of a stage cannot be fused into an add of the next
+             one (-ffp-contract=fast) and the fused chain rounds like the per-stage one.
+        */
+        __attribute__((always_inline))
+        inline void fence(__m512 & x) {
+               __asm__ ("" : "+v"(x));
+        }
+
+        __attribute__((always_inline))
+        inline void fence(PW_ZMM16C4 & x) {
+               fence(x.re);
+               fence(x.im);
+        }
+
+        // x*y, the products feed the fma directly.
+        __attribute__((always_inline))
+        inline PW_ZMM16C4 cmul(const __m512 xre,
+                               const __m512 xim,
+                               const __m512 yre,
+                               const __m512 yim) {
+               PW_ZMM16C4 z;
+               z.re = _mm512_fmsub_ps(xre,yre,_mm512_mul_ps(xim,yim));
+               z.im = _mm512_fmadd_ps(xre,yim,_mm512_mul_ps(xim,yre));
+               return (z);
+        }
+
+        /*
+             sin/cos of the incidence angles, shared by dir_vec and pol_vec.
+        */
+        struct trig_t {
+               __m512 stht;
+               __m512 ctht;
+               __m512 sphi;
+               __m512 cphi;
+        };
+
+        __attribute__((always_inline))
+        inline trig_t stage_trig(const __m512 tht,
+                                 const __m512 phi) {
+               trig_t t;
+               t.stht = xsinf(tht);
+               t.ctht = xcosf(tht);
+               t.sphi = xsinf(phi);
+               t.cphi = xcosf(phi);
+               fence(t.stht);
+               fence(t.ctht);
+               fence(t.sphi);
+               fence(t.cphi);
+               return (t);
+        }
+
+        __attribute__((always_inline))
+        inline void stage_dir(const trig_t & t,
+                              __m512 & dvx,
+                              __m512 & dvy,
+                              __m512 & dvz) {
+               dvx = _mm512_mul_ps(t.stht,t.cphi);
+               dvy = _mm512_mul_ps(t.stht,t.sphi);
+               dvz = t.ctht;
+               fence(dvx);
+               fence(dvy);
+               fence(dvz);
+        }
+
+        __attribute__((always_inline))
+        inline void stage_pol(const trig_t & t,
+                              const __m512 psi,
+                              __m512 & pvx,
+                              __m512 & pvy,
+                              __m512 & pvz) {
+               __m512 spsi{xsinf(psi)};
+               __m512 cpsi{xcosf(psi)};
+               fence(spsi);
+               fence(cpsi);
+               const __m512 t0{_mm512_mul_ps(spsi,t.ctht)};
+               pvx = _mm512_fmsub_ps(cpsi,t.sphi,_mm512_mul_ps(t0,t.cphi));
+               pvy = _mm512_fnmsub_ps(cpsi,t.cphi,_mm512_mul_ps(t0,t.sphi));
+               pvz = _mm512_mul_ps(spsi,t.stht);
+               fence(pvx);
+               fence(pvy);
+               fence(pvz);
+        }
+
+        __attribute__((always_inline))
+        inline void stage_H(const __m512 pvx,
+                            const __m512 pvy,
+                            const __m512 pvz,
+                            const __m512 dvx,
+                            const __m512 dvy,
+                            const __m512 dvz,
+                            const __m512 px,
+                            const __m512 py,
+                            const __m512 pz,
+                            const PW_ZMM16C4 k,
+                            PW_ZMM16C4 & Hx,
+                            PW_ZMM16C4 & Hy,
+                            PW_ZMM16C4 & Hz) {
+               __m512 dp{_mm512_fmadd_ps(dvx,px,_mm512_fmadd_ps(dvy,py,_mm512_mul_ps(dvz,pz)))};
+               fence(dp);
+               // i*k*(dir.r)
+               PW_ZMM16C4 ce{cmul(_mm512_setzero_ps(),_mm512_set1_ps(1.0f),k.re,k.im)};
+               fence(ce);
+               ce.re = _mm512_mul_ps(dp,ce.re);
+               ce.im = _mm512_mul_ps(dp,ce.im);
+               fence(ce);
+               __m512 ea{xexpf(ce.re)};
+               __m512 cc{xcosf(ce.im)};
+               __m512 ss{xsinf(ce.im)};
+               fence(ea);
+               fence(cc);
+               fence(ss);
+               __m512 expr{_mm512_mul_ps(ea,cc)};
+               __m512 expi{_mm512_mul_ps(ea,ss)};
+               fence(expr);
+               fence(expi);
+               Hx.re = _mm512_mul_ps(pvx,expr);
+               Hx.im = _mm512_mul_ps(pvx,expi);
+               Hy.re = _mm512_mul_ps(pvy,expr);
+               Hy.im = _mm512_mul_ps(pvy,expi);
+               Hz.re = _mm512_mul_ps(pvz,expr);
+               Hz.im = _mm512_mul_ps(pvz,expi);
+               fence(Hx);
+               fence(Hy);
+               fence(Hz);
+        }
+
+        __attribute__((always_inline))
+        inline void stage_B(const __m512 dvx,
+                            const __m512 dvy,
+                            const __m512 dvz,
+                            const PW_ZMM16C4 Hx,
+                            const PW_ZMM16C4 Hy,
+                            const PW_ZMM16C4 Hz,
+                            const __m512 omg,
+                            const PW_ZMM16C4 k,
+                            PW_ZMM16C4 & Bx,
+                            PW_ZMM16C4 & By,
+                            PW_ZMM16C4 & Bz) {
+               __m512 om{_mm512_mul_ps(omg,_mm512_set1_ps(MU0f))};
+               fence(om);
+               PW_ZMM16C4 t0;
+               t0.re = _mm512_div_ps(k.re,om);
+               t0.im = _mm512_div_ps(k.im,om);
+               fence(t0);
+               // dir x H, dir real
+               PW_ZMM16C4 cx,cy,cz;
+               cx.re = _mm512_fmsub_ps(dvy,Hz.re,_mm512_mul_ps(dvz,Hy.re));
+               cx.im = _mm512_fmsub_ps(dvy,Hz.im,_mm512_mul_ps(dvz,Hy.im));
+               cy.re = _mm512_fmsub_ps(dvz,Hx.re,_mm512_mul_ps(dvx,Hz.re));
+               cy.im = _mm512_fmsub_ps(dvz,Hx.im,_mm512_mul_ps(dvx,Hz.im));
+               cz.re = _mm512_fmsub_ps(dvx,Hy.re,_mm512_mul_ps(dvy,Hx.re));
+               cz.im = _mm512_fmsub_ps(dvx,Hy.im,_mm512_mul_ps(dvy,Hx.im));
+               fence(cx);
+               fence(cy);
+               fence(cz);
+               Bx = cmul(t0.re,t0.im,cx.re,cx.im);
+               By = cmul(t0.re,t0.im,cy.re,cy.im);
+               Bz = cmul(t0.re,t0.im,cz.re,cz.im);
+               fence(Bx);
+               fence(By);
+               fence(Bz);
+        }
+
+        __attribute__((always_inline))
+        inline PW_ZMM16C4 stage_cdotv(const PW_ZMM16C4 v1x,
+                                      const PW_ZMM16C4 v1y,
+                                      const PW_ZMM16C4 v1z,
+                                      const PW_ZMM16C4 v2x,
+                                      const PW_ZMM16C4 v2y,
+                                      const PW_ZMM16C4 v2z) {
+               PW_ZMM16C4 tx{cmul(v1x.re,v1x.im,v2x.re,v2x.im)};
+               PW_ZMM16C4 ty{cmul(v1y.re,v1y.im,v2y.re,v2y.im)};
+               PW_ZMM16C4 tz{cmul(v1z.re,v1z.im,v2z.re,v2z.im)};
+               fence(tx);
+               fence(ty);
+               fence(tz);
+               PW_ZMM16C4 r;
+               r.re = _mm512_add_ps(tx.re,_mm512_add_ps(ty.re,tz.re));
+               r.im = _mm512_add_ps(tx.im,_mm512_add_ps(ty.im,tz.im));
+               fence(r);
+               return (r);
+        }
+
+        // sqrt(Re(v.conj(v))), Re(x*conj(x)) = re*re+im*im
+        __attribute__((always_inline))
+        inline __m512 stage_cnorm(const PW_ZMM16C4 vx,
+                                  const PW_ZMM16C4 vy,
+                                  const PW_ZMM16C4 vz) {
+               __m512 tx{_mm512_fmadd_ps(vx.re,vx.re,_mm512_mul_ps(vx.im,vx.im))};
+               __m512 ty{_mm512_fmadd_ps(vy.re,vy.re,_mm512_mul_ps(vy.im,vy.im))};
+               __m512 tz{_mm512_fmadd_ps(vz.re,vz.re,_mm512_mul_ps(vz.im,vz.im))};
+               fence(tx);
+               fence(ty);
+               fence(tz);
+               __m512 r{_mm512_sqrt_ps(_mm512_add_ps(tx,_mm512_add_ps(ty,tz)))};
+               fence(r);
+               return (r);
+        }
+
+        constexpr uint32_t S_DIR = PW_OUT__DIR;
+        constexpr uint32_t S_POL = PW_OUT__POL;
+        constexpr uint32_t S_H   = PW_OUT__H;
+        constexpr uint32_t S_B   = PW_OUT__B;
+
+        /*
+             One tile of T registers starting at i, stage-major: every stage runs
+             over the tile before the next one, the selected outputs are stored
+             as soon as they are produced.
+        */
+        template<uint32_t STAGES,int32_t T>
+        __attribute__((always_inline))
+        inline void chain_tile(const PW_Inputs & in,
+                               const PW_Outputs & out,
+                               const uint32_t mask,
+                               const int32_t i) {
+               trig_t     tr[T];
+               __m512     dvx[T],dvy[T],dvz[T];
+               __m512     pvx[T],pvy[T],pvz[T];
+               PW_ZMM16C4 Hx[T],Hy[T],Hz[T];
+               PW_ZMM16C4 Bx[T],By[T],Bz[T];
+               for(int32_t __t{0}; __t != T; ++__t)
+                   tr[__t] = stage_trig(in.tht[i+__t],in.phi[i+__t]);
+               if constexpr((STAGES & S_DIR) != 0u) {
+                  for(int32_t __t{0}; __t != T; ++__t)
+                      stage_dir(tr[__t],dvx[__t],dvy[__t],dvz[__t]);
+                  if(mask & PW_OUT__DIR) {
+                     for(int32_t __t{0}; __t != T; ++__t) {
+                         out.dvx[i+__t] = dvx[__t];
+                         out.dvy[i+__t] = dvy[__t];
+                         out.dvz[i+__t] = dvz[__t];
+                     }
+                  }
+               }
+               if constexpr((STAGES & S_POL) != 0u) {
+                  for(int32_t __t{0}; __t != T; ++__t)
+                      stage_pol(tr[__t],in.psi[i+__t],pvx[__t],pvy[__t],pvz[__t]);
+                  if(mask & PW_OUT__POL) {
+                     for(int32_t __t{0}; __t != T; ++__t) {
+                         out.pvx[i+__t] = pvx[__t];
+                         out.pvy[i+__t] = pvy[__t];
+                         out.pvz[i+__t] = pvz[__t];
+                     }
+                  }
+               }
+               if constexpr((STAGES & S_H) != 0u) {
+                  for(int32_t __t{0}; __t != T; ++__t)
+                      stage_H(pvx[__t],pvy[__t],pvz[__t],dvx[__t],dvy[__t],dvz[__t],
+                              in.px[i+__t],in.py[i+__t],in.pz[i+__t],in.k[i+__t],
+                              Hx[__t],Hy[__t],Hz[__t]);
+                  if(mask & PW_OUT__H) {
+                     for(int32_t __t{0}; __t != T; ++__t) {
+                         out.Hx[i+__t] = Hx[__t];
+                         out.Hy[i+__t] = Hy[__t];
+                         out.Hz[i+__t] = Hz[__t];
+                     }
+                  }
+                  if(mask & PW_OUT__HNORM) {
+                     for(int32_t __t{0}; __t != T; ++__t)
+                         out.Hn[i+__t] = stage_cnorm(Hx[__t],Hy[__t],Hz[__t]);
+                  }
+               }
+               if constexpr((STAGES & S_B) != 0u) {
+                  for(int32_t __t{0}; __t != T; ++__t)
+                      stage_B(dvx[__t],dvy[__t],dvz[__t],Hx[__t],Hy[__t],Hz[__t],
+                              in.omg[i+__t],in.k[i+__t],Bx[__t],By[__t],Bz[__t]);
+                  if(mask & PW_OUT__B) {
+                     for(int32_t __t{0}; __t != T; ++__t) {
+                         out.Bx[i+__t] = Bx[__t];
+                         out.By[i+__t] = By[__t];
+                         out.Bz[i+__t] = Bz[__t];
+                     }
+                  }
+                  if(mask & PW_OUT__BNORM) {
+                     for(int32_t __t{0}; __t != T; ++__t)
+                         out.Bn[i+__t] = stage_cnorm(Bx[__t],By[__t],Bz[__t]);
+                  }
+                  if(mask & PW_OUT__HBDOT) {
+                     for(int32_t __t{0}; __t != T; ++__t)
+                         out.HB[i+__t] = stage_cdotv(Hx[__t],Hy[__t],Hz[__t],Bx[__t],By[__t],Bz[__t]);
+                  }
+               }
+        }
+
+        // Registers [i0,i1), full tiles then the remainder one register at a time.
+        template<uint32_t STAGES>
+        void chain_range(const PW_Inputs & in,
+                         const PW_Outputs & out,
+                         const uint32_t mask,
+                         const int32_t i0,
+                         const int32_t i1) {
+               int32_t i{i0};
+               for(; i+PW_FUSED_TILE <= i1; i += PW_FUSED_TILE)
+                   chain_tile<STAGES,PW_FUSED_TILE>(in,out,mask,i);
+               for(; i != i1; ++i)
+                   chain_tile<STAGES,1>(in,out,mask,i);
+        }
+
+        typedef void (*chain_range_fn)(const PW_Inputs &,const PW_Outputs &,
+                                       const uint32_t,const int32_t,const int32_t);
+
+        chain_range_fn select_chain(const uint32_t stages) {
+               switch(stages) {
+                      case S_DIR                   : return (&chain_range<S_DIR>);
+                      case S_POL                   : return (&chain_range<S_POL>);
+                      case S_DIR|S_POL             : return (&chain_range<S_DIR|S_POL>);
+                      case S_DIR|S_POL|S_H         : return (&chain_range<S_DIR|S_POL|S_H>);
+                      case S_DIR|S_POL|S_H|S_B     : return (&chain_range<S_DIR|S_POL|S_H|S_B>);
+                      default                      : return (nullptr);
+               }
+        }
+
+        bool outputs_present(const PW_Outputs & out,
+                             const uint32_t mask) {
+               if((mask & PW_OUT__DIR) && (!out.dvx || !out.dvy || !out.dvz)) return (false);
+               if((mask & PW_OUT__POL) && (!out.pvx || !out.pvy || !out.pvz)) return (false);
+               if((mask & PW_OUT__H)   && (!out.Hx  || !out.Hy  || !out.Hz))  return (false);
+               if((mask & PW_OUT__B)   && (!out.Bx  || !out.By  || !out.Bz))  return (false);
+               if((mask & PW_OUT__HNORM) && !out.Hn) return (false);
+               if((mask & PW_OUT__BNORM) && !out.Bn) return (false);
+               if((mask & PW_OUT__HBDOT) && !out.HB) return (false);
+               return (true);
+        }
+
+}
+
+
+uint32_t
+gms::radiolocation::pw_stages_of(const uint32_t out) {
+         uint32_t s{out & (PW_OUT__DIR|PW_OUT__POL)};
+         if(out & (PW_OUT__H|PW_OUT__HNORM))
+            s |= PW_OUT__DIR|PW_OUT__POL|PW_OUT__H;
+         if(out & (PW_OUT__B|PW_OUT__BNORM|PW_OUT__HBDOT))
+            s |= PW_OUT__DIR|PW_OUT__POL|PW_OUT__H|PW_OUT__B;
+         return (s);
+}
+
+
+uint64_t
+gms::radiolocation::pw_bytes_unfused(const uint32_t out,
+                                     const int32_t n) {
+         // registers moved per point register: dir 2+3, pol 3+3, H 11+6, B 12+6, cnorm 6+1, cdotv 12+2
+         const uint32_t s{pw_stages_of(out)};
+         uint64_t r{0ull};
+         if(s & PW_OUT__DIR)     r += 5ull;
+         if(s & PW_OUT__POL)     r += 6ull;
+         if(s & PW_OUT__H)       r += 17ull;
+         if(s & PW_OUT__B)       r += 18ull;
+         if(out & PW_OUT__HNORM) r += 7ull;
+         if(out & PW_OUT__BNORM) r += 7ull;
+         if(out & PW_OUT__HBDOT) r += 14ull;
+         return (r*sizeof(__m512)*static_cast<uint64_t>(n));
+}
+
+
+uint64_t
+gms::radiolocation::pw_bytes_fused(const uint32_t out,
+                                   const int32_t n) {
+         const uint32_t s{pw_stages_of(out)};
+         uint64_t r{0ull};
+         if(s & (PW_OUT__DIR|PW_OUT__POL)) r += 2ull;  // tht,phi
+         if(s & PW_OUT__POL)     r += 1ull;            // psi
+         if(s & PW_OUT__H)       r += 5ull;            // px,py,pz,k
+         if(s & PW_OUT__B)       r += 1ull;            // omg
+         if(out & PW_OUT__DIR)   r += 3ull;
+         if(out & PW_OUT__POL)   r += 3ull;
+         if(out & PW_OUT__H)     r += 6ull;
+         if(out & PW_OUT__B)     r += 6ull;
+         if(out & PW_OUT__HNORM) r += 1ull;
+         if(out & PW_OUT__BNORM) r += 1ull;
+         if(out & PW_OUT__HBDOT) r += 2ull;
+         return (r*sizeof(__m512)*static_cast<uint64_t>(n));
+}
+
+
+void
+gms::radiolocation::pw_dir_vec_zmm16r4(const __m512 * __restrict tht,
+                                       const __m512 * __restrict phi,
+                                       __m512 * __restrict dvx,
+                                       __m512 * __restrict dvy,
+                                       __m512 * __restrict dvz,
+                                       const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i) {
+             const trig_t t{stage_trig(tht[__i],phi[__i])};
+             stage_dir(t,dvx[__i],dvy[__i],dvz[__i]);
+         }
+}
+
+
+void
+gms::radiolocation::pw_pol_vec_zmm16r4(const __m512 * __restrict tht,
+                                       const __m512 * __restrict phi,
+                                       const __m512 * __restrict psi,
+                                       __m512 * __restrict pvx,
+                                       __m512 * __restrict pvy,
+                                       __m512 * __restrict pvz,
+                                       const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i) {
+             const trig_t t{stage_trig(tht[__i],phi[__i])};
+             stage_pol(t,psi[__i],pvx[__i],pvy[__i],pvz[__i]);
+         }
+}
+
+
+void
+gms::radiolocation::pw_H_XYZ_VP_zmm16c4(const __m512 * __restrict pvx,
+                                        const __m512 * __restrict pvy,
+                                        const __m512 * __restrict pvz,
+                                        const __m512 * __restrict dvx,
+                                        const __m512 * __restrict dvy,
+                                        const __m512 * __restrict dvz,
+                                        const __m512 * __restrict px,
+                                        const __m512 * __restrict py,
+                                        const __m512 * __restrict pz,
+                                        const PW_ZMM16C4 * __restrict k,
+                                        PW_ZMM16C4 * __restrict Hx,
+                                        PW_ZMM16C4 * __restrict Hy,
+                                        PW_ZMM16C4 * __restrict Hz,
+                                        const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i)
+             stage_H(pvx[__i],pvy[__i],pvz[__i],dvx[__i],dvy[__i],dvz[__i],
+                     px[__i],py[__i],pz[__i],k[__i],Hx[__i],Hy[__i],Hz[__i]);
+}
+
+
+void
+gms::radiolocation::pw_B_XYZ_VP_zmm16c4(const __m512 * __restrict dvx,
+                                        const __m512 * __restrict dvy,
+                                        const __m512 * __restrict dvz,
+                                        const PW_ZMM16C4 * __restrict Hx,
+                                        const PW_ZMM16C4 * __restrict Hy,
+                                        const PW_ZMM16C4 * __restrict Hz,
+                                        const __m512 * __restrict omg,
+                                        const PW_ZMM16C4 * __restrict k,
+                                        PW_ZMM16C4 * __restrict Bx,
+                                        PW_ZMM16C4 * __restrict By,
+                                        PW_ZMM16C4 * __restrict Bz,
+                                        const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i)
+             stage_B(dvx[__i],dvy[__i],dvz[__i],Hx[__i],Hy[__i],Hz[__i],
+                     omg[__i],k[__i],Bx[__i],By[__i],Bz[__i]);
+}
+
+
+void
+gms::radiolocation::pw_cnorm_zmm16c4(const PW_ZMM16C4 * __restrict vx,
+                                     const PW_ZMM16C4 * __restrict vy,
+                                     const PW_ZMM16C4 * __restrict vz,
+                                     __m512 * __restrict nrm,
+                                     const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i)
+             nrm[__i] = stage_cnorm(vx[__i],vy[__i],vz[__i]);
+}
+
+
+void
+gms::radiolocation::pw_cdotv_zmm16c4(const PW_ZMM16C4 * __restrict v1x,
+                                     const PW_ZMM16C4 * __restrict v1y,
+                                     const PW_ZMM16C4 * __restrict v1z,
+                                     const PW_ZMM16C4 * __restrict v2x,
+                                     const PW_ZMM16C4 * __restrict v2y,
+                                     const PW_ZMM16C4 * __restrict v2z,
+                                     PW_ZMM16C4 * __restrict dot,
+                                     const int32_t n) {
+         for(int32_t __i{0}; __i != n; ++__i)
+             dot[__i] = stage_cdotv(v1x[__i],v1y[__i],v1z[__i],v2x[__i],v2y[__i],v2z[__i]);
+}
+
+
+int32_t
+gms::radiolocation::pw_field_chain_zmm16r4(const PW_Inputs & in,
+                                           const PW_Outputs & out,
+                                           const uint32_t mask,
+                                           const int32_t n) {
+         const uint32_t s{pw_stages_of(mask)};
+         if(!outputs_present(out,mask|s)) return (1);
+         if(n <= 0) return (0);
+         if(s & PW_OUT__DIR)
+            pw_dir_vec_zmm16r4(in.tht,in.phi,out.dvx,out.dvy,out.dvz,n);
+         if(s & PW_OUT__POL)
+            pw_pol_vec_zmm16r4(in.tht,in.phi,in.psi,out.pvx,out.pvy,out.pvz,n);
+         if(s & PW_OUT__H)
+            pw_H_XYZ_VP_zmm16c4(out.pvx,out.pvy,out.pvz,out.dvx,out.dvy,out.dvz,
+                                in.px,in.py,in.pz,in.k,out.Hx,out.Hy,out.Hz,n);
+         if(mask & PW_OUT__HNORM)
+            pw_cnorm_zmm16c4(out.Hx,out.Hy,out.Hz,out.Hn,n);
+         if(s & PW_OUT__B)
+            pw_B_XYZ_VP_zmm16c4(out.dvx,out.dvy,out.dvz,out.Hx,out.Hy,out.Hz,
+                                in.omg,in.k,out.Bx,out.By,out.Bz,n);
+         if(mask & PW_OUT__BNORM)
+            pw_cnorm_zmm16c4(out.Bx,out.By,out.Bz,out.Bn,n);
+         if(mask & PW_OUT__HBDOT)
+            pw_cdotv_zmm16c4(out.Hx,out.Hy,out.Hz,out.Bx,out.By,out.Bz,out.HB,n);
+         return (0);
+}
+
+
+int32_t
+gms::radiolocation::pw_field_chain_fused_zmm16r4(const PW_Inputs & in,
+                                                 const PW_Outputs & out,
+                                                 const uint32_t mask,
+                                                 const int32_t n) {
+         if(!outputs_present(out,mask)) return (1);
+         const chain_range_fn fn{select_chain(pw_stages_of(mask))};
+         if(fn == nullptr || n <= 0) return (0);
+         fn(in,out,mask,0,n);
+         return (0);
+}
+
+
+int32_t
+gms::radiolocation::pw_field_chain_fused_omp(const PW_Inputs & in,
+                                             const PW_Outputs & out,
+                                             const uint32_t mask,
+                                             const int32_t n) {
+         using namespace gms::common;
+         if(!outputs_present(out,mask)) return (1);
+         const chain_range_fn fn{select_chain(pw_stages_of(mask))};
+         if(fn == nullptr || n <= 0) return (0);
+         // chunks of whole tiles, the last one takes the remainder
+         par_for(par_family::TRANSC,static_cast<std::size_t>(n),sizeof(__m512),PW_FUSED_TILE,
+                 [&](const std::size_t lo,const std::size_t hi) {
+                      fn(in,out,mask,static_cast<int32_t>(lo),static_cast<int32_t>(hi));
+                 });
+         return (0);
+}
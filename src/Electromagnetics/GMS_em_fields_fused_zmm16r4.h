@@ -0,0 +1,244 @@
+#ifndef __GMS_EM_FIELDS_FUSED_ZMM16R4_H__
+#define __GMS_EM_FIELDS_FUSED_ZMM16R4_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_EM_FIELDS_FUSED_ZMM16R4_MAJOR = 1U;
+    const unsigned int GMS_EM_FIELDS_FUSED_ZMM16R4_MINOR = 0U;
+    const unsigned int GMS_EM_FIELDS_FUSED_ZMM16R4_MICRO = 0U;
+    const unsigned int GMS_EM_FIELDS_FUSED_ZMM16R4_FULLVER =
+      1000U*GMS_EM_FIELDS_FUSED_ZMM16R4_MAJOR+100U*GMS_EM_FIELDS_FUSED_ZMM16R4_MINOR+
+      10U*GMS_EM_FIELDS_FUSED_ZMM16R4_MICRO;
+    const char * const GMS_EM_FIELDS_FUSED_ZMM16R4_CREATION_DATE = "22-10-2026 10:15 AM +00200 (THR 22 OCT 2026 GMT+2)";
+    const char * const GMS_EM_FIELDS_FUSED_ZMM16R4_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_EM_FIELDS_FUSED_ZMM16R4_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_EM_FIELDS_FUSED_ZMM16R4_DESCRIPTION   = "Plane-wave field chain (direction, polarization, H, B, norms, dot) -- per-stage and fused register-tile kernels.";
+
+}
+
+/*
+     Plane wave at the points r (px,py,pz), incidence angles tht,phi,
+     polarization angle psi, angular frequency omega, complex wavenumber k:
+          dir  -- dir_vec:   (sin(tht)*cos(phi), sin(tht)*sin(phi), cos(tht)),
+          pol  -- pol_vec:   (cos(psi)*sin(phi)-sin(psi)*cos(tht)*cos(phi),
+                             -cos(psi)*cos(phi)-sin(psi)*cos(tht)*sin(phi),
+                              sin(psi)*sin(tht)),
+          H    -- H_XYZ_VP:  pol*exp(i*k*(dir.r)),
+          B    -- B_XYZ_VP:  k/(omega*mu0)*(dir x H),
+          |H|, |B|           -- cnorm:  sqrt(Re(H.conj(H))),
+          H.B                -- cdotv:  (no conjugation).
+     The pw_*_zmm16r4/pw_*_zmm16c4 kernels run one stage over whole arrays
+     (every intermediate goes through memory). pw_field_chain_fused_zmm16r4
+     runs the chain over tiles of PW_FUSED_TILE registers and stores only the
+     outputs selected by the PW_OUT__* mask, the intermediates stay in registers
+     (and the stack slots spilled around the sin/cos/exp calls). Both paths
+     evaluate the same stage code, every stage output is a contraction barrier,
+     so the fused outputs are bitwise equal to the per-stage chain.
+     sin/cos/exp -- SLEEF xsinf/xcosf/xexpf (GMS_sleefsimdsp.cpp, -DENABLE_AVX512F).
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include "GMS_config.h"
+
+/*
+    Registers (16 points each) per step of the fused chain.
+*/
+#if !defined(PW_FUSED_TILE)
+#define PW_FUSED_TILE 2
+#endif
+
+#define PW_OUT__DIR     0x01u   // dvx,dvy,dvz
+#define PW_OUT__POL     0x02u   // pvx,pvy,pvz
+#define PW_OUT__H       0x04u   // Hx,Hy,Hz
+#define PW_OUT__B       0x08u   // Bx,By,Bz
+#define PW_OUT__HNORM   0x10u   // |H|
+#define PW_OUT__BNORM   0x20u   // |B|
+#define PW_OUT__HBDOT   0x40u   // H.B
+#define PW_OUT__ALL     0x7Fu
+
+namespace gms {
+
+        namespace radiolocation {
+
+                  typedef struct __ATTR_ALIGN__(64) PW_ZMM16C4 {
+
+                          __m512 re;
+                          __m512 im;
+                  } PW_ZMM16C4;
+
+                  /*
+                        Inputs of the chain, n registers each.
+                  */
+                  typedef struct PW_Inputs {
+
+                          const __m512     * __restrict tht;
+                          const __m512     * __restrict phi;
+                          const __m512     * __restrict psi;
+                          const __m512     * __restrict omg;
+                          const __m512     * __restrict px;
+                          const __m512     * __restrict py;
+                          const __m512     * __restrict pz;
+                          const PW_ZMM16C4 * __restrict k;
+                  } PW_Inputs;
+
+                  /*
+                        Outputs of the chain, only the members selected by the output
+                        mask are referenced. The per-stage chain uses the members of the
+                        stages it runs as the intermediate arrays.
+                  */
+                  typedef struct PW_Outputs {
+
+                          __m512     * __restrict dvx;
+                          __m512     * __restrict dvy;
+                          __m512     * __restrict dvz;
+                          __m512     * __restrict pvx;
+                          __m512     * __restrict pvy;
+                          __m512     * __restrict pvz;
+                          PW_ZMM16C4 * __restrict Hx;
+                          PW_ZMM16C4 * __restrict Hy;
+                          PW_ZMM16C4 * __restrict Hz;
+                          PW_ZMM16C4 * __restrict Bx;
+                          PW_ZMM16C4 * __restrict By;
+                          PW_ZMM16C4 * __restrict Bz;
+                          __m512     * __restrict Hn;
+                          __m512     * __restrict Bn;
+                          PW_ZMM16C4 * __restrict HB;
+                  } PW_Outputs;
+
+                  /*
+                        Stages the output mask depends on (PW_OUT__DIR|POL|H|B bits).
+                  */
+                  uint32_t pw_stages_of(const uint32_t out);
+
+                  /*
+                        Bytes read and written by the per-stage and the fused chain
+                        for n registers and the output mask.
+                  */
+                  uint64_t pw_bytes_unfused(const uint32_t out,
+                                            const int32_t n);
+
+                  uint64_t pw_bytes_fused(const uint32_t out,
+                                          const int32_t n);
+
+                  /*
+                        Per-stage kernels.
+                  */
+                  __ATTR_HOT__
+                  void pw_dir_vec_zmm16r4(const __m512 * __restrict tht,
+                                          const __m512 * __restrict phi,
+                                          __m512 * __restrict dvx,
+                                          __m512 * __restrict dvy,
+                                          __m512 * __restrict dvz,
+                                          const int32_t n);
+
+                  __ATTR_HOT__
+                  void pw_pol_vec_zmm16r4(const __m512 * __restrict tht,
+                                          const __m512 * __restrict phi,
+                                          const __m512 * __restrict psi,
+                                          __m512 * __restrict pvx,
+                                          __m512 * __restrict pvy,
+                                          __m512 * __restrict pvz,
+                                          const int32_t n);
+
+                  __ATTR_HOT__
+                  void pw_H_XYZ_VP_zmm16c4(const __m512 * __restrict pvx,
+                                           const __m512 * __restrict pvy,
+                                           const __m512 * __restrict pvz,
+                                           const __m512 * __restrict dvx,
+                                           const __m512 * __restrict dvy,
+                                           const __m512 * __restrict dvz,
+                                           const __m512 * __restrict px,
+                                           const __m512 * __restrict py,
+                                           const __m512 * __restrict pz,
+                                           const PW_ZMM16C4 * __restrict k,
+                                           PW_ZMM16C4 * __restrict Hx,
+                                           PW_ZMM16C4 * __restrict Hy,
+                                           PW_ZMM16C4 * __restrict Hz,
+                                           const int32_t n);
+
+                  __ATTR_HOT__
+                  void pw_B_XYZ_VP_zmm16c4(const __m512 * __restrict dvx,
+                                           const __m512 * __restrict dvy,
+                                           const __m512 * __restrict dvz,
+                                           const PW_ZMM16C4 * __restrict Hx,
+                                           const PW_ZMM16C4 * __restrict Hy,
+                                           const PW_ZMM16C4 * __restrict Hz,
+                                           const __m512 * __restrict omg,
+                                           const PW_ZMM16C4 * __restrict k,
+                                           PW_ZMM16C4 * __restrict Bx,
+                                           PW_ZMM16C4 * __restrict By,
+                                           PW_ZMM16C4 * __restrict Bz,
+                                           const int32_t n);
+
+                  __ATTR_HOT__
+                  void pw_cnorm_zmm16c4(const PW_ZMM16C4 * __restrict vx,
+                                        const PW_ZMM16C4 * __restrict vy,
+                                        const PW_ZMM16C4 * __restrict vz,
+                                        __m512 * __restrict nrm,
+                                        const int32_t n);
+
+                  __ATTR_HOT__
+                  void pw_cdotv_zmm16c4(const PW_ZMM16C4 * __restrict v1x,
+                                        const PW_ZMM16C4 * __restrict v1y,
+                                        const PW_ZMM16C4 * __restrict v1z,
+                                        const PW_ZMM16C4 * __restrict v2x,
+                                        const PW_ZMM16C4 * __restrict v2y,
+                                        const PW_ZMM16C4 * __restrict v2z,
+                                        PW_ZMM16C4 * __restrict dot,
+                                        const int32_t n);
+
+                  /*
+                        The chain stage by stage (the reference of the fused kernels).
+                        Returns 0 -- success, 1 -- an array of a stage or an output
+                        selected by out is nullptr.
+                  */
+                  int32_t pw_field_chain_zmm16r4(const PW_Inputs & in,
+                                                 const PW_Outputs & out,
+                                                 const uint32_t mask,
+                                                 const int32_t n);
+
+                  /*
+                        The fused chain, only the outputs selected by mask are
+                        referenced. Returns 0 -- success, 1 -- a selected output is nullptr.
+                  */
+                  __ATTR_HOT__
+                  int32_t pw_field_chain_fused_zmm16r4(const PW_Inputs & in,
+                                                       const PW_Outputs & out,
+                                                       const uint32_t mask,
+                                                       const int32_t n);
+
+                  /*
+                        Parallel, the worker team of GMS_par_team (family TRANSC,
+                        serial below its threshold), chunks of whole tiles.
+                  */
+                  __ATTR_HOT__
+                  int32_t pw_field_chain_fused_omp(const PW_Inputs & in,
+                                                   const PW_Outputs & out,
+                                                   const uint32_t mask,
+                                                   const int32_t n);
+
+        } // radiolocation
+
+} // gms
+
+#endif /*__GMS_EM_FIELDS_FUSED_ZMM16R4_H__*/
@@ -0,0 +1,1853 @@
+/*
+
+
+SOFTWARE DISCLAIMER / RELEASE
+
+This software was developed by employees of the National Telecommunications and Information Administration (NTIA), an agency of the Federal Government and is provided to you as a public service. Pursuant to Title 15 United States Code Section 105, works of NTIA employees are not subject to copyright protection within the United States.
+
+The software is provided by NTIA “AS IS.” NTIA MAKES NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED OR STATUTORY, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NTIA does not warrant or make any representations regarding the use of the software or the results thereof, including but not limited to the correctness, accuracy, reliability or usefulness of the software.
+
+To the extent that NTIA holds rights in countries other than the United States, you are hereby granted the non-exclusive irrevocable and unconditional right to print, publish, prepare derivative works and distribute the NTIA software, in any medium, or authorize others to do so on your behalf, on a royalty-free basis throughout the World.
+
+You may improve, modify, and create derivative works of the software or any portion of the software, and you may copy and distribute such modifications or works. Modified works should carry a notice stating that you changed the software and should note the date and nature of any such change.
+
+You are solely responsible for determining the appropriateness of using and distributing the software and you assume all risks associated with its use, including but not limited to the risks and costs of program errors, compliance with applicable laws, damage to or loss of data, programs or equipment, and the unavailability or interruption of operation. This software is not intended to be used in any situation where a failure could cause risk of injury or damage to property.
+
+Please provide appropriate acknowledgments of NTIA’s creation of the software in any copies or derivative works of this software.
+
+
+   Point-to-point and area mode engine, 16 links per AVX512 register,
+   by Bernard Gingold on 19-10-2026.
+*/
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+#include "GMS_itm_p2p_avx512.h"
+
+
+namespace {
+
+        // Climate dependent variability curves [ERL 79-ITS 67], index klim-1.
+        const double bv1[7]  = {-9.67,-0.62,1.26,-9.21,-0.62,-0.39,3.15};
+        const double bv2[7]  = {12.7,9.19,15.5,9.05,9.19,2.86,857.9};
+        const double xv1[7]  = {144.9e3,228.9e3,262.6e3,84.1e3,228.9e3,141.7e3,2222.e3};
+        const double xv2[7]  = {190.3e3,205.2e3,185.2e3,101.1e3,205.2e3,315.9e3,164.8e3};
+        const double xv3[7]  = {133.8e3,143.6e3,99.8e3,98.6e3,143.6e3,167.4e3,116.3e3};
+        const double bsm1[7] = {2.13,2.66,6.11,1.98,2.68,6.86,8.51};
+        const double bsm2[7] = {159.5,7.67,6.65,13.11,7.16,10.38,169.8};
+        const double xsm1[7] = {762.2e3,100.4e3,138.2e3,139.1e3,93.7e3,187.8e3,609.8e3};
+        const double xsm2[7] = {123.6e3,172.5e3,242.2e3,132.7e3,186.8e3,169.6e3,119.9e3};
+        const double xsm3[7] = {94.5e3,136.4e3,178.6e3,193.5e3,133.5e3,108.9e3,106.6e3};
+        const double bsp1[7] = {2.11,6.87,10.08,3.68,4.75,8.58,8.43};
+        const double bsp2[7] = {102.3,15.53,9.60,159.3,8.12,13.97,8.19};
+        const double xsp1[7] = {636.9e3,138.7e3,165.3e3,464.4e3,93.2e3,216.0e3,136.2e3};
+        const double xsp2[7] = {134.8e3,143.7e3,225.7e3,93.1e3,135.9e3,152.0e3,188.5e3};
+        const double xsp3[7] = {95.6e3,98.6e3,129.7e3,94.2e3,113.4e3,122.7e3,122.9e3};
+        const double bsd1[7] = {1.224,0.801,1.380,1.000,1.224,1.518,1.518};
+        const double bzd1[7] = {1.282,2.161,1.282,20.,1.282,1.282,1.282};
+        const double bfm1[7] = {1.0,1.0,1.0,1.0,0.92,1.0,1.0};
+        const double bfm2[7] = {0.0,0.0,0.0,0.0,0.25,0.0,0.0};
+        const double bfm3[7] = {0.0,0.0,0.0,0.0,1.77,0.0,0.0};
+        const double bfp1[7] = {1.0,0.93,1.0,0.93,0.93,1.0,1.0};
+        const double bfp2[7] = {0.0,0.31,0.0,0.19,0.31,0.0,0.0};
+        const double bfp3[7] = {0.0,2.00,0.0,1.79,2.00,0.0,0.0};
+
+        // Largest number of samples of the delta_h profile segment (10*25-5).
+        constexpr int32_t itm_dlthx_nmax{245};
+
+        inline double fdim(const double x,
+                           const double y) {
+               return ((x > y) ? x-y : 0.0);
+        }
+
+        // Standard normal deviate exceeded with the probability q (0 < q < 1).
+        double qerfi(const double q) {
+               constexpr double c0{2.515516698};
+               constexpr double c1{0.802853};
+               constexpr double c2{0.010328};
+               constexpr double d1{1.432788};
+               constexpr double d2{0.189269};
+               constexpr double d3{0.001308};
+               const double x{0.5-q};
+               double t{std::max(0.5-std::fabs(x),0.000001)};
+               t = std::sqrt(-2.0*std::log(t));
+               double v{t-((c2*t+c1)*t+c0)/(((d3*t+d2)*t+d1)*t+1.0)};
+               if(x < 0.0) v = -v;
+               return (v);
+        }
+
+        inline double curve(const double c1,
+                             const double c2,
+                             const double x1,
+                             const double x2,
+                             const double x3,
+                             const double de) {
+               double t1{(de-x2)/x3};
+               double t2{de/x1};
+               t1 *= t1;
+               t2 *= t2;
+               return ((c1+c2/(1.0+t1))*t2/(1.0+t2));
+        }
+
+        /*
+              Variability constants of one call (the klim/mdvar part of avar).
+        */
+        struct itm_var_t {
+               double  cv1,cv2,yv1,yv2,yv3;
+               double  csm1,csm2,ysm1,ysm2,ysm3;
+               double  csp1,csp2,ysp1,ysp2,ysp3;
+               double  csd1,zd,gm,gp;
+               double  zt,zl,zc;
+               int32_t kdv;
+               int32_t kwx;
+               bool    ws;
+               bool    w1;
+        };
+
+        void itm_var_init(itm_var_t & v,
+                          const gms::math::ITM_Params & p,
+                          const double wn) {
+               int32_t klim{p.climate};
+               v.kwx = 0;
+               if(klim <= 0 || klim > 7) {
+                  klim  = CLIMATE__CONTINENTAL_TEMPERATE;
+                  v.kwx = 2;
+               }
+               const int32_t k{klim-1};
+               v.cv1  = bv1[k];  v.cv2  = bv2[k];  v.yv1  = xv1[k];  v.yv2  = xv2[k];  v.yv3  = xv3[k];
+               v.csm1 = bsm1[k]; v.csm2 = bsm2[k]; v.ysm1 = xsm1[k]; v.ysm2 = xsm2[k]; v.ysm3 = xsm3[k];
+               v.csp1 = bsp1[k]; v.csp2 = bsp2[k]; v.ysp1 = xsp1[k]; v.ysp2 = xsp2[k]; v.ysp3 = xsp3[k];
+               v.csd1 = bsd1[k]; v.zd = bzd1[k];
+               int32_t kdv{p.mdvar};
+               v.ws = kdv >= 20;
+               if(v.ws) kdv -= 20;
+               v.w1 = kdv >= 10;
+               if(v.w1) kdv -= 10;
+               if(kdv < 0 || kdv > 3) {
+                  kdv   = 0;
+                  v.kwx = 2;
+               }
+               v.kdv = kdv;
+               const double q{std::log(0.133*wn)};
+               v.gm = bfm1[k]+bfm2[k]/(std::pow(bfm3[k]*q,2.0)+1.0);
+               v.gp = bfp1[k]+bfp2[k]/(std::pow(bfp3[k]*q,2.0)+1.0);
+               double zt{qerfi(0.01*p.time)};
+               double zl{qerfi(0.01*p.location)};
+               const double zc{qerfi(0.01*p.situation)};
+               switch(kdv) {
+                   case 0: zt = zc; zl = zc; break;
+                   case 1: zl = zc; break;
+                   case 2: zl = zt; break;
+                   default: break;
+               }
+               if(std::fabs(zt) > 3.1 || std::fabs(zl) > 3.1 || std::fabs(zc) > 3.1) v.kwx = std::max(v.kwx,1);
+               v.zt = zt;
+               v.zl = zl;
+               v.zc = zc;
+        }
+
+        // Ground transfer impedance
+        std::complex<double> itm_zgnd(const gms::math::ITM_Params & p) {
+               const std::complex<double> zq(p.epsilon,376.62*p.sigma*47.7/p.f_mhz);
+               std::complex<double> z{std::sqrt(zq-1.0)};
+               if(p.polarization != POLARIZATION__HORIZONTAL) z /= zq;
+               return (z);
+        }
+
+        /*
+              State of one link (prop/propa of the NTIA code, the static
+              variables of lrprop/adiff/alos/ascat live here).
+        */
+        struct itm_prop_t {
+               double  hg[2];
+               double  he[2];
+               double  dl[2];
+               double  the[2];
+               double  dh;
+               double  dist;
+               double  wn;
+               double  gme;
+               double  ens;
+               std::complex<double> zgnd;
+               int32_t kwx;
+               int32_t mdp;
+               double  dls[2];
+               double  dlsa,dla,tha,dmin,xae;
+               double  emd,aed,ak1,ak2,ael,ems,aes,dx;
+               double  wd1,xd1,afo,qk,aht,xht;
+               double  wls;
+               double  ad,rr,etq,h0s;
+        };
+
+        void itm_qlrps(itm_prop_t & s,
+                       const gms::math::ITM_Params & p,
+                       const double zsys) {
+               s.wn  = p.f_mhz/47.7;
+               s.ens = p.N_0;
+               if(zsys != 0.0) s.ens *= std::exp(-zsys/9460.0);
+               s.gme  = 157.0e-9*(1.0-0.04665*std::exp(s.ens/179.3));
+               s.zgnd = itm_zgnd(p);
+        }
+
+        // Terminal horizon angles and distances.
+        void itm_hzns(const double * __restrict pfl,
+                      itm_prop_t & s) {
+               const int32_t np{static_cast<int32_t>(pfl[0])};
+               const double xi{pfl[1]};
+               const double za{pfl[2]+s.hg[0]};
+               const double zb{pfl[np+2]+s.hg[1]};
+               const double qc{0.5*s.gme};
+               const double q{qc*s.dist};
+               s.the[1] = (zb-za)/s.dist;
+               s.the[0] = s.the[1]-q;
+               s.the[1] = -s.the[1]-q;
+               s.dl[0]  = s.dist;
+               s.dl[1]  = s.dist;
+               for(int32_t __i{1}; __i < np; ++__i) {
+                   const double sa{__i*xi};
+                   const double sb{s.dist-sa};
+                   const double ta{(pfl[__i+2]-za)/sa-qc*sa};
+                   const double tb{(pfl[__i+2]-zb)/sb-qc*sb};
+                   if(ta > s.the[0]) {
+                      s.the[0] = ta;
+                      s.dl[0]  = sa;
+                   }
+                   if(tb > s.the[1]) {
+                      s.the[1] = tb;
+                      s.dl[1]  = sb;
+                   }
+               }
+        }
+
+        // Least squares line through z[2..] between x1 and x2, ends z0 (x=0) and zn (x=z[0]*z[1]).
+        void itm_zlsq1(const double * __restrict z,
+                       const double x1,
+                       const double x2,
+                       double & z0,
+                       double & zn) {
+               const double xn{z[0]};
+               double xa{static_cast<double>(static_cast<int32_t>(fdim(x1/z[1],0.0)))};
+               double xb{xn-static_cast<double>(static_cast<int32_t>(fdim(xn,x2/z[1])))};
+               if(xb <= xa) {
+                  xa = fdim(xa,1.0);
+                  xb = xn-fdim(xn,xb+1.0);
+               }
+               int32_t ja{static_cast<int32_t>(xa)};
+               const int32_t jb{static_cast<int32_t>(xb)};
+               const int32_t n{jb-ja};
+               xa = xb-xa;
+               double x{-0.5*xa};
+               xb += x;
+               double a{0.5*(z[ja+2]+z[jb+2])};
+               double b{0.5*(z[ja+2]-z[jb+2])*x};
+               for(int32_t __i{2}; __i <= n; ++__i) {
+                   ++ja;
+                   x += 1.0;
+                   a += z[ja+2];
+                   b += z[ja+2]*x;
+               }
+               a /= xa;
+               b  = b*12.0/((xa*xa+2.0)*xa);
+               z0 = a-b*xb;
+               zn = a+b*(xn-xb);
+        }
+
+        // Interdecile range of the terrain heights between x1 and x2, corrected to the path length.
+        double itm_dlthx(const double * __restrict pfl,
+                         const double x1,
+                         const double x2) {
+               const int32_t np{static_cast<int32_t>(pfl[0])};
+               double xa{x1/pfl[1]};
+               double xb{x2/pfl[1]};
+               if(xb-xa < 2.0) return (0.0);
+               int32_t ka{static_cast<int32_t>(0.1*(xb-xa+8.0))};
+               ka = std::min(std::max(4,ka),25);
+               const int32_t n{10*ka-5};
+               const int32_t kb{n-ka+1};
+               const double sn{static_cast<double>(n-1)};
+               double s[itm_dlthx_nmax+2];
+               s[0] = sn;
+               s[1] = 1.0;
+               xb = (xb-xa)/sn;
+               int32_t k{static_cast<int32_t>(xa+1.0)};
+               xa -= static_cast<double>(k);
+               for(int32_t __j{0}; __j != n; ++__j) {
+                   while(xa > 0.0 && k < np) {
+                         xa -= 1.0;
+                         ++k;
+                   }
+                   s[__j+2] = pfl[k+2]+(pfl[k+2]-pfl[k+1])*xa;
+                   xa += xb;
+               }
+               itm_zlsq1(s,0.0,sn,xa,xb);
+               xb = (xb-xa)/sn;
+               for(int32_t __j{0}; __j != n; ++__j) {
+                   s[__j+2] -= xa;
+                   xa += xb;
+               }
+               std::nth_element(s+2,s+2+(ka-1),s+2+n,std::greater<double>());
+               const double q10{s[2+ka-1]};
+               std::nth_element(s+2,s+2+(kb-1),s+2+n,std::greater<double>());
+               const double q90{s[2+kb-1]};
+               return ((q10-q90)/(1.0-0.8*std::exp(-(x2-x1)/50.0e3)));
+        }
+
+        // Effective heights, horizons and delta_h of a profile (qlrpfl).
+        void itm_qlrpfl(const double * __restrict pfl,
+                        itm_prop_t & s) {
+               const int32_t np{static_cast<int32_t>(pfl[0])};
+               s.dist = pfl[0]*pfl[1];
+               itm_hzns(pfl,s);
+               double xl[2];
+               for(int32_t __j{0}; __j != 2; ++__j)
+                   xl[__j] = std::min(15.0*s.hg[__j],0.1*s.dl[__j]);
+               xl[1] = s.dist-xl[1];
+               s.dh  = itm_dlthx(pfl,xl[0],xl[1]);
+               double za,zb,q;
+               if(s.dl[0]+s.dl[1] > 1.5*s.dist) {
+                  itm_zlsq1(pfl,xl[0],xl[1],za,zb);
+                  s.he[0] = s.hg[0]+fdim(pfl[2],za);
+                  s.he[1] = s.hg[1]+fdim(pfl[np+2],zb);
+                  for(int32_t __j{0}; __j != 2; ++__j)
+                      s.dl[__j] = std::sqrt(2.0*s.he[__j]/s.gme)*std::exp(-0.07*std::sqrt(s.dh/std::max(s.he[__j],5.0)));
+                  q = s.dl[0]+s.dl[1];
+                  if(q <= s.dist) {
+                     q = s.dist/q;
+                     q *= q;
+                     for(int32_t __j{0}; __j != 2; ++__j) {
+                         s.he[__j] *= q;
+                         s.dl[__j]  = std::sqrt(2.0*s.he[__j]/s.gme)*std::exp(-0.07*std::sqrt(s.dh/std::max(s.he[__j],5.0)));
+                     }
+                  }
+                  for(int32_t __j{0}; __j != 2; ++__j) {
+                      q = std::sqrt(2.0*s.he[__j]/s.gme);
+                      s.the[__j] = (0.65*s.dh*(q/s.dl[__j]-1.0)-2.0*s.he[__j])/q;
+                  }
+               }
+               else {
+                  itm_zlsq1(pfl,xl[0],0.9*s.dl[0],za,q);
+                  itm_zlsq1(pfl,s.dist-0.9*s.dl[1],xl[1],q,zb);
+                  s.he[0] = s.hg[0]+fdim(pfl[2],za);
+                  s.he[1] = s.hg[1]+fdim(pfl[np+2],zb);
+               }
+               s.mdp = -1;
+        }
+
+        // Effective heights and horizons of the area mode (qlra).
+        void itm_qlra(const int32_t * __restrict kst,
+                      itm_prop_t & s) {
+               for(int32_t __j{0}; __j != 2; ++__j) {
+                   if(kst[__j] <= SITING_CRITERIA__RANDOM) {
+                      s.he[__j] = s.hg[__j];
+                   }
+                   else {
+                      double q{(kst[__j] != SITING_CRITERIA__CAREFUL) ? 9.0 : 4.0};
+                      if(s.hg[__j] < 5.0) q *= std::sin(0.3141593*s.hg[__j]);
+                      s.he[__j] = s.hg[__j]+(1.0+q)*std::exp(-std::min(20.0,2.0*s.hg[__j]/std::max(1.0e-3,s.dh)));
+                   }
+                   const double q{std::sqrt(2.0*s.he[__j]/s.gme)};
+                   s.dl[__j]  = q*std::exp(-0.07*std::sqrt(s.dh/std::max(s.he[__j],5.0)));
+                   s.the[__j] = (0.65*s.dh*(q/s.dl[__j]-1.0)-2.0*s.he[__j])/q;
+               }
+               s.mdp = 1;
+        }
+
+        // Knife edge diffraction loss, v2 = v^2/2.
+        inline double aknfe(const double v2) {
+               return ((v2 < 5.76) ? 6.02+9.11*std::sqrt(v2)-1.27*v2 : 12.953+10.0*std::log10(v2));
+        }
+
+        // Height gain over a smooth spherical earth.
+        double fht(const double x,
+                   const double pk) {
+               double w,f;
+               if(x < 200.0) {
+                  w = -std::log(pk);
+                  if(pk < 1.0e-5 || x*w*w*w > 5495.0) {
+                     f = -117.0;
+                     if(x > 1.0) f += 17.372*std::log(x);
+                  }
+                  else {
+                     f = 2.5e-5*x*x/pk-8.686*w-15.0;
+                  }
+               }
+               else {
+                  f = 0.05751*x-4.343*std::log(x);
+                  if(x < 2000.0) {
+                     w = 0.0134*x*std::exp(-0.005*x);
+                     f = (1.0-w)*f+w*(17.372*std::log(x)-117.0);
+                  }
+               }
+               return (f);
+        }
+
+        // Frequency gain function of the troposcatter.
+        double h0f(const double r,
+                   const double et) {
+               const double a[5] = {25.0,80.0,177.0,395.0,705.0};
+               const double b[5] = {24.0,45.0,68.0,80.0,105.0};
+               int32_t it{static_cast<int32_t>(et)};
+               double q;
+               if(it <= 0) {
+                  it = 1;
+                  q  = 0.0;
+               }
+               else if(it >= 5) {
+                  it = 5;
+                  q  = 0.0;
+               }
+               else {
+                  q = et-static_cast<double>(it);
+               }
+               const double x{1.0/(r*r)};
+               double h{4.343*std::log((a[it-1]*x+b[it-1])*x+1.0)};
+               if(q != 0.0) h = (1.0-q)*h+q*4.343*std::log((a[it]*x+b[it])*x+1.0);
+               return (h);
+        }
+
+        // Attenuation function of the troposcatter, td = theta*d.
+        inline double ahd(const double td) {
+               const double a[3] = {133.4,104.6,71.8};
+               const double b[3] = {0.332e-3,0.212e-3,0.157e-3};
+               const double c[3] = {-4.343,-1.086,2.171};
+               const int32_t i{(td <= 10.0e3) ? 0 : ((td <= 70.0e3) ? 1 : 2)};
+               return (a[i]+b[i]*td+c[i]*std::log(td));
+        }
+
+        // Diffraction attenuation, d == 0 initializes.
+        double itm_adiff(const double d,
+                         itm_prop_t & s) {
+               if(d == 0.0) {
+                  double q{s.hg[0]*s.hg[1]};
+                  s.qk = s.he[0]*s.he[1]-q;
+                  if(s.mdp < 0) q += 10.0;
+                  s.wd1 = std::sqrt(1.0+s.qk/q);
+                  s.xd1 = s.dla+s.tha/s.gme;
+                  q = (1.0-0.8*std::exp(-s.dlsa/50.0e3))*s.dh;
+                  q *= 0.78*std::exp(-std::pow(q/16.0,0.25));
+                  s.afo = std::min(15.0,2.171*std::log(1.0+4.77e-4*s.hg[0]*s.hg[1]*s.wn*q));
+                  s.qk  = 1.0/std::abs(s.zgnd);
+                  s.aht = 20.0;
+                  s.xht = 0.0;
+                  for(int32_t __j{0}; __j != 2; ++__j) {
+                      const double a{0.5*s.dl[__j]*s.dl[__j]/s.he[__j]};
+                      const double wa{std::cbrt(a*s.wn)};
+                      const double pk{s.qk/wa};
+                      q = (1.607-pk)*151.0*wa*s.dl[__j]/a;
+                      s.xht += q;
+                      s.aht += fht(q,pk);
+                  }
+                  return (0.0);
+               }
+               const double th{s.tha+d*s.gme};
+               const double ds{d-s.dla};
+               double q{0.0795775*s.wn*ds*th*th};
+               const double ak{aknfe(q*s.dl[0]/(ds+s.dl[0]))+aknfe(q*s.dl[1]/(ds+s.dl[1]))};
+               const double a{ds/th};
+               const double wa{std::cbrt(a*s.wn)};
+               const double pk{s.qk/wa};
+               q = (1.607-pk)*151.0*wa*th+s.xht;
+               const double ar{0.05751*q-4.343*std::log(q)-s.aht};
+               q = (s.wd1+s.xd1/d)*std::min((1.0-0.8*std::exp(-d/50.0e3))*s.dh*s.wn,6283.2);
+               const double wd{25.1/(25.1+std::sqrt(q))};
+               return (ar*wd+(1.0-wd)*ak+s.afo);
+        }
+
+        // Line-of-sight attenuation, d == 0 initializes.
+        double itm_alos(const double d,
+                        itm_prop_t & s) {
+               if(d == 0.0) {
+                  s.wls = 0.021/(0.021+s.wn*s.dh/std::max(10.0e3,s.dlsa));
+                  return (0.0);
+               }
+               double q{(1.0-0.8*std::exp(-d/50.0e3))*s.dh};
+               const double sg{0.78*q*std::exp(-std::pow(q/16.0,0.25))};
+               q = s.he[0]+s.he[1];
+               const double sps{q/std::sqrt(d*d+q*q)};
+               std::complex<double> r{(sps-s.zgnd)/(sps+s.zgnd)*std::exp(-std::min(10.0,s.wn*sg*sps))};
+               q = std::norm(r);
+               if(q < 0.25 || q < sps) r *= std::sqrt(sps/q);
+               const double al{s.emd*d+s.aed};
+               q = s.wn*s.he[0]*s.he[1]*2.0/d;
+               if(q > 1.57) q = 3.14-2.4649/q;
+               return ((-4.343*std::log(std::norm(std::complex<double>(std::cos(q),-std::sin(q))+r))-al)*s.wls+al);
+        }
+
+        // Troposcatter attenuation, d == 0 initializes.
+        double itm_ascat(const double d,
+                         itm_prop_t & s) {
+               if(d == 0.0) {
+                  s.ad = s.dl[0]-s.dl[1];
+                  s.rr = s.he[1]/s.he[0];
+                  if(s.ad < 0.0) {
+                     s.ad = -s.ad;
+                     s.rr = 1.0/s.rr;
+                  }
+                  s.etq = (5.67e-6*s.ens-2.32e-3)*s.ens+0.031;
+                  s.h0s = -15.0;
+                  return (0.0);
+               }
+               double h0;
+               if(s.h0s > 15.0) {
+                  h0 = s.h0s;
+               }
+               else {
+                  double th{s.the[0]+s.the[1]+d*s.gme};
+                  double r2{2.0*s.wn*th};
+                  const double r1{r2*s.he[0]};
+                  r2 *= s.he[1];
+                  if(r1 < 0.2 && r2 < 0.2) return (1001.0);
+                  double ss{(d-s.ad)/(d+s.ad)};
+                  double q{s.rr/ss};
+                  ss = std::max(0.1,ss);
+                  q  = std::min(std::max(0.1,q),10.0);
+                  const double z0{(d-s.ad)*(d+s.ad)*th*0.25/d};
+                  double t{std::min(1.7,z0/8.0e3)};
+                  t = t*t*t*t*t*t;
+                  const double et{(s.etq*std::exp(-t)+1.0)*z0/1.7556e3};
+                  const double ett{std::max(et,1.0)};
+                  h0  = (h0f(r1,ett)+h0f(r2,ett))*0.5;
+                  h0 += std::min(h0,(1.38-std::log(ett))*std::log(ss)*std::log(q)*0.49);
+                  h0  = fdim(h0,0.0);
+                  if(et < 1.0) {
+                     t  = (1.0+1.4142/r1)*(1.0+1.4142/r2);
+                     h0 = et*h0+(1.0-et)*4.343*std::log((t*t)*(r1+r2)/(r1+r2+2.8284));
+                  }
+                  if(h0 > 15.0 && s.h0s >= 0.0) h0 = s.h0s;
+               }
+               s.h0s = h0;
+               const double th{s.tha+d*s.gme};
+               return (ahd(th*d)+4.343*std::log(47.7*s.wn*th*th*th*th)-0.1*(s.ens-301.0)*std::exp(-th*d/40.0e3)+h0);
+        }
+
+        // Reference attenuation (lrprop) and the MODE__* of the path.
+        double itm_lrprop(const double d,
+                          itm_prop_t & s,
+                          int32_t & propmode) {
+               if(s.mdp != 0) {
+                  for(int32_t __j{0}; __j != 2; ++__j) s.dls[__j] = std::sqrt(2.0*s.he[__j]/s.gme);
+                  s.dlsa = s.dls[0]+s.dls[1];
+                  s.dla  = s.dl[0]+s.dl[1];
+                  s.tha  = std::max(s.the[0]+s.the[1],-s.dla*s.gme);
+                  if(s.wn < 0.838 || s.wn > 210.0) s.kwx = std::max(s.kwx,1);
+                  for(int32_t __j{0}; __j != 2; ++__j)
+                      if(s.hg[__j] < 1.0 || s.hg[__j] > 1000.0) s.kwx = std::max(s.kwx,1);
+                  for(int32_t __j{0}; __j != 2; ++__j)
+                      if(std::fabs(s.the[__j]) > 200.0e-3 || s.dl[__j] < 0.1*s.dls[__j] ||
+                         s.dl[__j] > 3.0*s.dls[__j]) s.kwx = std::max(s.kwx,3);
+                  if(s.ens < 250.0 || s.ens > 400.0 || s.gme < 75.0e-9 || s.gme > 250.0e-9 ||
+                     s.zgnd.real() <= std::fabs(s.zgnd.imag()) || s.wn < 0.419 || s.wn > 420.0) s.kwx = 4;
+                  for(int32_t __j{0}; __j != 2; ++__j)
+                      if(s.hg[__j] < 0.5 || s.hg[__j] > 3000.0) s.kwx = 4;
+                  s.dmin = std::fabs(s.he[0]-s.he[1])/200.0e-3;
+                  itm_adiff(0.0,s);
+                  s.xae = std::cbrt(1.0/(s.wn*s.gme*s.gme));
+                  const double d3{std::max(s.dlsa,1.3787*s.xae+s.dla)};
+                  const double d4{d3+2.7574*s.xae};
+                  const double a3{itm_adiff(d3,s)};
+                  const double a4{itm_adiff(d4,s)};
+                  s.emd = (a4-a3)/(d4-d3);
+                  s.aed = a3-s.emd*d3;
+               }
+               if(s.mdp >= 0) {
+                  s.mdp  = 0;
+                  s.dist = d;
+               }
+               if(s.dist > 0.0) {
+                  if(s.dist > 1000.0e3) s.kwx = std::max(s.kwx,1);
+                  if(s.dist < s.dmin)   s.kwx = std::max(s.kwx,3);
+                  if(s.dist < 1.0e3 || s.dist > 2000.0e3) s.kwx = 4;
+               }
+               double aref{0.0};
+               int32_t mode{MODE__LINE_OF_SIGHT};
+               if(s.dist < s.dlsa) {
+                  itm_alos(0.0,s);
+                  const double d2{s.dlsa};
+                  const double a2{s.aed+d2*s.emd};
+                  double d0{1.908*s.wn*s.he[0]*s.he[1]};
+                  double d1;
+                  if(s.aed >= 0.0) {
+                     d0 = std::min(d0,0.5*s.dla);
+                     d1 = d0+0.25*(s.dla-d0);
+                  }
+                  else {
+                     d1 = std::max(-s.aed/s.emd,0.25*s.dla);
+                  }
+                  const double a1{itm_alos(d1,s)};
+                  if(d0 < d1) {
+                     const double a0{itm_alos(d0,s)};
+                     const double q{std::log(d2/d0)};
+                     s.ak2 = std::max(0.0,((d2-d0)*(a1-a0)-(d1-d0)*(a2-a0))/((d2-d0)*std::log(d1/d0)-(d1-d0)*q));
+                     if(s.aed >= 0.0 || s.ak2 > 0.0) {
+                        s.ak1 = (a2-a0-s.ak2*q)/(d2-d0);
+                        if(s.ak1 < 0.0) {
+                           s.ak1 = 0.0;
+                           s.ak2 = fdim(a2,a0)/q;
+                           if(s.ak2 == 0.0) s.ak1 = s.emd;
+                        }
+                     }
+                     else {
+                        s.ak2 = 0.0;
+                        s.ak1 = (a2-a1)/(d2-d1);
+                        if(s.ak1 <= 0.0) s.ak1 = s.emd;
+                     }
+                  }
+                  else {
+                     s.ak1 = (a2-a1)/(d2-d1);
+                     s.ak2 = 0.0;
+                     if(s.ak1 <= 0.0) s.ak1 = s.emd;
+                  }
+                  s.ael = a2-s.ak1*d2-s.ak2*std::log(d2);
+                  if(s.dist > 0.0) aref = s.ael+s.ak1*s.dist+s.ak2*std::log(s.dist);
+               }
+               else {
+                  itm_ascat(0.0,s);
+                  const double d5{s.dla+200.0e3};
+                  const double d6{d5+200.0e3};
+                  const double a6{itm_ascat(d6,s)};
+                  const double a5{itm_ascat(d5,s)};
+                  if(a5 < 1000.0) {
+                     s.ems = (a6-a5)/200.0e3;
+                     s.dx  = std::max(s.dlsa,std::max(s.dla+0.3*s.xae*std::log(47.7*s.wn),
+                                                     (a5-s.aed-s.ems*d5)/(s.emd-s.ems)));
+                     s.aes = (s.emd-s.ems)*s.dx+s.aed;
+                  }
+                  else {
+                     s.ems = s.emd;
+                     s.aes = s.aed;
+                     s.dx  = 10.0e6;
+                  }
+                  if(s.dist > s.dx) {
+                     aref = s.aes+s.ems*s.dist;
+                     mode = MODE__TROPOSCATTER;
+                  }
+                  else {
+                     aref = s.aed+s.emd*s.dist;
+                     mode = MODE__DIFFRACTION;
+                  }
+               }
+               propmode = mode;
+               return (std::max(aref,0.0));
+        }
+
+} // anon
+
+namespace {
+
+        // Variability (avar) added to the reference attenuation aref.
+        double itm_avar(const itm_var_t & v,
+                        itm_prop_t & s,
+                        const double aref) {
+               constexpr double rt{7.8};
+               constexpr double rl{24.0};
+               s.kwx = std::max(s.kwx,v.kwx);
+               const double dexa{std::sqrt(18.0e6*s.he[0])+std::sqrt(18.0e6*s.he[1])+std::cbrt(575.7e12/s.wn)};
+               const double de{(s.dist < dexa) ? 130.0e3*s.dist/dexa : 130.0e3+s.dist-dexa};
+               const double vmd{curve(v.cv1,v.cv2,v.yv1,v.yv2,v.yv3,de)};
+               const double sgtm{curve(v.csm1,v.csm2,v.ysm1,v.ysm2,v.ysm3,de)*v.gm};
+               const double sgtp{curve(v.csp1,v.csp2,v.ysp1,v.ysp2,v.ysp3,de)*v.gp};
+               const double sgtd{sgtp*v.csd1};
+               const double tgtd{(sgtp-sgtd)*v.zd};
+               double sgl{0.0};
+               if(!v.w1) {
+                  const double q{(1.0-0.8*std::exp(-s.dist/50.0e3))*s.dh*s.wn};
+                  sgl = 10.0*q/(q+13.0);
+               }
+               double vs0{0.0};
+               if(!v.ws) {
+                  vs0 = 5.0+3.0*std::exp(-de/100.0e3);
+                  vs0 *= vs0;
+               }
+               const double zt{v.zt};
+               const double zl{v.zl};
+               const double zc{v.zc};
+               double sgt;
+               if(zt < 0.0)       sgt = sgtm;
+               else if(zt <= v.zd) sgt = sgtp;
+               else               sgt = sgtd+tgtd/zt;
+               const double vs{vs0+(sgt*zt)*(sgt*zt)/(rt+zc*zc)+(sgl*zl)*(sgl*zl)/(rl+zc*zc)};
+               double yr,sgc;
+               switch(v.kdv) {
+                   case 0:  yr = 0.0;                             sgc = std::sqrt(sgt*sgt+sgl*sgl+vs); break;
+                   case 1:  yr = sgt*zt;                          sgc = std::sqrt(sgl*sgl+vs);         break;
+                   case 2:  yr = std::sqrt(sgt*sgt+sgl*sgl)*zt;   sgc = std::sqrt(vs);                 break;
+                   default: yr = sgt*zt+sgl*zl;                   sgc = std::sqrt(vs);                 break;
+               }
+               double a{aref-vmd-yr-sgc*zc};
+               if(a < 0.0) a = a*(29.0-a)/(29.0-10.0*a);
+               return (a);
+        }
+
+        inline double itm_free_space_loss(const double f_mhz,
+                                          const double d) {
+               return (32.45+20.0*std::log10(f_mhz)+20.0*std::log10(d*1.0e-3));
+        }
+
+} // anon
+
+
+int32_t
+gms::math::itm_p2p_tls(const double h_tx,
+                       const double h_rx,
+                       const double * __restrict pfl,
+                       const ITM_Params & p,
+                       double * __restrict A_db,
+                       int32_t * __restrict propmode) {
+       itm_prop_t s{};
+       s.hg[0] = h_tx;
+       s.hg[1] = h_rx;
+       s.kwx   = 0;
+       // Average path height, the first and the last 10% of the profile excluded.
+       const int32_t np{static_cast<int32_t>(pfl[0])};
+       const int32_t p10{static_cast<int32_t>(0.1*np)};
+       double zsys{0.0};
+       for(int32_t __i{p10}; __i <= np-p10; ++__i) zsys += pfl[__i+2];
+       zsys /= static_cast<double>(np-2*p10+1);
+       itm_qlrps(s,p,zsys);
+       itm_qlrpfl(pfl,s);
+       int32_t mode;
+       const double aref{itm_lrprop(0.0,s,mode)};
+       itm_var_t v;
+       itm_var_init(v,p,s.wn);
+       *A_db     = itm_avar(v,s,aref)+itm_free_space_loss(p.f_mhz,s.dist);
+       *propmode = mode;
+       return (s.kwx);
+}
+
+
+int32_t
+gms::math::itm_area_tls(const double h_tx,
+                        const double h_rx,
+                        const int32_t tx_siting,
+                        const int32_t rx_siting,
+                        const double d_km,
+                        const double delta_h,
+                        const ITM_Params & p,
+                        double * __restrict A_db,
+                        int32_t * __restrict propmode) {
+       itm_prop_t s{};
+       s.hg[0] = h_tx;
+       s.hg[1] = h_rx;
+       s.dh    = delta_h;
+       s.kwx   = 0;
+       itm_qlrps(s,p,0.0);
+       const int32_t kst[2] = {tx_siting,rx_siting};
+       itm_qlra(kst,s);
+       int32_t mode;
+       const double aref{itm_lrprop(d_km*1.0e+3,s,mode)};
+       itm_var_t v;
+       itm_var_init(v,p,s.wn);
+       *A_db     = itm_avar(v,s,aref)+itm_free_space_loss(p.f_mhz,s.dist);
+       *propmode = mode;
+       return (s.kwx);
+}
+
+
+namespace {
+
+        /*
+              exp/log of 16 floats, Cephes expf/logf reduction and polynomials (~1 ulp).
+        */
+        __attribute__((always_inline))
+        inline __m512 exp_zmm16r4(const __m512 x) {
+               const __m512 xc{_mm512_min_ps(_mm512_max_ps(x,_mm512_set1_ps(-87.3f)),_mm512_set1_ps(88.3f))};
+               const __m512 fx{_mm512_roundscale_ps(_mm512_mul_ps(xc,_mm512_set1_ps(1.44269504088896341f)),
+                                                    _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC)};
+               __m512 r{_mm512_fnmadd_ps(fx,_mm512_set1_ps(0.693359375f),xc)};
+               r = _mm512_fnmadd_ps(fx,_mm512_set1_ps(-2.12194440e-4f),r);
+               const __m512 z{_mm512_mul_ps(r,r)};
+               __m512 y{_mm512_set1_ps(1.9875691500E-4f)};
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(1.3981999507E-3f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(8.3334519073E-3f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(4.1665795894E-2f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(1.6666665459E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(5.0000001201E-1f));
+               y = _mm512_fmadd_ps(y,z,_mm512_add_ps(r,_mm512_set1_ps(1.0f)));
+               return (_mm512_scalef_ps(y,fx));
+        }
+
+        __attribute__((always_inline))
+        inline __m512 log_zmm16r4(const __m512 x) {
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               __m512 m{_mm512_getmant_ps(x,_MM_MANT_NORM_p5_1,_MM_MANT_SIGN_zero)};
+               __m512 e{_mm512_add_ps(_mm512_getexp_ps(x),one)};
+               const __mmask16 lo{_mm512_cmp_ps_mask(m,_mm512_set1_ps(0.707106781186547524f),_CMP_LT_OQ)};
+               e = _mm512_mask_sub_ps(e,lo,e,one);
+               m = _mm512_mask_add_ps(m,lo,m,m);
+               const __m512 r{_mm512_sub_ps(m,one)};
+               const __m512 z{_mm512_mul_ps(r,r)};
+               __m512 y{_mm512_set1_ps(7.0376836292E-2f)};
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(-1.1514610310E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(1.1676998740E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(-1.2420140846E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(1.4249322787E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(-1.6668057665E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(2.0000714765E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(-2.4999993993E-1f));
+               y = _mm512_fmadd_ps(y,r,_mm512_set1_ps(3.3333331174E-1f));
+               y = _mm512_mul_ps(_mm512_mul_ps(y,r),z);
+               y = _mm512_fmadd_ps(e,_mm512_set1_ps(-2.12194440e-4f),y);
+               y = _mm512_fnmadd_ps(_mm512_set1_ps(0.5f),z,y);
+               return (_mm512_fmadd_ps(e,_mm512_set1_ps(0.693359375f),_mm512_add_ps(r,y)));
+        }
+
+        // x > 0
+        __attribute__((always_inline))
+        inline __m512 cbrt_zmm16r4(const __m512 x) {
+               return (exp_zmm16r4(_mm512_mul_ps(log_zmm16r4(x),_mm512_set1_ps(0.333333333333333333f))));
+        }
+
+        /*
+              sin/cos of 16 floats, |x| < 1.0e+4: Cody-Waite reduction by pi/2,
+              Cephes minimax polynomials on [-pi/4,pi/4].
+        */
+        __attribute__((always_inline))
+        inline void sincos_zmm16r4(const __m512 x,
+                                   __m512 & s,
+                                   __m512 & c) {
+               const __m512 q{_mm512_roundscale_ps(_mm512_mul_ps(x,_mm512_set1_ps(0.636619772367581343f)),
+                                                   _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC)};
+               __m512 r{_mm512_fnmadd_ps(q,_mm512_set1_ps(1.5703125f),x)};
+               r = _mm512_fnmadd_ps(q,_mm512_set1_ps(4.837512969970703125e-4f),r);
+               r = _mm512_fnmadd_ps(q,_mm512_set1_ps(7.54978995489188216e-8f),r);
+               const __m512 z{_mm512_mul_ps(r,r)};
+               __m512 ps{_mm512_set1_ps(-1.9515295891E-4f)};
+               ps = _mm512_fmadd_ps(ps,z,_mm512_set1_ps(8.3321608736E-3f));
+               ps = _mm512_fmadd_ps(ps,z,_mm512_set1_ps(-1.6666654611E-1f));
+               const __m512 sr{_mm512_fmadd_ps(_mm512_mul_ps(ps,z),r,r)};
+               __m512 pc{_mm512_set1_ps(2.443315711809948E-005f)};
+               pc = _mm512_fmadd_ps(pc,z,_mm512_set1_ps(-1.388731625493765E-003f));
+               pc = _mm512_fmadd_ps(pc,z,_mm512_set1_ps(4.166664568298827E-002f));
+               const __m512 cr{_mm512_fmadd_ps(_mm512_mul_ps(pc,z),z,
+                                               _mm512_fnmadd_ps(_mm512_set1_ps(0.5f),z,_mm512_set1_ps(1.0f)))};
+               const __m512i qi{_mm512_cvtps_epi32(q)};
+               const __mmask16 swp{_mm512_test_epi32_mask(qi,_mm512_set1_epi32(1))};
+               const __mmask16 sns{_mm512_test_epi32_mask(qi,_mm512_set1_epi32(2))};
+               const __mmask16 cns{_mm512_test_epi32_mask(_mm512_add_epi32(qi,_mm512_set1_epi32(1)),
+                                                          _mm512_set1_epi32(2))};
+               const __m512 s0{_mm512_mask_blend_ps(swp,sr,cr)};
+               const __m512 c0{_mm512_mask_blend_ps(swp,cr,sr)};
+               const __m512 zero{_mm512_setzero_ps()};
+               s = _mm512_mask_sub_ps(s0,sns,zero,s0);
+               c = _mm512_mask_sub_ps(c0,cns,zero,c0);
+        }
+
+        __attribute__((always_inline))
+        inline __m512 sel_zmm16r4(const __mmask16 m,
+                                  const __m512 a,
+                                  const __m512 b) { // m ? a : b
+               return (_mm512_mask_blend_ps(m,b,a));
+        }
+
+#define ITM_CMP(a,b,p) _mm512_cmp_ps_mask((a),(b),(p))
+
+        /*
+              State of 16 links (lanes), radio parameters are common.
+        */
+        struct itm_v16_t {
+               __m512  hg0,hg1,he0,he1,dl0,dl1,the0,the1;
+               __m512  dh,dist,gme,ens;
+               __m512  dlsa,dla,tha,xae,emd,aed;
+               __m512  wd1,xd1,afo,aht,xht;
+               __m512  ad,rr,etq,h0s;
+               __m512i kwx;
+               float   wn;
+               float   zgr;
+               float   zgi;
+               float   qk;
+               bool    p2p;
+        };
+
+        __attribute__((always_inline))
+        inline void kwx_max(itm_v16_t & s,
+                            const __mmask16 m,
+                            const int32_t level) {
+               s.kwx = _mm512_mask_max_epi32(s.kwx,m,s.kwx,_mm512_set1_epi32(level));
+        }
+
+        __attribute__((always_inline))
+        inline __m512 aknfe_zmm16r4(const __m512 v2) {
+               const __m512 a{_mm512_fmadd_ps(_mm512_set1_ps(9.11f),_mm512_sqrt_ps(v2),
+                                              _mm512_fnmadd_ps(_mm512_set1_ps(1.27f),v2,_mm512_set1_ps(6.02f)))};
+               const __m512 b{_mm512_fmadd_ps(_mm512_set1_ps(4.34294481903251828f),log_zmm16r4(v2),
+                                              _mm512_set1_ps(12.953f))};
+               return (sel_zmm16r4(ITM_CMP(v2,_mm512_set1_ps(5.76f),_CMP_LT_OQ),a,b));
+        }
+
+        __m512 fht_zmm16r4(const __m512 x,
+                           const __m512 pk) {
+               const __m512 lx{log_zmm16r4(x)};
+               const __m512 w{_mm512_sub_ps(_mm512_setzero_ps(),log_zmm16r4(pk))};
+               const __mmask16 m1 = ITM_CMP(pk,_mm512_set1_ps(1.0e-5f),_CMP_LT_OQ) |
+                                  ITM_CMP(_mm512_mul_ps(x,_mm512_mul_ps(w,_mm512_mul_ps(w,w))),
+                                          _mm512_set1_ps(5495.0f),_CMP_GT_OQ);
+               const __m512 l17{_mm512_fmsub_ps(_mm512_set1_ps(17.372f),lx,_mm512_set1_ps(117.0f))};
+               const __m512 fa{sel_zmm16r4(ITM_CMP(x,_mm512_set1_ps(1.0f),_CMP_GT_OQ),l17,_mm512_set1_ps(-117.0f))};
+               const __m512 fb{_mm512_fnmadd_ps(_mm512_set1_ps(8.686f),w,
+                               _mm512_fmsub_ps(_mm512_set1_ps(2.5e-5f),_mm512_div_ps(_mm512_mul_ps(x,x),pk),
+                                               _mm512_set1_ps(15.0f)))};
+               const __m512 f1{sel_zmm16r4(m1,fa,fb)};
+               __m512 f2{_mm512_fnmadd_ps(_mm512_set1_ps(4.343f),lx,_mm512_mul_ps(_mm512_set1_ps(0.05751f),x))};
+               const __m512 w2{_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.0134f),x),
+                                             exp_zmm16r4(_mm512_mul_ps(_mm512_set1_ps(-0.005f),x)))};
+               const __m512 f2b{_mm512_fmadd_ps(w2,l17,_mm512_fnmadd_ps(w2,f2,f2))};
+               f2 = sel_zmm16r4(ITM_CMP(x,_mm512_set1_ps(2000.0f),_CMP_LT_OQ),f2b,f2);
+               return (sel_zmm16r4(ITM_CMP(x,_mm512_set1_ps(200.0f),_CMP_LT_OQ),f1,f2));
+        }
+
+        __m512 h0f_zmm16r4(const __m512 r,
+                           const __m512 et) {
+               const __m512 ta{_mm512_setr_ps(25.0f,80.0f,177.0f,395.0f,705.0f,705.0f,705.0f,705.0f,
+                                              705.0f,705.0f,705.0f,705.0f,705.0f,705.0f,705.0f,705.0f)};
+               const __m512 tb{_mm512_setr_ps(24.0f,45.0f,68.0f,80.0f,105.0f,105.0f,105.0f,105.0f,
+                                              105.0f,105.0f,105.0f,105.0f,105.0f,105.0f,105.0f,105.0f)};
+               __m512 it{_mm512_roundscale_ps(et,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC)};
+               const __mmask16 edge = ITM_CMP(it,_mm512_set1_ps(0.0f),_CMP_LE_OQ) |
+                                    ITM_CMP(it,_mm512_set1_ps(5.0f),_CMP_GE_OQ);
+               const __m512 q{_mm512_maskz_sub_ps(static_cast<__mmask16>(~edge),et,it)};
+               it = _mm512_min_ps(_mm512_max_ps(it,_mm512_set1_ps(1.0f)),_mm512_set1_ps(5.0f));
+               const __m512i i0{_mm512_sub_epi32(_mm512_cvttps_epi32(it),_mm512_set1_epi32(1))};
+               const __m512i i1{_mm512_add_epi32(i0,_mm512_set1_epi32(1))};
+               const __m512 x{_mm512_div_ps(_mm512_set1_ps(1.0f),_mm512_mul_ps(r,r))};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               const __m512 c{_mm512_set1_ps(4.343f)};
+               __m512 h{_mm512_mul_ps(c,log_zmm16r4(_mm512_fmadd_ps(_mm512_fmadd_ps(_mm512_permutexvar_ps(i0,ta),x,
+                                                                                      _mm512_permutexvar_ps(i0,tb)),x,one)))};
+               const __m512 h1{_mm512_mul_ps(c,log_zmm16r4(_mm512_fmadd_ps(_mm512_fmadd_ps(_mm512_permutexvar_ps(i1,ta),x,
+                                                                                            _mm512_permutexvar_ps(i1,tb)),x,one)))};
+               const __mmask16 mq{ITM_CMP(q,_mm512_setzero_ps(),_CMP_NEQ_OQ)};
+               h = _mm512_mask_blend_ps(mq,h,_mm512_fmadd_ps(q,h1,_mm512_fnmadd_ps(q,h,h)));
+               return (h);
+        }
+
+        __attribute__((always_inline))
+        inline __m512 ahd_zmm16r4(const __m512 td) {
+               const __mmask16 m0{ITM_CMP(td,_mm512_set1_ps(10.0e3f),_CMP_LE_OQ)};
+               const __mmask16 m1{ITM_CMP(td,_mm512_set1_ps(70.0e3f),_CMP_LE_OQ)};
+               const __m512 a{sel_zmm16r4(m0,_mm512_set1_ps(133.4f),sel_zmm16r4(m1,_mm512_set1_ps(104.6f),_mm512_set1_ps(71.8f)))};
+               const __m512 b{sel_zmm16r4(m0,_mm512_set1_ps(0.332e-3f),sel_zmm16r4(m1,_mm512_set1_ps(0.212e-3f),_mm512_set1_ps(0.157e-3f)))};
+               const __m512 c{sel_zmm16r4(m0,_mm512_set1_ps(-4.343f),sel_zmm16r4(m1,_mm512_set1_ps(-1.086f),_mm512_set1_ps(2.171f)))};
+               return (_mm512_fmadd_ps(c,log_zmm16r4(td),_mm512_fmadd_ps(b,td,a)));
+        }
+
+        // 1-0.8*exp(-d/50 km), the path length correction of delta_h
+        __attribute__((always_inline))
+        inline __m512 dh_corr_zmm16r4(const __m512 d) {
+               return (_mm512_fnmadd_ps(_mm512_set1_ps(0.8f),exp_zmm16r4(_mm512_mul_ps(d,_mm512_set1_ps(-2.0e-5f))),
+                                        _mm512_set1_ps(1.0f)));
+        }
+
+        // 0.78*q*exp(-(q/16)^(1/4)), terrain roughness of delta_h_d = q
+        __attribute__((always_inline))
+        inline __m512 sigma_h_zmm16r4(const __m512 q) {
+               const __m512 t{_mm512_sqrt_ps(_mm512_sqrt_ps(_mm512_mul_ps(q,_mm512_set1_ps(0.0625f))))};
+               return (_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.78f),q),
+                                     exp_zmm16r4(_mm512_sub_ps(_mm512_setzero_ps(),t))));
+        }
+
+        void adiff_init_zmm16r4(itm_v16_t & s) {
+               __m512 q{_mm512_mul_ps(s.hg0,s.hg1)};
+               const __m512 tq{_mm512_fmsub_ps(s.he0,s.he1,q)};
+               if(s.p2p) q = _mm512_add_ps(q,_mm512_set1_ps(10.0f));
+               s.wd1 = _mm512_sqrt_ps(_mm512_add_ps(_mm512_set1_ps(1.0f),_mm512_div_ps(tq,q)));
+               s.xd1 = _mm512_add_ps(s.dla,_mm512_div_ps(s.tha,s.gme));
+               q = sigma_h_zmm16r4(_mm512_mul_ps(dh_corr_zmm16r4(s.dlsa),s.dh));
+               const __m512 t{_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(4.77e-4f*s.wn),_mm512_mul_ps(s.hg0,s.hg1)),q)};
+               s.afo = _mm512_min_ps(_mm512_set1_ps(15.0f),
+                                     _mm512_mul_ps(_mm512_set1_ps(2.171f),log_zmm16r4(_mm512_add_ps(_mm512_set1_ps(1.0f),t))));
+               s.aht = _mm512_set1_ps(20.0f);
+               s.xht = _mm512_setzero_ps();
+               const __m512 dl[2] = {s.dl0,s.dl1};
+               const __m512 he[2] = {s.he0,s.he1};
+               for(int32_t __j{0}; __j != 2; ++__j) {
+                   const __m512 a{_mm512_div_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f),_mm512_mul_ps(dl[__j],dl[__j])),he[__j])};
+                   const __m512 wa{cbrt_zmm16r4(_mm512_mul_ps(a,_mm512_set1_ps(s.wn)))};
+                   const __m512 pk{_mm512_div_ps(_mm512_set1_ps(s.qk),wa)};
+                   const __m512 x{_mm512_div_ps(_mm512_mul_ps(_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(1.607f),pk),
+                                                                            _mm512_mul_ps(_mm512_set1_ps(151.0f),wa)),dl[__j]),a)};
+                   s.xht = _mm512_add_ps(s.xht,x);
+                   s.aht = _mm512_add_ps(s.aht,fht_zmm16r4(x,pk));
+               }
+        }
+
+        __m512 adiff_zmm16r4(const __m512 d,
+                             const itm_v16_t & s) {
+               const __m512 th{_mm512_fmadd_ps(d,s.gme,s.tha)};
+               const __m512 ds{_mm512_sub_ps(d,s.dla)};
+               __m512 q{_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.0795775f*s.wn),ds),_mm512_mul_ps(th,th))};
+               const __m512 ak{_mm512_add_ps(aknfe_zmm16r4(_mm512_div_ps(_mm512_mul_ps(q,s.dl0),_mm512_add_ps(ds,s.dl0))),
+                                             aknfe_zmm16r4(_mm512_div_ps(_mm512_mul_ps(q,s.dl1),_mm512_add_ps(ds,s.dl1))))};
+               const __m512 a{_mm512_div_ps(ds,th)};
+               const __m512 wa{cbrt_zmm16r4(_mm512_mul_ps(a,_mm512_set1_ps(s.wn)))};
+               const __m512 pk{_mm512_div_ps(_mm512_set1_ps(s.qk),wa)};
+               q = _mm512_fmadd_ps(_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(1.607f),pk),_mm512_mul_ps(_mm512_set1_ps(151.0f),wa)),
+                                   th,s.xht);
+               const __m512 ar{_mm512_sub_ps(_mm512_fnmadd_ps(_mm512_set1_ps(4.343f),log_zmm16r4(q),
+                                                              _mm512_mul_ps(_mm512_set1_ps(0.05751f),q)),s.aht)};
+               q = _mm512_mul_ps(_mm512_add_ps(s.wd1,_mm512_div_ps(s.xd1,d)),
+                                 _mm512_min_ps(_mm512_mul_ps(_mm512_mul_ps(dh_corr_zmm16r4(d),s.dh),_mm512_set1_ps(s.wn)),
+                                               _mm512_set1_ps(6283.2f)));
+               const __m512 wd{_mm512_div_ps(_mm512_set1_ps(25.1f),_mm512_add_ps(_mm512_set1_ps(25.1f),_mm512_sqrt_ps(q)))};
+               return (_mm512_add_ps(_mm512_fmadd_ps(ar,wd,_mm512_fnmadd_ps(wd,ak,ak)),s.afo));
+        }
+
+        __m512 alos_zmm16r4(const __m512 d,
+                            const itm_v16_t & s,
+                            const __m512 wls) {
+               const __m512 sg{sigma_h_zmm16r4(_mm512_mul_ps(dh_corr_zmm16r4(d),s.dh))};
+               const __m512 hs{_mm512_add_ps(s.he0,s.he1)};
+               const __m512 sps{_mm512_div_ps(hs,_mm512_sqrt_ps(_mm512_fmadd_ps(d,d,_mm512_mul_ps(hs,hs))))};
+               // r = (sps-Z)/(sps+Z)*exp(-min(10,k*sigma_h*sps))
+               const __m512 zr{_mm512_set1_ps(s.zgr)};
+               const __m512 zi{_mm512_set1_ps(s.zgi)};
+               const __m512 sz{_mm512_add_ps(sps,zr)};
+               const __m512 den{_mm512_fmadd_ps(sz,sz,_mm512_mul_ps(zi,zi))};
+               const __m512 ex{_mm512_div_ps(exp_zmm16r4(_mm512_sub_ps(_mm512_setzero_ps(),
+                                                          _mm512_min_ps(_mm512_set1_ps(10.0f),
+                                                                        _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(s.wn),sg),sps)))),den)};
+               __m512 rre{_mm512_mul_ps(_mm512_sub_ps(_mm512_mul_ps(sps,sps),_mm512_set1_ps(s.zgr*s.zgr+s.zgi*s.zgi)),ex)};
+               __m512 rim{_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(-2.0f*s.zgi),sps),ex)};
+               const __m512 q{_mm512_fmadd_ps(rre,rre,_mm512_mul_ps(rim,rim))};
+               const __mmask16 msc = ITM_CMP(q,_mm512_set1_ps(0.25f),_CMP_LT_OQ) | ITM_CMP(q,sps,_CMP_LT_OQ);
+               const __m512 sc{_mm512_sqrt_ps(_mm512_div_ps(sps,q))};
+               rre = _mm512_mask_mul_ps(rre,msc,rre,sc);
+               rim = _mm512_mask_mul_ps(rim,msc,rim,sc);
+               const __m512 al{_mm512_fmadd_ps(s.emd,d,s.aed)};
+               __m512 t{_mm512_div_ps(_mm512_mul_ps(_mm512_set1_ps(2.0f*s.wn),_mm512_mul_ps(s.he0,s.he1)),d)};
+               const __mmask16 mt{ITM_CMP(t,_mm512_set1_ps(1.57f),_CMP_GT_OQ)};
+               t = _mm512_mask_sub_ps(t,mt,_mm512_set1_ps(3.14f),_mm512_div_ps(_mm512_set1_ps(2.4649f),t));
+               __m512 sn,cs;
+               sincos_zmm16r4(t,sn,cs);
+               const __m512 re{_mm512_add_ps(cs,rre)};
+               const __m512 im{_mm512_sub_ps(rim,sn)};
+               const __m512 l{_mm512_mul_ps(_mm512_set1_ps(-4.343f),log_zmm16r4(_mm512_fmadd_ps(re,re,_mm512_mul_ps(im,im))))};
+               return (_mm512_fmadd_ps(_mm512_sub_ps(l,al),wls,al));
+        }
+
+        void ascat_init_zmm16r4(itm_v16_t & s) {
+               s.ad = _mm512_sub_ps(s.dl0,s.dl1);
+               s.rr = _mm512_div_ps(s.he1,s.he0);
+               const __mmask16 neg{ITM_CMP(s.ad,_mm512_setzero_ps(),_CMP_LT_OQ)};
+               s.ad  = _mm512_abs_ps(s.ad);
+               s.rr  = _mm512_mask_div_ps(s.rr,neg,_mm512_set1_ps(1.0f),s.rr);
+               s.etq = _mm512_fmadd_ps(_mm512_fmsub_ps(_mm512_set1_ps(5.67e-6f),s.ens,_mm512_set1_ps(2.32e-3f)),s.ens,
+                                       _mm512_set1_ps(0.031f));
+               s.h0s = _mm512_set1_ps(-15.0f);
+        }
+
+        __m512 ascat_zmm16r4(const __m512 d,
+                             itm_v16_t & s) {
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               const __mmask16 skip{ITM_CMP(s.h0s,_mm512_set1_ps(15.0f),_CMP_GT_OQ)};
+               __m512 th{_mm512_fmadd_ps(d,s.gme,_mm512_add_ps(s.the0,s.the1))};
+               const __m512 r0{_mm512_mul_ps(_mm512_set1_ps(2.0f*s.wn),th)};
+               const __m512 r1{_mm512_mul_ps(r0,s.he0)};
+               const __m512 r2{_mm512_mul_ps(r0,s.he1)};
+               const __mmask16 early = static_cast<__mmask16>(~skip) &
+                                     ITM_CMP(r1,_mm512_set1_ps(0.2f),_CMP_LT_OQ) &
+                                     ITM_CMP(r2,_mm512_set1_ps(0.2f),_CMP_LT_OQ);
+               const __m512 dm{_mm512_sub_ps(d,s.ad)};
+               const __m512 dp{_mm512_add_ps(d,s.ad)};
+               __m512 ss{_mm512_div_ps(dm,dp)};
+               __m512 q{_mm512_div_ps(s.rr,ss)};
+               ss = _mm512_max_ps(ss,_mm512_set1_ps(0.1f));
+               q  = _mm512_min_ps(_mm512_max_ps(q,_mm512_set1_ps(0.1f)),_mm512_set1_ps(10.0f));
+               const __m512 z0{_mm512_div_ps(_mm512_mul_ps(_mm512_mul_ps(dm,dp),_mm512_mul_ps(th,_mm512_set1_ps(0.25f))),d)};
+               __m512 t{_mm512_min_ps(_mm512_set1_ps(1.7f),_mm512_mul_ps(z0,_mm512_set1_ps(1.25e-4f)))};
+               t = _mm512_mul_ps(t,t);
+               t = _mm512_mul_ps(t,_mm512_mul_ps(t,t));
+               const __m512 et{_mm512_div_ps(_mm512_mul_ps(_mm512_fmadd_ps(s.etq,exp_zmm16r4(_mm512_sub_ps(zero,t)),one),z0),
+                                             _mm512_set1_ps(1.7556e3f))};
+               const __m512 ett{_mm512_max_ps(et,one)};
+               __m512 h0{_mm512_mul_ps(_mm512_add_ps(h0f_zmm16r4(r1,ett),h0f_zmm16r4(r2,ett)),_mm512_set1_ps(0.5f))};
+               const __m512 lc{_mm512_mul_ps(_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(1.38f),log_zmm16r4(ett)),log_zmm16r4(ss)),
+                                             _mm512_mul_ps(log_zmm16r4(q),_mm512_set1_ps(0.49f)))};
+               h0 = _mm512_add_ps(h0,_mm512_min_ps(h0,lc));
+               h0 = _mm512_max_ps(h0,zero);
+               const __mmask16 met{ITM_CMP(et,one,_CMP_LT_OQ)};
+               if(met) {
+                  const __m512 tt{_mm512_mul_ps(_mm512_add_ps(one,_mm512_div_ps(_mm512_set1_ps(1.4142f),r1)),
+                                                _mm512_add_ps(one,_mm512_div_ps(_mm512_set1_ps(1.4142f),r2)))};
+                  const __m512 rs{_mm512_add_ps(r1,r2)};
+                  const __m512 l{_mm512_mul_ps(_mm512_set1_ps(4.343f),
+                                               log_zmm16r4(_mm512_div_ps(_mm512_mul_ps(_mm512_mul_ps(tt,tt),rs),
+                                                                         _mm512_add_ps(rs,_mm512_set1_ps(2.8284f)))))};
+                  h0 = _mm512_mask_blend_ps(met,h0,_mm512_fmadd_ps(et,h0,_mm512_fnmadd_ps(et,l,l)));
+               }
+               h0 = _mm512_mask_blend_ps(ITM_CMP(h0,_mm512_set1_ps(15.0f),_CMP_GT_OQ) & ITM_CMP(s.h0s,zero,_CMP_GE_OQ),h0,s.h0s);
+               h0 = _mm512_mask_blend_ps(skip,h0,s.h0s);
+               s.h0s = _mm512_mask_blend_ps(early,h0,s.h0s);
+               th = _mm512_fmadd_ps(d,s.gme,s.tha);
+               const __m512 td{_mm512_mul_ps(th,d)};
+               const __m512 th2{_mm512_mul_ps(th,th)};
+               __m512 a{_mm512_add_ps(ahd_zmm16r4(td),
+                                      _mm512_mul_ps(_mm512_set1_ps(4.343f),
+                                                    log_zmm16r4(_mm512_mul_ps(_mm512_set1_ps(47.7f*s.wn),_mm512_mul_ps(th2,th2)))))};
+               a = _mm512_fnmadd_ps(_mm512_mul_ps(_mm512_set1_ps(0.1f),_mm512_sub_ps(s.ens,_mm512_set1_ps(301.0f))),
+                                    exp_zmm16r4(_mm512_mul_ps(td,_mm512_set1_ps(-2.5e-5f))),a);
+               a = _mm512_add_ps(a,h0);
+               return (_mm512_mask_blend_ps(early,a,_mm512_set1_ps(1001.0f)));
+        }
+
+        // Reference attenuation of 16 links (lrprop), mode of propagation in propmode.
+        __m512 lrprop_zmm16r4(itm_v16_t & s,
+                              __m512i & propmode) {
+               const __m512 two{_mm512_set1_ps(2.0f)};
+               const __m512 dls0{_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,s.he0),s.gme))};
+               const __m512 dls1{_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,s.he1),s.gme))};
+               s.dlsa = _mm512_add_ps(dls0,dls1);
+               s.dla  = _mm512_add_ps(s.dl0,s.dl1);
+               s.tha  = _mm512_max_ps(_mm512_add_ps(s.the0,s.the1),_mm512_sub_ps(_mm512_setzero_ps(),_mm512_mul_ps(s.dla,s.gme)));
+               if(s.wn < 0.838f || s.wn > 210.0f) kwx_max(s,0xFFFF,1);
+               kwx_max(s,ITM_CMP(s.hg0,_mm512_set1_ps(1.0f),_CMP_LT_OQ) | ITM_CMP(s.hg0,_mm512_set1_ps(1000.0f),_CMP_GT_OQ) |
+                         ITM_CMP(s.hg1,_mm512_set1_ps(1.0f),_CMP_LT_OQ) | ITM_CMP(s.hg1,_mm512_set1_ps(1000.0f),_CMP_GT_OQ),1);
+               const __m512 c02{_mm512_set1_ps(200.0e-3f)};
+               const __m512 c01{_mm512_set1_ps(0.1f)};
+               const __m512 c3{_mm512_set1_ps(3.0f)};
+               kwx_max(s,ITM_CMP(_mm512_abs_ps(s.the0),c02,_CMP_GT_OQ) | ITM_CMP(s.dl0,_mm512_mul_ps(c01,dls0),_CMP_LT_OQ) |
+                         ITM_CMP(s.dl0,_mm512_mul_ps(c3,dls0),_CMP_GT_OQ) |
+                         ITM_CMP(_mm512_abs_ps(s.the1),c02,_CMP_GT_OQ) | ITM_CMP(s.dl1,_mm512_mul_ps(c01,dls1),_CMP_LT_OQ) |
+                         ITM_CMP(s.dl1,_mm512_mul_ps(c3,dls1),_CMP_GT_OQ),3);
+               kwx_max(s,ITM_CMP(s.ens,_mm512_set1_ps(250.0f),_CMP_LT_OQ) | ITM_CMP(s.ens,_mm512_set1_ps(400.0f),_CMP_GT_OQ) |
+                         ITM_CMP(s.gme,_mm512_set1_ps(75.0e-9f),_CMP_LT_OQ) | ITM_CMP(s.gme,_mm512_set1_ps(250.0e-9f),_CMP_GT_OQ) |
+                         ITM_CMP(s.hg0,_mm512_set1_ps(0.5f),_CMP_LT_OQ) | ITM_CMP(s.hg0,_mm512_set1_ps(3000.0f),_CMP_GT_OQ) |
+                         ITM_CMP(s.hg1,_mm512_set1_ps(0.5f),_CMP_LT_OQ) | ITM_CMP(s.hg1,_mm512_set1_ps(3000.0f),_CMP_GT_OQ),4);
+               if(s.zgr <= std::fabs(s.zgi) || s.wn < 0.419f || s.wn > 420.0f) kwx_max(s,0xFFFF,4);
+               const __m512 dmin{_mm512_div_ps(_mm512_abs_ps(_mm512_sub_ps(s.he0,s.he1)),c02)};
+               adiff_init_zmm16r4(s);
+               s.xae = cbrt_zmm16r4(_mm512_div_ps(_mm512_set1_ps(1.0f),_mm512_mul_ps(_mm512_set1_ps(s.wn),_mm512_mul_ps(s.gme,s.gme))));
+               const __m512 d3{_mm512_max_ps(s.dlsa,_mm512_fmadd_ps(_mm512_set1_ps(1.3787f),s.xae,s.dla))};
+               const __m512 d4{_mm512_fmadd_ps(_mm512_set1_ps(2.7574f),s.xae,d3)};
+               const __m512 a3{adiff_zmm16r4(d3,s)};
+               const __m512 a4{adiff_zmm16r4(d4,s)};
+               s.emd = _mm512_div_ps(_mm512_sub_ps(a4,a3),_mm512_sub_ps(d4,d3));
+               s.aed = _mm512_fnmadd_ps(s.emd,d3,a3);
+               kwx_max(s,ITM_CMP(s.dist,_mm512_set1_ps(1000.0e3f),_CMP_GT_OQ),1);
+               kwx_max(s,ITM_CMP(s.dist,dmin,_CMP_LT_OQ),3);
+               kwx_max(s,ITM_CMP(s.dist,_mm512_set1_ps(1.0e3f),_CMP_LT_OQ) | ITM_CMP(s.dist,_mm512_set1_ps(2000.0e3f),_CMP_GT_OQ),4);
+               const __mmask16 mlos{ITM_CMP(s.dist,s.dlsa,_CMP_LT_OQ)};
+               __m512 aref{_mm512_setzero_ps()};
+               propmode = _mm512_set1_epi32(MODE__LINE_OF_SIGHT);
+               if(mlos) {
+                  const __m512 wls{_mm512_div_ps(_mm512_set1_ps(0.021f),
+                                                 _mm512_fmadd_ps(_mm512_set1_ps(s.wn),
+                                                                 _mm512_div_ps(s.dh,_mm512_max_ps(_mm512_set1_ps(10.0e3f),s.dlsa)),
+                                                                 _mm512_set1_ps(0.021f)))};
+                  const __m512 d2{s.dlsa};
+                  const __m512 a2{_mm512_fmadd_ps(d2,s.emd,s.aed)};
+                  __m512 d0{_mm512_mul_ps(_mm512_set1_ps(1.908f*s.wn),_mm512_mul_ps(s.he0,s.he1))};
+                  const __mmask16 mpos{ITM_CMP(s.aed,_mm512_setzero_ps(),_CMP_GE_OQ)};
+                  d0 = _mm512_mask_min_ps(d0,mpos,d0,_mm512_mul_ps(_mm512_set1_ps(0.5f),s.dla));
+                  const __m512 d1{sel_zmm16r4(mpos,_mm512_fmadd_ps(_mm512_set1_ps(0.25f),_mm512_sub_ps(s.dla,d0),d0),
+                                              _mm512_max_ps(_mm512_div_ps(_mm512_sub_ps(_mm512_setzero_ps(),s.aed),s.emd),
+                                                            _mm512_mul_ps(_mm512_set1_ps(0.25f),s.dla)))};
+                  const __m512 a1{alos_zmm16r4(d1,s,wls)};
+                  const __m512 a0{alos_zmm16r4(d0,s,wls)};
+                  const __mmask16 m01{ITM_CMP(d0,d1,_CMP_LT_OQ)};
+                  const __m512 q{log_zmm16r4(_mm512_div_ps(d2,d0))};
+                  const __m512 d20{_mm512_sub_ps(d2,d0)};
+                  const __m512 d10{_mm512_sub_ps(d1,d0)};
+                  __m512 ak2{_mm512_max_ps(_mm512_setzero_ps(),
+                                           _mm512_div_ps(_mm512_fmsub_ps(d20,_mm512_sub_ps(a1,a0),_mm512_mul_ps(d10,_mm512_sub_ps(a2,a0))),
+                                                         _mm512_fmsub_ps(d20,log_zmm16r4(_mm512_div_ps(d1,d0)),_mm512_mul_ps(d10,q))))};
+                  const __mmask16 wq = mpos | ITM_CMP(ak2,_mm512_setzero_ps(),_CMP_GT_OQ);
+                  __m512 ak1{_mm512_div_ps(_mm512_fnmadd_ps(ak2,q,_mm512_sub_ps(a2,a0)),d20)};
+                  const __mmask16 neg{ITM_CMP(ak1,_mm512_setzero_ps(),_CMP_LT_OQ)};
+                  const __m512 ak2n{_mm512_div_ps(_mm512_max_ps(_mm512_sub_ps(a2,a0),_mm512_setzero_ps()),q)};
+                  ak2 = _mm512_mask_blend_ps(neg,ak2,ak2n);
+                  ak1 = _mm512_mask_blend_ps(neg,ak1,sel_zmm16r4(ITM_CMP(ak2n,_mm512_setzero_ps(),_CMP_EQ_OQ),s.emd,_mm512_setzero_ps()));
+                  __m512 ak1s{_mm512_div_ps(_mm512_sub_ps(a2,a1),_mm512_sub_ps(d2,d1))};
+                  ak1s = _mm512_mask_blend_ps(ITM_CMP(ak1s,_mm512_setzero_ps(),_CMP_LE_OQ),ak1s,s.emd);
+                  const __mmask16 simple = static_cast<__mmask16>(~(m01 & wq));
+                  ak1 = _mm512_mask_blend_ps(simple,ak1,ak1s);
+                  ak2 = _mm512_mask_blend_ps(simple,ak2,_mm512_setzero_ps());
+                  const __m512 ael{_mm512_fnmadd_ps(ak2,log_zmm16r4(d2),_mm512_fnmadd_ps(ak1,d2,a2))};
+                  const __m512 al{_mm512_fmadd_ps(ak2,log_zmm16r4(s.dist),_mm512_fmadd_ps(ak1,s.dist,ael))};
+                  aref = _mm512_mask_blend_ps(mlos,aref,al);
+               }
+               const __mmask16 msc{static_cast<__mmask16>(~mlos)};
+               if(msc) {
+                  ascat_init_zmm16r4(s);
+                  const __m512 d5{_mm512_add_ps(s.dla,_mm512_set1_ps(200.0e3f))};
+                  const __m512 d6{_mm512_add_ps(d5,_mm512_set1_ps(200.0e3f))};
+                  const __m512 a6{ascat_zmm16r4(d6,s)};
+                  const __m512 a5{ascat_zmm16r4(d5,s)};
+                  const __mmask16 ok{ITM_CMP(a5,_mm512_set1_ps(1000.0f),_CMP_LT_OQ)};
+                  __m512 ems{_mm512_mul_ps(_mm512_sub_ps(a6,a5),_mm512_set1_ps(5.0e-6f))};
+                  __m512 dx{_mm512_max_ps(s.dlsa,
+                                          _mm512_max_ps(_mm512_fmadd_ps(_mm512_set1_ps(0.3f*std::log(47.7f*s.wn)),s.xae,s.dla),
+                                                        _mm512_div_ps(_mm512_fnmadd_ps(ems,d5,_mm512_sub_ps(a5,s.aed)),
+                                                                      _mm512_sub_ps(s.emd,ems))))};
+                  __m512 aes{_mm512_fmadd_ps(_mm512_sub_ps(s.emd,ems),dx,s.aed)};
+                  ems = _mm512_mask_blend_ps(ok,s.emd,ems);
+                  aes = _mm512_mask_blend_ps(ok,s.aed,aes);
+                  dx  = _mm512_mask_blend_ps(ok,_mm512_set1_ps(10.0e6f),dx);
+                  const __mmask16 tro{ITM_CMP(s.dist,dx,_CMP_GT_OQ)};
+                  const __m512 as{sel_zmm16r4(tro,_mm512_fmadd_ps(ems,s.dist,aes),_mm512_fmadd_ps(s.emd,s.dist,s.aed))};
+                  aref = _mm512_mask_blend_ps(msc,aref,as);
+                  propmode = _mm512_mask_mov_epi32(propmode,msc & static_cast<__mmask16>(~tro),_mm512_set1_epi32(MODE__DIFFRACTION));
+                  propmode = _mm512_mask_mov_epi32(propmode,msc & tro,_mm512_set1_epi32(MODE__TROPOSCATTER));
+               }
+               return (_mm512_max_ps(aref,_mm512_setzero_ps()));
+        }
+
+        __attribute__((always_inline))
+        inline __m512 curve_zmm16r4(const double c1,
+                                    const double c2,
+                                    const double x1,
+                                    const double x2,
+                                    const double x3,
+                                    const __m512 de) {
+               __m512 t1{_mm512_mul_ps(_mm512_sub_ps(de,_mm512_set1_ps(static_cast<float>(x2))),_mm512_set1_ps(static_cast<float>(1.0/x3)))};
+               __m512 t2{_mm512_mul_ps(de,_mm512_set1_ps(static_cast<float>(1.0/x1)))};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               t1 = _mm512_fmadd_ps(t1,t1,one);
+               t2 = _mm512_mul_ps(t2,t2);
+               return (_mm512_div_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_set1_ps(static_cast<float>(c1)),
+                                                                 _mm512_div_ps(_mm512_set1_ps(static_cast<float>(c2)),t1)),t2),
+                                     _mm512_add_ps(one,t2)));
+        }
+
+        // Variability of 16 links (avar).
+        __m512 avar_zmm16r4(const itm_var_t & v,
+                            itm_v16_t & s,
+                            const __m512 aref) {
+               kwx_max(s,0xFFFF,v.kwx);
+               const __m512 c18{_mm512_set1_ps(18.0e6f)};
+               const __m512 dexa{_mm512_add_ps(_mm512_add_ps(_mm512_sqrt_ps(_mm512_mul_ps(c18,s.he0)),
+                                                             _mm512_sqrt_ps(_mm512_mul_ps(c18,s.he1))),
+                                               _mm512_set1_ps(static_cast<float>(std::cbrt(575.7e12/s.wn))))};
+               const __m512 c130{_mm512_set1_ps(130.0e3f)};
+               const __m512 de{sel_zmm16r4(ITM_CMP(s.dist,dexa,_CMP_LT_OQ),_mm512_div_ps(_mm512_mul_ps(c130,s.dist),dexa),
+                                           _mm512_add_ps(c130,_mm512_sub_ps(s.dist,dexa)))};
+               const __m512 vmd{curve_zmm16r4(v.cv1,v.cv2,v.yv1,v.yv2,v.yv3,de)};
+               const __m512 sgtm{_mm512_mul_ps(curve_zmm16r4(v.csm1,v.csm2,v.ysm1,v.ysm2,v.ysm3,de),_mm512_set1_ps(static_cast<float>(v.gm)))};
+               const __m512 sgtp{_mm512_mul_ps(curve_zmm16r4(v.csp1,v.csp2,v.ysp1,v.ysp2,v.ysp3,de),_mm512_set1_ps(static_cast<float>(v.gp)))};
+               const __m512 sgtd{_mm512_mul_ps(sgtp,_mm512_set1_ps(static_cast<float>(v.csd1)))};
+               const __m512 tgtd{_mm512_mul_ps(_mm512_sub_ps(sgtp,sgtd),_mm512_set1_ps(static_cast<float>(v.zd)))};
+               __m512 sgl{_mm512_setzero_ps()};
+               if(!v.w1) {
+                  const __m512 q{_mm512_mul_ps(_mm512_mul_ps(dh_corr_zmm16r4(s.dist),s.dh),_mm512_set1_ps(s.wn))};
+                  sgl = _mm512_div_ps(_mm512_mul_ps(_mm512_set1_ps(10.0f),q),_mm512_add_ps(q,_mm512_set1_ps(13.0f)));
+               }
+               __m512 vs0{_mm512_setzero_ps()};
+               if(!v.ws) {
+                  vs0 = _mm512_fmadd_ps(_mm512_set1_ps(3.0f),exp_zmm16r4(_mm512_mul_ps(de,_mm512_set1_ps(-1.0e-5f))),_mm512_set1_ps(5.0f));
+                  vs0 = _mm512_mul_ps(vs0,vs0);
+               }
+               const float zt{static_cast<float>(v.zt)};
+               const float zl{static_cast<float>(v.zl)};
+               const float zc{static_cast<float>(v.zc)};
+               __m512 sgt;
+               if(zt < 0.0f)                           sgt = sgtm;
+               else if(zt <= static_cast<float>(v.zd)) sgt = sgtp;
+               else                                    sgt = _mm512_fmadd_ps(tgtd,_mm512_set1_ps(1.0f/zt),sgtd);
+               const __m512 st{_mm512_mul_ps(sgt,_mm512_set1_ps(zt))};
+               const __m512 sl{_mm512_mul_ps(sgl,_mm512_set1_ps(zl))};
+               const __m512 vs{_mm512_fmadd_ps(_mm512_mul_ps(sl,sl),_mm512_set1_ps(1.0f/(24.0f+zc*zc)),
+                                               _mm512_fmadd_ps(_mm512_mul_ps(st,st),_mm512_set1_ps(1.0f/(7.8f+zc*zc)),vs0))};
+               const __m512 sgt2{_mm512_mul_ps(sgt,sgt)};
+               const __m512 sgl2{_mm512_mul_ps(sgl,sgl)};
+               __m512 yr,sgc;
+               switch(v.kdv) {
+                   case 0:  yr  = _mm512_setzero_ps();
+                            sgc = _mm512_sqrt_ps(_mm512_add_ps(_mm512_add_ps(sgt2,sgl2),vs)); break;
+                   case 1:  yr  = st;
+                            sgc = _mm512_sqrt_ps(_mm512_add_ps(sgl2,vs)); break;
+                   case 2:  yr  = _mm512_mul_ps(_mm512_sqrt_ps(_mm512_add_ps(sgt2,sgl2)),_mm512_set1_ps(zt));
+                            sgc = _mm512_sqrt_ps(vs); break;
+                   default: yr  = _mm512_add_ps(st,sl);
+                            sgc = _mm512_sqrt_ps(vs); break;
+               }
+               __m512 a{_mm512_fnmadd_ps(sgc,_mm512_set1_ps(zc),_mm512_sub_ps(_mm512_sub_ps(aref,vmd),yr))};
+               const __mmask16 neg{ITM_CMP(a,_mm512_setzero_ps(),_CMP_LT_OQ)};
+               if(neg) {
+                  const __m512 an{_mm512_div_ps(_mm512_mul_ps(a,_mm512_sub_ps(_mm512_set1_ps(29.0f),a)),
+                                                _mm512_fnmadd_ps(_mm512_set1_ps(10.0f),a,_mm512_set1_ps(29.0f)))};
+                  a = _mm512_mask_blend_ps(neg,a,an);
+               }
+               return (a);
+        }
+
+        void qlrps_zmm16r4(itm_v16_t & s,
+                           const gms::math::ITM_Params & p,
+                           const __m512 zsys) {
+               const std::complex<double> zg{itm_zgnd(p)};
+               s.wn  = static_cast<float>(p.f_mhz/47.7);
+               s.zgr = static_cast<float>(zg.real());
+               s.zgi = static_cast<float>(zg.imag());
+               s.qk  = static_cast<float>(1.0/std::abs(zg));
+               s.ens = _mm512_mul_ps(_mm512_set1_ps(static_cast<float>(p.N_0)),
+                                     exp_zmm16r4(_mm512_mul_ps(zsys,_mm512_set1_ps(-1.0f/9460.0f))));
+               s.gme = _mm512_mul_ps(_mm512_set1_ps(157.0e-9f),
+                                     _mm512_fnmadd_ps(_mm512_set1_ps(0.04665f),
+                                                      exp_zmm16r4(_mm512_mul_ps(s.ens,_mm512_set1_ps(1.0f/179.3f))),
+                                                      _mm512_set1_ps(1.0f)));
+               s.kwx = _mm512_setzero_si512();
+        }
+
+        // Horizons of 16 profiles (pfl16[16*i+k], i = 0..np).
+        void hzns_zmm16r4(itm_v16_t & s,
+                          const int32_t np,
+                          const __m512 xi,
+                          const float * __restrict pfl16) {
+               const __m512 za{_mm512_add_ps(_mm512_load_ps(&pfl16[0]),s.hg0)};
+               const __m512 zb{_mm512_add_ps(_mm512_load_ps(&pfl16[16*np]),s.hg1)};
+               const __m512 qc{_mm512_mul_ps(_mm512_set1_ps(0.5f),s.gme)};
+               const __m512 q{_mm512_mul_ps(qc,s.dist)};
+               const __m512 t{_mm512_div_ps(_mm512_sub_ps(zb,za),s.dist)};
+               s.the0 = _mm512_sub_ps(t,q);
+               s.the1 = _mm512_sub_ps(_mm512_sub_ps(_mm512_setzero_ps(),t),q);
+               s.dl0  = s.dist;
+               s.dl1  = s.dist;
+               for(int32_t __i{1}; __i < np; ++__i) {
+                   const __m512 sa{_mm512_mul_ps(_mm512_set1_ps(static_cast<float>(__i)),xi)};
+                   const __m512 sb{_mm512_sub_ps(s.dist,sa)};
+                   const __m512 z{_mm512_load_ps(&pfl16[16*__i])};
+                   const __m512 ta{_mm512_fnmadd_ps(qc,sa,_mm512_div_ps(_mm512_sub_ps(z,za),sa))};
+                   const __m512 tb{_mm512_fnmadd_ps(qc,sb,_mm512_div_ps(_mm512_sub_ps(z,zb),sb))};
+                   const __mmask16 ma{ITM_CMP(ta,s.the0,_CMP_GT_OQ)};
+                   const __mmask16 mb{ITM_CMP(tb,s.the1,_CMP_GT_OQ)};
+                   s.the0 = _mm512_mask_mov_ps(s.the0,ma,ta);
+                   s.dl0  = _mm512_mask_mov_ps(s.dl0,ma,sa);
+                   s.the1 = _mm512_mask_mov_ps(s.the1,mb,tb);
+                   s.dl1  = _mm512_mask_mov_ps(s.dl1,mb,sb);
+               }
+        }
+
+        /*
+              Least squares line (zlsq1) through z16[16*j+k], j = 0..xn, between
+              the sample positions u1 and u2 (in units of the spacing).
+        */
+        void zlsq1_zmm16r4(const float * __restrict z16,
+                           const __m512 xn,
+                           const __m512 u1,
+                           const __m512 u2,
+                           __m512 & z0,
+                           __m512 & zn) {
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               __m512 xa{_mm512_roundscale_ps(_mm512_max_ps(u1,zero),_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC)};
+               __m512 xb{_mm512_sub_ps(xn,_mm512_roundscale_ps(_mm512_max_ps(_mm512_sub_ps(xn,u2),zero),
+                                                               _MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC))};
+               const __mmask16 m{ITM_CMP(xb,xa,_CMP_LE_OQ)};
+               xa = _mm512_mask_mov_ps(xa,m,_mm512_max_ps(_mm512_sub_ps(xa,one),zero));
+               xb = _mm512_mask_mov_ps(xb,m,_mm512_sub_ps(xn,_mm512_max_ps(_mm512_sub_ps(_mm512_sub_ps(xn,xb),one),zero)));
+               const __m512i ja{_mm512_cvttps_epi32(xa)};
+               const __m512i jb{_mm512_cvttps_epi32(xb)};
+               const __m512 nn{_mm512_sub_ps(xb,xa)};
+               const __m512 x0{_mm512_fnmadd_ps(_mm512_set1_ps(0.5f),nn,_mm512_sub_ps(zero,xa))}; // x = j+x0
+               const int32_t jlo{_mm512_reduce_min_epi32(ja)};
+               const int32_t jhi{_mm512_reduce_max_epi32(jb)};
+               __m512 a{zero};
+               __m512 b{zero};
+               for(int32_t __j{jlo}; __j <= jhi; ++__j) {
+                   const __m512i jv{_mm512_set1_epi32(__j)};
+                   const __mmask16 in = _mm512_cmp_epi32_mask(jv,ja,_MM_CMPINT_NLT) & _mm512_cmp_epi32_mask(jv,jb,_MM_CMPINT_LE);
+                   const __mmask16 ends = _mm512_cmp_epi32_mask(jv,ja,_MM_CMPINT_EQ) | _mm512_cmp_epi32_mask(jv,jb,_MM_CMPINT_EQ);
+                   const __m512 w{_mm512_maskz_mov_ps(in,_mm512_mask_mov_ps(one,ends,_mm512_set1_ps(0.5f)))};
+                   const __m512 wz{_mm512_mul_ps(w,_mm512_load_ps(&z16[16*__j]))};
+                   a = _mm512_add_ps(a,wz);
+                   b = _mm512_fmadd_ps(wz,_mm512_add_ps(_mm512_set1_ps(static_cast<float>(__j)),x0),b);
+               }
+               a = _mm512_div_ps(a,nn);
+               b = _mm512_div_ps(_mm512_mul_ps(b,_mm512_set1_ps(12.0f)),_mm512_mul_ps(_mm512_fmadd_ps(nn,nn,_mm512_set1_ps(2.0f)),nn));
+               const __m512 mid{_mm512_fnmadd_ps(_mm512_set1_ps(0.5f),nn,xb)};
+               z0 = _mm512_fnmadd_ps(b,mid,a);
+               zn = _mm512_fmadd_ps(b,_mm512_sub_ps(xn,mid),a);
+        }
+
+        // delta_h of 16 profiles between x1 and x2 (dlthx), seg16 holds 16*itm_dlthx_nmax floats.
+        __m512 dlthx_zmm16r4(const int32_t np,
+                             const __m512 xi,
+                             const float * __restrict pfl16,
+                             const __m512 x1,
+                             const __m512 x2,
+                             float * __restrict seg16) {
+               const __m512 zero{_mm512_setzero_ps()};
+               __m512 xa{_mm512_div_ps(x1,xi)};
+               const __m512 xb{_mm512_div_ps(x2,xi)};
+               const __m512 span{_mm512_sub_ps(xb,xa)};
+               const __mmask16 valid{ITM_CMP(span,_mm512_set1_ps(2.0f),_CMP_GE_OQ)};
+               if(valid == 0) return (zero);
+               const __m512i ka{_mm512_min_epi32(_mm512_max_epi32(_mm512_cvttps_epi32(_mm512_mask_fmadd_ps(
+                                       _mm512_add_ps(span,_mm512_set1_ps(8.0f)),valid,_mm512_set1_ps(0.1f),zero)),
+                                       _mm512_set1_epi32(4)),_mm512_set1_epi32(25))};
+               const __m512i n{_mm512_sub_epi32(_mm512_mullo_epi32(ka,_mm512_set1_epi32(10)),_mm512_set1_epi32(5))};
+               const __m512i kb{_mm512_add_epi32(_mm512_sub_epi32(n,ka),_mm512_set1_epi32(1))};
+               const __m512 sn{_mm512_cvtepi32_ps(_mm512_sub_epi32(n,_mm512_set1_epi32(1)))};
+               const __m512 stp{_mm512_div_ps(span,sn)};
+               const __m512 k0{_mm512_roundscale_ps(_mm512_add_ps(xa,_mm512_set1_ps(1.0f)),_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC)};
+               __m512i k{_mm512_cvttps_epi32(k0)};
+               xa = _mm512_sub_ps(xa,k0);
+               const __m512i npv{_mm512_set1_epi32(np)};
+               const __m512i lane{_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)};
+               const int32_t nmax{_mm512_mask_reduce_max_epi32(valid,n)};
+               for(int32_t __j{0}; __j != nmax; ++__j) {
+                   const __mmask16 act = valid & _mm512_cmp_epi32_mask(_mm512_set1_epi32(__j),n,_MM_CMPINT_LT);
+                   // while(xa > 0 && k < np) { xa -= 1; ++k; }
+                   const __mmask16 adv = act & ITM_CMP(xa,zero,_CMP_GT_OQ) & _mm512_cmp_epi32_mask(k,npv,_MM_CMPINT_LT);
+                   const __m512i st{_mm512_min_epi32(_mm512_cvttps_epi32(_mm512_roundscale_ps(xa,_MM_FROUND_TO_POS_INF|_MM_FROUND_NO_EXC)),
+                                                     _mm512_sub_epi32(npv,k))};
+                   xa = _mm512_mask_sub_ps(xa,adv,xa,_mm512_cvtepi32_ps(st));
+                   k  = _mm512_mask_add_epi32(k,adv,k,st);
+                   const __m512i i1{_mm512_add_epi32(_mm512_slli_epi32(k,4),lane)};
+                   const __m512i i0{_mm512_sub_epi32(i1,_mm512_set1_epi32(16))};
+                   const __m512 z1{_mm512_mask_i32gather_ps(zero,act,i1,pfl16,4)};
+                   const __m512 z0{_mm512_mask_i32gather_ps(zero,act,i0,pfl16,4)};
+                   _mm512_store_ps(&seg16[16*__j],_mm512_fmadd_ps(_mm512_sub_ps(z1,z0),xa,z1));
+                   xa = _mm512_add_ps(xa,stp);
+               }
+               __m512 fa,fb;
+               zlsq1_zmm16r4(seg16,sn,zero,sn,fa,fb);
+               const __m512 slope{_mm512_div_ps(_mm512_sub_ps(fb,fa),sn)};
+               for(int32_t __j{0}; __j != nmax; ++__j) {
+                   const __m512 s{_mm512_load_ps(&seg16[16*__j])};
+                   _mm512_store_ps(&seg16[16*__j],_mm512_sub_ps(s,_mm512_fmadd_ps(_mm512_set1_ps(static_cast<float>(__j)),slope,fa)));
+               }
+               alignas(64) int32_t nv[16], kav[16], kbv[16];
+               alignas(64) float dhv[16];
+               _mm512_store_si512(nv,n);
+               _mm512_store_si512(kav,ka);
+               _mm512_store_si512(kbv,kb);
+               float tmp[itm_dlthx_nmax];
+               for(int32_t __l{0}; __l != 16; ++__l) {
+                   dhv[__l] = 0.0f;
+                   if(!((valid >> __l) & 1)) continue;
+                   for(int32_t __j{0}; __j != nv[__l]; ++__j) tmp[__j] = seg16[16*__j+__l];
+                   std::nth_element(tmp,tmp+(kav[__l]-1),tmp+nv[__l],std::greater<float>());
+                   const float q10{tmp[kav[__l]-1]};
+                   std::nth_element(tmp,tmp+(kbv[__l]-1),tmp+nv[__l],std::greater<float>());
+                   dhv[__l] = q10-tmp[kbv[__l]-1];
+               }
+               const __m512 dd{_mm512_load_ps(dhv)};
+               return (_mm512_div_ps(dd,dh_corr_zmm16r4(_mm512_sub_ps(x2,x1))));
+        }
+
+        // Effective heights, horizons and delta_h of 16 profiles (qlrpfl).
+        void qlrpfl_zmm16r4(itm_v16_t & s,
+                            const int32_t np,
+                            const __m512 xi,
+                            const float * __restrict pfl16) {
+               alignas(64) float seg16[16*itm_dlthx_nmax] = {}; // zeroed so every path defines what zlsq1 reads.
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 two{_mm512_set1_ps(2.0f)};
+               const __m512 npf{_mm512_set1_ps(static_cast<float>(np))};
+               s.dist = _mm512_mul_ps(npf,xi);
+               hzns_zmm16r4(s,np,xi,pfl16);
+               const __m512 c15{_mm512_set1_ps(15.0f)};
+               const __m512 c01{_mm512_set1_ps(0.1f)};
+               const __m512 xl0{_mm512_min_ps(_mm512_mul_ps(c15,s.hg0),_mm512_mul_ps(c01,s.dl0))};
+               const __m512 xl1{_mm512_sub_ps(s.dist,_mm512_min_ps(_mm512_mul_ps(c15,s.hg1),_mm512_mul_ps(c01,s.dl1)))};
+               s.dh = dlthx_zmm16r4(np,xi,pfl16,xl0,xl1,seg16);
+               const __mmask16 mlos{ITM_CMP(_mm512_add_ps(s.dl0,s.dl1),_mm512_mul_ps(_mm512_set1_ps(1.5f),s.dist),_CMP_GT_OQ)};
+               const __m512 c09{_mm512_set1_ps(0.9f)};
+               __m512 za,zb;
+               zlsq1_zmm16r4(pfl16,npf,_mm512_div_ps(xl0,xi),
+                             _mm512_div_ps(sel_zmm16r4(mlos,xl1,_mm512_mul_ps(c09,s.dl0)),xi),za,zb);
+               const __mmask16 mth{static_cast<__mmask16>(~mlos)};
+               if(mth) {
+                  __m512 q,zb2;
+                  zlsq1_zmm16r4(pfl16,npf,_mm512_div_ps(_mm512_fnmadd_ps(c09,s.dl1,s.dist),xi),_mm512_div_ps(xl1,xi),q,zb2);
+                  zb = _mm512_mask_mov_ps(zb,mth,zb2);
+               }
+               const __m512 z0{_mm512_load_ps(&pfl16[0])};
+               const __m512 z1{_mm512_load_ps(&pfl16[16*np])};
+               s.he0 = _mm512_add_ps(s.hg0,_mm512_max_ps(_mm512_sub_ps(z0,za),zero));
+               s.he1 = _mm512_add_ps(s.hg1,_mm512_max_ps(_mm512_sub_ps(z1,zb),zero));
+               if(mlos) {
+                  const __m512 c5{_mm512_set1_ps(5.0f)};
+                  const __m512 c007{_mm512_set1_ps(-0.07f)};
+                  __m512 he0{s.he0};
+                  __m512 he1{s.he1};
+                  __m512 dl0{_mm512_mul_ps(_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he0),s.gme)),
+                                           exp_zmm16r4(_mm512_mul_ps(c007,_mm512_sqrt_ps(_mm512_div_ps(s.dh,_mm512_max_ps(he0,c5))))))};
+                  __m512 dl1{_mm512_mul_ps(_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he1),s.gme)),
+                                           exp_zmm16r4(_mm512_mul_ps(c007,_mm512_sqrt_ps(_mm512_div_ps(s.dh,_mm512_max_ps(he1,c5))))))};
+                  const __m512 q{_mm512_add_ps(dl0,dl1)};
+                  const __mmask16 mq = mlos & ITM_CMP(q,s.dist,_CMP_LE_OQ);
+                  if(mq) {
+                     __m512 f{_mm512_div_ps(s.dist,q)};
+                     f = _mm512_mul_ps(f,f);
+                     he0 = _mm512_mask_mul_ps(he0,mq,he0,f);
+                     he1 = _mm512_mask_mul_ps(he1,mq,he1,f);
+                     dl0 = _mm512_mask_mov_ps(dl0,mq,_mm512_mul_ps(_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he0),s.gme)),
+                                              exp_zmm16r4(_mm512_mul_ps(c007,_mm512_sqrt_ps(_mm512_div_ps(s.dh,_mm512_max_ps(he0,c5)))))));
+                     dl1 = _mm512_mask_mov_ps(dl1,mq,_mm512_mul_ps(_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he1),s.gme)),
+                                              exp_zmm16r4(_mm512_mul_ps(c007,_mm512_sqrt_ps(_mm512_div_ps(s.dh,_mm512_max_ps(he1,c5)))))));
+                  }
+                  const __m512 c065{_mm512_mul_ps(_mm512_set1_ps(0.65f),s.dh)};
+                  const __m512 q0{_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he0),s.gme))};
+                  const __m512 q1{_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,he1),s.gme))};
+                  const __m512 t0{_mm512_div_ps(_mm512_fnmadd_ps(two,he0,_mm512_fmsub_ps(c065,_mm512_div_ps(q0,dl0),c065)),q0)};
+                  const __m512 t1{_mm512_div_ps(_mm512_fnmadd_ps(two,he1,_mm512_fmsub_ps(c065,_mm512_div_ps(q1,dl1),c065)),q1)};
+                  s.he0  = _mm512_mask_mov_ps(s.he0,mlos,he0);
+                  s.he1  = _mm512_mask_mov_ps(s.he1,mlos,he1);
+                  s.dl0  = _mm512_mask_mov_ps(s.dl0,mlos,dl0);
+                  s.dl1  = _mm512_mask_mov_ps(s.dl1,mlos,dl1);
+                  s.the0 = _mm512_mask_mov_ps(s.the0,mlos,t0);
+                  s.the1 = _mm512_mask_mov_ps(s.the1,mlos,t1);
+               }
+        }
+
+        // Effective heights and horizons of the area mode (qlra).
+        void qlra_zmm16r4(itm_v16_t & s,
+                          const int32_t * __restrict kst) {
+               __m512 * hg[2] = {&s.hg0,&s.hg1};
+               __m512 * he[2] = {&s.he0,&s.he1};
+               __m512 * dl[2] = {&s.dl0,&s.dl1};
+               __m512 * th[2] = {&s.the0,&s.the1};
+               const __m512 two{_mm512_set1_ps(2.0f)};
+               for(int32_t __j{0}; __j != 2; ++__j) {
+                   const __m512 h{*hg[__j]};
+                   if(kst[__j] <= SITING_CRITERIA__RANDOM) {
+                      *he[__j] = h;
+                   }
+                   else {
+                      __m512 b{_mm512_set1_ps((kst[__j] != SITING_CRITERIA__CAREFUL) ? 9.0f : 4.0f)};
+                      const __mmask16 lo{ITM_CMP(h,_mm512_set1_ps(5.0f),_CMP_LT_OQ)};
+                      if(lo) {
+                         __m512 sn,cs;
+                         sincos_zmm16r4(_mm512_mul_ps(_mm512_set1_ps(0.3141593f),h),sn,cs);
+                         b = _mm512_mask_mul_ps(b,lo,b,sn);
+                      }
+                      const __m512 e{exp_zmm16r4(_mm512_sub_ps(_mm512_setzero_ps(),
+                                                 _mm512_min_ps(_mm512_set1_ps(20.0f),
+                                                               _mm512_div_ps(_mm512_mul_ps(two,h),_mm512_max_ps(_mm512_set1_ps(1.0e-3f),s.dh)))))};
+                      *he[__j] = _mm512_fmadd_ps(_mm512_add_ps(_mm512_set1_ps(1.0f),b),e,h);
+                   }
+                   const __m512 q{_mm512_sqrt_ps(_mm512_div_ps(_mm512_mul_ps(two,*he[__j]),s.gme))};
+                   *dl[__j] = _mm512_mul_ps(q,exp_zmm16r4(_mm512_mul_ps(_mm512_set1_ps(-0.07f),
+                                               _mm512_sqrt_ps(_mm512_div_ps(s.dh,_mm512_max_ps(*he[__j],_mm512_set1_ps(5.0f)))))));
+                   const __m512 c065{_mm512_mul_ps(_mm512_set1_ps(0.65f),s.dh)};
+                   *th[__j] = _mm512_div_ps(_mm512_fnmadd_ps(two,*he[__j],_mm512_fmsub_ps(c065,_mm512_div_ps(q,*dl[__j]),c065)),q);
+               }
+        }
+
+        // 32.45+20*log10(f)+20*log10(d/1000)
+        __attribute__((always_inline))
+        inline __m512 free_space_loss_zmm16r4(const double f_mhz,
+                                              const __m512 d) {
+               return (_mm512_fmadd_ps(_mm512_set1_ps(8.68588963806503655f),log_zmm16r4(d),
+                                       _mm512_set1_ps(static_cast<float>(32.45+20.0*std::log10(f_mhz)-60.0))));
+        }
+
+} // anon
+
+
+__m512
+gms::math::itm_p2p_zmm16r4(const __m512 h_tx,
+                           const __m512 h_rx,
+                           const int32_t np,
+                           const __m512 xi,
+                           const float * __restrict pfl16,
+                           const ITM_Params & p,
+                           __m512i & propmode,
+                           __m512i & kwx) {
+       itm_v16_t s;
+       s.hg0 = h_tx;
+       s.hg1 = h_rx;
+       s.p2p = true;
+       const int32_t p10{static_cast<int32_t>(0.1*np)};
+       __m512 zsys{_mm512_setzero_ps()};
+       for(int32_t __i{p10}; __i <= np-p10; ++__i) zsys = _mm512_add_ps(zsys,_mm512_load_ps(&pfl16[16*__i]));
+       zsys = _mm512_mul_ps(zsys,_mm512_set1_ps(1.0f/static_cast<float>(np-2*p10+1)));
+       qlrps_zmm16r4(s,p,zsys);
+       qlrpfl_zmm16r4(s,np,xi,pfl16);
+       const __m512 aref{lrprop_zmm16r4(s,propmode)};
+       itm_var_t v;
+       itm_var_init(v,p,static_cast<double>(p.f_mhz/47.7));
+       const __m512 A{_mm512_add_ps(avar_zmm16r4(v,s,aref),free_space_loss_zmm16r4(p.f_mhz,s.dist))};
+       kwx = s.kwx;
+       return (A);
+}
+
+
+__m512
+gms::math::itm_area_zmm16r4(const __m512 h_tx,
+                            const __m512 h_rx,
+                            const int32_t tx_siting,
+                            const int32_t rx_siting,
+                            const __m512 d_km,
+                            const __m512 delta_h,
+                            const ITM_Params & p,
+                            __m512i & propmode,
+                            __m512i & kwx) {
+       itm_v16_t s;
+       s.hg0 = h_tx;
+       s.hg1 = h_rx;
+       s.dh  = delta_h;
+       s.p2p = false;
+       qlrps_zmm16r4(s,p,_mm512_setzero_ps());
+       const int32_t kst[2] = {tx_siting,rx_siting};
+       qlra_zmm16r4(s,kst);
+       s.dist = _mm512_mul_ps(d_km,_mm512_set1_ps(1.0e+3f));
+       const __m512 aref{lrprop_zmm16r4(s,propmode)};
+       itm_var_t v;
+       itm_var_init(v,p,static_cast<double>(p.f_mhz/47.7));
+       const __m512 A{_mm512_add_ps(avar_zmm16r4(v,s,aref),free_space_loss_zmm16r4(p.f_mhz,s.dist))};
+       kwx = s.kwx;
+       return (A);
+}
+
+
+int32_t
+gms::math::itm_elev_grid_mmap(const char * __restrict fname,
+                              const int32_t nx,
+                              const int32_t ny,
+                              const double x0,
+                              const double y0,
+                              const double dx,
+                              const double dy,
+                              ITM_ElevGrid & g) {
+       g = ITM_ElevGrid{};
+       const int fd{open(fname,O_RDONLY)};
+       if(fd < 0) return (1);
+       struct stat st;
+       if(fstat(fd,&st) != 0) {
+          close(fd);
+          return (1);
+       }
+       const std::size_t nbytes{static_cast<std::size_t>(nx)*static_cast<std::size_t>(ny)*sizeof(float)};
+       if(static_cast<std::size_t>(st.st_size) < nbytes) {
+          close(fd);
+          return (2);
+       }
+       void * const m{mmap(nullptr,nbytes,PROT_READ,MAP_PRIVATE,fd,0)};
+       close(fd); // the mapping keeps the file referenced
+       if(m == MAP_FAILED) return (3);
+       madvise(m,nbytes,MADV_WILLNEED);
+       g.z         = reinterpret_cast<const float*>(m);
+       g.nx        = nx;
+       g.ny        = ny;
+       g.x0        = x0;
+       g.y0        = y0;
+       g.dx        = dx;
+       g.dy        = dy;
+       g.map       = m;
+       g.map_bytes = nbytes;
+       return (0);
+}
+
+
+void
+gms::math::itm_elev_grid_wrap(const float * __restrict z,
+                              const int32_t nx,
+                              const int32_t ny,
+                              const double x0,
+                              const double y0,
+                              const double dx,
+                              const double dy,
+                              ITM_ElevGrid & g) {
+       g.z         = z;
+       g.nx        = nx;
+       g.ny        = ny;
+       g.x0        = x0;
+       g.y0        = y0;
+       g.dx        = dx;
+       g.dy        = dy;
+       g.map       = nullptr;
+       g.map_bytes = 0ULL;
+}
+
+
+void
+gms::math::itm_elev_grid_unmap(ITM_ElevGrid & g) {
+       if(g.map != nullptr) munmap(g.map,g.map_bytes);
+       g.map       = nullptr;
+       g.map_bytes = 0ULL;
+       g.z         = nullptr;
+}
+
+
+void
+gms::math::itm_profile_extract(const ITM_ElevGrid & g,
+                               const double xa,
+                               const double ya,
+                               const double xb,
+                               const double yb,
+                               const int32_t np,
+                               double * __restrict pfl) {
+       // Grid units, the same single precision arithmetic as itm_p2p_coverage_omp.
+       const float gx0{static_cast<float>((xa-g.x0)/g.dx)};
+       const float gy0{static_cast<float>((ya-g.y0)/g.dy)};
+       const float ddx{static_cast<float>((xb-g.x0)/g.dx)-gx0};
+       const float ddy{static_cast<float>((yb-g.y0)/g.dy)-gy0};
+       const float xmax{static_cast<float>(g.nx-1)};
+       const float ymax{static_cast<float>(g.ny-1)};
+       const float rnp{1.0f/static_cast<float>(np)};
+       pfl[0] = static_cast<double>(np);
+       pfl[1] = std::hypot(xb-xa,yb-ya)/static_cast<double>(np);
+       for(int32_t __i{0}; __i <= np; ++__i) {
+           const float t{static_cast<float>(__i)*rnp};
+           const float fx{std::min(std::max(std::fma(t,ddx,gx0),0.0f),xmax)};
+           const float fy{std::min(std::max(std::fma(t,ddy,gy0),0.0f),ymax)};
+           const int32_t ix{std::min(static_cast<int32_t>(fx),g.nx-2)};
+           const int32_t iy{std::min(static_cast<int32_t>(fy),g.ny-2)};
+           const float wx{fx-static_cast<float>(ix)};
+           const float wy{fy-static_cast<float>(iy)};
+           const float * __restrict r0{g.z+static_cast<std::size_t>(iy)*g.nx+ix};
+           const float * __restrict r1{r0+g.nx};
+           const float z0{std::fma(wx,r0[1]-r0[0],r0[0])};
+           const float z1{std::fma(wx,r1[1]-r1[0],r1[0])};
+           pfl[__i+2] = static_cast<double>(std::fma(wy,z1-z0,z0));
+       }
+}
+
+
+namespace {
+
+        // Bilinear heights of 16 profiles, lane k from (gx0,gy0) to (gx0+ddx[k],gy0+ddy[k]) (grid units).
+        void profile_extract_zmm16r4(const gms::math::ITM_ElevGrid & g,
+                                     const float gx0,
+                                     const float gy0,
+                                     const __m512 ddx,
+                                     const __m512 ddy,
+                                     const int32_t np,
+                                     float * __restrict pfl16) {
+               const __m512 vx0{_mm512_set1_ps(gx0)};
+               const __m512 vy0{_mm512_set1_ps(gy0)};
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 xmax{_mm512_set1_ps(static_cast<float>(g.nx-1))};
+               const __m512 ymax{_mm512_set1_ps(static_cast<float>(g.ny-1))};
+               const __m512i ixm{_mm512_set1_epi32(g.nx-2)};
+               const __m512i iym{_mm512_set1_epi32(g.ny-2)};
+               const __m512i vnx{_mm512_set1_epi32(g.nx)};
+               const float rnp{1.0f/static_cast<float>(np)};
+               for(int32_t __i{0}; __i <= np; ++__i) {
+                   const __m512 t{_mm512_set1_ps(static_cast<float>(__i)*rnp)};
+                   const __m512 fx{_mm512_min_ps(_mm512_max_ps(_mm512_fmadd_ps(t,ddx,vx0),zero),xmax)};
+                   const __m512 fy{_mm512_min_ps(_mm512_max_ps(_mm512_fmadd_ps(t,ddy,vy0),zero),ymax)};
+                   const __m512i ix{_mm512_min_epi32(_mm512_cvttps_epi32(fx),ixm)};
+                   const __m512i iy{_mm512_min_epi32(_mm512_cvttps_epi32(fy),iym)};
+                   const __m512 wx{_mm512_sub_ps(fx,_mm512_cvtepi32_ps(ix))};
+                   const __m512 wy{_mm512_sub_ps(fy,_mm512_cvtepi32_ps(iy))};
+                   const __m512i b0{_mm512_add_epi32(_mm512_mullo_epi32(iy,vnx),ix)};
+                   const __m512i b1{_mm512_add_epi32(b0,vnx)};
+                   const __m512 z00{_mm512_i32gather_ps(b0,g.z,4)};
+                   const __m512 z01{_mm512_i32gather_ps(b0,g.z+1,4)};
+                   const __m512 z10{_mm512_i32gather_ps(b1,g.z,4)};
+                   const __m512 z11{_mm512_i32gather_ps(b1,g.z+1,4)};
+                   const __m512 z0{_mm512_fmadd_ps(wx,_mm512_sub_ps(z01,z00),z00)};
+                   const __m512 z1{_mm512_fmadd_ps(wx,_mm512_sub_ps(z11,z10),z10)};
+                   _mm512_store_ps(&pfl16[16*__i],_mm512_fmadd_ps(wy,_mm512_sub_ps(z1,z0),z0));
+               }
+        }
+
+} // anon
+
+
+int32_t
+gms::math::itm_p2p_coverage_omp(const ITM_ElevGrid & g,
+                                const ITM_Params & p,
+                                const double tx_x,
+                                const double tx_y,
+                                const double h_tx,
+                                const double h_rx,
+                                const double * __restrict rx_x,
+                                const double * __restrict rx_y,
+                                const int32_t nrx,
+                                const double pfl_step,
+                                float * __restrict A_db,
+                                int8_t * __restrict propmode,
+                                int8_t * __restrict kwx) {
+       if(nrx <= 0) return (0);
+       double dmax{0.0};
+#pragma omp parallel for schedule(static) default(none) shared(rx_x,rx_y,nrx,tx_x,tx_y) reduction(max:dmax)
+       for(int32_t __i = 0; __i < nrx; ++__i) {
+           dmax = std::max(dmax,std::hypot(rx_x[__i]-tx_x,rx_y[__i]-tx_y));
+       }
+       const int32_t npmax{std::max(2,static_cast<int32_t>(std::ceil(dmax/pfl_step)))};
+       const std::size_t stride{16ULL*(static_cast<std::size_t>(npmax)+1ULL)};
+       const int32_t nthr{omp_get_max_threads()};
+       float * __restrict buf{reinterpret_cast<float*>(_mm_malloc(static_cast<std::size_t>(nthr)*stride*sizeof(float),64ULL))};
+       if(buf == nullptr) return (1);
+       const float gx0{static_cast<float>((tx_x-g.x0)/g.dx)};
+       const float gy0{static_cast<float>((tx_y-g.y0)/g.dy)};
+       const int32_t nb{(nrx+15)/16};
+#pragma omp parallel for schedule(dynamic,4) default(none) \
+        shared(g,p,tx_x,tx_y,h_tx,h_rx,rx_x,rx_y,nrx,pfl_step,A_db,propmode,kwx,buf,stride,gx0,gy0,nb)
+       for(int32_t __b = 0; __b < nb; ++__b) {
+           float * __restrict pfl16{buf+static_cast<std::size_t>(omp_get_thread_num())*stride};
+           const int32_t i0{16*__b};
+           const int32_t nl{std::min(16,nrx-i0)};
+           alignas(64) float ddx[16], ddy[16], dst[16];
+           double dm{0.0};
+           for(int32_t __k{0}; __k != 16; ++__k) {
+               const int32_t i{i0+std::min(__k,nl-1)}; // tail lanes repeat the last receiver
+               const double d{std::hypot(rx_x[i]-tx_x,rx_y[i]-tx_y)};
+               ddx[__k] = static_cast<float>((rx_x[i]-g.x0)/g.dx)-gx0;
+               ddy[__k] = static_cast<float>((rx_y[i]-g.y0)/g.dy)-gy0;
+               dst[__k] = static_cast<float>(std::max(d,1.0));
+               dm = std::max(dm,d);
+           }
+           const int32_t np{std::max(2,static_cast<int32_t>(std::ceil(dm/pfl_step)))};
+           profile_extract_zmm16r4(g,gx0,gy0,_mm512_load_ps(ddx),_mm512_load_ps(ddy),np,pfl16);
+           const __m512 xi{_mm512_div_ps(_mm512_load_ps(dst),_mm512_set1_ps(static_cast<float>(np)))};
+           __m512i vmode,vkwx;
+           const __m512 A{itm_p2p_zmm16r4(_mm512_set1_ps(static_cast<float>(h_tx)),
+                                          _mm512_set1_ps(static_cast<float>(h_rx)),
+                                          np,xi,pfl16,p,vmode,vkwx)};
+           alignas(64) float a[16];
+           alignas(64) int32_t m[16], w[16];
+           _mm512_store_ps(a,A);
+           _mm512_store_si512(m,vmode);
+           _mm512_store_si512(w,vkwx);
+           for(int32_t __k{0}; __k != nl; ++__k) {
+               const bool tiny{dst[__k] <= 1.0f};
+               A_db[i0+__k] = tiny ? std::numeric_limits<float>::quiet_NaN() : a[__k];
+               if(propmode != nullptr) propmode[i0+__k] = static_cast<int8_t>(tiny ? MODE__NOT_SET : m[__k]);
+               if(kwx != nullptr)      kwx[i0+__k]      = static_cast<int8_t>(w[__k]);
+           }
+       }
+       _mm_free(buf);
+       return (0);
+}
+
+
+void
+gms::math::itm_area_batch_omp(const double h_tx,
+                              const double h_rx,
+                              const int32_t tx_siting,
+                              const int32_t rx_siting,
+                              const double delta_h,
+                              const ITM_Params & p,
+                              const float * __restrict d_km,
+                              const int32_t n,
+                              float * __restrict A_db,
+                              int8_t * __restrict propmode,
+                              int8_t * __restrict kwx) {
+       const int32_t nb{(n+15)/16};
+#pragma omp parallel for schedule(static) default(none) \
+        shared(h_tx,h_rx,tx_siting,rx_siting,delta_h,p,d_km,n,A_db,propmode,kwx,nb)
+       for(int32_t __b = 0; __b < nb; ++__b) {
+           const int32_t i0{16*__b};
+           const int32_t nl{std::min(16,n-i0)};
+           alignas(64) float d[16];
+           for(int32_t __k{0}; __k != 16; ++__k) d[__k] = d_km[i0+std::min(__k,nl-1)];
+           __m512i vmode,vkwx;
+           const __m512 A{itm_area_zmm16r4(_mm512_set1_ps(static_cast<float>(h_tx)),
+                                           _mm512_set1_ps(static_cast<float>(h_rx)),
+                                           tx_siting,rx_siting,_mm512_load_ps(d),
+                                           _mm512_set1_ps(static_cast<float>(delta_h)),p,vmode,vkwx)};
+           alignas(64) float a[16];
+           alignas(64) int32_t m[16], w[16];
+           _mm512_store_ps(a,A);
+           _mm512_store_si512(m,vmode);
+           _mm512_store_si512(w,vkwx);
+           for(int32_t __k{0}; __k != nl; ++__k) {
+               A_db[i0+__k] = a[__k];
+               if(propmode != nullptr) propmode[i0+__k] = static_cast<int8_t>(m[__k]);
+               if(kwx != nullptr)      kwx[i0+__k]      = static_cast<int8_t>(w[__k]);
+           }
+       }
+}
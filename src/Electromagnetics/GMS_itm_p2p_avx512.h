@@ -0,0 +1,270 @@
+#ifndef __GMS_ITM_P2P_AVX512_H__
+#define __GMS_ITM_P2P_AVX512_H__
+
+/*
+
+
+SOFTWARE DISCLAIMER / RELEASE
+
+This software was developed by employees of the National Telecommunications and Information Administration (NTIA), an agency of the Federal Government and is provided to you as a public service. Pursuant to Title 15 United States Code Section 105, works of NTIA employees are not subject to copyright protection within the United States.
+
+The software is provided by NTIA “AS IS.” NTIA MAKES NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED OR STATUTORY, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NTIA does not warrant or make any representations regarding the use of the software or the results thereof, including but not limited to the correctness, accuracy, reliability or usefulness of the software.
+
+To the extent that NTIA holds rights in countries other than the United States, you are hereby granted the non-exclusive irrevocable and unconditional right to print, publish, prepare derivative works and distribute the NTIA software, in any medium, or authorize others to do so on your behalf, on a royalty-free basis throughout the World.
+
+You may improve, modify, and create derivative works of the software or any portion of the software, and you may copy and distribute such modifications or works. Modified works should carry a notice stating that you changed the software and should note the date and nature of any such change.
+
+You are solely responsible for determining the appropriateness of using and distributing the software and you assume all risks associated with its use, including but not limited to the risks and costs of program errors, compliance with applicable laws, damage to or loss of data, programs or equipment, and the unavailability or interruption of operation. This software is not intended to be used in any situation where a failure could cause risk of injury or damage to property.
+
+Please provide appropriate acknowledgments of NTIA’s creation of the software in any copies or derivative works of this software.
+
+
+   Point-to-point and area mode engine, 16 links per AVX512 register,
+   by Bernard Gingold on 19-10-2026.
+*/
+
+namespace file_info {
+
+     const unsigned int GMS_ITM_P2P_AVX512_MAJOR = 1;
+     const unsigned int GMS_ITM_P2P_AVX512_MINOR = 0;
+     const unsigned int GMS_ITM_P2P_AVX512_MICRO = 0;
+     const unsigned int GMS_ITM_P2P_AVX512_FULLVER = 1000*GMS_ITM_P2P_AVX512_MAJOR+
+                                                     100*GMS_ITM_P2P_AVX512_MINOR+
+						     10*GMS_ITM_P2P_AVX512_MICRO;
+     const char * const GMS_ITM_P2P_AVX512_CREATION_DATE = "19-10-2026 21:10 PM +00200 (MON 19 OCT 2026 GMT+2)";
+     const char * const GMS_ITM_P2P_AVX512_BUILD_DATE    = __DATE__ ":" __TIME__;
+     const char * const GMS_ITM_P2P_AVX512_PROGRAMMER    = "Programmer: Bernard Gingold, contact: beniekg@gmail.com, adapted from ITM v1.2.2/v1.4 model.";
+     const char * const GMS_ITM_P2P_AVX512_DESCRIPTION   = "Longley-Rice (ITM) point-to-point and area mode, terrain profiles from elevation grids, AVX512 and OpenMP.";
+}
+
+/*
+     Longley-Rice Irregular Terrain Model, point-to-point (terrain profile) and
+     area (delta_h, siting criteria) modes: reference attenuation in the
+     line-of-sight, diffraction and troposcatter regions plus the time/location/
+     situation variability, added to the free-space loss.
+     The scalar functions (double precision) follow the NTIA code; the _zmm16r4
+     functions evaluate 16 links per register in single precision (all lanes
+     share the radio parameters in ITM_Params, not the geometry) and agree with
+     the scalar ones to a small fraction of a dB.
+     Terrain is sampled bilinearly from a regular elevation grid in planar
+     coordinates (meters), either caller-owned or a memory-mapped raw float32
+     file (row-major, native byte order, e.g. an ESRI .flt body).
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include <cstddef>
+#include "GMS_config.h"
+
+#if !defined(POLARIZATION__HORIZONTAL)
+// List of valid polarizations
+#define POLARIZATION__HORIZONTAL                0
+#define POLARIZATION__VERTICAL                  1
+
+// List of valid siting criteria
+#define SITING_CRITERIA__RANDOM                 0
+#define SITING_CRITERIA__CAREFUL                1
+#define SITING_CRITERIA__VERY_CAREFUL           2
+
+// List of valid radio climates
+#define CLIMATE__EQUATORIAL                     1
+#define CLIMATE__CONTINENTAL_SUBTROPICAL        2
+#define CLIMATE__MARITIME_SUBTROPICAL           3
+#define CLIMATE__DESERT                         4
+#define CLIMATE__CONTINENTAL_TEMPERATE          5
+#define CLIMATE__MARITIME_TEMPERATE_OVER_LAND   6
+#define CLIMATE__MARITIME_TEMPERATE_OVER_SEA    7
+
+// List of valid modes of propagation
+#define MODE__NOT_SET                           0
+#define MODE__LINE_OF_SIGHT                     1
+#define MODE__DIFFRACTION                       2
+#define MODE__TROPOSCATTER                      3
+#endif
+
+// Modes of variability
+#define MDVAR__SINGLE_MESSAGE                   0
+#define MDVAR__ACCIDENTAL                       1
+#define MDVAR__MOBILE                           2
+#define MDVAR__BROADCAST                        3
+
+namespace gms {
+
+          namespace math {
+
+                /*
+                      Regular elevation grid: z[iy*nx+ix] is the height (m, above mean
+                      sea level) at (x0+ix*dx, y0+iy*dy). nx*ny must fit in int32_t
+                      (the profile extraction gathers with 32-bit indices).
+                */
+                typedef struct ITM_ElevGrid {
+
+                        const float * z;
+                        int32_t       nx;
+                        int32_t       ny;
+                        double        x0;
+                        double        y0;
+                        double        dx;
+                        double        dy;
+                        void *        map;       // mmap base, nullptr for caller-owned arrays
+                        std::size_t   map_bytes;
+                } ITM_ElevGrid;
+
+                /*
+                      Radio parameters common to all links of a call.
+                */
+                typedef struct ITM_Params {
+
+                        double  f_mhz;        // frequency, 20 .. 20000 MHz
+                        double  N_0;          // surface refractivity, 250 .. 400 N-units
+                        double  epsilon;      // relative permittivity of the ground
+                        double  sigma;        // ground conductivity, S/m
+                        int32_t polarization; // POLARIZATION__*
+                        int32_t climate;      // CLIMATE__*
+                        int32_t mdvar;        // MDVAR__* (+10 no location, +20 no situation variability)
+                        double  time;         // time percentage, 0 < time < 100
+                        double  location;     // location percentage
+                        double  situation;    // situation (confidence) percentage
+                } ITM_Params;
+
+                /*
+                      Maps a raw float32 elevation file of nx*ny samples.
+                      Returns 0 -- success, 1 -- cannot open/stat, 2 -- file smaller
+                      than nx*ny floats, 3 -- mmap failure.
+                */
+                int32_t itm_elev_grid_mmap(const char * __restrict fname,
+                                           const int32_t nx,
+                                           const int32_t ny,
+                                           const double x0,
+                                           const double y0,
+                                           const double dx,
+                                           const double dy,
+                                           ITM_ElevGrid & g);
+
+                void itm_elev_grid_wrap(const float * __restrict z,
+                                        const int32_t nx,
+                                        const int32_t ny,
+                                        const double x0,
+                                        const double y0,
+                                        const double dx,
+                                        const double dy,
+                                        ITM_ElevGrid & g);
+
+                void itm_elev_grid_unmap(ITM_ElevGrid & g);
+
+                /*
+                      Terrain profile in the ITM layout: pfl[0] = np, pfl[1] = xi
+                      (spacing, m), pfl[2..np+2] = np+1 heights sampled from (xa,ya)
+                      to (xb,yb). Points outside of the grid take the edge heights.
+                */
+                void itm_profile_extract(const ITM_ElevGrid & g,
+                                         const double xa,
+                                         const double ya,
+                                         const double xb,
+                                         const double yb,
+                                         const int32_t np,
+                                         double * __restrict pfl);
+
+                /*
+                      Scalar reference, point-to-point mode.
+                      h_tx,h_rx -- structural antenna heights (m), pfl -- profile as above.
+                      *A_db     -- basic transmission loss (dB), *propmode -- MODE__*.
+                      Returns the ITM warning level kwx: 0 -- none, 1 -- parameters
+                      slightly out of range, 2 -- default parameters substituted,
+                      3 -- out of range, 4 -- results are probably invalid.
+                */
+                int32_t itm_p2p_tls(const double h_tx,
+                                    const double h_rx,
+                                    const double * __restrict pfl,
+                                    const ITM_Params & p,
+                                    double * __restrict A_db,
+                                    int32_t * __restrict propmode);
+
+                /*
+                      Scalar reference, area mode.
+                      tx_siting,rx_siting -- SITING_CRITERIA__*, d_km -- path length,
+                      delta_h -- terrain irregularity parameter (m).
+                */
+                int32_t itm_area_tls(const double h_tx,
+                                     const double h_rx,
+                                     const int32_t tx_siting,
+                                     const int32_t rx_siting,
+                                     const double d_km,
+                                     const double delta_h,
+                                     const ITM_Params & p,
+                                     double * __restrict A_db,
+                                     int32_t * __restrict propmode);
+
+                /*
+                      16 point-to-point links. The profiles share the number of
+                      intervals np, lane k has the spacing xi[k] and the heights
+                      pfl16[16*i+k], i = 0..np. np >= 2.
+                      Returns A_db, propmode and kwx as in itm_p2p_tls.
+                */
+                __m512 itm_p2p_zmm16r4(const __m512 h_tx,
+                                       const __m512 h_rx,
+                                       const int32_t np,
+                                       const __m512 xi,
+                                       const float * __restrict pfl16,
+                                       const ITM_Params & p,
+                                       __m512i & propmode,
+                                       __m512i & kwx);
+
+                /*
+                      16 area mode links (distances and heights per lane).
+                */
+                __m512 itm_area_zmm16r4(const __m512 h_tx,
+                                        const __m512 h_rx,
+                                        const int32_t tx_siting,
+                                        const int32_t rx_siting,
+                                        const __m512 d_km,
+                                        const __m512 delta_h,
+                                        const ITM_Params & p,
+                                        __m512i & propmode,
+                                        __m512i & kwx);
+
+                /*
+                      Coverage of a transmitter at (tx_x,tx_y), h_tx above ground, for
+                      nrx receivers h_rx above ground: OpenMP over batches of 16
+                      consecutive receivers (keep neighbouring receivers adjacent, the
+                      batch uses the profile length of its farthest receiver).
+                      pfl_step -- target profile spacing (m), typically the grid spacing.
+                      Receivers closer than 1 m get A_db = NaN and MODE__NOT_SET.
+                      propmode and kwx may be nullptr.
+                      Returns 0 -- success, 1 -- allocation failure.
+                */
+                int32_t itm_p2p_coverage_omp(const ITM_ElevGrid & g,
+                                             const ITM_Params & p,
+                                             const double tx_x,
+                                             const double tx_y,
+                                             const double h_tx,
+                                             const double h_rx,
+                                             const double * __restrict rx_x,
+                                             const double * __restrict rx_y,
+                                             const int32_t nrx,
+                                             const double pfl_step,
+                                             float * __restrict A_db,
+                                             int8_t * __restrict propmode,
+                                             int8_t * __restrict kwx);
+
+                /*
+                      Area mode for n distances d_km (OpenMP over batches of 16).
+                      propmode and kwx may be nullptr.
+                */
+                void itm_area_batch_omp(const double h_tx,
+                                        const double h_rx,
+                                        const int32_t tx_siting,
+                                        const int32_t rx_siting,
+                                        const double delta_h,
+                                        const ITM_Params & p,
+                                        const float * __restrict d_km,
+                                        const int32_t n,
+                                        float * __restrict A_db,
+                                        int8_t * __restrict propmode,
+                                        int8_t * __restrict kwx);
+
+          } // math
+
+} // gms
+
+#endif /*__GMS_ITM_P2P_AVX512_H__*/
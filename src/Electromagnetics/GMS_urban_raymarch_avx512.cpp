@@ -0,0 +1,592 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_urban_raymarch_avx512.h"
+
+
+int32_t
+gms::radiolocation::urban_hmap_mip_build(const float * __restrict hmap,
+                                         const int32_t nx,
+                                         const int32_t ny,
+                                         const float dx,
+                                         const float dy,
+                                         UrbanHMapMip_t & m) {
+       std::memset(&m,0,sizeof(m));
+       int32_t lx{nx}, ly{ny}, nlev{1};
+       std::size_t total{static_cast<std::size_t>(nx)*static_cast<std::size_t>(ny)};
+       m.lnx[0] = nx;
+       m.lny[0] = ny;
+       while(lx > 1 || ly > 1) {
+             if(nlev == 16) return (2);
+             m.base[nlev] = static_cast<int32_t>(std::min(total,static_cast<std::size_t>(std::numeric_limits<int32_t>::max())));
+             lx = (lx+1)/2;
+             ly = (ly+1)/2;
+             m.lnx[nlev] = lx;
+             m.lny[nlev] = ly;
+             total += static_cast<std::size_t>(lx)*static_cast<std::size_t>(ly);
+             ++nlev;
+       }
+       if(total > static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) return (2);
+       for(int32_t __l{nlev}; __l != 16; ++__l) { // permutexvar by the level index needs 16 entries
+           m.lnx[__l]  = m.lnx[nlev-1];
+           m.lny[__l]  = m.lny[nlev-1];
+           m.base[__l] = m.base[nlev-1];
+       }
+       m.buf = reinterpret_cast<float*>(_mm_malloc(total*sizeof(float),64ULL));
+       if(m.buf == nullptr) return (1);
+       m.nx   = nx;
+       m.ny   = ny;
+       m.dx   = dx;
+       m.dy   = dy;
+       m.nlev = nlev;
+       float * __restrict buf{m.buf};
+#pragma omp parallel for schedule(static) default(none) shared(hmap,nx,ny,buf)
+       for(int32_t __i = 0; __i < ny; ++__i) {
+           std::memcpy(&buf[static_cast<std::size_t>(__i)*nx],&hmap[static_cast<std::size_t>(__i)*nx],
+                       static_cast<std::size_t>(nx)*sizeof(float));
+       }
+       for(int32_t __l{1}; __l != nlev; ++__l) {
+           const float * __restrict src{buf+m.base[__l-1]};
+           float * __restrict dst{buf+m.base[__l]};
+           const int32_t sx{m.lnx[__l-1]}, sy{m.lny[__l-1]};
+           const int32_t tx{m.lnx[__l]}, ty{m.lny[__l]};
+#pragma omp parallel for schedule(static) default(none) shared(src,dst,sx,sy,tx,ty)
+           for(int32_t __i = 0; __i < ty; ++__i) {
+               const float * __restrict r0{src+static_cast<std::size_t>(2*__i)*sx};
+               const float * __restrict r1{(2*__i+1 < sy) ? r0+sx : r0};
+               for(int32_t __j = 0; __j < tx; ++__j) {
+                   const int32_t j0{2*__j};
+                   const int32_t j1{std::min(j0+1,sx-1)};
+                   dst[static_cast<std::size_t>(__i)*tx+__j] = std::max(std::max(r0[j0],r0[j1]),std::max(r1[j0],r1[j1]));
+               }
+           }
+       }
+       return (0);
+}
+
+
+void
+gms::radiolocation::urban_hmap_mip_free(UrbanHMapMip_t & m) {
+       if(m.buf != nullptr) _mm_free(m.buf);
+       m.buf  = nullptr;
+       m.nlev = 0;
+}
+
+
+namespace {
+
+        // Cell selection offset (grid units) of the positions on cell boundaries.
+        inline float raymarch_eps(const gms::radiolocation::UrbanHMapMip_t & m) {
+               return (std::max(1.0e-4f,1.0e-6f*static_cast<float>(std::max(m.nx,m.ny))));
+        }
+
+        __attribute__((always_inline))
+        inline __m512 sel_zmm16r4(const __mmask16 k,
+                                  const __m512 a,
+                                  const __m512 b) { // k ? a : b
+               return (_mm512_mask_blend_ps(k,b,a));
+        }
+
+        /*
+              Max-mipmap march of the active lanes of 16 segments (meters).
+              Every step tests the cell of the current level under the ray
+              interval [t,t_exit]: a coarse cell below the ray is crossed and the
+              level raised, otherwise the level is lowered, down to the map cells.
+        */
+        __mmask16 los_zmm16r4(const gms::radiolocation::UrbanHMapMip_t & m,
+                              const __mmask16 act_in,
+                              const __m512 ox,
+                              const __m512 oy,
+                              const __m512 oz,
+                              const __m512 ex,
+                              const __m512 ey,
+                              const __m512 ez,
+                              __m512 & t_hit) {
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               const __m512 big{_mm512_set1_ps(1.0e+30f)};
+               const __m512 rdx{_mm512_set1_ps(1.0f/m.dx)};
+               const __m512 rdy{_mm512_set1_ps(1.0f/m.dy)};
+               const __m512 gx0{_mm512_mul_ps(ox,rdx)};
+               const __m512 gy0{_mm512_mul_ps(oy,rdy)};
+               const __m512 ddx{_mm512_sub_ps(_mm512_mul_ps(ex,rdx),gx0)};
+               const __m512 ddy{_mm512_sub_ps(_mm512_mul_ps(ey,rdy),gy0)};
+               const __m512 ddz{_mm512_sub_ps(ez,oz)};
+               const __m512 adx{_mm512_abs_ps(ddx)};
+               const __m512 ady{_mm512_abs_ps(ddy)};
+               const __m512 invx{sel_zmm16r4(_mm512_cmp_ps_mask(adx,_mm512_set1_ps(1.0e-20f),_CMP_LT_OQ),big,_mm512_div_ps(one,ddx))};
+               const __m512 invy{sel_zmm16r4(_mm512_cmp_ps_mask(ady,_mm512_set1_ps(1.0e-20f),_CMP_LT_OQ),big,_mm512_div_ps(one,ddy))};
+               const __mmask16 posx{_mm512_cmp_ps_mask(invx,zero,_CMP_GT_OQ)};
+               const __mmask16 posy{_mm512_cmp_ps_mask(invy,zero,_CMP_GT_OQ)};
+               // clip to the map box [0,nx]x[0,ny]
+               const __m512 xa{_mm512_mul_ps(_mm512_sub_ps(zero,gx0),invx)};
+               const __m512 xb{_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(static_cast<float>(m.nx)),gx0),invx)};
+               const __m512 ya{_mm512_mul_ps(_mm512_sub_ps(zero,gy0),invy)};
+               const __m512 yb{_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(static_cast<float>(m.ny)),gy0),invy)};
+               const __m512 t0{_mm512_max_ps(zero,_mm512_max_ps(_mm512_min_ps(xa,xb),_mm512_min_ps(ya,yb)))};
+               const __m512 t1{_mm512_min_ps(one,_mm512_min_ps(_mm512_max_ps(xa,xb),_mm512_max_ps(ya,yb)))};
+               __mmask16 act = act_in & _mm512_cmp_ps_mask(t0,t1,_CMP_LT_OQ);
+               __mmask16 vis{act_in};
+               t_hit = one;
+               const float eps{raymarch_eps(m)};
+               const __m512 epx{sel_zmm16r4(posx,_mm512_set1_ps(eps),_mm512_set1_ps(-eps))};
+               const __m512 epy{sel_zmm16r4(posy,_mm512_set1_ps(eps),_mm512_set1_ps(-eps))};
+               const __m512 tstep{_mm512_div_ps(_mm512_set1_ps(eps),
+                                                _mm512_max_ps(_mm512_max_ps(adx,ady),_mm512_set1_ps(1.0e-20f)))};
+               const __m512 bx1{_mm512_maskz_mov_ps(posx,one)};
+               const __m512 by1{_mm512_maskz_mov_ps(posy,one)};
+               const __m512i lnx{_mm512_loadu_si512(m.lnx)};
+               const __m512i lny{_mm512_loadu_si512(m.lny)};
+               const __m512i base{_mm512_loadu_si512(m.base)};
+               const __m512i i1{_mm512_set1_epi32(1)};
+               const __m512i ltop{_mm512_set1_epi32(m.nlev-1)};
+               __m512i L{ltop};
+               __m512 t{t0};
+               while(act) {
+                     const __m512 lf{_mm512_cvtepi32_ps(L)};
+                     const __m512 s{_mm512_scalef_ps(one,lf)};
+                     const __m512 rs{_mm512_scalef_ps(one,_mm512_sub_ps(zero,lf))};
+                     const __m512i nxl{_mm512_sub_epi32(_mm512_permutexvar_epi32(L,lnx),i1)};
+                     const __m512i nyl{_mm512_sub_epi32(_mm512_permutexvar_epi32(L,lny),i1)};
+                     const __m512 px{_mm512_fmadd_ps(t,ddx,gx0)};
+                     const __m512 py{_mm512_fmadd_ps(t,ddy,gy0)};
+                     __m512i cx{_mm512_cvttps_epi32(_mm512_max_ps(_mm512_mul_ps(_mm512_add_ps(px,epx),rs),zero))};
+                     __m512i cy{_mm512_cvttps_epi32(_mm512_max_ps(_mm512_mul_ps(_mm512_add_ps(py,epy),rs),zero))};
+                     cx = _mm512_min_epi32(cx,nxl);
+                     cy = _mm512_min_epi32(cy,nyl);
+                     const __m512 bx{_mm512_mul_ps(_mm512_add_ps(_mm512_cvtepi32_ps(cx),bx1),s)};
+                     const __m512 by{_mm512_mul_ps(_mm512_add_ps(_mm512_cvtepi32_ps(cy),by1),s)};
+                     __m512 te{_mm512_min_ps(_mm512_mul_ps(_mm512_sub_ps(bx,gx0),invx),
+                                             _mm512_mul_ps(_mm512_sub_ps(by,gy0),invy))};
+                     te = _mm512_min_ps(_mm512_max_ps(te,_mm512_add_ps(t,tstep)),t1);
+                     const __m512 z0{_mm512_fmadd_ps(t,ddz,oz)};
+                     const __m512 z1{_mm512_fmadd_ps(te,ddz,oz)};
+                     const __m512i idx{_mm512_add_epi32(_mm512_permutexvar_epi32(L,base),
+                                                        _mm512_add_epi32(_mm512_mullo_epi32(cy,_mm512_add_epi32(nxl,i1)),cx))};
+                     const __m512 H{_mm512_mask_i32gather_ps(zero,act,idx,m.buf,4)};
+                     const __mmask16 hit = act & _mm512_cmp_ps_mask(H,_mm512_min_ps(z0,z1),_CMP_GT_OQ);
+                     const __mmask16 l0{_mm512_cmpeq_epi32_mask(L,_mm512_setzero_si512())};
+                     const __mmask16 fine = hit & l0;
+                     if(fine) {
+                        const __m512 th{sel_zmm16r4(_mm512_cmp_ps_mask(z0,H,_CMP_LT_OQ),t,
+                                                    _mm512_div_ps(_mm512_sub_ps(H,oz),ddz))};
+                        t_hit = _mm512_mask_mov_ps(t_hit,fine,th);
+                        vis &= ~fine;
+                        act &= ~fine;
+                     }
+                     L = _mm512_mask_sub_epi32(L,hit & ~l0,L,i1);
+                     const __mmask16 adv = act & ~hit;
+                     t = _mm512_mask_mov_ps(t,adv,te);
+                     L = _mm512_mask_min_epi32(L,adv,_mm512_add_epi32(L,i1),ltop);
+                     act &= ~(adv & _mm512_cmp_ps_mask(te,t1,_CMP_GE_OQ));
+               }
+               return (vis);
+        }
+
+        __attribute__((always_inline))
+        inline __m512 hmap_gather_zmm16r4(const gms::radiolocation::UrbanHMapMip_t & m,
+                                          const __mmask16 k,
+                                          const __m512i ix,
+                                          const __m512i iy) {
+               const __m512i idx{_mm512_add_epi32(_mm512_mullo_epi32(iy,_mm512_set1_epi32(m.nx)),ix)};
+               return (_mm512_mask_i32gather_ps(_mm512_setzero_ps(),k,idx,m.buf,4));
+        }
+
+        // Cell (cx,cy) of the per-lane level L.
+        __attribute__((always_inline))
+        inline __m512 mip_gather_zmm16r4(const gms::radiolocation::UrbanHMapMip_t & m,
+                                         const __mmask16 k,
+                                         const __m512i L,
+                                         const __m512i cx,
+                                         const __m512i cy) {
+               const __m512i lnx{_mm512_permutexvar_epi32(L,_mm512_loadu_si512(m.lnx))};
+               const __m512i base{_mm512_permutexvar_epi32(L,_mm512_loadu_si512(m.base))};
+               const __m512i idx{_mm512_add_epi32(base,_mm512_add_epi32(_mm512_mullo_epi32(cy,lnx),cx))};
+               return (_mm512_mask_i32gather_ps(_mm512_setzero_ps(),k,idx,m.buf,4));
+        }
+
+        inline float hmap_at(const gms::radiolocation::UrbanHMapMip_t & m,
+                             const int32_t ix,
+                             const int32_t iy) {
+               return (m.buf[static_cast<std::size_t>(iy)*m.nx+ix]);
+        }
+
+} // anon
+
+
+__mmask16
+gms::radiolocation::urban_los_zmm16r4(const UrbanHMapMip_t & m,
+                                      const __m512 ox,
+                                      const __m512 oy,
+                                      const __m512 oz,
+                                      const __m512 ex,
+                                      const __m512 ey,
+                                      const __m512 ez,
+                                      __m512 & t_hit) {
+       return (los_zmm16r4(m,0xFFFF,ox,oy,oz,ex,ey,ez,t_hit));
+}
+
+
+void
+gms::radiolocation::urban_reflect_zmm16r4(const UrbanHMapMip_t & m,
+                                          const __m512 tx,
+                                          const __m512 ty,
+                                          const __m512 tz,
+                                          const __m512 rx,
+                                          const __m512 ry,
+                                          const __m512 rz,
+                                          const float h_gnd,
+                                          UrbanRefl_zmm16r4_t & r) {
+       const __m512 zero{_mm512_setzero_ps()};
+       const __m512 vdx{_mm512_set1_ps(m.dx)};
+       const __m512 vdy{_mm512_set1_ps(m.dy)};
+       const __m512 rdx{_mm512_set1_ps(1.0f/m.dx)};
+       const __m512 rdy{_mm512_set1_ps(1.0f/m.dy)};
+       const __m512 fnx{_mm512_set1_ps(static_cast<float>(m.nx))};
+       const __m512 fny{_mm512_set1_ps(static_cast<float>(m.ny))};
+       __m512 th;
+       // Ground: image of t below z = h_gnd.
+       {
+          const __m512 hg{_mm512_set1_ps(h_gnd)};
+          const __m512 a{_mm512_sub_ps(tz,hg)};
+          const __m512 b{_mm512_sub_ps(rz,hg)};
+          __mmask16 ok = _mm512_cmp_ps_mask(a,zero,_CMP_GT_OQ) & _mm512_cmp_ps_mask(b,zero,_CMP_GT_OQ);
+          const __m512 s{_mm512_div_ps(a,_mm512_add_ps(a,b))};
+          const __m512 px{_mm512_fmadd_ps(s,_mm512_sub_ps(rx,tx),tx)};
+          const __m512 py{_mm512_fmadd_ps(s,_mm512_sub_ps(ry,ty),ty)};
+          const __m512 gx{_mm512_mul_ps(px,rdx)};
+          const __m512 gy{_mm512_mul_ps(py,rdy)};
+          ok &= _mm512_cmp_ps_mask(gx,zero,_CMP_GE_OQ) & _mm512_cmp_ps_mask(gx,fnx,_CMP_LT_OQ) &
+                _mm512_cmp_ps_mask(gy,zero,_CMP_GE_OQ) & _mm512_cmp_ps_mask(gy,fny,_CMP_LT_OQ);
+          const __m512 H{hmap_gather_zmm16r4(m,ok,_mm512_cvttps_epi32(gx),_mm512_cvttps_epi32(gy))};
+          ok &= _mm512_cmp_ps_mask(H,_mm512_set1_ps(h_gnd+1.0e-3f),_CMP_LE_OQ); // street cell
+          const __m512 pz{_mm512_set1_ps(h_gnd+1.0e-2f)};
+          if(ok) ok = los_zmm16r4(m,ok,tx,ty,tz,px,py,pz,th);
+          if(ok) ok = los_zmm16r4(m,ok,px,py,pz,rx,ry,rz,th);
+          const __m512 ddx{_mm512_sub_ps(rx,tx)};
+          const __m512 ddy{_mm512_sub_ps(ry,ty)};
+          const __m512 ddz{_mm512_add_ps(a,b)};
+          r.px[UREFL__GROUND]    = px;
+          r.py[UREFL__GROUND]    = py;
+          r.pz[UREFL__GROUND]    = _mm512_set1_ps(h_gnd);
+          r.len[UREFL__GROUND]   = _mm512_sqrt_ps(_mm512_fmadd_ps(ddx,ddx,_mm512_fmadd_ps(ddy,ddy,_mm512_mul_ps(ddz,ddz))));
+          r.valid[UREFL__GROUND] = ok;
+       }
+       // Walls: scan the grid lines g beyond both points for the nearest exposed wall.
+       const __m512 tgx{_mm512_mul_ps(tx,rdx)}, tgy{_mm512_mul_ps(ty,rdy)};
+       const __m512 rgx{_mm512_mul_ps(rx,rdx)}, rgy{_mm512_mul_ps(ry,rdy)};
+       for(int32_t __c{UREFL__WALL_XN}; __c <= UREFL__WALL_YP; ++__c) {
+           const bool ax{__c <= UREFL__WALL_XP};
+           const bool fwd{(__c == UREFL__WALL_XN) || (__c == UREFL__WALL_YN)}; // points at u < g
+           const __m512 tu{ax ? tgx : tgy}, tv{ax ? tgy : tgx};
+           const __m512 ru{ax ? rgx : rgy}, rv{ax ? rgy : rgx};
+           const int32_t nu{ax ? m.nx : m.ny};
+           const __m512 fnv{ax ? fny : fnx};
+           const __m512 sg{_mm512_set1_ps(fwd ? 1.0f : -1.0f)};
+           __m512 g{fwd ? _mm512_add_ps(_mm512_roundscale_ps(_mm512_max_ps(tu,ru),_MM_FROUND_TO_NEG_INF|_MM_FROUND_NO_EXC),
+                                        _mm512_set1_ps(1.0f)) :
+                          _mm512_sub_ps(_mm512_roundscale_ps(_mm512_min_ps(tu,ru),_MM_FROUND_TO_POS_INF|_MM_FROUND_NO_EXC),
+                                        _mm512_set1_ps(1.0f))};
+           const __m512 glo{_mm512_set1_ps(1.0f)};
+           const __m512 ghi{_mm512_set1_ps(static_cast<float>(nu-1))};
+           __mmask16 act = _mm512_cmp_ps_mask(g,glo,_CMP_GE_OQ) & _mm512_cmp_ps_mask(g,ghi,_CMP_LE_OQ);
+           __mmask16 found{0};
+           __m512 fg{zero}, fv{zero}, fz{zero};
+           const __m512i wofs{_mm512_set1_epi32(fwd ? 0 : -1)};
+           const __m512i fofs{_mm512_set1_epi32(fwd ? -1 : 0)};
+           const __m512i i1{_mm512_set1_epi32(1)};
+           const __m512i ltop{_mm512_set1_epi32(m.nlev-1)};
+           const __m512i nvm1{_mm512_set1_epi32((ax ? m.ny : m.nx)-1)};
+           const __m512 two{_mm512_set1_ps(2.0f)};
+           const __m512 tol{_mm512_set1_ps(1.0e-3f)};
+           // The wall columns are skipped in aligned blocks of 2^L (per-lane L)
+           // whose mip maximum over the rows spanned by the reflection point lies
+           // below it; s, pv and pz are monotone in g.
+           __m512i L{_mm512_setzero_si512()};
+           while(act) {
+                 const __mmask16 l0 = act & _mm512_cmpeq_epi32_mask(L,_mm512_setzero_si512());
+                 const __mmask16 lc = act & ~l0;
+                 const __m512 s{_mm512_div_ps(_mm512_sub_ps(g,ru),
+                                              _mm512_sub_ps(_mm512_fmsub_ps(two,g,tu),ru))};
+                 const __m512 pv{_mm512_fmadd_ps(s,_mm512_sub_ps(tv,rv),rv)};
+                 const __m512 pz{_mm512_fmadd_ps(s,_mm512_sub_ps(tz,rz),rz)};
+                 const __m512i ig{_mm512_cvttps_epi32(g)};
+                 const __m512i iw{_mm512_add_epi32(ig,wofs)};
+                 __mmask16 skip{0}, cand{0};
+                 if(lc) {
+                    const __m512i blk{_mm512_srlv_epi32(iw,L)};
+                    const __m512i iwe{fwd ? _mm512_sub_epi32(_mm512_sllv_epi32(_mm512_add_epi32(blk,i1),L),i1) :
+                                            _mm512_sllv_epi32(blk,L)};
+                    __m512 ge{_mm512_cvtepi32_ps(_mm512_sub_epi32(iwe,wofs))};
+                    ge = _mm512_min_ps(_mm512_max_ps(ge,glo),ghi);
+                    const __m512 se{_mm512_div_ps(_mm512_sub_ps(ge,ru),
+                                                  _mm512_sub_ps(_mm512_fmsub_ps(two,ge,tu),ru))};
+                    const __m512 pve{_mm512_fmadd_ps(se,_mm512_sub_ps(tv,rv),rv)};
+                    const __m512 pze{_mm512_fmadd_ps(se,_mm512_sub_ps(tz,rz),rz)};
+                    const __m512 vlo{_mm512_sub_ps(_mm512_min_ps(pv,pve),tol)};
+                    const __m512 vhi{_mm512_add_ps(_mm512_max_ps(pv,pve),tol)};
+                    const __m512i rlo{_mm512_srlv_epi32(_mm512_min_epi32(_mm512_cvttps_epi32(_mm512_max_ps(vlo,zero)),nvm1),L)};
+                    const __m512i rhi{_mm512_srlv_epi32(_mm512_min_epi32(_mm512_cvttps_epi32(_mm512_max_ps(vhi,zero)),nvm1),L)};
+                    const __mmask16 span = lc & _mm512_cmple_epi32_mask(_mm512_sub_epi32(rhi,rlo),i1);
+                    const __m512 H0{ax ? mip_gather_zmm16r4(m,span,L,blk,rlo) : mip_gather_zmm16r4(m,span,L,rlo,blk)};
+                    const __m512 H1{ax ? mip_gather_zmm16r4(m,span,L,blk,rhi) : mip_gather_zmm16r4(m,span,L,rhi,blk)};
+                    skip = span & _mm512_cmp_ps_mask(_mm512_max_ps(H0,H1),_mm512_sub_ps(_mm512_min_ps(pz,pze),tol),_CMP_LE_OQ);
+                    g = _mm512_mask_add_ps(g,skip,ge,sg);
+                    L = _mm512_mask_min_epi32(L,skip,_mm512_add_epi32(L,i1),ltop);
+                    L = _mm512_mask_sub_epi32(L,lc & ~skip,L,i1);
+                 }
+                 if(l0) {
+                    const __mmask16 in = l0 & _mm512_cmp_ps_mask(pv,zero,_CMP_GE_OQ) & _mm512_cmp_ps_mask(pv,fnv,_CMP_LT_OQ);
+                    const __m512i iv{_mm512_cvttps_epi32(_mm512_max_ps(pv,zero))};
+                    const __m512i iff{_mm512_add_epi32(ig,fofs)};
+                    const __m512 Hw{ax ? hmap_gather_zmm16r4(m,in,iw,iv) : hmap_gather_zmm16r4(m,in,iv,iw)};
+                    const __m512 Hf{ax ? hmap_gather_zmm16r4(m,in,iff,iv) : hmap_gather_zmm16r4(m,in,iv,iff)};
+                    cand = in & _mm512_cmp_ps_mask(pz,Hw,_CMP_LT_OQ) & _mm512_cmp_ps_mask(pz,Hf,_CMP_GT_OQ);
+                    fg = _mm512_mask_mov_ps(fg,cand,g);
+                    fv = _mm512_mask_mov_ps(fv,cand,pv);
+                    fz = _mm512_mask_mov_ps(fz,cand,pz);
+                    found |= cand;
+                    const __mmask16 nxt = l0 & ~cand;
+                    g = _mm512_mask_add_ps(g,nxt,g,sg);
+                    L = _mm512_mask_min_epi32(L,nxt,i1,ltop);
+                 }
+                 act &= ~cand;
+                 act &= _mm512_cmp_ps_mask(g,glo,_CMP_GE_OQ) & _mm512_cmp_ps_mask(g,ghi,_CMP_LE_OQ);
+           }
+           // the point is moved off the wall, to the street side
+           const __m512 pu{_mm512_fnmadd_ps(sg,_mm512_set1_ps(1.0e-3f),fg)};
+           const __m512 px{ax ? _mm512_mul_ps(pu,vdx) : _mm512_mul_ps(fv,vdx)};
+           const __m512 py{ax ? _mm512_mul_ps(fv,vdy) : _mm512_mul_ps(pu,vdy)};
+           if(found) found = los_zmm16r4(m,found,tx,ty,tz,px,py,fz,th);
+           if(found) found = los_zmm16r4(m,found,px,py,fz,rx,ry,rz,th);
+           // unfolded path: the image of t across the wall plane
+           const __m512 du{ax ? vdx : vdy};
+           const __m512 tum{_mm512_mul_ps(tu,du)}, rum{_mm512_mul_ps(ru,du)};
+           const __m512 dv{ax ? _mm512_sub_ps(ry,ty) : _mm512_sub_ps(rx,tx)};
+           const __m512 dum{_mm512_sub_ps(rum,_mm512_fmsub_ps(_mm512_set1_ps(2.0f),_mm512_mul_ps(fg,du),tum))};
+           const __m512 dz{_mm512_sub_ps(rz,tz)};
+           r.px[__c]    = px;
+           r.py[__c]    = py;
+           r.pz[__c]    = fz;
+           r.len[__c]   = _mm512_sqrt_ps(_mm512_fmadd_ps(dum,dum,_mm512_fmadd_ps(dv,dv,_mm512_mul_ps(dz,dz))));
+           r.valid[__c] = found;
+       }
+}
+
+
+bool
+gms::radiolocation::urban_los_r4(const UrbanHMapMip_t & m,
+                                 const float * __restrict o,
+                                 const float * __restrict e,
+                                 float * __restrict t_hit) {
+       const double gx0{static_cast<double>(o[0])/m.dx};
+       const double gy0{static_cast<double>(o[1])/m.dy};
+       const double ddx{static_cast<double>(e[0])/m.dx-gx0};
+       const double ddy{static_cast<double>(e[1])/m.dy-gy0};
+       const double ddz{static_cast<double>(e[2])-o[2]};
+       const double inf{std::numeric_limits<double>::infinity()};
+       double t0{0.0}, t1{1.0};
+       const double g0[2] = {gx0,gy0}, dd[2] = {ddx,ddy};
+       const double nn[2] = {static_cast<double>(m.nx),static_cast<double>(m.ny)};
+       for(int32_t __k{0}; __k != 2; ++__k) {
+           if(dd[__k] == 0.0) {
+              if(g0[__k] < 0.0 || g0[__k] > nn[__k]) t1 = -1.0;
+              continue;
+           }
+           const double a{-g0[__k]/dd[__k]};
+           const double b{(nn[__k]-g0[__k])/dd[__k]};
+           t0 = std::max(t0,std::min(a,b));
+           t1 = std::min(t1,std::max(a,b));
+       }
+       *t_hit = 1.0f;
+       if(t0 >= t1) return (true);
+       int32_t ix{std::min(std::max(static_cast<int32_t>(std::floor(gx0+t0*ddx)),0),m.nx-1)};
+       int32_t iy{std::min(std::max(static_cast<int32_t>(std::floor(gy0+t0*ddy)),0),m.ny-1)};
+       const int32_t sx{(ddx > 0.0) ? 1 : -1};
+       const int32_t sy{(ddy > 0.0) ? 1 : -1};
+       double t{t0};
+       for(;;) {
+           const double txe{(ddx == 0.0) ? inf : (ix+(sx > 0 ? 1 : 0)-gx0)/ddx};
+           const double tye{(ddy == 0.0) ? inf : (iy+(sy > 0 ? 1 : 0)-gy0)/ddy};
+           const double te{std::min(std::min(txe,tye),t1)};
+           const double z0{o[2]+t*ddz};
+           const double z1{o[2]+te*ddz};
+           const double H{hmap_at(m,ix,iy)};
+           if(H > std::min(z0,z1)) {
+              *t_hit = static_cast<float>((z0 < H) ? t : (H-o[2])/ddz);
+              return (false);
+           }
+           if(te >= t1) return (true);
+           t = te;
+           if(txe <= tye) ix += sx;
+           else           iy += sy;
+           if(ix < 0 || ix >= m.nx || iy < 0 || iy >= m.ny) return (true);
+       }
+}
+
+
+void
+gms::radiolocation::urban_reflect_r4(const UrbanHMapMip_t & m,
+                                     const float * __restrict t,
+                                     const float * __restrict r,
+                                     const float h_gnd,
+                                     UrbanReflPts_t & pts) {
+       float th;
+       pts.valid = 0U;
+       // Ground
+       {
+          const double a{static_cast<double>(t[2])-h_gnd};
+          const double b{static_cast<double>(r[2])-h_gnd};
+          const double s{a/(a+b)};
+          const float p[3] = {static_cast<float>(t[0]+s*(r[0]-t[0])),
+                              static_cast<float>(t[1]+s*(r[1]-t[1])),
+                              h_gnd+1.0e-2f};
+          pts.p[UREFL__GROUND][0] = p[0];
+          pts.p[UREFL__GROUND][1] = p[1];
+          pts.p[UREFL__GROUND][2] = h_gnd;
+          pts.len[UREFL__GROUND]  = static_cast<float>(std::sqrt((r[0]-t[0])*(r[0]-t[0])+(r[1]-t[1])*(r[1]-t[1])+(a+b)*(a+b)));
+          const double gx{p[0]/m.dx}, gy{p[1]/m.dy};
+          if(a > 0.0 && b > 0.0 && gx >= 0.0 && gx < m.nx && gy >= 0.0 && gy < m.ny &&
+             hmap_at(m,static_cast<int32_t>(gx),static_cast<int32_t>(gy)) <= h_gnd+1.0e-3f &&
+             urban_los_r4(m,t,p,&th) && urban_los_r4(m,p,r,&th)) pts.valid |= 1U << UREFL__GROUND;
+       }
+       // Walls
+       for(int32_t __c{UREFL__WALL_XN}; __c <= UREFL__WALL_YP; ++__c) {
+           const bool ax{__c <= UREFL__WALL_XP};
+           const bool fwd{(__c == UREFL__WALL_XN) || (__c == UREFL__WALL_YN)};
+           const double du{ax ? m.dx : m.dy}, dv{ax ? m.dy : m.dx};
+           const double tu{(ax ? t[0] : t[1])/du}, tv{(ax ? t[1] : t[0])/dv};
+           const double ru{(ax ? r[0] : r[1])/du}, rv{(ax ? r[1] : r[0])/dv};
+           const int32_t nu{ax ? m.nx : m.ny}, nv{ax ? m.ny : m.nx};
+           const int32_t sg{fwd ? 1 : -1};
+           int32_t g{fwd ? static_cast<int32_t>(std::floor(std::max(tu,ru)))+1 :
+                           static_cast<int32_t>(std::ceil(std::min(tu,ru)))-1};
+           bool found{false};
+           double pv{0.0}, pz{0.0};
+           for(; g >= 1 && g <= nu-1; g += sg) {
+               const double s{(g-ru)/(2.0*g-tu-ru)};
+               pv = rv+s*(tv-rv);
+               pz = r[2]+s*(t[2]-r[2]);
+               if(pv < 0.0 || pv >= nv) continue;
+               const int32_t iv{static_cast<int32_t>(pv)};
+               const int32_t iw{fwd ? g : g-1}, iff{fwd ? g-1 : g};
+               const float Hw{ax ? hmap_at(m,iw,iv) : hmap_at(m,iv,iw)};
+               const float Hf{ax ? hmap_at(m,iff,iv) : hmap_at(m,iv,iff)};
+               if(pz < Hw && pz > Hf) {
+                  found = true;
+                  break;
+               }
+           }
+           const double pu{found ? g-sg*1.0e-3 : 0.0};
+           const float p[3] = {static_cast<float>(ax ? pu*du : pv*dv),
+                               static_cast<float>(ax ? pv*dv : pu*du),
+                               static_cast<float>(pz)};
+           pts.p[__c][0] = p[0];
+           pts.p[__c][1] = p[1];
+           pts.p[__c][2] = p[2];
+           const double dum{(ru-(2.0*g-tu))*du}, dvm{(rv-tv)*dv}, dz{static_cast<double>(r[2])-t[2]};
+           pts.len[__c] = static_cast<float>(std::sqrt(dum*dum+dvm*dvm+dz*dz));
+           if(found && urban_los_r4(m,t,p,&th) && urban_los_r4(m,p,r,&th)) pts.valid |= 1U << __c;
+       }
+}
+
+
+void
+gms::radiolocation::urban_los_batch_omp(const UrbanHMapMip_t & m,
+                                        const float * __restrict ox,
+                                        const float * __restrict oy,
+                                        const float * __restrict oz,
+                                        const float * __restrict ex,
+                                        const float * __restrict ey,
+                                        const float * __restrict ez,
+                                        const int32_t n,
+                                        uint8_t * __restrict visible,
+                                        float * __restrict t_hit) {
+       const int32_t nb{(n+15)/16};
+#pragma omp parallel for schedule(dynamic,16) default(none) shared(m,ox,oy,oz,ex,ey,ez,n,visible,t_hit,nb)
+       for(int32_t __b = 0; __b < nb; ++__b) {
+           const int32_t i0{16*__b};
+           const int32_t nl{std::min(16,n-i0)};
+           const __mmask16 k{static_cast<__mmask16>((1U << nl)-1U)};
+           __m512 th;
+           const __mmask16 vis{los_zmm16r4(m,k,_mm512_maskz_loadu_ps(k,&ox[i0]),_mm512_maskz_loadu_ps(k,&oy[i0]),
+                                           _mm512_maskz_loadu_ps(k,&oz[i0]),_mm512_maskz_loadu_ps(k,&ex[i0]),
+                                           _mm512_maskz_loadu_ps(k,&ey[i0]),_mm512_maskz_loadu_ps(k,&ez[i0]),th)};
+           _mm_mask_storeu_epi8(&visible[i0],k,_mm_maskz_mov_epi8(vis,_mm_set1_epi8(1)));
+           if(t_hit != nullptr) _mm512_mask_storeu_ps(&t_hit[i0],k,th);
+       }
+}
+
+
+void
+gms::radiolocation::urban_radar_coverage_omp(const UrbanHMapMip_t & m,
+                                             const float * __restrict radar,
+                                             const float * __restrict rx,
+                                             const float * __restrict ry,
+                                             const float * __restrict rz,
+                                             const int32_t n,
+                                             const float h_gnd,
+                                             uint8_t * __restrict visible,
+                                             UrbanReflPts_t * __restrict refl) {
+       const int32_t nb{(n+15)/16};
+#pragma omp parallel for schedule(dynamic,16) default(none) shared(m,radar,rx,ry,rz,n,h_gnd,visible,refl,nb)
+       for(int32_t __b = 0; __b < nb; ++__b) {
+           const int32_t i0{16*__b};
+           const int32_t nl{std::min(16,n-i0)};
+           const __mmask16 k{static_cast<__mmask16>((1U << nl)-1U)};
+           const __m512 tx{_mm512_set1_ps(radar[0])};
+           const __m512 ty{_mm512_set1_ps(radar[1])};
+           const __m512 tz{_mm512_set1_ps(radar[2])};
+           // tail lanes take the radar position (empty segments)
+           const __m512 vx{_mm512_mask_loadu_ps(tx,k,&rx[i0])};
+           const __m512 vy{_mm512_mask_loadu_ps(ty,k,&ry[i0])};
+           const __m512 vz{_mm512_mask_loadu_ps(tz,k,&rz[i0])};
+           __m512 th;
+           const __mmask16 vis{los_zmm16r4(m,k,tx,ty,tz,vx,vy,vz,th)};
+           _mm_mask_storeu_epi8(&visible[i0],k,_mm_maskz_mov_epi8(vis,_mm_set1_epi8(1)));
+           if(refl != nullptr) {
+              UrbanRefl_zmm16r4_t r;
+              urban_reflect_zmm16r4(m,tx,ty,tz,vx,vy,vz,h_gnd,r);
+              alignas(64) float px[UREFL__COUNT][16], py[UREFL__COUNT][16], pz[UREFL__COUNT][16], pl[UREFL__COUNT][16];
+              for(int32_t __c{0}; __c != UREFL__COUNT; ++__c) {
+                  _mm512_store_ps(px[__c],r.px[__c]);
+                  _mm512_store_ps(py[__c],r.py[__c]);
+                  _mm512_store_ps(pz[__c],r.pz[__c]);
+                  _mm512_store_ps(pl[__c],r.len[__c]);
+              }
+              for(int32_t __k{0}; __k != nl; ++__k) {
+                  UrbanReflPts_t & o{refl[i0+__k]};
+                  o.valid = 0U;
+                  for(int32_t __c{0}; __c != UREFL__COUNT; ++__c) {
+                      o.p[__c][0] = px[__c][__k];
+                      o.p[__c][1] = py[__c][__k];
+                      o.p[__c][2] = pz[__c][__k];
+                      o.len[__c]  = pl[__c][__k];
+                      o.valid    |= ((r.valid[__c] >> __k) & 1U) << __c;
+                  }
+              }
+           }
+       }
+}
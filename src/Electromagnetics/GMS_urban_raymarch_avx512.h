@@ -0,0 +1,213 @@
+#ifndef __GMS_URBAN_RAYMARCH_AVX512_H__
+#define __GMS_URBAN_RAYMARCH_AVX512_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+     const unsigned int GMS_URBAN_RAYMARCH_AVX512_MAJOR = 1U;
+     const unsigned int GMS_URBAN_RAYMARCH_AVX512_MINOR = 0U;
+     const unsigned int GMS_URBAN_RAYMARCH_AVX512_MICRO = 0U;
+     const unsigned int GMS_URBAN_RAYMARCH_AVX512_FULLVER =
+       1000U*GMS_URBAN_RAYMARCH_AVX512_MAJOR+100U*GMS_URBAN_RAYMARCH_AVX512_MINOR+
+       10U*GMS_URBAN_RAYMARCH_AVX512_MICRO;
+     const char * const GMS_URBAN_RAYMARCH_AVX512_CREATION_DATE = "20-10-2026 09:40 AM +00200 (TUE 20 OCT 2026 GMT+2)";
+     const char * const GMS_URBAN_RAYMARCH_AVX512_BUILD_DATE    = __DATE__ " " __TIME__;
+     const char * const GMS_URBAN_RAYMARCH_AVX512_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+     const char * const GMS_URBAN_RAYMARCH_AVX512_SYNOPSIS      = "Urban height map ray marching (max-mipmap), line of sight and first order specular reflections, AVX512.";
+
+}
+
+/*
+     Propagation geometry over an urban height map (building resolution raster,
+     the UHMapR1x_t layout of GMS_urban_adt_stat.h: hmap[iy*nx+ix]).
+     Cell (ix,iy) is the box [ix*dx,(ix+1)*dx) x [iy*dy,(iy+1)*dy) x [-inf,h],
+     world coordinates are meters relative to the map corner, z above the
+     height datum. Space outside of the map is empty.
+     Rays (segments) are marched through a hierarchical max-mipmap: a coarse
+     cell whose maximum lies below the ray is crossed in one step, so open
+     areas and the space above the roofs cost O(log n) steps.
+     The _zmm16r4 kernels march 16 independent rays per register (per-lane
+     mip level and parameter, masked gathers); the _r4 functions are scalar
+     references (plain cell by cell traversal in double precision).
+     First order specular reflections: the ground plane z = h_gnd (street
+     cells only) and the nearest exposed building wall of each of the four
+     wall orientations, found by the image method and kept when both legs
+     are visible.
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include "GMS_config.h"
+
+// Reflection candidates
+#define UREFL__GROUND                 0
+#define UREFL__WALL_XN                1    // wall facing -x (normal -x)
+#define UREFL__WALL_XP                2    // wall facing +x
+#define UREFL__WALL_YN                3    // wall facing -y
+#define UREFL__WALL_YP                4    // wall facing +y
+#define UREFL__COUNT                  5
+
+namespace gms {
+
+        namespace radiolocation {
+
+                /*
+                      Max-mipmap of a height map, level 0 is a copy of the map,
+                      level L holds the maxima of 2^L x 2^L blocks.
+                      All levels live in one 64-byte aligned buffer (32-bit offsets).
+                */
+                typedef struct UrbanHMapMip_t {
+
+                        float *  buf;
+                        int32_t  nx;
+                        int32_t  ny;
+                        float    dx;              // cell size (m)
+                        float    dy;
+                        int32_t  nlev;            // number of levels, <= 16
+                        int32_t  lnx[16];
+                        int32_t  lny[16];
+                        int32_t  base[16];        // level offsets into buf
+                } UrbanHMapMip_t;
+
+                /*
+                      Specular points of one transmitter/receiver pair.
+                */
+                typedef struct UrbanReflPts_t {
+
+                        float    p[UREFL__COUNT][3];   // reflection points (m)
+                        float    len[UREFL__COUNT];    // path length T -> P -> R (m)
+                        uint32_t valid;                // bit c: candidate c exists and both legs are visible
+                } UrbanReflPts_t;
+
+                /*
+                      16 pairs, as above.
+                */
+                typedef struct UrbanRefl_zmm16r4_t {
+
+                        __m512    px[UREFL__COUNT];
+                        __m512    py[UREFL__COUNT];
+                        __m512    pz[UREFL__COUNT];
+                        __m512    len[UREFL__COUNT];
+                        __mmask16 valid[UREFL__COUNT];
+                } UrbanRefl_zmm16r4_t;
+
+                /*
+                      Builds the mipmap (OpenMP over rows).
+                      Returns 0 -- success, 1 -- allocation failure, 2 -- map too large
+                      (more than 16 levels or 2^31 floats in all levels).
+                */
+                int32_t urban_hmap_mip_build(const float * __restrict hmap,
+                                             const int32_t nx,
+                                             const int32_t ny,
+                                             const float dx,
+                                             const float dy,
+                                             UrbanHMapMip_t & m);
+
+                /*
+                      Static urban rasters (UHMapR1x_t<float,nx,ny> and compatible).
+                */
+                template<typename UHMap>
+                inline int32_t urban_hmap_mip_build(const UHMap & um,
+                                                    const float dx,
+                                                    const float dy,
+                                                    UrbanHMapMip_t & m) {
+                        return (urban_hmap_mip_build(&um.hmap[0],UHMap::NX,UHMap::NY,dx,dy,m));
+                }
+
+                void urban_hmap_mip_free(UrbanHMapMip_t & m);
+
+                /*
+                      Line of sight of 16 segments o -> e (m).
+                      Returns the visibility mask, t_hit is the segment parameter of
+                      the first obstruction (1 for visible lanes).
+                */
+                __mmask16 urban_los_zmm16r4(const UrbanHMapMip_t & m,
+                                            const __m512 ox,
+                                            const __m512 oy,
+                                            const __m512 oz,
+                                            const __m512 ex,
+                                            const __m512 ey,
+                                            const __m512 ez,
+                                            __m512 & t_hit);
+
+                /*
+                      First order specular reflections of 16 pairs t -> r (m),
+                      h_gnd -- height of the street level (ground plane).
+                */
+                void urban_reflect_zmm16r4(const UrbanHMapMip_t & m,
+                                           const __m512 tx,
+                                           const __m512 ty,
+                                           const __m512 tz,
+                                           const __m512 rx,
+                                           const __m512 ry,
+                                           const __m512 rz,
+                                           const float h_gnd,
+                                           UrbanRefl_zmm16r4_t & r);
+
+                /*
+                      Scalar references.
+                */
+                bool urban_los_r4(const UrbanHMapMip_t & m,
+                                  const float * __restrict o,
+                                  const float * __restrict e,
+                                  float * __restrict t_hit);
+
+                void urban_reflect_r4(const UrbanHMapMip_t & m,
+                                      const float * __restrict t,
+                                      const float * __restrict r,
+                                      const float h_gnd,
+                                      UrbanReflPts_t & pts);
+
+                /*
+                      Line of sight of n segments (OpenMP over ray packets of 16).
+                      visible[i] = 1 or 0, t_hit may be nullptr.
+                */
+                void urban_los_batch_omp(const UrbanHMapMip_t & m,
+                                         const float * __restrict ox,
+                                         const float * __restrict oy,
+                                         const float * __restrict oz,
+                                         const float * __restrict ex,
+                                         const float * __restrict ey,
+                                         const float * __restrict ez,
+                                         const int32_t n,
+                                         uint8_t * __restrict visible,
+                                         float * __restrict t_hit);
+
+                /*
+                      Radar-to-street coverage: direct visibility of n receivers
+                      from the radar at radar[3] and, if refl != nullptr, their first
+                      order specular reflection points.
+                */
+                void urban_radar_coverage_omp(const UrbanHMapMip_t & m,
+                                              const float * __restrict radar,
+                                              const float * __restrict rx,
+                                              const float * __restrict ry,
+                                              const float * __restrict rz,
+                                              const int32_t n,
+                                              const float h_gnd,
+                                              uint8_t * __restrict visible,
+                                              UrbanReflPts_t * __restrict refl);
+
+        } // radiolocation
+
+} // gms
+
+#endif /*__GMS_URBAN_RAYMARCH_AVX512_H__*/
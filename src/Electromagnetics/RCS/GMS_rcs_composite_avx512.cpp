@@ -0,0 +1,435 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+#include "GMS_rcs_composite_avx512.h"
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+
+namespace {
+
+        constexpr float  PIf   = 3.14159265358979323846f;
+        constexpr double PI    = 3.14159265358979323846;
+        constexpr double EULER = 0.57721566490153286061;
+
+        // ln(x), x > 0 normal: x = m*2^e, m in [0.75,1.5), ln(m) = 2*atanh((m-1)/(m+1)).
+        __attribute__((always_inline))
+        inline __m512 log_zmm16r4(const __m512 x) {
+               const __m512 e{_mm512_getexp_ps(_mm512_mul_ps(x,_mm512_set1_ps(1.33333333333333333f)))};
+               const __m512 m{_mm512_scalef_ps(x,_mm512_sub_ps(_mm512_setzero_ps(),e))};
+               const __m512 t{_mm512_div_ps(_mm512_sub_ps(m,_mm512_set1_ps(1.0f)),
+                                            _mm512_add_ps(m,_mm512_set1_ps(1.0f)))};
+               const __m512 t2{_mm512_mul_ps(t,t)};
+               __m512 p{_mm512_set1_ps(0.222222222222222222f)};
+               p = _mm512_fmadd_ps(p,t2,_mm512_set1_ps(0.285714285714285714f));
+               p = _mm512_fmadd_ps(p,t2,_mm512_set1_ps(0.4f));
+               p = _mm512_fmadd_ps(p,t2,_mm512_set1_ps(0.666666666666666667f));
+               p = _mm512_fmadd_ps(p,t2,_mm512_set1_ps(2.0f));
+               return (_mm512_fmadd_ps(e,_mm512_set1_ps(0.693147180559945309f),_mm512_mul_ps(p,t)));
+        }
+
+        // Sphere, Rayleigh region, Handbook 1, 3.2-5.
+        __attribute__((always_inline))
+        inline __m512 sph_rayleigh_zmm16r4(const __m512 k0a,
+                                           const __m512 a) {
+               const __m512 x2{_mm512_mul_ps(k0a,k0a)};
+               const __m512 x4{_mm512_mul_ps(x2,x2)};
+               const __m512 s{_mm512_fmadd_ps(_mm512_fmsub_ps(_mm512_set1_ps(0.04635116598079561f),x2,
+                                                              _mm512_set1_ps(0.185185185185185185f)),x2,_mm512_set1_ps(1.0f))};
+               return (_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(9.0f*PIf),_mm512_mul_ps(a,a)),_mm512_mul_ps(x4,s)));
+        }
+
+        // Sphere, optics region.
+        __attribute__((always_inline))
+        inline __m512 sph_optics_zmm16r4(const __m512 a) {
+               return (_mm512_mul_ps(_mm512_set1_ps(PIf),_mm512_mul_ps(a,a)));
+        }
+
+        // Cylinder, Rayleigh region, 4.1-19 (E) and 4.1-20 (H).
+        __attribute__((always_inline))
+        inline __m512 cyl_rayleigh_zmm16r4(const __m512 k0a,
+                                           const __m512 a,
+                                           const int32_t pol) {
+               if(pol == RCS_CYL_POL__E) {
+                  const __m512 l{log_zmm16r4(_mm512_mul_ps(_mm512_set1_ps(0.89053626f),k0a))};
+                  const __m512 d{_mm512_mul_ps(k0a,_mm512_fmadd_ps(l,l,_mm512_set1_ps(0.25f*PIf*PIf)))};
+                  return (_mm512_div_ps(_mm512_mul_ps(_mm512_set1_ps(PIf*PIf),a),d));
+               }
+               const __m512 x3{_mm512_mul_ps(_mm512_mul_ps(k0a,k0a),k0a)};
+               return (_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(2.25f*PIf*PIf),a),x3));
+        }
+
+        // Cylinder, optics region, 4.1-38.
+        __attribute__((always_inline))
+        inline __m512 cyl_optics_zmm16r4(const __m512 a) {
+               return (_mm512_mul_ps(_mm512_set1_ps(PIf),a));
+        }
+
+        constexpr int32_t cyl_stack_nmax = 128;
+
+        /*
+            Exact broadside series of the PEC cylinder, 8 lanes of x = k0a (lanes outside
+            of act are dummies), s2 = |SUM eps_n*(-1)^n*c_n|^2, sigma = 4*s2/k0.
+            J_n by Miller's downward recurrence (normalised by J_0 + 2*SUM J_2k = 1),
+            Y_0 and Y_1 by the Neumann series
+                 Y_0 = 2/pi*(ln(x/2)+gamma)*J_0 - 4/pi*SUM (-1)^k*J_2k/k,
+                 Y_1 = -Y_0' = -2/pi*(J_0/x - (ln(x/2)+gamma)*J_1) + 2/pi*SUM (-1)^k*(J_2k-1 - J_2k+1)/k,
+            accumulated during the same downward sweep, Y_n by the upward recurrence.
+        */
+        int32_t cyl_series_zmm8r8(const __m512d x,
+                                  const __mmask8 act,
+                                  const int32_t pol,
+                                  __m512d & s2) {
+               double xs[8], ln2[8], nst[8];
+               const __m512d one{_mm512_set1_pd(1.0)};
+               const __m512d xv{_mm512_mask_mov_pd(one,act,x)};
+               _mm512_storeu_pd(xs,xv);
+               int32_t nmax{0};
+               for(int32_t __i{0}; __i != 8; ++__i) {
+                   const double xi{xs[__i]};
+                   const int32_t ns{((act>>__i)&1) ? static_cast<int32_t>(xi+4.0*std::cbrt(xi)+2.0) : 0};
+                   nst[__i] = static_cast<double>(ns);
+                   ln2[__i] = std::log(0.5*xi)+EULER;
+                   nmax = std::max(nmax,ns);
+               }
+               const int32_t nj{nmax+2};                 // J_0 .. J_nmax+1 kept
+               int32_t M{nmax+static_cast<int32_t>(std::sqrt(400.0*static_cast<double>(nmax+1)))+8};
+               M += (M & 1);
+               __m512d Jst[cyl_stack_nmax];
+               __m512d * __restrict J{Jst};
+               if(nj > cyl_stack_nmax) {
+                  J = reinterpret_cast<__m512d*>(_mm_malloc(static_cast<size_t>(nj)*sizeof(__m512d),64));
+                  if(J == nullptr) return (1);
+               }
+               const __m512d rx{_mm512_div_pd(one,xv)};
+               const __m512d big{_mm512_set1_pd(1.0e+200)};
+               const __m512d small{_mm512_set1_pd(1.0e-200)};
+               __m512d jp{_mm512_setzero_pd()};
+               __m512d j{small};
+               __m512d norm{_mm512_setzero_pd()};
+               __m512d s0{_mm512_setzero_pd()};
+               __m512d s1{_mm512_setzero_pd()};
+               for(int32_t n{M}; n >= 1; --n) {
+                   // j = J_n (unnormalised)
+                   if(n < nj) J[n] = j;
+                   if(n & 1) {
+                      const int32_t k1{(n+1)>>1}, k2{(n-1)>>1};
+                      double c{((k1 & 1) ? -1.0 : 1.0)/static_cast<double>(k1)};
+                      if(k2 >= 1) c -= ((k2 & 1) ? -1.0 : 1.0)/static_cast<double>(k2);
+                      s1 = _mm512_fmadd_pd(_mm512_set1_pd(c),j,s1);
+                   } else {
+                      const int32_t k{n>>1};
+                      norm = _mm512_fmadd_pd(_mm512_set1_pd(2.0),j,norm);
+                      s0   = _mm512_fmadd_pd(_mm512_set1_pd(((k & 1) ? -1.0 : 1.0)/static_cast<double>(k)),j,s0);
+                   }
+                   const __m512d jm{_mm512_fmsub_pd(_mm512_mul_pd(_mm512_set1_pd(2.0*static_cast<double>(n)),rx),j,jp)};
+                   jp = j;
+                   j  = jm;
+                   const __mmask8 ovf{_mm512_cmp_pd_mask(_mm512_abs_pd(j),big,_CMP_GT_OQ)};
+                   if(ovf) {
+                      j    = _mm512_mask_mul_pd(j,ovf,j,small);
+                      jp   = _mm512_mask_mul_pd(jp,ovf,jp,small);
+                      norm = _mm512_mask_mul_pd(norm,ovf,norm,small);
+                      s0   = _mm512_mask_mul_pd(s0,ovf,s0,small);
+                      s1   = _mm512_mask_mul_pd(s1,ovf,s1,small);
+                      for(int32_t __i{n}; __i < nj; ++__i) J[__i] = _mm512_mask_mul_pd(J[__i],ovf,J[__i],small);
+                   }
+               }
+               J[0] = j;
+               norm = _mm512_add_pd(norm,j);
+               const __m512d rn{_mm512_div_pd(one,norm)};
+               for(int32_t __i{0}; __i != nj; ++__i) J[__i] = _mm512_mul_pd(J[__i],rn);
+               s0 = _mm512_mul_pd(s0,rn);
+               s1 = _mm512_mul_pd(s1,rn);
+               const __m512d L{_mm512_loadu_pd(ln2)};
+               const __m512d tpi{_mm512_set1_pd(2.0/PI)};
+               __m512d y0{_mm512_fmsub_pd(_mm512_mul_pd(tpi,L),J[0],_mm512_mul_pd(_mm512_set1_pd(4.0/PI),s0))};
+               __m512d y1{_mm512_fmadd_pd(tpi,s1,_mm512_mul_pd(tpi,_mm512_fmsub_pd(L,J[1],_mm512_mul_pd(J[0],rx))))};
+               const __m512d nsv{_mm512_loadu_pd(nst)};
+               __m512d sr{_mm512_setzero_pd()};
+               __m512d si{_mm512_setzero_pd()};
+               __m512d ym1{_mm512_setzero_pd()};
+               for(int32_t n{0}; n <= nmax; ++n) {
+                   const __m512d fn{_mm512_set1_pd(static_cast<double>(n))};
+                   __m512d cj, cy;
+                   if(pol == RCS_CYL_POL__E) {
+                      cj = J[n];
+                      cy = y0;
+                   } else if(n == 0) {
+                      cj = _mm512_sub_pd(_mm512_setzero_pd(),J[1]);
+                      cy = _mm512_sub_pd(_mm512_setzero_pd(),y1);
+                   } else {
+                      const __m512d nx{_mm512_mul_pd(fn,rx)};
+                      cj = _mm512_fnmadd_pd(nx,J[n],J[n-1]);
+                      cy = _mm512_fnmadd_pd(nx,y0,ym1);
+                   }
+                   // c_n = cj/(cj - i*cy) = cj*(cj + i*cy)/(cj^2 + cy^2)
+                   const __m512d rd{_mm512_div_pd(cj,_mm512_fmadd_pd(cj,cj,_mm512_mul_pd(cy,cy)))};
+                   const double w{(n == 0) ? 1.0 : ((n & 1) ? -2.0 : 2.0)};
+                   const __mmask8 k = act & _mm512_cmp_pd_mask(fn,nsv,_CMP_LE_OQ);
+                   sr = _mm512_mask3_fmadd_pd(_mm512_mul_pd(_mm512_set1_pd(w),cj),rd,sr,k);
+                   si = _mm512_mask3_fmadd_pd(_mm512_mul_pd(_mm512_set1_pd(w),cy),rd,si,k);
+                   // Y_n+1 = 2n/x*Y_n - Y_n-1 (Y_1 is known)
+                   const __m512d yn{(n == 0) ? y1 : _mm512_fmsub_pd(_mm512_mul_pd(_mm512_add_pd(fn,fn),rx),y0,ym1)};
+                   ym1 = y0;
+                   y0  = yn;
+               }
+               if(J != Jst) _mm_free(J);
+               s2 = _mm512_maskz_mov_pd(act,_mm512_fmadd_pd(sr,sr,_mm512_mul_pd(si,si)));
+               return (0);
+        }
+
+        // Cylinder, resonance lanes of 16 (two double halves, empty halves skipped).
+        int32_t cyl_resonance_zmm16r4(const __m512 k0,
+                                      const __m512 a,
+                                      const int32_t pol,
+                                      const __mmask16 res,
+                                      __m512 & sig) {
+               const __m512 k0a{_mm512_mul_ps(k0,a)};
+               __m512d s2[2] = {_mm512_setzero_pd(),_mm512_setzero_pd()};
+               for(int32_t __i{0}; __i != 2; ++__i) {
+                   const __mmask8 h{static_cast<__mmask8>(res >> (8*__i))};
+                   if(h == 0) continue;
+                   const __m256 x{(__i == 0) ? _mm512_castps512_ps256(k0a) :
+                                               _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(k0a),1))};
+                   if(cyl_series_zmm8r8(_mm512_cvtps_pd(x),h,pol,s2[__i])) return (1);
+               }
+               const __m512 s{_mm512_insertf32x8(_mm512_castps256_ps512(_mm512_cvtpd_ps(s2[0])),
+                                                 _mm512_cvtpd_ps(s2[1]),1)};
+               sig = _mm512_maskz_div_ps(res,_mm512_mul_ps(_mm512_set1_ps(4.0f),s),k0);
+               return (0);
+        }
+
+        // Sphere, resonance lanes of 16 (the other lanes enter the Mie kernel as x = 0).
+        int32_t sph_resonance_zmm16r4(const __m512 k0,
+                                      const __m512 a,
+                                      const __mmask16 res,
+                                      __m512 & sig) {
+               __m512 fr, fi;
+               const __m512 z{_mm512_setzero_ps()};
+               return (gms::radiolocation::rcs_mie_sphere_zmm16r4(_mm512_maskz_mov_ps(res,k0),a,z,z,true,
+                                                                  &sig,&fr,&fi,nullptr,nullptr));
+        }
+
+        enum class body_t { sphere, cylinder };
+
+        // Closed form regions of 16 lanes (the resonance lanes are left at zero).
+        __attribute__((always_inline))
+        inline __m512 closed_forms_zmm16r4(const body_t b,
+                                           const __m512 k0a,
+                                           const __m512 a,
+                                           const int32_t pol,
+                                           const __mmask16 ray,
+                                           const __mmask16 opt) {
+               __m512 r{_mm512_setzero_ps()};
+               if(ray) r = _mm512_mask_mov_ps(r,ray,(b == body_t::sphere) ? sph_rayleigh_zmm16r4(k0a,a) :
+                                                                            cyl_rayleigh_zmm16r4(k0a,a,pol));
+               if(opt) r = _mm512_mask_mov_ps(r,opt,(b == body_t::sphere) ? sph_optics_zmm16r4(a) :
+                                                                            cyl_optics_zmm16r4(a));
+               return (r);
+        }
+
+        int32_t composite_zmm16r4(const body_t b,
+                                  const __m512 k0,
+                                  const __m512 a,
+                                  const int32_t pol,
+                                  const gms::radiolocation::RCS_RegionBounds & rb,
+                                  __m512 * __restrict rcs,
+                                  __m512i * __restrict region) {
+               const __m512 k0a{_mm512_mul_ps(k0,a)};
+               __mmask16 ray, res, opt;
+               gms::radiolocation::rcs_region_masks_zmm16r4(k0a,rb,ray,res,opt);
+               __m512 r{closed_forms_zmm16r4(b,k0a,a,pol,ray,opt)};
+               int32_t stat{0};
+               if(res) {
+                  __m512 s;
+                  stat = (b == body_t::sphere) ? sph_resonance_zmm16r4(k0,a,res,s) :
+                                                 cyl_resonance_zmm16r4(k0,a,pol,res,s);
+                  r = _mm512_mask_mov_ps(r,res,s);
+               }
+               *rcs = r;
+               if(region != nullptr) {
+                  __m512i g{_mm512_set1_epi32(-1)};
+                  g = _mm512_mask_mov_epi32(g,ray,_mm512_set1_epi32(RCS_REGION__RAYLEIGH));
+                  g = _mm512_mask_mov_epi32(g,res,_mm512_set1_epi32(RCS_REGION__RESONANCE));
+                  g = _mm512_mask_mov_epi32(g,opt,_mm512_set1_epi32(RCS_REGION__OPTICS));
+                  *region = g;
+               }
+               return (stat);
+        }
+
+        constexpr int32_t resonance_nbins = 4096;
+
+        inline int32_t resonance_bin(const float x) {
+               return (static_cast<int32_t>(std::min(4.0f*x,static_cast<float>(resonance_nbins-1))));
+        }
+
+        int32_t composite_omp(const body_t b,
+                              const float * __restrict k0,
+                              const float * __restrict a,
+                              const int32_t n,
+                              const int32_t pol,
+                              const gms::radiolocation::RCS_RegionBounds & rb,
+                              float * __restrict rcs) {
+               if(n <= 0) return (0);
+               const int32_t nreg{(n+15)/16};
+               if(n < gms::radiolocation::RCS_COMPOSITE_GROUP_MIN) {
+                  int32_t stat{0};
+                  for(int32_t __i{0}; __i != nreg; ++__i) {
+                      const int32_t i0{__i*16};
+                      const __mmask16 k{(n-i0 >= 16) ? __mmask16(0xFFFF) :
+                                                       static_cast<__mmask16>((1U << (n-i0))-1U)};
+                      __m512 r;
+                      stat |= composite_zmm16r4(b,_mm512_maskz_loadu_ps(k,&k0[i0]),_mm512_maskz_loadu_ps(k,&a[i0]),
+                                                pol,rb,&r,nullptr);
+                      _mm512_mask_storeu_ps(&rcs[i0],k,r);
+                  }
+                  return (stat);
+               }
+               // Closed form lanes in place, resonance lanes collected.
+               int32_t * __restrict buf{reinterpret_cast<int32_t*>(_mm_malloc(static_cast<size_t>(2*n+32)*sizeof(int32_t),64))};
+               if(buf == nullptr) return (1);
+               int32_t * __restrict idx{buf};
+               int32_t * __restrict srt{buf+n+16};
+#pragma omp parallel for schedule(static) default(none) shared(k0,a,rcs,rb,n,nreg,pol,b)
+               for(int32_t __i = 0; __i < nreg; ++__i) {
+                   const int32_t i0{__i*16};
+                   const __mmask16 k{(n-i0 >= 16) ? __mmask16(0xFFFF) :
+                                                    static_cast<__mmask16>((1U << (n-i0))-1U)};
+                   const __m512 va{_mm512_maskz_loadu_ps(k,&a[i0])};
+                   const __m512 k0a{_mm512_mul_ps(_mm512_maskz_loadu_ps(k,&k0[i0]),va)};
+                   __mmask16 ray, res, opt;
+                   gms::radiolocation::rcs_region_masks_zmm16r4(k0a,rb,ray,res,opt);
+                   _mm512_mask_storeu_ps(&rcs[i0],k,closed_forms_zmm16r4(b,k0a,va,pol,ray,opt));
+               }
+               int32_t nres{0};
+               const __m512i lane{_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)};
+               for(int32_t i0{0}; i0 < n; i0 += 16) {
+                   const __mmask16 k{(n-i0 >= 16) ? __mmask16(0xFFFF) :
+                                                    static_cast<__mmask16>((1U << (n-i0))-1U)};
+                   const __m512 k0a{_mm512_mul_ps(_mm512_maskz_loadu_ps(k,&k0[i0]),_mm512_maskz_loadu_ps(k,&a[i0]))};
+                   __mmask16 ray, res, opt;
+                   gms::radiolocation::rcs_region_masks_zmm16r4(k0a,rb,ray,res,opt);
+                   _mm512_mask_compressstoreu_epi32(&idx[nres],res,_mm512_add_epi32(lane,_mm512_set1_epi32(i0)));
+                   nres += __builtin_popcount(static_cast<uint32_t>(res));
+               }
+               // The series length of a register follows its largest k0a: counting sort
+               // of the resonance lanes by k0a (bins of 1/4), O(n) and in index order per bin.
+               std::vector<int32_t> cnt(resonance_nbins+1,0);
+               for(int32_t __i{0}; __i != nres; ++__i) ++cnt[resonance_bin(k0[idx[__i]]*a[idx[__i]])+1];
+               for(int32_t __i{1}; __i <= resonance_nbins; ++__i) cnt[__i] += cnt[__i-1];
+               for(int32_t __i{0}; __i != nres; ++__i) srt[cnt[resonance_bin(k0[idx[__i]]*a[idx[__i]])]++] = idx[__i];
+               idx = srt;
+               const int32_t ngrp{(nres+15)/16};
+               int32_t stat{0};
+#pragma omp parallel for schedule(dynamic) default(none) shared(k0,a,rcs,idx,nres,ngrp,pol,b) reduction(|:stat)
+               for(int32_t __i = 0; __i < ngrp; ++__i) {
+                   const int32_t i0{__i*16};
+                   const __mmask16 k{(nres-i0 >= 16) ? __mmask16(0xFFFF) :
+                                                       static_cast<__mmask16>((1U << (nres-i0))-1U)};
+                   const __m512i vi{_mm512_maskz_loadu_epi32(k,&idx[i0])};
+                   const __m512 vk0{_mm512_mask_i32gather_ps(_mm512_setzero_ps(),k,vi,k0,4)};
+                   const __m512 va{_mm512_mask_i32gather_ps(_mm512_setzero_ps(),k,vi,a,4)};
+                   __m512 s;
+                   stat |= (b == body_t::sphere) ? sph_resonance_zmm16r4(vk0,va,k,s) :
+                                                   cyl_resonance_zmm16r4(vk0,va,pol,k,s);
+                   _mm512_mask_i32scatter_ps(rcs,k,vi,s,4);
+               }
+               _mm_free(buf);
+               return (stat);
+        }
+
+}
+
+
+gms::radiolocation::RCS_RegionBounds
+gms::radiolocation::rcs_sphere_region_bounds() {
+       RCS_RegionBounds rb;
+       rb.k0a_rayleigh = 0.4f;
+       rb.k0a_optics   = 20.0f;
+       return (rb);
+}
+
+
+gms::radiolocation::RCS_RegionBounds
+gms::radiolocation::rcs_cylinder_region_bounds() {
+       RCS_RegionBounds rb;
+       rb.k0a_rayleigh = 0.1f;
+       rb.k0a_optics   = 20.0f;
+       return (rb);
+}
+
+
+void
+gms::radiolocation::rcs_region_masks_zmm16r4(const __m512 k0a,
+                                             const RCS_RegionBounds & rb,
+                                             __mmask16 & ray,
+                                             __mmask16 & res,
+                                             __mmask16 & opt) {
+       const __mmask16 valid{_mm512_cmp_ps_mask(k0a,_mm512_setzero_ps(),_CMP_GT_OQ)};
+       ray = valid & _mm512_cmp_ps_mask(k0a,_mm512_set1_ps(rb.k0a_rayleigh),_CMP_LT_OQ);
+       opt = valid & _mm512_cmp_ps_mask(k0a,_mm512_set1_ps(rb.k0a_optics),_CMP_GE_OQ);
+       res = valid & ~(ray | opt);
+}
+
+
+int32_t
+gms::radiolocation::rcs_sphere_composite_zmm16r4(const __m512 k0,
+                                                 const __m512 a,
+                                                 const RCS_RegionBounds & rb,
+                                                 __m512 * __restrict rcs,
+                                                 __m512i * __restrict region) {
+       return (composite_zmm16r4(body_t::sphere,k0,a,RCS_CYL_POL__E,rb,rcs,region));
+}
+
+
+int32_t
+gms::radiolocation::rcs_cylinder_composite_zmm16r4(const __m512 k0,
+                                                   const __m512 a,
+                                                   const int32_t pol,
+                                                   const RCS_RegionBounds & rb,
+                                                   __m512 * __restrict rcs,
+                                                   __m512i * __restrict region) {
+       return (composite_zmm16r4(body_t::cylinder,k0,a,pol,rb,rcs,region));
+}
+
+
+int32_t
+gms::radiolocation::rcs_sphere_composite_omp(const float * __restrict k0,
+                                             const float * __restrict a,
+                                             const int32_t n,
+                                             const RCS_RegionBounds & rb,
+                                             float * __restrict rcs) {
+       return (composite_omp(body_t::sphere,k0,a,n,RCS_CYL_POL__E,rb,rcs));
+}
+
+
+int32_t
+gms::radiolocation::rcs_cylinder_composite_omp(const float * __restrict k0,
+                                               const float * __restrict a,
+                                               const int32_t n,
+                                               const int32_t pol,
+                                               const RCS_RegionBounds & rb,
+                                               float * __restrict rcs) {
+       return (composite_omp(body_t::cylinder,k0,a,n,pol,rb,rcs));
+}
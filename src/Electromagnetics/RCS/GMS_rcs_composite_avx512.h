@@ -0,0 +1,153 @@
+#ifndef __GMS_RCS_COMPOSITE_AVX512_H__
+#define __GMS_RCS_COMPOSITE_AVX512_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_RCS_COMPOSITE_AVX512_MAJOR = 1U;
+    const unsigned int GMS_RCS_COMPOSITE_AVX512_MINOR = 0U;
+    const unsigned int GMS_RCS_COMPOSITE_AVX512_MICRO = 0U;
+    const unsigned int GMS_RCS_COMPOSITE_AVX512_FULLVER =
+      1000U*GMS_RCS_COMPOSITE_AVX512_MAJOR+100U*GMS_RCS_COMPOSITE_AVX512_MINOR+
+      10U*GMS_RCS_COMPOSITE_AVX512_MICRO;
+    const char * const GMS_RCS_COMPOSITE_AVX512_CREATION_DATE = "20-10-2026 17:05 PM +00200 (TUE 20 OCT 2026 GMT+2)";
+    const char * const GMS_RCS_COMPOSITE_AVX512_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_RCS_COMPOSITE_AVX512_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_RCS_COMPOSITE_AVX512_DESCRIPTION   = "Region-aware (Rayleigh/resonance/optics) monostatic RCS of the PEC sphere and circular cylinder, per-lane formula selection.";
+
+}
+
+/*
+     Composite monostatic RCS over the full band: every lane computes its k0a
+     and takes the formula of its region, only the formulas of the regions
+     present in a register are evaluated, the results are blended by masks.
+     Perfectly conducting sphere (RCS, m^2):
+          Rayleigh   k0a <  k0a_rayleigh  -- Handbook 1, 3.2-5,
+                                             9*pi*a^2*(k0a)^4*(1-0.185(k0a)^2+0.0464(k0a)^4),
+          resonance                       -- exact Mie series (GMS_rcs_sphere_mie_avx512),
+          optics     k0a >= k0a_optics    -- pi*a^2.
+     Perfectly conducting infinite circular cylinder, broadside (scattering
+     width per unit length, m), E-field parallel (RCS_CYL_POL__E) or
+     perpendicular (RCS_CYL_POL__H) to the axis:
+          Rayleigh   -- 4.1-19, pi^2*a/(k0a*((pi/2)^2+ln^2(0.8905*k0a))),
+                        4.1-20, 9/4*pi^2*a*(k0a)^3,
+          resonance  -- exact series 4/k0*|SUM (-1)^n*eps_n*J_n/H_n|^2 (E),
+                        J_n'/H_n' (H), Bessel functions by Miller's downward
+                        recurrence, Y_0/Y_1 by the Neumann series (double
+                        precision inside, the region is narrow),
+          optics     -- 4.1-38, pi*a.
+     The resonance lanes of a register share one series, so mixed registers
+     are cheapest when the optics lanes are masked out of it (done here) and
+     the batch drivers group the lanes by region (and the resonance lanes by
+     k0a) before evaluating.
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include "GMS_config.h"
+
+#define RCS_REGION__RAYLEIGH     0
+#define RCS_REGION__RESONANCE    1
+#define RCS_REGION__OPTICS       2
+
+#define RCS_CYL_POL__E           0   // E-field parallel to the cylinder axis (TM)
+#define RCS_CYL_POL__H           1   // H-field parallel to the cylinder axis (TE)
+
+namespace gms {
+
+        namespace radiolocation {
+
+                  /*
+                        Region boundaries in k0a. The defaults keep the closed forms
+                        within about 0.2 dB of the exact solution.
+                  */
+                  typedef struct RCS_RegionBounds {
+
+                          float k0a_rayleigh;     // upper bound of the Rayleigh region
+                          float k0a_optics;       // lower bound of the optics region
+                  } RCS_RegionBounds;
+
+                  RCS_RegionBounds rcs_sphere_region_bounds();
+
+                  RCS_RegionBounds rcs_cylinder_region_bounds();
+
+                  /*
+                        Region masks of 16 lanes (lanes with k0a <= 0 or NaN in none).
+                  */
+                  void rcs_region_masks_zmm16r4(const __m512 k0a,
+                                                const RCS_RegionBounds & rb,
+                                                __mmask16 & ray,
+                                                __mmask16 & res,
+                                                __mmask16 & opt);
+
+                  /*
+                        PEC sphere, radius a (m), wavenumber k0 (rad/m), rcs (m^2),
+                        region -- RCS_REGION__* of every lane (may be nullptr).
+                        Lanes with k0*a <= 0 (or NaN) return 0 (and region -1).
+                        Returns 0 -- success, 1 -- allocation failure (resonance
+                        series longer than the stack workspace).
+                  */
+                  int32_t rcs_sphere_composite_zmm16r4(const __m512 k0,
+                                                       const __m512 a,
+                                                       const RCS_RegionBounds & rb,
+                                                       __m512 * __restrict rcs,
+                                                       __m512i * __restrict region);
+
+                  /*
+                        PEC infinite circular cylinder, broadside backscatter width (m),
+                        pol -- RCS_CYL_POL__E or RCS_CYL_POL__H.
+                  */
+                  int32_t rcs_cylinder_composite_zmm16r4(const __m512 k0,
+                                                         const __m512 a,
+                                                         const int32_t pol,
+                                                         const RCS_RegionBounds & rb,
+                                                         __m512 * __restrict rcs,
+                                                         __m512i * __restrict region);
+
+                  /*
+                        Batches (OpenMP). Below RCS_COMPOSITE_GROUP_MIN elements the
+                        registers are evaluated in order (masked blend). Above it the
+                        closed form lanes are evaluated in place and the resonance lanes
+                        are collected (compress-stored index list), sorted by k0a
+                        (counting sort, bins of 1/4), evaluated with full registers
+                        (gathers) and scattered back.
+                        Returns 0 -- success, 1 -- allocation failure.
+                  */
+                  constexpr int32_t RCS_COMPOSITE_GROUP_MIN = 256;
+
+                  int32_t rcs_sphere_composite_omp(const float * __restrict k0,
+                                                   const float * __restrict a,
+                                                   const int32_t n,
+                                                   const RCS_RegionBounds & rb,
+                                                   float * __restrict rcs);
+
+                  int32_t rcs_cylinder_composite_omp(const float * __restrict k0,
+                                                     const float * __restrict a,
+                                                     const int32_t n,
+                                                     const int32_t pol,
+                                                     const RCS_RegionBounds & rb,
+                                                     float * __restrict rcs);
+
+        } // radiolocation
+
+} // gms
+
+#endif /*__GMS_RCS_COMPOSITE_AVX512_H__*/
@@ -0,0 +1,710 @@
+
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+#include "GMS_rcs_po_facets_bvh_omp.h"
+
+
+namespace {
+
+        using gms::radiolocation::PO_BVH_Node;
+        using gms::radiolocation::PO_Facets;
+
+        // Below this phase span (max-min of the three vertex phases) the facet
+        // integral is evaluated by its Taylor expansion around the mean phase.
+        constexpr double po_taylor_span{1.0e-3};
+
+        struct bvh_build_t {
+
+               std::vector<PO_BVH_Node> nodes;
+               std::vector<int32_t>     idx;
+               std::vector<float>       tb;  // per triangle bounds, min[3],max[3]
+               std::vector<float>       tc;  // per triangle centroid
+        };
+
+        inline float bbox_area(const float * __restrict bmin,
+                               const float * __restrict bmax) {
+               const float dx{bmax[0]-bmin[0]};
+               const float dy{bmax[1]-bmin[1]};
+               const float dz{bmax[2]-bmin[2]};
+               return (dx*dy+dy*dz+dz*dx);
+        }
+
+        inline void bbox_empty(float * __restrict bmin,
+                               float * __restrict bmax) {
+               bmin[0] = bmin[1] = bmin[2] =  3.0e+38f;
+               bmax[0] = bmax[1] = bmax[2] = -3.0e+38f;
+        }
+
+        inline void bbox_grow(float * __restrict bmin,
+                              float * __restrict bmax,
+                              const float * __restrict b) {
+               for(int32_t __k{0}; __k != 3; ++__k) {
+                   bmin[__k] = std::min(bmin[__k],b[__k]);
+                   bmax[__k] = std::max(bmax[__k],b[3+__k]);
+               }
+        }
+
+        /*
+              Binned SAH split of the triangles idx[lo,hi), left child is
+              allocated right after its parent, the parent stores the right child.
+        */
+        int32_t bvh_build_rec(bvh_build_t & ctx,
+                              const int32_t lo,
+                              const int32_t hi) {
+
+               const int32_t node{static_cast<int32_t>(ctx.nodes.size())};
+               ctx.nodes.emplace_back();
+               float bmin[3],bmax[3],cmin[3],cmax[3];
+               bbox_empty(bmin,bmax);
+               bbox_empty(cmin,cmax);
+               for(int32_t __i{lo}; __i != hi; ++__i) {
+                   const int32_t t{ctx.idx[__i]};
+                   bbox_grow(bmin,bmax,&ctx.tb[6*t]);
+                   for(int32_t __k{0}; __k != 3; ++__k) {
+                       cmin[__k] = std::min(cmin[__k],ctx.tc[3*t+__k]);
+                       cmax[__k] = std::max(cmax[__k],ctx.tc[3*t+__k]);
+                   }
+               }
+               PO_BVH_Node & nd{ctx.nodes[node]};
+               std::memcpy(nd.bmin,bmin,sizeof(bmin));
+               std::memcpy(nd.bmax,bmax,sizeof(bmax));
+               const int32_t n{hi-lo};
+               if(n <= PO_BVH_LEAF_MAX) {
+                  nd.first = lo;
+                  nd.count = n;
+                  return node;
+               }
+               int32_t axis{0};
+               for(int32_t __k{1}; __k != 3; ++__k)
+                   if(cmax[__k]-cmin[__k] > cmax[axis]-cmin[axis]) axis = __k;
+               const float ext{cmax[axis]-cmin[axis]};
+               int32_t mid{lo+n/2};
+               if(ext > 0.0f) {
+                  int32_t cnt[PO_BVH_NBINS] = {};
+                  float   bbs[PO_BVH_NBINS][6];
+                  for(int32_t __b{0}; __b != PO_BVH_NBINS; ++__b) bbox_empty(&bbs[__b][0],&bbs[__b][3]);
+                  const float scale{static_cast<float>(PO_BVH_NBINS)*(1.0f-1.0e-6f)/ext};
+                  auto bin = [&](const int32_t t) {
+                       const int32_t b{static_cast<int32_t>((ctx.tc[3*t+axis]-cmin[axis])*scale)};
+                       return std::min(std::max(b,0),PO_BVH_NBINS-1);
+                  };
+                  for(int32_t __i{lo}; __i != hi; ++__i) {
+                      const int32_t t{ctx.idx[__i]};
+                      const int32_t b{bin(t)};
+                      cnt[b] += 1;
+                      bbox_grow(&bbs[b][0],&bbs[b][3],&ctx.tb[6*t]);
+                  }
+                  // right sweep: area and count of the bins [b,NBINS)
+                  float   ra[PO_BVH_NBINS];
+                  int32_t rc[PO_BVH_NBINS];
+                  float   amin[3],amax[3];
+                  bbox_empty(amin,amax);
+                  int32_t acc{0};
+                  for(int32_t __b{PO_BVH_NBINS-1}; __b > 0; --__b) {
+                      acc += cnt[__b];
+                      if(cnt[__b] != 0) bbox_grow(amin,amax,&bbs[__b][0]);
+                      rc[__b] = acc;
+                      ra[__b] = (acc != 0) ? bbox_area(amin,amax) : 0.0f;
+                  }
+                  bbox_empty(amin,amax);
+                  acc = 0;
+                  float   best{3.0e+38f};
+                  int32_t bsplit{-1};
+                  for(int32_t __b{1}; __b != PO_BVH_NBINS; ++__b) {
+                      acc += cnt[__b-1];
+                      if(cnt[__b-1] != 0) bbox_grow(amin,amax,&bbs[__b-1][0]);
+                      if(acc == 0 || rc[__b] == 0) continue;
+                      const float cost{bbox_area(amin,amax)*static_cast<float>(acc)+
+                                       ra[__b]*static_cast<float>(rc[__b])};
+                      if(cost < best) {best = cost; bsplit = __b;}
+                  }
+                  if(bsplit > 0) {
+                     int32_t * __restrict p{ctx.idx.data()};
+                     mid = static_cast<int32_t>(std::partition(p+lo,p+hi,
+                                       [&](const int32_t t) {return bin(t) < bsplit;})-p);
+                  }
+                  if(mid == lo || mid == hi) {
+                     mid = lo+n/2;
+                     int32_t * __restrict p{ctx.idx.data()};
+                     std::nth_element(p+lo,p+mid,p+hi,[&](const int32_t a,const int32_t b) {
+                                      return ctx.tc[3*a+axis] < ctx.tc[3*b+axis];});
+                  }
+               }
+               bvh_build_rec(ctx,lo,mid);
+               const int32_t right{bvh_build_rec(ctx,mid,hi)};
+               ctx.nodes[node].first = right;
+               ctx.nodes[node].count = 0;
+               return node;
+        }
+
+        inline bool ray_tri(const gms::radiolocation::PO_Tri & tr,
+                            const float * __restrict o,
+                            const float * __restrict d,
+                            const float tmin,
+                            const float tmax) {
+               // Moller-Trumbore
+               const float px{d[1]*tr.e2[2]-d[2]*tr.e2[1]};
+               const float py{d[2]*tr.e2[0]-d[0]*tr.e2[2]};
+               const float pz{d[0]*tr.e2[1]-d[1]*tr.e2[0]};
+               const float det{tr.e1[0]*px+tr.e1[1]*py+tr.e1[2]*pz};
+               if(std::fabs(det) < 1.0e-20f) return false;
+               const float idet{1.0f/det};
+               const float sx{o[0]-tr.v0[0]};
+               const float sy{o[1]-tr.v0[1]};
+               const float sz{o[2]-tr.v0[2]};
+               const float u{(sx*px+sy*py+sz*pz)*idet};
+               if(u < 0.0f || u > 1.0f) return false;
+               const float qx{sy*tr.e1[2]-sz*tr.e1[1]};
+               const float qy{sz*tr.e1[0]-sx*tr.e1[2]};
+               const float qz{sx*tr.e1[1]-sy*tr.e1[0]};
+               const float v{(d[0]*qx+d[1]*qy+d[2]*qz)*idet};
+               if(v < 0.0f || u+v > 1.0f) return false;
+               const float t{(tr.e2[0]*qx+tr.e2[1]*qy+tr.e2[2]*qz)*idet};
+               return (t > tmin && t < tmax);
+        }
+
+#if defined(__AVX512F__)
+
+        /*
+              sin/cos of 8 doubles: Cody-Waite reduction by pi/2 (3 parts),
+              Cephes minimax polynomials on [-pi/4,pi/4].
+              Accurate to ~1 ulp for |x| < 2^30.
+        */
+        __attribute__((always_inline))
+        inline void sincos_zmm8r8(const __m512d x,
+                                  __m512d & s,
+                                  __m512d & c) {
+               const __m512d DP1{_mm512_set1_pd(1.5707962512969970703125)};
+               const __m512d DP2{_mm512_set1_pd(7.54978941586159635335e-08)};
+               const __m512d DP3{_mm512_set1_pd(5.39030285815811905290e-15)};
+               const __m512d q{_mm512_roundscale_pd(_mm512_mul_pd(x,_mm512_set1_pd(0.63661977236758134307553505349)),
+                                                    _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC)};
+               __m512d r{_mm512_fnmadd_pd(q,DP1,x)};
+               r = _mm512_fnmadd_pd(q,DP2,r);
+               r = _mm512_fnmadd_pd(q,DP3,r);
+               const __m512d z{_mm512_mul_pd(r,r)};
+               __m512d ps{_mm512_set1_pd(1.58962301576546568060E-10)};
+               ps = _mm512_fmadd_pd(ps,z,_mm512_set1_pd(-2.50507477628578072866E-8));
+               ps = _mm512_fmadd_pd(ps,z,_mm512_set1_pd(2.75573136213857245213E-6));
+               ps = _mm512_fmadd_pd(ps,z,_mm512_set1_pd(-1.98412698295895385996E-4));
+               ps = _mm512_fmadd_pd(ps,z,_mm512_set1_pd(8.33333333332211858878E-3));
+               ps = _mm512_fmadd_pd(ps,z,_mm512_set1_pd(-1.66666666666666307295E-1));
+               const __m512d sr{_mm512_fmadd_pd(_mm512_mul_pd(r,z),ps,r)};
+               __m512d pc{_mm512_set1_pd(-1.13585365213876817300E-11)};
+               pc = _mm512_fmadd_pd(pc,z,_mm512_set1_pd(2.08757008419747316778E-9));
+               pc = _mm512_fmadd_pd(pc,z,_mm512_set1_pd(-2.75573141792967388112E-7));
+               pc = _mm512_fmadd_pd(pc,z,_mm512_set1_pd(2.48015872888517045348E-5));
+               pc = _mm512_fmadd_pd(pc,z,_mm512_set1_pd(-1.38888888888730564116E-3));
+               pc = _mm512_fmadd_pd(pc,z,_mm512_set1_pd(4.16666666666665929218E-2));
+               const __m512d cr{_mm512_fmadd_pd(_mm512_mul_pd(z,z),pc,
+                                                _mm512_fnmadd_pd(_mm512_set1_pd(0.5),z,_mm512_set1_pd(1.0)))};
+               const __m512i qi{_mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(q))};
+               const __mmask8 swp{_mm512_test_epi64_mask(qi,_mm512_set1_epi64(1LL))};
+               const __mmask8 sns{_mm512_test_epi64_mask(qi,_mm512_set1_epi64(2LL))};
+               const __mmask8 cns{_mm512_test_epi64_mask(_mm512_add_epi64(qi,_mm512_set1_epi64(1LL)),
+                                                         _mm512_set1_epi64(2LL))};
+               const __m512d s0{_mm512_mask_blend_pd(swp,sr,cr)};
+               const __m512d c0{_mm512_mask_blend_pd(swp,cr,sr)};
+               const __m512d zero{_mm512_setzero_pd()};
+               s = _mm512_mask_sub_pd(s0,sns,zero,s0);
+               c = _mm512_mask_sub_pd(c0,cns,zero,c0);
+        }
+
+        // sin(x)/x
+        __attribute__((always_inline))
+        inline __m512d sinc_zmm8r8(const __m512d x) {
+               __m512d s,c;
+               sincos_zmm8r8(x,s,c);
+               const __mmask8 tiny{_mm512_cmp_pd_mask(_mm512_abs_pd(x),_mm512_set1_pd(1.0e-8),_CMP_LT_OQ)};
+               const __m512d one{_mm512_set1_pd(1.0)};
+               return (_mm512_mask_blend_pd(tiny,_mm512_div_pd(s,_mm512_mask_blend_pd(tiny,x,one)),one));
+        }
+
+        /*
+              Any-hit traversal of a packet of up to 16 shadow rays of one aspect:
+              common direction d, origins (ox,oy,oz), lane i skips its own facet ids[i].
+              Returns the occluded lanes.
+        */
+        __mmask16 occluded_zmm16r4(const PO_Facets & f,
+                                   const __m512 ox,
+                                   const __m512 oy,
+                                   const __m512 oz,
+                                   const __m512i ids,
+                                   const float * __restrict d,
+                                   const __mmask16 lanes) {
+               float inv[3];
+               for(int32_t __k{0}; __k != 3; ++__k)
+                   inv[__k] = (std::fabs(d[__k]) > 1.0e-30f) ? 1.0f/d[__k] : std::copysign(1.0e+30f,d[__k]);
+               const __m512 ix{_mm512_set1_ps(inv[0])};
+               const __m512 iy{_mm512_set1_ps(inv[1])};
+               const __m512 iz{_mm512_set1_ps(inv[2])};
+               const __m512 dx{_mm512_set1_ps(d[0])};
+               const __m512 dy{_mm512_set1_ps(d[1])};
+               const __m512 dz{_mm512_set1_ps(d[2])};
+               const __m512 zero{_mm512_setzero_ps()};
+               const __m512 one{_mm512_set1_ps(1.0f)};
+               const PO_BVH_Node * __restrict nodes{f.nodes};
+               const gms::radiolocation::PO_Tri * __restrict tris{f.tris};
+               __mmask16 active{lanes};
+               __mmask16 occ{0};
+               int32_t stack[64];
+               int32_t sp{0};
+               int32_t node{0};
+               while(true) {
+                     const PO_BVH_Node & nd{nodes[node]};
+                     __m512 ta{_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmin[0]),ox),ix)};
+                     __m512 tb{_mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmax[0]),ox),ix)};
+                     __m512 t0{_mm512_max_ps(zero,_mm512_min_ps(ta,tb))};
+                     __m512 t1{_mm512_max_ps(ta,tb)};
+                     ta = _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmin[1]),oy),iy);
+                     tb = _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmax[1]),oy),iy);
+                     t0 = _mm512_max_ps(t0,_mm512_min_ps(ta,tb));
+                     t1 = _mm512_min_ps(t1,_mm512_max_ps(ta,tb));
+                     ta = _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmin[2]),oz),iz);
+                     tb = _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(nd.bmax[2]),oz),iz);
+                     t0 = _mm512_max_ps(t0,_mm512_min_ps(ta,tb));
+                     t1 = _mm512_min_ps(t1,_mm512_max_ps(ta,tb));
+                     const __mmask16 hit{_mm512_mask_cmp_ps_mask(active,t0,t1,_CMP_LE_OQ)};
+                     if(hit != 0) {
+                        if(nd.count != 0) {
+                           for(int32_t __i{nd.first}; __i != nd.first+nd.count; ++__i) {
+                               // Moller-Trumbore, d x e2 and the determinant are common to the packet
+                               const gms::radiolocation::PO_Tri & tr{tris[__i]};
+                               const float px{d[1]*tr.e2[2]-d[2]*tr.e2[1]};
+                               const float py{d[2]*tr.e2[0]-d[0]*tr.e2[2]};
+                               const float pz{d[0]*tr.e2[1]-d[1]*tr.e2[0]};
+                               const float det{tr.e1[0]*px+tr.e1[1]*py+tr.e1[2]*pz};
+                               if(std::fabs(det) < 1.0e-20f) continue;
+                               const __m512 idet{_mm512_set1_ps(1.0f/det)};
+                               const __m512 sx{_mm512_sub_ps(ox,_mm512_set1_ps(tr.v0[0]))};
+                               const __m512 sy{_mm512_sub_ps(oy,_mm512_set1_ps(tr.v0[1]))};
+                               const __m512 sz{_mm512_sub_ps(oz,_mm512_set1_ps(tr.v0[2]))};
+                               const __m512 u{_mm512_mul_ps(_mm512_fmadd_ps(sz,_mm512_set1_ps(pz),
+                                              _mm512_fmadd_ps(sy,_mm512_set1_ps(py),
+                                              _mm512_mul_ps(sx,_mm512_set1_ps(px)))),idet)};
+                               __mmask16 m{_mm512_mask_cmp_ps_mask(hit,u,zero,_CMP_GE_OQ)};
+                               m = _mm512_mask_cmp_ps_mask(m,u,one,_CMP_LE_OQ);
+                               if(m == 0) continue;
+                               const __m512 e1x{_mm512_set1_ps(tr.e1[0])};
+                               const __m512 e1y{_mm512_set1_ps(tr.e1[1])};
+                               const __m512 e1z{_mm512_set1_ps(tr.e1[2])};
+                               const __m512 qx{_mm512_fmsub_ps(sy,e1z,_mm512_mul_ps(sz,e1y))};
+                               const __m512 qy{_mm512_fmsub_ps(sz,e1x,_mm512_mul_ps(sx,e1z))};
+                               const __m512 qz{_mm512_fmsub_ps(sx,e1y,_mm512_mul_ps(sy,e1x))};
+                               const __m512 v{_mm512_mul_ps(_mm512_fmadd_ps(dz,qz,
+                                              _mm512_fmadd_ps(dy,qy,_mm512_mul_ps(dx,qx))),idet)};
+                               const __m512 t{_mm512_mul_ps(_mm512_fmadd_ps(_mm512_set1_ps(tr.e2[2]),qz,
+                                              _mm512_fmadd_ps(_mm512_set1_ps(tr.e2[1]),qy,
+                                              _mm512_mul_ps(_mm512_set1_ps(tr.e2[0]),qx))),idet)};
+                               m = _mm512_mask_cmp_ps_mask(m,v,zero,_CMP_GE_OQ);
+                               m = _mm512_mask_cmp_ps_mask(m,_mm512_add_ps(u,v),one,_CMP_LE_OQ);
+                               m = _mm512_mask_cmp_ps_mask(m,t,zero,_CMP_GT_OQ);
+                               m = _mm512_mask_cmpneq_epi32_mask(m,ids,_mm512_set1_epi32(__i));
+                               occ    |= m;
+                               active &= static_cast<__mmask16>(~m);
+                           }
+                           if(active == 0) break;
+                        }
+                        else {
+                           stack[sp++] = nd.first;
+                           node += 1;
+                           continue;
+                        }
+                     }
+                     if(sp == 0) break;
+                     node = stack[--sp];
+               }
+               return occ;
+        }
+
+#endif
+
+}
+
+
+bool
+gms::radiolocation::po_facets_build(const double * __restrict xs,
+                                    const double * __restrict ys,
+                                    const double * __restrict zs,
+                                    const int32_t * __restrict tri_node,
+                                    const int32_t ntri,
+                                    const int32_t ntri_stride,
+                                    const int32_t base,
+                                    PO_Facets & f) {
+
+       std::memset(&f,0,sizeof(f));
+       if(__builtin_expect(ntri<=0,0)) return false;
+       const int32_t nfp{(ntri+7)&~7};
+       const std::size_t dbytes{static_cast<std::size_t>(nfp)*sizeof(double)};
+       double * __restrict * const soa[13] = {&f.p0x,&f.p0y,&f.p0z,&f.e1x,&f.e1y,&f.e1z,
+                                  &f.e2x,&f.e2y,&f.e2z,&f.nx,&f.ny,&f.nz,&f.area};
+       bool ok{true};
+       for(int32_t __k{0}; __k != 13; ++__k) {
+           *soa[__k] = reinterpret_cast<double*>(_mm_malloc(dbytes,64ULL));
+           ok = ok && (*soa[__k] != nullptr);
+       }
+       f.perm = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(ntri)*sizeof(int32_t),64ULL));
+       f.tris = reinterpret_cast<PO_Tri*>(_mm_malloc(static_cast<std::size_t>(ntri)*sizeof(PO_Tri),64ULL));
+       if(!ok || f.perm == nullptr || f.tris == nullptr) {
+          po_facets_free(f);
+          return false;
+       }
+       f.nf  = ntri;
+       f.nfp = nfp;
+       bvh_build_t ctx;
+       ctx.idx.resize(ntri);
+       ctx.tb.resize(6ull*ntri);
+       ctx.tc.resize(3ull*ntri);
+       float smin[3],smax[3];
+       bbox_empty(smin,smax);
+       for(int32_t __t{0}; __t != ntri; ++__t) {
+           ctx.idx[__t] = __t;
+           float * __restrict b{&ctx.tb[6ull*__t]};
+           bbox_empty(&b[0],&b[3]);
+           for(int32_t __v{0}; __v != 3; ++__v) {
+               const int32_t j{tri_node[static_cast<std::size_t>(ntri_stride)*__t+__v]-base};
+               const float p[6] = {static_cast<float>(xs[j]),static_cast<float>(ys[j]),static_cast<float>(zs[j]),
+                                   static_cast<float>(xs[j]),static_cast<float>(ys[j]),static_cast<float>(zs[j])};
+               bbox_grow(&b[0],&b[3],p);
+           }
+           for(int32_t __k{0}; __k != 3; ++__k)
+               ctx.tc[3ull*__t+__k] = 0.5f*(b[__k]+b[3+__k]);
+           bbox_grow(smin,smax,b);
+       }
+       ctx.nodes.reserve(2ull*static_cast<std::size_t>(ntri)/std::max(1,PO_BVH_LEAF_MAX/2)+1ull);
+       bvh_build_rec(ctx,0,ntri);
+       f.nnodes = static_cast<int32_t>(ctx.nodes.size());
+       f.nodes  = reinterpret_cast<PO_BVH_Node*>(_mm_malloc(ctx.nodes.size()*sizeof(PO_BVH_Node),64ULL));
+       if(f.nodes == nullptr) {
+          po_facets_free(f);
+          return false;
+       }
+       std::memcpy(f.nodes,ctx.nodes.data(),ctx.nodes.size()*sizeof(PO_BVH_Node));
+       const float dx{smax[0]-smin[0]};
+       const float dy{smax[1]-smin[1]};
+       const float dz{smax[2]-smin[2]};
+       f.ray_eps = 1.0e-5f*std::sqrt(dx*dx+dy*dy+dz*dz);
+       const int32_t * __restrict idx{ctx.idx.data()};
+       // Facets in the BVH leaf order.
+#pragma omp parallel for schedule(static) default(none) \
+        shared(f,idx,xs,ys,zs,tri_node,ntri,ntri_stride,base)
+       for(int32_t __i = 0; __i < ntri; ++__i) {
+           const int32_t t{idx[__i]};
+           const std::size_t e{static_cast<std::size_t>(ntri_stride)*t};
+           const int32_t j0{tri_node[e+0]-base};
+           const int32_t j1{tri_node[e+1]-base};
+           const int32_t j2{tri_node[e+2]-base};
+           const double ax{xs[j1]-xs[j0]}, ay{ys[j1]-ys[j0]}, az{zs[j1]-zs[j0]};
+           const double bx{xs[j2]-xs[j0]}, by{ys[j2]-ys[j0]}, bz{zs[j2]-zs[j0]};
+           const double cx{ay*bz-az*by};
+           const double cy{az*bx-ax*bz};
+           const double cz{ax*by-ay*bx};
+           const double cn{std::sqrt(cx*cx+cy*cy+cz*cz)};
+           const double icn{(cn > 0.0) ? 1.0/cn : 0.0};
+           f.perm[__i] = t;
+           f.p0x[__i] = xs[j0]; f.p0y[__i] = ys[j0]; f.p0z[__i] = zs[j0];
+           f.e1x[__i] = ax;     f.e1y[__i] = ay;     f.e1z[__i] = az;
+           f.e2x[__i] = bx;     f.e2y[__i] = by;     f.e2z[__i] = bz;
+           f.nx[__i]  = cx*icn; f.ny[__i]  = cy*icn; f.nz[__i]  = cz*icn;
+           f.area[__i] = 0.5*cn;
+           PO_Tri & tr{f.tris[__i]};
+           tr.v0[0] = static_cast<float>(xs[j0]);
+           tr.v0[1] = static_cast<float>(ys[j0]);
+           tr.v0[2] = static_cast<float>(zs[j0]);
+           tr.e1[0] = static_cast<float>(ax); tr.e1[1] = static_cast<float>(ay); tr.e1[2] = static_cast<float>(az);
+           tr.e2[0] = static_cast<float>(bx); tr.e2[1] = static_cast<float>(by); tr.e2[2] = static_cast<float>(bz);
+       }
+       for(int32_t __i{ntri}; __i != nfp; ++__i) {
+           for(int32_t __k{0}; __k != 13; ++__k) (*soa[__k])[__i] = 0.0;
+       }
+       return true;
+}
+
+
+void
+gms::radiolocation::po_facets_free(PO_Facets & f) {
+
+       double * __restrict * const soa[13] = {&f.p0x,&f.p0y,&f.p0z,&f.e1x,&f.e1y,&f.e1z,
+                                  &f.e2x,&f.e2y,&f.e2z,&f.nx,&f.ny,&f.nz,&f.area};
+       for(int32_t __k{0}; __k != 13; ++__k) {
+           if(*soa[__k] != nullptr) _mm_free(*soa[__k]);
+           *soa[__k] = nullptr;
+       }
+       if(f.perm  != nullptr) _mm_free(f.perm);
+       if(f.tris  != nullptr) _mm_free(f.tris);
+       if(f.nodes != nullptr) _mm_free(f.nodes);
+       f.perm  = nullptr;
+       f.tris  = nullptr;
+       f.nodes = nullptr;
+       f.nf = f.nfp = f.nnodes = 0;
+}
+
+
+bool
+gms::radiolocation::po_ray_occluded(const PO_Facets & f,
+                                    const float * __restrict org,
+                                    const float * __restrict dir,
+                                    const float tmin,
+                                    const float tmax,
+                                    const int32_t skip) {
+
+       float inv[3];
+       for(int32_t __k{0}; __k != 3; ++__k)
+           inv[__k] = (std::fabs(dir[__k]) > 1.0e-30f) ? 1.0f/dir[__k] : std::copysign(1.0e+30f,dir[__k]);
+       int32_t stack[64];
+       int32_t sp{0};
+       int32_t node{0};
+       const PO_BVH_Node * __restrict nodes{f.nodes};
+       const PO_Tri      * __restrict tris{f.tris};
+       while(true) {
+             const PO_BVH_Node & nd{nodes[node]};
+             float t0{tmin}, t1{tmax};
+             for(int32_t __k{0}; __k != 3; ++__k) {
+                 const float ta{(nd.bmin[__k]-org[__k])*inv[__k]};
+                 const float tb{(nd.bmax[__k]-org[__k])*inv[__k]};
+                 t0 = std::max(t0,std::min(ta,tb));
+                 t1 = std::min(t1,std::max(ta,tb));
+             }
+             if(t0 <= t1) {
+                if(nd.count != 0) {
+                   for(int32_t __i{nd.first}; __i != nd.first+nd.count; ++__i) {
+                       if(__i != skip && ray_tri(tris[__i],org,dir,tmin,tmax)) return true;
+                   }
+                }
+                else {
+                   stack[sp++] = nd.first;
+                   node += 1;
+                   continue;
+                }
+             }
+             if(sp == 0) break;
+             node = stack[--sp];
+       }
+       return false;
+}
+
+
+void
+gms::radiolocation::po_facets_integral(const PO_Facets & f,
+                                       const double * __restrict w,
+                                       const double rx,
+                                       const double ry,
+                                       const double rz,
+                                       const double k0,
+                                       double & Ire,
+                                       double & Iim) {
+
+       const double k2{2.0*k0};
+#if defined(__AVX512F__)
+       const __m512d wx{_mm512_set1_pd(k2*rx)};
+       const __m512d wy{_mm512_set1_pd(k2*ry)};
+       const __m512d wz{_mm512_set1_pd(k2*rz)};
+       const __m512d zero{_mm512_setzero_pd()};
+       const __m512d half{_mm512_set1_pd(0.5)};
+       const __m512d third{_mm512_set1_pd(0.333333333333333333333333333333)};
+       const __m512d c48{_mm512_set1_pd(0.020833333333333333333333333333)};
+       const __m512d two{_mm512_set1_pd(2.0)};
+       const __m512d tspan{_mm512_set1_pd(po_taylor_span)};
+       __m512d acc_re{zero};
+       __m512d acc_im{zero};
+       for(int32_t __i{0}; __i != f.nfp; __i += 8) {
+           const __m512d W{_mm512_load_pd(&w[__i])};
+           if(_mm512_cmp_pd_mask(W,zero,_CMP_NEQ_OQ) == 0) continue;
+           const __m512d ph0{_mm512_fmadd_pd(wz,_mm512_load_pd(&f.p0z[__i]),
+                             _mm512_fmadd_pd(wy,_mm512_load_pd(&f.p0y[__i]),
+                             _mm512_mul_pd(wx,_mm512_load_pd(&f.p0x[__i]))))};
+           const __m512d al{_mm512_fmadd_pd(wz,_mm512_load_pd(&f.e1z[__i]),
+                            _mm512_fmadd_pd(wy,_mm512_load_pd(&f.e1y[__i]),
+                            _mm512_mul_pd(wx,_mm512_load_pd(&f.e1x[__i]))))};
+           const __m512d be{_mm512_fmadd_pd(wz,_mm512_load_pd(&f.e2z[__i]),
+                            _mm512_fmadd_pd(wy,_mm512_load_pd(&f.e2y[__i]),
+                            _mm512_mul_pd(wx,_mm512_load_pd(&f.e2x[__i]))))};
+           // vertex phases {0,al,be} sorted: a <= b <= c
+           const __m512d a{_mm512_min_pd(zero,_mm512_min_pd(al,be))};
+           const __m512d c{_mm512_max_pd(zero,_mm512_max_pd(al,be))};
+           const __m512d b{_mm512_sub_pd(_mm512_sub_pd(_mm512_add_pd(al,be),a),c)};
+           const __m512d span{_mm512_sub_pd(c,a)};
+           const __mmask8 small{_mm512_cmp_pd_mask(span,tspan,_CMP_LT_OQ)};
+           // F = -(g[b,c]-g[a,b])/(c-a), g[x,y] = j*exp(j(x+y)/2)*sinc((y-x)/2)
+           const __m512d s1{sinc_zmm8r8(_mm512_mul_pd(half,_mm512_sub_pd(b,a)))};
+           const __m512d s2{sinc_zmm8r8(_mm512_mul_pd(half,_mm512_sub_pd(c,b)))};
+           __m512d sn1,cs1,sn2,cs2;
+           sincos_zmm8r8(_mm512_fmadd_pd(half,_mm512_add_pd(a,b),ph0),sn1,cs1);
+           sincos_zmm8r8(_mm512_fmadd_pd(half,_mm512_add_pd(b,c),ph0),sn2,cs2);
+           const __m512d Dre{_mm512_fmsub_pd(cs2,s2,_mm512_mul_pd(cs1,s1))};
+           const __m512d Dim{_mm512_fmsub_pd(sn2,s2,_mm512_mul_pd(sn1,s1))};
+           const __m512d ispan{_mm512_div_pd(_mm512_set1_pd(1.0),_mm512_mask_blend_pd(small,span,_mm512_set1_pd(1.0)))};
+           __m512d Gre{_mm512_mul_pd(Dim,ispan)};
+           __m512d Gim{_mm512_sub_pd(zero,_mm512_mul_pd(Dre,ispan))};
+           if(small != 0) {
+              // F ~ exp(jm)*(1/2 - SUM(d_i^2)/48), m -- mean phase, d_i -- deviations
+              const __m512d m{_mm512_mul_pd(_mm512_add_pd(al,be),third)};
+              const __m512d d1{_mm512_sub_pd(al,m)};
+              const __m512d d2{_mm512_sub_pd(be,m)};
+              const __m512d sd{_mm512_fmadd_pd(m,m,_mm512_fmadd_pd(d1,d1,_mm512_mul_pd(d2,d2)))};
+              const __m512d q{_mm512_fnmadd_pd(sd,c48,half)};
+              __m512d snm,csm;
+              sincos_zmm8r8(_mm512_add_pd(ph0,m),snm,csm);
+              Gre = _mm512_mask_blend_pd(small,Gre,_mm512_mul_pd(csm,q));
+              Gim = _mm512_mask_blend_pd(small,Gim,_mm512_mul_pd(snm,q));
+           }
+           const __m512d sc{_mm512_mul_pd(two,_mm512_mul_pd(_mm512_load_pd(&f.area[__i]),W))};
+           acc_re = _mm512_fmadd_pd(sc,Gre,acc_re);
+           acc_im = _mm512_fmadd_pd(sc,Gim,acc_im);
+       }
+       Ire = _mm512_reduce_add_pd(acc_re);
+       Iim = _mm512_reduce_add_pd(acc_im);
+#else
+       const double wx{k2*rx};
+       const double wy{k2*ry};
+       const double wz{k2*rz};
+       double acc_re{0.0};
+       double acc_im{0.0};
+       auto sinc = [](const double x) {
+            return (std::fabs(x) < 1.0e-8) ? 1.0 : std::sin(x)/x;
+       };
+       for(int32_t __i{0}; __i != f.nf; ++__i) {
+           const double W{w[__i]};
+           if(W == 0.0) continue;
+           const double ph0{wx*f.p0x[__i]+wy*f.p0y[__i]+wz*f.p0z[__i]};
+           const double al{wx*f.e1x[__i]+wy*f.e1y[__i]+wz*f.e1z[__i]};
+           const double be{wx*f.e2x[__i]+wy*f.e2y[__i]+wz*f.e2z[__i]};
+           const double a{std::min(0.0,std::min(al,be))};
+           const double c{std::max(0.0,std::max(al,be))};
+           const double b{al+be-a-c};
+           const double span{c-a};
+           double Gre,Gim;
+           if(span < po_taylor_span) {
+              const double m{(al+be)*0.333333333333333333333333333333};
+              const double d1{al-m};
+              const double d2{be-m};
+              const double q{0.5-(m*m+d1*d1+d2*d2)*0.020833333333333333333333333333};
+              Gre = std::cos(ph0+m)*q;
+              Gim = std::sin(ph0+m)*q;
+           }
+           else {
+              const double s1{sinc(0.5*(b-a))};
+              const double s2{sinc(0.5*(c-b))};
+              const double t1{ph0+0.5*(a+b)};
+              const double t2{ph0+0.5*(b+c)};
+              const double Dre{std::cos(t2)*s2-std::cos(t1)*s1};
+              const double Dim{std::sin(t2)*s2-std::sin(t1)*s1};
+              Gre =  Dim/span;
+              Gim = -Dre/span;
+           }
+           const double sc{2.0*f.area[__i]*W};
+           acc_re += sc*Gre;
+           acc_im += sc*Gim;
+       }
+       Ire = acc_re;
+       Iim = acc_im;
+#endif
+}
+
+
+void
+gms::radiolocation::po_rcs_monostatic_omp(const PO_Facets & f,
+                                          const double * __restrict theta,
+                                          const double * __restrict phi,
+                                          const int32_t naspects,
+                                          const double k0,
+                                          const bool shadowing,
+                                          const bool two_sided,
+                                          double * __restrict rcs) {
+
+       if(__builtin_expect(naspects<=0,0)) return;
+       const double ck{k0*k0*0.318309886183790671537767526745};
+       const int32_t nf{f.nf};
+       const int32_t nfp{f.nfp};
+#pragma omp parallel default(none) \
+        shared(f,theta,phi,naspects,k0,shadowing,two_sided,rcs,ck,nf,nfp)
+       {
+            double * __restrict w{reinterpret_cast<double*>(
+                                  _mm_malloc(static_cast<std::size_t>(nfp)*sizeof(double),64ULL))};
+            int32_t * __restrict cand{reinterpret_cast<int32_t*>(
+                                  _mm_malloc(static_cast<std::size_t>(nfp)*sizeof(int32_t),64ULL))};
+            for(int32_t __i{nf}; __i != nfp; ++__i) w[__i] = 0.0;
+#pragma omp for schedule(dynamic,1)
+            for(int32_t __a = 0; __a < naspects; ++__a) {
+                const double st{std::sin(theta[__a])};
+                const double rx{st*std::cos(phi[__a])};
+                const double ry{st*std::sin(phi[__a])};
+                const double rz{std::cos(theta[__a])};
+                const float dir[3] = {static_cast<float>(rx),static_cast<float>(ry),static_cast<float>(rz)};
+                const float eps{f.ray_eps};
+                int32_t nc{0};
+                for(int32_t __i{0}; __i != nf; ++__i) {
+                    double cn{f.nx[__i]*rx+f.ny[__i]*ry+f.nz[__i]*rz};
+                    if(two_sided) cn = std::fabs(cn);
+                    w[__i] = (cn > 0.0) ? cn : 0.0;
+                    if(shadowing && cn > 0.0) cand[nc++] = __i;
+                }
+                // shadow rays from the centroids lifted off the lit side, in BVH order
+                auto origin = [&](const int32_t i,float * __restrict o) {
+                     const PO_Tri & tr{f.tris[i]};
+                     const float ne{(f.nx[i]*rx+f.ny[i]*ry+f.nz[i]*rz < 0.0) ? -eps : eps};
+                     o[0] = tr.v0[0]+0.333333333f*(tr.e1[0]+tr.e2[0])+ne*static_cast<float>(f.nx[i]);
+                     o[1] = tr.v0[1]+0.333333333f*(tr.e1[1]+tr.e2[1])+ne*static_cast<float>(f.ny[i]);
+                     o[2] = tr.v0[2]+0.333333333f*(tr.e1[2]+tr.e2[2])+ne*static_cast<float>(f.nz[i]);
+                };
+#if defined(__AVX512F__)
+                for(int32_t __j{0}; __j < nc; __j += 16) {
+                    __ATTR_ALIGN__(64) float   ox[16];
+                    __ATTR_ALIGN__(64) float   oy[16];
+                    __ATTR_ALIGN__(64) float   oz[16];
+                    __ATTR_ALIGN__(64) int32_t id[16];
+                    const int32_t cnt{std::min(16,nc-__j)};
+                    for(int32_t __l{0}; __l != 16; ++__l) {
+                        float o[3];
+                        const int32_t i{cand[__j+std::min(__l,cnt-1)]};
+                        origin(i,o);
+                        ox[__l] = o[0]; oy[__l] = o[1]; oz[__l] = o[2];
+                        id[__l] = i;
+                    }
+                    const __mmask16 lanes{static_cast<__mmask16>((1U<<cnt)-1U)};
+                    __mmask16 occ{occluded_zmm16r4(f,_mm512_load_ps(ox),_mm512_load_ps(oy),_mm512_load_ps(oz),
+                                                   _mm512_load_si512(id),dir,lanes)};
+                    while(occ != 0) {
+                          w[cand[__j+__builtin_ctz(occ)]] = 0.0;
+                          occ &= static_cast<__mmask16>(occ-1);
+                    }
+                }
+#else
+                for(int32_t __j{0}; __j < nc; ++__j) {
+                    float o[3];
+                    origin(cand[__j],o);
+                    if(po_ray_occluded(f,o,dir,0.0f,3.0e+38f,cand[__j])) w[cand[__j]] = 0.0;
+                }
+#endif
+                double Ire,Iim;
+                po_facets_integral(f,w,rx,ry,rz,k0,Ire,Iim);
+                rcs[__a] = ck*(Ire*Ire+Iim*Iim);
+            }
+            _mm_free(cand);
+            _mm_free(w);
+       }
+}
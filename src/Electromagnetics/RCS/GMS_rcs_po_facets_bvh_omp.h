@@ -0,0 +1,197 @@
+#ifndef __GMS_RCS_PO_FACETS_BVH_OMP_H__
+#define __GMS_RCS_PO_FACETS_BVH_OMP_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_version {
+
+    const unsigned int GMS_RCS_PO_FACETS_BVH_OMP_MAJOR = 1U;
+    const unsigned int GMS_RCS_PO_FACETS_BVH_OMP_MINOR = 0U;
+    const unsigned int GMS_RCS_PO_FACETS_BVH_OMP_MICRO = 0U;
+    const unsigned int GMS_RCS_PO_FACETS_BVH_OMP_FULLVER =
+      1000U*GMS_RCS_PO_FACETS_BVH_OMP_MAJOR+
+      100U*GMS_RCS_PO_FACETS_BVH_OMP_MINOR+
+      10U*GMS_RCS_PO_FACETS_BVH_OMP_MICRO;
+    const char * const GMS_RCS_PO_FACETS_BVH_OMP_CREATION_DATE = "19-10-2026 14:10 PM +00200 (MON 19 OCT 2026 GMT+2)";
+    const char * const GMS_RCS_PO_FACETS_BVH_OMP_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_RCS_PO_FACETS_BVH_OMP_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_RCS_PO_FACETS_BVH_OMP_DESCRIPTION   = "Physical Optics monostatic RCS of triangulated (PEC) surfaces, SAH BVH shadowing, OpenMP over aspects.";
+
+}
+
+/*
+       Physical Optics (PO) monostatic RCS of a perfectly conducting,
+       triangulated surface:
+
+            sigma = (k0^2/pi) * | SUM_lit (n.r) * INT_facet exp(j*2k0*r.x) dS |^2
+
+       r is the unit vector from the target towards the radar at the aspect
+       (theta,phi): r = (sin(theta)cos(phi),sin(theta)sin(phi),cos(theta)).
+       The facet integrals are evaluated in closed form (divided differences of
+       exp(jx), Taylor expansion for nearly degenerate phase gradients), 8 facets
+       per AVX512 register.
+       A facet is lit when it faces the radar and, optionally, when the ray from
+       its centroid towards the radar does not hit another facet. The shadow rays
+       are traced through a binned-SAH bounding volume hierarchy.
+       Aspects are distributed over OpenMP threads.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include "GMS_config.h"
+
+// Maximum number of triangles in a BVH leaf.
+#if !defined(PO_BVH_LEAF_MAX)
+#define PO_BVH_LEAF_MAX 4
+#endif
+
+// Number of SAH bins.
+#if !defined(PO_BVH_NBINS)
+#define PO_BVH_NBINS 16
+#endif
+
+namespace gms {
+
+        namespace radiolocation {
+
+                  /*
+                        BVH node, 32 bytes. Inner node: count == 0, left child is the
+                        next node, first is the index of the right child. Leaf: triangles
+                        [first,first+count) of the facet arrays.
+                  */
+                  struct __ATTR_ALIGN__(32) PO_BVH_Node {
+
+                         float   bmin[3];
+                         int32_t first;
+                         float   bmax[3];
+                         int32_t count;
+                  };
+
+                  // Triangle used by the ray queries (vertex 0 and the two edges).
+                  struct PO_Tri {
+
+                         float v0[3];
+                         float e1[3];
+                         float e2[3];
+                  };
+
+                  /*
+                        Facets in BVH order, SoA, padded to a multiple of 8 with zero area facets.
+                        perm[i] is the input triangle index of facet i.
+                  */
+                  struct __ATTR_ALIGN__(64) PO_Facets {
+
+                         int32_t nf;      // number of facets
+                         int32_t nfp;     // padded number of facets
+                         int32_t nnodes;  // number of BVH nodes
+                         int32_t pad;
+                         double  * __restrict p0x;  // vertex 0
+                         double  * __restrict p0y;
+                         double  * __restrict p0z;
+                         double  * __restrict e1x;  // vertex 1 - vertex 0
+                         double  * __restrict e1y;
+                         double  * __restrict e1z;
+                         double  * __restrict e2x;  // vertex 2 - vertex 0
+                         double  * __restrict e2y;
+                         double  * __restrict e2z;
+                         double  * __restrict nx;   // unit normal (e1 x e2)/|e1 x e2|
+                         double  * __restrict ny;
+                         double  * __restrict nz;
+                         double  * __restrict area;
+                         int32_t * __restrict perm;
+                         PO_Tri  * __restrict tris;
+                         PO_BVH_Node * __restrict nodes;
+                         float   ray_eps;   // shadow ray offset (scene size relative)
+                  };
+
+                  /*
+                        Builds the facets and the BVH of a triangle mesh.
+                        xs,ys,zs -- node coordinates (e.g. GMSH_Mesh::node_xs ...).
+                        tri_node -- tri_node[ntri_stride*t+i], i=0,1,2, corner nodes of the triangle t,
+                                    index base 'base' (1 for gmsh_mmap_read/mesh_base_one meshes).
+                        ntri_stride -- number of nodes per element (3 for linear triangles, 6 for
+                                       quadratic ones, only the corner nodes are used).
+                        The vertex order defines the facet normal (right hand rule), closed
+                        bodies must be oriented outwards.
+                        The BVH is built once per mesh (serial binned SAH, O(n log n)).
+                        Returns false on allocation failure.
+                  */
+                  bool po_facets_build(const double * __restrict xs,
+                                       const double * __restrict ys,
+                                       const double * __restrict zs,
+                                       const int32_t * __restrict tri_node,
+                                       const int32_t ntri,
+                                       const int32_t ntri_stride,
+                                       const int32_t base,
+                                       PO_Facets & f);
+
+                  void po_facets_free(PO_Facets & f);
+
+                  /*
+                        Any-hit query: true if the ray org + t*dir, tmin < t < tmax,
+                        hits a facet other than 'skip'.
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  bool po_ray_occluded(const PO_Facets & f,
+                                       const float * __restrict org,
+                                       const float * __restrict dir,
+                                       const float tmin,
+                                       const float tmax,
+                                       const int32_t skip);
+
+                  /*
+                        Monostatic PO RCS [m^2] at naspects aspects (theta[i],phi[i]) [rad],
+                        free space wavenumber k0 [rad/m].
+                        shadowing -- trace the centroid shadow rays (otherwise only the
+                                     back facing facets are dark, exact for convex bodies).
+                        two_sided -- facets are lit from either side (open thin surfaces).
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void po_rcs_monostatic_omp(const PO_Facets & f,
+                                             const double * __restrict theta,
+                                             const double * __restrict phi,
+                                             const int32_t naspects,
+                                             const double k0,
+                                             const bool shadowing,
+                                             const bool two_sided,
+                                             double * __restrict rcs);
+
+                  /*
+                        Complex PO integral I of a single aspect (sigma = k0^2/pi*|I|^2),
+                        w[] are the facet weights (n.r of the lit facets, 0 for dark ones).
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void po_facets_integral(const PO_Facets & f,
+                                          const double * __restrict w,
+                                          const double rx,
+                                          const double ry,
+                                          const double rz,
+                                          const double k0,
+                                          double & Ire,
+                                          double & Iim);
+
+        } // radiolocation
+
+} // gms
+
+#endif /*__GMS_RCS_PO_FACETS_BVH_OMP_H__*/
@@ -0,0 +1,378 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+#include "GMS_rcs_sphere_mie_avx512.h"
+
+
+namespace {
+
+        // Thin per-width layer, the series kernel below is written once for both widths.
+        struct zmm16r4_ops {
+
+               typedef __m512    V;
+               typedef __mmask16 M;
+               typedef float     S;
+               static constexpr int32_t W = 16;
+               static V set1(const S s)                    { return (_mm512_set1_ps(s));}
+               static V zero()                             { return (_mm512_setzero_ps());}
+               static V add(const V a,const V b)           { return (_mm512_add_ps(a,b));}
+               static V sub(const V a,const V b)           { return (_mm512_sub_ps(a,b));}
+               static V mul(const V a,const V b)           { return (_mm512_mul_ps(a,b));}
+               static V div(const V a,const V b)           { return (_mm512_div_ps(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm512_fmadd_ps(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm512_fmsub_ps(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm512_fnmadd_ps(a,b,c));}
+               static V max(const V a,const V b)           { return (_mm512_max_ps(a,b));}
+               static V abs(const V a)                     { return (_mm512_abs_ps(a));}
+               static V mask_mov(const V s,const M k,const V a) { return (_mm512_mask_mov_ps(s,k,a));}
+               static M cmp_le(const V a,const V b)        { return (_mm512_cmp_ps_mask(a,b,_CMP_LE_OQ));}
+               static M cmp_gt(const V a,const V b)        { return (_mm512_cmp_ps_mask(a,b,_CMP_GT_OQ));}
+               static void store(S * p,const V a)          { _mm512_storeu_ps(p,a);}
+               static V load(const S * p)                  { return (_mm512_loadu_ps(p));}
+               static V maskz_load(const M k,const S * p)  { return (_mm512_maskz_loadu_ps(k,p));}
+               static void mask_store(S * p,const M k,const V a) { _mm512_mask_storeu_ps(p,k,a);}
+        };
+
+        struct zmm8r8_ops {
+
+               typedef __m512d   V;
+               typedef __mmask8  M;
+               typedef double    S;
+               static constexpr int32_t W = 8;
+               static V set1(const S s)                    { return (_mm512_set1_pd(s));}
+               static V zero()                             { return (_mm512_setzero_pd());}
+               static V add(const V a,const V b)           { return (_mm512_add_pd(a,b));}
+               static V sub(const V a,const V b)           { return (_mm512_sub_pd(a,b));}
+               static V mul(const V a,const V b)           { return (_mm512_mul_pd(a,b));}
+               static V div(const V a,const V b)           { return (_mm512_div_pd(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm512_fmadd_pd(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm512_fmsub_pd(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm512_fnmadd_pd(a,b,c));}
+               static V max(const V a,const V b)           { return (_mm512_max_pd(a,b));}
+               static V abs(const V a)                     { return (_mm512_abs_pd(a));}
+               static V mask_mov(const V s,const M k,const V a) { return (_mm512_mask_mov_pd(s,k,a));}
+               static M cmp_le(const V a,const V b)        { return (_mm512_cmp_pd_mask(a,b,_CMP_LE_OQ));}
+               static M cmp_gt(const V a,const V b)        { return (_mm512_cmp_pd_mask(a,b,_CMP_GT_OQ));}
+               static void store(S * p,const V a)          { _mm512_storeu_pd(p,a);}
+               static V load(const S * p)                  { return (_mm512_loadu_pd(p));}
+               static V maskz_load(const M k,const S * p)  { return (_mm512_maskz_loadu_pd(k,p));}
+               static void mask_store(S * p,const M k,const V a) { _mm512_mask_storeu_pd(p,k,a);}
+        };
+
+        // (ar + j*ai)/(br + j*bi), scaled by max(|br|,|bi|) (no overflow of |b|^2 in float).
+        template<typename Op>
+        __attribute__((always_inline))
+        inline void cdiv(const typename Op::V ar,
+                         const typename Op::V ai,
+                         const typename Op::V br,
+                         const typename Op::V bi,
+                         typename Op::V & cr,
+                         typename Op::V & ci) {
+               typedef typename Op::V V;
+               const V s{Op::div(Op::set1(1),Op::max(Op::abs(br),Op::abs(bi)))};
+               const V sr{Op::mul(br,s)};
+               const V si{Op::mul(bi,s)};
+               const V rd{Op::div(s,Op::fmadd(sr,sr,Op::mul(si,si)))};
+               cr = Op::mul(Op::fmadd(ar,sr,Op::mul(ai,si)),rd);
+               ci = Op::mul(Op::fmsub(ai,sr,Op::mul(ar,si)),rd);
+        }
+
+        constexpr int32_t mie_stack_nmax = 256;
+
+        template<typename Op>
+        int32_t mie_sphere_kernel(const typename Op::V k0,
+                                  const typename Op::V a,
+                                  const typename Op::V mr,
+                                  const typename Op::V mi,
+                                  const bool pec,
+                                  typename Op::V * __restrict rcs,
+                                  typename Op::V * __restrict Fr,
+                                  typename Op::V * __restrict Fi,
+                                  typename Op::V * __restrict qext,
+                                  typename Op::V * __restrict qsca) {
+               typedef typename Op::V V;
+               typedef typename Op::M M;
+               typedef typename Op::S S;
+               constexpr int32_t W{Op::W};
+               S xs[W], mrs[W], mis[W];
+               S s0[W], c0[W], nst[W];
+               const V xv{Op::mul(k0,a)};
+               Op::store(xs,xv);
+               Op::store(mrs,mr);
+               Op::store(mis,mi);
+               int32_t nstop{0}, nmx{0};
+               for(int32_t __i{0}; __i != W; ++__i) {
+                   const double x{static_cast<double>(xs[__i])};
+                   if(!(x > 0.0) || !std::isfinite(x)) {
+                      xs[__i]  = S(1);        // dummy lane, zeroed at the end
+                      s0[__i]  = S(0);
+                      c0[__i]  = S(1);
+                      nst[__i] = S(0);
+                      continue;
+                   }
+                   const int32_t ns{static_cast<int32_t>(x+4.0*std::cbrt(x)+2.0)};
+                   nst[__i] = static_cast<S>(ns);
+                   s0[__i]  = static_cast<S>(std::sin(x));
+                   c0[__i]  = static_cast<S>(std::cos(x));
+                   nstop    = std::max(nstop,ns);
+                   if(!pec) {
+                      const double amx{std::hypot(static_cast<double>(mrs[__i]),static_cast<double>(mis[__i]))*x};
+                      nmx = std::max(nmx,static_cast<int32_t>(std::max(static_cast<double>(ns),amx)+4.0*std::cbrt(amx))+15);
+                   }
+               }
+               const V x{Op::load(xs)};
+               const M valid{Op::cmp_gt(Op::load(nst),Op::zero())};
+               const V rx{Op::div(Op::set1(1),x)};
+               // D_n(mx), n = 0..nstop
+               V Dst[2*(mie_stack_nmax+1)];
+               V * __restrict D{Dst};
+               if(!pec && nstop > mie_stack_nmax) {
+                  D = reinterpret_cast<V*>(_mm_malloc(sizeof(V)*2*static_cast<std::size_t>(nstop+1),64ULL));
+                  if(D == nullptr) return (1);
+               }
+               V mrr{Op::zero()}, mri{Op::zero()};
+               if(!pec) {
+                  V rmxr, rmxi; // 1/(m*x)
+                  cdiv<Op>(Op::set1(1),Op::zero(),Op::mul(mr,x),Op::mul(mi,x),rmxr,rmxi);
+                  cdiv<Op>(Op::set1(1),Op::zero(),mr,mi,mrr,mri);
+                  V dr{Op::zero()}, di{Op::zero()};
+                  for(int32_t __n{nmx}; __n >= 1; --__n) {
+                      const V fn{Op::set1(static_cast<S>(__n))};
+                      const V pr{Op::mul(fn,rmxr)}, pi{Op::mul(fn,rmxi)}; // n/(mx)
+                      V qr, qi;
+                      cdiv<Op>(Op::set1(1),Op::zero(),Op::add(dr,pr),Op::add(di,pi),qr,qi);
+                      dr = Op::sub(pr,qr);
+                      di = Op::sub(pi,qi);
+                      if(__n-1 <= nstop) {
+                         D[2*(__n-1)]   = dr;
+                         D[2*(__n-1)+1] = di;
+                      }
+                  }
+               }
+               V psi0{Op::load(c0)}, psi1{Op::load(s0)};
+               V chi0{Op::sub(Op::zero(),psi1)}, chi1{psi0};
+               V xi1r{psi1}, xi1i{Op::sub(Op::zero(),chi1)};
+               V sfr{Op::zero()}, sfi{Op::zero()}, sext{Op::zero()}, ssca{Op::zero()};
+               const V nstv{Op::load(nst)};
+               for(int32_t __n{1}; __n <= nstop; ++__n) {
+                   const S fn{static_cast<S>(__n)};
+                   const M act = valid & Op::cmp_le(Op::set1(fn),nstv);
+                   const V f2n1{Op::set1(static_cast<S>(2*__n-1))};
+                   const V psi{Op::fmsub(Op::mul(f2n1,rx),psi1,psi0)};
+                   const V chi{Op::fmsub(Op::mul(f2n1,rx),chi1,chi0)};
+                   const V xir{psi}, xii{Op::sub(Op::zero(),chi)};
+                   const V nx{Op::mul(Op::set1(fn),rx)};
+                   V anr, ani, bnr, bni;
+                   if(pec) {
+                      // a_n = (n/x psi_n - psi_n-1)/(n/x xi_n - xi_n-1), b_n = psi_n/xi_n
+                      cdiv<Op>(Op::fmsub(nx,psi,psi1),Op::zero(),Op::fmsub(nx,xir,xi1r),Op::fmsub(nx,xii,xi1i),anr,ani);
+                      cdiv<Op>(psi,Op::zero(),xir,xii,bnr,bni);
+                   } else {
+                      const V dr{D[2*__n]}, di{D[2*__n+1]};
+                      // da = D/m + n/x, db = m*D + n/x
+                      const V dar{Op::add(Op::fnmadd(di,mri,Op::mul(dr,mrr)),nx)};
+                      const V dai{Op::fmadd(dr,mri,Op::mul(di,mrr))};
+                      const V dbr{Op::add(Op::fnmadd(di,mi,Op::mul(dr,mr)),nx)};
+                      const V dbi{Op::fmadd(dr,mi,Op::mul(di,mr))};
+                      // (d*psi - psi1)/(d*xi - xi1)
+                      cdiv<Op>(Op::fmsub(dar,psi,psi1),Op::mul(dai,psi),
+                               Op::sub(Op::fnmadd(dai,xii,Op::mul(dar,xir)),xi1r),
+                               Op::sub(Op::fmadd(dai,xir,Op::mul(dar,xii)),xi1i),anr,ani);
+                      cdiv<Op>(Op::fmsub(dbr,psi,psi1),Op::mul(dbi,psi),
+                               Op::sub(Op::fnmadd(dbi,xii,Op::mul(dbr,xir)),xi1r),
+                               Op::sub(Op::fmadd(dbi,xir,Op::mul(dbr,xii)),xi1i),bnr,bni);
+                   }
+                   const V w{Op::set1(static_cast<S>(2*__n+1))};
+                   const V ws{(__n & 1) ? Op::set1(static_cast<S>(-(2*__n+1))) : w};
+                   sfr  = Op::mask_mov(sfr,act,Op::fmadd(ws,Op::sub(anr,bnr),sfr));
+                   sfi  = Op::mask_mov(sfi,act,Op::fmadd(ws,Op::sub(ani,bni),sfi));
+                   sext = Op::mask_mov(sext,act,Op::fmadd(w,Op::add(anr,bnr),sext));
+                   ssca = Op::mask_mov(ssca,act,Op::fmadd(w,Op::fmadd(anr,anr,Op::fmadd(ani,ani,
+                                                          Op::fmadd(bnr,bnr,Op::mul(bni,bni)))),ssca));
+                   // lanes past their nstop keep the last values (no overflow of chi)
+                   psi0 = Op::mask_mov(psi0,act,psi1);
+                   psi1 = Op::mask_mov(psi1,act,psi);
+                   chi0 = Op::mask_mov(chi0,act,chi1);
+                   chi1 = Op::mask_mov(chi1,act,chi);
+                   xi1r = Op::mask_mov(xi1r,act,xir);
+                   xi1i = Op::mask_mov(xi1i,act,xii);
+               }
+               if(D != Dst) _mm_free(D);
+               const V zero{Op::zero()};
+               const V rk{Op::div(Op::set1(1),k0)};
+               const V pi{Op::set1(static_cast<S>(3.14159265358979323846264338328))};
+               const V q{Op::mul(Op::set1(2),Op::mul(rx,rx))};
+               *rcs = Op::mask_mov(zero,valid,Op::mul(Op::mul(pi,Op::mul(rk,rk)),Op::fmadd(sfr,sfr,Op::mul(sfi,sfi))));
+               *Fr  = Op::mask_mov(zero,valid,sfr);
+               *Fi  = Op::mask_mov(zero,valid,sfi);
+               if(qext != nullptr) *qext = Op::mask_mov(zero,valid,Op::mul(q,sext));
+               if(qsca != nullptr) *qsca = Op::mask_mov(zero,valid,Op::mul(q,ssca));
+               return (0);
+        }
+
+        template<typename Op>
+        int32_t mie_sweep(const typename Op::S * __restrict k0,
+                          const typename Op::S * __restrict a,
+                          const typename Op::S * __restrict mr,
+                          const typename Op::S * __restrict mi,
+                          const int32_t n,
+                          typename Op::S * __restrict rcs) {
+               typedef typename Op::V V;
+               typedef typename Op::M M;
+               constexpr int32_t W{Op::W};
+               const int32_t nb{(n+W-1)/W};
+               const bool pec{mr == nullptr};
+               int32_t err{0};
+#pragma omp parallel for schedule(dynamic,1) default(none) shared(k0,a,mr,mi,n,rcs,nb,pec) reduction(|:err)
+               for(int32_t __b = 0; __b < nb; ++__b) {
+                   const int32_t i0{Op::W*__b};
+                   const int32_t nl{std::min(Op::W,n-i0)};
+                   const M k{static_cast<M>((1ULL << nl)-1ULL)};
+                   const V vmr{pec ? Op::zero() : Op::maskz_load(k,&mr[i0])};
+                   const V vmi{(pec || mi == nullptr) ? Op::zero() : Op::maskz_load(k,&mi[i0])};
+                   V r, fr, fi;
+                   err |= mie_sphere_kernel<Op>(Op::maskz_load(k,&k0[i0]),Op::maskz_load(k,&a[i0]),vmr,vmi,pec,
+                                                &r,&fr,&fi,nullptr,nullptr);
+                   Op::mask_store(&rcs[i0],k,r);
+               }
+               return (err);
+        }
+
+} // anon
+
+
+int32_t
+gms::radiolocation::rcs_mie_sphere_zmm16r4(const __m512 k0,
+                                           const __m512 a,
+                                           const __m512 mr,
+                                           const __m512 mi,
+                                           const bool pec,
+                                           __m512 * __restrict rcs,
+                                           __m512 * __restrict Fr,
+                                           __m512 * __restrict Fi,
+                                           __m512 * __restrict qext,
+                                           __m512 * __restrict qsca) {
+       return (mie_sphere_kernel<zmm16r4_ops>(k0,a,mr,mi,pec,rcs,Fr,Fi,qext,qsca));
+}
+
+
+int32_t
+gms::radiolocation::rcs_mie_sphere_zmm8r8(const __m512d k0,
+                                          const __m512d a,
+                                          const __m512d mr,
+                                          const __m512d mi,
+                                          const bool pec,
+                                          __m512d * __restrict rcs,
+                                          __m512d * __restrict Fr,
+                                          __m512d * __restrict Fi,
+                                          __m512d * __restrict qext,
+                                          __m512d * __restrict qsca) {
+       return (mie_sphere_kernel<zmm8r8_ops>(k0,a,mr,mi,pec,rcs,Fr,Fi,qext,qsca));
+}
+
+
+double
+gms::radiolocation::rcs_mie_sphere_r8(const double k0,
+                                      const double a,
+                                      const std::complex<double> m,
+                                      const bool pec,
+                                      std::complex<double> * __restrict F,
+                                      double * __restrict qext,
+                                      double * __restrict qsca) {
+       typedef std::complex<double> C;
+       const double x{k0*a};
+       if(!(x > 0.0) || !std::isfinite(x)) {
+          if(F != nullptr)    *F    = C(0.0,0.0);
+          if(qext != nullptr) *qext = 0.0;
+          if(qsca != nullptr) *qsca = 0.0;
+          return (0.0);
+       }
+       const int32_t nstop{static_cast<int32_t>(x+4.0*std::cbrt(x)+2.0)};
+       std::vector<C> D;
+       if(!pec) {
+          const C mx{m*x};
+          const int32_t nmx{static_cast<int32_t>(std::max(static_cast<double>(nstop),std::abs(mx))+4.0*std::cbrt(std::abs(mx)))+15};
+          D.assign(static_cast<std::size_t>(nmx)+1,C(0.0,0.0));
+          for(int32_t __n{nmx}; __n >= 1; --__n) {
+              const C p{static_cast<double>(__n)/mx};
+              D[__n-1] = p-1.0/(D[__n]+p);
+          }
+       }
+       double psi0{std::cos(x)}, psi1{std::sin(x)};
+       double chi0{-std::sin(x)}, chi1{std::cos(x)};
+       C xi1{psi1,-chi1};
+       C sf{0.0,0.0};
+       double sext{0.0}, ssca{0.0};
+       for(int32_t __n{1}; __n <= nstop; ++__n) {
+           const double fn{static_cast<double>(__n)};
+           const double psi{(2.0*fn-1.0)*psi1/x-psi0};
+           const double chi{(2.0*fn-1.0)*chi1/x-chi0};
+           const C xi{psi,-chi};
+           C an, bn;
+           if(pec) {
+              an = (fn/x*psi-psi1)/(fn/x*xi-xi1);
+              bn = psi/xi;
+           } else {
+              const C da{D[__n]/m+fn/x};
+              const C db{m*D[__n]+fn/x};
+              an = (da*psi-psi1)/(da*xi-xi1);
+              bn = (db*psi-psi1)/(db*xi-xi1);
+           }
+           const double w{2.0*fn+1.0};
+           sf   += ((__n & 1) ? -w : w)*(an-bn);
+           sext += w*(an.real()+bn.real());
+           ssca += w*(std::norm(an)+std::norm(bn));
+           psi0 = psi1;
+           psi1 = psi;
+           chi0 = chi1;
+           chi1 = chi;
+           xi1  = xi;
+       }
+       if(F != nullptr)    *F    = sf;
+       if(qext != nullptr) *qext = 2.0*sext/(x*x);
+       if(qsca != nullptr) *qsca = 2.0*ssca/(x*x);
+       return (3.14159265358979323846264338328*std::norm(sf)/(k0*k0));
+}
+
+
+int32_t
+gms::radiolocation::rcs_mie_sphere_sweep_zmm16r4_omp(const float * __restrict k0,
+                                                     const float * __restrict a,
+                                                     const float * __restrict mr,
+                                                     const float * __restrict mi,
+                                                     const int32_t n,
+                                                     float * __restrict rcs) {
+       return (mie_sweep<zmm16r4_ops>(k0,a,mr,mi,n,rcs));
+}
+
+
+int32_t
+gms::radiolocation::rcs_mie_sphere_sweep_zmm8r8_omp(const double * __restrict k0,
+                                                    const double * __restrict a,
+                                                    const double * __restrict mr,
+                                                    const double * __restrict mi,
+                                                    const int32_t n,
+                                                    double * __restrict rcs) {
+       return (mie_sweep<zmm8r8_ops>(k0,a,mr,mi,n,rcs));
+}
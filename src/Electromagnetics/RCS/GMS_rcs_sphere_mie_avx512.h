@@ -0,0 +1,142 @@
+#ifndef __GMS_RCS_SPHERE_MIE_AVX512_H__
+#define __GMS_RCS_SPHERE_MIE_AVX512_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_RCS_SPHERE_MIE_AVX512_MAJOR = 1U;
+    const unsigned int GMS_RCS_SPHERE_MIE_AVX512_MINOR = 0U;
+    const unsigned int GMS_RCS_SPHERE_MIE_AVX512_MICRO = 0U;
+    const unsigned int GMS_RCS_SPHERE_MIE_AVX512_FULLVER =
+      1000U*GMS_RCS_SPHERE_MIE_AVX512_MAJOR+100U*GMS_RCS_SPHERE_MIE_AVX512_MINOR+
+      10U*GMS_RCS_SPHERE_MIE_AVX512_MICRO;
+    const char * const GMS_RCS_SPHERE_MIE_AVX512_CREATION_DATE = "20-10-2026 14:20 PM +00200 (TUE 20 OCT 2026 GMT+2)";
+    const char * const GMS_RCS_SPHERE_MIE_AVX512_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_RCS_SPHERE_MIE_AVX512_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_RCS_SPHERE_MIE_AVX512_DESCRIPTION   = "Exact (Mie series) sphere RCS, 16 (float) or 8 (double) frequencies/radii per AVX512 register.";
+
+}
+
+/*
+     Exact monostatic RCS of a homogeneous sphere (Mie series), the reference
+     for the region formulas of GMS_rcs_sphere_*.hpp (Rayleigh, resonance and
+     optics regions, Radar Cross Section Handbook 1, 3.2-4 .. 3.2-23).
+     Bohren-Huffman/Wiscombe formulation:
+          x = k0*a, m = mr + j*mi (relative complex refractive index, mi >= 0
+          absorbing, exp(-jwt) convention),
+          D_n(mx)      -- logarithmic derivative, downward recurrence from
+                          max(nstop,|mx|)+4*|mx|^(1/3)+15 (the Bohren-Huffman
+                          start max(nstop,|mx|)+15 is short of convergence for
+                          weakly absorbing spheres with |mx| > ~100),
+          psi_n, chi_n -- Riccati-Bessel functions of x, upward recurrence,
+          nstop        -- x + 4*x^(1/3) + 2 (Wiscombe truncation),
+          F            -- SUM (2n+1)*(-1)^n*(a_n-b_n),
+          sigma        -- pi*|F|^2/k0^2.
+     The perfectly conducting sphere (pec = true) uses the limits of a_n,b_n
+     for |m| -> inf; metals at radar frequencies should be modelled that way
+     (|mx| would drive the recurrence length).
+     The lanes of a register are independent spheres (k0 and a per lane), the
+     series runs to the largest nstop of the register, so lanes with similar
+     size parameters (sorted frequency sweeps) waste the least work.
+     Cost is O(x) per lane. The single precision kernel keeps a relative error
+     of about 1.0e-5 (PEC, absorbing spheres) up to x ~ 500; the backscatter of
+     lossless dielectric spheres above x ~ 30 is dominated by sharp internal
+     resonances and loses up to two more digits, use the zmm8r8 kernel there.
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include <complex>
+#include "GMS_config.h"
+
+namespace gms {
+
+        namespace radiolocation {
+
+                  /*
+                        16 spheres: wavenumber k0 (rad/m), radius a (m), refractive
+                        index mr + j*mi (ignored for pec).
+                        rcs  -- monostatic RCS (m^2),
+                        Fr,Fi -- backscatter amplitude F (sigma = pi*|F|^2/k0^2),
+                        qext,qsca -- extinction and scattering efficiencies (may be nullptr),
+                        in float qext of non-absorbing spheres below x ~ 0.1 is
+                        inaccurate (cancellation), qsca is not.
+                        Lanes with k0*a <= 0 (or NaN) return zeros.
+                        Returns 0 -- success, 1 -- allocation failure (D_n workspace, nstop > 256).
+                  */
+                  int32_t rcs_mie_sphere_zmm16r4(const __m512 k0,
+                                                 const __m512 a,
+                                                 const __m512 mr,
+                                                 const __m512 mi,
+                                                 const bool pec,
+                                                 __m512 * __restrict rcs,
+                                                 __m512 * __restrict Fr,
+                                                 __m512 * __restrict Fi,
+                                                 __m512 * __restrict qext,
+                                                 __m512 * __restrict qsca);
+
+                  int32_t rcs_mie_sphere_zmm8r8(const __m512d k0,
+                                                const __m512d a,
+                                                const __m512d mr,
+                                                const __m512d mi,
+                                                const bool pec,
+                                                __m512d * __restrict rcs,
+                                                __m512d * __restrict Fr,
+                                                __m512d * __restrict Fi,
+                                                __m512d * __restrict qext,
+                                                __m512d * __restrict qsca);
+
+                  /*
+                        Scalar reference (double precision, std::complex).
+                  */
+                  double rcs_mie_sphere_r8(const double k0,
+                                           const double a,
+                                           const std::complex<double> m,
+                                           const bool pec,
+                                           std::complex<double> * __restrict F,
+                                           double * __restrict qext,
+                                           double * __restrict qsca);
+
+                  /*
+                        n spheres, rcs[i] of (k0[i],a[i],mr[i]+j*mi[i]), OpenMP over
+                        registers (dynamic schedule, the cost grows with k0*a).
+                        mr == nullptr -- perfect conductor (mi is then ignored).
+                        Returns 0 -- success, 1 -- allocation failure.
+                  */
+                  int32_t rcs_mie_sphere_sweep_zmm16r4_omp(const float * __restrict k0,
+                                                           const float * __restrict a,
+                                                           const float * __restrict mr,
+                                                           const float * __restrict mi,
+                                                           const int32_t n,
+                                                           float * __restrict rcs);
+
+                  int32_t rcs_mie_sphere_sweep_zmm8r8_omp(const double * __restrict k0,
+                                                          const double * __restrict a,
+                                                          const double * __restrict mr,
+                                                          const double * __restrict mi,
+                                                          const int32_t n,
+                                                          double * __restrict rcs);
+
+        } // radiolocation
+
+} // gms
+
+#endif /*__GMS_RCS_SPHERE_MIE_AVX512_H__*/
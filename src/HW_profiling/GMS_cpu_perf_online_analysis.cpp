@@ -0,0 +1,237 @@
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "GMS_cpu_perf_online_analysis.h"
+
+gms::system::CpuPerfOnlineAnalyzer::
+CpuPerfOnlineAnalyzer(const CpuPerfOnlineParams & params)
+:
+m_params{params} {
+
+	// the minimums documented at CpuPerfOnlineParams
+	m_params.m_lag    = std::max(m_params.m_lag,1);
+	m_params.m_block  = std::max(m_params.m_block,1);
+	m_params.m_warmup = std::max(m_params.m_warmup,2);
+	const std::size_t C = static_cast<std::size_t>(m_params.m_lag)+1ULL;
+	m_ring.resize(2ULL*C);
+	m_first.resize(C);
+	m_lagsum.resize(C);
+	reset();
+}
+
+void
+gms::system::CpuPerfOnlineAnalyzer::reset() {
+
+	m_n = 0ULL;
+	m_mean = m_M2 = m_M3 = m_M4 = 0.0;
+	m_min =  std::numeric_limits<double>::infinity();
+	m_max = -std::numeric_limits<double>::infinity();
+	m_ewma_mean = m_ewma_var = 0.0;
+	m_shift = m_ysum = 0.0;
+	m_head = 0;
+	std::fill(m_ring.begin(),m_ring.end(),0.0);
+	std::fill(m_first.begin(),m_first.end(),0.0);
+	std::fill(m_lagsum.begin(),m_lagsum.end(),0.0);
+	m_bcnt = 0;
+	m_bsum = 0.0;
+	m_ref_n = 0ULL;
+	m_ref_mean = m_ref_M2 = 0.0;
+	m_ref_sd = 1.0;
+	m_gpos = m_gneg = 0.0;
+	m_zpos = m_zneg = 0ULL;
+	m_nchange = 0ULL;
+}
+
+bool
+gms::system::CpuPerfOnlineAnalyzer::push(const double x) {
+
+	const uint64_t t = m_n;
+	const int32_t C = m_params.m_lag+1;
+	if(t == 0ULL) {
+	   m_shift = x;
+	   m_ewma_mean = x;
+	}
+	// Lag sums: y(t)*y(t-k), the ring holds y(t-k) at m_head+k (twice, no wrap).
+	const double y = x-m_shift;
+	m_head = (m_head == 0) ? C-1 : m_head-1;
+	m_ring[m_head]   = y;
+	m_ring[m_head+C] = y;
+	const double * __restrict r = &m_ring[m_head];
+	double * __restrict s = &m_lagsum[0];
+#pragma omp simd
+	for(int32_t __i = 0; __i < C; ++__i) {
+	    s[__i] += y*r[__i];
+	}
+	if(t < static_cast<uint64_t>(C)) m_first[t] = y;
+	m_ysum += y;
+	// Moments (Pebay).
+	const double n1 = static_cast<double>(t);
+	const double n  = n1+1.0;
+	const double delta   = x-m_mean;
+	const double delta_n = delta/n;
+	const double delta_n2 = delta_n*delta_n;
+	const double term1 = delta*delta_n*n1;
+	m_mean += delta_n;
+	m_M4 += term1*delta_n2*(n*n-3.0*n+3.0)+6.0*delta_n2*m_M2-4.0*delta_n*m_M3;
+	m_M3 += term1*delta_n*(n-2.0)-3.0*delta_n*m_M2;
+	m_M2 += term1;
+	m_min = std::min(m_min,x);
+	m_max = std::max(m_max,x);
+	const double a = m_params.m_ewma;
+	const double d = x-m_ewma_mean;
+	m_ewma_mean += a*d;
+	m_ewma_var = (1.0-a)*(m_ewma_var+a*d*d);
+	m_n = t+1ULL;
+	// CUSUM of the block means, warm-up of the reference first.
+	m_bsum += x;
+	if(++m_bcnt < m_params.m_block) return (false);
+	const double xb = m_bsum/static_cast<double>(m_bcnt);
+	m_bcnt = 0;
+	m_bsum = 0.0;
+	if(m_ref_n < static_cast<uint64_t>(m_params.m_warmup)) {
+	   m_ref_n += 1ULL;
+	   const double dr = xb-m_ref_mean;
+	   m_ref_mean += dr/static_cast<double>(m_ref_n);
+	   m_ref_M2 += dr*(xb-m_ref_mean);
+	   if(m_ref_n == static_cast<uint64_t>(m_params.m_warmup)) {
+	      const double sd = std::sqrt(m_ref_M2/static_cast<double>(m_ref_n-1ULL));
+	      // constant reference: any change is a change
+	      m_ref_sd = (sd > 0.0) ? sd : std::max(1.0e-12*std::abs(m_ref_mean),std::numeric_limits<double>::min());
+	      m_gpos = m_gneg = 0.0;
+	      m_zpos = m_zneg = t;
+	   }
+	   return (false);
+	}
+	const double z = (xb-m_ref_mean)/m_ref_sd;
+	m_gpos = std::max(0.0,m_gpos+z-m_params.m_cusum_k);
+	m_gneg = std::max(0.0,m_gneg-z-m_params.m_cusum_k);
+	if(m_gpos == 0.0) m_zpos = t;
+	if(m_gneg == 0.0) m_zneg = t;
+	const bool up = m_gpos > m_params.m_cusum_h;
+	if(!up && !(m_gneg > m_params.m_cusum_h)) return (false);
+	CpuPerfChangepoint & e = m_events[m_nchange%CPU_PERF_ONLINE_MAX_EVENTS];
+	e.m_alarm    = t;
+	e.m_start    = (up ? m_zpos : m_zneg)+1ULL;
+	e.m_dir      = up ? 1 : -1;
+	e.m_ref_mean = m_ref_mean;
+	e.m_ref_sd   = m_ref_sd;
+	m_nchange += 1ULL;
+	m_ref_n = 0ULL;
+	m_ref_mean = m_ref_M2 = 0.0;
+	m_gpos = m_gneg = 0.0;
+	return (true);
+}
+
+int32_t
+gms::system::CpuPerfOnlineAnalyzer::push(const double * __restrict x,
+					 const std::size_t n) {
+
+	int32_t nalarm = 0;
+	for(std::size_t __i = 0ULL; __i != n; ++__i) {
+	    nalarm += push(x[__i]) ? 1 : 0;
+	}
+	return (nalarm);
+}
+
+void
+gms::system::CpuPerfOnlineAnalyzer::snapshot(CpuPerfOnlineSnapshot & s) const {
+
+	const int32_t L = m_params.m_lag;
+	const std::size_t C = static_cast<std::size_t>(L)+1ULL;
+	s.m_acov.assign(C,0.0);
+	s.m_acor.assign(C,0.0);
+	s.m_ar_coef.assign(static_cast<std::size_t>(L),0.0);
+	s.m_parcor.assign(static_cast<std::size_t>(L),0.0);
+	s.m_aic.assign(C,0.0);
+	s.m_n = m_n;
+	s.m_mean = m_mean;
+	s.m_min = m_min;
+	s.m_max = m_max;
+	s.m_ewma_mean = m_ewma_mean;
+	s.m_ewma_var = m_ewma_var;
+	const double n = static_cast<double>(m_n);
+	s.m_var  = (m_n > 1ULL) ? m_M2/(n-1.0) : 0.0;
+	s.m_skew = (m_M2 > 0.0) ? std::sqrt(n)*m_M3/std::pow(m_M2,1.5) : 0.0;
+	s.m_kurt = (m_M2 > 0.0) ? n*m_M4/(m_M2*m_M2)-3.0 : 0.0;
+	s.m_lag = 0;
+	s.m_ar_order = 0;
+	s.m_ar_sigma2 = 0.0;
+	if(m_n > 1ULL) {
+	   // c(k) = 1/n [ S(k) - my*(A(k)+B(k)) + (n-k)*my^2 ],
+	   // A(k) = Y - (first k), B(k) = Y - (last k), sums of y.
+	   const int32_t lmax = static_cast<int32_t>(std::min<uint64_t>(static_cast<uint64_t>(L),m_n-1ULL));
+	   const double my = m_ysum/n;
+	   double head = 0.0, tail = 0.0;
+	   for(int32_t __k = 0; __k <= lmax; ++__k) {
+	       const double A = m_ysum-head;
+	       const double B = m_ysum-tail;
+	       s.m_acov[__k] = (m_lagsum[__k]-my*(A+B)+(n-static_cast<double>(__k))*my*my)/n;
+	       head += m_first[__k];
+	       tail += m_ring[m_head+__k];
+	   }
+	   s.m_lag = lmax;
+	   const double c0 = s.m_acov[0];
+	   if(c0 > 0.0) {
+	      for(int32_t __k = 0; __k <= lmax; ++__k) s.m_acor[__k] = s.m_acov[__k]/c0;
+	      // Levinson-Durbin, AIC(m) = n*ln(sigma2(m))+2m
+	      std::vector<double> a(static_cast<std::size_t>(lmax)+1ULL,0.0), tmp(a.size(),0.0);
+	      double sigma2 = c0;
+	      s.m_aic[0] = n*std::log(sigma2);
+	      double best = s.m_aic[0];
+	      s.m_ar_sigma2 = sigma2;
+	      for(int32_t __m = 1; __m <= lmax; ++__m) {
+		  double acc = s.m_acov[__m];
+		  for(int32_t __i = 1; __i < __m; ++__i) acc -= a[__i]*s.m_acov[__m-__i];
+		  const double km = acc/sigma2;
+		  for(int32_t __i = 1; __i < __m; ++__i) tmp[__i] = a[__i]-km*a[__m-__i];
+		  for(int32_t __i = 1; __i < __m; ++__i) a[__i] = tmp[__i];
+		  a[__m] = km;
+		  sigma2 *= (1.0-km*km);
+		  s.m_parcor[__m-1] = km;
+		  if(!(sigma2 > 0.0)) break;      // perfectly predictable
+		  s.m_aic[__m] = n*std::log(sigma2)+2.0*static_cast<double>(__m);
+		  if(s.m_aic[__m] < best) {
+		     best = s.m_aic[__m];
+		     s.m_ar_order = __m;
+		     s.m_ar_sigma2 = sigma2;
+		     for(int32_t __i = 1; __i <= __m; ++__i) s.m_ar_coef[__i-1] = a[__i];
+		  }
+	      }
+	   }
+	}
+	s.m_nchange = m_nchange;
+	const uint64_t kept = std::min<uint64_t>(m_nchange,CPU_PERF_ONLINE_MAX_EVENTS);
+	s.m_changes.resize(static_cast<std::size_t>(kept));
+	for(uint64_t __i = 0ULL; __i != kept; ++__i) {
+	    s.m_changes[__i] = m_events[(m_nchange-kept+__i)%CPU_PERF_ONLINE_MAX_EVENTS];
+	}
+	s.m_in_warmup = m_ref_n < static_cast<uint64_t>(m_params.m_warmup);
+	s.m_cusum_pos = m_gpos;
+	s.m_cusum_neg = m_gneg;
+}
+
+void
+gms::system::print_snapshot(FILE * fp,
+			    const char * data_type,
+			    const CpuPerfOnlineSnapshot & s) {
+
+	fprintf(fp,"Data type: %s, samples: %llu\n",data_type,static_cast<unsigned long long>(s.m_n));
+	fprintf(fp,"mean=%.9f, var=%.9f, skew=%.9f, kurt=%.9f, min=%.9f, max=%.9f\n",
+		s.m_mean,s.m_var,s.m_skew,s.m_kurt,s.m_min,s.m_max);
+	fprintf(fp,"EWMA: mean=%.9f, var=%.9f\n",s.m_ewma_mean,s.m_ewma_var);
+	fprintf(fp,"lag, acov, acor, parcor, aic\n");
+	for(int32_t __k = 0; __k <= s.m_lag; ++__k) {
+	    fprintf(fp,"%d %.16f %.16f %.16f %.16f\n",__k,s.m_acov[__k],s.m_acor[__k],
+		    (__k > 0) ? s.m_parcor[__k-1] : 1.0,s.m_aic[__k]);
+	}
+	fprintf(fp,"AR order (min. AIC)=%d, sigma2=%.16f\n",s.m_ar_order,s.m_ar_sigma2);
+	for(int32_t __i = 0; __i != s.m_ar_order; ++__i) fprintf(fp,"a(%d)=%.16f\n",__i+1,s.m_ar_coef[__i]);
+	fprintf(fp,"Changepoints: %llu (CUSUM+=%.3f, CUSUM-=%.3f%s)\n",static_cast<unsigned long long>(s.m_nchange),
+		s.m_cusum_pos,s.m_cusum_neg,s.m_in_warmup ? ", warm-up" : "");
+	for(const CpuPerfChangepoint & e : s.m_changes) {
+	    fprintf(fp,"alarm=%llu, start=%llu, dir=%+d, ref. mean=%.9f, ref. sd=%.9f\n",
+		    static_cast<unsigned long long>(e.m_alarm),static_cast<unsigned long long>(e.m_start),
+		    e.m_dir,e.m_ref_mean,e.m_ref_sd);
+	}
+}
@@ -0,0 +1,187 @@
+#ifndef __GMS_CPU_PERF_ONLINE_ANALYSIS_H__
+#define __GMS_CPU_PERF_ONLINE_ANALYSIS_H__
+
+// File version info
+namespace file_info {
+     const unsigned int gGMS_CPU_PERF_ONLINE_ANALYSIS_MAJOR = 1U;
+
+     const unsigned int gGMS_CPU_PERF_ONLINE_ANALYSIS_MINOR = 0U;
+
+     const unsigned int gGMS_CPU_PERF_ONLINE_ANALYSIS_MICRO = 0U;
+
+     const unsigned int gGMS_CPU_PERF_ONLINE_ANALYSIS_FULLVER =
+	1000U*gGMS_CPU_PERF_ONLINE_ANALYSIS_MAJOR+100U*gGMS_CPU_PERF_ONLINE_ANALYSIS_MINOR+10U*gGMS_CPU_PERF_ONLINE_ANALYSIS_MICRO;
+
+     const char * const pgGMS_CPU_PERF_ONLINE_ANALYSIS_CREATE_DATE = "24-10-2026 10:05 +00200 (SAT 24 OCT 2026 GMT+2)";
+
+     const char * const pgGMS_CPU_PERF_ONLINE_ANALYSIS_BUILD_DATE = __DATE__ " " __TIME__;
+
+     const char * const pgGMS_CPU_PERF_ONLINE_ANALYSIS_AUTHOR = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+
+     const char * const pgGMS_CPU_PERF_ONLINE_ANALYSIS_SYNOPSIS = "Streaming (online) analysis of CPU performance time series.";
+}
+
+/*
+    Online counterpart of GMS_cpu_perf_time_series_analysis.h (Timsac AUTCOR,
+    UNIMAR, CANARM on a whole sample) for a kernel latency (or a PMC delta)
+    sampled continuously in a long-running process: the samples are pushed
+    one at a time, the state is fixed at construction (O(lag) doubles, it
+    does not grow with the number of samples) and a snapshot is computed on
+    demand:
+         moments    -- mean, variance, skewness, excess kurtosis (Pebay's
+                       one-pass update), min, max, EWMA of the level,
+         autocorrelation up to the lag L -- the sums y(t)*y(t-k), k = 0..L,
+                       y = x-x(0), updated from a ring of the last L+1
+                       samples; the snapshot corrects them by the mean,
+                       the first and the last L samples, i.e. the biased
+                       estimator of AUTCOR c(k) = 1/n sum (x(t)-m)(x(t-k)-m),
+         AR fit     -- Levinson-Durbin on c(0..L), orders 0..L, AIC(m) =
+                       n*ln(sigma2(m))+2*m, the order of the minimum AIC
+                       (as UNIMAR), coefficients, PARCOR, innovation variance,
+         changepoints -- two-sided CUSUM (Page) of block means (m_block
+                       samples) standardized by the mean and deviation of the
+                       block means of a warm-up window; the blocks absorb the
+                       short-range correlation and the tails of latencies (a
+                       CUSUM of the raw samples alarms every ~10^4 samples on
+                       a stationary series, the defaults about once in 10^7
+                       samples, a shift by 2 sd within 2-3 blocks). An alarm
+                       records the change (the
+                       start estimated by the last zero of the statistic, to
+                       a block) and restarts the warm-up.
+    One writer: push() and snapshot() from one thread (or synchronized by
+    the caller). print_snapshot writes to a stream owned by the caller.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "GMS_config.h"
+
+// Capacity of the ring of the last changepoints kept by the analyzer.
+#if !defined(CPU_PERF_ONLINE_MAX_EVENTS)
+#define CPU_PERF_ONLINE_MAX_EVENTS 16
+#endif
+
+namespace gms {
+	namespace system {
+
+		/*
+			The analyzer raises m_lag and m_block below 1 to 1 and m_warmup below 2
+			to 2 (a lag 0 only would leave no AR fit, a single block no deviation of
+			the reference); CpuPerfOnlineAnalyzer::m_params holds the values in use.
+		*/
+		struct CpuPerfOnlineParams {
+
+			int32_t m_lag      = 32;      // max. lag of the autocorrelation and order of the AR fit, >= 1
+			int32_t m_block    = 32;      // samples per block mean of the CUSUM, >= 1
+			int32_t m_warmup   = 64;      // blocks of the CUSUM reference, >= 2
+			double  m_cusum_k  = 0.5;     // CUSUM drift (standard deviations of a block mean)
+			double  m_cusum_h  = 16.0;    // CUSUM alarm threshold (standard deviations of a block mean)
+			double  m_ewma     = 0.01;    // EWMA weight of the level
+		};
+
+		struct CpuPerfChangepoint {
+
+			uint64_t m_alarm;         // sample index of the alarm
+			uint64_t m_start;         // estimated first sample of the new level
+			int32_t  m_dir;           // +1 up, -1 down
+			double   m_ref_mean;      // level before the change
+			double   m_ref_sd;        // deviation of its block means
+		};
+
+		struct CpuPerfOnlineSnapshot {
+
+			uint64_t m_n;
+			double   m_mean;
+			double   m_var;           // unbiased
+			double   m_skew;
+			double   m_kurt;          // excess
+			double   m_min;
+			double   m_max;
+			double   m_ewma_mean;
+			double   m_ewma_var;
+			int32_t  m_lag;           // lags 0..m_lag valid (<= L, < n)
+			std::vector<double> m_acov;    // c(0..L)
+			std::vector<double> m_acor;    // c(k)/c(0)
+			int32_t  m_ar_order;      // order of the minimum AIC
+			double   m_ar_sigma2;     // its innovation variance
+			std::vector<double> m_ar_coef; // x(t)-m = sum a(i)*(x(t-i)-m) + e(t), i = 1..order
+			std::vector<double> m_parcor;  // 1..L
+			std::vector<double> m_aic;     // 0..L
+			uint64_t m_nchange;       // changepoints since the start
+			std::vector<CpuPerfChangepoint> m_changes; // the last ones, oldest first
+			bool     m_in_warmup;
+			double   m_cusum_pos;
+			double   m_cusum_neg;
+		};
+
+		struct CpuPerfOnlineAnalyzer {
+
+			CpuPerfOnlineParams m_params;
+
+			uint64_t m_n;
+
+			double   m_mean;
+
+			double   m_M2;
+
+			double   m_M3;
+
+			double   m_M4;
+
+			double   m_min;
+
+			double   m_max;
+
+			double   m_ewma_mean;
+
+			double   m_ewma_var;
+
+			double   m_shift;       // x(0), y = x-x(0)
+
+			double   m_ysum;
+
+			int32_t  m_head;        // ring position of the last sample
+
+			std::vector<double> m_ring;   // 2*(L+1), y(t-k) at m_head+k
+			std::vector<double> m_first;  // y(0..L)
+			std::vector<double> m_lagsum; // sum y(t)*y(t-k), k = 0..L
+
+			// CUSUM
+			int32_t  m_bcnt;
+			double   m_bsum;
+			uint64_t m_ref_n;
+			double   m_ref_mean;
+			double   m_ref_M2;
+			double   m_ref_sd;
+			double   m_gpos;
+			double   m_gneg;
+			uint64_t m_zpos;        // last sample of the last block with m_gpos == 0
+			uint64_t m_zneg;
+			uint64_t m_nchange;
+			CpuPerfChangepoint m_events[CPU_PERF_ONLINE_MAX_EVENTS];
+
+			CpuPerfOnlineAnalyzer(const CpuPerfOnlineParams &);
+
+			void reset();
+
+			// Returns true when the sample raised a changepoint alarm.
+			bool push(const double);
+
+			// Returns the number of alarms raised by the samples.
+			int32_t push(const double * __restrict,
+				     const std::size_t);
+
+			void snapshot(CpuPerfOnlineSnapshot &) const;
+
+			inline uint64_t samples() const noexcept(true) { return (m_n); }
+		};
+
+		void print_snapshot(FILE *,
+				    const char *,
+				    const CpuPerfOnlineSnapshot &);
+
+	}
+}
+
+#endif /*__GMS_CPU_PERF_ONLINE_ANALYSIS_H__*/
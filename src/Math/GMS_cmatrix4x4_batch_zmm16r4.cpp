@@ -0,0 +1,545 @@
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cfloat>
+#include <atomic>
+#include "GMS_cmatrix4x4_batch_zmm16r4.h"
+#include "GMS_par_team.h"
+#include "GMS_sleefsimdsp.h"
+
+namespace {
+
+       struct cz
+       {
+              __m512 re;
+              __m512 im;
+       };
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz cmul(const cz a,const cz b)
+       {
+              return (cz{_mm512_fmsub_ps(a.re,b.re,_mm512_mul_ps(a.im,b.im)),
+                         _mm512_fmadd_ps(a.re,b.im,_mm512_mul_ps(a.im,b.re))});
+       }
+
+       // a*conj(b)
+       __ATTR_ALWAYS_INLINE__
+       inline cz cmulc(const cz a,const cz b)
+       {
+              return (cz{_mm512_fmadd_ps(a.re,b.re,_mm512_mul_ps(a.im,b.im)),
+                         _mm512_fmsub_ps(a.im,b.re,_mm512_mul_ps(a.re,b.im))});
+       }
+
+       // c-a*b
+       __ATTR_ALWAYS_INLINE__
+       inline cz cfnmadd(const cz a,const cz b,const cz c)
+       {
+              return (cz{_mm512_fmadd_ps(a.im,b.im,_mm512_fnmadd_ps(a.re,b.re,c.re)),
+                         _mm512_fnmadd_ps(a.im,b.re,_mm512_fnmadd_ps(a.re,b.im,c.im))});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz cadd(const cz a,const cz b)
+       {
+              return (cz{_mm512_add_ps(a.re,b.re),_mm512_add_ps(a.im,b.im)});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz csub(const cz a,const cz b)
+       {
+              return (cz{_mm512_sub_ps(a.re,b.re),_mm512_sub_ps(a.im,b.im)});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz cscale(const cz a,const __m512 s)
+       {
+              return (cz{_mm512_mul_ps(a.re,s),_mm512_mul_ps(a.im,s)});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz cblend(const __mmask16 m,const cz a,const cz b)
+       {
+              return (cz{_mm512_mask_blend_ps(m,a.re,b.re),_mm512_mask_blend_ps(m,a.im,b.im)});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline __m512 cabs2(const cz a)
+       {
+              return (_mm512_fmadd_ps(a.re,a.re,_mm512_mul_ps(a.im,a.im)));
+       }
+
+       // |re|+|im| (LINPACK cabs1)
+       __ATTR_ALWAYS_INLINE__
+       inline __m512 cabs1(const cz a)
+       {
+              return (_mm512_add_ps(_mm512_abs_ps(a.re),_mm512_abs_ps(a.im)));
+       }
+
+       // 1/a, scaled by |re|+|im| (no underflow of |a|^2)
+       __ATTR_ALWAYS_INLINE__
+       inline cz crcp(const cz a)
+       {
+              const __m512 s{_mm512_div_ps(_mm512_set1_ps(1.0f),cabs1(a))};
+              const cz as{cscale(a,s)};
+              const __m512 r{_mm512_div_ps(s,cabs2(as))};
+              return (cz{_mm512_mul_ps(as.re,r),_mm512_sub_ps(_mm512_setzero_ps(),_mm512_mul_ps(as.im,r))});
+       }
+
+       // principal square root, no cancellation
+       __ATTR_ALWAYS_INLINE__
+       inline cz csqrt(const cz a)
+       {
+              const __m512 zero{_mm512_setzero_ps()};
+              const __m512 m{_mm512_sqrt_ps(cabs2(a))};
+              const __m512 t{_mm512_sqrt_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f),_mm512_add_ps(m,_mm512_abs_ps(a.re))))};
+              const __mmask16 nz{_mm512_cmp_ps_mask(t,zero,_CMP_GT_OQ)};
+              const __m512 q{_mm512_maskz_div_ps(nz,_mm512_mul_ps(_mm512_set1_ps(0.5f),a.im),t)};
+              const __mmask16 pos{_mm512_cmp_ps_mask(a.re,zero,_CMP_GE_OQ)};
+              // re >= 0: (t, im/2t), re < 0: (|im|/2t, sign(im)*t)
+              const __m512 sgn_t{_mm512_or_ps(t,_mm512_and_ps(a.im,_mm512_set1_ps(-0.0f)))};
+              return (cz{_mm512_mask_blend_ps(pos,_mm512_abs_ps(q),t),
+                         _mm512_mask_blend_ps(pos,sgn_t,q)});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline cz ld(const gms::math::C4x4_ZMM16C4 & a,const int32_t i)
+       {
+              return (cz{a.re[i],a.im[i]});
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void st(gms::math::C4x4_ZMM16C4 & a,const int32_t i,const cz v)
+       {
+              a.re[i] = v.re;
+              a.im[i] = v.im;
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void set_identity(gms::math::C4x4_ZMM16C4 & a)
+       {
+              for(int32_t __i{0}; __i != 16; ++__i)
+              {
+                  a.re[__i] = (__i%5 == 0) ? _mm512_set1_ps(1.0f) : _mm512_setzero_ps();
+                  a.im[__i] = _mm512_setzero_ps();
+              }
+       }
+
+       // max. column sum of |re|+|im|
+       __ATTR_ALWAYS_INLINE__
+       inline __m512 norm1(const gms::math::C4x4_ZMM16C4 & a)
+       {
+              __m512 nrm{_mm512_setzero_ps()};
+              for(int32_t __j{0}; __j != 4; ++__j)
+              {
+                  __m512 s{_mm512_setzero_ps()};
+                  for(int32_t __i{0}; __i != 4; ++__i) s = _mm512_add_ps(s,cabs1(ld(a,4*__i+__j)));
+                  nrm = _mm512_max_ps(nrm,s);
+              }
+              return (nrm);
+       }
+
+       // eigenvector of the 2x2 [a b; c d] for mu, unit length, e if undetermined
+       __ATTR_ALWAYS_INLINE__
+       inline void eigvec2(const cz a,const cz b,const cz c,const cz d,const cz mu,
+                           const __m512 tiny,const int32_t e,cz & u0,cz & u1)
+       {
+              const cz v0{b};
+              const cz v1{csub(mu,a)};
+              const cz w0{csub(mu,d)};
+              const cz w1{c};
+              const __m512 nv{_mm512_add_ps(cabs2(v0),cabs2(v1))};
+              const __m512 nw{_mm512_add_ps(cabs2(w0),cabs2(w1))};
+              const __mmask16 use_w{_mm512_cmp_ps_mask(nw,nv,_CMP_GT_OQ)};
+              const __m512 n{_mm512_max_ps(nv,nw)};
+              const __mmask16 undet{_mm512_cmp_ps_mask(n,tiny,_CMP_LE_OQ)};
+              const __m512 r{_mm512_div_ps(_mm512_set1_ps(1.0f),_mm512_sqrt_ps(_mm512_mask_blend_ps(undet,n,_mm512_set1_ps(1.0f))))};
+              u0 = cscale(cblend(use_w,v0,w0),r);
+              u1 = cscale(cblend(use_w,v1,w1),r);
+              const cz one{_mm512_set1_ps(1.0f),_mm512_setzero_ps()};
+              const cz zero{_mm512_setzero_ps(),_mm512_setzero_ps()};
+              u0 = cblend(undet,u0,(e == 0) ? one : zero);
+              u1 = cblend(undet,u1,(e == 0) ? zero : one);
+       }
+
+}
+
+void
+gms::math::c4x4_set_lane(C4x4_ZMM16C4 & a,
+                         const int32_t lane,
+                         const std::complex<float> * __restrict m)
+{
+       for(int32_t __i{0}; __i != 16; ++__i)
+       {
+           reinterpret_cast<float*>(&a.re[__i])[lane] = m[__i].real();
+           reinterpret_cast<float*>(&a.im[__i])[lane] = m[__i].imag();
+       }
+}
+
+void
+gms::math::c4x4_get_lane(const C4x4_ZMM16C4 & a,
+                         const int32_t lane,
+                         std::complex<float> * __restrict m)
+{
+       for(int32_t __i{0}; __i != 16; ++__i)
+           m[__i] = std::complex<float>(reinterpret_cast<const float*>(&a.re[__i])[lane],
+                                        reinterpret_cast<const float*>(&a.im[__i])[lane]);
+}
+
+void
+gms::math::c2x2_set_lane(C2x2_ZMM16C4 & a,
+                         const int32_t lane,
+                         const std::complex<float> * __restrict m)
+{
+       for(int32_t __i{0}; __i != 4; ++__i)
+       {
+           reinterpret_cast<float*>(&a.re[__i])[lane] = m[__i].real();
+           reinterpret_cast<float*>(&a.im[__i])[lane] = m[__i].imag();
+       }
+}
+
+void
+gms::math::mul4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict a,
+                                const C4x4_ZMM16C4 & __restrict b,
+                                C4x4_ZMM16C4 & __restrict c)
+{
+       for(int32_t __i{0}; __i != 4; ++__i)
+       {
+           for(int32_t __j{0}; __j != 4; ++__j)
+           {
+               cz s{cmul(ld(a,4*__i),ld(b,__j))};
+               for(int32_t __k{1}; __k != 4; ++__k)
+               {
+                   const cz x{ld(a,4*__i+__k)};
+                   const cz y{ld(b,4*__k+__j)};
+                   s.re = _mm512_fmadd_ps(x.re,y.re,_mm512_fnmadd_ps(x.im,y.im,s.re));
+                   s.im = _mm512_fmadd_ps(x.re,y.im,_mm512_fmadd_ps(x.im,y.re,s.im));
+               }
+               st(c,4*__i+__j,s);
+           }
+       }
+}
+
+__mmask16
+gms::math::inv4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict a,
+                                C4x4_ZMM16C4 & __restrict inv)
+{
+       cz w[16];
+       for(int32_t __i{0}; __i != 16; ++__i) w[__i] = ld(a,__i);
+       set_identity(inv);
+       const __m512 tol{_mm512_mul_ps(_mm512_set1_ps(FLT_EPSILON),norm1(a))};
+       __mmask16 sing{0};
+       for(int32_t __k{0}; __k != 4; ++__k)
+       {
+           // pivot row per lane
+           __m512 piv{cabs1(w[4*__k+__k])};
+           __m512i prow{_mm512_set1_epi32(__k)};
+           for(int32_t __i{__k+1}; __i != 4; ++__i)
+           {
+               const __m512 c{cabs1(w[4*__i+__k])};
+               const __mmask16 m{_mm512_cmp_ps_mask(c,piv,_CMP_GT_OQ)};
+               piv  = _mm512_mask_blend_ps(m,piv,c);
+               prow = _mm512_mask_blend_epi32(m,prow,_mm512_set1_epi32(__i));
+           }
+           for(int32_t __i{__k+1}; __i != 4; ++__i)
+           {
+               const __mmask16 m{_mm512_cmpeq_epi32_mask(prow,_mm512_set1_epi32(__i))};
+               if(m == 0) continue;
+               for(int32_t __j{0}; __j != 4; ++__j)
+               {
+                   const cz wk{w[4*__k+__j]};
+                   w[4*__k+__j] = cblend(m,wk,w[4*__i+__j]);
+                   w[4*__i+__j] = cblend(m,w[4*__i+__j],wk);
+                   const cz bk{ld(inv,4*__k+__j)};
+                   st(inv,4*__k+__j,cblend(m,bk,ld(inv,4*__i+__j)));
+                   st(inv,4*__i+__j,cblend(m,ld(inv,4*__i+__j),bk));
+               }
+           }
+           // also catches NaN pivots
+           const __mmask16 s{_mm512_cmp_ps_mask(piv,tol,_CMP_NGT_UQ)};
+           sing |= s;
+           const cz one{_mm512_set1_ps(1.0f),_mm512_setzero_ps()};
+           const cz r{crcp(cblend(s,w[4*__k+__k],one))};
+           for(int32_t __j{0}; __j != 4; ++__j)
+           {
+               w[4*__k+__j] = cmul(w[4*__k+__j],r);
+               st(inv,4*__k+__j,cmul(ld(inv,4*__k+__j),r));
+           }
+           for(int32_t __i{0}; __i != 4; ++__i)
+           {
+               if(__i == __k) continue;
+               const cz f{w[4*__i+__k]};
+               for(int32_t __j{0}; __j != 4; ++__j)
+               {
+                   w[4*__i+__j] = cfnmadd(f,w[4*__k+__j],w[4*__i+__j]);
+                   st(inv,4*__i+__j,cfnmadd(f,ld(inv,4*__k+__j),ld(inv,4*__i+__j)));
+               }
+           }
+       }
+       return (sing);
+}
+
+void
+gms::math::extinct_m4x4_zmm16r4(const C2x2_ZMM16C4 & __restrict M,
+                                R4x4_ZMM16R4 & __restrict K)
+{
+       const __m512 two{_mm512_set1_ps(2.0f)};
+       const __m512 zero{_mm512_setzero_ps()};
+       const __m512 rs{_mm512_add_ps(M.re[0],M.re[3])};
+       const __m512 id{_mm512_sub_ps(M.im[0],M.im[3])};
+       // -A, dI/ds = A*I
+       K.m[0]  = _mm512_mul_ps(_mm512_set1_ps(-2.0f),M.re[0]);
+       K.m[1]  = zero;
+       K.m[2]  = _mm512_sub_ps(zero,M.re[1]);
+       K.m[3]  = _mm512_sub_ps(zero,M.im[1]);
+       K.m[4]  = zero;
+       K.m[5]  = _mm512_mul_ps(_mm512_set1_ps(-2.0f),M.re[3]);
+       K.m[6]  = _mm512_sub_ps(zero,M.re[2]);
+       K.m[7]  = M.im[2];
+       K.m[8]  = _mm512_mul_ps(_mm512_set1_ps(-2.0f),M.re[2]);
+       K.m[9]  = _mm512_mul_ps(_mm512_set1_ps(-2.0f),M.re[1]);
+       K.m[10] = _mm512_sub_ps(zero,rs);
+       K.m[11] = id;
+       K.m[12] = _mm512_mul_ps(two,M.im[2]);
+       K.m[13] = _mm512_mul_ps(_mm512_set1_ps(-2.0f),M.im[1]);
+       K.m[14] = _mm512_sub_ps(zero,id);
+       K.m[15] = _mm512_sub_ps(zero,rs);
+}
+
+__mmask16
+gms::math::eigen4x4_extinct_zmm16r4(const C2x2_ZMM16C4 & __restrict M,
+                                    C4_ZMM16C4 & __restrict l,
+                                    C4x4_ZMM16C4 & __restrict Q,
+                                    C4x4_ZMM16C4 & __restrict invQ)
+{
+       const __m512 half{_mm512_set1_ps(0.5f)};
+       const __m512 zero{_mm512_setzero_ps()};
+       const cz a{M.re[0],M.im[0]};
+       const cz b{M.re[1],M.im[1]};
+       const cz c{M.re[2],M.im[2]};
+       const cz d{M.re[3],M.im[3]};
+       // mu = (a+d +- r)/2, r = sqrt((a-d)^2+4bc) of the sign which keeps |a-d+r| large
+       const cz diff{csub(a,d)};
+       const cz bc{cmul(b,c)};
+       const cz disc{cadd(cmul(diff,diff),cscale(bc,_mm512_set1_ps(4.0f)))};
+       cz r{csqrt(disc)};
+       const __m512 dot{_mm512_fmadd_ps(diff.re,r.re,_mm512_mul_ps(diff.im,r.im))};
+       const __mmask16 neg{_mm512_cmp_ps_mask(dot,zero,_CMP_LT_OQ)};
+       r = cblend(neg,r,cz{_mm512_sub_ps(zero,r.re),_mm512_sub_ps(zero,r.im)});
+       const cz sum{cadd(a,d)};
+       const cz mu1{cscale(cadd(sum,r),half)};
+       const cz mu2{cscale(csub(sum,r),half)};
+       const __m512 scale{_mm512_add_ps(_mm512_add_ps(cabs1(a),cabs1(b)),_mm512_add_ps(cabs1(c),cabs1(d)))};
+       const __m512 eps_s{_mm512_mul_ps(_mm512_set1_ps(FLT_EPSILON),scale)};
+       const __m512 tiny{_mm512_max_ps(_mm512_mul_ps(eps_s,eps_s),_mm512_set1_ps(FLT_MIN))};
+       cz U[2][2];   // U[i][a], column a -- eigenvector of mu_a
+       eigvec2(a,b,c,d,mu1,tiny,0,U[0][0],U[1][0]);
+       eigvec2(a,b,c,d,mu2,tiny,1,U[0][1],U[1][1]);
+       const cz det{csub(cmul(U[0][0],U[1][1]),cmul(U[0][1],U[1][0]))};
+       const __m512 tol{_mm512_set1_ps(C4X4_EIG_DEFECT_TOL*C4X4_EIG_DEFECT_TOL)};
+       const __mmask16 defect{_mm512_cmp_ps_mask(cabs2(det),tol,_CMP_NGE_UQ)};
+       const cz rdet{crcp(cblend(defect,det,cz{_mm512_set1_ps(1.0f),zero}))};
+       cz V[2][2];   // inverse of U
+       V[0][0] = cmul(U[1][1],rdet);
+       V[1][1] = cmul(U[0][0],rdet);
+       V[0][1] = cmul(cz{_mm512_sub_ps(zero,U[0][1].re),_mm512_sub_ps(zero,U[0][1].im)},rdet);
+       V[1][0] = cmul(cz{_mm512_sub_ps(zero,U[1][0].re),_mm512_sub_ps(zero,U[1][0].im)},rdet);
+       const cz mu[2] = {mu1,mu2};
+       const int32_t pa[4] = {0,1,0,1};
+       const int32_t pb[4] = {0,1,1,0};
+       for(int32_t __p{0}; __p != 4; ++__p)
+       {
+           const int32_t ia{pa[__p]};
+           const int32_t ib{pb[__p]};
+           // l = -(mu_a+conj(mu_b))
+           l.re[__p] = _mm512_sub_ps(zero,_mm512_add_ps(mu[ia].re,mu[ib].re));
+           l.im[__p] = _mm512_sub_ps(mu[ib].im,mu[ia].im);
+           // column p of Q: Stokes vector of u_a*u_b^H
+           const cz c00{cmulc(U[0][ia],U[0][ib])};
+           const cz c11{cmulc(U[1][ia],U[1][ib])};
+           const cz c01{cmulc(U[0][ia],U[1][ib])};
+           const cz c10{cmulc(U[1][ia],U[0][ib])};
+           const cz dc{csub(c01,c10)};
+           st(Q,__p,c00);
+           st(Q,4+__p,c11);
+           st(Q,8+__p,cadd(c01,c10));
+           st(Q,12+__p,cz{dc.im,_mm512_sub_ps(zero,dc.re)});            // -i*(c01-c10)
+           // row p of inv(Q): coefficient of u_a*u_b^H in C = (V row a)^T*C*conj(V row b)
+           const cz p00{cmulc(V[ia][0],V[ib][0])};
+           const cz p11{cmulc(V[ia][1],V[ib][1])};
+           const cz p01{cmulc(V[ia][0],V[ib][1])};
+           const cz p10{cmulc(V[ia][1],V[ib][0])};
+           const cz dp{cscale(csub(p01,p10),half)};
+           st(invQ,4*__p,p00);
+           st(invQ,4*__p+1,p11);
+           st(invQ,4*__p+2,cscale(cadd(p01,p10),half));
+           st(invQ,4*__p+3,cz{_mm512_sub_ps(zero,dp.im),dp.re});        // i*(p01-p10)/2
+       }
+       return (defect);
+}
+
+void
+gms::math::exp4x4_eig_zmm16r4(const C4_ZMM16C4 & __restrict l,
+                              const C4x4_ZMM16C4 & __restrict Q,
+                              const C4x4_ZMM16C4 & __restrict invQ,
+                              const __m512 z,
+                              C4x4_ZMM16C4 & __restrict result)
+{
+       cz e[4];
+       for(int32_t __k{0}; __k != 4; ++__k)
+       {
+           const __m512 m{xexpf(_mm512_mul_ps(l.re[__k],z))};
+           const __m512 ph{_mm512_mul_ps(l.im[__k],z)};
+           e[__k] = cz{_mm512_mul_ps(m,xcosf(ph)),_mm512_mul_ps(m,xsinf(ph))};
+       }
+       C4x4_ZMM16C4 qe;
+       for(int32_t __i{0}; __i != 4; ++__i)
+           for(int32_t __k{0}; __k != 4; ++__k) st(qe,4*__i+__k,cmul(ld(Q,4*__i+__k),e[__k]));
+       mul4x4_cmplx_zmm16r4(qe,invQ,result);
+}
+
+void
+gms::math::exp4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict a,
+                                const __m512 z,
+                                C4x4_ZMM16C4 & __restrict result)
+{
+       constexpr int32_t degree{8};
+       const __m512 theta{_mm512_set1_ps(0.5f)};
+       C4x4_ZMM16C4 B;
+       for(int32_t __i{0}; __i != 16; ++__i) st(B,__i,cscale(ld(a,__i),z));
+       // s per lane: ||B||_1/2^s <= theta
+       const __m512 nrm{norm1(B)};
+       const __mmask16 big{_mm512_cmp_ps_mask(nrm,theta,_CMP_GT_OQ)};
+       __m512 s{_mm512_maskz_add_ps(big,_mm512_getexp_ps(_mm512_div_ps(nrm,theta)),_mm512_set1_ps(1.0f))};
+       s = _mm512_min_ps(s,_mm512_set1_ps(126.0f));
+       const __m512 ns{_mm512_sub_ps(_mm512_setzero_ps(),s)};
+       for(int32_t __i{0}; __i != 16; ++__i)
+       {
+           B.re[__i] = _mm512_scalef_ps(B.re[__i],ns);
+           B.im[__i] = _mm512_scalef_ps(B.im[__i],ns);
+       }
+       // Horner: X = I+B/k*X, k = degree..1
+       C4x4_ZMM16C4 X,T;
+       set_identity(X);
+       for(int32_t __k{degree}; __k != 0; --__k)
+       {
+           mul4x4_cmplx_zmm16r4(B,X,T);
+           const __m512 rk{_mm512_set1_ps(1.0f/static_cast<float>(__k))};
+           for(int32_t __i{0}; __i != 16; ++__i)
+           {
+               X.re[__i] = (__i%5 == 0) ? _mm512_fmadd_ps(T.re[__i],rk,_mm512_set1_ps(1.0f)) : _mm512_mul_ps(T.re[__i],rk);
+               X.im[__i] = _mm512_mul_ps(T.im[__i],rk);
+           }
+       }
+       // squaring, the lanes with fewer steps keep their result
+       alignas(64) float sv[16];
+       _mm512_store_ps(sv,s);
+       float smax{0.0f};
+       for(int32_t __l{0}; __l != 16; ++__l) smax = (sv[__l] > smax) ? sv[__l] : smax;
+       for(int32_t __q{0}; __q < static_cast<int32_t>(smax); ++__q)
+       {
+           const __mmask16 m{_mm512_cmp_ps_mask(_mm512_set1_ps(static_cast<float>(__q)),s,_CMP_LT_OQ)};
+           mul4x4_cmplx_zmm16r4(X,X,T);
+           for(int32_t __i{0}; __i != 16; ++__i)
+           {
+               X.re[__i] = _mm512_mask_blend_ps(m,X.re[__i],T.re[__i]);
+               X.im[__i] = _mm512_mask_blend_ps(m,X.im[__i],T.im[__i]);
+           }
+       }
+       result = X;
+}
+
+__mmask16
+gms::math::extinct_exp4x4_zmm16r4(const C2x2_ZMM16C4 & __restrict M,
+                                  const __m512 z,
+                                  R4x4_ZMM16R4 & __restrict E)
+{
+       C4_ZMM16C4 l;
+       C4x4_ZMM16C4 Q,invQ,R;
+       const __mmask16 defect{eigen4x4_extinct_zmm16r4(M,l,Q,invQ)};
+       exp4x4_eig_zmm16r4(l,Q,invQ,_mm512_sub_ps(_mm512_setzero_ps(),z),R);
+       for(int32_t __i{0}; __i != 16; ++__i) E.m[__i] = R.re[__i];
+       if(defect != 0)
+       {
+          R4x4_ZMM16R4 K;
+          extinct_m4x4_zmm16r4(M,K);
+          C4x4_ZMM16C4 A;
+          for(int32_t __i{0}; __i != 16; ++__i)
+          {
+              A.re[__i] = K.m[__i];
+              A.im[__i] = _mm512_setzero_ps();
+          }
+          exp4x4_cmplx_zmm16r4(A,_mm512_sub_ps(_mm512_setzero_ps(),z),R);
+          for(int32_t __i{0}; __i != 16; ++__i) E.m[__i] = _mm512_mask_blend_ps(defect,E.m[__i],R.re[__i]);
+       }
+       return (defect);
+}
+
+int32_t
+gms::math::inv4x4_cmplx_batch(const C4x4_ZMM16C4 * __restrict a,
+                              C4x4_ZMM16C4 * __restrict inv,
+                              __mmask16 * __restrict singular,
+                              const int32_t n)
+{
+       int32_t cnt{0};
+       for(int32_t __i{0}; __i != n; ++__i)
+       {
+           const __mmask16 m{inv4x4_cmplx_zmm16r4(a[__i],inv[__i])};
+           if(singular != nullptr) singular[__i] = m;
+           cnt += __builtin_popcount(m);
+       }
+       return (cnt);
+}
+
+int32_t
+gms::math::extinct_exp4x4_batch(const C2x2_ZMM16C4 * __restrict M,
+                                const __m512 * __restrict z,
+                                R4x4_ZMM16R4 * __restrict E,
+                                __mmask16 * __restrict defective,
+                                const int32_t n)
+{
+       int32_t cnt{0};
+       for(int32_t __i{0}; __i != n; ++__i)
+       {
+           const __mmask16 m{extinct_exp4x4_zmm16r4(M[__i],z[__i],E[__i])};
+           if(defective != nullptr) defective[__i] = m;
+           cnt += __builtin_popcount(m);
+       }
+       return (cnt);
+}
+
+int32_t
+gms::math::extinct_exp4x4_batch_par(const C2x2_ZMM16C4 * __restrict M,
+                                    const __m512 * __restrict z,
+                                    R4x4_ZMM16R4 * __restrict E,
+                                    __mmask16 * __restrict defective,
+                                    const int32_t n)
+{
+       using namespace gms::common;
+       if(n <= 0) return (0);
+       std::atomic<int32_t> cnt{0};
+       par_for(par_family::SERIES,static_cast<std::size_t>(n),sizeof(R4x4_ZMM16R4),1,
+               [&](const std::size_t lo,const std::size_t hi) {
+                    const int32_t c{extinct_exp4x4_batch(M+lo,z+lo,E+lo,(defective != nullptr) ? defective+lo : nullptr,
+                                                         static_cast<int32_t>(hi-lo))};
+                    cnt.fetch_add(c,std::memory_order_relaxed);
+               });
+       return (cnt.load());
+}
@@ -0,0 +1,198 @@
+#ifndef __GMS_CMATRIX4X4_BATCH_ZMM16R4_H__
+#define __GMS_CMATRIX4X4_BATCH_ZMM16R4_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_CMATRIX4X4_BATCH_ZMM16R4_MAJOR = 1U;
+    const unsigned int GMS_CMATRIX4X4_BATCH_ZMM16R4_MINOR = 0U;
+    const unsigned int GMS_CMATRIX4X4_BATCH_ZMM16R4_MICRO = 0U;
+    const unsigned int GMS_CMATRIX4X4_BATCH_ZMM16R4_FULLVER =
+      1000U*GMS_CMATRIX4X4_BATCH_ZMM16R4_MAJOR+100U*GMS_CMATRIX4X4_BATCH_ZMM16R4_MINOR+
+      10U*GMS_CMATRIX4X4_BATCH_ZMM16R4_MICRO;
+    const char * const GMS_CMATRIX4X4_BATCH_ZMM16R4_CREATION_DATE = "23-10-2026 09:15 AM +00200 (FRI 23 OCT 2026 GMT+2)";
+    const char * const GMS_CMATRIX4X4_BATCH_ZMM16R4_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_CMATRIX4X4_BATCH_ZMM16R4_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_CMATRIX4X4_BATCH_ZMM16R4_DESCRIPTION   = "Batched complex 4x4 inversion, eigendecomposition and exponential, 16 matrices per AVX512 register set.";
+
+}
+
+/*
+     Batched counterparts of exp4x4m_cmplxr4v1/v2, eigen4x4_cmplxr4, invm4x4_cmplxr4
+     and extinct_m4x4r4 (GMS_matrix_computations.h) for the layer radiative
+     transfer: one matrix per lane, a block of 16 matrices stored as SoA,
+     element (i,j) of the matrix k in the lane k of re[4*i+j], im[4*i+j]
+     (the row-major order of the scalar std::complex<float>[16] arguments).
+     Forward-scattering amplitudes M (2x2, order vv, vh, hv, hh as the argument
+     of extinct_m4x4r4) define the coherent field dE/ds = M*E, E = (Ev,Eh), and
+     the extinction matrix of the Stokes vector (Iv, Ih, U, V) dI/ds = -K*I
+     (Tsang, Kong, Shin, "Theory of Microwave Remote Sensing", ch. 3):
+          K = -| 2Re Mvv   0         Re Mvh          Im Mvh         |
+               | 0         2Re Mhh   Re Mhv         -Im Mhv         |
+               | 2Re Mhv   2Re Mvh   Re(Mvv+Mhh)   -Im(Mvv-Mhh)     |
+               |-2Im Mhv   2Im Mvh   Im(Mvv-Mhh)    Re(Mvv+Mhh)     |
+     Its eigenvalues are -(mu_a+conj(mu_b)), mu_1, mu_2 the eigenvalues of M,
+     and the eigenvectors the Stokes vectors of u_a*u_b^H (u the eigenvectors
+     of M), so the decomposition K = Q*diag(l)*inv(Q) is in closed form, inv(Q)
+     from the 2x2 inverse of [u_1 u_2]. Order of l: (1,1), (2,2), (1,2), (2,1).
+     When M is (nearly) defective (|det[u_1 u_2]| < C4X4_EIG_DEFECT_TOL, unit
+     eigenvectors) Q is ill-conditioned, those lanes are flagged and
+     extinct_exp4x4_zmm16r4 computes them by scaling and squaring instead.
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include <complex>
+#include "GMS_config.h"
+
+// Lanes of eigen4x4_extinct_zmm16r4 with |det[u_1 u_2]| below it are defective.
+#if !defined(C4X4_EIG_DEFECT_TOL)
+#define C4X4_EIG_DEFECT_TOL 0.05f
+#endif
+
+namespace gms {
+
+        namespace math {
+
+                  struct alignas(64) C4x4_ZMM16C4
+                  {
+                         __m512 re[16];
+                         __m512 im[16];
+                  };
+
+                  struct alignas(64) R4x4_ZMM16R4
+                  {
+                         __m512 m[16];
+                  };
+
+                  // forward-scattering amplitudes vv, vh, hv, hh
+                  struct alignas(64) C2x2_ZMM16C4
+                  {
+                         __m512 re[4];
+                         __m512 im[4];
+                  };
+
+                  struct alignas(64) C4_ZMM16C4
+                  {
+                         __m512 re[4];
+                         __m512 im[4];
+                  };
+
+                  // Lane access in the layout of the scalar routines (row-major std::complex<float>[16]).
+                  void c4x4_set_lane(C4x4_ZMM16C4 &,
+                                     const int32_t,
+                                     const std::complex<float> * __restrict);
+
+                  void c4x4_get_lane(const C4x4_ZMM16C4 &,
+                                     const int32_t,
+                                     std::complex<float> * __restrict);
+
+                  void c2x2_set_lane(C2x2_ZMM16C4 &,
+                                     const int32_t,
+                                     const std::complex<float> * __restrict);
+
+                  /*
+                       c = a*b
+                  */
+                  __ATTR_HOT__
+                  void mul4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict,
+                                            const C4x4_ZMM16C4 & __restrict,
+                                            C4x4_ZMM16C4 & __restrict);
+
+                  /*
+                       Gauss-Jordan with partial pivoting per lane (pivot of the largest
+                       |re|+|im| as LINPACK CGEFA). Returns the lanes which are singular
+                       (a pivot <= FLT_EPSILON*||a||_1), their inverse is unspecified.
+                  */
+                  __ATTR_HOT__
+                  __mmask16 inv4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict,
+                                                 C4x4_ZMM16C4 & __restrict);
+
+                  __ATTR_HOT__
+                  void extinct_m4x4_zmm16r4(const C2x2_ZMM16C4 & __restrict,
+                                            R4x4_ZMM16R4 & __restrict);
+
+                  /*
+                       K(M) = Q*diag(l)*inv(Q), returns the defective lanes (l and Q
+                       valid, inv(Q) unspecified).
+                  */
+                  __ATTR_HOT__
+                  __mmask16 eigen4x4_extinct_zmm16r4(const C2x2_ZMM16C4 & __restrict,
+                                                     C4_ZMM16C4 & __restrict,
+                                                     C4x4_ZMM16C4 & __restrict,
+                                                     C4x4_ZMM16C4 & __restrict);
+
+                  /*
+                       result = Q*diag(exp(l*z))*inv(Q) (exp4x4m_cmplxr4v1), z per lane.
+                  */
+                  __ATTR_HOT__
+                  void exp4x4_eig_zmm16r4(const C4_ZMM16C4 & __restrict,
+                                          const C4x4_ZMM16C4 & __restrict,
+                                          const C4x4_ZMM16C4 & __restrict,
+                                          const __m512,
+                                          C4x4_ZMM16C4 & __restrict);
+
+                  /*
+                       result = exp(a*z) of any matrix, scaling (per lane) and squaring
+                       of the Taylor polynomial of degree 8 (||a*z/2^s||_1 <= 0.5).
+                  */
+                  __ATTR_HOT__
+                  void exp4x4_cmplx_zmm16r4(const C4x4_ZMM16C4 & __restrict,
+                                            const __m512,
+                                            C4x4_ZMM16C4 & __restrict);
+
+                  /*
+                       E = exp(-K(M)*z), the layer transmission of the Stokes vector:
+                       eigendecomposition, scaling and squaring for the defective lanes.
+                       Returns the defective lanes.
+                  */
+                  __ATTR_HOT__
+                  __mmask16 extinct_exp4x4_zmm16r4(const C2x2_ZMM16C4 & __restrict,
+                                                   const __m512,
+                                                   R4x4_ZMM16R4 & __restrict);
+
+                  /*
+                       Batches of n blocks (16*n matrices), singular/defective masks
+                       per block (may be nullptr), return the number of such lanes.
+                  */
+                  int32_t inv4x4_cmplx_batch(const C4x4_ZMM16C4 * __restrict,
+                                             C4x4_ZMM16C4 * __restrict,
+                                             __mmask16 * __restrict,
+                                             const int32_t);
+
+                  int32_t extinct_exp4x4_batch(const C2x2_ZMM16C4 * __restrict,
+                                               const __m512 * __restrict,
+                                               R4x4_ZMM16R4 * __restrict,
+                                               __mmask16 * __restrict,
+                                               const int32_t);
+
+                  // Parallel, the worker team of GMS_par_team (family SERIES).
+                  int32_t extinct_exp4x4_batch_par(const C2x2_ZMM16C4 * __restrict,
+                                                   const __m512 * __restrict,
+                                                   R4x4_ZMM16R4 * __restrict,
+                                                   __mmask16 * __restrict,
+                                                   const int32_t);
+
+        } // math
+
+} // gms
+
+#endif /*__GMS_CMATRIX4X4_BATCH_ZMM16R4_H__*/
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cmath>
 #include "GMS_idealized_topo.h"
+#include "GMS_indices.h"
 
 
 
@@ -33,8 +34,8 @@
 						    float * __restrict __ATTR_ALIGN__(64) zsurf,
 						    const float height) {
 
-			      if(__builtin_expect(lon<=0,0) ||
-			         __builtin_expect(lat<=0,0)) {
+			      if(__builtin_expect(nlon<=0,0) ||
+			         __builtin_expect(nlat<=0,0)) {
                                  return;
 			      }
 
@@ -46,7 +47,7 @@
 			      constexpr float wlat = wlon;
 			      constexpr float rlon = 0.0f;
 			      constexpr float rlat = 0.0f;
-			      constexpr float inwlat = 0.066666666666666666666666666667f;
+			      constexpr float inwlat = 1.0f/wlat;
 			      constexpr float inwlon = inwlat;
 			      float xx = 0.0f;
 			      float yy = 0.0f;
@@ -66,13 +67,13 @@
 			      #pragma prefetch lon:0:4
 			      #pragma prefetch lon:1:16
 #endif
-                              #pragma omp simd simdlen(4) linear(i:1) private(ilon,dx,xx)
+                              #pragma omp simd simdlen(4)
                               for(int32_t i = 0; i != nlon; ++i) {
 			          const float ilon = lon[i];
                                   float dx = std::abs(ilon-olon);
 				  dx       = std::min(dx,std::abs(dx-tpi));
 				  xx = std::max(0.0f,dx-rlon)*inwlon;
-				  #pragma omp simd simdlen(4) linear(j:1) private(ilat,dy,yy)
+				  #pragma omp simd simdlen(4)
 				  for(int32_t j = 0; j != nlat; ++j) {
 				      const float ilat = lat[j];
                                       const float dy = std::abs(ilat-olat);
@@ -91,8 +92,8 @@
 						    double * __restrict __ATTR_ALIGN__(64) zsurf,
 						    const double height) {
 
-			      if(__builtin_expect(lon<=0,0) ||
-			         __builtin_expect(lat<=0,0)) {
+			      if(__builtin_expect(nlon<=0,0) ||
+			         __builtin_expect(nlat<=0,0)) {
                                  return;
 			      }
 
@@ -104,7 +105,7 @@
 			      constexpr double wlat = wlon;
 			      constexpr double rlon = 0.0;
 			      constexpr double rlat = 0.0;
-			      constexpr double inwlat = 0.066666666666666666666666666667;
+			      constexpr double inwlat = 1.0/wlat;
 			      constexpr double inwlon = inwlat;
 			      double xx = 0.0;
 			      double yy = 0.0;
@@ -124,13 +125,13 @@
 			      #pragma prefetch lon:0:4
 			      #pragma prefetch lon:1:16
 #endif
-                              #pragma omp simd simdlen(8) linear(i:1) private(ilon,dx,xx)
+                              #pragma omp simd simdlen(8)
                               for(int32_t i = 0; i != nlon; ++i) {
 			          const double ilon = lon[i];
                                   double dx = std::abs(ilon-olon);
 				  dx       = std::min(dx,std::abs(dx-tpi));
 				  xx = std::max(0.0,dx-rlon)*inwlon;
-				  #pragma omp simd simdlen(8) linear(j:1) private(ilat,dy,yy)
+				  #pragma omp simd simdlen(8)
 				  for(int32_t j = 0; j != nlat; ++j) {
 				      const double ilat = lat[j];
                                       const double dy = std::abs(ilat-olat);
@@ -27,7 +27,7 @@ namespace file_info {
        10U*GMS_IDEALIZED_TOPO_MICRO;
      const char * const GMS_IDEALIZED_TOPO_CREATION_DATE = "16-01-2022 09:34 +00200 (SAT 16 APR 2022 GMT+2)";
      const char * const GMS_IDEALIZED_TOPO_BUILD_DATE    = __DATE__ " " __TIME__;
-     const char * const GMS_IDEALIZED_TOPO_SYNOPSIS      = "Idealized gaussian and sinusoidal topography simulator."
+     const char * const GMS_IDEALIZED_TOPO_SYNOPSIS      = "Idealized gaussian and sinusoidal topography simulator.";
 
 }
 
@@ -0,0 +1,1061 @@
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+#include "GMS_lsoda_ensemble_zmm8r8.h"
+
+/*
+     The control part follows dlsoda_/dstoda_/dprja_ of GMS_cuLsoda.cuh label by
+     label (D -- DLSODA, S -- DSTODA, J -- DPRJA), the f2c locals which live across
+     a request are LsodaLane members. yh columns are 0-based here: YH(i,j) of the
+     Fortran is yh[(j-1)*n+i-1].
+*/
+
+namespace {
+
+       // resume points of a lane
+       enum : int32_t {
+              P_START = 0,
+              P_CONT,
+              P_INIT_F,
+              P_S220_F,
+              P_JAC,
+              P_FD_F,
+              P_LU,
+              P_SOLVE,
+              P_S405_F,
+              P_S640_F,
+              P_DONE
+       };
+
+       constexpr int32_t LS{8};   // SoA lane stride
+
+       // DSTODA stability limits of the Adams methods, orders 1..12
+       constexpr double sm1[12] = {.5,.575,.55,.45,.35,.25,.2,.15,.1,.075,.05,.025};
+
+       /*
+            DCFODE of both methods, ELCO(i,nq) -> elco[m][(nq-1)*13+i-1],
+            TESCO(k,nq) -> tesco[m][(nq-1)*3+k-1], m = meth-1, and the DSTODA
+            CM1/CM2 method switch constants. Computed once.
+       */
+       struct LsodaCoeffs {
+
+              double elco[2][13*12];
+              double tesco[2][3*12];
+              double cm1[12];
+              double cm2[5];
+       };
+
+       void dcfode(const int32_t meth,
+                   double * __restrict elco,
+                   double * __restrict tesco)
+       {
+              double pc[12];
+              std::memset(elco,0,sizeof(double)*13*12);
+              std::memset(tesco,0,sizeof(double)*3*12);
+              if(meth == 1)
+              {
+                  elco[0] = 1.0;
+                  elco[1] = 1.0;
+                  tesco[0] = 0.0;
+                  tesco[1] = 2.0;
+                  tesco[3] = 1.0;
+                  tesco[35] = 0.0;
+                  pc[0] = 1.0;
+                  double rqfac{1.0};
+                  for(int32_t nq{2}; nq <= 12; ++nq)
+                  {
+                      // p(x) = (x+1)*(x+2)*...*(x+nq-1)
+                      const double rq1fac{rqfac};
+                      rqfac /= static_cast<double>(nq);
+                      const int32_t nqm1{nq-1};
+                      const double fnqm1{static_cast<double>(nqm1)};
+                      const int32_t nqp1{nq+1};
+                      pc[nq-1] = 0.0;
+                      for(int32_t ib{1}; ib <= nqm1; ++ib)
+                      {
+                          const int32_t i{nqp1-ib};
+                          pc[i-1] = pc[i-2]+fnqm1*pc[i-1];
+                      }
+                      pc[0] = fnqm1*pc[0];
+                      double pint{pc[0]}, xpin{pc[0]/2.0}, tsign{1.0};
+                      for(int32_t i{2}; i <= nq; ++i)
+                      {
+                          tsign = -tsign;
+                          pint += tsign*pc[i-1]/static_cast<double>(i);
+                          xpin += tsign*pc[i-1]/static_cast<double>(i+1);
+                      }
+                      elco[(nq-1)*13]   = pint*rq1fac;
+                      elco[(nq-1)*13+1] = 1.0;
+                      for(int32_t i{2}; i <= nq; ++i)
+                          elco[(nq-1)*13+i] = rq1fac*pc[i-1]/static_cast<double>(i);
+                      const double agamq{rqfac*xpin};
+                      const double ragq{1.0/agamq};
+                      tesco[(nq-1)*3+1] = ragq;
+                      if(nq < 12) tesco[nq*3] = ragq*rqfac/static_cast<double>(nqp1);
+                      tesco[(nqm1-1)*3+2] = ragq;
+                  }
+              }
+              else
+              {
+                  pc[0] = 1.0;
+                  double rq1fac{1.0};
+                  for(int32_t nq{1}; nq <= 5; ++nq)
+                  {
+                      // p(x) = (x+1)*(x+2)*...*(x+nq)
+                      const double fnq{static_cast<double>(nq)};
+                      const int32_t nqp1{nq+1};
+                      pc[nqp1-1] = 0.0;
+                      for(int32_t ib{1}; ib <= nq; ++ib)
+                      {
+                          const int32_t i{nq+2-ib};
+                          pc[i-1] = pc[i-2]+fnq*pc[i-1];
+                      }
+                      pc[0] = fnq*pc[0];
+                      for(int32_t i{1}; i <= nqp1; ++i)
+                          elco[(nq-1)*13+i-1] = pc[i-1]/pc[1];
+                      elco[(nq-1)*13+1] = 1.0;
+                      tesco[(nq-1)*3]   = rq1fac;
+                      tesco[(nq-1)*3+1] = static_cast<double>(nqp1)/elco[(nq-1)*13];
+                      tesco[(nq-1)*3+2] = static_cast<double>(nq+2)/elco[(nq-1)*13];
+                      rq1fac /= fnq;
+                  }
+              }
+       }
+
+       LsodaCoeffs make_coeffs()
+       {
+              LsodaCoeffs c;
+              dcfode(1,&c.elco[0][0],&c.tesco[0][0]);
+              dcfode(2,&c.elco[1][0],&c.tesco[1][0]);
+              for(int32_t i{1}; i <= 5; ++i)
+                  c.cm2[i-1] = c.tesco[1][(i-1)*3+1]*c.elco[1][(i-1)*13+i];
+              for(int32_t i{1}; i <= 12; ++i)
+                  c.cm1[i-1] = c.tesco[0][(i-1)*3+1]*c.elco[0][(i-1)*13+i];
+              return c;
+       }
+
+       const LsodaCoeffs & lsoda_coeffs()
+       {
+              static const LsodaCoeffs c{make_coeffs()};
+              return c;
+       }
+
+       // DMNORM, weighted max-norm, w -- the inverse error weights
+       inline double dmnorm(const int32_t n,
+                            const double * __restrict v,
+                            const double * __restrict w)
+       {
+              double vm{0.0};
+              for(int32_t i{0}; i != n; ++i)
+                  vm = std::max(vm,std::fabs(v[i])*w[i]);
+              return vm;
+       }
+
+       // DMNORM of a lane of an SoA vector
+       inline double dmnorm_lane(const int32_t n,
+                                 const double * __restrict v,
+                                 const double * __restrict w)
+       {
+              double vm{0.0};
+              for(int32_t i{0}; i != n; ++i)
+                  vm = std::max(vm,std::fabs(v[LS*i])*w[i]);
+              return vm;
+       }
+
+       // DFNORM, the matrix norm consistent with DMNORM, a -- a lane of wm
+       inline double dfnorm_lane(const int32_t n,
+                                 const double * __restrict a,
+                                 const double * __restrict w)
+       {
+              double an{0.0};
+              for(int32_t i{0}; i != n; ++i)
+              {
+                  double sum{0.0};
+                  for(int32_t j{0}; j != n; ++j)
+                      sum += std::fabs(a[LS*(j*n+i)])/w[j];
+                  an = std::max(an,sum*w[i]);
+              }
+              return an;
+       }
+
+       // DEWSET followed by the inversion of DLSODA, false -- a weight <= 0
+       inline bool ewset_inv(const int32_t n,
+                             const int32_t itol,
+                             const double * __restrict rtol,
+                             const double * __restrict atol,
+                             const double * __restrict ycur,
+                             double * __restrict ewt)
+       {
+              for(int32_t i{0}; i != n; ++i)
+              {
+                  const double rt{(itol >= 3) ? rtol[i] : rtol[0]};
+                  const double at{(itol == 2 || itol == 4) ? atol[i] : atol[0]};
+                  const double e{rt*std::fabs(ycur[i])+at};
+                  if(e <= 0.0) return false;
+                  ewt[i] = 1.0/e;
+              }
+              return true;
+       }
+
+       inline double & lane_of(__m512d & v,const int32_t k)
+       {
+              return reinterpret_cast<double*>(&v)[k];
+       }
+
+       // state y (lane k) at t into the F/JAC arguments
+       inline int32_t request(gms::math::LsodaBlock & b,
+                              const int32_t k,
+                              const double t,
+                              const double * __restrict y,
+                              const int32_t req)
+       {
+              double * __restrict yf{reinterpret_cast<double*>(b.yf)+k};
+              for(int32_t i{0}; i != b.neq; ++i) yf[LS*i] = y[LS*i];
+              lane_of(b.t,k) = t;
+              return req;
+       }
+
+}
+
+bool
+gms::math::lsoda_block_alloc(LsodaBlock & b,
+                             const int32_t neq,
+                             const LsodaOpts & opts)
+{
+       const std::size_t n{static_cast<std::size_t>(neq)};
+       b.neq  = neq;
+       b.opts = opts;
+       b.itol = opts.itol;
+       b.rtol = opts.rtol;
+       b.atol = opts.atol;
+       b.t    = _mm512_setzero_pd();
+       b.sys  = _mm256_setzero_si256();
+       b.y    = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n,64));
+       b.yf   = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n,64));
+       b.f    = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n,64));
+       b.pd   = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n*n,64));
+       b.wm   = reinterpret_cast<__m512d*>(_mm_malloc(sizeof(__m512d)*n*n,64));
+       b.ipvt = reinterpret_cast<__m512i*>(_mm_malloc(sizeof(__m512i)*n,64));
+       // yh(13 columns), ewt, savf, acor per lane
+       const std::size_t ll{16*n};
+       b.lwork = reinterpret_cast<double*>(_mm_malloc(sizeof(double)*8*ll,64));
+       if(b.y == nullptr || b.yf == nullptr || b.f == nullptr || b.pd == nullptr ||
+          b.wm == nullptr || b.ipvt == nullptr || b.lwork == nullptr)
+       {
+           lsoda_block_free(b);
+           return false;
+       }
+       std::memset(b.lwork,0,sizeof(double)*8*ll);
+       for(std::size_t __i{0}; __i != n; ++__i)
+       {
+           b.y[__i]  = _mm512_setzero_pd();
+           b.yf[__i] = _mm512_setzero_pd();
+           b.f[__i]  = _mm512_setzero_pd();
+           b.ipvt[__i] = _mm512_setzero_si512();
+       }
+       for(std::size_t __i{0}; __i != n*n; ++__i)
+       {
+           b.pd[__i] = _mm512_setzero_pd();
+           b.wm[__i] = _mm512_setzero_pd();
+       }
+       for(int32_t __k{0}; __k != 8; ++__k)
+       {
+           LsodaLane & s = b.lane[__k];
+           std::memset(&s,0,sizeof(LsodaLane));
+           s.yh   = b.lwork+__k*ll;
+           s.ewt  = s.yh+13*n;
+           s.savf = s.ewt+n;
+           s.acor = s.savf+n;
+           s.n    = neq;
+           s.pc   = P_DONE;
+           b.info[__k] = 0;
+       }
+       return true;
+}
+
+void
+gms::math::lsoda_block_free(LsodaBlock & b)
+{
+       if(b.y)     _mm_free(b.y);
+       if(b.yf)    _mm_free(b.yf);
+       if(b.f)     _mm_free(b.f);
+       if(b.pd)    _mm_free(b.pd);
+       if(b.wm)    _mm_free(b.wm);
+       if(b.ipvt)  _mm_free(b.ipvt);
+       if(b.lwork) _mm_free(b.lwork);
+       b.y = b.yf = b.f = b.pd = b.wm = nullptr;
+       b.ipvt  = nullptr;
+       b.lwork = nullptr;
+}
+
+void
+gms::math::lsoda_lane_start(LsodaBlock & b,
+                            const int32_t k,
+                            const int32_t sys,
+                            const double t0,
+                            const double tout,
+                            const double * __restrict y0)
+{
+       LsodaLane & s = b.lane[k];
+       const LsodaOpts & o = b.opts;
+       // a lane does not remember its previous system
+       double * const yh{s.yh};
+       std::memset(&s,0,sizeof(LsodaLane));
+       s.yh   = yh;
+       s.ewt  = yh+13*b.neq;
+       s.savf = s.ewt+b.neq;
+       s.acor = s.savf+b.neq;
+       s.n    = b.neq;
+       double * __restrict y{reinterpret_cast<double*>(b.y)+k};
+       double * __restrict yf{reinterpret_cast<double*>(b.yf)+k};
+       for(int32_t __i{0}; __i != b.neq; ++__i)
+       {
+           s.yh[__i]  = y0[__i];
+           y[LS*__i]  = y0[__i];
+           yf[LS*__i] = y0[__i];
+       }
+       reinterpret_cast<int32_t*>(&b.sys)[k] = sys;
+       s.t      = t0;
+       s.tout   = tout;
+       s.istate = 1;
+       s.pc     = P_START;
+       s.jtyp   = (o.jt == 1) ? 1 : 2;
+       s.mxstep = (o.mxstep > 0) ? o.mxstep : 500;
+       s.mxordn = (o.mxordn > 0) ? std::min(o.mxordn,12) : 12;
+       s.mxords = (o.mxords > 0) ? std::min(o.mxords,5)  : 5;
+       s.h0     = o.h0;
+       s.hmxi   = (o.hmax > 0.0) ? 1.0/o.hmax : 0.0;
+       s.hmin   = std::max(o.hmin,0.0);
+}
+
+void
+gms::math::lsoda_lane_continue(LsodaBlock & b,
+                               const int32_t k,
+                               const double tout)
+{
+       LsodaLane & s = b.lane[k];
+       if(s.istate != 2) return;
+       s.tout = tout;
+       s.pc   = P_CONT;
+}
+
+int32_t
+gms::math::lsoda_lane_result(const LsodaBlock & b,
+                             const int32_t k,
+                             double * __restrict y,
+                             double * __restrict t,
+                             LsodaStats * __restrict stats)
+{
+       const LsodaLane & s = b.lane[k];
+       const double * __restrict yv{reinterpret_cast<const double*>(b.y)+k};
+       for(int32_t __i{0}; __i != b.neq; ++__i) y[__i] = yv[LS*__i];
+       *t = s.t;
+       if(stats != nullptr)
+       {
+           stats->nst   = s.nst;
+           stats->nfe   = s.nfe;
+           stats->nje   = s.nje;
+           stats->nqu   = s.nqu;
+           stats->mused = s.mused;
+           stats->pad   = 0;
+           stats->hu    = s.hu;
+           stats->tcur  = s.tn;
+           stats->tsw   = s.tsw;
+       }
+       return s.istate;
+}
+
+int32_t
+gms::math::lsoda_lane_advance(LsodaBlock & b,
+                              const int32_t k)
+{
+       LsodaLane & s = b.lane[k];
+       const LsodaCoeffs & cf = lsoda_coeffs();
+       const double uround{DBL_EPSILON};
+       const int32_t n{s.n};
+       double * __restrict y{reinterpret_cast<double*>(b.y)+k};
+       const double * __restrict fv{reinterpret_cast<const double*>(b.f)+k};
+       const double * __restrict pd{reinterpret_cast<const double*>(b.pd)+k};
+       double * __restrict wm{reinterpret_cast<double*>(b.wm)+k};
+       double * __restrict yh{s.yh};
+       double * __restrict ewt{s.ewt};
+       double * __restrict savf{s.savf};
+       double * __restrict acor{s.acor};
+       double r{0.0}, rm{0.0}, dcon{0.0}, exsm{0.0}, rh1{0.0}, rh1it{0.0}, rh2{0.0};
+       double dm1{0.0}, dm2{0.0}, exm1{0.0}, exm2{0.0}, dup{0.0}, ddn{0.0}, tol{0.0}, w0{0.0};
+       double tdist{0.0}, sum{0.0}, tp{0.0}, sc{0.0};
+
+       switch(s.pc)
+       {
+              case P_START:  goto D100;
+              case P_CONT:   goto D200;
+              case P_INIT_F: goto D100_F;
+              case P_S220_F: goto S220_F;
+              case P_JAC:    goto J100_JAC;
+              case P_FD_F:   goto J200_F;
+              case P_LU:     goto J240_LU;
+              case P_SOLVE:  goto S350_SOLVE;
+              case P_S405_F: goto S405_F;
+              case P_S640_F: goto S640_F;
+              default:       return LSODA_REQ_DONE;
+       }
+
+D100:
+       // ISTATE = 1, input checks, the initial f and the first step
+       for(int32_t i{0}; i != n; ++i)
+       {
+           if(((b.itol >= 3) ? b.rtol[i] : b.rtol[0]) < 0.0) goto D_ILLEGAL;
+           if(((b.itol == 2 || b.itol == 4) ? b.atol[i] : b.atol[0]) < 0.0) goto D_ILLEGAL;
+       }
+       s.meth   = 1;
+       s.tn     = s.t;
+       s.tsw    = s.t;
+       s.maxord = s.mxordn;
+       s.jstart = 0;
+       s.nhnil  = 0;
+       s.nst    = 0;
+       s.nje    = 0;
+       s.nslast = 0;
+       s.hu     = 0.0;
+       s.nqu    = 0;
+       s.mused  = 0;
+       s.miter  = 0;
+       s.elco   = cf.elco[0];
+       s.tesco  = cf.tesco[0];
+       s.pc = P_INIT_F;
+       return request(b,k,s.t,y,LSODA_REQ_F);
+D100_F:
+       for(int32_t i{0}; i != n; ++i) yh[n+i] = fv[LS*i];
+       s.nfe = 1;
+       s.nq  = 1;
+       s.h   = 1.0;
+       if(!ewset_inv(n,b.itol,b.rtol,b.atol,yh,ewt)) goto D_ILLEGAL;
+       if(s.h0 == 0.0)
+       {
+           tdist = std::fabs(s.tout-s.t);
+           w0    = std::max(std::fabs(s.t),std::fabs(s.tout));
+           if(tdist < 2.0*uround*w0) goto D_ILLEGAL;
+           tol = b.rtol[0];
+           if(b.itol > 2)
+               for(int32_t i{0}; i != n; ++i) tol = std::max(tol,b.rtol[i]);
+           if(tol <= 0.0)
+           {
+               for(int32_t i{0}; i != n; ++i)
+               {
+                   const double atoli{(b.itol == 2 || b.itol == 4) ? b.atol[i] : b.atol[0]};
+                   const double ayi{std::fabs(yh[i])};
+                   if(ayi != 0.0) tol = std::max(tol,atoli/ayi);
+               }
+           }
+           tol = std::min(std::max(tol,100.0*uround),.001);
+           sum = dmnorm(n,&yh[n],ewt);
+           sum = 1.0/(tol*w0*w0)+tol*(sum*sum);
+           s.h0 = std::min(1.0/std::sqrt(sum),tdist);
+           s.h0 = std::copysign(s.h0,s.tout-s.t);
+       }
+       r = std::fabs(s.h0)*s.hmxi;
+       if(r > 1.0) s.h0 /= r;
+       s.h = s.h0;
+       for(int32_t i{0}; i != n; ++i) yh[n+i] *= s.h0;
+       goto D270;
+
+D200:
+       // ISTATE = 2, TOUT already passed?
+       s.nslast = s.nst;
+       if((s.tn-s.tout)*s.h >= 0.0) goto D_INTERP;
+D250:
+       if(s.nst-s.nslast >= s.mxstep)
+       {
+           s.istate = -1;
+           goto D580;
+       }
+       if(!ewset_inv(n,b.itol,b.rtol,b.atol,yh,ewt))
+       {
+           s.istate = -6;
+           goto D580;
+       }
+D270:
+       if(uround*dmnorm(n,yh,ewt) > 1.0)
+       {
+           // too much accuracy requested
+           s.istate = (s.nst == 0) ? -3 : -2;
+           goto D580;
+       }
+       if(s.tn+s.h == s.tn) ++s.nhnil;
+       goto S_ENTRY;
+D290:
+       // kflag of DSTODA
+       if(s.kflag == -1)
+       {
+           s.istate = -4;
+           goto D580;
+       }
+       if(s.kflag < -1)
+       {
+           s.istate = -5;
+           goto D580;
+       }
+       if(s.meth != s.mused)
+       {
+           s.tsw    = s.tn;
+           s.maxord = (s.meth == 2) ? s.mxords : s.mxordn;
+           s.jstart = -1;
+       }
+       if((s.tn-s.tout)*s.h < 0.0) goto D250;
+D_INTERP:
+       // DINTDY, K = 0
+       tp = s.tn-s.hu-100.0*uround*std::copysign(std::fabs(s.tn)+std::fabs(s.hu),s.hu);
+       if((s.tout-tp)*(s.tout-s.tn) > 0.0) goto D_ILLEGAL;
+       sc = (s.tout-s.tn)/s.h;
+       for(int32_t i{0}; i != n; ++i)
+       {
+           double dky{yh[s.nq*n+i]};
+           for(int32_t j{s.nq-1}; j >= 0; --j) dky = yh[j*n+i]+sc*dky;
+           y[LS*i] = dky;
+       }
+       s.t      = s.tout;
+       s.istate = 2;
+       s.pc     = P_DONE;
+       return LSODA_REQ_DONE;
+D_ILLEGAL:
+       s.istate = -3;
+D580:
+       for(int32_t i{0}; i != n; ++i) y[LS*i] = yh[i];
+       s.t  = s.tn;
+       s.pc = P_DONE;
+       return LSODA_REQ_DONE;
+
+       // ------------------------------- DSTODA --------------------------------
+S_ENTRY:
+       s.kflag = 0;
+       s.told  = s.tn;
+       s.ncf   = 0;
+       s.ierpj = 0;
+       s.iersl = 0;
+       s.jcur  = 0;
+       s.icf   = 0;
+       s.delp  = 0.0;
+       if(s.jstart > 0)   goto S200;
+       if(s.jstart == -1) goto S100;
+       if(s.jstart == -2) goto S160;
+       s.lmax   = s.maxord+1;
+       s.nq     = 1;
+       s.l      = 2;
+       s.ialth  = 2;
+       s.rmax   = 1.0e4;
+       s.rc     = 0.0;
+       s.el0    = 1.0;
+       s.crate  = .7;
+       s.hold   = s.h;
+       s.nslp   = 0;
+       s.ipup   = s.miter;
+       s.iret   = 3;
+       s.icount = 20;
+       s.irflag = 0;
+       s.pdest  = 0.0;
+       s.pdlast = 0.0;
+       s.ratio  = 5.0;
+       s.elco   = cf.elco[0];
+       s.tesco  = cf.tesco[0];
+       goto S150;
+S100:
+       s.ipup = s.miter;
+       s.lmax = s.maxord+1;
+       if(s.ialth == 1) s.ialth = 2;
+       if(s.meth == s.mused) goto S160;
+       s.elco  = cf.elco[s.meth-1];
+       s.tesco = cf.tesco[s.meth-1];
+       s.ialth = s.l;
+       s.iret  = 1;
+S150:
+       for(int32_t i{0}; i != s.l; ++i) s.el[i] = s.elco[(s.nq-1)*13+i];
+       s.rc    = s.rc*s.el[0]/s.el0;
+       s.el0   = s.el[0];
+       s.conit = .5/static_cast<double>(s.nq+2);
+       if(s.iret == 1) goto S160;
+       if(s.iret == 2) goto S170;
+       goto S200;
+S160:
+       if(s.h == s.hold) goto S200;
+       s.rh    = s.h/s.hold;
+       s.h     = s.hold;
+       s.iredo = 3;
+       goto S175;
+S170:
+       s.rh = std::max(s.rh,s.hmin/std::fabs(s.h));
+S175:
+       s.rh = std::min(s.rh,s.rmax);
+       s.rh /= std::max(1.0,std::fabs(s.h)*s.hmxi*s.rh);
+       if(s.meth != 2)
+       {
+           s.irflag = 0;
+           s.pdh = std::max(std::fabs(s.h)*s.pdlast,1.0e-6);
+           if(s.rh*s.pdh*1.00001 >= sm1[s.nq-1])
+           {
+               s.rh = sm1[s.nq-1]/s.pdh;
+               s.irflag = 1;
+           }
+       }
+       r = 1.0;
+       for(int32_t j{1}; j < s.l; ++j)
+       {
+           r *= s.rh;
+           for(int32_t i{0}; i != n; ++i) yh[j*n+i] *= r;
+       }
+       s.h  *= s.rh;
+       s.rc *= s.rh;
+       s.ialth = s.l;
+       if(s.iredo == 0) goto S690;
+S200:
+       if(std::fabs(s.rc-1.0) > .3) s.ipup = s.miter;
+       if(s.nst >= s.nslp+20) s.ipup = s.miter;
+       s.tn += s.h;
+       // predictor, Pascal triangle
+       for(int32_t jb{1}; jb <= s.nq; ++jb)
+           for(int32_t j{s.nq-jb}; j < s.nq; ++j)
+               for(int32_t i{0}; i != n; ++i) yh[j*n+i] += yh[(j+1)*n+i];
+       s.pnorm = dmnorm(n,yh,ewt);
+S220:
+       s.m    = 0;
+       s.rate = 0.0;
+       s.del  = 0.0;
+       for(int32_t i{0}; i != n; ++i) y[LS*i] = yh[i];
+       s.pc = P_S220_F;
+       return request(b,k,s.tn,y,LSODA_REQ_F);
+S220_F:
+       for(int32_t i{0}; i != n; ++i) savf[i] = fv[LS*i];
+       ++s.nfe;
+       if(s.ipup <= 0) goto S250;
+
+       // ------------------------------- DPRJA ---------------------------------
+       ++s.nje;
+       s.ierpj = 0;
+       s.jcur  = 1;
+       s.hl0   = s.h*s.el0;
+       if(s.miter == 2) goto J200;
+       s.pc = P_JAC;
+       return request(b,k,s.tn,y,LSODA_REQ_JAC);
+J100_JAC:
+       for(int32_t i{0}; i != n*n; ++i) wm[LS*i] = -s.hl0*pd[LS*i];
+       goto J240;
+J200:
+       s.fac = dmnorm(n,savf,ewt);
+       s.r0  = std::fabs(s.h)*1.0e3*uround*static_cast<double>(n)*s.fac;
+       if(s.r0 == 0.0) s.r0 = 1.0;
+       s.jfd = 0;
+J210:
+       if(s.jfd == n) goto J230;
+       s.yj = y[LS*s.jfd];
+       r = std::max(std::sqrt(uround)*std::fabs(s.yj),s.r0/ewt[s.jfd]);
+       y[LS*s.jfd] += r;
+       s.fac = -s.hl0/r;
+       s.pc = P_FD_F;
+       return request(b,k,s.tn,y,LSODA_REQ_F);
+J200_F:
+       for(int32_t i{0}; i != n; ++i)
+           wm[LS*(s.jfd*n+i)] = (fv[LS*i]-savf[i])*s.fac;
+       y[LS*s.jfd] = s.yj;
+       ++s.jfd;
+       goto J210;
+J230:
+       s.nfe += n;
+J240:
+       s.pdnorm = dfnorm_lane(n,wm,ewt)/std::fabs(s.hl0);
+       for(int32_t i{0}; i != n; ++i) wm[LS*(i*n+i)] += 1.0;
+       s.pc = P_LU;
+       return LSODA_REQ_LU;
+J240_LU:
+       if(b.info[k] != 0) s.ierpj = 1;
+       // end of DPRJA
+       s.ipup  = 0;
+       s.rc    = 1.0;
+       s.nslp  = s.nst;
+       s.crate = .7;
+       if(s.ierpj != 0) goto S430;
+S250:
+       for(int32_t i{0}; i != n; ++i) acor[i] = 0.0;
+S270:
+       if(s.miter != 0) goto S350;
+       // functional iteration
+       for(int32_t i{0}; i != n; ++i)
+       {
+           savf[i] = s.h*savf[i]-yh[n+i];
+           y[LS*i] = savf[i]-acor[i];
+       }
+       s.del = dmnorm_lane(n,y,ewt);
+       for(int32_t i{0}; i != n; ++i)
+       {
+           y[LS*i] = yh[i]+s.el[0]*savf[i];
+           acor[i] = savf[i];
+       }
+       goto S400;
+S350:
+       // chord iteration, P*x = h*f - (yh1 + acor)
+       for(int32_t i{0}; i != n; ++i) y[LS*i] = s.h*savf[i]-(yh[n+i]+acor[i]);
+       s.pc = P_SOLVE;
+       return LSODA_REQ_SOLVE;
+S350_SOLVE:
+       s.del = dmnorm_lane(n,y,ewt);
+       for(int32_t i{0}; i != n; ++i)
+       {
+           acor[i] += y[LS*i];
+           y[LS*i] = yh[i]+s.el[0]*acor[i];
+       }
+S400:
+       // convergence test
+       if(s.del <= s.pnorm*100.0*uround) goto S450;
+       if(s.m == 0 && s.meth == 1) goto S405;
+       if(s.m == 0) goto S402;
+       rm = 1024.0;
+       if(s.del <= s.delp*1024.0) rm = s.del/s.delp;
+       s.rate  = std::max(s.rate,rm);
+       s.crate = std::max(s.crate*.2,rm);
+S402:
+       dcon = s.del*std::min(1.0,s.crate*1.5)/(s.tesco[(s.nq-1)*3+1]*s.conit);
+       if(dcon > 1.0) goto S405;
+       s.pdest = std::max(s.pdest,s.rate/std::fabs(s.h*s.el[0]));
+       if(s.pdest != 0.0) s.pdlast = s.pdest;
+       goto S450;
+S405:
+       ++s.m;
+       if(s.m == 3) goto S410;
+       if(s.m >= 2 && s.del > s.delp*2.0) goto S410;
+       s.delp = s.del;
+       s.pc = P_S405_F;
+       return request(b,k,s.tn,y,LSODA_REQ_F);
+S405_F:
+       for(int32_t i{0}; i != n; ++i) savf[i] = fv[LS*i];
+       ++s.nfe;
+       goto S270;
+S410:
+       if(s.miter == 0 || s.jcur == 1) goto S430;
+       s.icf  = 1;
+       s.ipup = s.miter;
+       goto S220;
+S430:
+       // corrector failure, retract yh
+       s.icf = 2;
+       ++s.ncf;
+       s.rmax = 2.0;
+       s.tn   = s.told;
+       for(int32_t jb{1}; jb <= s.nq; ++jb)
+           for(int32_t j{s.nq-jb}; j < s.nq; ++j)
+               for(int32_t i{0}; i != n; ++i) yh[j*n+i] -= yh[(j+1)*n+i];
+       if(s.ierpj < 0 || s.iersl < 0) goto S680;
+       if(std::fabs(s.h) <= s.hmin*1.00001) goto S670;
+       if(s.ncf == 10) goto S670;
+       s.rh    = .25;
+       s.ipup  = s.miter;
+       s.iredo = 1;
+       goto S170;
+S450:
+       // local error test
+       s.jcur = 0;
+       if(s.m == 0) s.dsm = s.del/s.tesco[(s.nq-1)*3+1];
+       if(s.m > 0)  s.dsm = dmnorm(n,acor,ewt)/s.tesco[(s.nq-1)*3+1];
+       if(s.dsm > 1.0) goto S500;
+       s.kflag = 0;
+       s.iredo = 0;
+       ++s.nst;
+       s.hu    = s.h;
+       s.nqu   = s.nq;
+       s.mused = s.meth;
+       for(int32_t j{0}; j != s.l; ++j)
+           for(int32_t i{0}; i != n; ++i) yh[j*n+i] += s.el[j]*acor[i];
+       // method switch test
+       --s.icount;
+       if(s.icount >= 0) goto S488;
+       if(s.meth == 2) goto S480;
+       if(s.nq > 5) goto S488;
+       if(s.dsm > s.pnorm*100.0*uround && s.pdest != 0.0) goto S470;
+       if(s.irflag == 0) goto S488;
+       rh2 = 2.0;
+       s.nqm2 = std::min(s.nq,s.mxords);
+       goto S478;
+S470:
+       exsm  = 1.0/static_cast<double>(s.l);
+       rh1   = 1.0/(std::pow(s.dsm,exsm)*1.2+1.2e-6);
+       rh1it = rh1*2.0;
+       s.pdh = s.pdlast*std::fabs(s.h);
+       if(s.pdh*rh1 > 1.0e-5) rh1it = sm1[s.nq-1]/s.pdh;
+       rh1 = std::min(rh1,rh1it);
+       if(s.nq <= s.mxords) goto S474;
+       s.nqm2 = s.mxords;
+       exm2 = 1.0/static_cast<double>(s.mxords+1);
+       dm2  = dmnorm(n,&yh[(s.mxords+1)*n],ewt)/cf.cm2[s.mxords-1];
+       rh2  = 1.0/(std::pow(dm2,exm2)*1.2+1.2e-6);
+       goto S476;
+S474:
+       dm2 = s.dsm*(cf.cm1[s.nq-1]/cf.cm2[s.nq-1]);
+       rh2 = 1.0/(std::pow(dm2,exsm)*1.2+1.2e-6);
+       s.nqm2 = s.nq;
+S476:
+       if(rh2 < s.ratio*rh1) goto S488;
+S478:
+       // Adams -> BDF
+       s.rh     = rh2;
+       s.icount = 20;
+       s.meth   = 2;
+       s.miter  = s.jtyp;
+       s.pdlast = 0.0;
+       s.nq     = s.nqm2;
+       s.l      = s.nq+1;
+       goto S170;
+S480:
+       exsm = 1.0/static_cast<double>(s.l);
+       if(s.mxordn >= s.nq) goto S484;
+       s.nqm1 = s.mxordn;
+       exm1 = 1.0/static_cast<double>(s.mxordn+1);
+       dm1  = dmnorm(n,&yh[(s.mxordn+1)*n],ewt)/cf.cm1[s.mxordn-1];
+       rh1  = 1.0/(std::pow(dm1,exm1)*1.2+1.2e-6);
+       goto S486;
+S484:
+       dm1  = s.dsm*(cf.cm2[s.nq-1]/cf.cm1[s.nq-1]);
+       rh1  = 1.0/(std::pow(dm1,exsm)*1.2+1.2e-6);
+       s.nqm1 = s.nq;
+       exm1 = exsm;
+S486:
+       rh1it = rh1*2.0;
+       s.pdh = s.pdnorm*std::fabs(s.h);
+       if(s.pdh*rh1 > 1.0e-5) rh1it = sm1[s.nqm1-1]/s.pdh;
+       rh1 = std::min(rh1,rh1it);
+       rh2 = 1.0/(std::pow(s.dsm,exsm)*1.2+1.2e-6);
+       if(rh1*s.ratio < rh2*5.0) goto S488;
+       dm1 = std::pow(std::max(.001,rh1),exm1)*dm1;
+       if(dm1 <= uround*1.0e3*s.pnorm) goto S488;
+       // BDF -> Adams
+       s.rh     = rh1;
+       s.icount = 20;
+       s.meth   = 1;
+       s.miter  = 0;
+       s.pdlast = 0.0;
+       s.nq     = s.nqm1;
+       s.l      = s.nq+1;
+       goto S170;
+S488:
+       --s.ialth;
+       if(s.ialth == 0) goto S520;
+       if(s.ialth > 1) goto S700;
+       if(s.l == s.lmax) goto S700;
+       for(int32_t i{0}; i != n; ++i) yh[(s.lmax-1)*n+i] = acor[i];
+       goto S700;
+S500:
+       // error test failed, retract yh
+       --s.kflag;
+       s.tn = s.told;
+       for(int32_t jb{1}; jb <= s.nq; ++jb)
+           for(int32_t j{s.nq-jb}; j < s.nq; ++j)
+               for(int32_t i{0}; i != n; ++i) yh[j*n+i] -= yh[(j+1)*n+i];
+       s.rmax = 2.0;
+       if(std::fabs(s.h) <= s.hmin*1.00001) goto S660;
+       if(s.kflag <= -3) goto S640;
+       s.iredo = 2;
+       s.rhup  = 0.0;
+       goto S540;
+S520:
+       // order and step size selection
+       s.rhup = 0.0;
+       if(s.l == s.lmax) goto S540;
+       for(int32_t i{0}; i != n; ++i) savf[i] = acor[i]-yh[(s.lmax-1)*n+i];
+       dup = dmnorm(n,savf,ewt)/s.tesco[(s.nq-1)*3+2];
+       s.rhup = 1.0/(std::pow(dup,1.0/static_cast<double>(s.l+1))*1.4+1.4e-6);
+S540:
+       exsm   = 1.0/static_cast<double>(s.l);
+       s.rhsm = 1.0/(std::pow(s.dsm,exsm)*1.2+1.2e-6);
+       s.rhdn = 0.0;
+       if(s.nq == 1) goto S550;
+       ddn    = dmnorm(n,&yh[(s.l-1)*n],ewt)/s.tesco[(s.nq-1)*3];
+       s.rhdn = 1.0/(std::pow(ddn,1.0/static_cast<double>(s.nq))*1.3+1.3e-6);
+S550:
+       if(s.meth == 2) goto S560;
+       s.pdh = std::max(std::fabs(s.h)*s.pdlast,1.0e-6);
+       if(s.l < s.lmax) s.rhup = std::min(s.rhup,sm1[s.l-1]/s.pdh);
+       s.rhsm = std::min(s.rhsm,sm1[s.nq-1]/s.pdh);
+       if(s.nq > 1) s.rhdn = std::min(s.rhdn,sm1[s.nq-2]/s.pdh);
+       s.pdest = 0.0;
+S560:
+       if(s.rhsm >= s.rhup) goto S570;
+       if(s.rhup > s.rhdn)  goto S590;
+       goto S580;
+S570:
+       if(s.rhsm < s.rhdn) goto S580;
+       s.newq = s.nq;
+       s.rh   = s.rhsm;
+       goto S620;
+S580:
+       s.newq = s.nq-1;
+       s.rh   = s.rhdn;
+       if(s.kflag < 0 && s.rh > 1.0) s.rh = 1.0;
+       goto S620;
+S590:
+       s.newq = s.l;
+       s.rh   = s.rhup;
+       if(s.rh < 1.1) goto S610;
+       r = s.el[s.l-1]/static_cast<double>(s.l);
+       for(int32_t i{0}; i != n; ++i) yh[s.newq*n+i] = acor[i]*r;
+       goto S630;
+S610:
+       s.ialth = 3;
+       goto S700;
+S620:
+       if(s.meth == 2) goto S622;
+       if(s.rh*s.pdh*1.00001 >= sm1[s.newq-1]) goto S625;
+S622:
+       if(s.kflag == 0 && s.rh < 1.1) goto S610;
+S625:
+       if(s.kflag <= -2) s.rh = std::min(s.rh,.2);
+       if(s.newq == s.nq) goto S170;
+S630:
+       s.nq   = s.newq;
+       s.l    = s.nq+1;
+       s.iret = 2;
+       goto S150;
+S640:
+       // repeated error test failures, restart at order 1
+       if(s.kflag == -10) goto S660;
+       s.rh = std::max(s.hmin/std::fabs(s.h),.1);
+       s.h *= s.rh;
+       for(int32_t i{0}; i != n; ++i) y[LS*i] = yh[i];
+       s.pc = P_S640_F;
+       return request(b,k,s.tn,y,LSODA_REQ_F);
+S640_F:
+       for(int32_t i{0}; i != n; ++i) savf[i] = fv[LS*i];
+       ++s.nfe;
+       for(int32_t i{0}; i != n; ++i) yh[n+i] = s.h*savf[i];
+       s.ipup  = s.miter;
+       s.ialth = 5;
+       if(s.nq == 1) goto S200;
+       s.nq   = 1;
+       s.l    = 2;
+       s.iret = 3;
+       goto S150;
+S660:
+       s.kflag = -1;
+       goto S720;
+S670:
+       s.kflag = -2;
+       goto S720;
+S680:
+       s.kflag = -3;
+       goto S720;
+S690:
+       s.rmax = 10.0;
+S700:
+       r = 1.0/s.tesco[(s.nqu-1)*3+1];
+       for(int32_t i{0}; i != n; ++i) acor[i] *= r;
+S720:
+       s.hold   = s.h;
+       s.jstart = 1;
+       goto D290;
+}
+
+void
+gms::math::lsoda_dgefa_zmm8r8(__m512d * __restrict a,
+                              __m512i * __restrict ipvt,
+                              int32_t * __restrict info,
+                              const int32_t n,
+                              const __mmask8 msk)
+{
+       const __m512i lane = _mm512_setr_epi64(0,1,2,3,4,5,6,7);
+       const __m512d sgn  = _mm512_set1_pd(-0.0);
+       double * __restrict pa{reinterpret_cast<double*>(a)};
+       __mmask8 sing{0};
+       for(int32_t __k{0}; __k < n-1; ++__k)
+       {
+           // pivot row l of every lane, the first largest |a(i,k)|
+           __m512d vmax = _mm512_andnot_pd(sgn,a[__k*n+__k]);
+           __m512i l    = _mm512_set1_epi64(__k);
+           for(int32_t __i{__k+1}; __i != n; ++__i)
+           {
+               const __m512d v = _mm512_andnot_pd(sgn,a[__k*n+__i]);
+               const __mmask8 gt = _mm512_cmp_pd_mask(v,vmax,_CMP_GT_OQ);
+               vmax = _mm512_mask_blend_pd(gt,vmax,v);
+               l    = _mm512_mask_blend_epi64(gt,l,_mm512_set1_epi64(__i));
+           }
+           _mm512_mask_store_epi64(&ipvt[__k],msk,l);
+           const __mmask8 zero = _mm512_mask_cmp_pd_mask(msk,vmax,_mm512_setzero_pd(),_CMP_EQ_OQ);
+           for(int32_t __j{0}; __j != 8; ++__j)
+               if((zero & ~sing) & (1 << __j)) info[__j] = __k+1;
+           sing |= zero;
+           const __mmask8 w  = msk & static_cast<__mmask8>(~zero);
+           const __mmask8 sw = _mm512_mask_cmpneq_epi64_mask(w,l,_mm512_set1_epi64(__k));
+           // a(l,j) <-> a(k,j), j >= k, rows of the lanes in sw
+           for(int32_t __j{__k}; __j != n; ++__j)
+           {
+               const __m512i idx = _mm512_add_epi64(_mm512_slli_epi64(_mm512_add_epi64(l,_mm512_set1_epi64(__j*n)),3),lane);
+               const __m512d t   = _mm512_mask_i64gather_pd(a[__j*n+__k],sw,idx,pa,8);
+               _mm512_mask_i64scatter_pd(pa,sw,idx,a[__j*n+__k],8);
+               a[__j*n+__k] = _mm512_mask_blend_pd(sw,a[__j*n+__k],t);
+           }
+           // multipliers -a(i,k)/a(k,k) and the update of the columns j > k
+           const __m512d t = _mm512_mask_div_pd(_mm512_set1_pd(-1.0),w,_mm512_set1_pd(-1.0),a[__k*n+__k]);
+           for(int32_t __i{__k+1}; __i != n; ++__i)
+               a[__k*n+__i] = _mm512_mask_mul_pd(a[__k*n+__i],w,t,a[__k*n+__i]);
+           for(int32_t __j{__k+1}; __j != n; ++__j)
+           {
+               const __m512d akj = a[__j*n+__k];
+               for(int32_t __i{__k+1}; __i != n; ++__i)
+                   a[__j*n+__i] = _mm512_mask3_fmadd_pd(akj,a[__k*n+__i],a[__j*n+__i],w);
+           }
+       }
+       _mm512_mask_store_epi64(&ipvt[n-1],msk,_mm512_set1_epi64(n-1));
+       const __mmask8 zero = _mm512_mask_cmp_pd_mask(msk,a[(n-1)*n+n-1],_mm512_setzero_pd(),_CMP_EQ_OQ);
+       for(int32_t __j{0}; __j != 8; ++__j)
+       {
+           if(!(msk & (1 << __j))) continue;
+           if(!(sing & (1 << __j))) info[__j] = (zero & (1 << __j)) ? n : 0;
+       }
+}
+
+void
+gms::math::lsoda_dgesl_zmm8r8(const __m512d * __restrict a,
+                              const __m512i * __restrict ipvt,
+                              __m512d * __restrict b,
+                              const int32_t n,
+                              const __mmask8 msk)
+{
+       const __m512i lane = _mm512_setr_epi64(0,1,2,3,4,5,6,7);
+       double * __restrict pb{reinterpret_cast<double*>(b)};
+       // L*y = P*b
+       for(int32_t __k{0}; __k < n-1; ++__k)
+       {
+           const __m512i l   = ipvt[__k];
+           const __mmask8 sw = _mm512_mask_cmpneq_epi64_mask(msk,l,_mm512_set1_epi64(__k));
+           const __m512i idx = _mm512_add_epi64(_mm512_slli_epi64(l,3),lane);
+           const __m512d t   = _mm512_mask_i64gather_pd(b[__k],sw,idx,pb,8);
+           _mm512_mask_i64scatter_pd(pb,sw,idx,b[__k],8);
+           b[__k] = _mm512_mask_blend_pd(sw,b[__k],t);
+           for(int32_t __i{__k+1}; __i != n; ++__i)
+               b[__i] = _mm512_mask3_fmadd_pd(t,a[__k*n+__i],b[__i],msk);
+       }
+       // U*x = y
+       for(int32_t __k{n-1}; __k >= 0; --__k)
+       {
+           b[__k] = _mm512_mask_div_pd(b[__k],msk,b[__k],a[__k*n+__k]);
+           const __m512d t = _mm512_sub_pd(_mm512_setzero_pd(),b[__k]);
+           for(int32_t __i{0}; __i != __k; ++__i)
+               b[__i] = _mm512_mask3_fmadd_pd(t,a[__k*n+__i],b[__i],msk);
+       }
+}
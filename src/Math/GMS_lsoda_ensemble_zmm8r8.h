@@ -0,0 +1,394 @@
+#ifndef __GMS_LSODA_ENSEMBLE_ZMM8R8_H__
+#define __GMS_LSODA_ENSEMBLE_ZMM8R8_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_LSODA_ENSEMBLE_ZMM8R8_MAJOR = 1U;
+    const unsigned int GMS_LSODA_ENSEMBLE_ZMM8R8_MINOR = 0U;
+    const unsigned int GMS_LSODA_ENSEMBLE_ZMM8R8_MICRO = 0U;
+    const unsigned int GMS_LSODA_ENSEMBLE_ZMM8R8_FULLVER =
+      1000U*GMS_LSODA_ENSEMBLE_ZMM8R8_MAJOR+100U*GMS_LSODA_ENSEMBLE_ZMM8R8_MINOR+
+      10U*GMS_LSODA_ENSEMBLE_ZMM8R8_MICRO;
+    const char * const GMS_LSODA_ENSEMBLE_ZMM8R8_CREATION_DATE = "22-10-2026 10:40 AM +00200 (THR 22 OCT 2026 GMT+2)";
+    const char * const GMS_LSODA_ENSEMBLE_ZMM8R8_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_LSODA_ENSEMBLE_ZMM8R8_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_LSODA_ENSEMBLE_ZMM8R8_DESCRIPTION   = "CPU ensemble LSODA (stiff/non-stiff switching), 8 systems per AVX512 register, OpenMP over blocks.";
+
+}
+
+/*
+     CPU port of the CUDA DLSODA (gpu/kernels/GMS_cuLsoda.cuh, f2c of ODEPACK
+     DLSODA/DSTODA/DPRJA, A.C. Hindmarsh, L.R. Petzold) for many independent
+     systems of the same dimension (per grid cell chemistry and microphysics).
+     Eight systems share one block, system k in the lane k of __m512d:
+          control -- the DLSODA/DSTODA logic runs per lane (scalar, its own
+                     step size, order, method, Jacobian age), as a resumable
+                     state machine which stops whenever it needs the RHS, the
+                     Jacobian, the LU factorization or the LU solve,
+          batched -- the block then calls the user RHS/Jacobian once for all
+                     lanes (__m512d arguments) and factors/solves the Newton
+                     matrices P = I - h*el0*J of the requesting lanes with an
+                     SoA LU (LINPACK DGEFA/DGESL, partial pivoting per lane).
+     Lanes are independent: a system gives bitwise the same result in every
+     lane and block. Blocks are distributed over the OpenMP threads (dynamic,
+     stiffness varies per cell), the last block is padded with copies of the
+     last system.
+     Supported subset of DLSODA: ITASK = 1 (output at TOUT by interpolation),
+     ITOL = 1..4, JT = 1 (user Jacobian) and JT = 2 (internal difference
+     quotient Jacobian), optional MXSTEP, MXORDN, MXORDS, H0, HMAX, HMIN.
+     Banded Jacobians (JT = 4, 5) and the critical time TCRIT are not ported.
+     User functors (the lane k evaluates the system sys[k]):
+          RHS      void operator()(const int32_t neq,const __m512d t,
+                                   const __m512d * __restrict y,__m512d * __restrict ydot,
+                                   const __m256i sys)
+          Jacobian void operator()(const int32_t neq,const __m512d t,
+                                   const __m512d * __restrict y,__m512d * __restrict pd,
+                                   const __m256i sys)
+                   pd[j*neq+i] = df_i/dy_j (column major, zeroed before the call).
+     Both are called with all eight lanes, the lanes which did not request the
+     call carry a state they were evaluated at before (results discarded).
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_config.h"
+
+namespace gms {
+
+        namespace math {
+
+                  // Request of a lane to its block.
+                  enum LsodaReq : int32_t {
+                         LSODA_REQ_DONE  = 0,
+                         LSODA_REQ_F     = 1,     // ydot = f(t,yf)
+                         LSODA_REQ_JAC   = 2,     // pd = df/dy(t,yf)
+                         LSODA_REQ_LU    = 3,     // LU factors of wm
+                         LSODA_REQ_SOLVE = 4      // y = wm^-1*y
+                  };
+
+                  // DLSODA optional inputs, zero selects the DLSODA default.
+                  struct __ATTR_ALIGN__(64) LsodaOpts {
+
+                         int32_t itol;                     // 1..4, scalar/vector rtol and atol
+                         int32_t jt;                       // 1 -- user Jacobian, 2 -- difference quotients
+                         int32_t mxstep;                   // max steps per call (500)
+                         int32_t mxordn;                   // max Adams order (12)
+                         int32_t mxords;                   // max BDF order (5)
+                         int32_t pad;
+                         const double * __restrict rtol;   // rtol[0] or rtol[neq]
+                         const double * __restrict atol;   // atol[0] or atol[neq]
+                         double  h0;                       // first step
+                         double  hmax;
+                         double  hmin;
+                  };
+
+                  // DLSODA optional outputs (IWORK(11..20), RWORK(11..15)).
+                  struct __ATTR_ALIGN__(32) LsodaStats {
+
+                         int32_t nst;                      // steps
+                         int32_t nfe;                      // RHS evaluations
+                         int32_t nje;                      // Jacobian evaluations (LU factorizations)
+                         int32_t nqu;                      // last order
+                         int32_t mused;                    // last method, 1 -- Adams, 2 -- BDF
+                         int32_t pad;
+                         double  hu;                       // last step
+                         double  tcur;                     // reached by the integrator
+                         double  tsw;                      // last method switch
+                  };
+
+                  /*
+                        Per lane DLSODA/DSTODA state (common block, DSTODA locals kept
+                        across the requests), the lane owned arrays are contiguous:
+                        yh[j*neq+i] the Nordsieck history, ewt the inverse error weights.
+                  */
+                  struct __ATTR_ALIGN__(64) LsodaLane {
+
+                         double  * __restrict yh;          // 13*neq
+                         double  * __restrict ewt;
+                         double  * __restrict savf;
+                         double  * __restrict acor;
+                         const double * __restrict elco;   // ELCO(13,12) of meth
+                         const double * __restrict tesco;  // TESCO(3,12) of meth
+                         int32_t pc;                       // resume point
+                         int32_t istate;
+                         int32_t n;
+                         int32_t jstart;
+                         int32_t kflag;
+                         int32_t meth;
+                         int32_t miter;
+                         int32_t jtyp;
+                         int32_t mused;
+                         int32_t maxord;
+                         int32_t mxordn;
+                         int32_t mxords;
+                         int32_t nq;
+                         int32_t l;
+                         int32_t lmax;
+                         int32_t nqu;
+                         int32_t newq;
+                         int32_t nqm1;
+                         int32_t nqm2;
+                         int32_t ialth;
+                         int32_t ipup;
+                         int32_t iret;
+                         int32_t iredo;
+                         int32_t icount;
+                         int32_t irflag;
+                         int32_t icf;
+                         int32_t ierpj;
+                         int32_t iersl;
+                         int32_t jcur;
+                         int32_t m;
+                         int32_t ncf;
+                         int32_t nslp;
+                         int32_t nst;
+                         int32_t nslast;
+                         int32_t nfe;
+                         int32_t nje;
+                         int32_t nhnil;
+                         int32_t mxstep;
+                         int32_t jfd;                      // difference quotient column
+                         double  t;
+                         double  tout;
+                         double  tn;
+                         double  told;
+                         double  tsw;
+                         double  h;
+                         double  hu;
+                         double  hold;
+                         double  h0;
+                         double  hmin;
+                         double  hmxi;
+                         double  hl0;
+                         double  rh;
+                         double  rmax;
+                         double  rc;
+                         double  el0;
+                         double  conit;
+                         double  crate;
+                         double  rate;
+                         double  del;
+                         double  delp;
+                         double  dsm;
+                         double  pnorm;
+                         double  pdnorm;
+                         double  pdest;
+                         double  pdlast;
+                         double  pdh;
+                         double  ratio;
+                         double  rhup;
+                         double  rhsm;
+                         double  rhdn;
+                         double  yj;
+                         double  fac;
+                         double  r0;
+                         double  el[13];
+                  };
+
+                  /*
+                        Eight systems of neq equations. The SoA buffers hold element i
+                        of the lane k in ((double*)x)[8*i+k].
+                  */
+                  struct __ATTR_ALIGN__(64) LsodaBlock {
+
+                         LsodaLane lane[8];
+                         __m512d   t;                      // time of the F/JAC request
+                         __m256i   sys;                    // system of each lane
+                         __m512d * __restrict y;           // neq, lane work vector and result
+                         __m512d * __restrict yf;          // neq, state of the F/JAC request
+                         __m512d * __restrict f;           // neq, RHS
+                         __m512d * __restrict pd;          // neq*neq, Jacobian
+                         __m512d * __restrict wm;          // neq*neq, P and its LU factors
+                         __m512i * __restrict ipvt;        // neq, pivot rows
+                         double  * __restrict lwork;       // lane owned arrays
+                         int32_t   info[8];                // DGEFA info per lane
+                         int32_t   neq;
+                         int32_t   itol;
+                         const double * __restrict rtol;
+                         const double * __restrict atol;
+                         LsodaOpts opts;
+                  };
+
+                  // Marks "no Jacobian": the difference quotient Jacobian (JT = 2) is used.
+                  struct LsodaNoJac {
+
+                         void operator()(const int32_t,const __m512d,const __m512d * __restrict,
+                                         __m512d * __restrict,const __m256i) const {}
+                  };
+
+                  bool lsoda_block_alloc(LsodaBlock & b,
+                                         const int32_t neq,
+                                         const LsodaOpts & opts);
+
+                  void lsoda_block_free(LsodaBlock & b);
+
+                  /*
+                        DLSODA call with ISTATE = 1 for the lane k: y0[neq] at t0,
+                        output requested at tout.
+                  */
+                  void lsoda_lane_start(LsodaBlock & b,
+                                        const int32_t k,
+                                        const int32_t sys,
+                                        const double t0,
+                                        const double tout,
+                                        const double * __restrict y0);
+
+                  /*
+                        DLSODA call with ISTATE = 2 (the lane finished its previous
+                        call with istate 2): continue to the new tout.
+                  */
+                  void lsoda_lane_continue(LsodaBlock & b,
+                                           const int32_t k,
+                                           const double tout);
+
+                  /*
+                        Runs the lane k until it needs a request (LsodaReq), the request
+                        must be served before the next call. LSODA_REQ_DONE -- the DLSODA
+                        call returned, lsoda_lane_result gives y, istate and the counters.
+                  */
+                  int32_t lsoda_lane_advance(LsodaBlock & b,
+                                             const int32_t k);
+
+                  // y at the return time, the DLSODA ISTATE (2 -- success, < 0 -- error).
+                  int32_t lsoda_lane_result(const LsodaBlock & b,
+                                            const int32_t k,
+                                            double * __restrict y,
+                                            double * __restrict t,
+                                            LsodaStats * __restrict stats);
+
+                  /*
+                        In place LU factorization (DGEFA) of the neq*neq matrices of the
+                        lanes in msk, wm[j*neq+i] column major, pivots in ipvt, info[k] > 0
+                        -- the exactly singular column + 1. The other lanes are not touched.
+                  */
+                  void lsoda_dgefa_zmm8r8(__m512d * __restrict a,
+                                          __m512i * __restrict ipvt,
+                                          int32_t * __restrict info,
+                                          const int32_t n,
+                                          const __mmask8 msk);
+
+                  // b = A^-1*b (DGESL, JOB = 0) of the lanes in msk.
+                  void lsoda_dgesl_zmm8r8(const __m512d * __restrict a,
+                                          const __m512i * __restrict ipvt,
+                                          __m512d * __restrict b,
+                                          const int32_t n,
+                                          const __mmask8 msk);
+
+                  /*
+                        Serves the requests of the block until every lane is done.
+                  */
+                  template<typename RHS,typename JAC>
+                  void lsoda_block_run(LsodaBlock & b,
+                                       RHS & f,
+                                       JAC & jac,
+                                       __mmask8 live)
+                  {
+                         const int32_t neq{b.neq};
+                         while(live)
+                         {
+                               __mmask8 mf{0}, mj{0}, ml{0}, ms{0};
+                               for(int32_t __k{0}; __k != 8; ++__k)
+                               {
+                                   if(!(live & (1 << __k))) continue;
+                                   const __mmask8 bit = static_cast<__mmask8>(1 << __k);
+                                   switch(lsoda_lane_advance(b,__k))
+                                   {
+                                          case LSODA_REQ_F:     mf |= bit; break;
+                                          case LSODA_REQ_JAC:   mj |= bit; break;
+                                          case LSODA_REQ_LU:    ml |= bit; break;
+                                          case LSODA_REQ_SOLVE: ms |= bit; break;
+                                          default:              live &= static_cast<__mmask8>(~bit);
+                                   }
+                               }
+                               if(mf) f(neq,b.t,b.yf,b.f,b.sys);
+                               if(mj)
+                               {
+                                   for(int32_t __i{0}; __i != neq*neq; ++__i)
+                                       b.pd[__i] = _mm512_setzero_pd();
+                                   jac(neq,b.t,b.yf,b.pd,b.sys);
+                               }
+                               if(ml) lsoda_dgefa_zmm8r8(b.wm,b.ipvt,b.info,neq,ml);
+                               if(ms) lsoda_dgesl_zmm8r8(b.wm,b.ipvt,b.y,neq,ms);
+                         }
+                  }
+
+                  /*
+                        Integrates nsys systems y[s*neq..s*neq+neq) from t0 to tout (in place),
+                        istate[s] -- the DLSODA ISTATE, stats may be nullptr. JAC = LsodaNoJac
+                        selects JT = 2. f and jac are copied per thread.
+                  */
+                  template<typename RHS,typename JAC = LsodaNoJac>
+                  void lsoda_ensemble_zmm8r8_omp(const RHS & f,
+                                                 const JAC & jac,
+                                                 const int32_t nsys,
+                                                 const int32_t neq,
+                                                 double * __restrict y,
+                                                 const double t0,
+                                                 const double tout,
+                                                 const LsodaOpts & opts,
+                                                 int32_t * __restrict istate,
+                                                 LsodaStats * __restrict stats)
+                  {
+                         const int32_t nblk{(nsys+7)/8};
+                         LsodaOpts o{opts};
+                         if(std::is_same<JAC,LsodaNoJac>::value) o.jt = 2;
+#pragma omp parallel default(none) shared(f,jac,nsys,neq,y,t0,tout,o,istate,stats,nblk)
+                         {
+                               RHS fl(f);
+                               JAC jl(jac);
+                               LsodaBlock b;
+                               const bool ok{lsoda_block_alloc(b,neq,o)};
+#pragma omp for schedule(dynamic,1)
+                               for(int32_t __i = 0; __i < nblk; ++__i)
+                               {
+                                   const int32_t s0{8*__i};
+                                   if(!ok)
+                                   {
+                                       for(int32_t __s{s0}; __s < std::min(s0+8,nsys); ++__s)
+                                           istate[__s] = -7;
+                                       continue;
+                                   }
+                                   for(int32_t __k{0}; __k != 8; ++__k)
+                                   {
+                                       const int32_t s{std::min(s0+__k,nsys-1)};
+                                       lsoda_lane_start(b,__k,s,t0,tout,&y[static_cast<std::size_t>(s)*neq]);
+                                   }
+                                   lsoda_block_run(b,fl,jl,0xFF);
+                                   for(int32_t __s{s0}; __s < std::min(s0+8,nsys); ++__s)
+                                   {
+                                       double tr;
+                                       istate[__s] = lsoda_lane_result(b,__s-s0,&y[static_cast<std::size_t>(__s)*neq],
+                                                                       &tr,(stats != nullptr) ? &stats[__s] : nullptr);
+                                   }
+                               }
+                               if(ok) lsoda_block_free(b);
+                         }
+                  }
+
+        } // math
+
+} // gms
+
+#endif /*__GMS_LSODA_ENSEMBLE_ZMM8R8_H__*/
@@ -0,0 +1,802 @@
+
+#ifndef __GMS_ROOT_FINDING_SIMD_HPP__
+#define __GMS_ROOT_FINDING_SIMD_HPP__ 231020261130
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+     const unsigned int GMS_ROOT_FINDING_SIMD_MAJOR = 1;
+     const unsigned int GMS_ROOT_FINDING_SIMD_MINOR = 0;
+     const unsigned int GMS_ROOT_FINDING_SIMD_MICRO = 0;
+     const unsigned int GMS_ROOT_FINDING_SIMD_FULLVER =
+       1000U*GMS_ROOT_FINDING_SIMD_MAJOR+100U*GMS_ROOT_FINDING_SIMD_MINOR+
+       10U*GMS_ROOT_FINDING_SIMD_MICRO;
+     const char * const GMS_ROOT_FINDING_SIMD_CREATION_DATE = "23-10-2026 11:30 +00200 (FRI 23 OCT 2026 GMT+2)";
+     const char * const GMS_ROOT_FINDING_SIMD_BUILD_DATE    = __DATE__ " " __TIME__;
+     const char * const GMS_ROOT_FINDING_SIMD_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+     const char * const GMS_ROOT_FINDING_SIMD_DESCRIPTION   = "Lane-parallel Brent/Newton/Illinois root finding, per-lane convergence.";
+
+}
+
+/*
+    Many independent root problems at once, one problem per lane of __m512
+    (16 floats, layout L = root_zmm16r4) or __m256d (4 doubles, L = root_ymm4r8),
+    V -- the vector type of L:
+         brentq   -- brentq of GMS_root_finding.hpp (SciPy brentq.c), bracketed,
+         newton   -- Newton with bisection safeguard (rtsafe), bracketed, f and f',
+         illinois -- modified regula falsi of GMS_root_finding.hpp, bracketed.
+    Every lane runs its own iteration, the lanes which converged (or failed)
+    are masked off, one call of the residual functor per round evaluates all
+    lanes (the finished ones at their last point, results discarded).
+    Block form (one vector of problems):
+         root_brentq_simd<L>(f,a,b,tol)       f:  V operator()(const V x) const
+         root_newton_simd<L>(fdf,a,b,x0,tol)  fdf: V operator()(const V x,V & dfdx) const
+         root_illinois_simd<L>(f,a,b,tol)
+    Array form (n problems, a lane which finished takes the next problem):
+         root_solve_array<L,method>(f,a,b,x0,x,fx,status,iters,n,tol)
+         f:   V operator()(const V x,const I idx) const,
+         fdf: V operator()(const V x,const I idx,V & dfdx) const,
+         idx -- the problem of each lane (I: __m512i of int32 for __m512,
+         __m128i for __m256d), always a valid index in [0,n).
+    status: ROOT_OK, ROOT_NO_BRACKET (f(a)*f(b) > 0), ROOT_MAXITER (the best
+    point so far is returned), the iteration count excludes f(a), f(b).
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include "GMS_config.h"
+
+// root_solve_array refills the lanes when 1/ROOT_SIMD_REFILL_DIV of them finished (at least one).
+#if !defined(ROOT_SIMD_REFILL_DIV)
+#define ROOT_SIMD_REFILL_DIV 8
+#endif
+
+// Independent sets of lanes of root_solve_array, advanced in turn (1 -- no interleaving).
+#if !defined(ROOT_SIMD_STREAMS)
+#define ROOT_SIMD_STREAMS 2
+#endif
+
+namespace  gms {
+
+           namespace math {
+
+                   enum root_status_t : int32_t
+                   {
+                         ROOT_OK         =  0,
+                         ROOT_NO_BRACKET = -1,
+                         ROOT_MAXITER    = -2
+                   };
+
+                   enum class root_method_t : int32_t
+                   {
+                         BRENTQ,
+                         NEWTON,
+                         ILLINOIS
+                   };
+
+                   // converged when |dx| <= xtol+rtol*|x| or |f(x)| <= ftol
+                   struct root_tol_t
+                   {
+                          double  xtol    = 1.0e-12;
+                          double  rtol    = 1.0e-6;
+                          double  ftol    = 0.0;
+                          int32_t maxiter = 200;
+                   };
+
+                   /*
+                        Lane layouts, the template argument of the solvers: __m512 and
+                        __m256d themselves would lose their alignment attributes as
+                        template arguments.
+                   */
+                   struct root_zmm16r4 {};   // 16 floats, __m512
+                   struct root_ymm4r8  {};   // 4 doubles, __m256d
+
+                   template<typename L>
+                   struct root_simd_traits;
+
+                   template<>
+                   struct root_simd_traits<root_zmm16r4>
+                   {
+                          typedef __m512    V;
+                          typedef float     T;
+                          typedef __mmask16 M;
+                          typedef __m512i   I;
+                          static constexpr int32_t lanes = 16;
+
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 set1(const T x)                { return (_mm512_set1_ps(x)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 add(const __m512 a,const __m512 b) { return (_mm512_add_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 sub(const __m512 a,const __m512 b) { return (_mm512_sub_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 mul(const __m512 a,const __m512 b) { return (_mm512_mul_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 div(const __m512 a,const __m512 b) { return (_mm512_div_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 min(const __m512 a,const __m512 b) { return (_mm512_min_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 max(const __m512 a,const __m512 b) { return (_mm512_max_ps(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 abs(const __m512 a)                { return (_mm512_abs_ps(a)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 neg(const __m512 a)                { return (_mm512_sub_ps(_mm512_setzero_ps(),a)); }
+                          // m ? b : a
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 blend(const M m,const __m512 a,const __m512 b) { return (_mm512_mask_blend_ps(m,a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M lt(const __m512 a,const __m512 b) { return (_mm512_cmp_ps_mask(a,b,_CMP_LT_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M le(const __m512 a,const __m512 b) { return (_mm512_cmp_ps_mask(a,b,_CMP_LE_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M gt(const __m512 a,const __m512 b) { return (_mm512_cmp_ps_mask(a,b,_CMP_GT_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M eq(const __m512 a,const __m512 b) { return (_mm512_cmp_ps_mask(a,b,_CMP_EQ_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M m_and(const M a,const M b)  { return (a & b); }
+                          __ATTR_ALWAYS_INLINE__ static inline M m_or(const M a,const M b)   { return (a | b); }
+                          // a & ~b
+                          __ATTR_ALWAYS_INLINE__ static inline M m_andn(const M a,const M b) { return (a & static_cast<M>(~b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline uint32_t bits(const M m)      { return (static_cast<uint32_t>(m)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M from_bits(const uint32_t b) { return (static_cast<M>(b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline I idx_load(const int32_t * p) { return (_mm512_load_si512(p)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m512 gather(const __m512 src,const M m,const I idx,const T * base)
+                          {
+                                 return (_mm512_mask_i32gather_ps(src,m,idx,base,4));
+                          }
+                          __ATTR_ALWAYS_INLINE__ static inline void store(T * p,const __m512 v) { _mm512_store_ps(p,v); }
+                   };
+
+                   template<>
+                   struct root_simd_traits<root_ymm4r8>
+                   {
+                          typedef __m256d V;
+                          typedef double  T;
+                          typedef __m256d M;     // all-ones lanes
+                          typedef __m128i I;
+                          static constexpr int32_t lanes = 4;
+
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d set1(const T x)                 { return (_mm256_set1_pd(x)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d add(const __m256d a,const __m256d b) { return (_mm256_add_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d sub(const __m256d a,const __m256d b) { return (_mm256_sub_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d mul(const __m256d a,const __m256d b) { return (_mm256_mul_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d div(const __m256d a,const __m256d b) { return (_mm256_div_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d min(const __m256d a,const __m256d b) { return (_mm256_min_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d max(const __m256d a,const __m256d b) { return (_mm256_max_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d abs(const __m256d a)                 { return (_mm256_andnot_pd(_mm256_set1_pd(-0.0),a)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d neg(const __m256d a)                 { return (_mm256_xor_pd(_mm256_set1_pd(-0.0),a)); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d blend(const M m,const __m256d a,const __m256d b) { return (_mm256_blendv_pd(a,b,m)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M lt(const __m256d a,const __m256d b) { return (_mm256_cmp_pd(a,b,_CMP_LT_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M le(const __m256d a,const __m256d b) { return (_mm256_cmp_pd(a,b,_CMP_LE_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M gt(const __m256d a,const __m256d b) { return (_mm256_cmp_pd(a,b,_CMP_GT_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M eq(const __m256d a,const __m256d b) { return (_mm256_cmp_pd(a,b,_CMP_EQ_OQ)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M m_and(const M a,const M b)  { return (_mm256_and_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M m_or(const M a,const M b)   { return (_mm256_or_pd(a,b)); }
+                          __ATTR_ALWAYS_INLINE__ static inline M m_andn(const M a,const M b) { return (_mm256_andnot_pd(b,a)); }
+                          __ATTR_ALWAYS_INLINE__ static inline uint32_t bits(const M m)      { return (static_cast<uint32_t>(_mm256_movemask_pd(m))); }
+                          __ATTR_ALWAYS_INLINE__ static inline M from_bits(const uint32_t b)
+                          {
+                                 const __m256i sel{_mm256_and_si256(_mm256_set1_epi64x(static_cast<int64_t>(b)),_mm256_setr_epi64x(1,2,4,8))};
+                                 return (_mm256_castsi256_pd(_mm256_cmpgt_epi64(sel,_mm256_setzero_si256())));
+                          }
+                          __ATTR_ALWAYS_INLINE__ static inline I idx_load(const int32_t * p) { return (_mm_load_si128(reinterpret_cast<const __m128i*>(p))); }
+                          __ATTR_ALWAYS_INLINE__ static inline __m256d gather(const __m256d src,const M m,const I idx,const T * base)
+                          {
+                                 return (_mm256_mask_i32gather_pd(src,base,idx,m,8));
+                          }
+                          __ATTR_ALWAYS_INLINE__ static inline void store(T * p,const __m256d v) { _mm256_store_pd(p,v); }
+                   };
+
+                   /*
+                        Lanes common to the methods: x_eval -- where the next round
+                        evaluates the residual, out -- lanes finished in the last round
+                        with x_out, f_out, nob (no bracket) and maxit.
+                   */
+                   template<typename L>
+                   struct root_lanes_base
+                   {
+                          typedef root_simd_traits<L> S;
+                          typedef typename S::V V;
+                          typedef typename S::T T;
+                          typedef typename S::M M;
+
+                          V x_eval;
+                          V x_out;
+                          V f_out;
+                          V iters;
+                          V xa;
+                          V xb;
+                          V fa;
+                          M ph_a;       // waits for f(a)
+                          M ph_b;       // waits for f(b)
+                          M ph_it;      // iterating
+                          M nob;
+                          M maxit;
+                          V xtol;
+                          V rtol;
+                          V ftol;
+                          V maxiter;
+
+                          explicit root_lanes_base(const root_tol_t & tol)
+                          {
+                                 const V z{S::set1(T(0))};
+                                 x_eval = x_out = f_out = iters = xa = xb = fa = z;
+                                 ph_a = ph_b = ph_it = nob = maxit = S::from_bits(0u);
+                                 xtol    = S::set1(static_cast<T>(tol.xtol));
+                                 rtol    = S::set1(static_cast<T>(tol.rtol));
+                                 ftol    = S::set1(static_cast<T>(tol.ftol));
+                                 maxiter = S::set1(static_cast<T>(tol.maxiter));
+                          }
+
+                          // new problems [a,b] in the lanes m
+                          __ATTR_ALWAYS_INLINE__
+                          inline void start(const M m,const V a,const V b)
+                          {
+                                 xa     = S::blend(m,xa,a);
+                                 xb     = S::blend(m,xb,b);
+                                 x_eval = S::blend(m,x_eval,a);
+                                 iters  = S::blend(m,iters,S::set1(T(0)));
+                                 ph_a   = S::m_or(ph_a,m);
+                          }
+
+                          __ATTR_ALWAYS_INLINE__
+                          inline M busy() const
+                          {
+                                 return (S::m_or(ph_a,S::m_or(ph_b,ph_it)));
+                          }
+
+                          // f(a) arrived: next f(b); returns the lanes which got f(b)
+                          __ATTR_ALWAYS_INLINE__
+                          inline M take_endpoints(const V f)
+                          {
+                                 const M got_b{ph_b};
+                                 fa     = S::blend(ph_a,fa,f);
+                                 x_eval = S::blend(ph_a,x_eval,xb);
+                                 ph_b   = ph_a;
+                                 ph_a   = S::from_bits(0u);
+                                 // no sign change: done
+                                 const M pos{S::gt(S::mul(fa,f),S::set1(T(0)))};
+                                 nob    = S::m_and(got_b,pos);
+                                 x_out  = S::blend(nob,x_out,xb);
+                                 f_out  = S::blend(nob,f_out,f);
+                                 return (S::m_andn(got_b,pos));
+                          }
+                   };
+
+                   template<typename L,root_method_t Method>
+                   struct root_lanes;
+
+                   // brentq (SciPy brentq.c as GMS_root_finding.hpp brentq)
+                   template<typename L>
+                   struct root_lanes<L,root_method_t::BRENTQ> : public root_lanes_base<L>
+                   {
+                          typedef root_lanes_base<L> B;
+                          typedef typename B::S S;
+                          typedef typename B::V V;
+                          typedef typename B::T T;
+                          typedef typename B::M M;
+
+                          V xpre,fpre,xcur,fcur,xblk,fblk,spre,scur;
+
+                          explicit root_lanes(const root_tol_t & tol) : B(tol)
+                          {
+                                 xpre = fpre = xcur = fcur = xblk = fblk = spre = scur = S::set1(T(0));
+                          }
+
+                          template<typename F,typename I>
+                          __ATTR_ALWAYS_INLINE__
+                          inline M round(F & f,const I idx)
+                          {
+                                 const V fx{f(this->x_eval,idx)};
+                                 return (advance(fx));
+                          }
+
+                          // the lanes finished in this round
+                          inline M advance(const V f)
+                          {
+                                 const V zero{S::set1(T(0))};
+                                 const V half{S::set1(T(0.5))};
+                                 const M it{this->ph_it};
+                                 const M init{this->take_endpoints(f)};
+                                 // started lanes: xpre = a, xcur = b
+                                 xpre = S::blend(init,xpre,this->xa);
+                                 fpre = S::blend(init,fpre,this->fa);
+                                 xcur = S::blend(init,xcur,this->xb);
+                                 fcur = S::blend(S::m_or(init,it),fcur,f);
+                                 const M run{S::m_or(init,it)};
+                                 // new bracket
+                                 const M sc{S::m_or(init,S::m_and(run,S::lt(S::mul(fpre,fcur),zero)))};
+                                 xblk = S::blend(sc,xblk,xpre);
+                                 fblk = S::blend(sc,fblk,fpre);
+                                 scur = S::blend(sc,scur,S::sub(xcur,xpre));
+                                 spre = S::blend(sc,spre,scur);
+                                 // best point in xcur
+                                 const M rot{S::m_and(run,S::lt(S::abs(fblk),S::abs(fcur)))};
+                                 const V tx{xcur},tf{fcur};
+                                 xpre = S::blend(rot,xpre,xcur);
+                                 fpre = S::blend(rot,fpre,fcur);
+                                 xcur = S::blend(rot,xcur,xblk);
+                                 fcur = S::blend(rot,fcur,fblk);
+                                 xblk = S::blend(rot,xblk,tx);
+                                 fblk = S::blend(rot,fblk,tf);
+                                 const V delta{S::mul(S::add(this->xtol,S::mul(this->rtol,S::abs(xcur))),half)};
+                                 const V sbis{S::mul(S::sub(xblk,xcur),half)};
+                                 const M conv{S::m_and(run,S::m_or(S::le(S::abs(fcur),this->ftol),S::lt(S::abs(sbis),delta)))};
+                                 const M lim{S::m_andn(S::m_and(run,S::le(this->maxiter,this->iters)),conv)};
+                                 const M cont{S::m_andn(S::m_andn(run,conv),lim)};
+                                 // interpolation (xpre == xblk) or inverse quadratic extrapolation
+                                 const V dpre{S::div(S::sub(fpre,fcur),S::sub(xpre,xcur))};
+                                 const V dblk{S::div(S::sub(fblk,fcur),S::sub(xblk,xcur))};
+                                 const V s_int{S::div(S::mul(S::neg(fcur),S::sub(xcur,xpre)),S::sub(fcur,fpre))};
+                                 const V s_ext{S::div(S::mul(S::neg(fcur),S::sub(S::mul(fblk,dblk),S::mul(fpre,dpre))),
+                                                      S::mul(S::mul(dblk,dpre),S::sub(fblk,fpre)))};
+                                 const V stry{S::blend(S::eq(xpre,xblk),s_ext,s_int)};
+                                 const M try_it{S::m_and(S::gt(S::abs(spre),delta),S::lt(S::abs(fcur),S::abs(fpre)))};
+                                 const V lim_s{S::min(S::abs(spre),S::sub(S::mul(S::set1(T(3)),S::abs(sbis)),delta))};
+                                 const M acc{S::m_and(try_it,S::lt(S::add(S::abs(stry),S::abs(stry)),lim_s))};
+                                 const V nspre{S::blend(acc,sbis,scur)};
+                                 const V nscur{S::blend(acc,sbis,stry)};
+                                 spre = S::blend(cont,spre,nspre);
+                                 scur = S::blend(cont,scur,nscur);
+                                 xpre = S::blend(cont,xpre,xcur);
+                                 fpre = S::blend(cont,fpre,fcur);
+                                 const V mind{S::blend(S::gt(sbis,zero),S::neg(delta),delta)};
+                                 const V step{S::blend(S::gt(S::abs(scur),delta),mind,scur)};
+                                 xcur = S::blend(cont,xcur,S::add(xcur,step));
+                                 this->x_eval = S::blend(cont,this->x_eval,xcur);
+                                 this->iters  = S::blend(cont,this->iters,S::add(this->iters,S::set1(T(1))));
+                                 const M done{S::m_or(conv,lim)};
+                                 this->x_out = S::blend(done,this->x_out,xcur);
+                                 this->f_out = S::blend(done,this->f_out,fcur);
+                                 this->maxit = lim;
+                                 this->ph_it = cont;
+                                 return (S::m_or(done,this->nob));
+                          }
+                   };
+
+                   // Newton with the bisection safeguard (rtsafe), f(xl) < 0 < f(xh)
+                   template<typename L>
+                   struct root_lanes<L,root_method_t::NEWTON> : public root_lanes_base<L>
+                   {
+                          typedef root_lanes_base<L> B;
+                          typedef typename B::S S;
+                          typedef typename B::V V;
+                          typedef typename B::T T;
+                          typedef typename B::M M;
+
+                          V xl,xh,x,dx,dxold,x0;
+                          M ph_fin;     // waits for f at the converged point
+                          M has_x0;
+
+                          explicit root_lanes(const root_tol_t & tol) : B(tol)
+                          {
+                                 xl = xh = x = dx = dxold = x0 = S::set1(T(0));
+                                 ph_fin = has_x0 = S::from_bits(0u);
+                          }
+
+                          // starting point of the lanes m (the midpoint otherwise, or when outside [a,b])
+                          __ATTR_ALWAYS_INLINE__
+                          inline void start_x0(const M m,const V x0v)
+                          {
+                                 x0     = S::blend(m,x0,x0v);
+                                 has_x0 = S::m_or(has_x0,m);
+                          }
+
+                          template<typename F,typename I>
+                          __ATTR_ALWAYS_INLINE__
+                          inline M round(F & f,const I idx)
+                          {
+                                 V df;
+                                 const V fx{f(this->x_eval,idx,df)};
+                                 return (advance(fx,df));
+                          }
+
+                          inline M advance(const V f,const V df)
+                          {
+                                 const V zero{S::set1(T(0))};
+                                 const V half{S::set1(T(0.5))};
+                                 const M it{this->ph_it};
+                                 const M fin{ph_fin};
+                                 const M init{this->take_endpoints(f)};
+                                 // oriented bracket, first point
+                                 const M alo{S::lt(this->fa,zero)};
+                                 xl = S::blend(init,xl,S::blend(alo,this->xb,this->xa));
+                                 xh = S::blend(init,xh,S::blend(alo,this->xa,this->xb));
+                                 const V lo{S::min(this->xa,this->xb)};
+                                 const V hi{S::max(this->xa,this->xb)};
+                                 const M in{S::m_and(has_x0,S::m_and(S::le(lo,x0),S::le(x0,hi)))};
+                                 const V xs{S::blend(in,S::mul(S::add(this->xa,this->xb),half),x0)};
+                                 x     = S::blend(init,x,xs);
+                                 dxold = S::blend(init,dxold,S::abs(S::sub(this->xb,this->xa)));
+                                 dx    = S::blend(init,dx,dxold);
+                                 // f(a) or f(b) zero: done at once
+                                 const M za{S::m_and(init,S::eq(this->fa,zero))};
+                                 const M zb{S::m_andn(S::m_and(init,S::eq(f,zero)),za)};
+                                 this->x_out = S::blend(za,this->x_out,this->xa);
+                                 this->f_out = S::blend(za,this->f_out,zero);
+                                 this->x_out = S::blend(zb,this->x_out,this->xb);
+                                 this->f_out = S::blend(zb,this->f_out,zero);
+                                 const M zab{S::m_or(za,zb)};
+                                 // the converged lanes got f(x)
+                                 this->x_out = S::blend(fin,this->x_out,x);
+                                 this->f_out = S::blend(fin,this->f_out,f);
+                                 // iterating lanes got f, f' at x
+                                 const M conv{S::m_and(it,S::le(S::abs(f),this->ftol))};
+                                 const M run{S::m_andn(it,conv)};
+                                 const M neg{S::lt(f,zero)};
+                                 xl = S::blend(S::m_and(run,neg),xl,x);
+                                 xh = S::blend(S::m_andn(run,neg),xh,x);
+                                 // Newton out of the bracket or not halving the step: bisect
+                                 const V t1{S::sub(S::mul(S::sub(x,xh),df),f)};
+                                 const V t2{S::sub(S::mul(S::sub(x,xl),df),f)};
+                                 const M out{S::m_or(S::gt(S::mul(t1,t2),zero),S::eq(df,zero))};
+                                 const M slow{S::gt(S::abs(S::add(f,f)),S::abs(S::mul(dxold,df)))};
+                                 const M bis{S::m_or(out,slow)};
+                                 const V dxb{S::mul(S::sub(xh,xl),half)};
+                                 const V dxn{S::div(f,df)};
+                                 const V nx{S::blend(bis,S::sub(x,dxn),S::add(xl,dxb))};
+                                 const V xp{x};
+                                 const V ndx{S::blend(bis,dxn,dxb)};
+                                 dxold = S::blend(run,dxold,dx);
+                                 dx    = S::blend(run,dx,ndx);
+                                 x     = S::blend(run,x,nx);
+                                 this->iters = S::blend(run,this->iters,S::add(this->iters,S::set1(T(1))));
+                                 const V delta{S::add(this->xtol,S::mul(this->rtol,S::abs(x)))};
+                                 const M small{S::m_and(run,S::lt(S::abs(dx),delta))};
+                                 const M lim{S::m_andn(S::m_and(run,S::le(this->maxiter,this->iters)),small)};
+                                 // out of iterations: the last evaluated point
+                                 this->x_out = S::blend(conv,this->x_out,x);
+                                 this->x_out = S::blend(lim,this->x_out,xp);
+                                 this->f_out = S::blend(S::m_or(conv,lim),this->f_out,f);
+                                 const M init_run{S::m_andn(init,zab)};
+                                 const M next{S::m_or(init_run,S::m_andn(run,lim))};
+                                 ph_fin       = small;
+                                 this->ph_it  = S::m_andn(next,small);
+                                 this->x_eval = S::blend(next,this->x_eval,x);
+                                 this->maxit  = lim;
+                                 return (S::m_or(S::m_or(this->nob,zab),S::m_or(S::m_or(fin,conv),lim)));
+                          }
+
+                          __ATTR_ALWAYS_INLINE__
+                          inline M busy() const
+                          {
+                                 return (S::m_or(B::busy(),ph_fin));
+                          }
+                   };
+
+                   // Illinois (modified regula falsi, as GMS_root_finding.hpp illinois)
+                   template<typename L>
+                   struct root_lanes<L,root_method_t::ILLINOIS> : public root_lanes_base<L>
+                   {
+                          typedef root_lanes_base<L> B;
+                          typedef typename B::S S;
+                          typedef typename B::V V;
+                          typedef typename B::T T;
+                          typedef typename B::M M;
+
+                          V x1,x2,f1,f2,f1e;   // f1e -- f(x1) before the halving
+
+                          explicit root_lanes(const root_tol_t & tol) : B(tol)
+                          {
+                                 x1 = x2 = f1 = f2 = f1e = S::set1(T(0));
+                          }
+
+                          template<typename F,typename I>
+                          __ATTR_ALWAYS_INLINE__
+                          inline M round(F & f,const I idx)
+                          {
+                                 const V fx{f(this->x_eval,idx)};
+                                 return (advance(fx));
+                          }
+
+                          // regula falsi, bisection when it leaves (x1,x2) or f1 == f2
+                          __ATTR_ALWAYS_INLINE__
+                          inline V rf_step() const
+                          {
+                                 const V d{S::sub(f2,f1)};
+                                 const V x3{S::sub(x1,S::mul(S::div(f1,d),S::sub(x2,x1)))};
+                                 const M inside{S::m_and(S::gt(x3,S::min(x1,x2)),S::lt(x3,S::max(x1,x2)))};
+                                 return (S::blend(inside,S::mul(S::add(x1,x2),S::set1(T(0.5))),x3));
+                          }
+
+                          inline M advance(const V f)
+                          {
+                                 const V zero{S::set1(T(0))};
+                                 const M it{this->ph_it};
+                                 const M init{this->take_endpoints(f)};
+                                 x1  = S::blend(init,x1,this->xa);
+                                 f1  = S::blend(init,f1,this->fa);
+                                 f1e = S::blend(init,f1e,this->fa);
+                                 x2  = S::blend(init,x2,this->xb);
+                                 f2  = S::blend(init,f2,f);
+                                 const M za{S::m_and(init,S::eq(this->fa,zero))};
+                                 const M zb{S::m_andn(S::m_and(init,S::eq(f,zero)),za)};
+                                 // lanes which got f(x3), x3 in x_eval
+                                 const V x3{this->x_eval};
+                                 const M conv{S::m_and(it,S::le(S::abs(f),this->ftol))};
+                                 const M run{S::m_andn(it,conv)};
+                                 const M chg{S::m_and(run,S::lt(S::mul(f2,f),zero))};
+                                 const M same{S::m_andn(run,chg)};
+                                 x1  = S::blend(chg,x1,x2);
+                                 f1  = S::blend(chg,f1,f2);
+                                 f1e = S::blend(chg,f1e,f2);
+                                 f1e = S::blend(same,f1e,f1);
+                                 f1  = S::blend(same,f1,S::mul(f1,S::set1(T(0.5))));
+                                 x2  = S::blend(run,x2,x3);
+                                 f2  = S::blend(run,f2,f);
+                                 this->iters = S::blend(run,this->iters,S::add(this->iters,S::set1(T(1))));
+                                 // converged(x1,x2): |x2-x1| <= xtol or <= rtol*|x1|
+                                 const V d{S::abs(S::sub(x2,x1))};
+                                 const M close{S::m_and(run,S::m_or(S::le(d,this->xtol),S::le(d,S::mul(this->rtol,S::abs(x1)))))};
+                                 const M lim{S::m_andn(S::m_and(run,S::le(this->maxiter,this->iters)),close)};
+                                 // choose_best(x1,x2,f1e,f2)
+                                 const M b1{S::lt(S::abs(f1e),S::abs(f2))};
+                                 const M fin{S::m_or(close,lim)};
+                                 this->x_out = S::blend(fin,this->x_out,S::blend(b1,x2,x1));
+                                 this->f_out = S::blend(fin,this->f_out,S::blend(b1,f2,f1e));
+                                 this->x_out = S::blend(conv,this->x_out,x3);
+                                 this->f_out = S::blend(conv,this->f_out,f);
+                                 this->x_out = S::blend(za,this->x_out,this->xa);
+                                 this->f_out = S::blend(za,this->f_out,zero);
+                                 this->x_out = S::blend(zb,this->x_out,this->xb);
+                                 this->f_out = S::blend(zb,this->f_out,zero);
+                                 const M zab{S::m_or(za,zb)};
+                                 const M next{S::m_or(S::m_andn(init,zab),S::m_andn(run,fin))};
+                                 this->x_eval = S::blend(next,this->x_eval,rf_step());
+                                 this->ph_it  = next;
+                                 this->maxit  = lim;
+                                 return (S::m_or(S::m_or(this->nob,zab),S::m_or(conv,fin)));
+                          }
+                   };
+
+                   template<typename L>
+                   struct root_block_t
+                   {
+                          typedef typename root_simd_traits<L>::V V;
+
+                          V x;
+                          V fx;
+                          V iters;
+                          typename root_simd_traits<L>::M no_bracket;
+                          typename root_simd_traits<L>::M maxiter;
+                   };
+
+                   namespace detail {
+
+                          template<typename L>
+                          inline typename root_simd_traits<L>::I lane_ids()
+                          {
+                                 alignas(64) int32_t id[root_simd_traits<L>::lanes];
+                                 for(int32_t __i{0}; __i != root_simd_traits<L>::lanes; ++__i) id[__i] = __i;
+                                 return (root_simd_traits<L>::idx_load(id));
+                          }
+
+                          template<typename L,root_method_t Method,typename F>
+                          inline root_block_t<L> solve_block(F & f,
+                                                             root_lanes<L,Method> & ln)
+                          {
+                                 typedef root_simd_traits<L> S;
+                                 typedef typename S::M M;
+                                 const auto idx{lane_ids<L>()};
+                                 root_block_t<L> r;
+                                 r.x  = r.fx = r.iters = S::set1(typename S::T(0));
+                                 r.no_bracket = r.maxiter = S::from_bits(0u);
+                                 while(S::bits(ln.busy()) != 0u)
+                                 {
+                                       const M done{ln.round(f,idx)};
+                                       r.x          = S::blend(done,r.x,ln.x_out);
+                                       r.fx         = S::blend(done,r.fx,ln.f_out);
+                                       r.iters      = S::blend(done,r.iters,ln.iters);
+                                       r.no_bracket = S::m_or(r.no_bracket,ln.nob);
+                                       r.maxiter    = S::m_or(r.maxiter,ln.maxit);
+                                 }
+                                 return (r);
+                          }
+
+                   } // detail
+
+                   /*
+                        Block form: all lanes of a, b (f(a)*f(b) <= 0 per lane).
+                   */
+                   template<typename L,typename F>
+                   inline root_block_t<L> root_brentq_simd(F && f,
+                                                           const typename root_simd_traits<L>::V a,
+                                                           const typename root_simd_traits<L>::V b,
+                                                           const root_tol_t & tol = root_tol_t{})
+                   {
+                          typedef root_simd_traits<L> S;
+                          typedef typename S::V V;
+                          root_lanes<L,root_method_t::BRENTQ> ln(tol);
+                          ln.start(S::from_bits((1u << S::lanes)-1u),a,b);
+                          auto g = [&f](const V x,const typename S::I) { return (f(x)); };
+                          return (detail::solve_block<L,root_method_t::BRENTQ>(g,ln));
+                   }
+
+                   template<typename L,typename F>
+                   inline root_block_t<L> root_newton_simd(F && fdf,
+                                                           const typename root_simd_traits<L>::V a,
+                                                           const typename root_simd_traits<L>::V b,
+                                                           const typename root_simd_traits<L>::V x0,
+                                                           const root_tol_t & tol = root_tol_t{})
+                   {
+                          typedef root_simd_traits<L> S;
+                          typedef typename S::V V;
+                          root_lanes<L,root_method_t::NEWTON> ln(tol);
+                          const typename S::M all{S::from_bits((1u << S::lanes)-1u)};
+                          ln.start(all,a,b);
+                          ln.start_x0(all,x0);
+                          auto g = [&fdf](const V x,const typename S::I,V & df) { return (fdf(x,df)); };
+                          return (detail::solve_block<L,root_method_t::NEWTON>(g,ln));
+                   }
+
+                   template<typename L,typename F>
+                   inline root_block_t<L> root_illinois_simd(F && f,
+                                                             const typename root_simd_traits<L>::V a,
+                                                             const typename root_simd_traits<L>::V b,
+                                                             const root_tol_t & tol = root_tol_t{})
+                   {
+                          typedef root_simd_traits<L> S;
+                          typedef typename S::V V;
+                          root_lanes<L,root_method_t::ILLINOIS> ln(tol);
+                          ln.start(S::from_bits((1u << S::lanes)-1u),a,b);
+                          auto g = [&f](const V x,const typename S::I) { return (f(x)); };
+                          return (detail::solve_block<L,root_method_t::ILLINOIS>(g,ln));
+                   }
+
+                   namespace detail {
+
+                          /*
+                               One set of lanes of root_solve_array: refill, one round,
+                               write-out of the finished lanes. next -- the next problem,
+                               shared by the streams.
+                          */
+                          template<typename L,root_method_t Method>
+                          struct root_stream_t
+                          {
+                                 typedef root_simd_traits<L> S;
+                                 typedef typename S::V V;
+                                 typedef typename S::T T;
+                                 typedef typename S::M M;
+                                 static constexpr int32_t NL{S::lanes};
+                                 static constexpr int32_t thr{(NL/ROOT_SIMD_REFILL_DIV > 1) ? NL/ROOT_SIMD_REFILL_DIV : 1};
+
+                                 root_lanes<L,Method> ln;
+                                 alignas(64) int32_t id[NL];
+                                 alignas(64) T tx[NL];
+                                 alignas(64) T tf[NL];
+                                 alignas(64) T ti[NL];
+                                 uint32_t live;
+                                 uint32_t fresh;
+                                 uint32_t fin;      // finished, results not yet written
+                                 uint32_t nb;
+                                 uint32_t mb;
+
+                                 root_stream_t() : ln(root_tol_t{}) {}
+
+                                 inline void init(const root_tol_t & tol,
+                                                  int32_t & next,
+                                                  const int32_t n)
+                                 {
+                                        ln = root_lanes<L,Method>(tol);
+                                        live = fresh = fin = nb = mb = 0u;
+                                        for(int32_t __l{0}; __l != NL; ++__l)
+                                        {
+                                            if(next < n) { id[__l] = next++; fresh |= 1u << __l; }
+                                            else id[__l] = n-1;
+                                        }
+                                 }
+
+                                 // false when the stream has nothing left to do
+                                 template<typename F>
+                                 inline bool step(F & f,
+                                                  const T * __restrict a,
+                                                  const T * __restrict b,
+                                                  const T * __restrict x0,
+                                                  T * __restrict x,
+                                                  T * __restrict fx,
+                                                  int32_t * __restrict status,
+                                                  int32_t * __restrict iters,
+                                                  int32_t & next,
+                                                  int32_t & nbad,
+                                                  const int32_t n)
+                                 {
+                                        if(fresh != 0u)
+                                        {
+                                           const auto idx{S::idx_load(id)};
+                                           const M m{S::from_bits(fresh)};
+                                           const V va{S::gather(S::set1(T(0)),m,idx,a)};
+                                           const V vb{S::gather(S::set1(T(0)),m,idx,b)};
+                                           ln.start(m,va,vb);
+                                           if constexpr(Method == root_method_t::NEWTON)
+                                           {
+                                                if(x0 != nullptr) ln.start_x0(m,S::gather(S::set1(T(0)),m,idx,x0));
+                                                else ln.start_x0(m,S::set1(std::numeric_limits<T>::quiet_NaN()));
+                                           }
+                                           live |= fresh;
+                                           fresh = 0u;
+                                        }
+                                        if(live != 0u)
+                                        {
+                                           const M done{ln.round(f,S::idx_load(id))};
+                                           const uint32_t db{S::bits(done) & live};
+                                           nb   |= S::bits(ln.nob) & db;
+                                           mb   |= S::bits(ln.maxit) & db;
+                                           fin  |= db;
+                                           live &= ~db;
+                                           // finished lanes keep x_out, f_out, iters until restarted
+                                           if(__builtin_popcount(fin) < thr && live != 0u) return (true);
+                                        }
+                                        if(fin == 0u) return (false);
+                                        S::store(tx,ln.x_out);
+                                        S::store(tf,ln.f_out);
+                                        S::store(ti,ln.iters);
+                                        for(uint32_t __m{fin}; __m != 0u; __m &= __m-1u)
+                                        {
+                                            const int32_t l{__builtin_ctz(__m)};
+                                            const int32_t p{id[l]};
+                                            const int32_t st{((nb >> l) & 1u) ? ROOT_NO_BRACKET :
+                                                             (((mb >> l) & 1u) ? ROOT_MAXITER : ROOT_OK)};
+                                            x[p]  = tx[l];
+                                            fx[p] = tf[l];
+                                            if(status != nullptr) status[p] = st;
+                                            if(iters != nullptr)  iters[p]  = static_cast<int32_t>(ti[l]);
+                                            nbad += (st != ROOT_OK);
+                                            if(next < n) { id[l] = next++; fresh |= 1u << l; }
+                                        }
+                                        fin = nb = mb = 0u;
+                                        return ((live|fresh) != 0u);
+                                 }
+                          };
+
+                   } // detail
+
+                   /*
+                        Array form: problems 0..n-1 with brackets [a[i],b[i]] (x0 -- starting
+                        points of Newton, may be nullptr), a finished lane takes the next
+                        problem (in groups of L/ROOT_SIMD_REFILL_DIV lanes, which amortizes the
+                        scalar write-out and the gathers). ROOT_SIMD_STREAMS independent sets
+                        of lanes are advanced in turn: one round is a chain of dependent
+                        divisions and blends, the rounds of the other sets fill its latency.
+                        status and iters may be nullptr. Returns the number of problems which
+                        are not ROOT_OK.
+                   */
+                   template<typename L,root_method_t Method,typename F>
+                   inline int32_t root_solve_array(F && f,
+                                                   const typename root_simd_traits<L>::T * __restrict a,
+                                                   const typename root_simd_traits<L>::T * __restrict b,
+                                                   const typename root_simd_traits<L>::T * __restrict x0,
+                                                   typename root_simd_traits<L>::T * __restrict x,
+                                                   typename root_simd_traits<L>::T * __restrict fx,
+                                                   int32_t * __restrict status,
+                                                   int32_t * __restrict iters,
+                                                   const int32_t n,
+                                                   const root_tol_t & tol = root_tol_t{})
+                   {
+                          if(n <= 0) return (0);
+                          int32_t next{0};
+                          int32_t nbad{0};
+                          detail::root_stream_t<L,Method> st[ROOT_SIMD_STREAMS];
+                          for(int32_t __s{0}; __s != ROOT_SIMD_STREAMS; ++__s) st[__s].init(tol,next,n);
+                          uint32_t act{(1u << ROOT_SIMD_STREAMS)-1u};
+                          while(act != 0u)
+                          {
+                                for(int32_t __s{0}; __s != ROOT_SIMD_STREAMS; ++__s)
+                                {
+                                    if(((act >> __s) & 1u) != 0u &&
+                                       !st[__s].step(f,a,b,x0,x,fx,status,iters,next,nbad,n))
+                                       act &= ~(1u << __s);
+                                }
+                          }
+                          return (nbad);
+                   }
+
+           } // math
+
+} // gms
+
+#endif /*__GMS_ROOT_FINDING_SIMD_HPP__*/
@@ -0,0 +1,811 @@
+
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+#include <climits>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_spatial_index.h"
+
+
+namespace {
+
+        using gms::math::KDTree;
+        using gms::math::UniformGrid;
+
+        // Tasks are spawned for the k-d tree subtrees larger than this.
+        constexpr int32_t kd_task_min{32768};
+
+        struct kd_item_t {
+
+               int32_t node;
+               int32_t lo;
+               int32_t hi;
+               double  d2;
+        };
+
+        int32_t kd_max_node(const int32_t node,
+                            const int32_t cnt) {
+               if(cnt <= KDTREE_LEAF_MAX) return node;
+               return std::max(kd_max_node(2*node+1,cnt/2),
+                               kd_max_node(2*node+2,cnt-cnt/2));
+        }
+
+        void kd_build_rec(KDTree & t,
+                          int32_t * __restrict idx,
+                          const double * __restrict pset,
+                          const int32_t node,
+                          const int32_t lo,
+                          const int32_t hi) {
+               if(hi-lo <= KDTREE_LEAF_MAX) {
+                  t.sdim[node]  = -1;
+                  t.split[node] = 0.0;
+                  return;
+               }
+               const int32_t dim{t.dim};
+               double bmin[KDTREE_DIM_MAX],bmax[KDTREE_DIM_MAX];
+               for(int32_t __d{0}; __d != dim; ++__d) {bmin[__d] = DBL_MAX; bmax[__d] = -DBL_MAX;}
+               for(int32_t __i{lo}; __i != hi; ++__i) {
+                   const double * __restrict p{&pset[static_cast<std::size_t>(dim)*idx[__i]]};
+                   for(int32_t __d{0}; __d != dim; ++__d) {
+                       bmin[__d] = std::min(bmin[__d],p[__d]);
+                       bmax[__d] = std::max(bmax[__d],p[__d]);
+                   }
+               }
+               int32_t sd{0};
+               for(int32_t __d{1}; __d != dim; ++__d)
+                   if(bmax[__d]-bmin[__d] > bmax[sd]-bmin[sd]) sd = __d;
+               const int32_t mid{lo+(hi-lo)/2};
+               std::nth_element(idx+lo,idx+mid,idx+hi,[=](const int32_t a,const int32_t b) {
+                                const double xa{pset[static_cast<std::size_t>(dim)*a+sd]};
+                                const double xb{pset[static_cast<std::size_t>(dim)*b+sd]};
+                                return (xa < xb || (xa == xb && a < b));});
+               t.sdim[node]  = sd;
+               t.split[node] = pset[static_cast<std::size_t>(dim)*idx[mid]+sd];
+#pragma omp task default(none) shared(t) firstprivate(idx,pset,node,lo,mid) if(mid-lo > kd_task_min)
+               kd_build_rec(t,idx,pset,2*node+1,lo,mid);
+#pragma omp task default(none) shared(t) firstprivate(idx,pset,node,mid,hi) if(hi-mid > kd_task_min)
+               kd_build_rec(t,idx,pset,2*node+2,mid,hi);
+#pragma omp taskwait
+        }
+
+        // squared distances of the leaf points [lo,hi) to q, unit stride over the points
+        inline void kd_leaf_d2(const KDTree & t,
+                               const double * __restrict q,
+                               const int32_t lo,
+                               const int32_t cnt,
+                               double * __restrict d2) {
+#pragma omp simd
+               for(int32_t __j = 0; __j < cnt; ++__j) d2[__j] = 0.0;
+               for(int32_t __d{0}; __d != t.dim; ++__d) {
+                   const double * __restrict x{&t.pts[static_cast<std::size_t>(__d)*t.ld+lo]};
+                   const double qd{q[__d]};
+#pragma omp simd
+                   for(int32_t __j = 0; __j < cnt; ++__j) {
+                       const double dx{x[__j]-qd};
+                       d2[__j] += dx*dx;
+                   }
+               }
+        }
+
+        // sorted (distance,index) insertion into the k best
+        inline void knn_insert(double * __restrict bd,
+                               int32_t * __restrict bi,
+                               const int32_t k,
+                               const double d2,
+                               const int32_t i) {
+               int32_t __j{k-1};
+               while(__j > 0 && (d2 < bd[__j-1] || (d2 == bd[__j-1] && i < bi[__j-1]))) {
+                     bd[__j] = bd[__j-1];
+                     bi[__j] = bi[__j-1];
+                     --__j;
+               }
+               bd[__j] = d2;
+               bi[__j] = i;
+        }
+
+        void kd_knn(const KDTree & t,
+                    const double * __restrict q,
+                    const int32_t k,
+                    double * __restrict bd,
+                    int32_t * __restrict bi) {
+               for(int32_t __j{0}; __j != k; ++__j) {bd[__j] = DBL_MAX; bi[__j] = INT_MAX;}
+               kd_item_t stack[128];
+               int32_t sp{0};
+               stack[sp++] = {0,0,t.n,0.0};
+               __ATTR_ALIGN__(64) double d2[KDTREE_LEAF_MAX];
+               while(sp != 0) {
+                     kd_item_t it{stack[--sp]};
+                     if(it.d2 > bd[k-1]) continue;
+                     while(t.sdim[it.node] >= 0) {
+                           const int32_t sd{t.sdim[it.node]};
+                           const double diff{q[sd]-t.split[it.node]};
+                           const int32_t mid{it.lo+(it.hi-it.lo)/2};
+                           const int32_t l{2*it.node+1};
+                           if(diff < 0.0) {
+                              stack[sp++] = {l+1,mid,it.hi,diff*diff};
+                              it = {l,it.lo,mid,0.0};
+                           }
+                           else {
+                              stack[sp++] = {l,it.lo,mid,diff*diff};
+                              it = {l+1,mid,it.hi,0.0};
+                           }
+                     }
+                     const int32_t cnt{it.hi-it.lo};
+                     kd_leaf_d2(t,q,it.lo,cnt,d2);
+                     for(int32_t __j{0}; __j != cnt; ++__j) {
+                         const int32_t i{t.perm[it.lo+__j]};
+                         if(d2[__j] < bd[k-1] || (d2[__j] == bd[k-1] && i < bi[k-1]))
+                            knn_insert(bd,bi,k,d2[__j],i);
+                     }
+               }
+        }
+
+        inline int32_t grid_cell1(const UniformGrid & g,
+                                  const double x,
+                                  const int32_t d) {
+               const double c{std::floor((x-g.lo[d])*g.ih)};
+               if(c < 0.0) return 0;
+               if(c >= static_cast<double>(g.nc[d]-1)) return g.nc[d]-1;
+               return static_cast<int32_t>(c);
+        }
+
+        inline int64_t grid_cell_id(const UniformGrid & g,
+                                    const int32_t * __restrict c) {
+               return (g.dim == 2) ? static_cast<int64_t>(c[1])*g.nc[0]+c[0] :
+                                     (static_cast<int64_t>(c[2])*g.nc[1]+c[1])*g.nc[0]+c[0];
+        }
+
+        // scans the cells [c0,c1] (inclusive box), f(j,d2) for every point
+        template<typename Visit>
+        inline void grid_scan_box(const UniformGrid & g,
+                                  const double * __restrict q,
+                                  const int32_t * __restrict c0,
+                                  const int32_t * __restrict c1,
+                                  Visit visit) {
+               const int32_t z0{(g.dim == 3) ? c0[2] : 0};
+               const int32_t z1{(g.dim == 3) ? c1[2] : 0};
+               for(int32_t __z{z0}; __z <= z1; ++__z)
+                   for(int32_t __y{c0[1]}; __y <= c1[1]; ++__y) {
+                       const int64_t row{(static_cast<int64_t>(__z)*g.nc[1]+__y)*g.nc[0]};
+                       // the cells of a row are contiguous in the sorted points
+                       const int32_t s0{g.cell_start[row+c0[0]]};
+                       const int32_t s1{g.cell_start[row+c1[0]+1]};
+                       for(int32_t __j{s0}; __j < s1; ++__j) {
+                           double d2{0.0};
+                           for(int32_t __d{0}; __d != g.dim; ++__d) {
+                               const double dx{g.pts[static_cast<std::size_t>(__d)*g.ld+__j]-q[__d]};
+                               d2 += dx*dx;
+                           }
+                           if(!visit(__j,d2)) return;
+                       }
+                   }
+        }
+
+        inline bool radius_box(const UniformGrid & g,
+                               const double * __restrict q,
+                               const double r,
+                               int32_t * __restrict c0,
+                               int32_t * __restrict c1) {
+               for(int32_t __d{0}; __d != g.dim; ++__d) {
+                   if(q[__d]+r < g.lo[__d] || q[__d]-r > g.lo[__d]+g.h*g.nc[__d]) return false;
+                   c0[__d] = grid_cell1(g,q[__d]-r,__d);
+                   c1[__d] = grid_cell1(g,q[__d]+r,__d);
+               }
+               return true;
+        }
+
+        template<typename Query>
+        int32_t * csr_batch_omp(const int32_t nq,
+                                int32_t * __restrict offs,
+                                Query query) {
+               offs[0] = 0;
+#pragma omp parallel for schedule(dynamic,256) default(none) shared(nq,offs,query)
+               for(int32_t __i = 0; __i < nq; ++__i)
+                   offs[__i+1] = query(__i,nullptr,0);
+               for(int32_t __i{0}; __i != nq; ++__i) offs[__i+1] += offs[__i];
+               int32_t * __restrict idx{new int32_t[std::max(offs[nq],1)]};
+#pragma omp parallel for schedule(dynamic,256) default(none) shared(nq,offs,query,idx)
+               for(int32_t __i = 0; __i < nq; ++__i)
+                   query(__i,&idx[offs[__i]],offs[__i+1]-offs[__i]);
+               return idx;
+        }
+
+}
+
+
+bool
+gms::math::kdtree_build(KDTree & t,
+                        const int32_t dim,
+                        const int32_t n,
+                        const double * __restrict pset) {
+
+       std::memset(&t,0,sizeof(t));
+       if(dim < 1 || dim > KDTREE_DIM_MAX || n < 1) return false;
+       t.dim    = dim;
+       t.n      = n;
+       t.ld     = (n+7)&~7;
+       t.nnodes = kd_max_node(0,n)+1;
+       t.pts    = reinterpret_cast<double*>(_mm_malloc(static_cast<std::size_t>(dim)*t.ld*sizeof(double),64ULL));
+       t.perm   = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(n)*sizeof(int32_t),64ULL));
+       t.split  = reinterpret_cast<double*>(_mm_malloc(static_cast<std::size_t>(t.nnodes)*sizeof(double),64ULL));
+       t.sdim   = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(t.nnodes)*sizeof(int32_t),64ULL));
+       if(t.pts == nullptr || t.perm == nullptr || t.split == nullptr || t.sdim == nullptr) {
+          kdtree_free(t);
+          return false;
+       }
+       int32_t * __restrict idx{t.perm};
+       for(int32_t __i{0}; __i != n; ++__i) idx[__i] = __i;
+       // nodes outside the implied tree are never visited
+       std::fill(t.sdim,t.sdim+t.nnodes,-1);
+#pragma omp parallel default(none) shared(t,idx,pset,n)
+       {
+#pragma omp single
+            kd_build_rec(t,idx,pset,0,0,n);
+       }
+#pragma omp parallel for schedule(static) default(none) shared(t,idx,pset,n,dim)
+       for(int32_t __j = 0; __j < n; ++__j) {
+           for(int32_t __d{0}; __d != dim; ++__d)
+               t.pts[static_cast<std::size_t>(__d)*t.ld+__j] = pset[static_cast<std::size_t>(dim)*idx[__j]+__d];
+       }
+       return true;
+}
+
+
+void
+gms::math::kdtree_free(KDTree & t) {
+
+       if(t.pts   != nullptr) _mm_free(t.pts);
+       if(t.perm  != nullptr) _mm_free(t.perm);
+       if(t.split != nullptr) _mm_free(t.split);
+       if(t.sdim  != nullptr) _mm_free(t.sdim);
+       std::memset(&t,0,sizeof(t));
+}
+
+
+int32_t
+gms::math::kdtree_nearest(const KDTree & t,
+                          const double * __restrict q,
+                          double * __restrict d_min) {
+
+       double  bd;
+       int32_t bi;
+       kd_knn(t,q,1,&bd,&bi);
+       *d_min = std::sqrt(bd);
+       return bi;
+}
+
+
+void
+gms::math::kdtree_knn(const KDTree & t,
+                      const double * __restrict q,
+                      const int32_t k,
+                      int32_t * __restrict idx,
+                      double  * __restrict dist) {
+
+       kd_knn(t,q,k,dist,idx);
+       for(int32_t __j{0}; __j != k; ++__j) dist[__j] = std::sqrt(dist[__j]);
+}
+
+
+int32_t
+gms::math::kdtree_radius(const KDTree & t,
+                         const double * __restrict q,
+                         const double r,
+                         int32_t * __restrict idx,
+                         const int32_t cap) {
+
+       const double r2{r*r};
+       kd_item_t stack[128];
+       int32_t sp{0};
+       int32_t cnt{0};
+       stack[sp++] = {0,0,t.n,0.0};
+       __ATTR_ALIGN__(64) double d2[KDTREE_LEAF_MAX];
+       while(sp != 0) {
+             kd_item_t it{stack[--sp]};
+             if(it.d2 > r2) continue;
+             while(t.sdim[it.node] >= 0) {
+                   const int32_t sd{t.sdim[it.node]};
+                   const double diff{q[sd]-t.split[it.node]};
+                   const int32_t mid{it.lo+(it.hi-it.lo)/2};
+                   const int32_t l{2*it.node+1};
+                   if(diff < 0.0) {
+                      if(diff*diff <= r2) stack[sp++] = {l+1,mid,it.hi,diff*diff};
+                      it = {l,it.lo,mid,0.0};
+                   }
+                   else {
+                      if(diff*diff <= r2) stack[sp++] = {l,it.lo,mid,diff*diff};
+                      it = {l+1,mid,it.hi,0.0};
+                   }
+             }
+             const int32_t n{it.hi-it.lo};
+             kd_leaf_d2(t,q,it.lo,n,d2);
+             for(int32_t __j{0}; __j != n; ++__j) {
+                 if(d2[__j] <= r2) {
+                    if(cnt < cap) idx[cnt] = t.perm[it.lo+__j];
+                    ++cnt;
+                 }
+             }
+       }
+       return cnt;
+}
+
+
+void
+gms::math::kdtree_knn_batch_omp(const KDTree & t,
+                                const int32_t nq,
+                                const double * __restrict q,
+                                const int32_t k,
+                                int32_t * __restrict idx,
+                                double  * __restrict dist) {
+
+#pragma omp parallel for schedule(dynamic,256) default(none) shared(t,nq,q,k,idx,dist)
+       for(int32_t __i = 0; __i < nq; ++__i) {
+           kdtree_knn(t,&q[static_cast<std::size_t>(t.dim)*__i],k,
+                      &idx[static_cast<std::size_t>(k)*__i],&dist[static_cast<std::size_t>(k)*__i]);
+       }
+}
+
+
+int32_t *
+gms::math::kdtree_radius_batch_omp(const KDTree & t,
+                                   const int32_t nq,
+                                   const double * __restrict q,
+                                   const double r,
+                                   int32_t * __restrict offs) {
+
+       return csr_batch_omp(nq,offs,[&](const int32_t i,int32_t * out,const int32_t cap) {
+              return kdtree_radius(t,&q[static_cast<std::size_t>(t.dim)*i],r,out,cap);});
+}
+
+
+bool
+gms::math::grid_build(UniformGrid & g,
+                      const int32_t dim,
+                      const int32_t n,
+                      const double * __restrict pset,
+                      const double cell) {
+
+       std::memset(&g,0,sizeof(g));
+       if((dim != 2 && dim != 3) || n < 1) return false;
+       g.dim = dim;
+       g.n   = n;
+       g.ld  = (n+7)&~7;
+       double hi[3] = {0.0,0.0,0.0};
+       for(int32_t __d{0}; __d != 3; ++__d) {g.lo[__d] = (__d < dim) ? DBL_MAX : 0.0; hi[__d] = (__d < dim) ? -DBL_MAX : 0.0;}
+       for(int32_t __j{0}; __j != n; ++__j)
+           for(int32_t __d{0}; __d != dim; ++__d) {
+               g.lo[__d] = std::min(g.lo[__d],pset[static_cast<std::size_t>(dim)*__j+__d]);
+               hi[__d]   = std::max(hi[__d],pset[static_cast<std::size_t>(dim)*__j+__d]);
+           }
+       double emax{0.0};
+       double vol{1.0};
+       for(int32_t __d{0}; __d != dim; ++__d) emax = std::max(emax,hi[__d]-g.lo[__d]);
+       if(emax <= 0.0) emax = 1.0;
+       for(int32_t __d{0}; __d != dim; ++__d) vol *= std::max(hi[__d]-g.lo[__d],1.0e-3*emax);
+       double h{(cell > 0.0) ? cell : std::pow(2.0*vol/static_cast<double>(n),1.0/dim)};
+       // at most ~8 cells per point
+       while(true) {
+             int64_t nc{1};
+             for(int32_t __d{0}; __d != dim; ++__d)
+                 nc *= static_cast<int64_t>((hi[__d]-g.lo[__d])/h)+1;
+             if(nc <= 8LL*n+64LL) break;
+             h *= 1.25;
+       }
+       g.h  = h;
+       g.ih = 1.0/h;
+       g.ncells = 1;
+       g.nc[0] = g.nc[1] = g.nc[2] = 1;
+       for(int32_t __d{0}; __d != dim; ++__d) {
+           g.nc[__d] = static_cast<int32_t>((hi[__d]-g.lo[__d])*g.ih)+1;
+           g.ncells *= g.nc[__d];
+       }
+       g.cell_start = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(g.ncells+1)*sizeof(int32_t),64ULL));
+       g.perm       = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(n)*sizeof(int32_t),64ULL));
+       g.pts        = reinterpret_cast<double*>(_mm_malloc(static_cast<std::size_t>(dim)*g.ld*sizeof(double),64ULL));
+       int32_t * __restrict cid{reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(n)*sizeof(int32_t),64ULL))};
+       if(g.cell_start == nullptr || g.perm == nullptr || g.pts == nullptr || cid == nullptr) {
+          if(cid != nullptr) _mm_free(cid);
+          grid_free(g);
+          return false;
+       }
+#pragma omp parallel for schedule(static) default(none) shared(g,pset,cid,n,dim)
+       for(int32_t __j = 0; __j < n; ++__j) {
+           int32_t c[3] = {0,0,0};
+           for(int32_t __d{0}; __d != dim; ++__d)
+               c[__d] = grid_cell1(g,pset[static_cast<std::size_t>(dim)*__j+__d],__d);
+           cid[__j] = static_cast<int32_t>(grid_cell_id(g,c));
+       }
+       // counting sort, stable (ascending pset index within a cell)
+       std::fill(g.cell_start,g.cell_start+g.ncells+1,0);
+       for(int32_t __j{0}; __j != n; ++__j) g.cell_start[cid[__j]+1] += 1;
+       for(int64_t __c{0}; __c != g.ncells; ++__c) g.cell_start[__c+1] += g.cell_start[__c];
+       for(int32_t __j{0}; __j != n; ++__j) {
+           const int32_t s{g.cell_start[cid[__j]]++};
+           g.perm[s] = __j;
+       }
+       for(int64_t __c{g.ncells}; __c > 0; --__c) g.cell_start[__c] = g.cell_start[__c-1];
+       g.cell_start[0] = 0;
+       _mm_free(cid);
+#pragma omp parallel for schedule(static) default(none) shared(g,pset,n,dim)
+       for(int32_t __j = 0; __j < n; ++__j) {
+           for(int32_t __d{0}; __d != dim; ++__d)
+               g.pts[static_cast<std::size_t>(__d)*g.ld+__j] = pset[static_cast<std::size_t>(dim)*g.perm[__j]+__d];
+       }
+       return true;
+}
+
+
+void
+gms::math::grid_free(UniformGrid & g) {
+
+       if(g.cell_start != nullptr) _mm_free(g.cell_start);
+       if(g.perm       != nullptr) _mm_free(g.perm);
+       if(g.pts        != nullptr) _mm_free(g.pts);
+       std::memset(&g,0,sizeof(g));
+}
+
+
+int32_t
+gms::math::grid_nearest(const UniformGrid & g,
+                        const double * __restrict q,
+                        double * __restrict d_min) {
+
+       int32_t c[3] = {0,0,0};
+       for(int32_t __d{0}; __d != g.dim; ++__d) c[__d] = grid_cell1(g,q[__d],__d);
+       double  bd{DBL_MAX};
+       int32_t bi{INT_MAX};
+       auto visit = [&](const int32_t j,const double d2) {
+            const int32_t i{g.perm[j]};
+            if(d2 < bd || (d2 == bd && i < bi)) {bd = d2; bi = i;}
+            return true;
+       };
+       for(int32_t __r{0}; ; ++__r) {
+           // shell of the cube [c-r,c+r]: slabs of the faces, no cell is visited twice
+           int32_t c0[3],c1[3];
+           bool full[3] = {true,true,true};
+           double gap{DBL_MAX};
+           for(int32_t __d{0}; __d != g.dim; ++__d) {
+               c0[__d] = std::max(c[__d]-__r,0);
+               c1[__d] = std::min(c[__d]+__r,g.nc[__d]-1);
+               if(c[__d]-__r > 0) {full[__d] = false; gap = std::min(gap,q[__d]-(g.lo[__d]+g.h*(c[__d]-__r)));}
+               if(c[__d]+__r < g.nc[__d]-1) {full[__d] = false; gap = std::min(gap,g.lo[__d]+g.h*(c[__d]+__r+1)-q[__d]);}
+           }
+           if(__r == 0) {
+              grid_scan_box(g,q,c0,c1,visit);
+           }
+           else {
+              for(int32_t __d{0}; __d != g.dim; ++__d) {
+                  // faces normal to d, the axes before d are already shrunk to the inner range
+                  int32_t a0[3],a1[3];
+                  for(int32_t __e{0}; __e != g.dim; ++__e) {
+                      a0[__e] = c0[__e]; a1[__e] = c1[__e];
+                      if(__e < __d) {a0[__e] = std::max(c[__e]-__r+1,0); a1[__e] = std::min(c[__e]+__r-1,g.nc[__e]-1);}
+                  }
+                  bool empty{false};
+                  for(int32_t __e{0}; __e != g.dim; ++__e) empty = empty || (a0[__e] > a1[__e]);
+                  if(empty) continue;
+                  if(c[__d]-__r >= 0) {
+                     int32_t b0[3],b1[3];
+                     std::memcpy(b0,a0,sizeof(b0)); std::memcpy(b1,a1,sizeof(b1));
+                     b0[__d] = b1[__d] = c[__d]-__r;
+                     grid_scan_box(g,q,b0,b1,visit);
+                  }
+                  if(c[__d]+__r <= g.nc[__d]-1) {
+                     int32_t b0[3],b1[3];
+                     std::memcpy(b0,a0,sizeof(b0)); std::memcpy(b1,a1,sizeof(b1));
+                     b0[__d] = b1[__d] = c[__d]+__r;
+                     grid_scan_box(g,q,b0,b1,visit);
+                  }
+              }
+           }
+           bool all{true};
+           for(int32_t __d{0}; __d != g.dim; ++__d) all = all && full[__d];
+           if(all) break;
+           if(gap > 0.0 && bd < gap*gap) break;
+       }
+       *d_min = std::sqrt(bd);
+       return bi;
+}
+
+
+int32_t
+gms::math::grid_radius(const UniformGrid & g,
+                       const double * __restrict q,
+                       const double r,
+                       int32_t * __restrict idx,
+                       const int32_t cap) {
+
+       int32_t c0[3],c1[3];
+       if(!radius_box(g,q,r,c0,c1)) return 0;
+       const double r2{r*r};
+       int32_t cnt{0};
+       grid_scan_box(g,q,c0,c1,[&](const int32_t j,const double d2) {
+            if(d2 <= r2) {
+               if(cnt < cap) idx[cnt] = g.perm[j];
+               ++cnt;
+            }
+            return true;
+       });
+       return cnt;
+}
+
+
+bool
+gms::math::grid_any_within(const UniformGrid & g,
+                           const double * __restrict q,
+                           const double r) {
+
+       int32_t c0[3],c1[3];
+       if(!radius_box(g,q,r,c0,c1)) return false;
+       const double r2{r*r};
+       bool found{false};
+       grid_scan_box(g,q,c0,c1,[&](const int32_t,const double d2) {
+            found = (d2 < r2);
+            return !found;
+       });
+       return found;
+}
+
+
+void
+gms::math::grid_nearest_batch_omp(const UniformGrid & g,
+                                  const int32_t nq,
+                                  const double * __restrict q,
+                                  int32_t * __restrict idx,
+                                  double  * __restrict d_min) {
+
+#pragma omp parallel for schedule(dynamic,256) default(none) shared(g,nq,q,idx,d_min)
+       for(int32_t __i = 0; __i < nq; ++__i)
+           idx[__i] = grid_nearest(g,&q[static_cast<std::size_t>(g.dim)*__i],&d_min[__i]);
+}
+
+
+int32_t *
+gms::math::grid_radius_batch_omp(const UniformGrid & g,
+                                 const int32_t nq,
+                                 const double * __restrict q,
+                                 const double r,
+                                 int32_t * __restrict offs) {
+
+       return csr_batch_omp(nq,offs,[&](const int32_t i,int32_t * out,const int32_t cap) {
+              return grid_radius(g,&q[static_cast<std::size_t>(g.dim)*i],r,out,cap);});
+}
+
+
+bool
+gms::math::trilocator_build(TriLocator & l,
+                            const int32_t node_num,
+                            const double * __restrict node_xy,
+                            const int32_t triangle_order,
+                            const int32_t triangle_num,
+                            const int32_t * __restrict triangle_node) {
+
+       std::memset(&l,0,sizeof(l));
+       if(node_num < 3 || triangle_num < 1) return false;
+       double hi[2] = {-DBL_MAX,-DBL_MAX};
+       l.lo[0] = l.lo[1] = DBL_MAX;
+       for(int32_t __j{0}; __j != node_num; ++__j)
+           for(int32_t __d{0}; __d != 2; ++__d) {
+               l.lo[__d] = std::min(l.lo[__d],node_xy[2*__j+__d]);
+               hi[__d]   = std::max(hi[__d],node_xy[2*__j+__d]);
+           }
+       const double ex{std::max(hi[0]-l.lo[0],DBL_MIN)};
+       const double ey{std::max(hi[1]-l.lo[1],DBL_MIN)};
+       // about one triangle per cell
+       l.h  = std::sqrt(ex*ey/static_cast<double>(triangle_num));
+       if(!(l.h > 0.0)) l.h = std::max(ex,ey);
+       l.ih = 1.0/l.h;
+       l.nc[0] = static_cast<int32_t>(ex*l.ih)+1;
+       l.nc[1] = static_cast<int32_t>(ey*l.ih)+1;
+       l.ntri  = triangle_num;
+       const int64_t ncells{static_cast<int64_t>(l.nc[0])*l.nc[1]};
+       l.cell_start = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(ncells+1)*sizeof(int32_t),64ULL));
+       int32_t * __restrict box{reinterpret_cast<int32_t*>(_mm_malloc(4ULL*triangle_num*sizeof(int32_t),64ULL))};
+       if(l.cell_start == nullptr || box == nullptr) {
+          if(box != nullptr) _mm_free(box);
+          trilocator_free(l);
+          return false;
+       }
+       auto cell = [&](const double x,const int32_t d) {
+            const int32_t c{static_cast<int32_t>((x-l.lo[d])*l.ih)};
+            return std::min(std::max(c,0),l.nc[d]-1);
+       };
+#pragma omp parallel for schedule(static) default(none) shared(node_xy,triangle_order,triangle_num,triangle_node,box,cell)
+       for(int32_t __t = 0; __t < triangle_num; ++__t) {
+           double bx0{DBL_MAX},by0{DBL_MAX},bx1{-DBL_MAX},by1{-DBL_MAX};
+           for(int32_t __v{0}; __v != 3; ++__v) {
+               const int32_t a{triangle_node[__v+__t*triangle_order]};
+               bx0 = std::min(bx0,node_xy[2*a]);   bx1 = std::max(bx1,node_xy[2*a]);
+               by0 = std::min(by0,node_xy[2*a+1]); by1 = std::max(by1,node_xy[2*a+1]);
+           }
+           box[4*__t+0] = cell(bx0,0); box[4*__t+1] = cell(by0,1);
+           box[4*__t+2] = cell(bx1,0); box[4*__t+3] = cell(by1,1);
+       }
+       std::fill(l.cell_start,l.cell_start+ncells+1,0);
+       for(int32_t __t{0}; __t != triangle_num; ++__t)
+           for(int32_t __y{box[4*__t+1]}; __y <= box[4*__t+3]; ++__y)
+               for(int32_t __x{box[4*__t+0]}; __x <= box[4*__t+2]; ++__x)
+                   l.cell_start[static_cast<int64_t>(__y)*l.nc[0]+__x+1] += 1;
+       for(int64_t __c{0}; __c != ncells; ++__c) l.cell_start[__c+1] += l.cell_start[__c];
+       l.nslots = l.cell_start[ncells];
+       const std::size_t sb{static_cast<std::size_t>(std::max(l.nslots,1))*sizeof(double)};
+       l.tri = reinterpret_cast<int32_t*>(_mm_malloc(static_cast<std::size_t>(std::max(l.nslots,1))*sizeof(int32_t),64ULL));
+       l.cx  = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       l.cy  = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       l.dxa = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       l.dya = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       l.dxb = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       l.dyb = reinterpret_cast<double*>(_mm_malloc(sb,64ULL));
+       if(l.tri == nullptr || l.cx == nullptr || l.cy == nullptr || l.dxa == nullptr ||
+          l.dya == nullptr || l.dxb == nullptr || l.dyb == nullptr) {
+          _mm_free(box);
+          trilocator_free(l);
+          return false;
+       }
+       // slots of a cell in ascending triangle order
+       for(int32_t __t{0}; __t != triangle_num; ++__t) {
+           const int32_t a{triangle_node[0+__t*triangle_order]};
+           const int32_t b{triangle_node[1+__t*triangle_order]};
+           const int32_t c{triangle_node[2+__t*triangle_order]};
+           for(int32_t __y{box[4*__t+1]}; __y <= box[4*__t+3]; ++__y)
+               for(int32_t __x{box[4*__t+0]}; __x <= box[4*__t+2]; ++__x) {
+                   const int32_t s{l.cell_start[static_cast<int64_t>(__y)*l.nc[0]+__x]++};
+                   l.tri[s] = __t;
+                   l.cx[s]  = node_xy[0+c*2];
+                   l.cy[s]  = node_xy[1+c*2];
+                   l.dxa[s] = node_xy[0+a*2]-node_xy[0+c*2];
+                   l.dya[s] = node_xy[1+a*2]-node_xy[1+c*2];
+                   l.dxb[s] = node_xy[0+b*2]-node_xy[0+c*2];
+                   l.dyb[s] = node_xy[1+b*2]-node_xy[1+c*2];
+               }
+       }
+       for(int64_t __c{ncells}; __c > 0; --__c) l.cell_start[__c] = l.cell_start[__c-1];
+       l.cell_start[0] = 0;
+       _mm_free(box);
+       return true;
+}
+
+
+void
+gms::math::trilocator_free(TriLocator & l) {
+
+       if(l.cell_start != nullptr) _mm_free(l.cell_start);
+       if(l.tri != nullptr) _mm_free(l.tri);
+       if(l.cx  != nullptr) _mm_free(l.cx);
+       if(l.cy  != nullptr) _mm_free(l.cy);
+       if(l.dxa != nullptr) _mm_free(l.dxa);
+       if(l.dya != nullptr) _mm_free(l.dya);
+       if(l.dxb != nullptr) _mm_free(l.dxb);
+       if(l.dyb != nullptr) _mm_free(l.dyb);
+       std::memset(&l,0,sizeof(l));
+}
+
+
+int32_t
+gms::math::trilocator_search(const TriLocator & l,
+                             const double * __restrict p) {
+
+       const double x{p[0]};
+       const double y{p[1]};
+       const double fx{std::floor((x-l.lo[0])*l.ih)};
+       const double fy{std::floor((y-l.lo[1])*l.ih)};
+       if(fx < 0.0 || fy < 0.0 || fx >= static_cast<double>(l.nc[0]) || fy >= static_cast<double>(l.nc[1])) return -1;
+       const int64_t c{static_cast<int64_t>(fy)*l.nc[0]+static_cast<int64_t>(fx)};
+       const int32_t s0{l.cell_start[c]};
+       const int32_t s1{l.cell_start[c+1]};
+       int32_t best{INT_MAX};
+       // barycentric test of triangulation_search_naive over all slots of the cell
+#pragma omp simd reduction(min:best)
+       for(int32_t __s = s0; __s < s1; ++__s) {
+           const double dxp{x-l.cx[__s]};
+           const double dyp{y-l.cy[__s]};
+           const double det{l.dxa[__s]*l.dyb[__s]-l.dya[__s]*l.dxb[__s]};
+           const double alpha{(dxp*l.dyb[__s]-dyp*l.dxb[__s])/det};
+           const double beta{(l.dxa[__s]*dyp-l.dya[__s]*dxp)/det};
+           const double gamma{1.0-alpha-beta};
+           const bool in{0.0 <= alpha && 0.0 <= beta && 0.0 <= gamma};
+           best = in ? std::min(best,l.tri[__s]) : best;
+       }
+       return (best == INT_MAX) ? -1 : best+1;
+}
+
+
+void
+gms::math::trilocator_search_batch_omp(const TriLocator & l,
+                                       const int32_t np,
+                                       const double * __restrict p,
+                                       int32_t * __restrict tri_index) {
+
+#pragma omp parallel for schedule(static) default(none) shared(l,np,p,tri_index)
+       for(int32_t __i = 0; __i < np; ++__i)
+           tri_index[__i] = trilocator_search(l,&p[2*__i]);
+}
+
+
+int32_t *
+gms::math::points_points_near_kdtree_nd(const int32_t dim_num,
+                                        const int32_t nset,
+                                        const double * __restrict pset,
+                                        const int32_t ntest,
+                                        const double * __restrict ptest) {
+
+       int32_t * __restrict nearest{new int32_t[std::max(ntest,1)]};
+       KDTree t;
+       if(!kdtree_build(t,dim_num,nset,pset)) {
+          std::fill(nearest,nearest+std::max(ntest,1),-1);
+          return nearest;
+       }
+#pragma omp parallel for schedule(dynamic,256) default(none) shared(t,ntest,ptest,nearest,dim_num)
+       for(int32_t __i = 0; __i < ntest; ++__i) {
+           double d;
+           nearest[__i] = kdtree_nearest(t,&ptest[static_cast<std::size_t>(dim_num)*__i],&d);
+       }
+       kdtree_free(t);
+       return nearest;
+}
+
+
+int32_t *
+gms::math::points_points_near_kdtree_2d(const int32_t nset,
+                                        const double * __restrict pset,
+                                        const int32_t ntest,
+                                        const double * __restrict ptest) {
+
+       return points_points_near_kdtree_nd(2,nset,pset,ntest,ptest);
+}
+
+
+int32_t *
+gms::math::points_points_near_kdtree_3d(const int32_t nset,
+                                        const double * __restrict pset,
+                                        const int32_t ntest,
+                                        const double * __restrict ptest) {
+
+       return points_points_near_kdtree_nd(3,nset,pset,ntest,ptest);
+}
+
+
+void
+gms::math::points_avoid_point_grid_2d(const int32_t n,
+                                      const double * __restrict pset,
+                                      const int32_t ntest,
+                                      const double * __restrict ptest,
+                                      bool * __restrict avoid) {
+
+       if(n < 1) {
+          std::fill(avoid,avoid+ntest,true);
+          return;
+       }
+       UniformGrid g;
+       if(!grid_build(g,2,n,pset,0.0)) {
+          std::fill(avoid,avoid+ntest,false);
+          return;
+       }
+       const double tol{100.0*DBL_EPSILON};
+#pragma omp parallel for schedule(static) default(none) shared(g,ntest,ptest,avoid,tol)
+       for(int32_t __i = 0; __i < ntest; ++__i)
+           avoid[__i] = !grid_any_within(g,&ptest[2*__i],tol);
+       grid_free(g);
+}
@@ -0,0 +1,274 @@
+#ifndef __GMS_SPATIAL_INDEX_H__
+#define __GMS_SPATIAL_INDEX_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_SPATIAL_INDEX_MAJOR = 1U;
+    const unsigned int GMS_SPATIAL_INDEX_MINOR = 0U;
+    const unsigned int GMS_SPATIAL_INDEX_MICRO = 0U;
+    const unsigned int GMS_SPATIAL_INDEX_FULLVER =
+      1000U*GMS_SPATIAL_INDEX_MAJOR+100U*GMS_SPATIAL_INDEX_MINOR+10U*GMS_SPATIAL_INDEX_MICRO;
+    const char * const GMS_SPATIAL_INDEX_CREATION_DATE = "19-10-2026 17:40 PM +00200 (MON 19 OCT 2026 GMT+2)";
+    const char * const GMS_SPATIAL_INDEX_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_SPATIAL_INDEX_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_SPATIAL_INDEX_DESCRIPTION   = "k-d tree, uniform grid and triangle locator (batched, OpenMP) for the GMS_geometry/GMS_triangulation point queries.";
+
+}
+
+/*
+     Accelerated replacements of the O(N)-per-query routines
+     points_point_near_naive_2d/3d/nd, points_points_near_naive_2d/3d,
+     points_avoid_point_naive_2d (GMS_geometry) and triangulation_search_naive
+     (GMS_triangulation).
+     Point sets use the same layout as those routines: pset[dim*j+i], i-th
+     coordinate of the j-th point. All returned point indices are indices of pset.
+     The indexes keep their own copy of the coordinates (SoA, in tree/cell order),
+     so the leaf and cell scans are unit stride and vectorize.
+     The *_batch_omp functions distribute the queries over OpenMP threads.
+     Compile GMS_spatial_index.cpp with -ffp-contract=off (icpc: -no-fma), the
+     barycentric test then reproduces triangulation_search_naive bit for bit
+     for the points on the edges and vertices.
+*/
+
+#include <cstdint>
+#include "GMS_config.h"
+
+// Maximum number of points in a k-d tree leaf.
+#if !defined(KDTREE_LEAF_MAX)
+#define KDTREE_LEAF_MAX 16
+#endif
+
+// Maximum dimension of the k-d tree.
+#if !defined(KDTREE_DIM_MAX)
+#define KDTREE_DIM_MAX 8
+#endif
+
+namespace gms {
+
+        namespace math {
+
+                  /*
+                        Balanced k-d tree (median split along the widest extent).
+                        The node i has the children 2i+1, 2i+2 and covers a range of the
+                        tree ordered points which is implied by the median splits, so only
+                        the split dimension and value are stored per node.
+                  */
+                  struct __ATTR_ALIGN__(64) KDTree {
+
+                         int32_t dim;
+                         int32_t n;
+                         int32_t nnodes;
+                         int32_t ld;                      // leading dimension of pts (n rounded up to 8)
+                         double  * __restrict pts;        // pts[d*ld+j], tree order
+                         int32_t * __restrict perm;       // tree order -> pset index
+                         double  * __restrict split;      // split value
+                         int32_t * __restrict sdim;       // split dimension, -1 -- leaf
+                  };
+
+                  bool kdtree_build(KDTree & t,
+                                    const int32_t dim,
+                                    const int32_t n,
+                                    const double * __restrict pset);
+
+                  void kdtree_free(KDTree & t);
+
+                  /*
+                        Nearest point of q, returns its index, *d_min is the distance.
+                        Equal distances resolve to the lower index (as in the naive search).
+                  */
+                  int32_t kdtree_nearest(const KDTree & t,
+                                         const double * __restrict q,
+                                         double * __restrict d_min);
+
+                  /*
+                        k nearest points of q (k <= n), ascending distance.
+                  */
+                  void kdtree_knn(const KDTree & t,
+                                  const double * __restrict q,
+                                  const int32_t k,
+                                  int32_t * __restrict idx,
+                                  double  * __restrict dist);
+
+                  /*
+                        Points within the distance r of q (|p-q| <= r), unordered.
+                        Returns the number of points, only the first cap of them are stored.
+                  */
+                  int32_t kdtree_radius(const KDTree & t,
+                                        const double * __restrict q,
+                                        const double r,
+                                        int32_t * __restrict idx,
+                                        const int32_t cap);
+
+                  // q[dim*i+d], idx/dist[k*i+j]
+                  void kdtree_knn_batch_omp(const KDTree & t,
+                                            const int32_t nq,
+                                            const double * __restrict q,
+                                            const int32_t k,
+                                            int32_t * __restrict idx,
+                                            double  * __restrict dist);
+
+                  /*
+                        Radius search of nq points, CSR result: the points of the query i are
+                        idx[offs[i]..offs[i+1]), idx is allocated with new [] (caller deletes).
+                  */
+                  int32_t * kdtree_radius_batch_omp(const KDTree & t,
+                                                    const int32_t nq,
+                                                    const double * __restrict q,
+                                                    const double r,
+                                                    int32_t * __restrict offs);
+
+                  /*
+                        Uniform grid (2D or 3D) of cubic cells, points sorted by cell.
+                  */
+                  struct __ATTR_ALIGN__(64) UniformGrid {
+
+                         int32_t dim;
+                         int32_t n;
+                         int32_t nc[3];                   // cells per axis
+                         int32_t ld;
+                         int64_t ncells;
+                         double  lo[3];                   // lower corner
+                         double  h;                       // cell size
+                         double  ih;
+                         int32_t * __restrict cell_start; // [ncells+1]
+                         int32_t * __restrict perm;       // cell order -> pset index
+                         double  * __restrict pts;        // pts[d*ld+j], cell order
+                  };
+
+                  /*
+                        cell <= 0.0 selects the cell size for about two points per cell.
+                  */
+                  bool grid_build(UniformGrid & g,
+                                  const int32_t dim,
+                                  const int32_t n,
+                                  const double * __restrict pset,
+                                  const double cell);
+
+                  void grid_free(UniformGrid & g);
+
+                  int32_t grid_nearest(const UniformGrid & g,
+                                       const double * __restrict q,
+                                       double * __restrict d_min);
+
+                  int32_t grid_radius(const UniformGrid & g,
+                                      const double * __restrict q,
+                                      const double r,
+                                      int32_t * __restrict idx,
+                                      const int32_t cap);
+
+                  // true if a point lies within the distance r of q.
+                  bool grid_any_within(const UniformGrid & g,
+                                       const double * __restrict q,
+                                       const double r);
+
+                  void grid_nearest_batch_omp(const UniformGrid & g,
+                                              const int32_t nq,
+                                              const double * __restrict q,
+                                              int32_t * __restrict idx,
+                                              double  * __restrict d_min);
+
+                  int32_t * grid_radius_batch_omp(const UniformGrid & g,
+                                                  const int32_t nq,
+                                                  const double * __restrict q,
+                                                  const double r,
+                                                  int32_t * __restrict offs);
+
+                  /*
+                        Point location in a 2D triangulation (order 3 or 6, 0-based nodes,
+                        as in triangulation_search_naive). Triangles are binned by their
+                        bounding boxes, every cell stores a copy of the data of its
+                        triangles (cell major SoA) for a vectorized barycentric test.
+                  */
+                  struct __ATTR_ALIGN__(64) TriLocator {
+
+                         int32_t ntri;
+                         int32_t nc[2];
+                         int32_t nslots;
+                         double  lo[2];
+                         double  h;
+                         double  ih;
+                         int32_t * __restrict cell_start; // [nc[0]*nc[1]+1]
+                         int32_t * __restrict tri;        // triangle index of the slot
+                         double  * __restrict cx;         // vertex C
+                         double  * __restrict cy;
+                         double  * __restrict dxa;        // A-C
+                         double  * __restrict dya;
+                         double  * __restrict dxb;        // B-C
+                         double  * __restrict dyb;
+                  };
+
+                  bool trilocator_build(TriLocator & l,
+                                        const int32_t node_num,
+                                        const double * __restrict node_xy,
+                                        const int32_t triangle_order,
+                                        const int32_t triangle_num,
+                                        const int32_t * __restrict triangle_node);
+
+                  void trilocator_free(TriLocator & l);
+
+                  /*
+                        Same result as triangulation_search_naive: the lowest (1-based) index
+                        of a triangle containing p, or -1.
+                  */
+                  int32_t trilocator_search(const TriLocator & l,
+                                            const double * __restrict p);
+
+                  void trilocator_search_batch_omp(const TriLocator & l,
+                                                   const int32_t np,
+                                                   const double * __restrict p,
+                                                   int32_t * __restrict tri_index);
+
+                  /*
+                        Drop-in versions of the naive GMS_geometry routines (the index is
+                        built per call, keep a KDTree/UniformGrid for repeated queries).
+                  */
+                  int32_t * points_points_near_kdtree_2d(const int32_t nset,
+                                                         const double * __restrict pset,
+                                                         const int32_t ntest,
+                                                         const double * __restrict ptest);
+
+                  int32_t * points_points_near_kdtree_3d(const int32_t nset,
+                                                         const double * __restrict pset,
+                                                         const int32_t ntest,
+                                                         const double * __restrict ptest);
+
+                  int32_t * points_points_near_kdtree_nd(const int32_t dim_num,
+                                                         const int32_t nset,
+                                                         const double * __restrict pset,
+                                                         const int32_t ntest,
+                                                         const double * __restrict ptest);
+
+                  /*
+                        Batched points_avoid_point_naive_2d: avoid[i] is true if ptest i is
+                        at least 100*eps away from every point of pset.
+                  */
+                  void points_avoid_point_grid_2d(const int32_t n,
+                                                  const double * __restrict pset,
+                                                  const int32_t ntest,
+                                                  const double * __restrict ptest,
+                                                  bool * __restrict avoid);
+
+        } // math
+
+} // gms
+
+#endif /*__GMS_SPATIAL_INDEX_H__*/
@@ -0,0 +1,730 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_delaunay_omp.h"
+
+
+namespace {
+
+        // Subproblems larger than this are triangulated by two tasks.
+        constexpr int32_t dc_task_min{16384};
+        // Cut-off of the parallel merge sort.
+        constexpr int32_t sort_task_min{65536};
+
+        /*
+              Robust predicates, J.R. Shewchuk, "Adaptive Precision Floating-Point
+              Arithmetic and Fast Robust Geometric Predicates", 1997.
+              Expansions are stored in the increasing magnitude order, zero components
+              eliminated.
+        */
+        constexpr double pr_eps{1.1102230246251565404e-16}; // 2^-53
+        constexpr double ccwerrboundA{(3.0+16.0*pr_eps)*pr_eps};
+        constexpr double iccerrboundA{(10.0+96.0*pr_eps)*pr_eps};
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void fast_two_sum(const double a,
+                          const double b,
+                          double & x,
+                          double & y) {
+               x = a+b;
+               const double bv{x-a};
+               y = b-bv;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void two_sum(const double a,
+                     const double b,
+                     double & x,
+                     double & y) {
+               x = a+b;
+               const double bv{x-a};
+               const double av{x-bv};
+               y = (a-av)+(b-bv);
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void two_diff(const double a,
+                      const double b,
+                      double & x,
+                      double & y) {
+               x = a-b;
+               const double bv{a-x};
+               const double av{x+bv};
+               y = (a-av)+(bv-b);
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void two_prod(const double a,
+                      const double b,
+                      double & x,
+                      double & y) {
+               x = a*b;
+               y = std::fma(a,b,-x);
+        }
+
+        // a-b as an expansion of at most 2 components.
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t diff_expansion(const double a,
+                               const double b,
+                               double * __restrict e) {
+               double x,y;
+               two_diff(a,b,x,y);
+               if(y != 0.0) {e[0] = y; e[1] = x; return 2;}
+               e[0] = x;
+               return 1;
+        }
+
+        int32_t fast_expansion_sum_zeroelim(const int32_t elen,
+                                            const double * __restrict e,
+                                            const int32_t flen,
+                                            const double * __restrict f,
+                                            double * __restrict h) {
+               double Q,Qnew,hh;
+               double enow{e[0]}, fnow{f[0]};
+               int32_t ei{0}, fi{0}, hi{0};
+               if((fnow > enow) == (fnow > -enow)) {
+                  Q = enow;
+                  enow = (++ei < elen) ? e[ei] : 0.0;
+               }
+               else {
+                  Q = fnow;
+                  fnow = (++fi < flen) ? f[fi] : 0.0;
+               }
+               if(ei < elen && fi < flen) {
+                  if((fnow > enow) == (fnow > -enow)) {
+                     fast_two_sum(enow,Q,Qnew,hh);
+                     enow = (++ei < elen) ? e[ei] : 0.0;
+                  }
+                  else {
+                     fast_two_sum(fnow,Q,Qnew,hh);
+                     fnow = (++fi < flen) ? f[fi] : 0.0;
+                  }
+                  Q = Qnew;
+                  if(hh != 0.0) h[hi++] = hh;
+                  while(ei < elen && fi < flen) {
+                        if((fnow > enow) == (fnow > -enow)) {
+                           two_sum(Q,enow,Qnew,hh);
+                           enow = (++ei < elen) ? e[ei] : 0.0;
+                        }
+                        else {
+                           two_sum(Q,fnow,Qnew,hh);
+                           fnow = (++fi < flen) ? f[fi] : 0.0;
+                        }
+                        Q = Qnew;
+                        if(hh != 0.0) h[hi++] = hh;
+                  }
+               }
+               while(ei < elen) {
+                     two_sum(Q,enow,Qnew,hh);
+                     enow = (++ei < elen) ? e[ei] : 0.0;
+                     Q = Qnew;
+                     if(hh != 0.0) h[hi++] = hh;
+               }
+               while(fi < flen) {
+                     two_sum(Q,fnow,Qnew,hh);
+                     fnow = (++fi < flen) ? f[fi] : 0.0;
+                     Q = Qnew;
+                     if(hh != 0.0) h[hi++] = hh;
+               }
+               if(Q != 0.0 || hi == 0) h[hi++] = Q;
+               return hi;
+        }
+
+        int32_t scale_expansion_zeroelim(const int32_t elen,
+                                         const double * __restrict e,
+                                         const double b,
+                                         double * __restrict h) {
+               double Q,sum,hh,p1,p0;
+               int32_t hi{0};
+               two_prod(e[0],b,Q,hh);
+               if(hh != 0.0) h[hi++] = hh;
+               for(int32_t __i{1}; __i < elen; ++__i) {
+                   two_prod(e[__i],b,p1,p0);
+                   two_sum(Q,p0,sum,hh);
+                   if(hh != 0.0) h[hi++] = hh;
+                   fast_two_sum(p1,sum,Q,hh);
+                   if(hh != 0.0) h[hi++] = hh;
+               }
+               if(Q != 0.0 || hi == 0) h[hi++] = Q;
+               return hi;
+        }
+
+        // h = e*f (elen <= 16), h and w hold 2*elen*flen entries.
+        int32_t expansion_product(const int32_t elen,
+                                  const double * __restrict e,
+                                  const int32_t flen,
+                                  const double * __restrict f,
+                                  double * __restrict h,
+                                  double * __restrict w) {
+               double t[32];
+               double * a{h};
+               double * b{w};
+               int32_t alen{scale_expansion_zeroelim(elen,e,f[0],a)};
+               for(int32_t __i{1}; __i < flen; ++__i) {
+                   const int32_t tlen{scale_expansion_zeroelim(elen,e,f[__i],t)};
+                   alen = fast_expansion_sum_zeroelim(alen,a,tlen,t,b);
+                   std::swap(a,b);
+               }
+               if(a != h) std::copy(a,a+alen,h);
+               return alen;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void negate_expansion(const int32_t elen,
+                              double * __restrict e) {
+               for(int32_t __i{0}; __i < elen; ++__i) e[__i] = -e[__i];
+        }
+
+        double orient2d_exact(const double * __restrict pa,
+                              const double * __restrict pb,
+                              const double * __restrict pc) {
+               double acx[2],acy[2],bcx[2],bcy[2];
+               double l[8],r[8],w[8],det[16];
+               const int32_t acxl{diff_expansion(pa[0],pc[0],acx)};
+               const int32_t acyl{diff_expansion(pa[1],pc[1],acy)};
+               const int32_t bcxl{diff_expansion(pb[0],pc[0],bcx)};
+               const int32_t bcyl{diff_expansion(pb[1],pc[1],bcy)};
+               const int32_t ll{expansion_product(acxl,acx,bcyl,bcy,l,w)};
+               const int32_t rl{expansion_product(acyl,acy,bcxl,bcx,r,w)};
+               negate_expansion(rl,r);
+               const int32_t dl{fast_expansion_sum_zeroelim(ll,l,rl,r,det)};
+               return det[dl-1];
+        }
+
+        // ex^2+ey^2
+        int32_t lift_expansion(const int32_t exl,
+                               const double * __restrict ex,
+                               const int32_t eyl,
+                               const double * __restrict ey,
+                               double * __restrict h) {
+               double xx[8],yy[8],w[8];
+               const int32_t xxl{expansion_product(exl,ex,exl,ex,xx,w)};
+               const int32_t yyl{expansion_product(eyl,ey,eyl,ey,yy,w)};
+               return fast_expansion_sum_zeroelim(xxl,xx,yyl,yy,h);
+        }
+
+        // ux*vy-uy*vx
+        int32_t cross_expansion(const int32_t uxl,
+                                const double * __restrict ux,
+                                const int32_t uyl,
+                                const double * __restrict uy,
+                                const int32_t vxl,
+                                const double * __restrict vx,
+                                const int32_t vyl,
+                                const double * __restrict vy,
+                                double * __restrict h) {
+               double l[8],r[8],w[8];
+               const int32_t ll{expansion_product(uxl,ux,vyl,vy,l,w)};
+               const int32_t rl{expansion_product(uyl,uy,vxl,vx,r,w)};
+               negate_expansion(rl,r);
+               return fast_expansion_sum_zeroelim(ll,l,rl,r,h);
+        }
+
+        double incircle_exact(const double * __restrict pa,
+                              const double * __restrict pb,
+                              const double * __restrict pc,
+                              const double * __restrict pd) {
+               double adx[2],ady[2],bdx[2],bdy[2],cdx[2],cdy[2];
+               double lift[16],cross[16];
+               double ta[512],tb[512],tc[512],w[512];
+               double tab[1024],det[1536];
+               const int32_t adxl{diff_expansion(pa[0],pd[0],adx)};
+               const int32_t adyl{diff_expansion(pa[1],pd[1],ady)};
+               const int32_t bdxl{diff_expansion(pb[0],pd[0],bdx)};
+               const int32_t bdyl{diff_expansion(pb[1],pd[1],bdy)};
+               const int32_t cdxl{diff_expansion(pc[0],pd[0],cdx)};
+               const int32_t cdyl{diff_expansion(pc[1],pd[1],cdy)};
+               int32_t ll,cl;
+               ll = lift_expansion(adxl,adx,adyl,ady,lift);
+               cl = cross_expansion(bdxl,bdx,bdyl,bdy,cdxl,cdx,cdyl,cdy,cross);
+               const int32_t tal{expansion_product(ll,lift,cl,cross,ta,w)};
+               ll = lift_expansion(bdxl,bdx,bdyl,bdy,lift);
+               cl = cross_expansion(cdxl,cdx,cdyl,cdy,adxl,adx,adyl,ady,cross);
+               const int32_t tbl{expansion_product(ll,lift,cl,cross,tb,w)};
+               ll = lift_expansion(cdxl,cdx,cdyl,cdy,lift);
+               cl = cross_expansion(adxl,adx,adyl,ady,bdxl,bdx,bdyl,bdy,cross);
+               const int32_t tcl{expansion_product(ll,lift,cl,cross,tc,w)};
+               const int32_t tabl{fast_expansion_sum_zeroelim(tal,ta,tbl,tb,tab)};
+               const int32_t dl{fast_expansion_sum_zeroelim(tabl,tab,tcl,tc,det)};
+               return det[dl-1];
+        }
+
+        /*
+              Divide and conquer. The nodes are permuted into pt[], a subproblem owns
+              the contiguous range pt[lo..hi) and the edge slots [3*lo,3*hi) (the planar
+              bound 3*m-6 leaves room for the merge), the half edges of the slot s are
+              2*s and 2*s+1 (Sym). Only the primal ring pointers Onext/Oprev are kept.
+              Free slots of a subproblem form a list linked through onext[].
+        */
+        struct dc_pt_t {
+
+               double  x;
+               double  y;
+               int32_t id;
+               int32_t pad;
+        };
+
+        struct dc_ctx_t {
+
+               dc_pt_t * __restrict pt;
+               int32_t * __restrict org;
+               int32_t * __restrict onext;
+               int32_t * __restrict oprev;
+        };
+
+        struct dc_free_t {
+
+               int32_t head;
+               int32_t tail;
+        };
+
+        // Lexicographic order of the cut axis: (x,y) for 0, (y,-x) for 1 (rotated frame).
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        bool dc_less(const dc_pt_t & a,
+                     const dc_pt_t & b,
+                     const int32_t axis) {
+               if(axis == 0) return (a.x < b.x) || (a.x == b.x && a.y < b.y);
+               return (a.y < b.y) || (a.y == b.y && a.x > b.x);
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        bool dc_ccw(const dc_ctx_t & c,
+                    const int32_t a,
+                    const int32_t b,
+                    const int32_t d) {
+               return gms::math::orient2d_robust(&c.pt[a].x,&c.pt[b].x,&c.pt[d].x) > 0.0;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        bool dc_incircle(const dc_ctx_t & c,
+                         const int32_t a,
+                         const int32_t b,
+                         const int32_t d,
+                         const int32_t e) {
+               return gms::math::incircle_robust(&c.pt[a].x,&c.pt[b].x,&c.pt[d].x,&c.pt[e].x) > 0.0;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t dc_dest(const dc_ctx_t & c,
+                        const int32_t e) {
+               return c.org[e^1];
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t dc_lnext(const dc_ctx_t & c,
+                         const int32_t e) {
+               return c.oprev[e^1];
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t dc_rprev(const dc_ctx_t & c,
+                         const int32_t e) {
+               return c.onext[e^1];
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void dc_splice(const dc_ctx_t & c,
+                       const int32_t a,
+                       const int32_t b) {
+               const int32_t al{c.onext[a]};
+               const int32_t be{c.onext[b]};
+               c.onext[a]  = be;
+               c.onext[b]  = al;
+               c.oprev[al] = b;
+               c.oprev[be] = a;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t dc_make_edge(const dc_ctx_t & c,
+                             dc_free_t & fl,
+                             const int32_t a,
+                             const int32_t b) {
+               const int32_t e{fl.head};
+               fl.head = c.onext[e];
+               if(fl.head < 0) fl.tail = -1;
+               c.org[e]     = a;
+               c.org[e+1]   = b;
+               c.onext[e]   = e;
+               c.oprev[e]   = e;
+               c.onext[e+1] = e+1;
+               c.oprev[e+1] = e+1;
+               return e;
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void dc_delete_edge(const dc_ctx_t & c,
+                            dc_free_t & fl,
+                            const int32_t e) {
+               dc_splice(c,e,c.oprev[e]);
+               dc_splice(c,e^1,c.oprev[e^1]);
+               const int32_t s{e & ~1};
+               c.org[s]   = -1;
+               c.org[s+1] = -1;
+               c.onext[s] = fl.head;
+               if(fl.head < 0) fl.tail = s;
+               fl.head = s;
+        }
+
+        // New edge from Dest(a) to Org(b), a, new edge and b share the left face.
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        int32_t dc_connect(const dc_ctx_t & c,
+                           dc_free_t & fl,
+                           const int32_t a,
+                           const int32_t b) {
+               const int32_t e{dc_make_edge(c,fl,dc_dest(c,a),c.org[b])};
+               dc_splice(c,e,dc_lnext(c,a));
+               dc_splice(c,e^1,b);
+               return e;
+        }
+
+        // 2 or 3 nodes, returns an edge with the outer face on its right.
+        int32_t dc_leaf(const dc_ctx_t & c,
+                        const int32_t lo,
+                        const int32_t hi,
+                        const int32_t axis,
+                        dc_free_t & fl) {
+               dc_pt_t * __restrict p{c.pt};
+               for(int32_t __i{lo+1}; __i < hi; ++__i)
+                   for(int32_t __j{__i}; __j > lo && dc_less(p[__j],p[__j-1],axis); --__j)
+                       std::swap(p[__j],p[__j-1]);
+               fl.head = -1;
+               fl.tail = -1;
+               for(int32_t __s{3*hi-1}; __s >= 3*lo; --__s) {
+                   c.onext[2*__s] = fl.head;
+                   if(fl.head < 0) fl.tail = 2*__s;
+                   fl.head = 2*__s;
+               }
+               const int32_t a{dc_make_edge(c,fl,lo,lo+1)};
+               if(hi-lo == 2) return a;
+               const int32_t b{dc_make_edge(c,fl,lo+1,lo+2)};
+               dc_splice(c,a^1,b);
+               if(dc_ccw(c,lo,lo+1,lo+2)) {
+                  dc_connect(c,fl,b,a);
+                  return a;
+               }
+               if(dc_ccw(c,lo,lo+2,lo+1)) {
+                  const int32_t e{dc_connect(c,fl,b,a)};
+                  return e^1;
+               }
+               return a;
+        }
+
+        int32_t dc_rec(const dc_ctx_t & c,
+                       const int32_t lo,
+                       const int32_t hi,
+                       const int32_t axis,
+                       const bool sorted,
+                       dc_free_t & fl) {
+               const int32_t n{hi-lo};
+               if(n <= 3) return dc_leaf(c,lo,hi,axis,fl);
+               dc_pt_t * __restrict p{c.pt};
+               const int32_t mid{lo+n/2};
+               if(!sorted)
+                  std::nth_element(p+lo,p+mid,p+hi,[=](const dc_pt_t & a,const dc_pt_t & b) {
+                                       return dc_less(a,b,axis);});
+               dc_free_t fll,flr;
+               int32_t el,er;
+#pragma omp task default(none) shared(c,fll,el) firstprivate(lo,mid,axis) if(n > dc_task_min)
+               el = dc_rec(c,lo,mid,1-axis,false,fll);
+               er = dc_rec(c,mid,hi,1-axis,false,flr);
+#pragma omp taskwait
+               fl = fll;
+               if(fl.head < 0) fl = flr;
+               else if(flr.head >= 0) {
+                  c.onext[fl.tail] = flr.head;
+                  fl.tail          = flr.tail;
+               }
+               // Walk the hulls (counterclockwise, Rprev) for the nodes facing the cut.
+               int32_t e{el}, ldi{el};
+               do {
+                  if(dc_less(p[c.org[ldi]],p[c.org[e]],axis)) ldi = e;
+                  e = dc_rprev(c,e);
+               } while(e != el);
+               ldi = c.oprev[ldi];
+               int32_t rdi{er};
+               e = er;
+               do {
+                  if(dc_less(p[c.org[e]],p[c.org[rdi]],axis)) rdi = e;
+                  e = dc_rprev(c,e);
+               } while(e != er);
+               // Lower common tangent.
+               for(;;) {
+                   if(dc_ccw(c,c.org[rdi],c.org[ldi],dc_dest(c,ldi)))      ldi = dc_lnext(c,ldi);
+                   else if(dc_ccw(c,c.org[ldi],dc_dest(c,rdi),c.org[rdi])) rdi = dc_rprev(c,rdi);
+                   else break;
+               }
+               int32_t basel{dc_connect(c,fl,rdi^1,ldi)};
+               const int32_t first{basel};
+               auto valid = [&c,&basel](const int32_t ed) {
+                    return dc_ccw(c,dc_dest(c,ed),dc_dest(c,basel),c.org[basel]);
+               };
+               // Rising bubble.
+               for(;;) {
+                   int32_t lcand{c.onext[basel^1]};
+                   if(valid(lcand)) {
+                      while(dc_incircle(c,dc_dest(c,basel),c.org[basel],dc_dest(c,lcand),dc_dest(c,c.onext[lcand]))) {
+                            const int32_t t{c.onext[lcand]};
+                            dc_delete_edge(c,fl,lcand);
+                            lcand = t;
+                      }
+                   }
+                   int32_t rcand{c.oprev[basel]};
+                   if(valid(rcand)) {
+                      while(dc_incircle(c,dc_dest(c,basel),c.org[basel],dc_dest(c,rcand),dc_dest(c,c.oprev[rcand]))) {
+                            const int32_t t{c.oprev[rcand]};
+                            dc_delete_edge(c,fl,rcand);
+                            rcand = t;
+                      }
+                   }
+                   const bool lv{valid(lcand)};
+                   const bool rv{valid(rcand)};
+                   if(!lv && !rv) break;
+                   if(!lv || (rv && dc_incircle(c,dc_dest(c,lcand),c.org[lcand],c.org[rcand],dc_dest(c,rcand))))
+                      basel = dc_connect(c,fl,rcand,basel^1);
+                   else
+                      basel = dc_connect(c,fl,basel^1,lcand^1);
+               }
+               return first^1;
+        }
+
+        void pt_sort_rec(dc_pt_t * __restrict p,
+                         const int32_t n) {
+               auto less0 = [](const dc_pt_t & a,const dc_pt_t & b) {return dc_less(a,b,0);};
+               if(n <= sort_task_min) {
+                  std::sort(p,p+n,less0);
+                  return;
+               }
+               const int32_t h{n/2};
+#pragma omp task default(none) firstprivate(p,h)
+               pt_sort_rec(p,h);
+               pt_sort_rec(p+h,n-h);
+#pragma omp taskwait
+               std::inplace_merge(p,p+h,p+n,less0);
+        }
+
+}
+
+
+double
+gms::math::orient2d_robust(const double * __restrict pa,
+                           const double * __restrict pb,
+                           const double * __restrict pc) {
+       const double detleft{(pa[0]-pc[0])*(pb[1]-pc[1])};
+       const double detright{(pa[1]-pc[1])*(pb[0]-pc[0])};
+       const double det{detleft-detright};
+       double detsum;
+       if(detleft > 0.0) {
+          if(detright <= 0.0) return det;
+          detsum = detleft+detright;
+       }
+       else if(detleft < 0.0) {
+          if(detright >= 0.0) return det;
+          detsum = -detleft-detright;
+       }
+       else {
+          return det;
+       }
+       const double errbound{ccwerrboundA*detsum};
+       if(det >= errbound || -det >= errbound) return det;
+       return orient2d_exact(pa,pb,pc);
+}
+
+
+double
+gms::math::incircle_robust(const double * __restrict pa,
+                           const double * __restrict pb,
+                           const double * __restrict pc,
+                           const double * __restrict pd) {
+       const double adx{pa[0]-pd[0]}, ady{pa[1]-pd[1]};
+       const double bdx{pb[0]-pd[0]}, bdy{pb[1]-pd[1]};
+       const double cdx{pc[0]-pd[0]}, cdy{pc[1]-pd[1]};
+       const double bdxcdy{bdx*cdy}, cdxbdy{cdx*bdy};
+       const double cdxady{cdx*ady}, adxcdy{adx*cdy};
+       const double adxbdy{adx*bdy}, bdxady{bdx*ady};
+       const double alift{adx*adx+ady*ady};
+       const double blift{bdx*bdx+bdy*bdy};
+       const double clift{cdx*cdx+cdy*cdy};
+       const double det{alift*(bdxcdy-cdxbdy)+blift*(cdxady-adxcdy)+clift*(adxbdy-bdxady)};
+       const double permanent{(std::fabs(bdxcdy)+std::fabs(cdxbdy))*alift+
+                              (std::fabs(cdxady)+std::fabs(adxcdy))*blift+
+                              (std::fabs(adxbdy)+std::fabs(bdxady))*clift};
+       const double errbound{iccerrboundA*permanent};
+       if(det > errbound || -det > errbound) return det;
+       return incircle_exact(pa,pb,pc,pd);
+}
+
+
+int32_t
+gms::math::r8tris2_dc_omp(const int32_t node_num,
+                          const double * __restrict node_xy,
+                          int32_t * __restrict triangle_num,
+                          int32_t * __restrict triangle_node,
+                          int32_t * __restrict triangle_neighbor) {
+       *triangle_num = 0;
+       if(node_num < 3) return 225;
+       if(node_num > INT32_MAX/6) return 1;
+       const int32_t n{node_num};
+       const int32_t nh{6*n}; // half edges
+       dc_ctx_t c;
+       c.pt    = reinterpret_cast<dc_pt_t*>(_mm_malloc(sizeof(dc_pt_t)*static_cast<std::size_t>(n),64));
+       c.org   = reinterpret_cast<int32_t*>(_mm_malloc(sizeof(int32_t)*static_cast<std::size_t>(nh),64));
+       c.onext = reinterpret_cast<int32_t*>(_mm_malloc(sizeof(int32_t)*static_cast<std::size_t>(nh),64));
+       c.oprev = reinterpret_cast<int32_t*>(_mm_malloc(sizeof(int32_t)*static_cast<std::size_t>(nh),64));
+       int32_t * __restrict tid{reinterpret_cast<int32_t*>(_mm_malloc(sizeof(int32_t)*static_cast<std::size_t>(nh),64))};
+       uint8_t * __restrict rep{reinterpret_cast<uint8_t*>(_mm_malloc(static_cast<std::size_t>(nh),64))};
+       int32_t * __restrict cnt{reinterpret_cast<int32_t*>(_mm_malloc(sizeof(int32_t)*(omp_get_max_threads()+1),64))};
+       auto release = [&]() {
+            if(c.pt)    _mm_free(c.pt);
+            if(c.org)   _mm_free(c.org);
+            if(c.onext) _mm_free(c.onext);
+            if(c.oprev) _mm_free(c.oprev);
+            if(tid)     _mm_free(tid);
+            if(rep)     _mm_free(rep);
+            if(cnt)     _mm_free(cnt);
+       };
+       if(!c.pt || !c.org || !c.onext || !c.oprev || !tid || !rep || !cnt) {
+          release();
+          return 1;
+       }
+       dc_pt_t * __restrict pt{c.pt};
+       int32_t * __restrict org{c.org};
+#pragma omp parallel default(none) shared(pt,org,tid,rep,node_xy,n,nh)
+       {
+#pragma omp for schedule(static) nowait
+           for(int32_t __i = 0; __i < n; ++__i) {
+               pt[__i].x   = node_xy[2*__i];
+               pt[__i].y   = node_xy[2*__i+1];
+               pt[__i].id  = __i;
+               pt[__i].pad = 0;
+           }
+#pragma omp for schedule(static)
+           for(int32_t __i = 0; __i < nh; ++__i) {
+               org[__i] = -1;
+               tid[__i] = -1;
+               rep[__i] = 0;
+           }
+#pragma omp single
+           pt_sort_rec(pt,n);
+       }
+       int32_t ndup{0};
+#pragma omp parallel for schedule(static) default(none) shared(pt,n) reduction(+:ndup)
+       for(int32_t __i = 1; __i < n; ++__i)
+           if(pt[__i].x == pt[__i-1].x && pt[__i].y == pt[__i-1].y) ++ndup;
+       if(ndup != 0) {
+          release();
+          return 224;
+       }
+       int32_t hull{-1};
+#pragma omp parallel default(none) shared(c,n,hull)
+       {
+#pragma omp single
+           {
+               dc_free_t fl;
+               hull = dc_rec(c,0,n,0,true,fl);
+           }
+       }
+       // The outer face lies left of the clockwise hull edges.
+       int32_t e{hull};
+       do {
+          tid[e^1] = -2;
+          e = dc_rprev(c,e);
+       } while(e != hull);
+       // Triangles are numbered in the order of their lowest half edge.
+       int32_t ntri{0};
+#pragma omp parallel default(none) shared(c,org,tid,rep,cnt,pt,nh,ntri,triangle_node,triangle_neighbor)
+       {
+           const int32_t nt{omp_get_num_threads()};
+           const int32_t ti{omp_get_thread_num()};
+           const int32_t b0{static_cast<int32_t>((static_cast<int64_t>(nh)*ti)/nt)};
+           const int32_t b1{static_cast<int32_t>((static_cast<int64_t>(nh)*(ti+1))/nt)};
+           int32_t k{0};
+           for(int32_t __h{b0}; __h != b1; ++__h) {
+               if(org[__h] < 0 || tid[__h] == -2) continue;
+               const int32_t l1{dc_lnext(c,__h)};
+               const int32_t l2{dc_lnext(c,l1)};
+               if(__h < l1 && __h < l2) {rep[__h] = 1; ++k;}
+           }
+           cnt[ti+1] = k;
+#pragma omp barrier
+#pragma omp single
+           {
+               cnt[0] = 0;
+               for(int32_t __t{0}; __t != nt; ++__t) cnt[__t+1] += cnt[__t];
+               ntri = cnt[nt];
+           }
+           int32_t t{cnt[ti]};
+           for(int32_t __h{b0}; __h != b1; ++__h) {
+               if(!rep[__h]) continue;
+               const int32_t l1{dc_lnext(c,__h)};
+               const int32_t l2{dc_lnext(c,l1)};
+               tid[__h] = t;
+               tid[l1]  = t;
+               tid[l2]  = t;
+               triangle_node[3*t]   = pt[org[__h]].id;
+               triangle_node[3*t+1] = pt[org[l1]].id;
+               triangle_node[3*t+2] = pt[org[l2]].id;
+               triangle_neighbor[3*t] = __h;
+               ++t;
+           }
+#pragma omp barrier
+#pragma omp for schedule(static)
+           for(int32_t __t = 0; __t < ntri; ++__t) {
+               int32_t ed{triangle_neighbor[3*__t]};
+               for(int32_t __j{0}; __j != 3; ++__j) {
+                   const int32_t s{ed^1};
+                   if(tid[s] >= 0) {
+                      triangle_neighbor[3*__t+__j] = tid[s]+1;
+                   }
+                   else {
+                      // link to the next counterclockwise boundary edge
+                      const int32_t nx{c.onext[s]};
+                      const int32_t t2{tid[nx]};
+                      const int32_t v{pt[org[nx]].id};
+                      const int32_t j2{(triangle_node[3*t2] == v) ? 0 : ((triangle_node[3*t2+1] == v) ? 1 : 2)};
+                      triangle_neighbor[3*__t+__j] = -(3*(t2+1)+j2);
+                   }
+                   ed = dc_lnext(c,ed);
+               }
+           }
+       }
+       release();
+       *triangle_num = ntri;
+       return (ntri == 0) ? 225 : 0;
+}
@@ -0,0 +1,99 @@
+#ifndef __GMS_DELAUNAY_OMP_H__
+#define __GMS_DELAUNAY_OMP_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_DELAUNAY_OMP_MAJOR = 1U;
+    const unsigned int GMS_DELAUNAY_OMP_MINOR = 0U;
+    const unsigned int GMS_DELAUNAY_OMP_MICRO = 0U;
+    const unsigned int GMS_DELAUNAY_OMP_FULLVER =
+      1000U*GMS_DELAUNAY_OMP_MAJOR+100U*GMS_DELAUNAY_OMP_MINOR+10U*GMS_DELAUNAY_OMP_MICRO;
+    const char * const GMS_DELAUNAY_OMP_CREATION_DATE = "19-10-2026 19:05 PM +00200 (MON 19 OCT 2026 GMT+2)";
+    const char * const GMS_DELAUNAY_OMP_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_DELAUNAY_OMP_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_DELAUNAY_OMP_DESCRIPTION   = "Parallel (OpenMP tasks) divide-and-conquer 2D Delaunay triangulation with robust predicates.";
+
+}
+
+/*
+     Divide-and-conquer Delaunay triangulation (Guibas-Stolfi merge, Dwyer's
+     alternating cuts), the two halves of every subproblem are triangulated by
+     separate OpenMP tasks. The orientation and incircle tests are the adaptive
+     exact predicates of J.R. Shewchuk (static error bound filter, exact
+     expansion arithmetic on failure), so degenerate input (grids, collinear
+     and cocircular points) is triangulated consistently.
+     Compile GMS_delaunay_omp.cpp with -ffp-contract=off (icpc: -fp-model precise -no-fma),
+     the error bounds and the exact arithmetic assume separately rounded operations.
+     Working memory: about 130 bytes per node.
+*/
+
+#include <cstdint>
+#include "GMS_config.h"
+
+namespace gms {
+
+        namespace math {
+
+                  /*
+                        Sign of the orientation of (pa,pb,pc): > 0 counterclockwise,
+                        < 0 clockwise, 0 collinear. Exact sign, the magnitude is approximate.
+                  */
+                  double orient2d_robust(const double * __restrict pa,
+                                         const double * __restrict pb,
+                                         const double * __restrict pc);
+
+                  /*
+                        > 0 if pd lies inside the circle through pa, pb, pc (counterclockwise),
+                        < 0 outside, 0 cocircular. Exact sign.
+                  */
+                  double incircle_robust(const double * __restrict pa,
+                                         const double * __restrict pb,
+                                         const double * __restrict pc,
+                                         const double * __restrict pd);
+
+                  /*
+                        Parallel replacement of r8tris2 (GMS_triangulation, GMS_geompack),
+                        same arguments and output layout:
+                        node_xy[2*node_num]  -- coordinates (not modified, r8tris2 sorts them
+                                                in place and restores them on exit).
+                        *triangle_num        -- 2*node_num-nb-2, nb = number of boundary nodes.
+                        triangle_node[3*triangle_num] -- 0-based node indices, counterclockwise.
+                        triangle_neighbor[3*triangle_num] -- 1-based index of the triangle
+                                                across the edge from vertex j to j+1, or the
+                                                link -(3*I+J-1) to the next counterclockwise
+                                                boundary edge J (1-based) of the triangle I.
+                        Size both arrays for 3*(2*node_num) entries, as for r8tris2.
+                        Returns 0 -- no error, 1 -- allocation failure, 224 -- coincident nodes
+                        (remove them first, e.g. node_merge), 225 -- all nodes collinear.
+                        The result does not depend on the number of threads.
+                  */
+                  int32_t r8tris2_dc_omp(const int32_t node_num,
+                                         const double * __restrict node_xy,
+                                         int32_t * __restrict triangle_num,
+                                         int32_t * __restrict triangle_node,
+                                         int32_t * __restrict triangle_neighbor);
+
+        } // math
+
+} // gms
+
+#endif /*__GMS_DELAUNAY_OMP_H__*/
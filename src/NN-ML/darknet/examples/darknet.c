@@ -0,0 +1,92 @@
+#include "darknet.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/*
+ * Command line front end. Of the upstream subcommands only the ones whose
+ * sources are bundled in this tree are wired in.
+ */
+
+void speed(char *cfgfile, int tics)
+{
+    if (tics == 0) tics = 1000;
+    network *net = load_network_fused(cfgfile, 0, 0);
+    network_images_per_second(net, tics);
+    free_network(net);
+}
+
+/*
+ * Post-training quantization of a classifier: calibrates on a random subset
+ * of the valid list of the data cfg, reports accuracy and speed against the
+ * fp32 network over the whole list and saves the quantized weights.
+ */
+void quantize(char *datacfg, char *cfgfile, char *weightfile, char *type, char *outfile, int calib_n)
+{
+    list *options = read_data_cfg(datacfg);
+    char *label_list = option_find_str(options, "labels", "data/labels.list");
+    char *valid_list = option_find_str(options, "valid", "data/train.list");
+    int classes = option_find_int(options, "classes", 2);
+    char **labels = get_labels(label_list);
+    list *plist = get_paths(valid_list);
+    char **paths = (char **)list_to_array(plist);
+    int m = plist->size;
+    QUANT_TYPE qt = (0 == strcmp(type, "bf16")) ? QUANT_BF16 : QUANT_INT8;
+
+    network *ref = load_network(cfgfile, weightfile, 0);
+    network *net = load_network(cfgfile, weightfile, 0);
+    set_batch_network(ref, 1);
+    set_batch_network(net, 1);
+    srand(time(0));
+
+    if (calib_n > m) calib_n = m;
+    data calib = load_data_old(paths, calib_n, m, labels, classes, net->w, net->h);
+    quantize_network(net, qt, calib);
+    free_data(calib);
+
+    data valid = load_data_old(paths, m, 0, labels, classes, net->w, net->h);
+    quantization_report(ref, net, valid);
+    free_data(valid);
+
+    if (outfile) save_weights(net, outfile);
+    free_network(ref);
+    free_network(net);
+    free(paths);
+    free_list(plist);
+}
+
+int main(int argc, char **argv)
+{
+    if(argc < 2){
+        fprintf(stderr, "usage: %s <function>\n", argv[0]);
+        return 0;
+    }
+    gpu_index = find_int_arg(argc, argv, "-i", 0);
+    if(find_arg(argc, argv, "-nogpu")) {
+        gpu_index = -1;
+    }
+
+#ifndef GPU
+    gpu_index = -1;
+#else
+    if(gpu_index >= 0){
+        cuda_set_device(gpu_index);
+    }
+#endif
+
+    if (0 == strcmp(argv[1], "speed")){
+        speed(argv[2], (argc > 3 && argv[3]) ? atoi(argv[3]) : 0);
+    } else if (0 == strcmp(argv[1], "quantize")){
+        if(argc < 6){
+            fprintf(stderr, "usage: %s quantize <int8|bf16> [data] [cfg] [weights] [-out quant.weights] [-calib 256]\n", argv[0]);
+            return 0;
+        }
+        char *out = find_char_arg(argc, argv, "-out", 0);
+        int calib = find_int_arg(argc, argv, "-calib", 256);
+        quantize(argv[3], argv[4], argv[5], argv[2], out, calib);
+    } else {
+        fprintf(stderr, "Not an option: %s\n", argv[1]);
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <pthread.h>
 
 #ifdef GPU
@@ -57,6 +58,10 @@ typedef enum{
     MULT, ADD, SUB, DIV
 } BINARY_ACTIVATION;
 
+typedef enum{
+    QUANT_NONE, QUANT_INT8, QUANT_BF16
+} QUANT_TYPE;
+
 typedef enum {
     CONVOLUTIONAL,
     DECONVOLUTIONAL,
@@ -238,6 +243,14 @@ struct layer{
     float * __restrict__ weights;
     float * __restrict__ weight_updates;
 
+    QUANT_TYPE quantized;
+    int8_t   * __restrict__ weights_int8;
+    uint16_t * __restrict__ weights_bf16;
+    float    * __restrict__ weight_scales;
+    int      * __restrict__ weight_sums;
+    float input_scale;
+    float input_max;
+
     float * __restrict__ delta;
     float * __restrict__ output;
     float * __restrict__ loss;
@@ -585,6 +598,12 @@ typedef struct{
 
 
 network *load_network(char *cfg, char *weights, int clear);
+network *load_network_fused(char *cfg, char *weights, int clear);
+void fuse_network_batchnorm(network *net);
+double network_images_per_second(network *net, int iterations);
+void calibrate_network(network *net, data d);
+void quantize_network(network *net, QUANT_TYPE type, data calib);
+void quantization_report(network *fp32, network *quant, data d);
 load_args get_base_args(network *net);
 
 void free_data(data d);
@@ -5,6 +5,7 @@
 #include "col2im.h"
 #include "blas.h"
 #include "gemm.h"
+#include "direct_conv.h"
 #include <stdio.h>
 #include <time.h>
 
@@ -442,10 +443,71 @@ void backward_bias(float *bias_updates, float *delta, int batch, int n, int size
     }
 }
 
+/*
+ * Inference-only path for layers whose batchnorm has been folded into the
+ * weights (see fuse_conv_batchnorm): 3x3 convolutions over few channels run
+ * im2col-free, 1x1/stride-1 convolutions feed the input straight into the
+ * gemm, and bias + activation are applied inside the gemm epilogue.
+ */
+static void forward_convolutional_layer_fused(convolutional_layer l, network net)
+{
+    int i, j;
+    int m = l.n/l.groups;
+    int k = l.size*l.size*l.c/l.groups;
+    int n = l.out_w*l.out_h;
+    int cg = l.c/l.groups;
+    for(i = 0; i < l.batch; ++i){
+        for(j = 0; j < l.groups; ++j){
+            float *a = l.weights + j*l.nweights/l.groups;
+            float *b = net.workspace;
+            float *c = l.output + (i*l.groups + j)*n*m;
+            float *im =  net.input + (i*l.groups + j)*cg*l.h*l.w;
+            float *bias = l.biases + j*m;
+
+            if(l.size == 3 && cg <= DIRECT_CONV3X3_MAX_C){
+                conv3x3_direct_cpu(im, cg, l.h, l.w, l.stride, l.pad, a, m, bias, l.activation, c);
+                continue;
+            }
+            if(l.size == 1 && l.stride == 1 && l.pad == 0){
+                b = im;
+            } else {
+                im2col_cpu(im, cg, l.h, l.w, l.size, l.stride, l.pad, b);
+            }
+            gemm_cpu_fused(0,0,m,n,k,1,a,k,b,n,0,c,n,bias,l.activation);
+        }
+    }
+}
+
+void fuse_conv_batchnorm(convolutional_layer *l)
+{
+    int f, i;
+    int size = l->nweights/l->n;
+    if(!l->batch_normalize) return;
+    for(f = 0; f < l->n; ++f){
+        float s = l->scales[f]/(sqrt(l->rolling_variance[f]) + .000001f);
+        for(i = 0; i < size; ++i){
+            l->weights[f*size + i] *= s;
+        }
+        l->biases[f] -= l->rolling_mean[f]*s;
+        l->scales[f] = 1;
+        l->rolling_mean[f] = 0;
+        l->rolling_variance[f] = 1;
+    }
+    l->batch_normalize = 0;
+#ifdef GPU
+    if(gpu_index >= 0) push_convolutional_layer(*l);
+#endif
+}
+
 void forward_convolutional_layer(convolutional_layer l, network net)
 {
     int i, j;
 
+    if(!net.train && !l.batch_normalize && !l.xnor && !l.binary){
+        forward_convolutional_layer_fused(l, net);
+        return;
+    }
+
     fill_cpu(l.outputs*l.batch, 0, l.output, 1);
 
     if(l.xnor){
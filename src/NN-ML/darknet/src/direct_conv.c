@@ -0,0 +1,89 @@
+#include "direct_conv.h"
+#include <string.h>
+
+/*
+ * im2col-free 3x3 convolution for inference.
+ *
+ * Each output row is accumulated as a sequence of row saxpys over the
+ * input rows its taps touch, so the rows being built stay in L1 for the
+ * whole channel loop; the valid output column range of every tap is
+ * computed up front so the three taps of a kernel row are applied in a
+ * single bounds-free pass over the interior, which vectorizes. Filters are processed four at a time so each input row is
+ * reused for four output rows. Bias and activation are applied
+ * to each plane right after its last tap.
+ */
+
+#define CONV3X3_OC_BLOCK 4
+
+static void tap_range(int k, int stride, int pad, int in, int out,
+        int *lo, int *hi)
+{
+    /* output index o is valid when 0 <= o*stride + k - pad < in */
+    int l = pad - k;
+    int h = in - 1 + pad - k;
+    *lo = (l <= 0) ? 0 : (l + stride - 1)/stride;
+    *hi = (h < 0) ? -1 : h/stride;
+    if(*hi > out - 1) *hi = out - 1;
+}
+
+void conv3x3_direct_cpu(float *im, int channels, int height, int width,
+        int stride, int pad, float *weights, int filters,
+        float *bias, ACTIVATION a, float *out)
+{
+    const int out_h = (height + 2*pad - 3)/stride + 1;
+    const int out_w = (width + 2*pad - 3)/stride + 1;
+    const int plane = out_h*out_w;
+    int xlo[3], xhi[3], xr[3], ylo[3], yhi[3];
+    int f0, t;
+    int xa = 0, xb = out_w - 1;
+    for(t = 0; t < 3; ++t){
+        tap_range(t, stride, pad, width,  out_w, &xlo[t], &xhi[t]);
+        tap_range(t, stride, pad, height, out_h, &ylo[t], &yhi[t]);
+        if(xlo[t] > xa) xa = xlo[t];
+        if(xhi[t] < xb) xb = xhi[t];
+    }
+    /* right edge columns of each tap; on narrow outputs xa > xb + 1 and the
+       left edge loop has already covered the columns below xa */
+    for(t = 0; t < 3; ++t){
+        xr[t] = xb + 1;
+        if(xr[t] < xa) xr[t] = xa;
+        if(xr[t] < xlo[t]) xr[t] = xlo[t];
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(f0 = 0; f0 < filters; f0 += CONV3X3_OC_BLOCK){
+        int nf = (filters - f0 < CONV3X3_OC_BLOCK) ? filters - f0 : CONV3X3_OC_BLOCK;
+        int f, c, ky, kx, y, x;
+        memset(out + f0*plane, 0, nf*plane*sizeof(float));
+        for(y = 0; y < out_h; ++y){
+            for(c = 0; c < channels; ++c){
+                float *src = im + c*height*width;
+                for(ky = 0; ky < 3; ++ky){
+                    if(y < ylo[ky] || y > yhi[ky]) continue;
+                    const float *row = src + (y*stride + ky - pad)*width;
+                    for(f = 0; f < nf; ++f){
+                        const float *w = weights + ((f0 + f)*channels + c)*9 + ky*3;
+                        float *restrict dst = out + (f0 + f)*plane + y*out_w;
+                        const float *restrict in = row - pad;
+                        const float w0 = w[0], w1 = w[1], w2 = w[2];
+                        for(kx = 0; kx < 3; ++kx){
+                            for(x = xlo[kx]; x < xa && x <= xhi[kx]; ++x) dst[x] += w[kx]*in[x*stride + kx];
+                            for(x = xr[kx]; x <= xhi[kx]; ++x) dst[x] += w[kx]*in[x*stride + kx];
+                        }
+                        if(stride == 1){
+                            for(x = xa; x <= xb; ++x) dst[x] += w0*in[x] + w1*in[x + 1] + w2*in[x + 2];
+                        } else {
+                            for(x = xa; x <= xb; ++x) dst[x] += w0*in[x*stride] + w1*in[x*stride + 1] + w2*in[x*stride + 2];
+                        }
+                    }
+                }
+            }
+        }
+        for(f = 0; f < nf; ++f){
+            float *dst = out + (f0 + f)*plane;
+            float b = bias ? bias[f0 + f] : 0;
+            for(x = 0; x < plane; ++x) dst[x] += b;
+            activate_array(dst, plane, a);
+        }
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef DIRECT_CONV_H
+#define DIRECT_CONV_H
+#include "activations.h"
+
+/* Input channels above which im2col + the packed gemm is faster (first layers only). */
+#ifndef DIRECT_CONV3X3_MAX_C
+#define DIRECT_CONV3X3_MAX_C 4
+#endif
+
+void conv3x3_direct_cpu(float *im, int channels, int height, int width,
+        int stride, int pad, float *weights, int filters,
+        float *bias, ACTIVATION a, float *out);
+
+#endif
@@ -3,7 +3,12 @@
 #include "cuda.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
+#include <pthread.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 void gemm_bin(int M, int N, int K, float ALPHA, 
         char  *A, int lda, 
@@ -142,6 +147,336 @@ void gemm_tt(int M, int N, int K, float ALPHA,
 }
 
 
+/*
+ * Packed, register-blocked SGEMM for the CPU inference path.
+ *
+ * C += ALPHA*op(A)*op(B) is computed with the usual three-level blocking:
+ * a KC x NC panel of op(B) is packed into NR-wide column slivers, each
+ * MC x KC block of op(A) is packed into MR-tall row slivers (ALPHA folded
+ * in), and an MR x NR micro-kernel keeps the whole C tile in registers
+ * across the KC loop. Packing handles all four transpose combinations, so
+ * gemm_nn/nt/tn/tt share a single kernel. The micro-kernel is chosen once
+ * at run time: AVX-512 (12x32), AVX2+FMA (6x16) or a portable 4x8 one.
+ */
+
+#define GEMM_MC 144
+#define GEMM_KC 256
+#define GEMM_NC 4096
+#define GEMM_NB 256
+#define GEMM_MAX_MR 12
+#define GEMM_MAX_NR 32
+
+/* Below this many multiply-adds the plain loops above are faster. */
+#define GEMM_PACKED_MIN_WORK (32*32*32)
+
+typedef void (*gemm_micro_kernel)(int kc, const float *a, const float *b,
+        float *c, int ldc);
+
+typedef struct{
+    int mr;
+    int nr;
+    gemm_micro_kernel kernel;
+    const char *name;
+} gemm_kernel_info;
+
+static void gemm_micro_4x8_generic(int kc, const float *a, const float *b,
+        float *c, int ldc)
+{
+    float acc[4][8] = {{0}};
+    int k, i, j;
+    for(k = 0; k < kc; ++k){
+        for(i = 0; i < 4; ++i){
+            float ai = a[k*4 + i];
+            for(j = 0; j < 8; ++j){
+                acc[i][j] += ai*b[k*8 + j];
+            }
+        }
+    }
+    for(i = 0; i < 4; ++i){
+        for(j = 0; j < 8; ++j){
+            c[i*ldc + j] += acc[i][j];
+        }
+    }
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+
+__attribute__((target("avx2,fma")))
+static void gemm_micro_6x16_avx2(int kc, const float *a, const float *b,
+        float *c, int ldc)
+{
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+    int k;
+    for(k = 0; k < kc; ++k){
+        __m256 b0 = _mm256_load_ps(b);
+        __m256 b1 = _mm256_load_ps(b + 8);
+        __m256 ai;
+        ai = _mm256_broadcast_ss(a + 0); c00 = _mm256_fmadd_ps(ai, b0, c00); c01 = _mm256_fmadd_ps(ai, b1, c01);
+        ai = _mm256_broadcast_ss(a + 1); c10 = _mm256_fmadd_ps(ai, b0, c10); c11 = _mm256_fmadd_ps(ai, b1, c11);
+        ai = _mm256_broadcast_ss(a + 2); c20 = _mm256_fmadd_ps(ai, b0, c20); c21 = _mm256_fmadd_ps(ai, b1, c21);
+        ai = _mm256_broadcast_ss(a + 3); c30 = _mm256_fmadd_ps(ai, b0, c30); c31 = _mm256_fmadd_ps(ai, b1, c31);
+        ai = _mm256_broadcast_ss(a + 4); c40 = _mm256_fmadd_ps(ai, b0, c40); c41 = _mm256_fmadd_ps(ai, b1, c41);
+        ai = _mm256_broadcast_ss(a + 5); c50 = _mm256_fmadd_ps(ai, b0, c50); c51 = _mm256_fmadd_ps(ai, b1, c51);
+        a += 6;
+        b += 16;
+    }
+#define GEMM_AVX2_ROW(r, v0, v1) \
+    _mm256_storeu_ps(c + (r)*ldc,     _mm256_add_ps(_mm256_loadu_ps(c + (r)*ldc),     v0)); \
+    _mm256_storeu_ps(c + (r)*ldc + 8, _mm256_add_ps(_mm256_loadu_ps(c + (r)*ldc + 8), v1));
+    GEMM_AVX2_ROW(0, c00, c01)
+    GEMM_AVX2_ROW(1, c10, c11)
+    GEMM_AVX2_ROW(2, c20, c21)
+    GEMM_AVX2_ROW(3, c30, c31)
+    GEMM_AVX2_ROW(4, c40, c41)
+    GEMM_AVX2_ROW(5, c50, c51)
+#undef GEMM_AVX2_ROW
+}
+
+__attribute__((target("avx512f")))
+static void gemm_micro_12x32_avx512(int kc, const float *a, const float *b,
+        float *c, int ldc)
+{
+    __m512 acc[12][2];
+    int i, k;
+    #pragma GCC unroll 12
+    for(i = 0; i < 12; ++i){
+        acc[i][0] = _mm512_setzero_ps();
+        acc[i][1] = _mm512_setzero_ps();
+    }
+    for(k = 0; k < kc; ++k){
+        __m512 b0 = _mm512_load_ps(b);
+        __m512 b1 = _mm512_load_ps(b + 16);
+        #pragma GCC unroll 12
+        for(i = 0; i < 12; ++i){
+            __m512 ai = _mm512_set1_ps(a[i]);
+            acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += 12;
+        b += 32;
+    }
+    #pragma GCC unroll 12
+    for(i = 0; i < 12; ++i){
+        _mm512_storeu_ps(c + i*ldc,      _mm512_add_ps(_mm512_loadu_ps(c + i*ldc),      acc[i][0]));
+        _mm512_storeu_ps(c + i*ldc + 16, _mm512_add_ps(_mm512_loadu_ps(c + i*ldc + 16), acc[i][1]));
+    }
+}
+#endif
+
+static gemm_kernel_info gemm_kernel;
+static pthread_once_t gemm_kernel_once = PTHREAD_ONCE_INIT;
+
+static void gemm_select_kernel()
+{
+    gemm_kernel_info k = {4, 8, gemm_micro_4x8_generic, "generic 4x8"};
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){
+        k.mr = 12; k.nr = 32; k.kernel = gemm_micro_12x32_avx512; k.name = "avx512 12x32";
+    } else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        k.mr = 6; k.nr = 16; k.kernel = gemm_micro_6x16_avx2; k.name = "avx2 6x16";
+    }
+#endif
+    gemm_kernel = k;
+}
+
+static gemm_kernel_info get_gemm_kernel()
+{
+    pthread_once(&gemm_kernel_once, gemm_select_kernel);
+    return gemm_kernel;
+}
+
+const char *gemm_cpu_kernel_name()
+{
+    return get_gemm_kernel().name;
+}
+
+static void pack_a_panel(int TA, int mc, int kc, float ALPHA,
+        float *A, int lda, int mr, float *buf)
+{
+    int i, k, r;
+    for(i = 0; i < mc; i += mr){
+        int rows = (mc - i < mr) ? mc - i : mr;
+        for(k = 0; k < kc; ++k){
+            for(r = 0; r < rows; ++r){
+                float v = TA ? A[k*lda + i + r] : A[(i + r)*lda + k];
+                buf[k*mr + r] = ALPHA*v;
+            }
+            for(; r < mr; ++r) buf[k*mr + r] = 0;
+        }
+        buf += kc*mr;
+    }
+}
+
+static void pack_b_panel(int TB, int kc, int nc, float *B, int ldb,
+        int nr, float *buf)
+{
+    int j, k, c;
+    for(j = 0; j < nc; j += nr){
+        int cols = (nc - j < nr) ? nc - j : nr;
+        float *dst = buf + (j/nr)*kc*nr;
+        for(k = 0; k < kc; ++k){
+            if(!TB){
+                memcpy(dst + k*nr, B + k*ldb + j, cols*sizeof(float));
+            } else {
+                for(c = 0; c < cols; ++c) dst[k*nr + c] = B[(j + c)*ldb + k];
+            }
+            for(c = cols; c < nr; ++c) dst[k*nr + c] = 0;
+        }
+    }
+}
+
+static void gemm_epilogue(float *C, int ldc, int rows, int cols,
+        float *bias, ACTIVATION a)
+{
+    int i, j;
+    for(i = 0; i < rows; ++i){
+        float *row = C + i*ldc;
+        float b = bias ? bias[i] : 0;
+        switch(a){
+            case LINEAR:
+                for(j = 0; j < cols; ++j) row[j] += b;
+                break;
+            case RELU:
+                for(j = 0; j < cols; ++j){
+                    float v = row[j] + b;
+                    row[j] = v > 0 ? v : 0;
+                }
+                break;
+            case LEAKY:
+                for(j = 0; j < cols; ++j){
+                    float v = row[j] + b;
+                    row[j] = v > 0 ? v : .1f*v;
+                }
+                break;
+            default:
+                for(j = 0; j < cols; ++j) row[j] += b;
+                activate_array(row, cols, a);
+        }
+    }
+}
+
+/*
+ * C += ALPHA*op(A)*op(B), then optionally C = a(C + bias[row]) applied to
+ * each tile right after its last K block, while it is still in cache.
+ */
+static void gemm_packed(int TA, int TB, int M, int N, int K, float ALPHA,
+        float *A, int lda,
+        float *B, int ldb,
+        float *C, int ldc,
+        float *bias, ACTIVATION act, int epilogue)
+{
+    gemm_kernel_info kern = get_gemm_kernel();
+    const int mr = kern.mr;
+    const int nr = kern.nr;
+    const int mblocks = (M + GEMM_MC - 1)/GEMM_MC;
+    int nthreads = 1;
+    int jc, pc;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    float *bpack = 0;
+    float *apack = 0;
+    size_t bsize = (size_t)GEMM_KC*(((GEMM_NC + nr - 1)/nr)*nr);
+    size_t asize = (size_t)GEMM_KC*(((GEMM_MC + mr - 1)/mr)*mr);
+    if(posix_memalign((void **)&bpack, 64, bsize*sizeof(float))) error("gemm: cannot allocate B panel");
+    if(posix_memalign((void **)&apack, 64, nthreads*asize*sizeof(float))) error("gemm: cannot allocate A panels");
+
+    for(jc = 0; jc < N; jc += GEMM_NC){
+        int nc = (N - jc < GEMM_NC) ? N - jc : GEMM_NC;
+        int nblocks = (nc + GEMM_NB - 1)/GEMM_NB;
+        for(pc = 0; pc < K; pc += GEMM_KC){
+            int kc = (K - pc < GEMM_KC) ? K - pc : GEMM_KC;
+            int last = (pc + kc == K);
+            float *bsrc = TB ? B + jc*ldb + pc : B + pc*ldb + jc;
+            int t;
+            #pragma omp parallel for schedule(static)
+            for(t = 0; t < nc; t += GEMM_NB){
+                int w = (nc - t < GEMM_NB) ? nc - t : GEMM_NB;
+                float *src = TB ? bsrc + t*ldb : bsrc + t;
+                pack_b_panel(TB, kc, w, src, ldb, nr, bpack + (t/nr)*kc*nr);
+            }
+
+            #pragma omp parallel for schedule(dynamic)
+            for(t = 0; t < mblocks*nblocks; ++t){
+                int tid = 0;
+#ifdef _OPENMP
+                tid = omp_get_thread_num();
+#endif
+                float *abuf = apack + tid*asize;
+                int ic = (t/nblocks)*GEMM_MC;
+                int jb = (t%nblocks)*GEMM_NB;
+                int mc = (M - ic < GEMM_MC) ? M - ic : GEMM_MC;
+                int nb = (nc - jb < GEMM_NB) ? nc - jb : GEMM_NB;
+                float *asrc = TA ? A + pc*lda + ic : A + ic*lda + pc;
+                int ir, jr;
+                pack_a_panel(TA, mc, kc, ALPHA, asrc, lda, mr, abuf);
+                for(jr = 0; jr < nb; jr += nr){
+                    int cols = (nb - jr < nr) ? nb - jr : nr;
+                    const float *bp = bpack + ((jb + jr)/nr)*kc*nr;
+                    for(ir = 0; ir < mc; ir += mr){
+                        int rows = (mc - ir < mr) ? mc - ir : mr;
+                        const float *ap = abuf + (ir/mr)*kc*mr;
+                        float *cp = C + (ic + ir)*ldc + jc + jb + jr;
+                        if(rows == mr && cols == nr){
+                            kern.kernel(kc, ap, bp, cp, ldc);
+                        } else {
+                            float tmp[GEMM_MAX_MR*GEMM_MAX_NR] __attribute__((aligned(64)));
+                            int i, j;
+                            memset(tmp, 0, sizeof(tmp));
+                            kern.kernel(kc, ap, bp, tmp, nr);
+                            for(i = 0; i < rows; ++i){
+                                for(j = 0; j < cols; ++j){
+                                    cp[i*ldc + j] += tmp[i*nr + j];
+                                }
+                            }
+                        }
+                    }
+                }
+                if(last && epilogue){
+                    gemm_epilogue(C + ic*ldc + jc + jb, ldc, mc, nb,
+                            bias ? bias + ic : 0, act);
+                }
+            }
+        }
+    }
+    free(apack);
+    free(bpack);
+}
+
+void gemm_cpu_fused(int TA, int TB, int M, int N, int K, float ALPHA, 
+        float *A, int lda, 
+        float *B, int ldb,
+        float BETA,
+        float *C, int ldc,
+        float *bias, ACTIVATION a)
+{
+    int i, j;
+    if(BETA == 0){
+        for(i = 0; i < M; ++i){
+            memset(C + i*ldc, 0, N*sizeof(float));
+        }
+    } else if(BETA != 1){
+        for(i = 0; i < M; ++i){
+            for(j = 0; j < N; ++j){
+                C[i*ldc + j] *= BETA;
+            }
+        }
+    }
+    if(K == 0){
+        gemm_epilogue(C, ldc, M, N, bias, a);
+        return;
+    }
+    gemm_packed(TA, TB, M, N, K, ALPHA, A, lda, B, ldb, C, ldc, bias, a, 1);
+}
+
+
 void gemm_cpu(int TA, int TB, int M, int N, int K, float ALPHA, 
         float *A, int lda, 
         float *B, int ldb,
@@ -155,6 +490,10 @@ void gemm_cpu(int TA, int TB, int M, int N, int K, float ALPHA,
             C[i*ldc + j] *= BETA;
         }
     }
+    if((double)M*N*K >= GEMM_PACKED_MIN_WORK){
+        gemm_packed(TA, TB, M, N, K, ALPHA, A, lda, B, ldb, C, ldc, 0, LINEAR, 0);
+        return;
+    }
     if(!TA && !TB)
         gemm_nn(M, N, K, ALPHA,A,lda, B, ldb,C,ldc);
     else if(TA && !TB)
@@ -6,6 +6,7 @@
 #include "data.h"
 #include "utils.h"
 #include "blas.h"
+#include "gemm.h"
 
 #include "crop_layer.h"
 #include "connected_layer.h"
@@ -60,6 +61,24 @@ network *load_network(char *cfg, char *weights, int clear)
     return net;
 }
 
+void fuse_network_batchnorm(network *net)
+{
+    int i;
+    for(i = 0; i < net->n; ++i){
+        layer *l = &net->layers[i];
+        if(l->type == CONVOLUTIONAL) fuse_conv_batchnorm(l);
+    }
+}
+
+/* Loads a network for CPU inference with conv+batchnorm folded into the weights. */
+network *load_network_fused(char *cfg, char *weights, int clear)
+{
+    network *net = load_network(cfg, weights, clear);
+    set_batch_network(net, 1);
+    fuse_network_batchnorm(net);
+    return net;
+}
+
 size_t get_current_batch(network *net)
 {
     size_t batch_num = (*net->seen)/(net->batch*net->subdivisions);
@@ -507,6 +526,26 @@ float *network_predict(network *net, float *input)
     return out;
 }
 
+/* Times network_predict on a random image and returns images per second. */
+double network_images_per_second(network *net, int iterations)
+{
+    int i;
+    int inputs = net->inputs*net->batch;
+    float *X = calloc(inputs, sizeof(float));
+    for(i = 0; i < inputs; ++i) X[i] = rand_uniform(0, 1);
+    network_predict(net, X);
+    double start = what_time_is_it_now();
+    for(i = 0; i < iterations; ++i){
+        network_predict(net, X);
+    }
+    double elapsed = what_time_is_it_now() - start;
+    free(X);
+    double ips = (elapsed > 0) ? iterations*net->batch/elapsed : 0;
+    fprintf(stderr, "%d images in %f seconds: %f images/s (gemm kernel: %s)\n",
+            iterations*net->batch, elapsed, ips, gemm_cpu_kernel_name());
+    return ips;
+}
+
 int num_detections(network *net, float thresh)
 {
     int i;
@@ -35,6 +35,7 @@
 #include "shortcut_layer.h"
 #include "softmax_layer.h"
 #include "lstm_layer.h"
+#include "quantize.h"
 #include "utils.h"
 
 typedef struct{
@@ -968,12 +969,19 @@ void save_convolutional_weights(layer l, FILE *fp)
 #endif
     int num = l.nweights;
     fwrite(l.biases, sizeof(float), l.n, fp);
+    if (l.quantized){
+        fwrite(&l.batch_normalize, sizeof(int), 1, fp);
+    }
     if (l.batch_normalize){
         fwrite(l.scales, sizeof(float), l.n, fp);
         fwrite(l.rolling_mean, sizeof(float), l.n, fp);
         fwrite(l.rolling_variance, sizeof(float), l.n, fp);
     }
-    fwrite(l.weights, sizeof(float), num, fp);
+    if (l.quantized){
+        save_quantized_weights(l, fp);
+    } else {
+        fwrite(l.weights, sizeof(float), num, fp);
+    }
 }
 
 void save_batchnorm_weights(layer l, FILE *fp)
@@ -996,7 +1004,11 @@ void save_connected_weights(layer l, FILE *fp)
     }
 #endif
     fwrite(l.biases, sizeof(float), l.outputs, fp);
-    fwrite(l.weights, sizeof(float), l.outputs*l.inputs, fp);
+    if (l.quantized){
+        save_quantized_weights(l, fp);
+    } else {
+        fwrite(l.weights, sizeof(float), l.outputs*l.inputs, fp);
+    }
     if (l.batch_normalize){
         fwrite(l.scales, sizeof(float), l.outputs, fp);
         fwrite(l.rolling_mean, sizeof(float), l.outputs, fp);
@@ -1018,10 +1030,21 @@ void save_weights_upto(network *net, char *filename, int cutoff)
     int major = 0;
     int minor = 2;
     int revision = 0;
+    int quant = QUANT_NONE;
+    int j;
+    for(j = 0; j < net->n && j < cutoff; ++j){
+        if(net->layers[j].quantized) quant = net->layers[j].quantized;
+    }
+    if(quant) minor = QUANT_WEIGHTS_MINOR;
     fwrite(&major, sizeof(int), 1, fp);
     fwrite(&minor, sizeof(int), 1, fp);
     fwrite(&revision, sizeof(int), 1, fp);
     fwrite(net->seen, sizeof(size_t), 1, fp);
+    if(quant){
+        uint32_t magic = QUANT_WEIGHTS_MAGIC;
+        fwrite(&magic, sizeof(uint32_t), 1, fp);
+        fwrite(&quant, sizeof(int), 1, fp);
+    }
 
     int i;
     for(i = 0; i < net->n && i < cutoff; ++i){
@@ -1161,6 +1184,43 @@ void load_convolutional_weights_binary(layer l, FILE *fp)
 #endif
 }
 
+void load_connected_weights_quantized(layer *l, FILE *fp, QUANT_TYPE type)
+{
+    fread(l->biases, sizeof(float), l->outputs, fp);
+    load_quantized_weights(l, fp, type);
+    if (l->batch_normalize && (!l->dontloadscales)){
+        fread(l->scales, sizeof(float), l->outputs, fp);
+        fread(l->rolling_mean, sizeof(float), l->outputs, fp);
+        fread(l->rolling_variance, sizeof(float), l->outputs, fp);
+    }
+#ifdef GPU
+    if(gpu_index >= 0){
+        push_connected_layer(*l);
+    }
+#endif
+}
+
+void load_convolutional_weights_quantized(layer *l, FILE *fp, QUANT_TYPE type)
+{
+    int batch_normalize = 0;
+    fread(l->biases, sizeof(float), l->n, fp);
+    fread(&batch_normalize, sizeof(int), 1, fp);
+    if (batch_normalize && !l->batch_normalize) error("quantized weights carry batchnorm the cfg does not declare");
+    /* batchnorm was folded into the weights before quantization */
+    if (!batch_normalize) l->batch_normalize = 0;
+    if (l->batch_normalize){
+        fread(l->scales, sizeof(float), l->n, fp);
+        fread(l->rolling_mean, sizeof(float), l->n, fp);
+        fread(l->rolling_variance, sizeof(float), l->n, fp);
+    }
+    load_quantized_weights(l, fp, type);
+#ifdef GPU
+    if(gpu_index >= 0){
+        push_convolutional_layer(*l);
+    }
+#endif
+}
+
 void load_convolutional_weights(layer l, FILE *fp)
 {
     if(l.binary){
@@ -1241,15 +1301,30 @@ void load_weights_upto(network *net, char *filename, int start, int cutoff)
         *net->seen = iseen;
     }
     int transpose = (major > 1000) || (minor > 1000);
+    QUANT_TYPE quant = QUANT_NONE;
+    if (major == 0 && minor == QUANT_WEIGHTS_MINOR){
+        uint32_t magic = 0;
+        int type = QUANT_NONE;
+        fread(&magic, sizeof(uint32_t), 1, fp);
+        fread(&type, sizeof(int), 1, fp);
+        if (magic != QUANT_WEIGHTS_MAGIC || (type != QUANT_INT8 && type != QUANT_BF16)){
+            error("bad quantized weights header");
+        }
+        quant = type;
+    }
 
     int i;
     for(i = start; i < net->n && i < cutoff; ++i){
         layer l = net->layers[i];
         if (l.dontload) continue;
-        if(l.type == CONVOLUTIONAL || l.type == DECONVOLUTIONAL){
+        if(quant && l.type == CONVOLUTIONAL && !l.binary && !l.xnor){
+            load_convolutional_weights_quantized(&net->layers[i], fp, quant);
+        } else if(l.type == CONVOLUTIONAL || l.type == DECONVOLUTIONAL){
             load_convolutional_weights(l, fp);
         }
-        if(l.type == CONNECTED){
+        if(quant && l.type == CONNECTED){
+            load_connected_weights_quantized(&net->layers[i], fp, quant);
+        } else if(l.type == CONNECTED){
             load_connected_weights(l, fp, transpose);
         }
         if(l.type == BATCHNORM){
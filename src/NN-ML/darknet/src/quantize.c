@@ -0,0 +1,711 @@
+#include "quantize.h"
+#include "convolutional_layer.h"
+#include "batchnorm_layer.h"
+#include "activations.h"
+#include "network.h"
+#include "im2col.h"
+#include "utils.h"
+#include "blas.h"
+#include <math.h>
+#include <float.h>
+#include <pthread.h>
+
+/*
+ * Post-training quantization for CPU inference.
+ *
+ * INT8: weights are quantized symmetrically per output channel, activations
+ * per tensor with a scale calibrated on sample data and stored as u8 with a
+ * zero point of 128, so that u8 x s8 products map onto VNNI vpdpbusd. The
+ * zero point is removed in the epilogue with the precomputed weight row sums.
+ * BF16: weights and activations are rounded to bfloat16 and multiplied with
+ * vdpbf16ps, accumulating in fp32.
+ *
+ * Both paths compute C = A * B^T with A the [rows][K] weights and B the
+ * [N][K] activations, both contiguous and zero padded along K, so that the
+ * same dot-product kernels serve convolutional (B = im2col columns,
+ * transposed while quantizing) and connected layers (B = the input rows).
+ */
+
+#define QUANT_TILE 4
+#define QUANT_ZERO_POINT 128
+
+typedef void (*int8_tile_kernel)(int K, const int8_t **a, const uint8_t **b, int acc[QUANT_TILE][QUANT_TILE]);
+typedef void (*bf16_tile_kernel)(int K, const uint16_t **a, const uint16_t **b, float acc[QUANT_TILE][QUANT_TILE]);
+
+int quant_padded_k(int k)
+{
+    return (k + QUANT_K_ALIGN - 1)/QUANT_K_ALIGN*QUANT_K_ALIGN;
+}
+
+uint16_t float_to_bf16(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    if((u & 0x7fffffff) > 0x7f800000) return 0x7fc0;
+    u += 0x7fff + ((u >> 16) & 1);
+    return (uint16_t)(u >> 16);
+}
+
+float bf16_to_float(uint16_t h)
+{
+    uint32_t u = ((uint32_t)h) << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static void int8_tile_generic(int K, const int8_t **a, const uint8_t **b, int acc[QUANT_TILE][QUANT_TILE])
+{
+    int i, j, k;
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j){
+            int sum = 0;
+            for(k = 0; k < K; ++k) sum += (int)a[i][k]*(int)b[j][k];
+            acc[i][j] = sum;
+        }
+    }
+}
+
+static void bf16_tile_generic(int K, const uint16_t **a, const uint16_t **b, float acc[QUANT_TILE][QUANT_TILE])
+{
+    int i, j, k;
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j){
+            float sum = 0;
+            for(k = 0; k < K; ++k) sum += bf16_to_float(a[i][k])*bf16_to_float(b[j][k]);
+            acc[i][j] = sum;
+        }
+    }
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+static void int8_tile_vnni(int K, const int8_t **a, const uint8_t **b, int acc[QUANT_TILE][QUANT_TILE])
+{
+    __m512i c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_setzero_si512();
+    }
+    for(k = 0; k < K; k += 64){
+        __m512i bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) bv[j] = _mm512_loadu_si512((const void *)(b[j] + k));
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m512i av = _mm512_loadu_si512((const void *)(a[i] + k));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_dpbusd_epi32(c[i][j], bv[j], av);
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j) acc[i][j] = _mm512_reduce_add_epi32(c[i][j]);
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void int8_tile_avx512bw(int K, const int8_t **a, const uint8_t **b, int acc[QUANT_TILE][QUANT_TILE])
+{
+    __m512i c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_setzero_si512();
+    }
+    for(k = 0; k < K; k += 32){
+        __m512i bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) bv[j] = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)(b[j] + k)));
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m512i av = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(a[i] + k)));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_add_epi32(c[i][j], _mm512_madd_epi16(bv[j], av));
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j) acc[i][j] = _mm512_reduce_add_epi32(c[i][j]);
+    }
+}
+
+__attribute__((target("avx2")))
+static int hsum_epi32_avx2(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1,0,3,2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2,3,0,1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+__attribute__((target("avx2")))
+static void int8_tile_avx2(int K, const int8_t **a, const uint8_t **b, int acc[QUANT_TILE][QUANT_TILE])
+{
+    __m256i c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm256_setzero_si256();
+    }
+    for(k = 0; k < K; k += 16){
+        __m256i bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) bv[j] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(b[j] + k)));
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m256i av = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a[i] + k)));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm256_add_epi32(c[i][j], _mm256_madd_epi16(bv[j], av));
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j) acc[i][j] = hsum_epi32_avx2(c[i][j]);
+    }
+}
+
+__attribute__((target("avx512f,avx512bf16")))
+static void bf16_tile_avx512bf16(int K, const uint16_t **a, const uint16_t **b, float acc[QUANT_TILE][QUANT_TILE])
+{
+    __m512 c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_setzero_ps();
+    }
+    for(k = 0; k < K; k += 32){
+        __m512bh bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) bv[j] = (__m512bh)_mm512_loadu_si512((const void *)(b[j] + k));
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m512bh av = (__m512bh)_mm512_loadu_si512((const void *)(a[i] + k));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_dpbf16_ps(c[i][j], av, bv[j]);
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j) acc[i][j] = _mm512_reduce_add_ps(c[i][j]);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void bf16_tile_avx512f(int K, const uint16_t **a, const uint16_t **b, float acc[QUANT_TILE][QUANT_TILE])
+{
+    __m512 c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_setzero_ps();
+    }
+    for(k = 0; k < K; k += 16){
+        __m512 bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j){
+            __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(b[j] + k)));
+            bv[j] = _mm512_castsi512_ps(_mm512_slli_epi32(h, 16));
+        }
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(a[i] + k)));
+            __m512 av = _mm512_castsi512_ps(_mm512_slli_epi32(h, 16));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm512_fmadd_ps(av, bv[j], c[i][j]);
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j) acc[i][j] = _mm512_reduce_add_ps(c[i][j]);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void bf16_tile_avx2(int K, const uint16_t **a, const uint16_t **b, float acc[QUANT_TILE][QUANT_TILE])
+{
+    __m256 c[QUANT_TILE][QUANT_TILE];
+    int i, j, k;
+    #pragma GCC unroll 4
+    for(i = 0; i < QUANT_TILE; ++i){
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm256_setzero_ps();
+    }
+    for(k = 0; k < K; k += 8){
+        __m256 bv[QUANT_TILE];
+        #pragma GCC unroll 4
+        for(j = 0; j < QUANT_TILE; ++j){
+            __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(b[j] + k)));
+            bv[j] = _mm256_castsi256_ps(_mm256_slli_epi32(h, 16));
+        }
+        #pragma GCC unroll 4
+        for(i = 0; i < QUANT_TILE; ++i){
+            __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(a[i] + k)));
+            __m256 av = _mm256_castsi256_ps(_mm256_slli_epi32(h, 16));
+            #pragma GCC unroll 4
+            for(j = 0; j < QUANT_TILE; ++j) c[i][j] = _mm256_fmadd_ps(av, bv[j], c[i][j]);
+        }
+    }
+    for(i = 0; i < QUANT_TILE; ++i){
+        for(j = 0; j < QUANT_TILE; ++j){
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(c[i][j]), _mm256_extractf128_ps(c[i][j], 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            s = _mm_add_ss(s, _mm_movehdup_ps(s));
+            acc[i][j] = _mm_cvtss_f32(s);
+        }
+    }
+}
+#endif
+
+static int8_tile_kernel int8_tile = int8_tile_generic;
+static bf16_tile_kernel bf16_tile = bf16_tile_generic;
+static const char *int8_tile_name = "generic";
+static const char *bf16_tile_name = "generic";
+static pthread_once_t quant_kernel_once = PTHREAD_ONCE_INIT;
+
+static void quant_select_kernels()
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw")){
+        int8_tile = int8_tile_vnni; int8_tile_name = "avx512 vnni";
+    } else if(__builtin_cpu_supports("avx512bw")){
+        int8_tile = int8_tile_avx512bw; int8_tile_name = "avx512bw";
+    } else if(__builtin_cpu_supports("avx2")){
+        int8_tile = int8_tile_avx2; int8_tile_name = "avx2";
+    }
+    if(__builtin_cpu_supports("avx512bf16")){
+        bf16_tile = bf16_tile_avx512bf16; bf16_tile_name = "avx512 bf16";
+    } else if(__builtin_cpu_supports("avx512f")){
+        bf16_tile = bf16_tile_avx512f; bf16_tile_name = "avx512f";
+    } else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        bf16_tile = bf16_tile_avx2; bf16_tile_name = "avx2";
+    }
+#endif
+}
+
+const char *quant_kernel_name(QUANT_TYPE type)
+{
+    pthread_once(&quant_kernel_once, quant_select_kernels);
+    if(type == QUANT_INT8) return int8_tile_name;
+    if(type == QUANT_BF16) return bf16_tile_name;
+    return "fp32";
+}
+
+/* C[m*ldc_m + n*ldc_n] = (A[m].B[n] - 128*a_sums[m])*scales[m] + bias[m] */
+void gemm_int8_nt(int M, int N, int K,
+        const int8_t *A, int lda,
+        const uint8_t *B, int ldb,
+        const int *a_sums, const float *scales, const float *bias,
+        float *C, int ldc_m, int ldc_n)
+{
+    int n0;
+    pthread_once(&quant_kernel_once, quant_select_kernels);
+    #pragma omp parallel for schedule(static)
+    for(n0 = 0; n0 < N; n0 += QUANT_TILE){
+        int nn = (N - n0 < QUANT_TILE) ? N - n0 : QUANT_TILE;
+        const uint8_t *b[QUANT_TILE];
+        int m0, i, j;
+        for(j = 0; j < QUANT_TILE; ++j) b[j] = B + (size_t)(n0 + (j < nn ? j : 0))*ldb;
+        for(m0 = 0; m0 < M; m0 += QUANT_TILE){
+            int mm = (M - m0 < QUANT_TILE) ? M - m0 : QUANT_TILE;
+            const int8_t *a[QUANT_TILE];
+            int acc[QUANT_TILE][QUANT_TILE];
+            for(i = 0; i < QUANT_TILE; ++i) a[i] = A + (size_t)(m0 + (i < mm ? i : 0))*lda;
+            int8_tile(K, a, b, acc);
+            for(i = 0; i < mm; ++i){
+                int m = m0 + i;
+                float bm = bias ? bias[m] : 0;
+                for(j = 0; j < nn; ++j){
+                    C[(size_t)m*ldc_m + (size_t)(n0 + j)*ldc_n] =
+                        (float)(acc[i][j] - QUANT_ZERO_POINT*a_sums[m])*scales[m] + bm;
+                }
+            }
+        }
+    }
+}
+
+/* C[m*ldc_m + n*ldc_n] = A[m].B[n] + bias[m] */
+void gemm_bf16_nt(int M, int N, int K,
+        const uint16_t *A, int lda,
+        const uint16_t *B, int ldb,
+        const float *bias,
+        float *C, int ldc_m, int ldc_n)
+{
+    int n0;
+    pthread_once(&quant_kernel_once, quant_select_kernels);
+    #pragma omp parallel for schedule(static)
+    for(n0 = 0; n0 < N; n0 += QUANT_TILE){
+        int nn = (N - n0 < QUANT_TILE) ? N - n0 : QUANT_TILE;
+        const uint16_t *b[QUANT_TILE];
+        int m0, i, j;
+        for(j = 0; j < QUANT_TILE; ++j) b[j] = B + (size_t)(n0 + (j < nn ? j : 0))*ldb;
+        for(m0 = 0; m0 < M; m0 += QUANT_TILE){
+            int mm = (M - m0 < QUANT_TILE) ? M - m0 : QUANT_TILE;
+            const uint16_t *a[QUANT_TILE];
+            float acc[QUANT_TILE][QUANT_TILE];
+            for(i = 0; i < QUANT_TILE; ++i) a[i] = A + (size_t)(m0 + (i < mm ? i : 0))*lda;
+            bf16_tile(K, a, b, acc);
+            for(i = 0; i < mm; ++i){
+                int m = m0 + i;
+                float bm = bias ? bias[m] : 0;
+                for(j = 0; j < nn; ++j){
+                    C[(size_t)m*ldc_m + (size_t)(n0 + j)*ldc_n] = acc[i][j] + bm;
+                }
+            }
+        }
+    }
+}
+
+static inline uint8_t quantize_u8(float x, float inv_scale)
+{
+    float q = roundf(x*inv_scale) + QUANT_ZERO_POINT;
+    if(q < 0) q = 0;
+    if(q > 255) q = 255;
+    return (uint8_t)q;
+}
+
+/* [K][N] float columns -> [N][Kp] quantized rows, the K padding filled with the
+   zero point so that it quantizes 0 (removed with the weight row sums) */
+static void quantize_columns_u8(const float *b, int K, int N, float scale, uint8_t *q, int Kp)
+{
+    const float inv = 1.f/scale;
+    int n0;
+    #pragma omp parallel for schedule(static)
+    for(n0 = 0; n0 < N; n0 += 64){
+        int nb = (N - n0 < 64) ? N - n0 : 64;
+        int k, n;
+        for(n = 0; n < nb; ++n) memset(q + (size_t)(n0 + n)*Kp + K, QUANT_ZERO_POINT, Kp - K);
+        for(k = 0; k < K; ++k){
+            const float *row = b + (size_t)k*N + n0;
+            for(n = 0; n < nb; ++n) q[(size_t)(n0 + n)*Kp + k] = quantize_u8(row[n], inv);
+        }
+    }
+}
+
+static void bf16_columns(const float *b, int K, int N, uint16_t *q, int Kp)
+{
+    int n0;
+    #pragma omp parallel for schedule(static)
+    for(n0 = 0; n0 < N; n0 += 64){
+        int nb = (N - n0 < 64) ? N - n0 : 64;
+        int k, n;
+        for(n = 0; n < nb; ++n) memset(q + (size_t)(n0 + n)*Kp + K, 0, (Kp - K)*sizeof(uint16_t));
+        for(k = 0; k < K; ++k){
+            const float *row = b + (size_t)k*N + n0;
+            for(n = 0; n < nb; ++n) q[(size_t)(n0 + n)*Kp + k] = float_to_bf16(row[n]);
+        }
+    }
+}
+
+static int layer_rows(const layer *l)
+{
+    return (l->type == CONNECTED) ? l->outputs : l->n;
+}
+
+static int layer_cols(const layer *l)
+{
+    return (l->type == CONNECTED) ? l->inputs : l->nweights/l->n;
+}
+
+static void free_quantized_weights(layer *l)
+{
+    free(l->weights_int8);
+    free(l->weights_bf16);
+    free(l->weight_scales);
+    free(l->weight_sums);
+    l->weights_int8 = 0;
+    l->weights_bf16 = 0;
+    l->weight_scales = 0;
+    l->weight_sums = 0;
+}
+
+static void set_quantized_forward(layer *l)
+{
+    if(l->type == CONVOLUTIONAL) l->forward = forward_convolutional_layer_quantized;
+    if(l->type == CONNECTED) l->forward = forward_connected_layer_quantized;
+}
+
+static void finish_int8_rows(layer *l)
+{
+    int rows = layer_rows(l);
+    int cols = layer_cols(l);
+    int kp = quant_padded_k(cols);
+    int r, k;
+    for(r = 0; r < rows; ++r){
+        int sum = 0;
+        for(k = 0; k < cols; ++k){
+            sum += l->weights_int8[(size_t)r*kp + k];
+            l->weights[(size_t)r*cols + k] = l->weights_int8[(size_t)r*kp + k]*l->weight_scales[r];
+        }
+        l->weight_sums[r] = sum;
+    }
+}
+
+void quantize_layer(layer *l, QUANT_TYPE type)
+{
+    if(l->type != CONVOLUTIONAL && l->type != CONNECTED) return;
+    if(l->binary || l->xnor) return;
+    int rows = layer_rows(l);
+    int cols = layer_cols(l);
+    int kp = quant_padded_k(cols);
+    int r, k;
+
+    free_quantized_weights(l);
+    l->quantized = QUANT_NONE;
+    if(type == QUANT_INT8){
+        l->weights_int8 = calloc((size_t)rows*kp, sizeof(int8_t));
+        l->weight_scales = calloc(rows, sizeof(float));
+        l->weight_sums = calloc(rows, sizeof(int));
+        for(r = 0; r < rows; ++r){
+            const float *w = l->weights + (size_t)r*cols;
+            float amax = 0;
+            for(k = 0; k < cols; ++k) amax = fmaxf(amax, fabsf(w[k]));
+            float s = (amax > 0) ? amax/127.f : 1.f;
+            for(k = 0; k < cols; ++k){
+                float q = roundf(w[k]/s);
+                if(q > 127) q = 127;
+                if(q < -127) q = -127;
+                l->weights_int8[(size_t)r*kp + k] = (int8_t)q;
+            }
+            l->weight_scales[r] = s;
+        }
+        finish_int8_rows(l);
+        l->input_scale = (l->input_max > 0) ? l->input_max/127.f : 1.f;
+    } else if(type == QUANT_BF16){
+        l->weights_bf16 = calloc((size_t)rows*kp, sizeof(uint16_t));
+        for(r = 0; r < rows; ++r){
+            for(k = 0; k < cols; ++k){
+                uint16_t h = float_to_bf16(l->weights[(size_t)r*cols + k]);
+                l->weights_bf16[(size_t)r*kp + k] = h;
+                l->weights[(size_t)r*cols + k] = bf16_to_float(h);
+            }
+        }
+    } else {
+        return;
+    }
+    l->quantized = type;
+    set_quantized_forward(l);
+}
+
+void save_quantized_weights(layer l, FILE *fp)
+{
+    int rows = layer_rows(&l);
+    int cols = layer_cols(&l);
+    int kp = quant_padded_k(cols);
+    int r;
+    if(l.quantized == QUANT_INT8){
+        fwrite(l.weight_scales, sizeof(float), rows, fp);
+        fwrite(&l.input_scale, sizeof(float), 1, fp);
+        for(r = 0; r < rows; ++r) fwrite(l.weights_int8 + (size_t)r*kp, sizeof(int8_t), cols, fp);
+    } else if(l.quantized == QUANT_BF16){
+        for(r = 0; r < rows; ++r) fwrite(l.weights_bf16 + (size_t)r*kp, sizeof(uint16_t), cols, fp);
+    }
+}
+
+void load_quantized_weights(layer *l, FILE *fp, QUANT_TYPE type)
+{
+    int rows = layer_rows(l);
+    int cols = layer_cols(l);
+    int kp = quant_padded_k(cols);
+    int r, k;
+    free_quantized_weights(l);
+    if(type == QUANT_INT8){
+        l->weights_int8 = calloc((size_t)rows*kp, sizeof(int8_t));
+        l->weight_scales = calloc(rows, sizeof(float));
+        l->weight_sums = calloc(rows, sizeof(int));
+        fread(l->weight_scales, sizeof(float), rows, fp);
+        fread(&l->input_scale, sizeof(float), 1, fp);
+        for(r = 0; r < rows; ++r) fread(l->weights_int8 + (size_t)r*kp, sizeof(int8_t), cols, fp);
+        finish_int8_rows(l);
+    } else if(type == QUANT_BF16){
+        l->weights_bf16 = calloc((size_t)rows*kp, sizeof(uint16_t));
+        for(r = 0; r < rows; ++r){
+            fread(l->weights_bf16 + (size_t)r*kp, sizeof(uint16_t), cols, fp);
+            for(k = 0; k < cols; ++k){
+                l->weights[(size_t)r*cols + k] = bf16_to_float(l->weights_bf16[(size_t)r*kp + k]);
+            }
+        }
+    } else {
+        return;
+    }
+    l->quantized = type;
+    set_quantized_forward(l);
+}
+
+static void quantized_gemm(layer l, int m, int n, int k, int row0,
+        const float *b_cols, const float *b_rows, float *bias,
+        float *c, int ldc_m, int ldc_n)
+{
+    int kp = quant_padded_k(k);
+    int i;
+    if(l.quantized == QUANT_INT8){
+        uint8_t *q = malloc((size_t)n*kp);
+        float *scales = malloc(m*sizeof(float));
+        for(i = 0; i < m; ++i) scales[i] = l.weight_scales[row0 + i]*l.input_scale;
+        if(b_cols){
+            quantize_columns_u8(b_cols, k, n, l.input_scale, q, kp);
+        } else {
+            const float inv = 1.f/l.input_scale;
+            int j;
+            for(i = 0; i < n; ++i){
+                for(j = 0; j < k; ++j) q[(size_t)i*kp + j] = quantize_u8(b_rows[(size_t)i*k + j], inv);
+                memset(q + (size_t)i*kp + k, QUANT_ZERO_POINT, kp - k);
+            }
+        }
+        gemm_int8_nt(m, n, kp, l.weights_int8 + (size_t)row0*kp, kp, q, kp,
+                l.weight_sums + row0, scales, bias, c, ldc_m, ldc_n);
+        free(scales);
+        free(q);
+    } else {
+        uint16_t *q = malloc((size_t)n*kp*sizeof(uint16_t));
+        if(b_cols){
+            bf16_columns(b_cols, k, n, q, kp);
+        } else {
+            int j;
+            for(i = 0; i < n; ++i){
+                for(j = 0; j < k; ++j) q[(size_t)i*kp + j] = float_to_bf16(b_rows[(size_t)i*k + j]);
+                for(; j < kp; ++j) q[(size_t)i*kp + j] = 0;
+            }
+        }
+        gemm_bf16_nt(m, n, kp, l.weights_bf16 + (size_t)row0*kp, kp, q, kp, bias, c, ldc_m, ldc_n);
+        free(q);
+    }
+}
+
+void forward_convolutional_layer_quantized(layer l, network net)
+{
+    int i, j;
+    int m = l.n/l.groups;
+    int k = l.size*l.size*l.c/l.groups;
+    int n = l.out_w*l.out_h;
+    for(i = 0; i < l.batch; ++i){
+        for(j = 0; j < l.groups; ++j){
+            float *b = net.workspace;
+            float *c = l.output + (i*l.groups + j)*n*m;
+            float *im =  net.input + (i*l.groups + j)*l.c/l.groups*l.h*l.w;
+            float *bias = l.batch_normalize ? 0 : l.biases + j*m;
+
+            if(l.size == 1 && l.stride == 1 && l.pad == 0){
+                b = im;
+            } else {
+                im2col_cpu(im, l.c/l.groups, l.h, l.w, l.size, l.stride, l.pad, b);
+            }
+            quantized_gemm(l, m, n, k, j*m, b, 0, bias, c, n, 1);
+        }
+    }
+    if(l.batch_normalize) forward_batchnorm_layer(l, net);
+    activate_array(l.output, l.outputs*l.batch, l.activation);
+}
+
+void forward_connected_layer_quantized(layer l, network net)
+{
+    float *bias = l.batch_normalize ? 0 : l.biases;
+    quantized_gemm(l, l.outputs, l.batch, l.inputs, 0, 0, net.input, bias, l.output, 1, l.outputs);
+    if(l.batch_normalize) forward_batchnorm_layer(l, net);
+    activate_array(l.output, l.outputs*l.batch, l.activation);
+}
+
+/* Records the largest |input| seen by every conv/connected layer. */
+void calibrate_network(network *net, data d)
+{
+    int i, b, j;
+    int batch = net->batch;
+    float *X = calloc(batch*d.X.cols, sizeof(float));
+    network orig = *net;
+    for(i = 0; i < net->n; ++i) net->layers[i].input_max = 0;
+    for(b = 0; b + batch <= d.X.rows; b += batch){
+        network state = *net;
+        get_next_batch(d, batch, b, X, 0);
+        state.input = X;
+        state.truth = 0;
+        state.train = 0;
+        state.delta = 0;
+        for(i = 0; i < net->n; ++i){
+            layer *l = &net->layers[i];
+            state.index = i;
+            if(l->type == CONVOLUTIONAL || l->type == CONNECTED){
+                float amax = l->input_max;
+                for(j = 0; j < l->inputs*batch; ++j) amax = fmaxf(amax, fabsf(state.input[j]));
+                l->input_max = amax;
+            }
+            l->forward(*l, state);
+            state.input = l->output;
+        }
+    }
+    *net = orig;
+    free(X);
+}
+
+void quantize_network(network *net, QUANT_TYPE type, data calib)
+{
+    int i;
+    fuse_network_batchnorm(net);
+    if(type == QUANT_INT8) calibrate_network(net, calib);
+    for(i = 0; i < net->n; ++i){
+        quantize_layer(&net->layers[i], type);
+    }
+    fprintf(stderr, "Quantized network to %s (kernel: %s)\n",
+            type == QUANT_INT8 ? "int8" : type == QUANT_BF16 ? "bf16" : "fp32",
+            quant_kernel_name(type));
+}
+
+static QUANT_TYPE quant_network_type(network *net)
+{
+    int i;
+    for(i = 0; i < net->n; ++i){
+        if(net->layers[i].quantized) return net->layers[i].quantized;
+    }
+    return QUANT_NONE;
+}
+
+/* Accuracy and speed of a quantized network against its fp32 reference on d. */
+void quantization_report(network *fp32, network *quant, data d)
+{
+    int i, j;
+    int outputs = fp32->outputs;
+    double abs_err = 0, max_err = 0, ref_sq = 0, err_sq = 0;
+    double t_ref = 0, t_q = 0, t0;
+    int agree = 0, correct_ref = 0, correct_q = 0;
+    float *ref = calloc(outputs, sizeof(float));
+    for(i = 0; i < d.X.rows; ++i){
+        t0 = what_time_is_it_now();
+        float *out = network_predict(fp32, d.X.vals[i]);
+        t_ref += what_time_is_it_now() - t0;
+        memcpy(ref, out, outputs*sizeof(float));
+        t0 = what_time_is_it_now();
+        out = network_predict(quant, d.X.vals[i]);
+        t_q += what_time_is_it_now() - t0;
+        for(j = 0; j < outputs; ++j){
+            double e = fabs(out[j] - ref[j]);
+            abs_err += e;
+            if(e > max_err) max_err = e;
+            err_sq += e*e;
+            ref_sq += ref[j]*ref[j];
+        }
+        int top_ref = max_index(ref, outputs);
+        int top_q = max_index(out, outputs);
+        agree += (top_ref == top_q);
+        if(d.y.vals && d.y.cols == outputs){
+            int truth = max_index(d.y.vals[i], outputs);
+            correct_ref += (top_ref == truth);
+            correct_q += (top_q == truth);
+        }
+    }
+    free(ref);
+    int n = d.X.rows;
+    printf("Quantization report over %d samples\n", n);
+    printf("mean |err|: %g, max |err|: %g, relative L2: %g\n",
+            abs_err/((double)n*outputs), max_err, ref_sq > 0 ? sqrt(err_sq/ref_sq) : 0);
+    printf("top-1 agreement: %f\n", (float)agree/n);
+    printf("images/s fp32: %f, quantized (%s): %f, speedup: %f\n",
+            t_ref > 0 ? n/t_ref : 0, quant_kernel_name(quant_network_type(quant)),
+            t_q > 0 ? n/t_q : 0, t_q > 0 ? t_ref/t_q : 0);
+    if(d.y.vals && d.y.cols == outputs){
+        printf("top-1 accuracy fp32: %f, quantized: %f, delta: %f\n",
+                (float)correct_ref/n, (float)correct_q/n, (float)(correct_q - correct_ref)/n);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+#include "darknet.h"
+
+/* Reduction dimension of quantized weights/activations is padded to this. */
+#define QUANT_K_ALIGN 64
+
+/*
+ * Quantized .weights files. The header is the usual one with a minor
+ * version no fp32 file uses, followed by a magic word and the type:
+ *     int major = 0, int minor = QUANT_WEIGHTS_MINOR, int revision = 0,
+ *     size_t seen, uint32_t QUANT_WEIGHTS_MAGIC, int QUANT_INT8|QUANT_BF16.
+ * The layers follow in network order. Convolutional: float biases[n],
+ * int batch_normalize (0 once folded), the batchnorm floats if set, then
+ * the weights. Connected: float biases[outputs], the weights, the
+ * batchnorm floats. Weights INT8: float scales[rows], float input_scale,
+ * int8 [rows][cols]; BF16: uint16 [rows][cols]. Other layers as fp32.
+ */
+#define QUANT_WEIGHTS_MINOR 81          /* 'Q' */
+#define QUANT_WEIGHTS_MAGIC 0x57514b44u /* "DKQW" little endian */
+
+int quant_padded_k(int k);
+uint16_t float_to_bf16(float f);
+float bf16_to_float(uint16_t h);
+
+void quantize_layer(layer *l, QUANT_TYPE type);
+void save_quantized_weights(layer l, FILE *fp);
+void load_quantized_weights(layer *l, FILE *fp, QUANT_TYPE type);
+
+void forward_convolutional_layer_quantized(layer l, network net);
+void forward_connected_layer_quantized(layer l, network net);
+
+void gemm_int8_nt(int M, int N, int K,
+        const int8_t *A, int lda,
+        const uint8_t *B, int ldb,
+        const int *a_sums, const float *scales, const float *bias,
+        float *C, int ldc_m, int ldc_n);
+
+void gemm_bf16_nt(int M, int N, int K,
+        const uint16_t *A, int lda,
+        const uint16_t *B, int ldb,
+        const float *bias,
+        float *C, int ldc_m, int ldc_n);
+
+const char *quant_kernel_name(QUANT_TYPE type);
+
+#endif
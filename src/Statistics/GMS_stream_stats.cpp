@@ -0,0 +1,785 @@
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <immintrin.h>
+#include "GMS_stream_stats.h"
+#include "GMS_par_team.h"
+
+namespace {
+
+#if defined(__AVX512F__)
+
+        typedef __m512d vd_t;
+        constexpr std::size_t VW = 8ULL;
+
+        inline vd_t ld(const double * p)  { return (_mm512_loadu_pd(p)); }
+        inline vd_t ld(const float * p)   { return (_mm512_cvtps_pd(_mm256_loadu_ps(p))); }
+        inline vd_t vset(const double a)  { return (_mm512_set1_pd(a)); }
+        inline vd_t vadd(const vd_t a,const vd_t b) { return (_mm512_add_pd(a,b)); }
+        inline vd_t vsub(const vd_t a,const vd_t b) { return (_mm512_sub_pd(a,b)); }
+        inline vd_t vmul(const vd_t a,const vd_t b) { return (_mm512_mul_pd(a,b)); }
+        inline vd_t vfma(const vd_t a,const vd_t b,const vd_t c) { return (_mm512_fmadd_pd(a,b,c)); }
+        // NaN in a -> b
+        inline vd_t vmin(const vd_t a,const vd_t b) { return (_mm512_min_pd(a,b)); }
+        inline vd_t vmax(const vd_t a,const vd_t b) { return (_mm512_max_pd(a,b)); }
+        inline double hsum(const vd_t a) { return (_mm512_reduce_add_pd(a)); }
+        inline double hmin(const vd_t a) { return (_mm512_reduce_min_pd(a)); }
+        inline double hmax(const vd_t a) { return (_mm512_reduce_max_pd(a)); }
+        inline void   st_idx(int32_t * p,const vd_t a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),_mm512_cvttpd_epi32(a)); }
+
+#elif defined(__AVX2__)
+
+        typedef __m256d vd_t;
+        constexpr std::size_t VW = 4ULL;
+
+        inline vd_t ld(const double * p)  { return (_mm256_loadu_pd(p)); }
+        inline vd_t ld(const float * p)   { return (_mm256_cvtps_pd(_mm_loadu_ps(p))); }
+        inline vd_t vset(const double a)  { return (_mm256_set1_pd(a)); }
+        inline vd_t vadd(const vd_t a,const vd_t b) { return (_mm256_add_pd(a,b)); }
+        inline vd_t vsub(const vd_t a,const vd_t b) { return (_mm256_sub_pd(a,b)); }
+        inline vd_t vmul(const vd_t a,const vd_t b) { return (_mm256_mul_pd(a,b)); }
+        inline vd_t vfma(const vd_t a,const vd_t b,const vd_t c) { return (_mm256_fmadd_pd(a,b,c)); }
+        inline vd_t vmin(const vd_t a,const vd_t b) { return (_mm256_min_pd(a,b)); }
+        inline vd_t vmax(const vd_t a,const vd_t b) { return (_mm256_max_pd(a,b)); }
+        inline double hsum(const vd_t a)
+        {
+               const __m128d s{_mm_add_pd(_mm256_castpd256_pd128(a),_mm256_extractf128_pd(a,1))};
+               return (_mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s))));
+        }
+        inline double hmin(const vd_t a)
+        {
+               const __m128d s{_mm_min_pd(_mm256_castpd256_pd128(a),_mm256_extractf128_pd(a,1))};
+               return (_mm_cvtsd_f64(_mm_min_sd(s,_mm_unpackhi_pd(s,s))));
+        }
+        inline double hmax(const vd_t a)
+        {
+               const __m128d s{_mm_max_pd(_mm256_castpd256_pd128(a),_mm256_extractf128_pd(a,1))};
+               return (_mm_cvtsd_f64(_mm_max_sd(s,_mm_unpackhi_pd(s,s))));
+        }
+        inline void   st_idx(int32_t * p,const vd_t a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p),_mm256_cvttpd_epi32(a)); }
+
+#else
+
+        typedef double vd_t;
+        constexpr std::size_t VW = 1ULL;
+
+        inline vd_t ld(const double * p)  { return (*p); }
+        inline vd_t ld(const float * p)   { return (static_cast<double>(*p)); }
+        inline vd_t vset(const double a)  { return (a); }
+        inline vd_t vadd(const vd_t a,const vd_t b) { return (a+b); }
+        inline vd_t vsub(const vd_t a,const vd_t b) { return (a-b); }
+        inline vd_t vmul(const vd_t a,const vd_t b) { return (a*b); }
+        inline vd_t vfma(const vd_t a,const vd_t b,const vd_t c) { return (a*b+c); }
+        inline vd_t vmin(const vd_t a,const vd_t b) { return ((a < b) ? a : b); }
+        inline vd_t vmax(const vd_t a,const vd_t b) { return ((a > b) ? a : b); }
+        inline double hsum(const vd_t a) { return (a); }
+        inline double hmin(const vd_t a) { return (a); }
+        inline double hmax(const vd_t a) { return (a); }
+        inline void   st_idx(int32_t * p,const vd_t a) { *p = static_cast<int32_t>(a); }
+
+#endif
+
+        /*
+             Central moments of x[0..m), m <= STREAM_STATS_CHUNK: sum, min, max,
+             then the sums of d^k, d = x-c about the provisional mean c, the
+             residual mean s1/m corrects them to the chunk mean. A non-finite
+             sum sends the chunk through a copy of its finite values.
+        */
+        template<typename T>
+        void chunk_moments(const T * __restrict x,
+                           const std::size_t m,
+                           gms::stat::stream_moments_t & c)
+        {
+             const std::size_t mv{m-m%VW};
+             vd_t vs0{vset(0.0)},vs1{vset(0.0)};
+             vd_t vlo{vset(std::numeric_limits<double>::infinity())},vhi{vset(-std::numeric_limits<double>::infinity())};
+             std::size_t __i{0};
+             for(; __i+2ULL*VW <= mv; __i += 2ULL*VW)
+             {
+                  const vd_t a{ld(x+__i)},b{ld(x+__i+VW)};
+                  vs0 = vadd(vs0,a);
+                  vs1 = vadd(vs1,b);
+                  vlo = vmin(vlo,vmin(a,b));
+                  vhi = vmax(vhi,vmax(a,b));
+             }
+             for(; __i != mv; __i += VW)
+             {
+                  const vd_t a{ld(x+__i)};
+                  vs0 = vadd(vs0,a);
+                  vlo = vmin(vlo,a);
+                  vhi = vmax(vhi,a);
+             }
+             double sum{hsum(vadd(vs0,vs1))},lo{hmin(vlo)},hi{hmax(vhi)};
+             for(; __i != m; ++__i)
+             {
+                  const double v{static_cast<double>(x[__i])};
+                  sum += v;
+                  lo = std::min(lo,v);
+                  hi = std::max(hi,v);
+             }
+             if(!std::isfinite(sum))
+             {
+                  // NaN or +-inf in the chunk (or a sum of finite values beyond DBL_MAX)
+                  alignas(64) double y[STREAM_STATS_CHUNK];
+                  std::size_t k{0};
+                  for(__i = 0ULL; __i != m; ++__i)
+                  {
+                       const double v{static_cast<double>(x[__i])};
+                       if(std::isfinite(v)) y[k++] = v;
+                  }
+                  if(k != m)
+                  {
+                     if(k != 0ULL)
+                        chunk_moments(&y[0],k,c);
+                     else
+                        c = gms::stat::stream_moments_t{};
+                     c.nonfinite = static_cast<uint64_t>(m-k);
+                     return;
+                  }
+             }
+             const double dm{static_cast<double>(m)};
+             const double cm{sum/dm};
+             const vd_t vc{vset(cm)};
+             vd_t v1{vset(0.0)},v2{vset(0.0)},v3{vset(0.0)},v4{vset(0.0)};
+             for(__i = 0ULL; __i != mv; __i += VW)
+             {
+                  const vd_t d{vsub(ld(x+__i),vc)};
+                  const vd_t d2{vmul(d,d)};
+                  v1 = vadd(v1,d);
+                  v2 = vadd(v2,d2);
+                  v3 = vfma(d2,d,v3);
+                  v4 = vfma(d2,d2,v4);
+             }
+             double s1{hsum(v1)},s2{hsum(v2)},s3{hsum(v3)},s4{hsum(v4)};
+             for(; __i != m; ++__i)
+             {
+                  const double d{static_cast<double>(x[__i])-cm};
+                  const double d2{d*d};
+                  s1 += d; s2 += d2; s3 += d2*d; s4 += d2*d2;
+             }
+             const double e{s1/dm};
+             const double e2{e*e};
+             c.n    = static_cast<uint64_t>(m);
+             c.mean = cm+e;
+             c.M2   = s2-s1*e;
+             c.M3   = s3-3.0*e*s2+2.0*dm*e2*e;
+             c.M4   = s4-4.0*e*s3+6.0*e2*s2-3.0*dm*e2*e2;
+             c.min  = lo;
+             c.max  = hi;
+             c.nonfinite = 0ULL;
+        }
+
+        template<typename T>
+        void moments_add(gms::stat::stream_moments_t & s,
+                         const T * __restrict x,
+                         const std::size_t n)
+        {
+             gms::stat::stream_moments_t c;
+             for(std::size_t __i{0}; __i < n; __i += STREAM_STATS_CHUNK)
+             {
+                  chunk_moments(x+__i,std::min<std::size_t>(STREAM_STATS_CHUNK,n-__i),c);
+                  s.merge(c);
+             }
+        }
+
+        // Bin slots of x[0..m): u = (x-lo)/w+1 clamped to [0,nbins+1] (NaN -> 0), truncated.
+        template<typename T>
+        void hist_add(gms::stat::stream_hist_t & h,
+                      const T * __restrict x,
+                      const std::size_t n)
+        {
+             if(h.nbins <= 0) return;
+             alignas(64) int32_t idx[STREAM_STATS_CHUNK];
+             const double iw{static_cast<double>(h.nbins)/(h.hi-h.lo)};
+             const double sh{1.0-h.lo*iw};
+             const double top{static_cast<double>(h.nbins)+1.0};
+             const vd_t viw{vset(iw)},vsh{vset(sh)},vz{vset(0.0)},vtop{vset(top)};
+             uint64_t * __restrict cnt{h.cnt.data()};
+             for(std::size_t __b{0}; __b < n; __b += STREAM_STATS_CHUNK)
+             {
+                  const std::size_t m{std::min<std::size_t>(STREAM_STATS_CHUNK,n-__b)};
+                  const std::size_t mv{m-m%VW};
+                  const T * __restrict xb{x+__b};
+                  std::size_t __i{0};
+                  for(; __i != mv; __i += VW)
+                  {
+                       const vd_t u{vfma(ld(xb+__i),viw,vsh)};
+                       st_idx(idx+__i,vmin(vmax(u,vz),vtop));
+                  }
+                  for(; __i != m; ++__i)
+                  {
+                       double u{static_cast<double>(xb[__i])*iw+sh};
+                       u = (u > 0.0) ? u : 0.0;
+                       u = (u < top) ? u : top;
+                       idx[__i] = static_cast<int32_t>(u);
+                  }
+                  for(__i = 0ULL; __i != m; ++__i) ++cnt[idx[__i]];
+             }
+        }
+
+        /*
+             LSD radix sort (8-bit digits) of the order-preserving integer keys
+             of the doubles (sign bit flipped, all bits of the negative ones),
+             the passes of a digit equal in all the keys skipped: no
+             mispredicted compares of std::sort on the flushed buffers.
+        */
+        void radix_sort(std::vector<double> & v)
+        {
+             const std::size_t n{v.size()};
+             if(n < 64ULL)
+             {
+                std::sort(v.begin(),v.end());
+                return;
+             }
+             std::vector<uint64_t> ka(n),kb(n);
+             uint32_t cnt[8][256] = {};
+             for(std::size_t __i{0}; __i != n; ++__i)
+             {
+                  uint64_t k;
+                  std::memcpy(&k,&v[__i],8ULL);
+                  k ^= (k>>63) ? ~0ULL : (1ULL<<63);
+                  ka[__i] = k;
+                  for(int32_t __d{0}; __d != 8; ++__d) ++cnt[__d][(k>>(8*__d))&0xFFULL];
+             }
+             uint64_t * __restrict src{ka.data()};
+             uint64_t * __restrict dst{kb.data()};
+             for(int32_t __d{0}; __d != 8; ++__d)
+             {
+                  const int32_t sh{8*__d};
+                  if(cnt[__d][(src[0]>>sh)&0xFFULL] == n) continue;
+                  uint32_t off[256];
+                  uint32_t acc{0};
+                  for(int32_t __b{0}; __b != 256; ++__b) { off[__b] = acc; acc += cnt[__d][__b]; }
+                  for(std::size_t __i{0}; __i != n; ++__i) dst[off[(src[__i]>>sh)&0xFFULL]++] = src[__i];
+                  std::swap(src,dst);
+             }
+             for(std::size_t __i{0}; __i != n; ++__i)
+             {
+                  uint64_t k{src[__i]};
+                  k ^= (k>>63) ? (1ULL<<63) : ~0ULL;
+                  std::memcpy(&v[__i],&k,8ULL);
+             }
+        }
+
+        // k1 scale function of the compression d and its inverse
+        inline double k1(const double q,const double d)
+        {
+             return (d*(1.0/(2.0*M_PI))*std::asin(2.0*q-1.0));
+        }
+
+        inline double k1_inv(const double k,const double d)
+        {
+             const double a{std::min(std::max(k*(2.0*M_PI)/d,-0.5*M_PI),0.5*M_PI)};
+             return (0.5*(std::sin(a)+1.0));
+        }
+
+        /*
+             One merge pass over the centroids (m,w) in ascending order, the
+             total weight tw: neighbours are merged while the weight stays
+             within one unit of k1 from the start of the current centroid.
+        */
+        void compress(std::vector<double> & m,
+                      std::vector<double> & w,
+                      const double tw,
+                      const double d)
+        {
+             const std::size_t nc{m.size()};
+             if(nc < 2ULL) return;
+             std::size_t out{0};
+             double wsum{0.0};  // weight before the current centroid
+             double c0{m[0]},cs{0.0},cw{w[0]};  // mean = c0+cs/cw
+             double lim{tw*k1_inv(k1(0.0,d)+1.0,d)};
+             for(std::size_t __i{1}; __i != nc; ++__i)
+             {
+                  if(wsum+cw+w[__i] <= lim)
+                  {
+                       cw += w[__i];
+                       cs += (m[__i]-c0)*w[__i];
+                  }
+                  else
+                  {
+                       m[out] = c0+cs/cw; w[out] = cw; ++out;
+                       wsum += cw;
+                       c0 = m[__i]; cs = 0.0; cw = w[__i];
+                       lim = tw*k1_inv(k1(wsum/tw,d)+1.0,d);
+                  }
+             }
+             m[out] = c0+cs/cw; w[out] = cw; ++out;
+             m.resize(out);
+             w.resize(out);
+        }
+
+        // Sorted union of the centroids a and the unit-weight values v (sorted).
+        void merge_sorted(const std::vector<double> & am,
+                          const std::vector<double> & aw,
+                          const std::vector<double> & bm,
+                          const std::vector<double> & bw,
+                          std::vector<double> & m,
+                          std::vector<double> & w)
+        {
+             const std::size_t na{am.size()},nb{bm.size()};
+             m.resize(na+nb);
+             w.resize(na+nb);
+             std::size_t __i{0},__j{0},__k{0};
+             while(__i != na && __j != nb)
+             {
+                  if(bm[__j] < am[__i]) { m[__k] = bm[__j]; w[__k] = bw.empty() ? 1.0 : bw[__j]; ++__j; }
+                  else                  { m[__k] = am[__i]; w[__k] = aw[__i]; ++__i; }
+                  ++__k;
+             }
+             for(; __i != na; ++__i, ++__k) { m[__k] = am[__i]; w[__k] = aw[__i]; }
+             for(; __j != nb; ++__j, ++__k) { m[__k] = bm[__j]; w[__k] = bw.empty() ? 1.0 : bw[__j]; }
+        }
+
+        template<typename T>
+        void tdigest_add(gms::stat::tdigest_t & t,
+                         const T * __restrict x,
+                         const std::size_t n)
+        {
+             const std::size_t cap{std::max<std::size_t>(static_cast<std::size_t>(STREAM_TDIGEST_BUFFER_FACTOR*t.delta),1ULL)};
+             double lo{(t.n == 0ULL) ? std::numeric_limits<double>::infinity()  : t.min};
+             double hi{(t.n == 0ULL) ? -std::numeric_limits<double>::infinity() : t.max};
+             uint64_t added{0};
+             for(std::size_t __i{0}; __i != n; ++__i)
+             {
+                  const double v{static_cast<double>(x[__i])};
+                  // NaN and +-inf are not ranked
+                  if(!std::isfinite(v)) continue;
+                  t.buf.push_back(v);
+                  lo = std::min(lo,v);
+                  hi = std::max(hi,v);
+                  ++added;
+                  if(t.buf.size() >= cap)
+                  {
+                       t.n  += added;
+                       added = 0ULL;
+                       t.min = lo;
+                       t.max = hi;
+                       t.flush();
+                  }
+             }
+             if(added != 0ULL)
+             {
+                  t.n  += added;
+                  t.min = lo;
+                  t.max = hi;
+             }
+        }
+
+        template<typename T>
+        void summary_add(gms::stat::stream_summary_t & s,
+                         const T * __restrict x,
+                         const std::size_t n)
+        {
+             for(std::size_t __i{0}; __i < n; __i += STREAM_STATS_CHUNK)
+             {
+                  const std::size_t m{std::min<std::size_t>(STREAM_STATS_CHUNK,n-__i)};
+                  moments_add(s.mom,x+__i,m);
+                  s.dig.add(x+__i,m);
+                  hist_add(s.hist,x+__i,m);
+             }
+        }
+
+        template<typename T>
+        void stats_par(const T * __restrict x,
+                       const std::size_t n,
+                       gms::stat::stream_summary_t & s)
+        {
+             using namespace gms::common;
+             const int32_t nw{par_team_size()};
+             std::vector<gms::stat::stream_summary_t> part(static_cast<std::size_t>(std::max(nw,1)),
+                                                         gms::stat::stream_summary_t(s.dig.delta,s.hist.lo,s.hist.hi,s.hist.nbins));
+             par_region(par_family::ARITH,n,[&](const par_ctx_t & c) {
+                  c.for_static(n,sizeof(T),static_cast<int32_t>(VW),[&](const std::size_t lo,const std::size_t hi) {
+                       part[static_cast<std::size_t>(c.id())].add(x+lo,hi-lo);
+                  });
+             });
+             for(auto & p : part) (void)s.merge(p);
+        }
+
+}
+
+void
+gms::stat::stream_moments_t::add(const double * __restrict x,
+                                 const std::size_t n)
+{
+     moments_add(*this,x,n);
+}
+
+void
+gms::stat::stream_moments_t::add(const float * __restrict x,
+                                 const std::size_t n)
+{
+     moments_add(*this,x,n);
+}
+
+void
+gms::stat::stream_moments_t::merge(const stream_moments_t & b)
+{
+     nonfinite += b.nonfinite;
+     if(b.n == 0ULL) return;
+     if(n == 0ULL)
+     {
+        const uint64_t nf{nonfinite};
+        *this = b;
+        nonfinite = nf;
+        return;
+     }
+     const double na{static_cast<double>(n)},nb{static_cast<double>(b.n)};
+     const double nn{na+nb};
+     const double d{b.mean-mean};
+     const double dn{d/nn};
+     const double dn2{dn*dn};
+     const double t{d*dn*na*nb};        // d^2*na*nb/n
+     M4 += b.M4+t*dn2*(na*na-na*nb+nb*nb)+6.0*dn2*(na*na*b.M2+nb*nb*M2)+4.0*dn*(na*b.M3-nb*M3);
+     M3 += b.M3+t*dn*(na-nb)+3.0*dn*(na*b.M2-nb*M2);
+     M2 += b.M2+t;
+     mean += dn*nb;
+     n   += b.n;
+     min  = std::min(min,b.min);
+     max  = std::max(max,b.max);
+}
+
+void
+gms::stat::stream_hist_t::init(const double a,
+                               const double b,
+                               const int32_t nb)
+{
+     lo    = a;
+     hi    = b;
+     nbins = (b > a) ? std::max(nb,0) : 0;
+     cnt.assign((nbins > 0) ? static_cast<std::size_t>(nbins)+2ULL : 0ULL,0ULL);
+}
+
+void
+gms::stat::stream_hist_t::add(const double * __restrict x,
+                              const std::size_t n)
+{
+     hist_add(*this,x,n);
+}
+
+void
+gms::stat::stream_hist_t::add(const float * __restrict x,
+                              const std::size_t n)
+{
+     hist_add(*this,x,n);
+}
+
+bool
+gms::stat::stream_hist_t::merge(const stream_hist_t & b)
+{
+     if(b.nbins != nbins || b.lo != lo || b.hi != hi) return (false);
+     for(std::size_t __i{0}; __i != cnt.size(); ++__i) cnt[__i] += b.cnt[__i];
+     return (true);
+}
+
+void
+gms::stat::tdigest_t::init(const double d)
+{
+     delta = std::max(d,10.0);
+     n     = 0ULL;
+     min   = 0.0;
+     max   = 0.0;
+     mean.clear();
+     weight.clear();
+     buf.clear();
+     buf.reserve(static_cast<std::size_t>(STREAM_TDIGEST_BUFFER_FACTOR*delta));
+}
+
+void
+gms::stat::tdigest_t::add(const double * __restrict x,
+                          const std::size_t n)
+{
+     tdigest_add(*this,x,n);
+}
+
+void
+gms::stat::tdigest_t::add(const float * __restrict x,
+                          const std::size_t n)
+{
+     tdigest_add(*this,x,n);
+}
+
+void
+gms::stat::tdigest_t::flush()
+{
+     if(buf.empty()) return;
+     radix_sort(buf);
+     std::vector<double> m,w;
+     merge_sorted(mean,weight,buf,std::vector<double>(),m,w);
+     buf.clear();
+     compress(m,w,static_cast<double>(n),delta);
+     mean.swap(m);
+     weight.swap(w);
+}
+
+bool
+gms::stat::tdigest_t::merge(const tdigest_t & b)
+{
+     if(b.delta != delta) return (false);
+     if(b.n == 0ULL) return (true);
+     min = (n == 0ULL) ? b.min : std::min(min,b.min);
+     max = (n == 0ULL) ? b.max : std::max(max,b.max);
+     n  += b.n;
+     buf.insert(buf.end(),b.buf.begin(),b.buf.end());
+     radix_sort(buf);
+     std::vector<double> m,w,m2,w2;
+     merge_sorted(mean,weight,b.mean,b.weight,m,w);
+     merge_sorted(m,w,buf,std::vector<double>(),m2,w2);
+     buf.clear();
+     compress(m2,w2,static_cast<double>(n),delta);
+     mean.swap(m2);
+     weight.swap(w2);
+     return (true);
+}
+
+double
+gms::stat::tdigest_t::quantile(const double q) const
+{
+     if(n == 0ULL) return (std::numeric_limits<double>::quiet_NaN());
+     const double tw{static_cast<double>(n)};
+     const double r{std::min(std::max(q,0.0),1.0)*tw};
+     // knots (rank,x): (0,min), (centres,means), (n,max)
+     double r0{0.0},x0{min},wsum{0.0};
+     for(std::size_t __i{0}; __i != mean.size(); ++__i)
+     {
+          const double r1{wsum+0.5*weight[__i]};
+          if(r <= r1)
+             return ((r1 > r0) ? x0+(mean[__i]-x0)*(r-r0)/(r1-r0) : mean[__i]);
+          r0 = r1;
+          x0 = mean[__i];
+          wsum += weight[__i];
+     }
+     return ((tw > r0) ? x0+(max-x0)*(r-r0)/(tw-r0) : max);
+}
+
+double
+gms::stat::tdigest_t::cdf(const double x) const
+{
+     if(n == 0ULL) return (std::numeric_limits<double>::quiet_NaN());
+     if(x < min)   return (0.0);
+     if(x >= max)  return (1.0);
+     const double tw{static_cast<double>(n)};
+     double r0{0.0},x0{min},wsum{0.0};
+     for(std::size_t __i{0}; __i != mean.size(); ++__i)
+     {
+          const double r1{wsum+0.5*weight[__i]};
+          if(x < mean[__i])
+             return ((r0+(r1-r0)*(x-x0)/(mean[__i]-x0))/tw);
+          r0 = r1;
+          x0 = mean[__i];
+          wsum += weight[__i];
+     }
+     return ((r0+(tw-r0)*(x-x0)/(max-x0))/tw);
+}
+
+double
+gms::stat::tdigest_t::trimmed_mean(const double q0,
+                                   const double q1) const
+{
+     if(n == 0ULL || !(q1 > q0)) return (std::numeric_limits<double>::quiet_NaN());
+     const double tw{static_cast<double>(n)};
+     const double ra{std::max(q0,0.0)*tw},rb{std::min(q1,1.0)*tw};
+     // integral of the piecewise linear quantile function over [ra,rb]
+     double acc{0.0};
+     auto seg = [&](const double r0,const double x0,const double r1,const double x1) {
+          const double a{std::max(r0,ra)},b{std::min(r1,rb)};
+          if(b <= a) return;
+          const double s{(x1-x0)/(r1-r0)};
+          acc += (b-a)*(x0+s*(0.5*(a+b)-r0));
+     };
+     double r0{0.0},x0{min},wsum{0.0};
+     for(std::size_t __i{0}; __i != mean.size(); ++__i)
+     {
+          const double r1{wsum+0.5*weight[__i]};
+          seg(r0,x0,r1,mean[__i]);
+          r0 = r1;
+          x0 = mean[__i];
+          wsum += weight[__i];
+     }
+     seg(r0,x0,tw,max);
+     return (acc/(rb-ra));
+}
+
+gms::stat::stream_summary_t::stream_summary_t(const double compression,
+                                              const double lo,
+                                              const double hi,
+                                              const int32_t nbins)
+{
+     dig.init(compression);
+     hist.init(lo,hi,nbins);
+}
+
+void
+gms::stat::stream_summary_t::add(const double * __restrict x,
+                                 const std::size_t n)
+{
+     summary_add(*this,x,n);
+}
+
+void
+gms::stat::stream_summary_t::add(const float * __restrict x,
+                                 const std::size_t n)
+{
+     summary_add(*this,x,n);
+}
+
+bool
+gms::stat::stream_summary_t::merge(const stream_summary_t & b)
+{
+     if(b.dig.delta != dig.delta ||
+        b.hist.nbins != hist.nbins || b.hist.lo != hist.lo || b.hist.hi != hist.hi) return (false);
+     mom.merge(b.mom);
+     (void)dig.merge(b.dig);
+     (void)hist.merge(b.hist);
+     return (true);
+}
+
+gms::stat::stream_stats_t
+gms::stat::stream_summary_t::stats()
+{
+     dig.flush();
+     stream_stats_t s;
+     const double dn{static_cast<double>(mom.n)};
+     s.n     = mom.n;
+     s.nonfinite = mom.nonfinite;
+     s.mean  = mom.mean;
+     s.var   = (mom.n > 1ULL) ? mom.M2/(dn-1.0) : 0.0;
+     s.sd    = std::sqrt(s.var);
+     s.relsd = std::abs(100.0*s.sd/s.mean);
+     s.skew  = (mom.M2 > 0.0) ? std::sqrt(dn)*mom.M3/(mom.M2*std::sqrt(mom.M2)) : 0.0;
+     s.kurt  = (mom.M2 > 0.0) ? dn*mom.M4/(mom.M2*mom.M2) : 0.0;
+     s.min   = mom.min;
+     s.max   = mom.max;
+     s.range = mom.max-mom.min;
+     s.mid   = 0.5*(mom.min+mom.max);
+     s.midm  = dig.trimmed_mean(0.25,0.75);
+     s.med   = dig.quantile(0.5);
+     return (s);
+}
+
+namespace {
+
+        constexpr uint32_t STREAM_STATS_MAGIC   = 0x53545347U;  // "GSTS"
+        // 2: the count of non-finite values in the former reserved slot (0 in a version 1 buffer)
+        constexpr uint32_t STREAM_STATS_VERSION = 2U;
+
+        // fixed part: magic, version, 3 counts, 6 moments, 3 digest doubles, non-finite count, 2 histogram doubles, nbins+pad
+        constexpr std::size_t STREAM_STATS_HDR = 2ULL*4ULL+3ULL*8ULL+6ULL*8ULL+4ULL*8ULL+2ULL*8ULL+2ULL*4ULL;
+
+        template<typename T>
+        inline void put(unsigned char * __restrict & p,const T v)
+        {
+             std::memcpy(p,&v,sizeof(T));
+             p += sizeof(T);
+        }
+
+        template<typename T>
+        inline T get(const unsigned char * __restrict & p)
+        {
+             T v;
+             std::memcpy(&v,p,sizeof(T));
+             p += sizeof(T);
+             return (v);
+        }
+
+}
+
+std::size_t
+gms::stat::stream_summary_t::serialized_size()
+{
+     dig.flush();
+     return (STREAM_STATS_HDR+16ULL*dig.mean.size()+8ULL*hist.cnt.size());
+}
+
+std::size_t
+gms::stat::stream_summary_t::serialize(unsigned char * __restrict buf)
+{
+     dig.flush();
+     unsigned char * __restrict p{buf};
+     put<uint32_t>(p,STREAM_STATS_MAGIC);
+     put<uint32_t>(p,STREAM_STATS_VERSION);
+     put<uint64_t>(p,mom.n);
+     put<uint64_t>(p,dig.n);
+     put<uint64_t>(p,static_cast<uint64_t>(dig.mean.size()));
+     put<double>(p,mom.mean);
+     put<double>(p,mom.M2);
+     put<double>(p,mom.M3);
+     put<double>(p,mom.M4);
+     put<double>(p,mom.min);
+     put<double>(p,mom.max);
+     put<double>(p,dig.delta);
+     put<double>(p,dig.min);
+     put<double>(p,dig.max);
+     put<uint64_t>(p,mom.nonfinite);
+     put<double>(p,hist.lo);
+     put<double>(p,hist.hi);
+     put<int32_t>(p,hist.nbins);
+     put<int32_t>(p,0);
+     for(std::size_t __i{0}; __i != dig.mean.size(); ++__i) put<double>(p,dig.mean[__i]);
+     for(std::size_t __i{0}; __i != dig.mean.size(); ++__i) put<double>(p,dig.weight[__i]);
+     for(std::size_t __i{0}; __i != hist.cnt.size(); ++__i) put<uint64_t>(p,hist.cnt[__i]);
+     return (static_cast<std::size_t>(p-buf));
+}
+
+bool
+gms::stat::stream_summary_t::deserialize(const unsigned char * __restrict buf,
+                                         const std::size_t len)
+{
+     if(len < STREAM_STATS_HDR) return (false);
+     const unsigned char * __restrict p{buf};
+     if(get<uint32_t>(p) != STREAM_STATS_MAGIC) return (false);
+     const uint32_t ver{get<uint32_t>(p)};
+     if(ver != 1U && ver != STREAM_STATS_VERSION) return (false);
+     stream_summary_t s;
+     s.mom.n = get<uint64_t>(p);
+     const uint64_t dn{get<uint64_t>(p)};
+     const uint64_t nc{get<uint64_t>(p)};
+     s.mom.mean = get<double>(p);
+     s.mom.M2   = get<double>(p);
+     s.mom.M3   = get<double>(p);
+     s.mom.M4   = get<double>(p);
+     s.mom.min  = get<double>(p);
+     s.mom.max  = get<double>(p);
+     const double d{get<double>(p)};
+     const double dmin{get<double>(p)};
+     const double dmax{get<double>(p)};
+     s.mom.nonfinite = get<uint64_t>(p);
+     const double lo{get<double>(p)};
+     const double hi{get<double>(p)};
+     const int32_t nb{get<int32_t>(p)};
+     (void)get<int32_t>(p);
+     if(nb < 0 || !(d >= 10.0) || nc > (len-STREAM_STATS_HDR)/16ULL) return (false);
+     const std::size_t nh{(nb > 0) ? static_cast<std::size_t>(nb)+2ULL : 0ULL};
+     if(len != STREAM_STATS_HDR+16ULL*nc+8ULL*nh) return (false);
+     s.dig.init(d);
+     s.dig.n   = dn;
+     s.dig.min = dmin;
+     s.dig.max = dmax;
+     s.hist.init(lo,hi,nb);
+     s.dig.mean.resize(nc);
+     s.dig.weight.resize(nc);
+     for(std::size_t __i{0}; __i != nc; ++__i) s.dig.mean[__i]   = get<double>(p);
+     for(std::size_t __i{0}; __i != nc; ++__i) s.dig.weight[__i] = get<double>(p);
+     for(std::size_t __i{0}; __i != nh; ++__i) s.hist.cnt[__i]   = get<uint64_t>(p);
+     *this = std::move(s);
+     return (true);
+}
+
+void
+gms::stat::stream_stats_par(const float * __restrict x,
+                            const std::size_t n,
+                            stream_summary_t & s)
+{
+     stats_par(x,n,s);
+}
+
+void
+gms::stat::stream_stats_par(const double * __restrict x,
+                            const std::size_t n,
+                            stream_summary_t & s)
+{
+     stats_par(x,n,s);
+}
@@ -0,0 +1,244 @@
+
+#ifndef __GMS_STREAM_STATS_H__
+#define __GMS_STREAM_STATS_H__ 241020261430
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_STREAM_STATS_MAJOR = 1U;
+    const unsigned int GMS_STREAM_STATS_MINOR = 0U;
+    const unsigned int GMS_STREAM_STATS_MICRO = 0U;
+    const unsigned int GMS_STREAM_STATS_FULLVER =
+      1000U*GMS_STREAM_STATS_MAJOR+100U*GMS_STREAM_STATS_MINOR+10U*GMS_STREAM_STATS_MICRO;
+    const char * const GMS_STREAM_STATS_CREATION_DATE = "24-10-2026 14:30 PM +00200 (SAT 24 OCT 2026 GMT+2)";
+    const char * const GMS_STREAM_STATS_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_STREAM_STATS_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_STREAM_STATS_DESCRIPTION   = "One-pass mergeable descriptive statistics: moments, t-digest quantiles, histogram.";
+
+}
+
+/*
+     One-pass counterparts of relsd, var, skewness_kurtosis, loc and scale
+     (GMS_descriptive_statistics.hpp) for samples which are too many to be
+     stored and sorted (Monte Carlo outputs, PMC counts): the data is read
+     once in chunks of STREAM_STATS_CHUNK elements, every chunk (in L1) feeds
+         moments   -- two passes over the chunk (AVX-512 or AVX2+FMA, double
+                      accumulators, float or double data): sum, min, max, then
+                      the central sums of order 2..4 about the chunk mean,
+                      merged into the running M2..M4 by the pairwise update of
+                      Chan et al. / Pebay (exact up to rounding, no cancellation
+                      of the naive sum of powers),
+         t-digest  -- merging digest (Dunning), scale function k1, compression
+                      delta: at most delta centroids, a centroid at the rank q
+                      holds at most pi/delta*sqrt(q(1-q)) of the samples (the
+                      rank error of the quantile q, smaller at the tails); the
+                      buffered values are radix sorted and merged into the
+                      centroids,
+         histogram -- fixed bins over [lo,hi), underflow and overflow (NaN go
+                      to the underflow, -inf and +inf to the underflow and the
+                      overflow), bin indices computed in SIMD.
+     Non-finite values (NaN, -inf, +inf) are not accumulated in the moments
+     (counted in stream_moments_t::nonfinite instead, n counts the finite
+     values only) and are not ranked by the digest.
+     Summaries of the same compression and binning merge (threads; processes
+     through serialize/deserialize to a flat byte buffer): the moments and the
+     counts exactly, the union of the centroids of both digests is
+     re-compressed (within the same rank error).
+     stream_stats_par splits an array over the workers of GMS_par_team and
+     merges the per-worker summaries in the worker order (deterministic for
+     a given team size).
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "GMS_config.h"
+
+// Elements per chunk of stream_summary_t::add (the chunk stays in L1 between the passes).
+#if !defined(STREAM_STATS_CHUNK)
+#define STREAM_STATS_CHUNK 2048
+#endif
+
+// Values buffered by the t-digest before a merge, in multiples of the compression.
+#if !defined(STREAM_TDIGEST_BUFFER_FACTOR)
+#define STREAM_TDIGEST_BUFFER_FACTOR 10
+#endif
+
+namespace gms {
+
+        namespace stat {
+
+                  struct stream_moments_t
+                  {
+                         uint64_t n    = 0ULL;    // finite values
+                         uint64_t nonfinite = 0ULL;  // NaN, -inf, +inf (not in the moments)
+                         double   mean = 0.0;
+                         double   M2   = 0.0;    // sum (x-mean)^k
+                         double   M3   = 0.0;
+                         double   M4   = 0.0;
+                         double   min  = 0.0;
+                         double   max  = 0.0;
+
+                         void add(const double * __restrict,
+                                  const std::size_t);
+
+                         void add(const float * __restrict,
+                                  const std::size_t);
+
+                         // Chan/Pebay pairwise combination.
+                         void merge(const stream_moments_t &);
+                  };
+
+                  struct stream_hist_t
+                  {
+                         double  lo    = 0.0;
+                         double  hi    = 1.0;
+                         int32_t nbins = 0;
+                         std::vector<uint64_t> cnt;  // [0] underflow, [1..nbins] bins, [nbins+1] overflow
+
+                         void init(const double,
+                                   const double,
+                                   const int32_t);
+
+                         void add(const double * __restrict,
+                                  const std::size_t);
+
+                         void add(const float * __restrict,
+                                  const std::size_t);
+
+                         // false (nothing merged) when the binning differs
+                         bool merge(const stream_hist_t &);
+
+                         inline uint64_t bin(const int32_t i)  const { return (cnt[static_cast<std::size_t>(i)+1ULL]); }
+                         inline uint64_t underflow()            const { return (cnt.empty() ? 0ULL : cnt[0]); }
+                         inline uint64_t overflow()             const { return (cnt.empty() ? 0ULL : cnt.back()); }
+                  };
+
+                  struct tdigest_t
+                  {
+                         double   delta = 200.0;
+                         uint64_t n     = 0ULL;
+                         double   min   = 0.0;
+                         double   max   = 0.0;
+                         std::vector<double> mean;    // centroids, ascending
+                         std::vector<double> weight;
+                         std::vector<double> buf;     // values not yet merged
+
+                         void init(const double);
+
+                         void add(const double * __restrict,
+                                  const std::size_t);
+
+                         void add(const float * __restrict,
+                                  const std::size_t);
+
+                         // false (nothing merged) when the compression differs
+                         bool merge(const tdigest_t &);
+
+                         // merges the buffer into the centroids
+                         void flush();
+
+                         /*
+                             Of the flushed digest: the quantile function is piecewise
+                             linear through (rank 0, min), (rank of the centre of every
+                             centroid, its mean), (rank n, max); NaN when empty.
+                         */
+                         double quantile(const double) const;
+
+                         double cdf(const double) const;
+
+                         // mean of the values between the quantiles q0 < q1
+                         double trimmed_mean(const double,
+                                             const double) const;
+
+                         inline std::size_t centroids() const { return (mean.size()); }
+                  };
+
+                  // The estimators of relsd, var, skewness_kurtosis, loc and scale.
+                  struct stream_stats_t
+                  {
+                         uint64_t n;
+                         uint64_t nonfinite;  // NaN, -inf, +inf, not in n
+                         double   mean;
+                         double   var;        // divisor n-1
+                         double   sd;
+                         double   relsd;      // 100*sd/|mean|
+                         double   skew;
+                         double   kurt;       // n*M4/M2^2 (SKEKUR, not the excess)
+                         double   min;
+                         double   max;
+                         double   range;
+                         double   mid;        // (min+max)/2
+                         double   midm;       // midmean, mean of the quartiles 1..3 (t-digest)
+                         double   med;        // median (t-digest)
+                  };
+
+                  struct stream_summary_t
+                  {
+                         stream_moments_t mom;
+                         tdigest_t        dig;
+                         stream_hist_t    hist;
+
+                         // nbins == 0 (or hi <= lo) -- no histogram
+                         stream_summary_t(const double compression = 200.0,
+                                          const double lo = 0.0,
+                                          const double hi = 1.0,
+                                          const int32_t nbins = 0);
+
+                         void add(const double * __restrict,
+                                  const std::size_t);
+
+                         void add(const float * __restrict,
+                                  const std::size_t);
+
+                         // false (nothing merged) when the compression or the binning differ
+                         bool merge(const stream_summary_t &);
+
+                         // flushes the digest
+                         stream_stats_t stats();
+
+                         inline double quantile(const double q) { dig.flush(); return (dig.quantile(q)); }
+
+                         // both flush the digest
+                         std::size_t serialized_size();
+
+                         // native byte order, returns the bytes written
+                         std::size_t serialize(unsigned char * __restrict);
+
+                         // false on a malformed buffer (the summary is unchanged)
+                         bool deserialize(const unsigned char * __restrict,
+                                          const std::size_t);
+                  };
+
+                  // The summary of x[0..n) on the worker team (merged into s).
+                  void stream_stats_par(const float * __restrict,
+                                        const std::size_t,
+                                        stream_summary_t &);
+
+                  void stream_stats_par(const double * __restrict,
+                                        const std::size_t,
+                                        stream_summary_t &);
+
+        } // stat
+
+} // gms
+
+#endif /*__GMS_STREAM_STATS_H__*/
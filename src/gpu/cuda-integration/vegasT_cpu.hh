@@ -0,0 +1,704 @@
+#ifndef VEGAS_VEGAS_T_CPU_HH
+#define VEGAS_VEGAS_T_CPU_HH
+
+/*
+
+CPU (OpenMP + SIMD) backend of the m-Cubes VEGAS integrator in vegasT.cuh,
+for hosts without a GPU. Same integrand interface (a functor with
+operator()(double, ..., double) of NDIM arguments), same grid, sampling,
+rebinning and stopping rules, same integration_result.
+
+g++ -O3 -march=native -fopenmp -ffast-math -I. my_integral.cpp
+(-ffast-math lets the glibc vector math library vectorize exp/sin/pow calls of
+the integrand)
+
+Work layout per iteration:
+
+  - the ncubes sub-cubes are split into a fixed number of contiguous slots
+    (nslots, independent of the number of threads), the slots are
+    distributed over the OpenMP team,
+  - a slot is walked in batches of up to batch_size samples: the random
+    numbers are drawn per cube (the generator is reseeded with the cube
+    index, as the GPU kernels do), the grid map x = regn + rc * dx and the
+    Jacobian are evaluated dimension by dimension over the whole batch
+    (omp simd, branch free, xi[0] = 0), then the integrand is evaluated on
+    the batch (omp simd over the scalar operator(), or the integrand's own
+    eval_batch member when it has one, see below),
+  - every slot accumulates fb, f2b and the bin contributions d into its own
+    storage; after the sampling the slots are merged bin by bin in slot order
+    (omp for over the bins, no atomics, no locks).
+
+The summation order therefore depends only on ncall, ndim and nslots, the
+results are bitwise reproducible for a given seed whatever the number of
+threads. With cpu_mcubes::Custom_generator the sampled points are the ones
+the GPU kernels use with ::Custom_generator, so the demos results are
+reproduced up to the order of the floating point sums.
+
+Optional batched integrand member (checked at compile time):
+
+  void eval_batch(double const* const* x, int n, double* f);
+
+  x[d][s] is coordinate d of sample s, s = 0..n-1 (n <= batch_size), the
+  values go to f[s].
+
+*/
+
+#if !defined(__CUDACC__)
+#ifndef __host__
+#define __host__
+#endif
+#ifndef __device__
+#define __device__
+#endif
+#endif
+
+#include "Volume.cuh"
+#include "integration_result.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <omp.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpu_mcubes {
+
+  // The GPU ::Custom_generator: x_k+1 = (a * x_k + c) mod 2^31 in 32 bit
+  // arithmetic, reseeded with the cube index, the iteration seed is ignored.
+  class Custom_generator {
+    uint32_t custom_seed = 0;
+
+  public:
+    explicit Custom_generator(uint32_t) {}
+
+    double
+    operator()()
+    {
+      const uint32_t a = 1103515245;
+      const uint32_t c = 12345;
+      const uint32_t p = uint32_t(1) << 31;
+      custom_seed = (a * custom_seed + c) & (p - 1);
+      return static_cast<double>(custom_seed) / static_cast<double>(p);
+    }
+
+    void
+    SetSeed(uint32_t seed)
+    {
+      custom_seed = seed;
+    }
+  };
+
+  // Counter based splitmix64 stream keyed by (iteration seed, cube index),
+  // uniform in (0, 1], the CPU stand-in of the curand default: every
+  // iteration draws new points.
+  class Counter_generator {
+    uint64_t key = 0;
+    uint64_t state = 0;
+
+  public:
+    explicit Counter_generator(uint32_t seed)
+      : key(0x9E3779B97F4A7C15ULL * (uint64_t(seed) + 1))
+    {}
+
+    double
+    operator()()
+    {
+      uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      z ^= z >> 31;
+      return (static_cast<double>(z >> 11) + 1.0) * 0x1.0p-53;
+    }
+
+    void
+    SetSeed(uint32_t cube)
+    {
+      state = key ^ (0xD1B54A32D192ED03ULL * (uint64_t(cube) + 1));
+    }
+  };
+
+  class Cpu_Vegas_Params {
+    static constexpr int ndmx = 500;
+    static constexpr int mxdim = 20;
+    static constexpr double alph = 1.5;
+    static constexpr double tiny = 1.0e-30;
+    static constexpr int nslots = 256;
+    static constexpr int batch_size = 256;
+
+  public:
+    static constexpr int
+    get_NDMX()
+    {
+      return ndmx;
+    }
+
+    static constexpr int
+    get_NDMX_p1()
+    {
+      return ndmx + 1;
+    }
+
+    static constexpr int
+    get_MXDIM()
+    {
+      return mxdim;
+    }
+
+    static constexpr double
+    get_ALPH()
+    {
+      return alph;
+    }
+
+    static constexpr double
+    get_TINY()
+    {
+      return tiny;
+    }
+
+    static constexpr int
+    get_NSLOTS()
+    {
+      return nslots;
+    }
+
+    static constexpr int
+    get_BATCH_SIZE()
+    {
+      return batch_size;
+    }
+  };
+
+  namespace detail {
+
+    template <typename IntegT, typename = void>
+    struct has_eval_batch : std::false_type {};
+
+    template <typename IntegT>
+    struct has_eval_batch<
+      IntegT,
+      std::void_t<decltype(std::declval<IntegT&>().eval_batch(
+        std::declval<double const* const*>(),
+        int(),
+        std::declval<double*>()))>> : std::true_type {};
+
+    template <typename IntegT, std::size_t... I>
+    inline void
+    eval_scalar(IntegT& f,
+                double const* const* x,
+                int n,
+                double* fv,
+                std::index_sequence<I...>)
+    {
+#pragma omp simd
+      for (int s = 0; s < n; s++)
+        fv[s] = f(x[I][s]...);
+    }
+
+    template <typename IntegT, int ndim>
+    inline void
+    eval_batch(IntegT& f, double const* const* x, int n, double* fv)
+    {
+      if constexpr (has_eval_batch<IntegT>::value)
+        f.eval_batch(x, n, fv);
+      else
+        eval_scalar(f, x, n, fv, std::make_index_sequence<ndim>());
+    }
+
+    // 1-based bin indices of cube m, last dimension fastest (get_indx of the
+    // GPU code)
+    inline void
+    get_indx(std::size_t m, int* kg, int ndim, int ng)
+    {
+      std::size_t dp = 1;
+      for (int j = 1; j < ndim; j++)
+        dp *= ng;
+      for (int j = 0; j < ndim; j++) {
+        const std::size_t t1 = m / dp;
+        kg[j] = 1 + static_cast<int>(t1);
+        m -= t1 * dp;
+        dp /= (ng > 0 ? ng : 1);
+      }
+    }
+
+    inline void
+    rebin(double rc, int nd, double r[], double xin[], double xi[])
+    {
+      int i, k = 0;
+      double dr = 0.0, xn = 0.0, xo = 0.0;
+
+      for (i = 1; i < nd; i++) {
+        while (rc > dr) {
+          dr += r[++k];
+        }
+        if (k > 1)
+          xo = xi[k - 1];
+        xn = xi[k];
+        dr -= rc;
+
+        xin[i] = xn - (xn - xo) * dr / r[k];
+      }
+
+      for (i = 1; i < nd; i++)
+        xi[i] = xin[i];
+      xi[nd] = 1.0;
+    }
+
+    inline int
+    GetStatus(double estimate,
+              double errorest,
+              int iteration,
+              double epsrel,
+              double epsabs)
+    {
+      const bool done =
+        std::abs(errorest / estimate) <= epsrel || errorest <= epsabs;
+      return (done && iteration >= 5) ? 0 : 1;
+    }
+
+    inline bool
+    AdjustParams(double& ncall, int& totalIters)
+    {
+      if (ncall >= 8.e9 && totalIters >= 100)
+        return false;
+      else if (ncall >= 8.e9)
+        totalIters += 10;
+      else if (ncall >= 1.e9)
+        ncall += 1.e9;
+      else
+        ncall *= 10.;
+      return true;
+    }
+
+    // One sampling pass over all cubes. Returns the sum of f and of the per
+    // cube variances; with ADJUST the squared contributions are binned into
+    // d[i * ndim + (j - 1)], i = 1..nd (bin), j = 1..ndim.
+    template <typename IntegT, int ndim, bool ADJUST, typename GeneratorType>
+    void
+    sample_pass(IntegT const& integrand,
+                std::size_t ncubes,
+                int ng,
+                int npg,
+                int nslots,
+                unsigned int seed_init,
+                double xjac,
+                double dxg,
+                double xnd,
+                const double* regn,
+                const double* dx,
+                const double* xi,
+                std::vector<double>& slot_d,
+                std::vector<double>& slot_fb,
+                double* d,
+                double& fbg,
+                double& f2bg)
+    {
+      const int nbins = Cpu_Vegas_Params::get_NDMX_p1() * ndim;
+
+#pragma omp parallel default(none)                                             \
+  shared(integrand, ncubes, ng, npg, nslots, seed_init, xjac, dxg, xnd, regn, \
+           dx, xi, slot_d, slot_fb, d, nbins)
+      {
+        constexpr int ndmx = Cpu_Vegas_Params::get_NDMX();
+        constexpr int ndmx_p1 = Cpu_Vegas_Params::get_NDMX_p1();
+        constexpr int B = Cpu_Vegas_Params::get_BATCH_SIZE();
+        constexpr double tiny = Cpu_Vegas_Params::get_TINY();
+        IntegT f = integrand; // operator() need not be const
+        GeneratorType rng(seed_init);
+        std::vector<double> xs(ndim * B), ran(ndim * B), wgt(B), fv(B);
+        std::vector<int> kgs(ndim * B), ia(ndim * B), kg(ndim);
+        std::vector<double> cfb(B), cf2b(B);
+        double* xp[ndim];
+        for (int j = 0; j < ndim; j++)
+          xp[j] = &xs[j * B];
+        // cubes per group: all their samples go through the batch buffers
+        // together, a cube with more than B samples is a group on its own
+        const int G = std::max(1, B / npg);
+
+#pragma omp for schedule(dynamic, 1)
+        for (int s = 0; s < nslots; s++) {
+          const std::size_t c0 = ncubes * s / nslots;
+          const std::size_t c1 = ncubes * (s + 1) / nslots;
+          double* dl = ADJUST ? &slot_d[static_cast<std::size_t>(s) * nbins] :
+                                nullptr;
+          double sfb = 0.0, sf2b = 0.0;
+          if (ADJUST)
+            std::fill(dl, dl + nbins, 0.0);
+          get_indx(c0, kg.data(), ndim, ng);
+
+          for (std::size_t cg = c0; cg < c1; cg += G) {
+            const int ng_cubes = static_cast<int>(
+              std::min<std::size_t>(static_cast<std::size_t>(G), c1 - cg));
+            const std::size_t nsmp =
+              static_cast<std::size_t>(ng_cubes) * static_cast<std::size_t>(npg);
+            std::fill(cfb.begin(), cfb.begin() + ng_cubes, 0.0);
+            std::fill(cf2b.begin(), cf2b.begin() + ng_cubes, 0.0);
+
+            for (std::size_t s0 = 0; s0 < nsmp; s0 += B) {
+              const int n = static_cast<int>(std::min<std::size_t>(B, nsmp - s0));
+              // random numbers in the GPU order: cube, sample, dimension
+              for (int b = 0; b < n; b++) {
+                const std::size_t smp = s0 + b;
+                if (smp % npg == 0) {
+                  if (smp != 0) {
+                    for (int k = ndim - 1; k >= 0; k--) {
+                      kg[k] %= ng;
+                      if (++kg[k] != 1)
+                        break;
+                    }
+                  }
+                  rng.SetSeed(static_cast<uint32_t>(cg + smp / npg));
+                }
+                for (int j = 0; j < ndim; j++) {
+                  ran[j * B + b] = rng();
+                  kgs[j * B + b] = kg[j];
+                }
+                wgt[b] = xjac;
+              }
+              // grid map and Jacobian, dimension by dimension
+              for (int j = 0; j < ndim; j++) {
+                const double* __restrict xij = &xi[(j + 1) * ndmx_p1];
+                const double* __restrict rj = &ran[j * B];
+                const int* __restrict kj = &kgs[j * B];
+                int* __restrict iaj = &ia[j * B];
+                double* __restrict xj = xp[j];
+                double* __restrict w = wgt.data();
+                const double lo = regn[j + 1], dxj = dx[j + 1];
+#pragma omp simd
+                for (int b = 0; b < n; b++) {
+                  const double xn = (kj[b] - rj[b]) * dxg + 1.0;
+                  const int ib = std::max(std::min(static_cast<int>(xn), ndmx), 1);
+                  const double xb = xij[ib - 1];
+                  const double xo = xij[ib] - xb;
+                  const double rc = xb + (xn - ib) * xo;
+                  iaj[b] = ib;
+                  xj[b] = lo + rc * dxj;
+                  w[b] *= xo * xnd;
+                }
+              }
+              eval_batch<IntegT, ndim>(f, xp, n, fv.data());
+              for (int b = 0; b < n; b++) {
+                const int g = static_cast<int>((s0 + b) / npg);
+                const double fw = wgt[b] * fv[b];
+                const double f2 = fw * fw;
+                cfb[g] += fw;
+                cf2b[g] += f2;
+                fv[b] = f2;
+              }
+              if (ADJUST) {
+                for (int j = 0; j < ndim; j++)
+                  for (int b = 0; b < n; b++)
+                    dl[ia[j * B + b] * ndim + j] += fv[b];
+              }
+            }
+
+            for (int g = 0; g < ng_cubes; g++) {
+              double f2b = std::sqrt(cf2b[g] * npg);
+              f2b = (f2b - cfb[g]) * (f2b + cfb[g]);
+              if (f2b <= 0.0)
+                f2b = tiny;
+              sfb += cfb[g];
+              sf2b += f2b;
+            }
+            // advance to the first cube of the next group
+            for (int k = ndim - 1; k >= 0; k--) {
+              kg[k] %= ng;
+              if (++kg[k] != 1)
+                break;
+            }
+          }
+          slot_fb[2 * s] = sfb;
+          slot_fb[2 * s + 1] = sf2b;
+        }
+
+        // lock free merge, each thread owns a range of bins, slots added in
+        // slot order
+        if (ADJUST) {
+#pragma omp for schedule(static)
+          for (int i = 0; i < nbins; i++) {
+            double acc = 0.0;
+            for (int s = 0; s < nslots; s++)
+              acc += slot_d[static_cast<std::size_t>(s) * nbins + i];
+            d[i] = acc;
+          }
+        }
+      }
+
+      fbg = f2bg = 0.0;
+      for (int s = 0; s < nslots; s++) {
+        fbg += slot_fb[2 * s];
+        f2bg += slot_fb[2 * s + 1];
+      }
+    }
+  }
+
+  template <typename IntegT,
+            int ndim,
+            bool DEBUG_MCUBES = false,
+            typename GeneratorType = Counter_generator>
+  void
+  vegas(IntegT const& integrand,
+        double epsrel,
+        double epsabs,
+        double ncall,
+        double* tgral,
+        double* sd,
+        double* chi2a,
+        int* status,
+        size_t* iters,
+        int titer,
+        int itmax,
+        int skip,
+        quad::Volume<double, ndim> const* vol,
+        unsigned int seed = 0,
+        int nslots = Cpu_Vegas_Params::get_NSLOTS())
+  {
+    static_assert(ndim >= 1 && ndim <= Cpu_Vegas_Params::get_MXDIM(),
+                  "1 <= ndim <= MXDIM");
+    constexpr int ndmx = Cpu_Vegas_Params::get_NDMX();
+    constexpr int ndmx_p1 = Cpu_Vegas_Params::get_NDMX_p1();
+    constexpr int mxdim_p1 = Cpu_Vegas_Params::get_MXDIM() + 1;
+
+    double regn[2 * mxdim_p1];
+    for (int j = 1; j <= ndim; j++) {
+      regn[j] = vol->lows[j - 1];
+      regn[j + ndim] = vol->highs[j - 1];
+    }
+
+    int i, it, j, nd, ndo, ng, npg;
+    double calls, dv2g, dxg, rc, ti, tsi, wgt, xjac, xn, xnd, xo;
+    double k, ncubes;
+    double schi, si, swgt;
+
+    // d[i * ndim + j - 1]: contribution of bin i of dimension j
+    std::vector<double> d(ndmx_p1 * ndim, 0.0), dt(mxdim_p1), dx(mxdim_p1),
+      r(ndmx_p1), xin(ndmx_p1);
+    // xi[j * ndmx_p1 + i]: right edge of bin i of dimension j, xi[..+0] = 0
+    std::vector<double> xi(mxdim_p1 * ndmx_p1, 0.0);
+
+    ndo = 1;
+    for (j = 1; j <= ndim; j++)
+      xi[j * ndmx_p1 + 1] = 1.0;
+
+    si = swgt = schi = 0.0;
+    nd = ndmx;
+    ng = (int)pow(ncall / 2.0 + 0.25, 1.0 / ndim);
+    for (k = 1, i = 1; i < ndim; i++)
+      k *= ng;
+    k *= ng;
+    ncubes = k;
+
+    npg = static_cast<int>(std::max(ncall / k, 2.0));
+    calls = (double)npg * (double)k;
+    dxg = 1.0 / ng;
+
+    for (dv2g = 1, i = 1; i <= ndim; i++)
+      dv2g *= dxg;
+    dv2g = (calls * dv2g * calls * dv2g) / npg / npg / (npg - 1.0);
+
+    xnd = nd;
+    dxg *= xnd;
+    xjac = 1.0 / calls;
+    for (j = 1; j <= ndim; j++) {
+      dx[j] = regn[j + ndim] - regn[j];
+      xjac *= dx[j];
+    }
+
+    for (i = 1; i <= std::max(nd, ndo); i++)
+      r[i] = 1.0;
+    for (j = 1; j <= ndim; j++)
+      detail::rebin(ndo / xnd, nd, r.data(), xin.data(), &xi[j * ndmx_p1]);
+    ndo = nd;
+
+    const std::size_t nc = static_cast<std::size_t>(ncubes);
+    nslots = static_cast<int>(
+      std::max<std::size_t>(1, std::min<std::size_t>(nslots, nc)));
+    std::vector<double> slot_d(static_cast<std::size_t>(nslots) * ndmx_p1 *
+                               ndim);
+    std::vector<double> slot_fb(2 * nslots);
+
+    // itmax iterations adjust the grid, the remaining ones up to titer only
+    // sample it
+    const int last = std::max(titer, itmax);
+    for (it = 1; it <= last && (*status); (*iters)++, it++) {
+      const bool adjust = (it <= itmax);
+      const unsigned int seed_it = seed + static_cast<unsigned int>(it);
+
+      if (adjust)
+        detail::sample_pass<IntegT, ndim, true, GeneratorType>(
+          integrand, nc, ng, npg, nslots, seed_it, xjac, dxg, xnd, regn,
+          dx.data(), xi.data(), slot_d, slot_fb, d.data(), ti, tsi);
+      else
+        detail::sample_pass<IntegT, ndim, false, GeneratorType>(
+          integrand, nc, ng, npg, nslots, seed_it, xjac, dxg, xnd, regn,
+          dx.data(), xi.data(), slot_d, slot_fb, d.data(), ti, tsi);
+      tsi *= dv2g;
+
+      if (it > skip || !adjust) {
+        wgt = 1.0 / tsi;
+        si += wgt * ti;
+        schi += wgt * ti * ti;
+        swgt += wgt;
+        *tgral = si / swgt;
+        *chi2a = (schi - si * (*tgral)) / (static_cast<double>(it) - 0.9999);
+        if (*chi2a < 0.0)
+          *chi2a = 0.0;
+        *sd = sqrt(1.0 / swgt);
+        *status = detail::GetStatus(*tgral, *sd, it, epsrel, epsabs);
+      }
+
+      if constexpr (DEBUG_MCUBES)
+        printf("%i, %.15e, %.15e, %.15e, %.15e, %.15e\n",
+               it, *tgral, *sd, *chi2a, ti, sqrt(tsi));
+
+      if (!adjust)
+        continue;
+
+      // smooth the bin contributions and rebin, as the GPU host code
+      for (j = 1; j <= ndim; j++) {
+        double* dj = &d[j - 1];
+        xo = dj[1 * ndim];
+        xn = dj[2 * ndim];
+        dj[1 * ndim] = (xo + xn) / 2.0;
+        dt[j] = dj[1 * ndim];
+
+        for (i = 2; i < nd; i++) {
+          rc = xo + xn;
+          xo = xn;
+          xn = dj[(i + 1) * ndim];
+          dj[i * ndim] = (rc + xn) / 3.0;
+          dt[j] += dj[i * ndim];
+        }
+
+        dj[nd * ndim] = (xo + xn) / 2.0;
+        dt[j] += dj[nd * ndim];
+      }
+
+      for (j = 1; j <= ndim; j++) {
+        if (dt[j] > 0.0) {
+          rc = 0.0;
+          for (i = 1; i <= nd; i++) {
+            const double dij = d[i * ndim + j - 1];
+            r[i] = pow((1.0 - dij / dt[j]) / (log(dt[j]) - log(dij)),
+                       Cpu_Vegas_Params::get_ALPH());
+            rc += r[i];
+          }
+          detail::rebin(rc / xnd, nd, r.data(), xin.data(), &xi[j * ndmx_p1]);
+        }
+      }
+    }
+  }
+
+  template <typename IntegT,
+            int NDIM,
+            bool DEBUG_MCUBES = false,
+            typename GeneratorType = Counter_generator>
+  numint::integration_result
+  integrate(IntegT const& ig,
+            double epsrel,
+            double epsabs,
+            double ncall,
+            quad::Volume<double, NDIM> const* volume,
+            int totalIters = 15,
+            int adjustIters = 15,
+            int skipIters = 5,
+            unsigned int seed = 0)
+  {
+    numint::integration_result result;
+    result.status = 1;
+    vegas<IntegT, NDIM, DEBUG_MCUBES, GeneratorType>(ig,
+                                                     epsrel,
+                                                     epsabs,
+                                                     ncall,
+                                                     &result.estimate,
+                                                     &result.errorest,
+                                                     &result.chi_sq,
+                                                     &result.status,
+                                                     &result.iters,
+                                                     totalIters,
+                                                     adjustIters,
+                                                     skipIters,
+                                                     volume,
+                                                     seed);
+    const double ng = (int)pow(ncall / 2.0 + 0.25, 1.0 / NDIM);
+    const double ncubes = pow(ng, NDIM);
+    result.neval = static_cast<size_t>(std::max(ncall / ncubes, 2.0)) *
+                   static_cast<size_t>(ncubes) * result.iters;
+    return result;
+  }
+
+  template <typename IntegT,
+            int NDIM,
+            bool DEBUG_MCUBES = false,
+            typename GeneratorType = Counter_generator>
+  numint::integration_result
+  simple_integrate(IntegT const& integrand,
+                   double epsrel,
+                   double epsabs,
+                   double ncall,
+                   quad::Volume<double, NDIM> const* volume,
+                   int totalIters = 15,
+                   int adjustIters = 15,
+                   int skipIters = 5,
+                   unsigned int seed = 0)
+  {
+    numint::integration_result result;
+    result.status = 1;
+
+    do {
+      result = integrate<IntegT, NDIM, DEBUG_MCUBES, GeneratorType>(
+        integrand, epsrel, epsabs, ncall, volume, totalIters, adjustIters,
+        skipIters, seed);
+    } while (result.status == 1 &&
+             detail::AdjustParams(ncall, totalIters) == true);
+
+    return result;
+  }
+
+  class mcubes {
+  public:
+    mcubes(double epsrel,
+           double epsabs,
+           double ncall,
+           int totalIters = 15,
+           int adjustIters = 15,
+           int skipIters = 5,
+           unsigned int seed = 0)
+      : epsrel_(epsrel)
+      , epsabs_(epsabs)
+      , ncall_(ncall)
+      , totalIters_(totalIters)
+      , adjustIters_(adjustIters)
+      , skipIters_(skipIters)
+      , seed_(seed)
+    {}
+
+    template <typename F, int NDIM>
+    numint::integration_result
+    integrate(F& integrand, quad::Volume<double, NDIM> const* volume)
+    {
+      return cpu_mcubes::integrate<F, NDIM>(integrand,
+                                            epsrel_,
+                                            epsabs_,
+                                            ncall_,
+                                            volume,
+                                            totalIters_,
+                                            adjustIters_,
+                                            skipIters_,
+                                            seed_);
+    }
+
+  private:
+    double epsrel_;
+    double epsabs_;
+    double ncall_;
+    int totalIters_;
+    int adjustIters_;
+    int skipIters_;
+    unsigned int seed_;
+  };
+
+}
+#endif
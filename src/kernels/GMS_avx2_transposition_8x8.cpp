@@ -44,7 +44,7 @@ void gms::math::transpose_ymm8r4_8x8_ip(__m256 &x0,
 			  z1 = _mm256_shuffle_ps(y0,y2,_MM_SHUFFLE(3,2,3,2));
 			  y3 = _mm256_unpackhi_ps(x2,x3);
 			  z2 = _mm256_shuffle_ps(y1,y3,_MM_SHUFFLE(1,0,1,0));
-			  z3 = _mm256_shuffle_ps(y1,y3,_MM_SHUFFLE(3,2,3,3));
+			  z3 = _mm256_shuffle_ps(y1,y3,_MM_SHUFFLE(3,2,3,2));
 			  y4 = _mm256_unpacklo_ps(x4,x5);
 			  y5 = _mm256_unpackhi_ps(x4,x5);
 			  y6 = _mm256_unpacklo_ps(x6,x7);
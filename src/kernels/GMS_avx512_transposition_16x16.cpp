@@ -214,8 +214,8 @@ void gms::math::transpose_u_zmm16r4_16x16_ip(float * __restrict x00,
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -329,8 +329,8 @@ void gms::math::transpose_a_zmm16r4_16x16_ip(float * __restrict __ATTR_ALIGN__(6
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -429,8 +429,8 @@ void gms::math::transpose_u_zmm16r4_16x16_ip(float * __restrict x)
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -530,8 +530,8 @@ void gms::math::transpose_a_zmm16r4_16x16_ip(float * __restrict __ATTR_ALIGN__(6
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -631,8 +631,8 @@ void gms::math::transpose_u_zmm16r4_16x16(float * __restrict x,
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -732,8 +732,8 @@ void gms::math::transpose_a_zmm16r4_16x16(float * __restrict __ATTR_ALIGN__(64)
 			   z07 = _mm512_shuffle_ps(y05,y07,_MM_SHUFFLE(3,2,3,2));
 			   z08 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(1,0,1,0));
 			   z09 = _mm512_shuffle_ps(y08,y10,_MM_SHUFFLE(3,2,3,2));
-			   z10 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(1,0,1,0));
-			   z11 = _mm512_shuffle_ps(y09,y10,_MM_SHUFFLE(3,2,3,2));
+			   z10 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(1,0,1,0));
+			   z11 = _mm512_shuffle_ps(y09,y11,_MM_SHUFFLE(3,2,3,2));
 			   z12 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(1,0,1,0));
 			   z13 = _mm512_shuffle_ps(y12,y14,_MM_SHUFFLE(3,2,3,2));
 			   z14 = _mm512_shuffle_ps(y13,y15,_MM_SHUFFLE(1,0,1,0));
@@ -0,0 +1,469 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <algorithm>
+#include "GMS_cbessel_jyh_vec.h"
+
+
+namespace {
+
+        // Thin per-width layer, the recurrences below are written once for all four widths.
+        struct zmm16r4_ops {
+
+               typedef __m512    V;
+               typedef __mmask16 M;
+               typedef float     S;
+               static constexpr int32_t W = 16;
+               static constexpr S big   = 1.0e+20f;     // rescaling threshold of the downward sweep
+               static constexpr S small = 1.0e-20f;
+               static constexpr int32_t c1 = 4;         // Miller start, M = max(N,|z|) + c1*|z|^(1/3) + c2
+               static constexpr int32_t c2 = 10;
+               static V set1(const S s)                    { return (_mm512_set1_ps(s));}
+               static V zero()                             { return (_mm512_setzero_ps());}
+               static V add(const V a,const V b)           { return (_mm512_add_ps(a,b));}
+               static V sub(const V a,const V b)           { return (_mm512_sub_ps(a,b));}
+               static V mul(const V a,const V b)           { return (_mm512_mul_ps(a,b));}
+               static V div(const V a,const V b)           { return (_mm512_div_ps(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm512_fmadd_ps(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm512_fmsub_ps(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm512_fnmadd_ps(a,b,c));}
+               static V abs(const V a)                     { return (_mm512_abs_ps(a));}
+               static M cmp_gt(const V a,const V b)        { return (_mm512_cmp_ps_mask(a,b,_CMP_GT_OQ));}
+               static M cmp_le(const V a,const V b)        { return (_mm512_cmp_ps_mask(a,b,_CMP_LE_OQ));}
+               static M cmp_eq(const V a,const V b)        { return (_mm512_cmp_ps_mask(a,b,_CMP_EQ_OQ));}
+               static M mand(const M a,const M b)          { return (a & b);}
+               static bool any(const M k)                  { return (k != 0);}
+               static V select(const M k,const V t,const V f) { return (_mm512_mask_blend_ps(k,f,t));}
+               static void store(S * p,const V a)          { _mm512_storeu_ps(p,a);}
+               static V load(const S * p)                  { return (_mm512_loadu_ps(p));}
+        };
+
+        struct zmm8r8_ops {
+
+               typedef __m512d   V;
+               typedef __mmask8  M;
+               typedef double    S;
+               static constexpr int32_t W = 8;
+               static constexpr S big   = 1.0e+150;
+               static constexpr S small = 1.0e-150;
+               static constexpr int32_t c1 = 8;
+               static constexpr int32_t c2 = 20;
+               static V set1(const S s)                    { return (_mm512_set1_pd(s));}
+               static V zero()                             { return (_mm512_setzero_pd());}
+               static V add(const V a,const V b)           { return (_mm512_add_pd(a,b));}
+               static V sub(const V a,const V b)           { return (_mm512_sub_pd(a,b));}
+               static V mul(const V a,const V b)           { return (_mm512_mul_pd(a,b));}
+               static V div(const V a,const V b)           { return (_mm512_div_pd(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm512_fmadd_pd(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm512_fmsub_pd(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm512_fnmadd_pd(a,b,c));}
+               static V abs(const V a)                     { return (_mm512_abs_pd(a));}
+               static M cmp_gt(const V a,const V b)        { return (_mm512_cmp_pd_mask(a,b,_CMP_GT_OQ));}
+               static M cmp_le(const V a,const V b)        { return (_mm512_cmp_pd_mask(a,b,_CMP_LE_OQ));}
+               static M cmp_eq(const V a,const V b)        { return (_mm512_cmp_pd_mask(a,b,_CMP_EQ_OQ));}
+               static M mand(const M a,const M b)          { return (a & b);}
+               static bool any(const M k)                  { return (k != 0);}
+               static V select(const M k,const V t,const V f) { return (_mm512_mask_blend_pd(k,f,t));}
+               static void store(S * p,const V a)          { _mm512_storeu_pd(p,a);}
+               static V load(const S * p)                  { return (_mm512_loadu_pd(p));}
+        };
+
+        // AVX2: the comparison masks are vectors.
+        struct ymm8r4_ops {
+
+               typedef __m256    V;
+               typedef __m256    M;
+               typedef float     S;
+               static constexpr int32_t W = 8;
+               static constexpr S big   = 1.0e+20f;
+               static constexpr S small = 1.0e-20f;
+               static constexpr int32_t c1 = 4;
+               static constexpr int32_t c2 = 10;
+               static V set1(const S s)                    { return (_mm256_set1_ps(s));}
+               static V zero()                             { return (_mm256_setzero_ps());}
+               static V add(const V a,const V b)           { return (_mm256_add_ps(a,b));}
+               static V sub(const V a,const V b)           { return (_mm256_sub_ps(a,b));}
+               static V mul(const V a,const V b)           { return (_mm256_mul_ps(a,b));}
+               static V div(const V a,const V b)           { return (_mm256_div_ps(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm256_fmadd_ps(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm256_fmsub_ps(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm256_fnmadd_ps(a,b,c));}
+               static V abs(const V a)                     { return (_mm256_andnot_ps(_mm256_set1_ps(-0.0f),a));}
+               static M cmp_gt(const V a,const V b)        { return (_mm256_cmp_ps(a,b,_CMP_GT_OQ));}
+               static M cmp_le(const V a,const V b)        { return (_mm256_cmp_ps(a,b,_CMP_LE_OQ));}
+               static M cmp_eq(const V a,const V b)        { return (_mm256_cmp_ps(a,b,_CMP_EQ_OQ));}
+               static M mand(const M a,const M b)          { return (_mm256_and_ps(a,b));}
+               static bool any(const M k)                  { return (_mm256_movemask_ps(k) != 0);}
+               static V select(const M k,const V t,const V f) { return (_mm256_blendv_ps(f,t,k));}
+               static void store(S * p,const V a)          { _mm256_storeu_ps(p,a);}
+               static V load(const S * p)                  { return (_mm256_loadu_ps(p));}
+        };
+
+        struct ymm4r8_ops {
+
+               typedef __m256d   V;
+               typedef __m256d   M;
+               typedef double    S;
+               static constexpr int32_t W = 4;
+               static constexpr S big   = 1.0e+150;
+               static constexpr S small = 1.0e-150;
+               static constexpr int32_t c1 = 8;
+               static constexpr int32_t c2 = 20;
+               static V set1(const S s)                    { return (_mm256_set1_pd(s));}
+               static V zero()                             { return (_mm256_setzero_pd());}
+               static V add(const V a,const V b)           { return (_mm256_add_pd(a,b));}
+               static V sub(const V a,const V b)           { return (_mm256_sub_pd(a,b));}
+               static V mul(const V a,const V b)           { return (_mm256_mul_pd(a,b));}
+               static V div(const V a,const V b)           { return (_mm256_div_pd(a,b));}
+               static V fmadd(const V a,const V b,const V c)  { return (_mm256_fmadd_pd(a,b,c));}
+               static V fmsub(const V a,const V b,const V c)  { return (_mm256_fmsub_pd(a,b,c));}
+               static V fnmadd(const V a,const V b,const V c) { return (_mm256_fnmadd_pd(a,b,c));}
+               static V abs(const V a)                     { return (_mm256_andnot_pd(_mm256_set1_pd(-0.0),a));}
+               static M cmp_gt(const V a,const V b)        { return (_mm256_cmp_pd(a,b,_CMP_GT_OQ));}
+               static M cmp_le(const V a,const V b)        { return (_mm256_cmp_pd(a,b,_CMP_LE_OQ));}
+               static M cmp_eq(const V a,const V b)        { return (_mm256_cmp_pd(a,b,_CMP_EQ_OQ));}
+               static M mand(const M a,const M b)          { return (_mm256_and_pd(a,b));}
+               static bool any(const M k)                  { return (_mm256_movemask_pd(k) != 0);}
+               static V select(const M k,const V t,const V f) { return (_mm256_blendv_pd(f,t,k));}
+               static void store(S * p,const V a)          { _mm256_storeu_pd(p,a);}
+               static V load(const S * p)                  { return (_mm256_loadu_pd(p));}
+        };
+
+        // (ar + j*ai)*(br + j*bi)
+        template<typename Op>
+        __attribute__((always_inline))
+        inline void cmul(const typename Op::V ar,
+                         const typename Op::V ai,
+                         const typename Op::V br,
+                         const typename Op::V bi,
+                         typename Op::V & cr,
+                         typename Op::V & ci) {
+               cr = Op::fmsub(ar,br,Op::mul(ai,bi));
+               ci = Op::fmadd(ar,bi,Op::mul(ai,br));
+        }
+
+        // 1/(br + j*bi), scaled by max(|br|,|bi|).
+        template<typename Op>
+        __attribute__((always_inline))
+        inline void crcp(const typename Op::V br,
+                         const typename Op::V bi,
+                         typename Op::V & cr,
+                         typename Op::V & ci) {
+               typedef typename Op::V V;
+               const V one{Op::set1(1)};
+               const V ab{Op::abs(br)}, bb{Op::abs(bi)};
+               const V s{Op::div(one,Op::select(Op::cmp_gt(ab,bb),ab,bb))};
+               const V sr{Op::mul(br,s)};
+               const V si{Op::mul(bi,s)};
+               const V rd{Op::div(s,Op::fmadd(sr,sr,Op::mul(si,si)))};
+               cr = Op::mul(sr,rd);
+               ci = Op::sub(Op::zero(),Op::mul(si,rd));
+        }
+
+        template<typename Op>
+        void cbessel_jyh_kernel(const typename Op::V zr,
+                                const typename Op::V zi,
+                                const int32_t N,
+                                typename Op::V * __restrict Jr,
+                                typename Op::V * __restrict Ji,
+                                typename Op::V * __restrict Yr,
+                                typename Op::V * __restrict Yi,
+                                typename Op::V * __restrict H2r,
+                                typename Op::V * __restrict H2i) {
+               typedef typename Op::V V;
+               typedef typename Op::M M;
+               typedef typename Op::S S;
+               constexpr int32_t W{Op::W};
+               if(N < 0) return;
+               S zrs[W], zis[W], lr[W], li[W], cr[W], ci[W];
+               // w = z reflected to Im w >= 0, f(z) = conj(f(conj z)) for the lanes below the real axis
+               const M lo{Op::cmp_gt(Op::zero(),zi)};
+               const V vzi{Op::abs(zi)};
+               Op::store(zrs,zr);
+               Op::store(zis,vzi);
+               double amax{0.0};
+               for(int32_t __i{0}; __i != W; ++__i) {
+                   std::complex<double> z{static_cast<double>(zrs[__i]),static_cast<double>(zis[__i])};
+                   if(z == std::complex<double>(0.0,0.0)) {
+                      z = {1.0,0.0};                       // dummy lane, set at the end
+                      zrs[__i] = S(1);
+                   }
+                   amax = std::max(amax,std::abs(z));
+                   const std::complex<double> l{std::log(0.5*z)+0.57721566490153286061};
+                   const std::complex<double> c{std::cos(z)};
+                   lr[__i] = static_cast<S>(l.real());
+                   li[__i] = static_cast<S>(l.imag());
+                   cr[__i] = static_cast<S>(c.real());
+                   ci[__i] = static_cast<S>(c.imag());
+               }
+               const M zl{Op::mand(Op::cmp_eq(zr,Op::zero()),Op::cmp_eq(zi,Op::zero()))};
+               const V vzr{Op::load(zrs)};
+               const int32_t nmax{std::max(N,static_cast<int32_t>(amax))};
+               const int32_t M0{nmax+static_cast<int32_t>(static_cast<double>(Op::c1)*std::cbrt(amax))+Op::c2};
+               V rzr, rzi;
+               crcp<Op>(vzr,vzi,rzr,rzi);
+               const V big{Op::set1(Op::big)};
+               const V small{Op::set1(Op::small)};
+               // downward sweep, j = J_n, jp = J_n+1 (unnormalised)
+               V jr{small}, ji{Op::zero()}, jpr{Op::zero()}, jpi{Op::zero()};
+               V ser{Op::zero()}, sei{Op::zero()};   // 2*SUM J_2k
+               V sar{Op::zero()}, sai{Op::zero()};   // 2*SUM (-1)^k*J_2k
+               V s0r{Op::zero()}, s0i{Op::zero()};   // SUM (-1)^k*J_2k/k
+               V s1r{Op::zero()}, s1i{Op::zero()};   // SUM (-1)^k*(J_2k-1 - J_2k+1)/k
+               for(int32_t n{M0}; n >= 1; --n) {
+                   if(n <= N) {
+                      Jr[n] = jr;
+                      Ji[n] = ji;
+                   }
+                   if(n & 1) {
+                      const int32_t k1{(n+1)>>1}, k2{(n-1)>>1};
+                      S c{((k1 & 1) ? S(-1) : S(1))/static_cast<S>(k1)};
+                      if(k2 >= 1) c -= ((k2 & 1) ? S(-1) : S(1))/static_cast<S>(k2);
+                      const V vc{Op::set1(c)};
+                      s1r = Op::fmadd(vc,jr,s1r);
+                      s1i = Op::fmadd(vc,ji,s1i);
+                   } else {
+                      const int32_t k{n>>1};
+                      const S sg{(k & 1) ? S(-1) : S(1)};
+                      const V two{Op::set1(S(2))};
+                      const V tsg{Op::set1(S(2)*sg)};
+                      const V rk{Op::set1(sg/static_cast<S>(k))};
+                      ser = Op::fmadd(two,jr,ser);
+                      sei = Op::fmadd(two,ji,sei);
+                      sar = Op::fmadd(tsg,jr,sar);
+                      sai = Op::fmadd(tsg,ji,sai);
+                      s0r = Op::fmadd(rk,jr,s0r);
+                      s0i = Op::fmadd(rk,ji,s0i);
+                   }
+                   // J_n-1 = 2n/z*J_n - J_n+1
+                   V tr, ti;
+                   cmul<Op>(rzr,rzi,jr,ji,tr,ti);
+                   const V tn{Op::set1(static_cast<S>(2*n))};
+                   const V jmr{Op::fmsub(tn,tr,jpr)};
+                   const V jmi{Op::fmsub(tn,ti,jpi)};
+                   jpr = jr;
+                   jpi = ji;
+                   jr  = jmr;
+                   ji  = jmi;
+                   const M ovf{Op::cmp_gt(Op::add(Op::abs(jr),Op::abs(ji)),big)};
+                   if(Op::any(ovf)) {
+                      const auto sc = [&](V & v) { v = Op::select(ovf,Op::mul(v,small),v); };
+                      sc(jr);  sc(ji);  sc(jpr); sc(jpi);
+                      sc(ser); sc(sei); sc(sar); sc(sai);
+                      sc(s0r); sc(s0i); sc(s1r); sc(s1i);
+                      for(int32_t __i{n}; __i <= N; ++__i) {
+                          sc(Jr[__i]);
+                          sc(Ji[__i]);
+                      }
+                   }
+               }
+               // normalisation, J_0 + 2*SUM J_2k = 1 or J_0 + 2*SUM (-1)^k*J_2k = cos(z)
+               const M nrm1{Op::cmp_le(vzi,Op::set1(S(1)))};
+               V csr, csi;
+               {
+                  V qr, qi;
+                  crcp<Op>(Op::load(cr),Op::load(ci),qr,qi);
+                  V ar, ai;
+                  cmul<Op>(Op::add(jr,sar),Op::add(ji,sai),qr,qi,ar,ai);
+                  csr = Op::select(nrm1,Op::add(jr,ser),ar);
+                  csi = Op::select(nrm1,Op::add(ji,sei),ai);
+               }
+               V rnr, rni;
+               crcp<Op>(csr,csi,rnr,rni);
+               V j0r, j0i, j1r, j1i;
+               cmul<Op>(jr,ji,rnr,rni,j0r,j0i);
+               cmul<Op>(jpr,jpi,rnr,rni,j1r,j1i);
+               Jr[0] = j0r;
+               Ji[0] = j0i;
+               for(int32_t __i{1}; __i <= N; ++__i) cmul<Op>(Jr[__i],Ji[__i],rnr,rni,Jr[__i],Ji[__i]);
+               const V one{Op::set1(S(1))};
+               if(Yr != nullptr || H2r != nullptr) {
+                  // H1_0, H1_1: |w| < 2 from the Neumann series of Y_0, Y_1 (H1 = J + jY),
+                  // |w| >= 2 from J_0, J_1, the Wronskian and gamma = H1_0'/H1_0 (Steed's CF2),
+                  //     gamma = -1/(2w) + j + j/w*(a_1/(b_1 + a_2/(b_2 + ...))), a_k = ((2k-1)/2)^2, b_k = 2(w + jk),
+                  //     H1_0 = 2j/(pi*w*(gamma*J_0 + J_1)), H1_1 = -gamma*H1_0.
+                  // H1 is the minimal solution at Im w -> inf and the dominant one of the
+                  // forward recurrence, Y = -j*(H1 - J) then keeps the part J and Y cancel to.
+                  cmul<Op>(s0r,s0i,rnr,rni,s0r,s0i);
+                  cmul<Op>(s1r,s1i,rnr,rni,s1r,s1i);
+                  const V L_r{Op::load(lr)}, L_i{Op::load(li)};
+                  const V tpi{Op::set1(static_cast<S>(0.636619772367581343076))};
+                  const V fpi{Op::set1(static_cast<S>(1.273239544735162686151))};
+                  V h0r, h0i, h1r, h1i;
+                  {
+                     V tr, ti, ur, ui;
+                     cmul<Op>(L_r,L_i,j0r,j0i,tr,ti);
+                     const V y0r{Op::fmsub(tpi,tr,Op::mul(fpi,s0r))};
+                     const V y0i{Op::fmsub(tpi,ti,Op::mul(fpi,s0i))};
+                     cmul<Op>(L_r,L_i,j1r,j1i,tr,ti);
+                     cmul<Op>(j0r,j0i,rzr,rzi,ur,ui);
+                     const V y1r{Op::mul(tpi,Op::add(Op::sub(tr,ur),s1r))};
+                     const V y1i{Op::mul(tpi,Op::add(Op::sub(ti,ui),s1i))};
+                     h0r = Op::sub(j0r,y0i);
+                     h0i = Op::add(j0i,y0r);
+                     h1r = Op::sub(j1r,y1i);
+                     h1i = Op::add(j1i,y1r);
+                  }
+                  const M cf{Op::cmp_le(Op::set1(S(4)),Op::fmadd(vzr,vzr,Op::mul(vzi,vzi)))};
+                  if(Op::any(cf)) {
+                     const V eps{Op::set1(S(4)*std::numeric_limits<S>::epsilon())};
+                     V fr{small}, fi{Op::zero()}, Cr{small}, Ci{Op::zero()}, Dr{Op::zero()}, Di{Op::zero()};
+                     const V br{Op::add(vzr,vzr)};
+                     for(int32_t k{1}; k <= 1000; ++k) {
+                         const S ak{static_cast<S>(0.25*(2*k-1)*(2*k-1))};
+                         const V va{Op::set1(ak)};
+                         const V bi{Op::add(Op::add(vzi,vzi),Op::set1(static_cast<S>(2*k)))};
+                         crcp<Op>(Op::fmadd(va,Dr,br),Op::fmadd(va,Di,bi),Dr,Di);
+                         V qr, qi;
+                         crcp<Op>(Cr,Ci,qr,qi);
+                         Cr = Op::fmadd(va,qr,br);
+                         Ci = Op::fmadd(va,qi,bi);
+                         V er, ei;
+                         cmul<Op>(Cr,Ci,Dr,Di,er,ei);
+                         cmul<Op>(fr,fi,er,ei,fr,fi);
+                         const V de{Op::add(Op::abs(Op::sub(er,one)),Op::abs(ei))};
+                         if(!Op::any(Op::mand(cf,Op::cmp_gt(de,eps)))) break;
+                     }
+                     V gr, gi, tr, ti;
+                     cmul<Op>(rzr,rzi,Op::fnmadd(Op::set1(S(1)),fi,Op::set1(S(-0.5))),fr,gr,gi);
+                     gi = Op::add(gi,one);
+                     cmul<Op>(gr,gi,j0r,j0i,tr,ti);
+                     cmul<Op>(vzr,vzi,Op::add(tr,j1r),Op::add(ti,j1i),tr,ti);
+                     V qr, qi;
+                     crcp<Op>(tr,ti,qr,qi);
+                     const V c0r{Op::sub(Op::zero(),Op::mul(tpi,qi))};
+                     const V c0i{Op::mul(tpi,qr)};
+                     cmul<Op>(gr,gi,c0r,c0i,tr,ti);
+                     h0r = Op::select(cf,c0r,h0r);
+                     h0i = Op::select(cf,c0i,h0i);
+                     h1r = Op::select(cf,Op::sub(Op::zero(),tr),h1r);
+                     h1i = Op::select(cf,Op::sub(Op::zero(),ti),h1i);
+                  }
+                  // H1_n+1 = 2n/w*H1_n - H1_n-1, Y_n = -j*(H1_n - J_n), H2_n = 2J_n - H1_n (conj(H1_n) below the axis)
+                  const V ninf{Op::set1(-std::numeric_limits<S>::infinity())};
+                  const V pinf{Op::set1(std::numeric_limits<S>::infinity())};
+                  const V lim{Op::set1(std::numeric_limits<S>::max())};
+                  V hmr{Op::zero()}, hmi{Op::zero()};
+                  for(int32_t n{0}; n <= N; ++n) {
+                      const V dr{Op::sub(h0r,Jr[n])};
+                      const V di{Op::sub(h0i,Ji[n])};
+                      if(Yr != nullptr) {
+                         Yr[n] = Op::select(zl,ninf,di);
+                         Yi[n] = Op::select(zl,Op::zero(),Op::select(lo,dr,Op::sub(Op::zero(),dr)));
+                      }
+                      if(H2r != nullptr) {
+                         const V hr{Op::select(lo,h0r,Op::sub(Jr[n],dr))};
+                         const V hi{Op::select(lo,Op::sub(Op::zero(),h0i),Op::sub(Ji[n],di))};
+                         H2r[n] = Op::select(zl,(n == 0) ? one : Op::zero(),hr);
+                         H2i[n] = Op::select(zl,pinf,hi);
+                      }
+                      if(n == N) break;
+                      V hnr, hni;
+                      if(n == 0) {
+                         hnr = h1r;
+                         hni = h1i;
+                      } else {
+                         V tr, ti;
+                         cmul<Op>(rzr,rzi,h0r,h0i,tr,ti);
+                         const V tn{Op::set1(static_cast<S>(2*n))};
+                         hnr = Op::fmsub(tn,tr,hmr);
+                         hni = Op::fmsub(tn,ti,hmi);
+                         // n >> |w|: H1_n leaves the range, the lane saturates to inf along
+                         // 2n/w*H1_n-1 and stays there (inf - inf would give NaN next step)
+                         const auto fn{Op::cmp_le(Op::add(Op::abs(hnr),Op::abs(hni)),lim)};
+                         const auto f0{Op::cmp_le(Op::add(Op::abs(h0r),Op::abs(h0i)),lim)};
+                         const V sr{Op::select(Op::cmp_gt(tr,Op::zero()),pinf,
+                                               Op::select(Op::cmp_gt(Op::zero(),tr),ninf,Op::zero()))};
+                         const V si{Op::select(Op::cmp_gt(ti,Op::zero()),pinf,
+                                               Op::select(Op::cmp_gt(Op::zero(),ti),ninf,Op::zero()))};
+                         hnr = Op::select(fn,hnr,Op::select(f0,sr,h0r));
+                         hni = Op::select(fn,hni,Op::select(f0,si,h0i));
+                      }
+                      hmr = h0r;
+                      hmi = h0i;
+                      h0r = hnr;
+                      h0i = hni;
+                  }
+               }
+               for(int32_t __i{0}; __i <= N; ++__i) {
+                   Jr[__i] = Op::select(zl,(__i == 0) ? one : Op::zero(),Jr[__i]);
+                   Ji[__i] = Op::select(zl,Op::zero(),Op::select(lo,Op::sub(Op::zero(),Ji[__i]),Ji[__i]));
+               }
+        }
+}
+
+
+void
+gms::math::cbessel_jyh_zmm16r4(const __m512 zr,
+                               const __m512 zi,
+                               const int32_t N,
+                               __m512 * __restrict Jr,
+                               __m512 * __restrict Ji,
+                               __m512 * __restrict Yr,
+                               __m512 * __restrict Yi,
+                               __m512 * __restrict H2r,
+                               __m512 * __restrict H2i) {
+       cbessel_jyh_kernel<zmm16r4_ops>(zr,zi,N,Jr,Ji,Yr,Yi,H2r,H2i);
+}
+
+
+void
+gms::math::cbessel_jyh_zmm8r8(const __m512d zr,
+                              const __m512d zi,
+                              const int32_t N,
+                              __m512d * __restrict Jr,
+                              __m512d * __restrict Ji,
+                              __m512d * __restrict Yr,
+                              __m512d * __restrict Yi,
+                              __m512d * __restrict H2r,
+                              __m512d * __restrict H2i) {
+       cbessel_jyh_kernel<zmm8r8_ops>(zr,zi,N,Jr,Ji,Yr,Yi,H2r,H2i);
+}
+
+
+void
+gms::math::cbessel_jyh_ymm8r4(const __m256 zr,
+                              const __m256 zi,
+                              const int32_t N,
+                              __m256 * __restrict Jr,
+                              __m256 * __restrict Ji,
+                              __m256 * __restrict Yr,
+                              __m256 * __restrict Yi,
+                              __m256 * __restrict H2r,
+                              __m256 * __restrict H2i) {
+       cbessel_jyh_kernel<ymm8r4_ops>(zr,zi,N,Jr,Ji,Yr,Yi,H2r,H2i);
+}
+
+
+void
+gms::math::cbessel_jyh_ymm4r8(const __m256d zr,
+                              const __m256d zi,
+                              const int32_t N,
+                              __m256d * __restrict Jr,
+                              __m256d * __restrict Ji,
+                              __m256d * __restrict Yr,
+                              __m256d * __restrict Yi,
+                              __m256d * __restrict H2r,
+                              __m256d * __restrict H2i) {
+       cbessel_jyh_kernel<ymm4r8_ops>(zr,zi,N,Jr,Ji,Yr,Yi,H2r,H2i);
+}
@@ -0,0 +1,117 @@
+#ifndef __GMS_CBESSEL_JYH_VEC_H__
+#define __GMS_CBESSEL_JYH_VEC_H__
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+    const unsigned int GMS_CBESSEL_JYH_VEC_MAJOR = 1U;
+    const unsigned int GMS_CBESSEL_JYH_VEC_MINOR = 0U;
+    const unsigned int GMS_CBESSEL_JYH_VEC_MICRO = 0U;
+    const unsigned int GMS_CBESSEL_JYH_VEC_FULLVER =
+      1000U*GMS_CBESSEL_JYH_VEC_MAJOR+100U*GMS_CBESSEL_JYH_VEC_MINOR+
+      10U*GMS_CBESSEL_JYH_VEC_MICRO;
+    const char * const GMS_CBESSEL_JYH_VEC_CREATION_DATE = "21-10-2026 09:15 AM +00200 (WED 21 OCT 2026 GMT+2)";
+    const char * const GMS_CBESSEL_JYH_VEC_BUILD_DATE    = __DATE__ ":" __TIME__;
+    const char * const GMS_CBESSEL_JYH_VEC_AUTHOR        = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+    const char * const GMS_CBESSEL_JYH_VEC_DESCRIPTION   = "Integer order Bessel J_n, Y_n and Hankel H2_n of complex argument, orders 0..N per call, AVX512/AVX2 float and double.";
+
+}
+
+/*
+     J_n(z), Y_n(z) and H_n^(2)(z) = J_n(z) - j*Y_n(z), n = 0..N, of complex z
+     (principal branch, -pi < arg z <= pi), one argument per lane, the whole
+     order sequence per call (cylinder and wedge series solutions).
+          J_n -- Miller's downward recurrence J_n-1 = 2n/z*J_n - J_n+1 from
+                 M = max(N,|z|) + c1*|z|^(1/3) + c2, lanes rescaled on overflow,
+                 normalised by J_0 + 2*SUM J_2k = 1 (|Im z| <= 1) or by
+                 J_0 + 2*SUM (-1)^k*J_2k = cos(z) (|Im z| > 1, no cancellation),
+          Y_n -- through H1_n = J_n + j*Y_n, the minimal solution for Im z -> +inf
+                 and the dominant one of the forward recurrence; the lanes are
+                 reflected to Im z >= 0 (f(z) = conj(f(conj z))), H1_0 and H1_1 come
+                 from J_0, J_1, the Wronskian and H1_0'/H1_0 by Steed's continued
+                 fraction (|z| >= 2) or from the Neumann series (|z| < 2),
+                      Y_0 = 2/pi*(ln(z/2)+gamma)*J_0 - 4/pi*SUM (-1)^k*J_2k/k,
+                 then H1_n by forward recurrence, Y_n = -j*(H1_n - J_n) and
+                 H2_n = 2*J_n - H1_n (conj(H1_n(conj z)) below the real axis), so
+                 the exponentially small parts of Y and H2 are not lost to cancellation.
+     Output is split complex per order: Jr[n],Ji[n] (n = 0..N, N+1 registers),
+     Y and H2 may be nullptr. z = 0 gives J_0 = 1, J_n = 0, Y_n = -inf.
+     Accuracy (unit test, relative to |J_n| + |Y_n|): double about 1.0e-14
+     (1.0e-13 at |z| = 100 from the argument conditioning, |z|*eps), float
+     about 3.0e-6 for |z| <= 50. Y_n overflows (inf) once the true value
+     leaves the range of the type (n >> |z|).
+     Cost O(M) complex multiply-adds per register, the per-lane ln and cos
+     are evaluated once per call.
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include "GMS_config.h"
+
+namespace gms {
+
+        namespace math {
+
+                  void cbessel_jyh_zmm16r4(const __m512 zr,
+                                           const __m512 zi,
+                                           const int32_t N,
+                                           __m512 * __restrict Jr,
+                                           __m512 * __restrict Ji,
+                                           __m512 * __restrict Yr,
+                                           __m512 * __restrict Yi,
+                                           __m512 * __restrict H2r,
+                                           __m512 * __restrict H2i);
+
+                  void cbessel_jyh_zmm8r8(const __m512d zr,
+                                          const __m512d zi,
+                                          const int32_t N,
+                                          __m512d * __restrict Jr,
+                                          __m512d * __restrict Ji,
+                                          __m512d * __restrict Yr,
+                                          __m512d * __restrict Yi,
+                                          __m512d * __restrict H2r,
+                                          __m512d * __restrict H2i);
+
+                  void cbessel_jyh_ymm8r4(const __m256 zr,
+                                          const __m256 zi,
+                                          const int32_t N,
+                                          __m256 * __restrict Jr,
+                                          __m256 * __restrict Ji,
+                                          __m256 * __restrict Yr,
+                                          __m256 * __restrict Yi,
+                                          __m256 * __restrict H2r,
+                                          __m256 * __restrict H2i);
+
+                  void cbessel_jyh_ymm4r8(const __m256d zr,
+                                          const __m256d zi,
+                                          const int32_t N,
+                                          __m256d * __restrict Jr,
+                                          __m256d * __restrict Ji,
+                                          __m256d * __restrict Yr,
+                                          __m256d * __restrict Yi,
+                                          __m256d * __restrict H2r,
+                                          __m256d * __restrict H2i);
+
+        } // math
+
+} // gms
+
+#endif /*__GMS_CBESSEL_JYH_VEC_H__*/
@@ -0,0 +1,448 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#include <immintrin.h>
+#include <cstring>
+#include <algorithm>
+#include "GMS_fp16_bulk.h"
+
+static_assert(sizeof(half_float::half) == sizeof(std::uint16_t),
+              "half_float::half must be a bare 16-bit binary16 value");
+
+#if defined(__AVX512F__) || defined(__F16C__)
+#define FP16_BULK_SIMD 1
+#else
+#define FP16_BULK_SIMD 0
+#endif
+
+namespace
+{
+
+#if defined(__AVX512F__)
+
+       constexpr std::size_t VL{16ull};
+       typedef __m512 vf32;
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldh(const std::uint16_t * __restrict p)
+       {
+#if defined(__AVX512FP16__)
+              return _mm512_cvtxph_ps(_mm256_castsi256_ph(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))));
+#else
+              return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+#endif
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void sth(std::uint16_t * __restrict p,const vf32 v)
+       {
+#if defined(__AVX512FP16__)
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),_mm256_castph_si256(_mm512_cvtxps_ph(v)));
+#else
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),_mm512_cvtps_ph(v,_MM_FROUND_TO_NEAREST_INT));
+#endif
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldf(const float * __restrict p)            { return _mm512_loadu_ps(p); }
+       __ATTR_ALWAYS_INLINE__
+       inline void stf(float * __restrict p,const vf32 v)     { _mm512_storeu_ps(p,v); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vset1(const float s)                       { return _mm512_set1_ps(s); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vzero()                                    { return _mm512_setzero_ps(); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vmul(const vf32 a,const vf32 b)            { return _mm512_mul_ps(a,b); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vfma(const vf32 a,const vf32 b,const vf32 c) { return _mm512_fmadd_ps(a,b,c); }
+       __ATTR_ALWAYS_INLINE__
+       inline float vhsum(const vf32 a)                       { return _mm512_reduce_add_ps(a); }
+
+       // interleaved complex product (re,im)*(re,im)
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vcmul(const vf32 x,const vf32 y)
+       {
+              const vf32 yre{_mm512_moveldup_ps(y)};
+              const vf32 yim{_mm512_movehdup_ps(y)};
+              const vf32 xsw{_mm512_permute_ps(x,0xB1)};
+              return _mm512_fmaddsub_ps(x,yre,_mm512_mul_ps(xsw,yim));
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void fill16(std::uint16_t * __restrict p,const std::uint16_t bits,const std::size_t n)
+       {
+              const __m512i v{_mm512_set1_epi16(static_cast<short>(bits))};
+              std::size_t __i;
+              for(__i = 0ull; __i+32ull <= n; __i += 32ull)
+                  _mm512_storeu_si512(reinterpret_cast<void*>(p+__i),v);
+              for(; __i != n; ++__i) p[__i] = bits;
+       }
+
+#elif defined(__F16C__)
+
+       constexpr std::size_t VL{8ull};
+       typedef __m256 vf32;
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldh(const std::uint16_t * __restrict p)
+       {
+              return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void sth(std::uint16_t * __restrict p,const vf32 v)
+       {
+              _mm_storeu_si128(reinterpret_cast<__m128i*>(p),_mm256_cvtps_ph(v,_MM_FROUND_TO_NEAREST_INT));
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldf(const float * __restrict p)            { return _mm256_loadu_ps(p); }
+       __ATTR_ALWAYS_INLINE__
+       inline void stf(float * __restrict p,const vf32 v)     { _mm256_storeu_ps(p,v); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vset1(const float s)                       { return _mm256_set1_ps(s); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vzero()                                    { return _mm256_setzero_ps(); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vmul(const vf32 a,const vf32 b)            { return _mm256_mul_ps(a,b); }
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vfma(const vf32 a,const vf32 b,const vf32 c)
+       {
+#if defined(__FMA__)
+              return _mm256_fmadd_ps(a,b,c);
+#else
+              return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+#endif
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline float vhsum(const vf32 a)
+       {
+              __m128 s{_mm_add_ps(_mm256_castps256_ps128(a),_mm256_extractf128_ps(a,1))};
+              s = _mm_add_ps(s,_mm_movehl_ps(s,s));
+              s = _mm_add_ss(s,_mm_movehdup_ps(s));
+              return _mm_cvtss_f32(s);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 vcmul(const vf32 x,const vf32 y)
+       {
+              const vf32 yre{_mm256_moveldup_ps(y)};
+              const vf32 yim{_mm256_movehdup_ps(y)};
+              const vf32 xsw{_mm256_permute_ps(x,0xB1)};
+#if defined(__FMA__)
+              return _mm256_fmaddsub_ps(x,yre,_mm256_mul_ps(xsw,yim));
+#else
+              return _mm256_addsub_ps(_mm256_mul_ps(x,yre),_mm256_mul_ps(xsw,yim));
+#endif
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void fill16(std::uint16_t * __restrict p,const std::uint16_t bits,const std::size_t n)
+       {
+              const __m256i v{_mm256_set1_epi16(static_cast<short>(bits))};
+              std::size_t __i;
+              for(__i = 0ull; __i+16ull <= n; __i += 16ull)
+                  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p+__i),v);
+              for(; __i != n; ++__i) p[__i] = bits;
+       }
+
+#endif
+
+#if (FP16_BULK_SIMD) == 1
+
+       // Partial (r < VL) loads/stores through a zero-padded buffer.
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldh_n(const std::uint16_t * __restrict p,const std::size_t r)
+       {
+              alignas(64) std::uint16_t buf[VL] = {};
+              std::memcpy(&buf[0],p,r*sizeof(std::uint16_t));
+              return ldh(&buf[0]);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void sth_n(std::uint16_t * __restrict p,const vf32 v,const std::size_t r)
+       {
+              alignas(64) std::uint16_t buf[VL];
+              sth(&buf[0],v);
+              std::memcpy(p,&buf[0],r*sizeof(std::uint16_t));
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline vf32 ldf_n(const float * __restrict p,const std::size_t r)
+       {
+              alignas(64) float buf[VL] = {};
+              std::memcpy(&buf[0],p,r*sizeof(float));
+              return ldf(&buf[0]);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline void stf_n(float * __restrict p,const vf32 v,const std::size_t r)
+       {
+              alignas(64) float buf[VL];
+              stf(&buf[0],v);
+              std::memcpy(p,&buf[0],r*sizeof(float));
+       }
+
+#endif
+
+       __ATTR_ALWAYS_INLINE__
+       inline const std::uint16_t * bits(const half_float::half * p)
+       {
+              return reinterpret_cast<const std::uint16_t*>(p);
+       }
+
+       __ATTR_ALWAYS_INLINE__
+       inline std::uint16_t * bits(half_float::half * p)
+       {
+              return reinterpret_cast<std::uint16_t*>(p);
+       }
+
+}
+
+const char *
+gms::common::fp16_bulk_isa_name()
+{
+#if defined(__AVX512FP16__)
+       return "AVX512FP16";
+#elif defined(__AVX512F__)
+       return "AVX512F";
+#elif defined(__F16C__)
+       return "F16C";
+#else
+       return "SCALAR";
+#endif
+}
+
+void
+gms::common::cvt_f16_f32(const half_float::half * __restrict__ src,
+                         float * __restrict__ dst,
+                         const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       const std::uint16_t * __restrict s{bits(src)};
+       std::size_t __i;
+       for(__i = 0ull; __i+2ull*VL <= n; __i += 2ull*VL)
+       {
+           const vf32 v0{ldh(s+__i)};
+           const vf32 v1{ldh(s+__i+VL)};
+           stf(dst+__i,v0);
+           stf(dst+__i+VL,v1);
+       }
+       for(; __i+VL <= n; __i += VL)
+           stf(dst+__i,ldh(s+__i));
+       if(__i != n)
+           stf_n(dst+__i,ldh_n(s+__i,n-__i),n-__i);
+#else
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           dst[__i] = static_cast<float>(src[__i]);
+#endif
+}
+
+void
+gms::common::cvt_f32_f16(const float * __restrict__ src,
+                         half_float::half * __restrict__ dst,
+                         const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       std::uint16_t * __restrict d{bits(dst)};
+       std::size_t __i;
+       for(__i = 0ull; __i+2ull*VL <= n; __i += 2ull*VL)
+       {
+           const vf32 v0{ldf(src+__i)};
+           const vf32 v1{ldf(src+__i+VL)};
+           sth(d+__i,v0);
+           sth(d+__i+VL,v1);
+       }
+       for(; __i+VL <= n; __i += VL)
+           sth(d+__i,ldf(src+__i));
+       if(__i != n)
+           sth_n(d+__i,ldf_n(src+__i,n-__i),n-__i);
+#else
+       using namespace half_float;
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           dst[__i] = half_cast<half>(src[__i]);
+#endif
+}
+
+void
+gms::common::cvt_c2_c4(const std::complex<half_float::half> * __restrict__ src,
+                       std::complex<float> * __restrict__ dst,
+                       const std::size_t n)
+{
+       gms::common::cvt_f16_f32(reinterpret_cast<const half_float::half*>(src),
+                                reinterpret_cast<float*>(dst),2ull*n);
+}
+
+void
+gms::common::cvt_c4_c2(const std::complex<float> * __restrict__ src,
+                       std::complex<half_float::half> * __restrict__ dst,
+                       const std::size_t n)
+{
+       gms::common::cvt_f32_f16(reinterpret_cast<const float*>(src),
+                                reinterpret_cast<half_float::half*>(dst),2ull*n);
+}
+
+void
+gms::common::fill_f16(half_float::half * __restrict__ dst,
+                      const half_float::half h,
+                      const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       std::uint16_t b;
+       std::memcpy(&b,&h,sizeof(b));
+       fill16(bits(dst),b,n);
+#else
+       std::fill(dst,dst+n,h);
+#endif
+}
+
+void
+gms::common::scale_f16(half_float::half * __restrict__ x,
+                       const float a,
+                       const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       std::uint16_t * __restrict px{bits(x)};
+       const vf32 va{vset1(a)};
+       std::size_t __i;
+       for(__i = 0ull; __i+VL <= n; __i += VL)
+           sth(px+__i,vmul(va,ldh(px+__i)));
+       if(__i != n)
+           sth_n(px+__i,vmul(va,ldh_n(px+__i,n-__i)),n-__i);
+#else
+       using namespace half_float;
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           x[__i] = half_cast<half>(a*static_cast<float>(x[__i]));
+#endif
+}
+
+void
+gms::common::axpy_f16(const float a,
+                      const half_float::half * __restrict__ x,
+                      half_float::half * __restrict__ y,
+                      const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       const std::uint16_t * __restrict px{bits(x)};
+       std::uint16_t * __restrict py{bits(y)};
+       const vf32 va{vset1(a)};
+       std::size_t __i;
+       for(__i = 0ull; __i+VL <= n; __i += VL)
+           sth(py+__i,vfma(va,ldh(px+__i),ldh(py+__i)));
+       if(__i != n)
+       {
+           const std::size_t r{n-__i};
+           sth_n(py+__i,vfma(va,ldh_n(px+__i,r),ldh_n(py+__i,r)),r);
+       }
+#else
+       using namespace half_float;
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           y[__i] = half_cast<half>(a*static_cast<float>(x[__i])+static_cast<float>(y[__i]));
+#endif
+}
+
+void
+gms::common::mul_f16(const half_float::half * __restrict__ x,
+                     const half_float::half * __restrict__ y,
+                     half_float::half * __restrict__ z,
+                     const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       const std::uint16_t * __restrict px{bits(x)};
+       const std::uint16_t * __restrict py{bits(y)};
+       std::uint16_t * __restrict pz{bits(z)};
+       std::size_t __i;
+       for(__i = 0ull; __i+VL <= n; __i += VL)
+           sth(pz+__i,vmul(ldh(px+__i),ldh(py+__i)));
+       if(__i != n)
+       {
+           const std::size_t r{n-__i};
+           sth_n(pz+__i,vmul(ldh_n(px+__i,r),ldh_n(py+__i,r)),r);
+       }
+#else
+       using namespace half_float;
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           z[__i] = half_cast<half>(static_cast<float>(x[__i])*static_cast<float>(y[__i]));
+#endif
+}
+
+float
+gms::common::dot_f16(const half_float::half * __restrict__ x,
+                     const half_float::half * __restrict__ y,
+                     const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       const std::uint16_t * __restrict px{bits(x)};
+       const std::uint16_t * __restrict py{bits(y)};
+       vf32 acc0{vzero()};
+       vf32 acc1{vzero()};
+       std::size_t __i;
+       for(__i = 0ull; __i+2ull*VL <= n; __i += 2ull*VL)
+       {
+           acc0 = vfma(ldh(px+__i),ldh(py+__i),acc0);
+           acc1 = vfma(ldh(px+__i+VL),ldh(py+__i+VL),acc1);
+       }
+       for(; __i+VL <= n; __i += VL)
+           acc0 = vfma(ldh(px+__i),ldh(py+__i),acc0);
+       if(__i != n)
+       {
+           const std::size_t r{n-__i};
+           acc1 = vfma(ldh_n(px+__i,r),ldh_n(py+__i,r),acc1);
+       }
+       return (vhsum(acc0)+vhsum(acc1));
+#else
+       float sum{0.0f};
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+           sum += static_cast<float>(x[__i])*static_cast<float>(y[__i]);
+       return (sum);
+#endif
+}
+
+void
+gms::common::cmul_c2(const std::complex<half_float::half> * __restrict__ x,
+                     const std::complex<half_float::half> * __restrict__ y,
+                     std::complex<half_float::half> * __restrict__ z,
+                     const std::size_t n)
+{
+#if (FP16_BULK_SIMD) == 1
+       const std::uint16_t * __restrict px{reinterpret_cast<const std::uint16_t*>(x)};
+       const std::uint16_t * __restrict py{reinterpret_cast<const std::uint16_t*>(y)};
+       std::uint16_t * __restrict pz{reinterpret_cast<std::uint16_t*>(z)};
+       const std::size_t m{2ull*n};
+       std::size_t __i;
+       for(__i = 0ull; __i+VL <= m; __i += VL)
+           sth(pz+__i,vcmul(ldh(px+__i),ldh(py+__i)));
+       if(__i != m)
+       {
+           const std::size_t r{m-__i};
+           sth_n(pz+__i,vcmul(ldh_n(px+__i,r),ldh_n(py+__i,r)),r);
+       }
+#else
+       using namespace half_float;
+       for(std::size_t __i{0ull}; __i != n; ++__i)
+       {
+           const float a{static_cast<float>(x[__i].real())};
+           const float b{static_cast<float>(x[__i].imag())};
+           const float c{static_cast<float>(y[__i].real())};
+           const float d{static_cast<float>(y[__i].imag())};
+           z[__i] = std::complex<half>(half_cast<half>(a*c-b*d),half_cast<half>(a*d+b*c));
+       }
+#endif
+}
@@ -0,0 +1,131 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#ifndef __GMS_FP16_BULK_H__
+#define __GMS_FP16_BULK_H__ 191020261400
+
+
+namespace  file_info
+{
+
+    const unsigned int GMS_FP16_BULK_MAJOR = 1U;
+    const unsigned int GMS_FP16_BULK_MINOR = 0U;
+    const unsigned int GMS_FP16_BULK_MICRO = 0U;
+    const unsigned int GMS_FP16_BULK_FULLVER =
+      1000U*GMS_FP16_BULK_MAJOR+100U*GMS_FP16_BULK_MINOR+10U*GMS_FP16_BULK_MICRO;
+    const char * const GMS_FP16_BULK_CREATE_DATE = "19-10-2026 14:00 +00200 (MON 19 OCT 2026 GMT+2)";
+    const char * const GMS_FP16_BULK_BUILD_DATE  = __DATE__ ":" __TIME__;
+    const char * const GMS_FP16_BULK_AUTHOR      =  "Programmer: Bernard Gingold, e-mail: beniekg@gmail.com";
+    const char * const GMS_FP16_BULK_DESCRIPT    =  "Bulk (F16C/AVX512) half <-> float conversion and fp16 storage compute kernels.";
+
+}
+
+#include <cstdint>
+#include <cstddef>
+#include <complex>
+#include "GMS_config.h"
+#include "GMS_half.h"
+
+/*
+    Bulk kernels for the half-precision storage containers (darray_r2_t,
+    darray_c2_t) and the fp16 signal generators.
+    Every kernel loads fp16, computes in fp32 and stores fp16 rounded to
+    nearest-even, i.e. the result is bit-identical to the element-wise
+    half_cast<half>() path of GMS_half.h (round_to_nearest style).
+    Code path selected at compile-time:
+    AVX512FP16 -- vcvtph2psx/vcvtps2phx, 16 elements per step.
+    AVX512F    -- vcvtph2ps/vcvtps2ph (zmm), 16 elements per step.
+    F16C       -- vcvtph2ps/vcvtps2ph (ymm), 8 elements per step.
+    otherwise  -- the scalar half_float conversions.
+    The remainder is converted through a zero-padded register-sized buffer,
+    hence no scalar tail loop. Complex arrays are interleaved (re,im) pairs.
+*/
+
+namespace gms
+{
+namespace common
+{
+
+const char * fp16_bulk_isa_name();
+
+// dst[i] = float(src[i])
+__ATTR_HOT__
+void cvt_f16_f32(const half_float::half * __restrict__,
+                 float * __restrict__,
+                 const std::size_t);
+
+// dst[i] = half(src[i])
+__ATTR_HOT__
+void cvt_f32_f16(const float * __restrict__,
+                 half_float::half * __restrict__,
+                 const std::size_t);
+
+__ATTR_HOT__
+void cvt_c2_c4(const std::complex<half_float::half> * __restrict__,
+               std::complex<float> * __restrict__,
+               const std::size_t);
+
+__ATTR_HOT__
+void cvt_c4_c2(const std::complex<float> * __restrict__,
+               std::complex<half_float::half> * __restrict__,
+               const std::size_t);
+
+// dst[i] = h
+__ATTR_HOT__
+void fill_f16(half_float::half * __restrict__,
+              const half_float::half,
+              const std::size_t);
+
+// x[i] = a*x[i]
+__ATTR_HOT__
+void scale_f16(half_float::half * __restrict__,
+               const float,
+               const std::size_t);
+
+// y[i] = a*x[i]+y[i]
+__ATTR_HOT__
+void axpy_f16(const float,
+              const half_float::half * __restrict__,
+              half_float::half * __restrict__,
+              const std::size_t);
+
+// z[i] = x[i]*y[i]
+__ATTR_HOT__
+void mul_f16(const half_float::half * __restrict__,
+             const half_float::half * __restrict__,
+             half_float::half * __restrict__,
+             const std::size_t);
+
+// sum(x[i]*y[i]), accumulated in fp32
+__ATTR_HOT__
+float dot_f16(const half_float::half * __restrict__,
+              const half_float::half * __restrict__,
+              const std::size_t);
+
+// z[i] = x[i]*y[i] (complex)
+__ATTR_HOT__
+void cmul_c2(const std::complex<half_float::half> * __restrict__,
+             const std::complex<half_float::half> * __restrict__,
+             std::complex<half_float::half> * __restrict__,
+             const std::size_t);
+
+}
+}
+
+#endif /*__GMS_FP16_BULK_H__*/
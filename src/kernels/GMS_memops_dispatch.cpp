@@ -0,0 +1,910 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#include <immintrin.h>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <omp.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+#include "GMS_memops_dispatch.h"
+#include "GMS_sse_memcpy.h"
+#include "GMS_sse_uncached_memcpy.h"
+#include "GMS_avx_memcpy.h"
+#include "GMS_avx_uncached_memcpy.h"
+#include "GMS_avx512_memcpy.h"
+#include "GMS_avx512_uncached_memcpy.h"
+#include "GMS_sse_memset.h"
+#include "GMS_setv_avx512_unroll16x.h"
+
+/*
+   Non-temporal fill kernels. The tree provides only temporal memset kernels,
+   the streaming variants are compiled here per ISA by the target attribute,
+   so that this translation unit may be built for the baseline x86-64 target.
+*/
+
+__attribute__((target("avx512f")))
+static void
+stream_set_zmm16r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     float * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 63) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m512 zmm0{_mm512_set1_ps(filler)};
+     while(sz >= 64ull)
+     {
+           _mm512_stream_ps(p_dst+0ull, zmm0);
+           _mm512_stream_ps(p_dst+16ull,zmm0);
+           _mm512_stream_ps(p_dst+32ull,zmm0);
+           _mm512_stream_ps(p_dst+48ull,zmm0);
+           sz    -= 64ull;
+           p_dst += 64ull;
+     }
+     while(sz >= 16ull)
+     {
+           _mm512_stream_ps(p_dst,zmm0);
+           sz    -= 16ull;
+           p_dst += 16ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+__attribute__((target("avx512f")))
+static void
+stream_set_zmm8r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     double * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 63) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m512d zmm0{_mm512_set1_pd(filler)};
+     while(sz >= 32ull)
+     {
+           _mm512_stream_pd(p_dst+0ull, zmm0);
+           _mm512_stream_pd(p_dst+8ull, zmm0);
+           _mm512_stream_pd(p_dst+16ull,zmm0);
+           _mm512_stream_pd(p_dst+24ull,zmm0);
+           sz    -= 32ull;
+           p_dst += 32ull;
+     }
+     while(sz >= 8ull)
+     {
+           _mm512_stream_pd(p_dst,zmm0);
+           sz    -= 8ull;
+           p_dst += 8ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+__attribute__((target("avx")))
+static void
+stream_set_ymm8r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     float * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 31) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m256 ymm0{_mm256_set1_ps(filler)};
+     while(sz >= 32ull)
+     {
+           _mm256_stream_ps(p_dst+0ull, ymm0);
+           _mm256_stream_ps(p_dst+8ull, ymm0);
+           _mm256_stream_ps(p_dst+16ull,ymm0);
+           _mm256_stream_ps(p_dst+24ull,ymm0);
+           sz    -= 32ull;
+           p_dst += 32ull;
+     }
+     while(sz >= 8ull)
+     {
+           _mm256_stream_ps(p_dst,ymm0);
+           sz    -= 8ull;
+           p_dst += 8ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+__attribute__((target("avx")))
+static void
+stream_set_ymm4r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     double * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 31) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m256d ymm0{_mm256_set1_pd(filler)};
+     while(sz >= 16ull)
+     {
+           _mm256_stream_pd(p_dst+0ull, ymm0);
+           _mm256_stream_pd(p_dst+4ull, ymm0);
+           _mm256_stream_pd(p_dst+8ull, ymm0);
+           _mm256_stream_pd(p_dst+12ull,ymm0);
+           sz    -= 16ull;
+           p_dst += 16ull;
+     }
+     while(sz >= 4ull)
+     {
+           _mm256_stream_pd(p_dst,ymm0);
+           sz    -= 4ull;
+           p_dst += 4ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+static void
+stream_set_xmm4r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     float * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 15) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m128 xmm0{_mm_set1_ps(filler)};
+     while(sz >= 16ull)
+     {
+           _mm_stream_ps(p_dst+0ull, xmm0);
+           _mm_stream_ps(p_dst+4ull, xmm0);
+           _mm_stream_ps(p_dst+8ull, xmm0);
+           _mm_stream_ps(p_dst+12ull,xmm0);
+           sz    -= 16ull;
+           p_dst += 16ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+static void
+stream_set_xmm2r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     double * __restrict__ p_dst{dst};
+     while(((uintptr_t)p_dst & 15) && sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+     const __m128d xmm0{_mm_set1_pd(filler)};
+     while(sz >= 8ull)
+     {
+           _mm_stream_pd(p_dst+0ull,xmm0);
+           _mm_stream_pd(p_dst+2ull,xmm0);
+           _mm_stream_pd(p_dst+4ull,xmm0);
+           _mm_stream_pd(p_dst+6ull,xmm0);
+           sz    -= 8ull;
+           p_dst += 8ull;
+     }
+     _mm_sfence();
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+/*
+   Temporal fills. The setv kernels take a 32-bit element count, hence the
+   outer loop.
+*/
+
+static void
+cached_set_zmm16r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     constexpr std::size_t maxn{1ull<<30};
+     while(sz)
+     {
+           const std::size_t n{std::min(sz,maxn)};
+           gms::math::ssetv_u_zmm16r4_unroll16x(static_cast<int32_t>(n),filler,dst,1);
+           dst += n;
+           sz  -= n;
+     }
+}
+
+static void
+cached_set_zmm8r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     constexpr std::size_t maxn{1ull<<30};
+     while(sz)
+     {
+           const std::size_t n{std::min(sz,maxn)};
+           gms::math::dsetv_u_zmm8r8_unroll16x(static_cast<int32_t>(n),filler,dst,1);
+           dst += n;
+           sz  -= n;
+     }
+}
+
+/*
+   256-bit temporal fills for the AVX row (the ymm setv kernels of
+   BLAS-kernels/GMS_setv_avx_unroll16x.cpp do not compile).
+*/
+
+__attribute__((target("avx")))
+static void
+cached_set_ymm8r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     float * __restrict__ p_dst{dst};
+     const __m256 ymm0{_mm256_set1_ps(filler)};
+     while(sz >= 32ull)
+     {
+           _mm256_storeu_ps(p_dst+0ull, ymm0);
+           _mm256_storeu_ps(p_dst+8ull, ymm0);
+           _mm256_storeu_ps(p_dst+16ull,ymm0);
+           _mm256_storeu_ps(p_dst+24ull,ymm0);
+           sz    -= 32ull;
+           p_dst += 32ull;
+     }
+     while(sz >= 8ull)
+     {
+           _mm256_storeu_ps(p_dst,ymm0);
+           sz    -= 8ull;
+           p_dst += 8ull;
+     }
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+__attribute__((target("avx")))
+static void
+cached_set_ymm4r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     double * __restrict__ p_dst{dst};
+     const __m256d ymm0{_mm256_set1_pd(filler)};
+     while(sz >= 16ull)
+     {
+           _mm256_storeu_pd(p_dst+0ull, ymm0);
+           _mm256_storeu_pd(p_dst+4ull, ymm0);
+           _mm256_storeu_pd(p_dst+8ull, ymm0);
+           _mm256_storeu_pd(p_dst+12ull,ymm0);
+           sz    -= 16ull;
+           p_dst += 16ull;
+     }
+     while(sz >= 4ull)
+     {
+           _mm256_storeu_pd(p_dst,ymm0);
+           sz    -= 4ull;
+           p_dst += 4ull;
+     }
+     while(sz)
+     {
+           *p_dst++ = filler;
+           sz--;
+     }
+}
+
+static void
+cached_set_xmm4r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     gms::common::sse_memset_unroll16x_ps(dst,filler,sz);
+}
+
+static void
+cached_set_xmm2r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     gms::common::sse_memset_unroll16x_pd(dst,filler,sz);
+}
+
+static void
+scalar_set_r4(float * __restrict__ dst,const float filler,std::size_t sz)
+{
+     std::fill(dst,dst+sz,filler);
+}
+
+static void
+scalar_set_r8(double * __restrict__ dst,const double filler,std::size_t sz)
+{
+     std::fill(dst,dst+sz,filler);
+}
+
+static void
+scalar_copy_r4(float * __restrict__ dst,float * __restrict__ src,std::size_t sz)
+{
+     std::memcpy(dst,src,sz*sizeof(float));
+}
+
+static void
+scalar_copy_r8(double * __restrict__ dst,double * __restrict__ src,std::size_t sz)
+{
+     std::memcpy(dst,src,sz*sizeof(double));
+}
+
+namespace
+{
+
+typedef void (*copy_r4_t)(float * __restrict__,float * __restrict__,std::size_t);
+typedef void (*copy_r8_t)(double * __restrict__,double * __restrict__,std::size_t);
+typedef void (*set_r4_t)(float * __restrict__,const float,std::size_t);
+typedef void (*set_r8_t)(double * __restrict__,const double,std::size_t);
+
+// Indexed by [isa][streaming].
+const copy_r4_t copy_r4_tab[4][2] = {
+      {&scalar_copy_r4,                                &scalar_copy_r4},
+      {&gms::common::sse_memcpy_unroll8x_ps,           &gms::common::sse_uncached_memcpy_unroll8x_ps},
+      {&gms::common::avx_memcpy_unroll8x_ps,           &gms::common::avx_uncached_memcpy_unroll8x_ps},
+      {&gms::common::avx512_memcpy_unroll8x_ps,        &gms::common::avx512_uncached_memcpy_unroll8x_ps}};
+
+const copy_r8_t copy_r8_tab[4][2] = {
+      {&scalar_copy_r8,                                &scalar_copy_r8},
+      {&gms::common::sse_memcpy_unroll8x_pd,           &gms::common::sse_uncached_memcpy_unroll8x_pd},
+      {&gms::common::avx_memcpy_unroll8x_pd,           &gms::common::avx_uncached_memcpy_unroll8x_pd},
+      {&gms::common::avx512_memcpy_unroll8x_pd,        &gms::common::avx512_uncached_memcpy_unroll8x_pd}};
+
+const set_r4_t set_r4_tab[4][2] = {
+      {&scalar_set_r4,      &scalar_set_r4},
+      {&cached_set_xmm4r4,  &stream_set_xmm4r4},
+      {&cached_set_ymm8r4,  &stream_set_ymm8r4},
+      {&cached_set_zmm16r4, &stream_set_zmm16r4}};
+
+const set_r8_t set_r8_tab[4][2] = {
+      {&scalar_set_r8,      &scalar_set_r8},
+      {&cached_set_xmm2r8,  &stream_set_xmm2r8},
+      {&cached_set_ymm4r8,  &stream_set_ymm4r8},
+      {&cached_set_zmm8r8,  &stream_set_zmm8r8}};
+
+// Alignment (bytes) the copy kernels require of (dst-src), per ISA.
+const std::size_t isa_vec_bytes[4] = {1ull,16ull,32ull,64ull};
+
+constexpr std::size_t page_bytes{4096ull};
+
+gms::common::memops_tuning_t g_tuning{};
+std::once_flag               g_once;
+std::once_flag               g_measure_once;
+#if defined(__linux__)
+std::vector<cpu_set_t>       g_node_cpus;
+#endif
+
+gms::common::memops_isa detect_isa()
+{
+       using gms::common::memops_isa;
+       __builtin_cpu_init();
+       if(__builtin_cpu_supports("avx512f")) return memops_isa::AVX512;
+       if(__builtin_cpu_supports("avx"))     return memops_isa::AVX;
+       if(__builtin_cpu_supports("sse2"))    return memops_isa::SSE;
+       return memops_isa::SCALAR;
+}
+
+std::size_t detect_llc_bytes()
+{
+       long llc{-1L};
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+       llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+       if(llc <= 0L) llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+       return (llc > 0L) ? static_cast<std::size_t>(llc) : 8ull*1048576ull;
+}
+
+#if defined(__linux__)
+bool parse_cpulist(const char * fname,cpu_set_t &set)
+{
+       FILE * fp{std::fopen(fname,"r")};
+       if(!fp) return false;
+       char buf[4096] = {};
+       const bool ok{std::fgets(buf,sizeof(buf),fp) != NULL};
+       std::fclose(fp);
+       if(!ok) return false;
+       CPU_ZERO(&set);
+       char * p{buf};
+       while(*p && *p != '\n')
+       {
+             char * end{NULL};
+             const long lo{std::strtol(p,&end,10)};
+             if(end == p) break;
+             long hi{lo};
+             p = end;
+             if(*p == '-')
+             {
+                 hi = std::strtol(p+1,&end,10);
+                 p  = end;
+             }
+             for(long c = lo; c <= hi && c < CPU_SETSIZE; ++c) CPU_SET(c,&set);
+             if(*p == ',') ++p;
+       }
+       return CPU_COUNT(&set) > 0;
+}
+
+/*
+   Online NUMA nodes, from the node list (ids may be sparse, e.g. "0,2-3").
+   g_node_cpus is indexed by the node id, absent and memory-only (CPU-less)
+   nodes have an empty set. Returns the number of online nodes.
+*/
+int32_t detect_numa_nodes()
+{
+       g_node_cpus.clear();
+       cpu_set_t online;
+       if(!parse_cpulist("/sys/devices/system/node/online",online))
+       {
+           // no online list: every node directory present
+           CPU_ZERO(&online);
+           for(int32_t n = 0; n < CPU_SETSIZE; ++n)
+           {
+                 char dname[128];
+                 std::snprintf(dname,sizeof(dname),"/sys/devices/system/node/node%d",n);
+                 if(access(dname,F_OK) == 0) CPU_SET(n,&online);
+           }
+       }
+       cpu_set_t none;
+       CPU_ZERO(&none);
+       int32_t count{0};
+       for(int32_t n = 0; n < CPU_SETSIZE; ++n)
+       {
+             if(!CPU_ISSET(n,&online)) continue;
+             ++count;
+             g_node_cpus.resize(static_cast<std::size_t>(n)+1ull,none);
+             char fname[128];
+             std::snprintf(fname,sizeof(fname),"/sys/devices/system/node/node%d/cpulist",n);
+             cpu_set_t set;
+             if(parse_cpulist(fname,set)) g_node_cpus[n] = set;
+       }
+       return count;
+}
+
+// NUMA node owning the page at p, -1 when not yet faulted-in or unknown.
+int32_t page_node(const void * p)
+{
+#if defined(SYS_move_pages)
+       void * pages[1] = {reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(p) & ~(page_bytes-1ull))};
+       int status[1]   = {-1};
+       const long ret{syscall(SYS_move_pages,0,1UL,pages,NULL,status,0)};
+       return (ret == 0L && status[0] >= 0) ? static_cast<int32_t>(status[0]) : -1;
+#else
+       return -1;
+#endif
+}
+#endif
+
+/*
+   Binds the calling thread to the node owning dst for the scope lifetime.
+*/
+struct node_binding_t
+{
+#if defined(__linux__)
+       cpu_set_t m_saved;
+       bool      m_bound;
+
+       explicit node_binding_t(const void * dst) : m_bound(false)
+       {
+            if(g_tuning.n_numa_nodes < 2) return;
+            const int32_t node{page_node(dst)};
+            if(node < 0 || node >= static_cast<int32_t>(g_node_cpus.size())) return;
+            if(CPU_COUNT(&g_node_cpus[node]) == 0) return; // memory-only node
+            if(pthread_getaffinity_np(pthread_self(),sizeof(m_saved),&m_saved) != 0) return;
+            m_bound = pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&g_node_cpus[node]) == 0;
+       }
+
+       ~node_binding_t()
+       {
+            if(m_bound) pthread_setaffinity_np(pthread_self(),sizeof(m_saved),&m_saved);
+       }
+#else
+       explicit node_binding_t(const void *) {}
+#endif
+};
+
+/*
+   Widest ISA not above the selected one whose copy kernels may be used for
+   this (dst,src) pair -- the kernels align dst and then issue aligned loads
+   from src.
+*/
+inline int32_t copy_isa(const void * dst,const void * src)
+{
+       const uintptr_t diff{reinterpret_cast<uintptr_t>(dst) ^ reinterpret_cast<uintptr_t>(src)};
+       int32_t isa{static_cast<int32_t>(g_tuning.isa)};
+       while(isa > 0 && (diff & (isa_vec_bytes[isa]-1ull))) --isa;
+       return isa;
+}
+
+inline std::size_t chunk_elems(const std::size_t n,const std::size_t esize,const int32_t nth)
+{
+       std::size_t chunk{(n*esize + static_cast<std::size_t>(nth) - 1ull) / static_cast<std::size_t>(nth)};
+       chunk = (chunk + page_bytes - 1ull) & ~(page_bytes - 1ull);
+       return chunk/esize;
+}
+
+inline int32_t team_size(const std::size_t nbytes,const std::size_t mt_bytes)
+{
+       if(nbytes < mt_bytes || g_tuning.max_threads < 2 || omp_in_parallel()) return 1;
+       const std::size_t nth{nbytes/MEMOPS_DISPATCH_MIN_CHUNK_BYTES};
+       return static_cast<int32_t>(std::max<std::size_t>(1ull,
+                                   std::min<std::size_t>(nth,static_cast<std::size_t>(g_tuning.max_threads))));
+}
+
+template<typename T,typename Copy>
+void copy_split(T * __restrict__ dst,T * __restrict__ src,const std::size_t n,
+                const int32_t nth,Copy copy)
+{
+       const std::size_t chunk{chunk_elems(n,sizeof(T),nth)};
+#pragma omp parallel num_threads(nth)
+       {
+              const std::size_t lo{static_cast<std::size_t>(omp_get_thread_num())*chunk};
+              if(lo < n)
+              {
+                  const std::size_t len{std::min(chunk,n-lo)};
+                  node_binding_t bind(dst+lo);
+                  copy(dst+lo,src+lo,len);
+              }
+       }
+}
+
+template<typename T,typename Set>
+void set_split(T * __restrict__ dst,const T filler,const std::size_t n,
+               const int32_t nth,Set set)
+{
+       const std::size_t chunk{chunk_elems(n,sizeof(T),nth)};
+#pragma omp parallel num_threads(nth)
+       {
+              const std::size_t lo{static_cast<std::size_t>(omp_get_thread_num())*chunk};
+              if(lo < n)
+              {
+                  const std::size_t len{std::min(chunk,n-lo)};
+                  node_binding_t bind(dst+lo);
+                  set(dst+lo,filler,len);
+              }
+       }
+}
+
+void detect_once();
+
+inline void init_tuning()
+{
+       std::call_once(g_once,&detect_once);
+}
+
+inline bool use_stream(const gms::common::memops_hint hint,const std::size_t nbytes,
+                       const std::size_t nt_bytes)
+{
+       using gms::common::memops_hint;
+       if(hint == memops_hint::STREAM) return true;
+       if(hint == memops_hint::CACHED) return false;
+       return nbytes >= nt_bytes;
+}
+
+template<typename T,typename CopyTab>
+void copy_impl(T * __restrict__ dst,const T * __restrict__ src,const std::size_t n,
+               const gms::common::memops_hint hint,const CopyTab &tab)
+{
+       const std::size_t nbytes{n*sizeof(T)};
+       if(nbytes < MEMOPS_DISPATCH_SMALL_BYTES)
+       {
+           std::memcpy(dst,src,nbytes);
+           return;
+       }
+       init_tuning();
+       const int32_t isa{copy_isa(dst,src)};
+       const auto copy{tab[isa][use_stream(hint,nbytes,g_tuning.nt_copy_bytes)]};
+       T * __restrict__ s{const_cast<T*>(src)};
+       const int32_t nth{team_size(nbytes,g_tuning.mt_copy_bytes)};
+       if(nth > 1)
+          copy_split(dst,s,n,nth,copy);
+       else
+          copy(dst,s,n);
+}
+
+template<typename T,typename SetTab>
+void set_impl(T * __restrict__ dst,const T filler,const std::size_t n,
+              const gms::common::memops_hint hint,const SetTab &tab)
+{
+       const std::size_t nbytes{n*sizeof(T)};
+       if(nbytes < MEMOPS_DISPATCH_SMALL_BYTES)
+       {
+           std::fill(dst,dst+n,filler);
+           return;
+       }
+       init_tuning();
+       const int32_t isa{static_cast<int32_t>(g_tuning.isa)};
+       const auto set{tab[isa][use_stream(hint,nbytes,g_tuning.nt_set_bytes)]};
+       const int32_t nth{team_size(nbytes,g_tuning.mt_set_bytes)};
+       if(nth > 1)
+          set_split(dst,filler,n,nth,set);
+       else
+          set(dst,filler,n);
+}
+
+#if (MEMOPS_DISPATCH_MEASURE_CROSSOVER) == 1
+
+// Best-of-reps time (seconds) of fn, each rep touching at least 16 MiB.
+template<typename Fn>
+double time_best(const std::size_t nbytes,Fn fn)
+{
+       const std::size_t inner{std::max<std::size_t>(1ull,(16ull*1048576ull)/nbytes)};
+       double best{1.0e+30};
+       fn(); // warm-up, faults-in the pages
+       for(int32_t r = 0; r != 3; ++r)
+       {
+             const auto t0{std::chrono::steady_clock::now()};
+             for(std::size_t i = 0ull; i != inner; ++i) fn();
+             const auto t1{std::chrono::steady_clock::now()};
+             best = std::min(best,std::chrono::duration<double>(t1-t0).count()/static_cast<double>(inner));
+       }
+       return best;
+}
+
+/*
+   Sweeps power-of-two sizes and returns the smallest size from which the
+   candidate is faster than the baseline at this and all larger sizes.
+   Returns SIZE_MAX when the candidate never wins.
+*/
+template<typename Base,typename Cand>
+std::size_t crossover(const std::size_t lo,const std::size_t hi,const double margin,
+                      Base base,Cand cand)
+{
+       std::size_t xover{SIZE_MAX};
+       for(std::size_t nbytes = hi; nbytes >= lo; nbytes >>= 1)
+       {
+             const double tb{time_best(nbytes,[&]{base(nbytes);})};
+             const double tc{time_best(nbytes,[&]{cand(nbytes);})};
+             if(tc*margin < tb)
+                xover = nbytes;
+             else
+                break;
+       }
+       return xover;
+}
+
+void measure_crossover(gms::common::memops_tuning_t &t)
+{
+       const std::size_t lo{256ull*1024ull};
+       std::size_t hi{lo};
+       const std::size_t cap{std::min<std::size_t>(4ull*t.llc_bytes,64ull*1048576ull)};
+       while(2ull*hi <= cap) hi *= 2ull;
+       const std::size_t n{hi/sizeof(float)};
+       float * dst{static_cast<float*>(std::aligned_alloc(page_bytes,hi))};
+       float * src{static_cast<float*>(std::aligned_alloc(page_bytes,hi))};
+       if(dst == NULL || src == NULL)
+       {
+           std::free(dst);
+           std::free(src);
+           return;
+       }
+       std::fill(src,src+n,1.0f);
+       std::fill(dst,dst+n,0.0f);
+       const int32_t isa{static_cast<int32_t>(t.isa)};
+       const copy_r4_t cp_c{copy_r4_tab[isa][0]}, cp_s{copy_r4_tab[isa][1]};
+       const set_r4_t  st_c{set_r4_tab[isa][0]},  st_s{set_r4_tab[isa][1]};
+       const std::size_t nt_copy{crossover(lo,hi,1.03,
+                  [&](std::size_t b){cp_c(dst,src,b/sizeof(float));},
+                  [&](std::size_t b){cp_s(dst,src,b/sizeof(float));})};
+       const std::size_t nt_set{crossover(lo,hi,1.03,
+                  [&](std::size_t b){st_c(dst,2.0f,b/sizeof(float));},
+                  [&](std::size_t b){st_s(dst,2.0f,b/sizeof(float));})};
+       // never stream below the point where the streaming kernel was measured to win
+       t.nt_copy_bytes = (nt_copy == SIZE_MAX) ? std::max<std::size_t>(t.nt_copy_bytes,2ull*hi) : nt_copy;
+       t.nt_set_bytes  = (nt_set  == SIZE_MAX) ? std::max<std::size_t>(t.nt_set_bytes, 2ull*hi) : nt_set;
+       if(t.max_threads > 1)
+       {
+           const std::size_t mlo{std::max<std::size_t>(lo,2ull*MEMOPS_DISPATCH_MIN_CHUNK_BYTES)};
+           g_tuning = t;
+           const std::size_t mt_copy{crossover(mlo,hi,1.10,
+                  [&](std::size_t b){
+                        const std::size_t m{b/sizeof(float)};
+                        copy_r4_tab[isa][b >= t.nt_copy_bytes](dst,src,m);},
+                  [&](std::size_t b){
+                        const std::size_t m{b/sizeof(float)};
+                        copy_split(dst,src,m,team_size(b,0ull),copy_r4_tab[isa][b >= t.nt_copy_bytes]);})};
+           const std::size_t mt_set{crossover(mlo,hi,1.10,
+                  [&](std::size_t b){
+                        const std::size_t m{b/sizeof(float)};
+                        set_r4_tab[isa][b >= t.nt_set_bytes](dst,2.0f,m);},
+                  [&](std::size_t b){
+                        const std::size_t m{b/sizeof(float)};
+                        set_split(dst,2.0f,m,team_size(b,0ull),set_r4_tab[isa][b >= t.nt_set_bytes]);})};
+           t.mt_copy_bytes = mt_copy;
+           t.mt_set_bytes  = mt_set;
+       }
+       t.measured = true;
+       std::free(dst);
+       std::free(src);
+}
+
+#endif
+
+void measure_once()
+{
+#if (MEMOPS_DISPATCH_MEASURE_CROSSOVER) == 1
+       gms::common::memops_tuning_t t{g_tuning};
+       measure_crossover(t);
+       g_tuning = t;
+#endif
+}
+
+// Detection and the LLC-derived defaults, no measurement unless GMS_MEMOPS_CALIBRATE=1.
+void detect_once()
+{
+       using namespace gms::common;
+       memops_tuning_t t{};
+       t.isa          = detect_isa();
+       t.llc_bytes    = detect_llc_bytes();
+       t.max_threads  = omp_get_max_threads();
+#if defined(__linux__)
+       t.n_numa_nodes = std::max<int32_t>(1,detect_numa_nodes());
+#else
+       t.n_numa_nodes = 1;
+#endif
+       // LLC-derived defaults (cf. the glibc non-temporal threshold of 3/4 of the shared cache).
+       t.nt_copy_bytes = (3ull*t.llc_bytes)/4ull;
+       t.nt_set_bytes  = (3ull*t.llc_bytes)/4ull;
+       t.mt_copy_bytes = (t.max_threads > 1) ? std::max<std::size_t>(t.llc_bytes,4ull*MEMOPS_DISPATCH_MIN_CHUNK_BYTES) : SIZE_MAX;
+       t.mt_set_bytes  = t.mt_copy_bytes;
+       t.measured      = false;
+       g_tuning = t;
+       const char * env{std::getenv("GMS_MEMOPS_CALIBRATE")};
+       if(env != NULL && std::atoi(env) != 0) std::call_once(g_measure_once,&measure_once);
+}
+
+#if (MEMOPS_DISPATCH_CALIBRATE_AT_STARTUP) == 1
+struct startup_calibration_t
+{
+       startup_calibration_t() { gms::common::memops_calibrate(); }
+} g_startup_calibration;
+#endif
+
+} // anonymous
+
+
+void
+gms::common::
+memops_calibrate()
+{
+      init_tuning();
+      std::call_once(g_measure_once,&measure_once);
+}
+
+const gms::common::memops_tuning_t &
+gms::common::
+memops_tuning()
+{
+      init_tuning();
+      return g_tuning;
+}
+
+void
+gms::common::
+memops_set_tuning(const memops_tuning_t &t)
+{
+      init_tuning();
+      // a later memops_calibrate() must not overwrite the tuning set here
+      std::call_once(g_measure_once,[]{});
+      g_tuning = t;
+      // the selected ISA must not exceed the executing CPU
+      g_tuning.isa = std::min(t.isa,detect_isa());
+}
+
+const char *
+gms::common::
+memops_isa_name(const memops_isa isa)
+{
+      switch(isa)
+      {
+           case memops_isa::AVX512 : return "AVX512";
+           case memops_isa::AVX    : return "AVX";
+           case memops_isa::SSE    : return "SSE";
+           default                 : return "SCALAR";
+      }
+}
+
+void
+gms::common::
+memops_print_tuning()
+{
+      const memops_tuning_t &t{memops_tuning()};
+      std::printf("[MEMOPS-DISPATCH]: isa=%s, llc=%zu bytes, threads=%d, numa_nodes=%d, measured=%d\n",
+                  memops_isa_name(t.isa),t.llc_bytes,t.max_threads,t.n_numa_nodes,static_cast<int>(t.measured));
+      std::printf("[MEMOPS-DISPATCH]: copy: non-temporal >= %zu bytes, multi-thread >= %zu bytes\n",
+                  t.nt_copy_bytes,t.mt_copy_bytes);
+      std::printf("[MEMOPS-DISPATCH]: set:  non-temporal >= %zu bytes, multi-thread >= %zu bytes\n",
+                  t.nt_set_bytes,t.mt_set_bytes);
+}
+
+void
+gms::common::
+memcpy_dispatch_ps(float * __restrict__ dst,
+                   const float * __restrict__ src,
+                   const std::size_t n,
+                   const memops_hint hint)
+{
+      copy_impl(dst,src,n,hint,copy_r4_tab);
+}
+
+void
+gms::common::
+memcpy_dispatch_pd(double * __restrict__ dst,
+                   const double * __restrict__ src,
+                   const std::size_t n,
+                   const memops_hint hint)
+{
+      copy_impl(dst,src,n,hint,copy_r8_tab);
+}
+
+void
+gms::common::
+memcpy_dispatch(void * __restrict__ dst,
+                const void * __restrict__ src,
+                const std::size_t nbytes,
+                const memops_hint hint)
+{
+      // The float kernels copy bit patterns only, any 4-byte granular block qualifies.
+      if((nbytes & 3ull) || (reinterpret_cast<uintptr_t>(dst) & 3ull) ||
+         (reinterpret_cast<uintptr_t>(src) & 3ull))
+      {
+          std::memcpy(dst,src,nbytes);
+          return;
+      }
+      copy_impl(static_cast<float*>(dst),static_cast<const float*>(src),nbytes>>2,hint,copy_r4_tab);
+}
+
+void
+gms::common::
+memset_dispatch_ps(float * __restrict__ dst,
+                   const float filler,
+                   const std::size_t n,
+                   const memops_hint hint)
+{
+      set_impl(dst,filler,n,hint,set_r4_tab);
+}
+
+void
+gms::common::
+memset_dispatch_pd(double * __restrict__ dst,
+                   const double filler,
+                   const std::size_t n,
+                   const memops_hint hint)
+{
+      set_impl(dst,filler,n,hint,set_r8_tab);
+}
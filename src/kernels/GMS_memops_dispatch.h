@@ -0,0 +1,169 @@
+/*MIT License
+!Copyright (c) 2020 Bernard Gingold
+!Permission is hereby granted, free of charge, to any person obtaining a copy
+!of this software and associated documentation files (the "Software"), to deal
+!in the Software without restriction, including without limitation the rights
+!to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+!copies of the Software, and to permit persons to whom the Software is
+!furnished to do so, subject to the following conditions:
+!The above copyright notice and this permission notice shall be included in all
+!copies or substantial portions of the Software.
+!THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+!IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+!FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+!AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+!LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+!OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+!SOFTWARE.
+!*/
+
+#ifndef __GMS_MEMOPS_DISPATCH_H__
+#define __GMS_MEMOPS_DISPATCH_H__ 191020260900
+
+
+namespace  file_info
+{
+
+    const unsigned int GMS_MEMOPS_DISPATCH_MAJOR = 1U;
+    const unsigned int GMS_MEMOPS_DISPATCH_MINOR = 0U;
+    const unsigned int GMS_MEMOPS_DISPATCH_MICRO = 0U;
+    const unsigned int GMS_MEMOPS_DISPATCH_FULLVER =
+      1000U*GMS_MEMOPS_DISPATCH_MAJOR+100U*GMS_MEMOPS_DISPATCH_MINOR+10U*GMS_MEMOPS_DISPATCH_MICRO;
+    const char * const GMS_MEMOPS_DISPATCH_CREATE_DATE = "19-10-2026 09:00 +00200 (MON 19 OCT 2026 GMT+2)";
+    const char * const GMS_MEMOPS_DISPATCH_BUILD_DATE  = __DATE__ ":" __TIME__;
+    const char * const GMS_MEMOPS_DISPATCH_AUTHOR      =  "Programmer: Bernard Gingold, e-mail: beniekg@gmail.com";
+    const char * const GMS_MEMOPS_DISPATCH_DESCRIPT    =  "Calibrated runtime dispatcher for the SSE/AVX/AVX512 memcpy/memset kernels.";
+
+}
+
+#include <cstdint>
+#include <cstddef>
+#include "GMS_config.h"
+
+/*
+    The dispatcher selects at run-time among the cached and the non-temporal
+    (uncached) copy kernels and the memset kernels of the widest ISA supported
+    by the executing CPU. The first call detects the ISA, LLC size, thread
+    count and NUMA nodes and uses crossover points (cached -> streaming,
+    single-thread -> multi-thread) derived from the LLC size. The crossover
+    points are measured only by memops_calibrate(), at static initialization
+    with MEMOPS_DISPATCH_CALIBRATE_AT_STARTUP, or on the first call when the
+    environment variable GMS_MEMOPS_CALIBRATE is non-zero. The measurement
+    sweeps buffers of up to min(4*LLC,64 MiB) and takes on the order of a
+    second; it stalls whichever call runs it.
+    Copies above the multi-thread threshold are split into page-aligned
+    chunks, each worker thread is temporarily bound to the NUMA node which
+    owns its destination chunk.
+*/
+
+// Detect and measure during static initialization.
+#if !defined(MEMOPS_DISPATCH_CALIBRATE_AT_STARTUP)
+#define MEMOPS_DISPATCH_CALIBRATE_AT_STARTUP 0
+#endif
+
+// memops_calibrate() measures the crossover points (1), or keeps the LLC-derived ones (0).
+#if !defined(MEMOPS_DISPATCH_MEASURE_CROSSOVER)
+#define MEMOPS_DISPATCH_MEASURE_CROSSOVER 1
+#endif
+
+// Below this size (in bytes) the call is forwarded to std::memcpy/std::fill.
+#if !defined(MEMOPS_DISPATCH_SMALL_BYTES)
+#define MEMOPS_DISPATCH_SMALL_BYTES 256ull
+#endif
+
+// Smallest per-thread chunk (in bytes) of a multi-threaded copy.
+#if !defined(MEMOPS_DISPATCH_MIN_CHUNK_BYTES)
+#define MEMOPS_DISPATCH_MIN_CHUNK_BYTES 1048576ull
+#endif
+
+namespace gms
+{
+namespace common
+{
+
+enum class memops_isa : int32_t
+{
+      SCALAR = 0,
+      SSE    = 1,
+      AVX    = 2,
+      AVX512 = 3
+};
+
+enum class memops_hint : int32_t
+{
+      AUTO   = 0, // calibrated choice
+      CACHED = 1, // force temporal stores
+      STREAM = 2  // force non-temporal stores
+};
+
+struct memops_tuning_t
+{
+       std::size_t nt_copy_bytes;  // copies >= this use non-temporal stores
+       std::size_t mt_copy_bytes;  // copies >= this are split across threads
+       std::size_t nt_set_bytes;   // fills  >= this use non-temporal stores
+       std::size_t mt_set_bytes;   // fills  >= this are split across threads
+       std::size_t llc_bytes;
+       int32_t     max_threads;
+       int32_t     n_numa_nodes;
+       memops_isa  isa;
+       bool        measured;
+};
+
+/*
+    Detects the ISA, LLC size, thread count and NUMA topology and measures
+    the crossover points (unless MEMOPS_DISPATCH_MEASURE_CROSSOVER is 0).
+    Thread-safe and idempotent; call it before the copies run concurrently
+    on other threads, since it replaces the tuning they read.
+*/
+__ATTR_COLD__
+void memops_calibrate();
+
+const memops_tuning_t & memops_tuning();
+
+/*
+    Overrides the calibrated (or default) tuning, e.g. for reproducible
+    benchmarking. Implies calibration has taken place.
+*/
+__ATTR_COLD__
+void memops_set_tuning(const memops_tuning_t &);
+
+__ATTR_COLD__
+void memops_print_tuning();
+
+const char * memops_isa_name(const memops_isa);
+
+__ATTR_HOT__
+void memcpy_dispatch_ps(float * __restrict__,
+                        const float * __restrict__,
+                        const std::size_t,
+                        const memops_hint hint = memops_hint::AUTO);
+
+__ATTR_HOT__
+void memcpy_dispatch_pd(double * __restrict__,
+                        const double * __restrict__,
+                        const std::size_t,
+                        const memops_hint hint = memops_hint::AUTO);
+
+// Byte count interface, used by the containers of non-float element types.
+__ATTR_HOT__
+void memcpy_dispatch(void * __restrict__,
+                     const void * __restrict__,
+                     const std::size_t,
+                     const memops_hint hint = memops_hint::AUTO);
+
+__ATTR_HOT__
+void memset_dispatch_ps(float * __restrict__,
+                        const float,
+                        const std::size_t,
+                        const memops_hint hint = memops_hint::AUTO);
+
+__ATTR_HOT__
+void memset_dispatch_pd(double * __restrict__,
+                        const double,
+                        const std::size_t,
+                        const memops_hint hint = memops_hint::AUTO);
+
+} // common
+} // gms
+
+#endif /*__GMS_MEMOPS_DISPATCH_H__*/
@@ -0,0 +1,314 @@
+
+#include <immintrin.h>
+#include <algorithm>
+#include "GMS_rigid_body_6dof_zmm16r4.h"
+#include "GMS_par_team.h"
+#include "GMS_sleefsimdsp.h"
+
+namespace {
+
+        typedef struct RBRegs {
+
+                __m512 q0,q1,q2,q3;
+                __m512 wx,wy,wz;
+                __m512 pn,pe,pd;
+                __m512 vn,ve,vd;
+        } RBRegs;
+
+        // Per register constants of a call: Euler coefficients, torque/inertia, force.
+        typedef struct RBConst {
+
+                __m512 a1,a2,a3;      // (iy-iz)/ix, (iz-ix)/iy, (ix-iy)/iz
+                __m512 ax,ay,az;      // tau/i
+                __m512 fx,fy,fz;
+                __m512 g;
+        } RBConst;
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        __m512 ld_or_0(const __m512 * __restrict p,
+                       const int32_t i) {
+             return ((p != nullptr) ? p[i] : _mm512_setzero_ps());
+        }
+
+        /*
+             Right-hand side; the rotation of the force uses the unit-quaternion
+             form of R (|q| = 1 to O(dt^5) between the renormalizations).
+        */
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_deriv(const RBRegs & x,
+                      const RBConst & c,
+                      RBRegs & d) {
+             const __m512 h{_mm512_set1_ps(0.5f)};
+             const __m512 two{_mm512_set1_ps(2.0f)};
+             // dq = 1/2*q*(0,w)
+             d.q0 = _mm512_mul_ps(_mm512_set1_ps(-0.5f),_mm512_fmadd_ps(x.q1,x.wx,_mm512_fmadd_ps(x.q2,x.wy,_mm512_mul_ps(x.q3,x.wz))));
+             d.q1 = _mm512_mul_ps(h,_mm512_fmadd_ps(x.q0,x.wx,_mm512_fmsub_ps(x.q2,x.wz,_mm512_mul_ps(x.q3,x.wy))));
+             d.q2 = _mm512_mul_ps(h,_mm512_fmadd_ps(x.q0,x.wy,_mm512_fmsub_ps(x.q3,x.wx,_mm512_mul_ps(x.q1,x.wz))));
+             d.q3 = _mm512_mul_ps(h,_mm512_fmadd_ps(x.q0,x.wz,_mm512_fmsub_ps(x.q1,x.wy,_mm512_mul_ps(x.q2,x.wx))));
+             // Euler
+             d.wx = _mm512_fmadd_ps(c.a1,_mm512_mul_ps(x.wy,x.wz),c.ax);
+             d.wy = _mm512_fmadd_ps(c.a2,_mm512_mul_ps(x.wz,x.wx),c.ay);
+             d.wz = _mm512_fmadd_ps(c.a3,_mm512_mul_ps(x.wx,x.wy),c.az);
+             d.pn = x.vn;
+             d.pe = x.ve;
+             d.pd = x.vd;
+             // R*f, R = I+2*q0*[v]x+2*[v]x^2, v = (q1,q2,q3): t = 2*v x f, R*f = f+q0*t+v x t
+             const __m512 tx{_mm512_mul_ps(two,_mm512_fmsub_ps(x.q2,c.fz,_mm512_mul_ps(x.q3,c.fy)))};
+             const __m512 ty{_mm512_mul_ps(two,_mm512_fmsub_ps(x.q3,c.fx,_mm512_mul_ps(x.q1,c.fz)))};
+             const __m512 tz{_mm512_mul_ps(two,_mm512_fmsub_ps(x.q1,c.fy,_mm512_mul_ps(x.q2,c.fx)))};
+             d.vn = _mm512_add_ps(_mm512_fmadd_ps(x.q0,tx,c.fx),_mm512_fmsub_ps(x.q2,tz,_mm512_mul_ps(x.q3,ty)));
+             d.ve = _mm512_add_ps(_mm512_fmadd_ps(x.q0,ty,c.fy),_mm512_fmsub_ps(x.q3,tx,_mm512_mul_ps(x.q1,tz)));
+             d.vd = _mm512_add_ps(_mm512_add_ps(_mm512_fmadd_ps(x.q0,tz,c.fz),_mm512_fmsub_ps(x.q1,ty,_mm512_mul_ps(x.q2,tx))),c.g);
+        }
+
+#define RB_AXPY(o,x,k,d) \
+        o.q0 = _mm512_fmadd_ps(k,d.q0,x.q0); o.q1 = _mm512_fmadd_ps(k,d.q1,x.q1); \
+        o.q2 = _mm512_fmadd_ps(k,d.q2,x.q2); o.q3 = _mm512_fmadd_ps(k,d.q3,x.q3); \
+        o.wx = _mm512_fmadd_ps(k,d.wx,x.wx); o.wy = _mm512_fmadd_ps(k,d.wy,x.wy); \
+        o.wz = _mm512_fmadd_ps(k,d.wz,x.wz); o.pn = _mm512_fmadd_ps(k,d.pn,x.pn); \
+        o.pe = _mm512_fmadd_ps(k,d.pe,x.pe); o.pd = _mm512_fmadd_ps(k,d.pd,x.pd); \
+        o.vn = _mm512_fmadd_ps(k,d.vn,x.vn); o.ve = _mm512_fmadd_ps(k,d.ve,x.ve); \
+        o.vd = _mm512_fmadd_ps(k,d.vd,x.vd);
+
+#define RB_SCALE(o,k,d) \
+        o.q0 = _mm512_mul_ps(k,d.q0); o.q1 = _mm512_mul_ps(k,d.q1); \
+        o.q2 = _mm512_mul_ps(k,d.q2); o.q3 = _mm512_mul_ps(k,d.q3); \
+        o.wx = _mm512_mul_ps(k,d.wx); o.wy = _mm512_mul_ps(k,d.wy); \
+        o.wz = _mm512_mul_ps(k,d.wz); o.pn = _mm512_mul_ps(k,d.pn); \
+        o.pe = _mm512_mul_ps(k,d.pe); o.pd = _mm512_mul_ps(k,d.pd); \
+        o.vn = _mm512_mul_ps(k,d.vn); o.ve = _mm512_mul_ps(k,d.ve); \
+        o.vd = _mm512_mul_ps(k,d.vd);
+
+        // Low parts of the positions and velocities, compensated sums over the steps of a call.
+        typedef struct RBComp {
+
+                __m512 pn,pe,pd;
+                __m512 vn,ve,vd;
+        } RBComp;
+
+        // x += d+c, c the rounding error of the sum (Fast2Sum, |x| >= |d|)
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void kahan_add(__m512 & x,
+                       __m512 & c,
+                       const __m512 d) {
+             const __m512 y{_mm512_add_ps(d,c)};
+             const __m512 t{_mm512_add_ps(x,y)};
+             c = _mm512_sub_ps(y,_mm512_sub_ps(t,x));
+             x = t;
+        }
+
+        /*
+             Classic RK4: x += dt/6*(k1+2*k2+2*k3+k4), the increment summed
+             apart, added to p and v compensated (a float position of 10^5 m
+             has an ulp of 8 mm, a step adds a few m).
+        */
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_rk4(RBRegs & x,
+                    RBComp & e,
+                    const RBConst & c,
+                    const __m512 dt) {
+             const __m512 hdt{_mm512_mul_ps(_mm512_set1_ps(0.5f),dt)};
+             const __m512 dt6{_mm512_mul_ps(_mm512_set1_ps(1.0f/6.0f),dt)};
+             const __m512 dt3{_mm512_mul_ps(_mm512_set1_ps(1.0f/3.0f),dt)};
+             RBRegs k,y,acc;
+             rb_deriv(x,c,k);
+             RB_SCALE(acc,dt6,k)
+             RB_AXPY(y,x,hdt,k)
+             rb_deriv(y,c,k);
+             RB_AXPY(acc,acc,dt3,k)
+             RB_AXPY(y,x,hdt,k)
+             rb_deriv(y,c,k);
+             RB_AXPY(acc,acc,dt3,k)
+             RB_AXPY(y,x,dt,k)
+             rb_deriv(y,c,k);
+             RB_AXPY(acc,acc,dt6,k)
+             x.q0 = _mm512_add_ps(x.q0,acc.q0);
+             x.q1 = _mm512_add_ps(x.q1,acc.q1);
+             x.q2 = _mm512_add_ps(x.q2,acc.q2);
+             x.q3 = _mm512_add_ps(x.q3,acc.q3);
+             x.wx = _mm512_add_ps(x.wx,acc.wx);
+             x.wy = _mm512_add_ps(x.wy,acc.wy);
+             x.wz = _mm512_add_ps(x.wz,acc.wz);
+             kahan_add(x.pn,e.pn,acc.pn);
+             kahan_add(x.pe,e.pe,acc.pe);
+             kahan_add(x.pd,e.pd,acc.pd);
+             kahan_add(x.vn,e.vn,acc.vn);
+             kahan_add(x.ve,e.ve,acc.ve);
+             kahan_add(x.vd,e.vd,acc.vd);
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_renorm(RBRegs & x) {
+             const __m512 s{_mm512_fmadd_ps(x.q0,x.q0,_mm512_fmadd_ps(x.q1,x.q1,
+                            _mm512_fmadd_ps(x.q2,x.q2,_mm512_mul_ps(x.q3,x.q3))))};
+             const __m512 r{_mm512_div_ps(_mm512_set1_ps(1.0f),_mm512_sqrt_ps(s))};
+             x.q0 = _mm512_mul_ps(x.q0,r);
+             x.q1 = _mm512_mul_ps(x.q1,r);
+             x.q2 = _mm512_mul_ps(x.q2,r);
+             x.q3 = _mm512_mul_ps(x.q3,r);
+        }
+
+        // R(q/|q|) body-to-NED: R = I+s*(q0*[v]x+[v]x^2), s = 2/|q|^2
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_rmat(const __m512 q0,
+                     const __m512 q1,
+                     const __m512 q2,
+                     const __m512 q3,
+                     __m512 r[9]) {
+             const __m512 one{_mm512_set1_ps(1.0f)};
+             const __m512 nq{_mm512_fmadd_ps(q0,q0,_mm512_fmadd_ps(q1,q1,_mm512_fmadd_ps(q2,q2,_mm512_mul_ps(q3,q3))))};
+             const __m512 s{_mm512_div_ps(_mm512_set1_ps(2.0f),nq)};
+             const __m512 sq1{_mm512_mul_ps(s,q1)},sq2{_mm512_mul_ps(s,q2)},sq3{_mm512_mul_ps(s,q3)};
+             const __m512 q11{_mm512_mul_ps(sq1,q1)},q22{_mm512_mul_ps(sq2,q2)},q33{_mm512_mul_ps(sq3,q3)};
+             const __m512 q12{_mm512_mul_ps(sq1,q2)},q13{_mm512_mul_ps(sq1,q3)},q23{_mm512_mul_ps(sq2,q3)};
+             const __m512 q01{_mm512_mul_ps(sq1,q0)},q02{_mm512_mul_ps(sq2,q0)},q03{_mm512_mul_ps(sq3,q0)};
+             r[0] = _mm512_sub_ps(one,_mm512_add_ps(q22,q33));
+             r[1] = _mm512_sub_ps(q12,q03);
+             r[2] = _mm512_add_ps(q13,q02);
+             r[3] = _mm512_add_ps(q12,q03);
+             r[4] = _mm512_sub_ps(one,_mm512_add_ps(q11,q33));
+             r[5] = _mm512_sub_ps(q23,q01);
+             r[6] = _mm512_sub_ps(q13,q02);
+             r[7] = _mm512_add_ps(q23,q01);
+             r[8] = _mm512_sub_ps(one,_mm512_add_ps(q11,q22));
+        }
+
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_store_rmat(const gms::math::RB6DofRMat9x16 & m,
+                           const int32_t i,
+                           const __m512 r[9]) {
+             m.row1[i] = r[0]; m.row2[i] = r[1]; m.row3[i] = r[2];
+             m.row4[i] = r[3]; m.row5[i] = r[4]; m.row6[i] = r[5];
+             m.row7[i] = r[6]; m.row8[i] = r[7]; m.row9[i] = r[8];
+        }
+
+        // LOS to the target in body axes: u_b = R^T*(t-p)/|t-p|.
+        __ATTR_ALWAYS_INLINE__
+        static inline
+        void rb_los(const gms::math::RB6DofLOS & o,
+                    const int32_t i,
+                    const RBRegs & x,
+                    const __m512 r[9]) {
+             const __m512 tn{(o.tn != nullptr) ? o.tn[i] : _mm512_set1_ps(o.tgt[0])};
+             const __m512 te{(o.te != nullptr) ? o.te[i] : _mm512_set1_ps(o.tgt[1])};
+             const __m512 td{(o.td != nullptr) ? o.td[i] : _mm512_set1_ps(o.tgt[2])};
+             const __m512 dn{_mm512_sub_ps(tn,x.pn)},de{_mm512_sub_ps(te,x.pe)},dd{_mm512_sub_ps(td,x.pd)};
+             const __m512 rg{_mm512_sqrt_ps(_mm512_fmadd_ps(dn,dn,_mm512_fmadd_ps(de,de,_mm512_mul_ps(dd,dd))))};
+             const __m512 ir{_mm512_div_ps(_mm512_set1_ps(1.0f),rg)};
+             const __m512 ux{_mm512_mul_ps(ir,_mm512_fmadd_ps(r[0],dn,_mm512_fmadd_ps(r[3],de,_mm512_mul_ps(r[6],dd))))};
+             const __m512 uy{_mm512_mul_ps(ir,_mm512_fmadd_ps(r[1],dn,_mm512_fmadd_ps(r[4],de,_mm512_mul_ps(r[7],dd))))};
+             const __m512 uz{_mm512_mul_ps(ir,_mm512_fmadd_ps(r[2],dn,_mm512_fmadd_ps(r[5],de,_mm512_mul_ps(r[8],dd))))};
+             if(o.ux  != nullptr) o.ux[i]  = ux;
+             if(o.uy  != nullptr) o.uy[i]  = uy;
+             if(o.uz  != nullptr) o.uz[i]  = uz;
+             if(o.rng != nullptr) o.rng[i] = rg;
+             const __m512 rho{_mm512_sqrt_ps(_mm512_fmadd_ps(ux,ux,_mm512_mul_ps(uy,uy)))};
+             if(o.tht != nullptr) o.tht[i] = xatan2f(rho,uz);
+             if(o.phi != nullptr || o.az != nullptr)
+             {
+                const __m512 a{xatan2f(uy,ux)};
+                if(o.phi != nullptr) o.phi[i] = a;
+                if(o.az  != nullptr) o.az[i]  = a;
+             }
+             if(o.el != nullptr) o.el[i] = xatan2f(_mm512_sub_ps(_mm512_setzero_ps(),uz),rho);
+        }
+
+}
+
+void
+gms::math::rb6dof_propagate_range_zmm16r4(const RB6DofState & s,
+                                          const RB6DofLoads & l,
+                                          const RB6DofParams & p,
+                                          const int32_t nsteps,
+                                          const int32_t lo,
+                                          const int32_t hi,
+                                          const RB6DofRMat9x16 * rmat,
+                                          const RB6DofLOS * los) {
+     const __m512 dt{_mm512_set1_ps(p.dt)};
+     const __m512 one{_mm512_set1_ps(1.0f)};
+     const int64_t re{static_cast<int64_t>(p.renorm_every)};
+     for(int32_t __i{lo}; __i < hi; ++__i)
+     {
+          RBRegs x;
+          x.q0 = s.q0[__i]; x.q1 = s.q1[__i]; x.q2 = s.q2[__i]; x.q3 = s.q3[__i];
+          x.wx = s.wx[__i]; x.wy = s.wy[__i]; x.wz = s.wz[__i];
+          x.pn = s.pn[__i]; x.pe = s.pe[__i]; x.pd = s.pd[__i];
+          x.vn = s.vn[__i]; x.ve = s.ve[__i]; x.vd = s.vd[__i];
+          RBConst c;
+          if(nsteps > 0)
+          {
+             const __m512 ix{l.ix[__i]},iy{l.iy[__i]},iz{l.iz[__i]};
+             const __m512 rx{_mm512_div_ps(one,ix)},ry{_mm512_div_ps(one,iy)},rz{_mm512_div_ps(one,iz)};
+             c.a1 = _mm512_mul_ps(_mm512_sub_ps(iy,iz),rx);
+             c.a2 = _mm512_mul_ps(_mm512_sub_ps(iz,ix),ry);
+             c.a3 = _mm512_mul_ps(_mm512_sub_ps(ix,iy),rz);
+             c.ax = _mm512_mul_ps(ld_or_0(l.tx,__i),rx);
+             c.ay = _mm512_mul_ps(ld_or_0(l.ty,__i),ry);
+             c.az = _mm512_mul_ps(ld_or_0(l.tz,__i),rz);
+             c.fx = ld_or_0(l.fx,__i);
+             c.fy = ld_or_0(l.fy,__i);
+             c.fz = ld_or_0(l.fz,__i);
+             c.g  = _mm512_set1_ps(p.g);
+          }
+          RBComp e;
+          e.pn = e.pe = e.pd = e.vn = e.ve = e.vd = _mm512_setzero_ps();
+          for(int32_t __k{0}; __k < nsteps; ++__k)
+          {
+               rb_rk4(x,e,c,dt);
+               if(re > 0 && (s.nstep+__k+1)%re == 0) rb_renorm(x);
+          }
+          s.q0[__i] = x.q0; s.q1[__i] = x.q1; s.q2[__i] = x.q2; s.q3[__i] = x.q3;
+          s.wx[__i] = x.wx; s.wy[__i] = x.wy; s.wz[__i] = x.wz;
+          s.pn[__i] = x.pn; s.pe[__i] = x.pe; s.pd[__i] = x.pd;
+          s.vn[__i] = x.vn; s.ve[__i] = x.ve; s.vd[__i] = x.vd;
+          if(rmat != nullptr || los != nullptr)
+          {
+             __m512 r[9];
+             rb_rmat(x.q0,x.q1,x.q2,x.q3,r);
+             if(rmat != nullptr) rb_store_rmat(*rmat,__i,r);
+             if(los  != nullptr) rb_los(*los,__i,x,r);
+          }
+     }
+}
+
+void
+gms::math::rb6dof_propagate_zmm16r4(RB6DofState & s,
+                                    const RB6DofLoads & l,
+                                    const RB6DofParams & p,
+                                    const int32_t nsteps,
+                                    const int32_t n,
+                                    const RB6DofRMat9x16 * rmat,
+                                    const RB6DofLOS * los) {
+     using namespace gms::common;
+     if(n > 0)
+     {
+        const RB6DofState & cs{s};
+        // RK4 of a register: ~400 flops a step
+        const par_family fam{(nsteps > 1) ? par_family::SERIES : par_family::ARITH};
+        par_for(fam,static_cast<std::size_t>(n),sizeof(__m512),1,
+                [&](const std::size_t lo,const std::size_t hi) {
+                     rb6dof_propagate_range_zmm16r4(cs,l,p,nsteps,static_cast<int32_t>(lo),
+                                                    static_cast<int32_t>(hi),rmat,los);
+                });
+     }
+     s.nstep += static_cast<int64_t>(std::max(nsteps,0));
+}
+
+void
+gms::math::rb6dof_rmat9x16_zmm16r4(const RB6DofState & s,
+                                   const int32_t n,
+                                   const RB6DofRMat9x16 & rmat) {
+     for(int32_t __i{0}; __i < n; ++__i)
+     {
+          __m512 r[9];
+          rb_rmat(s.q0[__i],s.q1[__i],s.q2[__i],s.q3[__i],r);
+          rb_store_rmat(rmat,__i,r);
+     }
+}
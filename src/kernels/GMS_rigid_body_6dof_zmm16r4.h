@@ -0,0 +1,210 @@
+
+#ifndef __GMS_RIGID_BODY_6DOF_ZMM16R4_H__
+#define __GMS_RIGID_BODY_6DOF_ZMM16R4_H__ 251020260910
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info {
+
+   const unsigned int GMS_RIGID_BODY_6DOF_ZMM16R4_MAJOR = 1U;
+   const unsigned int GMS_RIGID_BODY_6DOF_ZMM16R4_MINOR = 0U;
+   const unsigned int GMS_RIGID_BODY_6DOF_ZMM16R4_MICRO = 0U;
+   const unsigned int GMS_RIGID_BODY_6DOF_ZMM16R4_FULLVER =
+    1000U*GMS_RIGID_BODY_6DOF_ZMM16R4_MAJOR+
+    100U*GMS_RIGID_BODY_6DOF_ZMM16R4_MINOR+
+    10U*GMS_RIGID_BODY_6DOF_ZMM16R4_MICRO;
+   const char * const GMS_RIGID_BODY_6DOF_ZMM16R4_CREATE_DATE = "25-10-2026 09:10 +00200 (SUN 25 OCT 2026 GMT+2)";
+   const char * const GMS_RIGID_BODY_6DOF_ZMM16R4_BUILD_DATE  = __DATE__ ":" __TIME__;
+   const char * const GMS_RIGID_BODY_6DOF_ZMM16R4_AUTHOR      = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+   const char * const GMS_RIGID_BODY_6DOF_ZMM16R4_DESCRIPTION = "Batched 6-DOF rigid body propagator (RK4, quaternion attitude) AVX512, 9x16 rotation matrix output.";
+}
+
+/*
+     Batched 6-DOF rigid bodies (platforms, projectiles) over a flat earth,
+     NED axes, 16 bodies per __m512, state in SoA registers:
+          q0..q3   -- attitude quaternion body-to-NED (q0 scalar part), a body
+                      vector is v_ned = q*v_b*conj(q),
+          wx,wy,wz -- body rates [rad/s] in the principal (FRD) body axes,
+          pn,pe,pd -- position [m], vn,ve,vd -- velocity [m/s], NED.
+     Equations of motion, the loads held over a step:
+          dq/dt = 1/2*q*(0,w),
+          J*dw/dt = tau-w x (J*w), J = diag(ix,iy,iz),
+          dp/dt = v,   dv/dt = R(q)*f+(0,0,g),
+     f -- specific force (thrust and aerodynamic force over the mass) in body
+     axes. Classic RK4 steps, q renormalized every renorm_every steps (the
+     drift of |q| of RK4 is O(dt^5) a step). Position and velocity are
+     summed with compensation (Fast2Sum) over the steps of a call; the
+     residual is not kept in the state, so the same steps split over more
+     calls round differently in the last bits.
+     rb6dof_propagate_zmm16r4 runs nsteps steps of every register of bodies
+     with its state in registers (one load and one store of the state per
+     call, not per step) and then, from the same registers:
+          the rotation matrix body-to-NED R = C(n<-b), 9x16 SoA (row1..row9 =
+          R11,R12,R13,R21,...,R33, the layout of q4x16_rm9x16_looped_*),
+          from q/|q| (orthogonal also for an unnormalized q),
+          the line of sight to a target point (per body or common), in body
+          axes: aspect angles (tht,phi) of the PO RCS (po_rcs_monostatic_omp)
+          and of the plane-wave chain (PW_Inputs::tht/phi), u = (sin(tht)*
+          cos(phi),sin(tht)*sin(phi),cos(tht)); antenna pointing az =
+          atan2(uy,ux), el = atan2(-uz,sqrt(ux^2+uy^2)) (FRD: up positive);
+          range.
+     The arrays hold n registers (bodies padded to a multiple of 16 by the
+     caller with valid bodies, e.g. unit inertia). Registers are split over
+     the worker team (GMS_par_team) above the threshold of the family.
+     atan2 -- SLEEF xatan2f (GMS_sleefsimdsp.cpp, -DENABLE_AVX512F).
+*/
+
+#include <immintrin.h>
+#include <cstdint>
+#include "GMS_config.h"
+
+// Default number of steps between two renormalizations of the quaternions.
+#if !defined(RB6DOF_RENORM_EVERY)
+#define RB6DOF_RENORM_EVERY 16
+#endif
+
+namespace gms {
+
+          namespace math {
+
+                  /*
+                        State of n registers of bodies, updated in place.
+                  */
+                  typedef struct RB6DofState {
+
+                          __m512 * __restrict q0;
+                          __m512 * __restrict q1;
+                          __m512 * __restrict q2;
+                          __m512 * __restrict q3;
+                          __m512 * __restrict wx;
+                          __m512 * __restrict wy;
+                          __m512 * __restrict wz;
+                          __m512 * __restrict pn;
+                          __m512 * __restrict pe;
+                          __m512 * __restrict pd;
+                          __m512 * __restrict vn;
+                          __m512 * __restrict ve;
+                          __m512 * __restrict vd;
+                          int64_t  nstep;          // steps taken (phase of the renormalization)
+                  } RB6DofState;
+
+                  /*
+                        Principal moments of inertia [kg*m^2] and the loads, held
+                        over the steps of a call; nullptr loads are zero.
+                  */
+                  typedef struct RB6DofLoads {
+
+                          const __m512 * __restrict ix;
+                          const __m512 * __restrict iy;
+                          const __m512 * __restrict iz;
+                          const __m512 * __restrict fx;    // specific force, body axes [m/s^2]
+                          const __m512 * __restrict fy;
+                          const __m512 * __restrict fz;
+                          const __m512 * __restrict tx;    // torque, body axes [N*m]
+                          const __m512 * __restrict ty;
+                          const __m512 * __restrict tz;
+                  } RB6DofLoads;
+
+                  typedef struct RB6DofParams {
+
+                          float   dt           = 0.01f;        // [s]
+                          float   g            = 9.80665f;     // [m/s^2], down
+                          int32_t renorm_every = RB6DOF_RENORM_EVERY;
+                  } RB6DofParams;
+
+                  /*
+                        Rotation matrices body-to-NED, n registers per row.
+                  */
+                  typedef struct RB6DofRMat9x16 {
+
+                          __m512 * __restrict row1;
+                          __m512 * __restrict row2;
+                          __m512 * __restrict row3;
+                          __m512 * __restrict row4;
+                          __m512 * __restrict row5;
+                          __m512 * __restrict row6;
+                          __m512 * __restrict row7;
+                          __m512 * __restrict row8;
+                          __m512 * __restrict row9;
+                  } RB6DofRMat9x16;
+
+                  /*
+                        Line of sight from the bodies to the targets (tn,te,td) [m]
+                        NED, n registers, or to the common point tgt[] when tn is
+                        nullptr. nullptr outputs are not computed.
+                  */
+                  typedef struct RB6DofLOS {
+
+                          const __m512 * __restrict tn;
+                          const __m512 * __restrict te;
+                          const __m512 * __restrict td;
+                          float    tgt[3];
+                          __m512 * __restrict ux;          // unit LOS, body axes
+                          __m512 * __restrict uy;
+                          __m512 * __restrict uz;
+                          __m512 * __restrict tht;         // aspect [rad], 0..pi
+                          __m512 * __restrict phi;         // aspect [rad], -pi..pi
+                          __m512 * __restrict az;          // antenna pointing [rad]
+                          __m512 * __restrict el;
+                          __m512 * __restrict rng;         // [m]
+                  } RB6DofLOS;
+
+                  /*
+                        nsteps RK4 steps of the registers [0,n) (s.nstep advanced),
+                        then the outputs of the final state (rmat, los: nullptr --
+                        not computed).
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void rb6dof_propagate_zmm16r4(RB6DofState & s,
+                                                const RB6DofLoads & l,
+                                                const RB6DofParams & p,
+                                                const int32_t nsteps,
+                                                const int32_t n,
+                                                const RB6DofRMat9x16 * rmat,
+                                                const RB6DofLOS * los);
+
+                  /*
+                        The same, serially on the registers [lo,hi) (the body of the
+                        parallel loop, for callers which split the bodies themselves).
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void rb6dof_propagate_range_zmm16r4(const RB6DofState & s,
+                                                      const RB6DofLoads & l,
+                                                      const RB6DofParams & p,
+                                                      const int32_t nsteps,
+                                                      const int32_t lo,
+                                                      const int32_t hi,
+                                                      const RB6DofRMat9x16 * rmat,
+                                                      const RB6DofLOS * los);
+
+                  // Rotation matrices of the current state, registers [0,n).
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void rb6dof_rmat9x16_zmm16r4(const RB6DofState & s,
+                                               const int32_t n,
+                                               const RB6DofRMat9x16 & rmat);
+
+          } // math
+
+} // gms
+
+#endif /*__GMS_RIGID_BODY_6DOF_ZMM16R4_H__*/
@@ -36,7 +36,7 @@ sse_memcpy_unroll8x_ps(float * __restrict__ dst,float * __restrict__ src,std::si
     float * __restrict__ p_dst{dst};
     float * __restrict__ p_src{src};
 
-    while(((uintptr_t)&p_dst & 15) && sz)
+    while(((uintptr_t)p_dst & 15) && sz)
     {
          float t_src{*p_src};
          *p_dst = t_src;
@@ -193,7 +193,7 @@ sse_memcpy_unroll16x_ps(float * __restrict__ dst,float * __restrict__ src,std::s
      float * __restrict__ p_dst{dst};
      float * __restrict__ p_src{src};
 
-     while(((uintptr_t)&p_dst & 15) && sz)
+     while(((uintptr_t)p_dst & 15) && sz)
      {
          float t_src{*p_src};
          *p_dst = t_src;
@@ -593,7 +593,7 @@ sse_memcpy_unroll8x_pd(double * __restrict__ dst,double * __restrict__ src,std::
     double * __restrict__ p_dst{dst};
     double * __restrict__ p_src{src};
 
-    while(((uintptr_t)&p_dst & 15) && sz)
+    while(((uintptr_t)p_dst & 15) && sz)
     {
          double t_src{*p_src};
          *p_dst = t_src;
@@ -750,7 +750,7 @@ sse_memcpy_unroll16x_pd(double * __restrict__ dst,double * __restrict__ src,std:
      double * __restrict__ p_dst{dst};
      double * __restrict__ p_src{src};
 
-     while(((uintptr_t)&p_dst & 15) && sz)
+     while(((uintptr_t)p_dst & 15) && sz)
      {
          double t_src{*p_src};
          *p_dst = t_src;
@@ -36,7 +36,7 @@ sse_uncached_memcpy_unroll8x_ps(float * __restrict__ dst,float * __restrict__ sr
     float * __restrict__ p_dst{dst};
     float * __restrict__ p_src{src};
 
-    while(((uintptr_t)&p_dst & 15) && sz)
+    while(((uintptr_t)p_dst & 15) && sz)
     {
          float t_src{*p_src};
          *p_dst = t_src;
@@ -203,7 +203,7 @@ sse_uncached_memcpy_unroll16x_ps(float * __restrict__ dst,float * __restrict__ s
      float * __restrict__ p_dst{dst};
      float * __restrict__ p_src{src};
 
-     while(((uintptr_t)&p_dst & 15) && sz)
+     while(((uintptr_t)p_dst & 15) && sz)
      {
          float t_src{*p_src};
          *p_dst = t_src;
@@ -617,7 +617,7 @@ sse_uncached_memcpy_unroll8x_pd(double * __restrict__ dst,double * __restrict__
     double * __restrict__ p_dst{dst};
     double * __restrict__ p_src{src};
 
-    while(((uintptr_t)&p_dst & 15) && sz)
+    while(((uintptr_t)p_dst & 15) && sz)
     {
          double t_src{*p_src};
          *p_dst = t_src;
@@ -784,7 +784,7 @@ sse_uncached_memcpy_unroll16x_pd(double * __restrict__ dst,double * __restrict__
      double * __restrict__ p_dst{dst};
      double * __restrict__ p_src{src};
 
-     while(((uintptr_t)&p_dst & 15) && sz)
+     while(((uintptr_t)p_dst & 15) && sz)
      {
          double t_src{*p_src};
          *p_dst = t_src;
@@ -0,0 +1,752 @@
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <immintrin.h>
+#include <algorithm>
+#include <omp.h>
+#include "GMS_transpose_aos_soa_omp.h"
+#include "GMS_memops_dispatch.h"
+#if defined(__AVX512F__)
+#include "GMS_avx512_transposition_16x16.h"
+#elif defined(__AVX__)
+#include "GMS_avx2_transposition_8x8.h"
+#endif
+
+namespace {
+
+#if defined(__AVX512F__)
+
+constexpr std::size_t TILE{16ull};
+
+struct tile_t
+{
+       __m512 r[16];
+
+       inline void load(const float * __restrict a,const std::size_t lda)
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) r[k] = _mm512_loadu_ps(&a[k*lda]);
+       }
+
+       inline void store(float * __restrict b,const std::size_t ldb) const
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) _mm512_storeu_ps(&b[k*ldb],r[k]);
+       }
+
+       inline void store_nt(float * __restrict b,const std::size_t ldb) const
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) _mm512_stream_ps(&b[k*ldb],r[k]);
+       }
+
+       inline void transpose()
+       {
+            gms::math::transpose_zmm16r4_16x16_ip(r[0],r[1],r[2], r[3], r[4], r[5], r[6], r[7],
+                                                  r[8],r[9],r[10],r[11],r[12],r[13],r[14],r[15]);
+       }
+};
+
+#elif defined(__AVX__)
+
+constexpr std::size_t TILE{8ull};
+
+struct tile_t
+{
+       __m256 r[8];
+
+       inline void load(const float * __restrict a,const std::size_t lda)
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) r[k] = _mm256_loadu_ps(&a[k*lda]);
+       }
+
+       inline void store(float * __restrict b,const std::size_t ldb) const
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) _mm256_storeu_ps(&b[k*ldb],r[k]);
+       }
+
+       inline void store_nt(float * __restrict b,const std::size_t ldb) const
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k) _mm256_stream_ps(&b[k*ldb],r[k]);
+       }
+
+       inline void transpose()
+       {
+            gms::math::transpose_ymm8r4_8x8_ip(r[0],r[1],r[2],r[3],r[4],r[5],r[6],r[7]);
+       }
+};
+
+#else
+
+constexpr std::size_t TILE{4ull};
+
+struct tile_t
+{
+       float r[4][4];
+
+       inline void load(const float * __restrict a,const std::size_t lda)
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k)
+                for(std::size_t l{0ull}; l != TILE; ++l) r[k][l] = a[k*lda+l];
+       }
+
+       inline void store(float * __restrict b,const std::size_t ldb) const
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k)
+                for(std::size_t l{0ull}; l != TILE; ++l) b[k*ldb+l] = r[k][l];
+       }
+
+       inline void store_nt(float * __restrict b,const std::size_t ldb) const
+       {
+            store(b,ldb);
+       }
+
+       inline void transpose()
+       {
+            for(std::size_t k{0ull}; k != TILE; ++k)
+                for(std::size_t l{k+1ull}; l != TILE; ++l) std::swap(r[k][l],r[l][k]);
+       }
+};
+
+#endif
+
+// Splits an extent in halves, rounded to a whole number of tiles.
+inline std::size_t split_point(const std::size_t d)
+{
+       return ((d/2ull + TILE - 1ull)/TILE)*TILE;
+}
+
+inline std::size_t tiled_end(const std::size_t lo,const std::size_t hi)
+{
+       return lo + ((hi-lo)/TILE)*TILE;
+}
+
+void transpose_leaf(const float * __restrict A,const std::size_t lda,
+                    float * __restrict B,const std::size_t ldb,
+                    const std::size_t r0,const std::size_t r1,
+                    const std::size_t c0,const std::size_t c1,
+                    const bool nt)
+{
+       const std::size_t rt{tiled_end(r0,r1)};
+       const std::size_t ct{tiled_end(c0,c1)};
+       tile_t t;
+       for(std::size_t r{r0}; r != rt; r += TILE)
+       {
+           for(std::size_t c{c0}; c != ct; c += TILE)
+           {
+               t.load(&A[r*lda+c],lda);
+               t.transpose();
+               if(nt) t.store_nt(&B[c*ldb+r],ldb); else t.store(&B[c*ldb+r],ldb);
+           }
+           for(std::size_t c{ct}; c != c1; ++c)
+               for(std::size_t k{0ull}; k != TILE; ++k) B[c*ldb+r+k] = A[(r+k)*lda+c];
+       }
+       for(std::size_t r{rt}; r != r1; ++r)
+           for(std::size_t c{c0}; c != c1; ++c) B[c*ldb+r] = A[r*lda+c];
+       if(nt) _mm_sfence();
+}
+
+void transpose_rec(const float * __restrict A,const std::size_t lda,
+                   float * __restrict B,const std::size_t ldb,
+                   const std::size_t r0,const std::size_t r1,
+                   const std::size_t c0,const std::size_t c1,
+                   const bool nt)
+{
+       const std::size_t dr{r1-r0};
+       const std::size_t dc{c1-c0};
+       if(dr <= TRANSPOSE_AOS_SOA_LEAF && dc <= TRANSPOSE_AOS_SOA_LEAF)
+       {
+           transpose_leaf(A,lda,B,ldb,r0,r1,c0,c1,nt);
+           return;
+       }
+       const bool spawn{dr*dc > TRANSPOSE_AOS_SOA_TASK_MIN};
+       if(dr >= dc)
+       {
+           const std::size_t rm{r0+split_point(dr)};
+#pragma omp task default(shared) if(spawn)
+           transpose_rec(A,lda,B,ldb,r0,rm,c0,c1,nt);
+           transpose_rec(A,lda,B,ldb,rm,r1,c0,c1,nt);
+       }
+       else
+       {
+           const std::size_t cm{c0+split_point(dc)};
+#pragma omp task default(shared) if(spawn)
+           transpose_rec(A,lda,B,ldb,r0,r1,c0,cm,nt);
+           transpose_rec(A,lda,B,ldb,r0,r1,cm,c1,nt);
+       }
+#pragma omp taskwait
+}
+
+/*
+   Off-diagonal block X = rows [r0,r1) x cols [c0,c1) is exchanged with the
+   transposed mirror block Y = rows [c0,c1) x cols [r0,r1). X,Y are disjoint.
+*/
+void swap_leaf(float * __restrict A,const std::size_t ld,
+               const std::size_t r0,const std::size_t r1,
+               const std::size_t c0,const std::size_t c1)
+{
+       const std::size_t rt{tiled_end(r0,r1)};
+       const std::size_t ct{tiled_end(c0,c1)};
+       tile_t x,y;
+       for(std::size_t r{r0}; r != rt; r += TILE)
+       {
+           for(std::size_t c{c0}; c != ct; c += TILE)
+           {
+               x.load(&A[r*ld+c],ld);
+               y.load(&A[c*ld+r],ld);
+               x.transpose();
+               y.transpose();
+               x.store(&A[c*ld+r],ld);
+               y.store(&A[r*ld+c],ld);
+           }
+       }
+       for(std::size_t r{r0}; r != r1; ++r)
+       {
+           const std::size_t cs{(r < rt) ? ct : c0};
+           for(std::size_t c{cs}; c != c1; ++c) std::swap(A[r*ld+c],A[c*ld+r]);
+       }
+}
+
+void swap_rec(float * __restrict A,const std::size_t ld,
+              const std::size_t r0,const std::size_t r1,
+              const std::size_t c0,const std::size_t c1)
+{
+       const std::size_t dr{r1-r0};
+       const std::size_t dc{c1-c0};
+       if(dr <= TRANSPOSE_AOS_SOA_LEAF && dc <= TRANSPOSE_AOS_SOA_LEAF)
+       {
+           swap_leaf(A,ld,r0,r1,c0,c1);
+           return;
+       }
+       const bool spawn{dr*dc > TRANSPOSE_AOS_SOA_TASK_MIN};
+       if(dr >= dc)
+       {
+           const std::size_t rm{r0+split_point(dr)};
+#pragma omp task default(shared) if(spawn)
+           swap_rec(A,ld,r0,rm,c0,c1);
+           swap_rec(A,ld,rm,r1,c0,c1);
+       }
+       else
+       {
+           const std::size_t cm{c0+split_point(dc)};
+#pragma omp task default(shared) if(spawn)
+           swap_rec(A,ld,r0,r1,c0,cm);
+           swap_rec(A,ld,r0,r1,cm,c1);
+       }
+#pragma omp taskwait
+}
+
+// Diagonal block [d0,d1) x [d0,d1).
+void diag_leaf(float * __restrict A,const std::size_t ld,
+               const std::size_t d0,const std::size_t d1)
+{
+       const std::size_t dt{tiled_end(d0,d1)};
+       tile_t x,y;
+       for(std::size_t r{d0}; r != dt; r += TILE)
+       {
+           x.load(&A[r*ld+r],ld);
+           x.transpose();
+           x.store(&A[r*ld+r],ld);
+           for(std::size_t c{r+TILE}; c != dt; c += TILE)
+           {
+               x.load(&A[r*ld+c],ld);
+               y.load(&A[c*ld+r],ld);
+               x.transpose();
+               y.transpose();
+               x.store(&A[c*ld+r],ld);
+               y.store(&A[r*ld+c],ld);
+           }
+       }
+       for(std::size_t r{d0}; r != d1; ++r)
+       {
+           const std::size_t cs{std::max<std::size_t>(dt,r+1ull)};
+           for(std::size_t c{cs}; c < d1; ++c) std::swap(A[r*ld+c],A[c*ld+r]);
+       }
+}
+
+void transpose_ip_rec(float * __restrict A,const std::size_t ld,
+                      const std::size_t d0,const std::size_t d1)
+{
+       const std::size_t d{d1-d0};
+       if(d <= TRANSPOSE_AOS_SOA_LEAF)
+       {
+           diag_leaf(A,ld,d0,d1);
+           return;
+       }
+       const std::size_t dm{d0+split_point(d)};
+       const bool spawn{d*d > 4ull*TRANSPOSE_AOS_SOA_TASK_MIN};
+#pragma omp task default(shared) if(spawn)
+       transpose_ip_rec(A,ld,d0,dm);
+#pragma omp task default(shared) if(spawn)
+       transpose_ip_rec(A,ld,dm,d1);
+       swap_rec(A,ld,d0,dm,dm,d1);
+#pragma omp taskwait
+}
+
+inline bool run_parallel(const std::size_t nelems)
+{
+       return nelems >= TRANSPOSE_AOS_SOA_OMP_MIN && omp_get_max_threads() > 1 && !omp_in_parallel();
+}
+
+// Output of nbytes is written with non-temporal stores.
+inline bool use_stream(const std::size_t nbytes)
+{
+       return nbytes >= gms::common::memops_tuning().nt_copy_bytes;
+}
+
+// Number of leading elements to process before dst becomes 64-byte aligned.
+inline std::size_t head_to_align(const float * dst,const std::size_t n)
+{
+       const std::size_t mis{reinterpret_cast<uintptr_t>(dst) & 63ull};
+       if(mis & 3ull) return n; // not even float aligned -- all scalar
+       return std::min<std::size_t>(n,((64ull-mis) & 63ull)/sizeof(float));
+}
+
+inline bool same_alignment(const float * a,const float * b)
+{
+       return (reinterpret_cast<uintptr_t>(a) & 63ull) == (reinterpret_cast<uintptr_t>(b) & 63ull);
+}
+
+// Converter blocks are multiples of 16 elements, each thread gets whole blocks.
+constexpr std::size_t CVT_BLOCK{4096ull};
+
+template<typename Body>
+void run_blocks(const std::size_t i0,const std::size_t n,Body body)
+{
+       if(i0 >= n) return;
+       const std::size_t nblk{(n-i0+CVT_BLOCK-1ull)/CVT_BLOCK};
+       if(run_parallel(n-i0))
+       {
+#pragma omp parallel for schedule(static) default(none) shared(body) firstprivate(i0,n,nblk)
+           for(std::size_t b = 0ull; b < nblk; ++b)
+           {
+               const std::size_t lo{i0+b*CVT_BLOCK};
+               body(lo,std::min<std::size_t>(n,lo+CVT_BLOCK));
+           }
+       }
+       else
+       {
+           for(std::size_t b{0ull}; b != nblk; ++b)
+           {
+               const std::size_t lo{i0+b*CVT_BLOCK};
+               body(lo,std::min<std::size_t>(n,lo+CVT_BLOCK));
+           }
+       }
+}
+
+#if defined(__AVX512F__)
+
+inline void store16(float * __restrict p,const __m512 v,const bool nt)
+{
+       if(nt) _mm512_stream_ps(p,v); else _mm512_storeu_ps(p,v);
+}
+
+#endif
+
+void c2split_blk(const float * __restrict z,float * __restrict re,float * __restrict im,
+                 const std::size_t i0,const std::size_t i1,const bool nt)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i ire{_mm512_setr_epi32(0,2,4,6,8,10,12,14,16,18,20,22,24,26,28,30)};
+       const __m512i iim{_mm512_setr_epi32(1,3,5,7,9,11,13,15,17,19,21,23,25,27,29,31)};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           const __m512 a{_mm512_loadu_ps(&z[2ull*i])};
+           const __m512 b{_mm512_loadu_ps(&z[2ull*i+16ull])};
+           store16(&re[i],_mm512_permutex2var_ps(a,ire,b),nt);
+           store16(&im[i],_mm512_permutex2var_ps(a,iim,b),nt);
+       }
+       if(nt) _mm_sfence();
+#elif defined(__AVX2__)
+       (void)nt;
+       for(; i+8ull <= i1; i += 8ull)
+       {
+           const __m256 a{_mm256_loadu_ps(&z[2ull*i])};
+           const __m256 b{_mm256_loadu_ps(&z[2ull*i+8ull])};
+           const __m256 r{_mm256_shuffle_ps(a,b,_MM_SHUFFLE(2,0,2,0))};
+           const __m256 m{_mm256_shuffle_ps(a,b,_MM_SHUFFLE(3,1,3,1))};
+           _mm256_storeu_ps(&re[i],_mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r),_MM_SHUFFLE(3,1,2,0))));
+           _mm256_storeu_ps(&im[i],_mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(m),_MM_SHUFFLE(3,1,2,0))));
+       }
+#else
+       (void)nt;
+#endif
+       for(; i != i1; ++i)
+       {
+           re[i] = z[2ull*i];
+           im[i] = z[2ull*i+1ull];
+       }
+}
+
+void split2c_blk(const float * __restrict re,const float * __restrict im,float * __restrict z,
+                 const std::size_t i0,const std::size_t i1,const bool nt)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i ilo{_mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23)};
+       const __m512i ihi{_mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31)};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           const __m512 r{_mm512_loadu_ps(&re[i])};
+           const __m512 m{_mm512_loadu_ps(&im[i])};
+           store16(&z[2ull*i],       _mm512_permutex2var_ps(r,ilo,m),nt);
+           store16(&z[2ull*i+16ull], _mm512_permutex2var_ps(r,ihi,m),nt);
+       }
+       if(nt) _mm_sfence();
+#elif defined(__AVX__)
+       (void)nt;
+       for(; i+8ull <= i1; i += 8ull)
+       {
+           const __m256 r{_mm256_loadu_ps(&re[i])};
+           const __m256 m{_mm256_loadu_ps(&im[i])};
+           const __m256 lo{_mm256_unpacklo_ps(r,m)};
+           const __m256 hi{_mm256_unpackhi_ps(r,m)};
+           _mm256_storeu_ps(&z[2ull*i],     _mm256_permute2f128_ps(lo,hi,0x20));
+           _mm256_storeu_ps(&z[2ull*i+8ull],_mm256_permute2f128_ps(lo,hi,0x31));
+       }
+#else
+       (void)nt;
+#endif
+       for(; i != i1; ++i)
+       {
+           z[2ull*i]     = re[i];
+           z[2ull*i+1ull] = im[i];
+       }
+}
+
+#if defined(__AVX512F__)
+
+/*
+   Permute tables of the 3-component (de)interleave, 16 records per 3 zmm.
+   aos->soa, component j:  t = permutex2var(a,i1[j],b), v = permutex2var(t,i2[j],c)
+   soa->aos, output r:     t = permutex2var(x,o1[r],y), v = permutex2var(t,o2[r],z)
+*/
+struct xyz_tables_t
+{
+       __ATTR_ALIGN__(64) int32_t i1[3][16];
+       __ATTR_ALIGN__(64) int32_t i2[3][16];
+       __ATTR_ALIGN__(64) int32_t o1[3][16];
+       __ATTR_ALIGN__(64) int32_t o2[3][16];
+
+       xyz_tables_t()
+       {
+            for(int32_t j = 0; j != 3; ++j)
+            {
+                for(int32_t i = 0; i != 16; ++i)
+                {
+                    const int32_t p{3*i+j};
+                    i1[j][i] = (p < 32) ? p : 0;
+                    i2[j][i] = (p < 32) ? i : 16+(p-32);
+                }
+            }
+            for(int32_t r = 0; r != 3; ++r)
+            {
+                for(int32_t e = 0; e != 16; ++e)
+                {
+                    const int32_t q{16*r+e};
+                    const int32_t i{q/3};
+                    const int32_t j{q%3};
+                    o1[r][e] = (j == 0) ? i : ((j == 1) ? 16+i : 0);
+                    o2[r][e] = (j == 2) ? 16+i : e;
+                }
+            }
+       }
+};
+
+const xyz_tables_t xyz_tab;
+
+#endif
+
+void aos3_blk(const float * __restrict aos,float * __restrict x,float * __restrict y,float * __restrict z,
+              const std::size_t i0,const std::size_t i1,const bool nt)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i a1x{_mm512_load_si512(xyz_tab.i1[0])}, a2x{_mm512_load_si512(xyz_tab.i2[0])};
+       const __m512i a1y{_mm512_load_si512(xyz_tab.i1[1])}, a2y{_mm512_load_si512(xyz_tab.i2[1])};
+       const __m512i a1z{_mm512_load_si512(xyz_tab.i1[2])}, a2z{_mm512_load_si512(xyz_tab.i2[2])};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           const float * __restrict p{&aos[3ull*i]};
+           const __m512 a{_mm512_loadu_ps(p)};
+           const __m512 b{_mm512_loadu_ps(p+16ull)};
+           const __m512 c{_mm512_loadu_ps(p+32ull)};
+           store16(&x[i],_mm512_permutex2var_ps(_mm512_permutex2var_ps(a,a1x,b),a2x,c),nt);
+           store16(&y[i],_mm512_permutex2var_ps(_mm512_permutex2var_ps(a,a1y,b),a2y,c),nt);
+           store16(&z[i],_mm512_permutex2var_ps(_mm512_permutex2var_ps(a,a1z,b),a2z,c),nt);
+       }
+       if(nt) _mm_sfence();
+#else
+       (void)nt;
+#endif
+       for(; i != i1; ++i)
+       {
+           x[i] = aos[3ull*i];
+           y[i] = aos[3ull*i+1ull];
+           z[i] = aos[3ull*i+2ull];
+       }
+}
+
+void soa3_blk(const float * __restrict x,const float * __restrict y,const float * __restrict z,float * __restrict aos,
+              const std::size_t i0,const std::size_t i1,const bool nt)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i o10{_mm512_load_si512(xyz_tab.o1[0])}, o20{_mm512_load_si512(xyz_tab.o2[0])};
+       const __m512i o11{_mm512_load_si512(xyz_tab.o1[1])}, o21{_mm512_load_si512(xyz_tab.o2[1])};
+       const __m512i o12{_mm512_load_si512(xyz_tab.o1[2])}, o22{_mm512_load_si512(xyz_tab.o2[2])};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           const __m512 vx{_mm512_loadu_ps(&x[i])};
+           const __m512 vy{_mm512_loadu_ps(&y[i])};
+           const __m512 vz{_mm512_loadu_ps(&z[i])};
+           float * __restrict p{&aos[3ull*i]};
+           store16(p,       _mm512_permutex2var_ps(_mm512_permutex2var_ps(vx,o10,vy),o20,vz),nt);
+           store16(p+16ull, _mm512_permutex2var_ps(_mm512_permutex2var_ps(vx,o11,vy),o21,vz),nt);
+           store16(p+32ull, _mm512_permutex2var_ps(_mm512_permutex2var_ps(vx,o12,vy),o22,vz),nt);
+       }
+       if(nt) _mm_sfence();
+#else
+       (void)nt;
+#endif
+       for(; i != i1; ++i)
+       {
+           aos[3ull*i]       = x[i];
+           aos[3ull*i+1ull]  = y[i];
+           aos[3ull*i+2ull]  = z[i];
+       }
+}
+
+void aosk_blk(const float * __restrict aos,const std::size_t k,float * __restrict * __restrict soa,
+              const std::size_t i0,const std::size_t i1)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i vidx{_mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15),
+                                             _mm512_set1_epi32(static_cast<int32_t>(k)))};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           const float * __restrict p{&aos[k*i]};
+           for(std::size_t c{0ull}; c != k; ++c)
+               _mm512_storeu_ps(&soa[c][i],_mm512_i32gather_ps(vidx,p+c,sizeof(float)));
+       }
+#endif
+       for(; i != i1; ++i)
+           for(std::size_t c{0ull}; c != k; ++c) soa[c][i] = aos[k*i+c];
+}
+
+void soak_blk(const float * __restrict const * __restrict soa,const std::size_t k,float * __restrict aos,
+              const std::size_t i0,const std::size_t i1)
+{
+       std::size_t i{i0};
+#if defined(__AVX512F__)
+       const __m512i vidx{_mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15),
+                                             _mm512_set1_epi32(static_cast<int32_t>(k)))};
+       for(; i+16ull <= i1; i += 16ull)
+       {
+           float * __restrict p{&aos[k*i]};
+           for(std::size_t c{0ull}; c != k; ++c)
+               _mm512_i32scatter_ps(p+c,vidx,_mm512_loadu_ps(&soa[c][i]),sizeof(float));
+       }
+#endif
+       for(; i != i1; ++i)
+           for(std::size_t c{0ull}; c != k; ++c) aos[k*i+c] = soa[c][i];
+}
+
+} // anonymous
+
+
+void gms::math::transpose_r4_omp(const float * __restrict A,
+                                 const std::size_t lda,
+                                 float * __restrict B,
+                                 const std::size_t ldb,
+                                 const std::size_t rows,
+                                 const std::size_t cols)
+{
+       if(__builtin_expect(rows == 0ull || cols == 0ull,0)) return;
+       // whole tile rows of B are cache lines: stream them past the cache when B is large
+       const bool nt{use_stream(rows*cols*sizeof(float)) && ldb%TILE == 0ull &&
+                     (reinterpret_cast<uintptr_t>(B) & (TILE*sizeof(float)-1ull)) == 0ull};
+       if(run_parallel(rows*cols))
+       {
+#pragma omp parallel
+#pragma omp single nowait
+           transpose_rec(A,lda,B,ldb,0ull,rows,0ull,cols,nt);
+       }
+       else
+       {
+           transpose_rec(A,lda,B,ldb,0ull,rows,0ull,cols,nt);
+       }
+}
+
+
+void gms::math::transpose_r4_ip_omp(float * __restrict A,
+                                    const std::size_t ld,
+                                    const std::size_t n)
+{
+       if(__builtin_expect(n < 2ull,0)) return;
+       if(run_parallel(n*n))
+       {
+#pragma omp parallel
+#pragma omp single nowait
+           transpose_ip_rec(A,ld,0ull,n);
+       }
+       else
+       {
+           transpose_ip_rec(A,ld,0ull,n);
+       }
+}
+
+
+void gms::math::transpose_r4_ip_rect_omp(float * __restrict A,
+                                         const std::size_t rows,
+                                         const std::size_t cols)
+{
+       using namespace gms::common;
+       if(rows == cols)
+       {
+           transpose_r4_ip_omp(A,cols,rows);
+           return;
+       }
+       if(rows == 1ull || cols == 1ull) return; // a vector is its own transpose when packed
+       const std::size_t n{rows*cols};
+       float * __restrict tmp{reinterpret_cast<float*>(_mm_malloc(n*sizeof(float),64ULL))};
+       transpose_r4_omp(A,cols,tmp,rows,rows,cols);
+       memcpy_dispatch_ps(A,tmp,n);
+       _mm_free(tmp);
+}
+
+
+void gms::math::cinterleaved_to_split_r4_omp(const std::complex<float> * __restrict z,
+                                             float * __restrict re,
+                                             float * __restrict im,
+                                             const std::size_t n)
+{
+       const float * __restrict zf{reinterpret_cast<const float*>(z)};
+       const bool nt{use_stream(2ull*sizeof(float)*n) && same_alignment(re,im)};
+       const std::size_t h{nt ? head_to_align(re,n) : 0ull};
+       c2split_blk(zf,re,im,0ull,h,false);
+       run_blocks(h,n,[=](const std::size_t lo,const std::size_t hi) {
+                              c2split_blk(zf,re,im,lo,hi,nt);});
+}
+
+
+void gms::math::csplit_to_interleaved_r4_omp(const float * __restrict re,
+                                             const float * __restrict im,
+                                             std::complex<float> * __restrict z,
+                                             const std::size_t n)
+{
+       float * __restrict zf{reinterpret_cast<float*>(z)};
+       // z advances by 2 floats per element, an 8-byte aligned head exists only for 8-byte aligned z
+       const bool nt{use_stream(2ull*sizeof(float)*n) && !(reinterpret_cast<uintptr_t>(zf) & 7ull)};
+       const std::size_t h{nt ? head_to_align(zf,2ull*n)/2ull : 0ull};
+       split2c_blk(re,im,zf,0ull,h,false);
+       run_blocks(h,n,[=](const std::size_t lo,const std::size_t hi) {
+                              split2c_blk(re,im,zf,lo,hi,nt);});
+}
+
+
+void gms::math::aos3_to_soa_r4_omp(const float * __restrict aos,
+                                   float * __restrict x,
+                                   float * __restrict y,
+                                   float * __restrict z,
+                                   const std::size_t n)
+{
+       const bool nt{use_stream(3ull*sizeof(float)*n) && same_alignment(x,y) && same_alignment(x,z)};
+       const std::size_t h{nt ? head_to_align(x,n) : 0ull};
+       aos3_blk(aos,x,y,z,0ull,h,false);
+       run_blocks(h,n,[=](const std::size_t lo,const std::size_t hi) {
+                              aos3_blk(aos,x,y,z,lo,hi,nt);});
+}
+
+
+void gms::math::soa3_to_aos_r4_omp(const float * __restrict x,
+                                   const float * __restrict y,
+                                   const float * __restrict z,
+                                   float * __restrict aos,
+                                   const std::size_t n)
+{
+       // 16 records are 192 bytes, a 64-byte aligned record block exists when aos is float aligned
+       std::size_t h{0ull};
+       bool nt{use_stream(3ull*sizeof(float)*n)};
+       if(nt)
+       {
+           const std::size_t mis{reinterpret_cast<uintptr_t>(aos) & 63ull};
+           nt = !(mis & 3ull);
+           if(nt)
+           {
+               // smallest h with (aos + 3h floats) 64-byte aligned, h < 16
+               while(h < 16ull && ((mis + 12ull*h) & 63ull)) ++h;
+               h = std::min<std::size_t>(h,n);
+           }
+       }
+       soa3_blk(x,y,z,aos,0ull,h,false);
+       run_blocks(h,n,[=](const std::size_t lo,const std::size_t hi) {
+                              soa3_blk(x,y,z,aos,lo,hi,nt);});
+}
+
+
+void gms::math::aos_to_soa_r4_omp(const float * __restrict aos,
+                                  const std::size_t ncomp,
+                                  float * __restrict * __restrict soa,
+                                  const std::size_t n)
+{
+       using namespace gms::common;
+       switch(ncomp)
+       {
+            case 0ull :
+                 return;
+            case 1ull :
+                 memcpy_dispatch_ps(soa[0],aos,n);
+                 return;
+            case 2ull :
+                 cinterleaved_to_split_r4_omp(reinterpret_cast<const std::complex<float>*>(aos),soa[0],soa[1],n);
+                 return;
+            case 3ull :
+                 aos3_to_soa_r4_omp(aos,soa[0],soa[1],soa[2],n);
+                 return;
+            default :
+                 run_blocks(0ull,n,[=](const std::size_t lo,const std::size_t hi) {
+                                         aosk_blk(aos,ncomp,soa,lo,hi);});
+       }
+}
+
+
+void gms::math::soa_to_aos_r4_omp(const float * __restrict const * __restrict soa,
+                                  const std::size_t ncomp,
+                                  float * __restrict aos,
+                                  const std::size_t n)
+{
+       using namespace gms::common;
+       switch(ncomp)
+       {
+            case 0ull :
+                 return;
+            case 1ull :
+                 memcpy_dispatch_ps(aos,soa[0],n);
+                 return;
+            case 2ull :
+                 csplit_to_interleaved_r4_omp(soa[0],soa[1],reinterpret_cast<std::complex<float>*>(aos),n);
+                 return;
+            case 3ull :
+                 soa3_to_aos_r4_omp(soa[0],soa[1],soa[2],aos,n);
+                 return;
+            default :
+                 run_blocks(0ull,n,[=](const std::size_t lo,const std::size_t hi) {
+                                         soak_blk(soa,ncomp,aos,lo,hi);});
+       }
+}
@@ -0,0 +1,168 @@
+#ifndef __GMS_TRANSPOSE_AOS_SOA_OMP_H__
+#define __GMS_TRANSPOSE_AOS_SOA_OMP_H__ 191020261130
+
+/*MIT License
+Copyright (c) 2020 Bernard Gingold
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+namespace file_info
+{
+
+    const unsigned int GMS_TRANSPOSE_AOS_SOA_OMP_MAJOR = 1;
+
+    const unsigned int GMS_TRANSPOSE_AOS_SOA_OMP_MINOR = 0;
+
+    const unsigned int GMS_TRANSPOSE_AOS_SOA_OMP_MICRO = 0;
+
+    const unsigned int GMS_TRANSPOSE_AOS_SOA_OMP_FULLVER =
+        1000U*GMS_TRANSPOSE_AOS_SOA_OMP_MAJOR+100U*GMS_TRANSPOSE_AOS_SOA_OMP_MINOR+10U*GMS_TRANSPOSE_AOS_SOA_OMP_MICRO;
+
+    const char * const GMS_TRANSPOSE_AOS_SOA_OMP_DATE = "19-10-2026 11:30 +00200 (MON 19 OCT 2026 GMT+2)";
+
+    const char * const GMS_TRANSPOSE_AOS_SOA_OMP_BUILD_DATE = __DATE__ " " __TIME__;
+
+    const char * const GMS_TRANSPOSE_AOS_SOA_OMP_AUTHOR = "Programmer: Bernard Gingold, contact: beniekg@gmail.com";
+
+    const char * const GMS_TRANSPOSE_AOS_SOA_OMP_DESCRIPT = "Arbitrary size cache-oblivious transposition and AoS<->SoA conversion (OpenMP).";
+
+}
+
+/*
+        Arbitrary size (row-major) single precision transposition, built
+        recursively (cache-oblivious) on the 16x16 (AVX512) or 8x8 (AVX)
+        register tiles and parallelized by OpenMP tasks.
+        The layout converters (interleaved complex <-> split re/im,
+        xyz records <-> x,y,z arrays, k-component records <-> k arrays)
+        are streaming kernels: lane permutes only, non-temporal stores for
+        outputs beyond the calibrated streaming threshold of GMS_memops_dispatch.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <complex>
+#include "GMS_config.h"
+
+// Recursion leaf: sub-blocks of at most LEAF x LEAF elements are transposed by tiles.
+#if !defined(TRANSPOSE_AOS_SOA_LEAF)
+#define TRANSPOSE_AOS_SOA_LEAF 64ull
+#endif
+
+// Sub-blocks larger than this (in elements) are spawned as OpenMP tasks.
+#if !defined(TRANSPOSE_AOS_SOA_TASK_MIN)
+#define TRANSPOSE_AOS_SOA_TASK_MIN 65536ull
+#endif
+
+// Problems smaller than this (in elements) run serially.
+#if !defined(TRANSPOSE_AOS_SOA_OMP_MIN)
+#define TRANSPOSE_AOS_SOA_OMP_MIN 262144ull
+#endif
+
+namespace gms {
+
+namespace math {
+
+                  /*
+                        Out-of-place: B[j*ldb+i] = A[i*lda+j], i < rows, j < cols.
+                        A and B must not overlap.
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void transpose_r4_omp(const float * __restrict A,
+                                        const std::size_t lda,
+                                        float * __restrict B,
+                                        const std::size_t ldb,
+                                        const std::size_t rows,
+                                        const std::size_t cols);
+
+                  /*
+                        In-place, square n x n matrix of leading dimension ld.
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void transpose_r4_ip_omp(float * __restrict A,
+                                           const std::size_t ld,
+                                           const std::size_t n);
+
+                  /*
+                        In-place, densely packed rows x cols matrix, becomes cols x rows.
+                        Non-square shapes are transposed through a scratch buffer of
+                        rows*cols elements.
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void transpose_r4_ip_rect_omp(float * __restrict A,
+                                                const std::size_t rows,
+                                                const std::size_t cols);
+
+                  // std::complex<float>[n] -> re[n],im[n]
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void cinterleaved_to_split_r4_omp(const std::complex<float> * __restrict z,
+                                                    float * __restrict re,
+                                                    float * __restrict im,
+                                                    const std::size_t n);
+
+                  // re[n],im[n] -> std::complex<float>[n]
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void csplit_to_interleaved_r4_omp(const float * __restrict re,
+                                                    const float * __restrict im,
+                                                    std::complex<float> * __restrict z,
+                                                    const std::size_t n);
+
+                  // {x,y,z}[n] -> x[n],y[n],z[n]
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void aos3_to_soa_r4_omp(const float * __restrict aos,
+                                          float * __restrict x,
+                                          float * __restrict y,
+                                          float * __restrict z,
+                                          const std::size_t n);
+
+                  // x[n],y[n],z[n] -> {x,y,z}[n]
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void soa3_to_aos_r4_omp(const float * __restrict x,
+                                          const float * __restrict y,
+                                          const float * __restrict z,
+                                          float * __restrict aos,
+                                          const std::size_t n);
+
+                  /*
+                        Records of ncomp floats -> ncomp arrays (soa[c][i] = aos[i*ncomp+c]).
+                        ncomp of 2 and 3 are forwarded to the specialized kernels.
+                  */
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void aos_to_soa_r4_omp(const float * __restrict aos,
+                                         const std::size_t ncomp,
+                                         float * __restrict * __restrict soa,
+                                         const std::size_t n);
+
+                  __ATTR_HOT__
+                  __ATTR_ALIGN__(32)
+                  void soa_to_aos_r4_omp(const float * __restrict const * __restrict soa,
+                                         const std::size_t ncomp,
+                                         float * __restrict aos,
+                                         const std::size_t n);
+
+} // math
+
+} // gms
+
+#endif /*__GMS_TRANSPOSE_AOS_SOA_OMP_H__*/
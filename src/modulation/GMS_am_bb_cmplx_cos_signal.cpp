@@ -2,7 +2,7 @@
 #include <iomanip>
 #include <random>
 #include "GMS_am_bb_cmplx_cos_signal.h"
-#include "GMS_sse_memset.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_indices.h"
 
 gms::radiolocation
@@ -67,7 +67,7 @@ gms::radiolocation
 {
 #if (INIT_BY_STD_FILL) == 0
      using namespace gms::common;
-	 sse_memset_unroll8x_ps(reinterpret_cast<float*>(this->m_sig_samples.m_data),filler,2ull*this->m_nsamples);
+	 memset_dispatch_ps(reinterpret_cast<float*>(this->m_sig_samples.m_data),filler,2ull*this->m_nsamples);
 #else 
      std::fill(this->m_sig_samples.m_data,this->m_sig_samples.m_data+this->m_nsamples,filler);
 #endif
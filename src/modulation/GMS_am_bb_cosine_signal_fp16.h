@@ -39,8 +39,10 @@ namespace file_info
 #include <cstdint>
 #include <string>
 #include <iostream>
+#include <algorithm>
 #include "GMS_config.h"
 #include "GMS_dyn_array.h"
+#include "GMS_fp16_bulk.h"
 
 // Enable non-temporal stores for this class only( used with free-standing operators)
 // defaulted to 0.
@@ -60,6 +62,12 @@ namespace file_info
 #define INIT_BY_STD_FILL 0
 #endif 
 
+// Number of samples computed in fp32 and converted (in bulk) to the fp16 storage
+// at once, shall be a multiple of 16.
+#if !defined(AM_BB_COSINE_SIGNAL_FP16_TILE)
+#define AM_BB_COSINE_SIGNAL_FP16_TILE 512
+#endif
+
 // For inlining of trigo functions (asin,acos,sin,cos)
 #if !defined(AM_BB_COSINE_SIGNAL_FP16_USE_CEPHES)
 #define AM_BB_COSINE_SIGNAL_FP16_USE_CEPHES 1
@@ -196,7 +204,7 @@ namespace radiolocation
                           constexpr float C628318530717958647692528676656{6.28318530717958647692528676656f};
                           const float arg{this->m_n*C628318530717958647692528676656*t*invT};
                           float cos_val{};
-#if (AM_BB_COSINE_SIGNAL_USE_CEPHES) == 1
+#if (AM_BB_COSINE_SIGNAL_FP16_USE_CEPHES) == 1
                           cos_val = 0.5f*this->m_A*(1.0f-ceph_cosf(arg));
                           return (cos_val);
 #else                     
@@ -222,23 +230,28 @@ namespace radiolocation
                      template<class Functor>
                      std::int32_t create_signal_rand_data(Functor & f)
                      {
-                             using namespace half_float;
+                             using namespace gms::common;
                              const float T{static_cast<float>(this->m_nsamples)};
                              const float invT{this->m_P/T};
-                             float sum;
-                             for(std::size_t __t{0ull}; __t != this->m_nsamples; ++__t) 
+                             alignas(64) float tile[AM_BB_COSINE_SIGNAL_FP16_TILE];
+                             for(std::size_t __b{0ull}; __b < this->m_nsamples; __b += AM_BB_COSINE_SIGNAL_FP16_TILE)
                              {
-                                 const float t{static_cast<float>(__t)};
-                                 sum = 0.0f;
-                                 for(std::uint32_t __k{0}; __k != this->m_nK; ++__k) 
+                                 const std::size_t nb{std::min<std::size_t>(AM_BB_COSINE_SIGNAL_FP16_TILE,this->m_nsamples-__b)};
+                                 for(std::size_t __i{0ull}; __i != nb; ++__i) 
                                  {
-                                     const float k{static_cast<float>(__k)};
-                                     const float arg{t-k*T};
-                                     sum += cos_sample(arg,invT)*f();
+                                     const float t{static_cast<float>(__b+__i)};
+                                     float sum{0.0f};
+                                     for(std::uint32_t __k{0}; __k != this->m_nK; ++__k) 
+                                     {
+                                         const float k{static_cast<float>(__k)};
+                                         const float arg{t-k*T};
+                                         sum += cos_sample(arg,invT)*f();
+                                     }
+                                     tile[__i] = sum;
                                  }
-                                 this->m_sig_samples.m_data[__t] = half_cast<half>(sum);
-                              }
-                              return (0);
+                                 cvt_f32_f16(&tile[0],&this->m_sig_samples.m_data[__b],nb);
+                             }
+                             return (0);
                      }
 
                    
@@ -1,7 +1,7 @@
 #include <fstream>
 #include <iomanip>
 #include "GMS_am_bb_sine_signal.h"
-#include "GMS_sse_memset.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_indices.h"
 
 gms::radiolocation
@@ -66,7 +66,7 @@ gms::radiolocation
 {
 #if (INIT_BY_STD_FILL) == 0
      using namespace gms::common;
-	 sse_memset_unroll8x_ps(&this->m_sig_samples.m_data[0],filler,this->m_nsamples);
+	 memset_dispatch_ps(&this->m_sig_samples.m_data[0],filler,this->m_nsamples);
 #else 
      std::fill(this->m_sig_samples.m_data,this->m_sig_samples.m_data+this->m_nsamples,filler);
 #endif
@@ -1,7 +1,6 @@
 #include <fstream>
 #include <iomanip>
 #include "GMS_am_bb_sine_signal_fp16.h"
-#include "GMS_sse_memset.h"
 #include "GMS_indices.h"
 
 gms::radiolocation
@@ -79,8 +78,7 @@ gms::radiolocation
 ::init_storage(const half_float::half filler)
 {
 #if (INIT_BY_STD_FILL) == 0
-     using namespace gms::common;
-	 sse_memset_unroll8x_ps(reinterpret_cast<float*>(this->m_sig_samples.m_data),static_cast<float>(filler),this->m_nsamples);
+     this->m_sig_samples.fill(filler);
 #else 
      std::fill(this->m_sig_samples.m_data,this->m_sig_samples.m_data+this->m_nsamples,filler);
 #endif
@@ -154,23 +152,29 @@ gms::radiolocation
                           const std::uint32_t n_T,
                           const std::uint32_t n_K)
 {
-      using namespace half_float;
+      using namespace gms::common;
       if(__builtin_expect(static_cast<std::uint32_t>(this->m_nsamples)!=n_T,0) || 
          __builtin_expect(this->m_nK!=n_K,0)) { return (-1);}
        const float T{static_cast<float>(this->m_nsamples)};
        const float invT{this->m_P/T};
-       float sum;
-       for(std::uint32_t __t{0}; __t != n_T; ++__t) 
+       alignas(64) float tile[AM_BB_SINE_SIGNAL_FP16_TILE];
+       for(std::uint32_t __b{0}; __b < n_T; __b += AM_BB_SINE_SIGNAL_FP16_TILE)
        {
-            const float t{static_cast<float>(__t)};
-            sum = 0.0f;
-            for(std::uint32_t __k{0}; __k != n_K; ++__k) 
+            const std::uint32_t nb{std::min<std::uint32_t>(AM_BB_SINE_SIGNAL_FP16_TILE,n_T-__b)};
+            for(std::uint32_t __i{0}; __i != nb; ++__i) 
             {
-                 const float k{static_cast<float>(__k)};
-                 const float arg{t-k*T};
-                 sum += sin_sample(arg,invT)*sym_in[Ix2D(__t,n_K,__k)];
+                 const std::uint32_t __t{__b+__i};
+                 const float t{static_cast<float>(__t)};
+                 float sum{0.0f};
+                 for(std::uint32_t __k{0}; __k != n_K; ++__k) 
+                 {
+                      const float k{static_cast<float>(__k)};
+                      const float arg{t-k*T};
+                      sum += sin_sample(arg,invT)*sym_in[Ix2D(__t,n_K,__k)];
+                 }
+                 tile[__i] = sum;
             }
-            this->m_sig_samples.m_data[__t] = half_cast<half>(sum);
+            cvt_f32_f16(&tile[0],&this->m_sig_samples.m_data[__b],nb);
         }
         return (0);
 }
@@ -182,73 +186,61 @@ gms::radiolocation
                               const std::uint32_t n_T,
                               const std::uint32_t n_K)
 {
-      using namespace half_float;
+      using namespace gms::common;
       if(__builtin_expect(static_cast<std::uint32_t>(this->m_nsamples)!=n_T,0) || 
          __builtin_expect(this->m_nK!=n_K,0)) { return (-1);}
         const float T{static_cast<float>(this->m_nsamples)};
         const float invT{this->m_P/T};
+        alignas(64) float tile[AM_BB_SINE_SIGNAL_FP16_TILE];
         float sum0;
         float sum1;
         float sum2;
         float sum3;
-        float t__i_0{-4.0f};
-        float t__i_1{1.0f};
-        float t__i_2{2.0f};
-        float t__i_3{3.0f};
-        std::uint32_t __i;
-        std::uint32_t __j;
-        for(__i = 0; __i != ROUND_TO_FOUR(n_T,4); __i += 4u)
+        for(std::uint32_t __b{0}; __b < n_T; __b += AM_BB_SINE_SIGNAL_FP16_TILE)
         {
-            t__i_0 += 4.0f;
-            sum0    = 0.0f;
-            for(std::uint32_t __k{0}; __k != n_K; ++__k) 
+            const std::uint32_t nb{std::min<std::uint32_t>(AM_BB_SINE_SIGNAL_FP16_TILE,n_T-__b)};
+            std::uint32_t __i;
+            std::uint32_t __j;
+            for(__i = 0; __i != ROUND_TO_FOUR(nb,4); __i += 4u)
             {
-                const float k{static_cast<float>(__k)};
-                const float arg{t__i_0-k*T};
-                sum0 += sin_sample(arg,invT)*sym_in[Ix2D(__i+0,n_K,__k)];
-            }
-            this->m_sig_samples.m_data[__i+0] = half_cast<half>(sum0);
-            t__i_1 += 4.0f;
-            sum1    = 0.0f;
-            for(std::uint32_t __k{0}; __k != n_K; ++__k) 
-            {
-                const float k{static_cast<float>(__k)};
-                const float arg{t__i_1-k*T};
-                sum1 += sin_sample(arg,invT)*sym_in[Ix2D(__i+1,n_K,__k)];
-            }
-            this->m_sig_samples.m_data[__i+1] = half_cast<half>(sum1);
-            t__i_2  += 4.0f;
-            sum2     = 0.0f;
-            for(std::uint32_t __k{0}; __k != n_K; ++__k) 
-            {
-                const float k{static_cast<float>(__k)};
-                const float arg{t__i_2-k*T};
-                sum2 += sin_sample(arg,invT)*sym_in[Ix2D(__i+2,n_K,__k)];
-            }
-            this->m_sig_samples.m_data[__i+2] = half_cast<half>(sum2);
-            t__i_3  += 4.0f;
-            sum3     = 0.0f;
-            for(std::uint32_t __k{0}; __k != n_K; ++__k) 
-            {
-                const float k{static_cast<float>(__k)};
-                const float arg{t__i_3-k*T};
-                sum3 += sin_sample(arg,invT)*sym_in[Ix2D(__i+3,n_K,__k)];
-            }
-            this->m_sig_samples.m_data[__i+3] = half_cast<half>(sum3);
+                const std::uint32_t __t{__b+__i};
+                const float t__i_0{static_cast<float>(__t+0u)};
+                const float t__i_1{static_cast<float>(__t+1u)};
+                const float t__i_2{static_cast<float>(__t+2u)};
+                const float t__i_3{static_cast<float>(__t+3u)};
+                sum0 = 0.0f;
+                sum1 = 0.0f;
+                sum2 = 0.0f;
+                sum3 = 0.0f;
+                for(std::uint32_t __k{0}; __k != n_K; ++__k) 
+                {
+                    const float k{static_cast<float>(__k)};
+                    sum0 += sin_sample(t__i_0-k*T,invT)*sym_in[Ix2D((__t+0u),n_K,__k)];
+                    sum1 += sin_sample(t__i_1-k*T,invT)*sym_in[Ix2D((__t+1u),n_K,__k)];
+                    sum2 += sin_sample(t__i_2-k*T,invT)*sym_in[Ix2D((__t+2u),n_K,__k)];
+                    sum3 += sin_sample(t__i_3-k*T,invT)*sym_in[Ix2D((__t+3u),n_K,__k)];
+                }
+                tile[__i+0] = sum0;
+                tile[__i+1] = sum1;
+                tile[__i+2] = sum2;
+                tile[__i+3] = sum3;
             }
-            for(__j = __i; __j != n_T; ++__j) 
+            for(__j = __i; __j != nb; ++__j) 
             {
-                const float t{static_cast<float>(__j)};
+                const std::uint32_t __t{__b+__j};
+                const float t{static_cast<float>(__t)};
                 sum0 = 0.0f;
                 for(std::uint32_t __k{0}; __k != n_K; ++__k) 
                 {
                     const float k{static_cast<float>(__k)};
                     const float arg{t-k*T};
-                    sum0 += sin_sample(arg,invT)*sym_in[Ix2D(__j,n_K,__k)];
+                    sum0 += sin_sample(arg,invT)*sym_in[Ix2D(__t,n_K,__k)];
                 }
-                this->m_sig_samples.m_data[__j] = half_cast<half>(sum0);
+                tile[__j] = sum0;
             }
-            return (0);
+            cvt_f32_f16(&tile[0],&this->m_sig_samples.m_data[__b],nb);
+        }
+        return (0);
 }
 
 auto
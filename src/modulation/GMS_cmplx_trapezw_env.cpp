@@ -2,7 +2,7 @@
 #include <fstream>
 #include <iomanip>
 #include "GMS_cmplx_trapezw_env.h"
-#include "GMS_sse_memset.h"
+#include "GMS_memops_dispatch.h"
 #include "GMS_indices.h"
 
 
@@ -100,8 +100,8 @@ gms::radiolocation
 {
 #if (INIT_BY_STD_FILL) == 0
      using namespace gms::common;
-	 sse_memset_unroll8x_ps(&this->__I_chan__.m_data[0],I_filler,this->__I_n_samples__);
-     sse_memset_unroll8x_ps(&this->__Q_chan__.m_data[0],Q_filler,this->__Q_n_samples__);
+	 memset_dispatch_ps(&this->__I_chan__.m_data[0],I_filler,this->__I_n_samples__);
+     memset_dispatch_ps(&this->__Q_chan__.m_data[0],Q_filler,this->__Q_n_samples__);
 #else 
      std::fill(this->__I_chan__.m_data,this->__I_chan__.m_data+this->__I_n_samples__,I_filler);
      std::fill(this->__Q_chan__.m_data,this->__Q_chan__.m_data+this->__Q_n_samples__,Q_filler);
@@ -1,6 +1,6 @@
 #include <fstream>
 #include "GMS_rectangular_waveform.h"
-#include "GMS_sse_memset.h"
+#include "GMS_memops_dispatch.h"
 #if (RECTANGULAR_WAVEFORM_USE_CEPHES) == 0
 #include <cmath>
 #endif 
@@ -271,7 +271,7 @@ gms::radiolocation
 {
 #if (INIT_BY_STD_FILL) == 0
      using namespace gms::common;
-	 sse_memset_unroll8x_ps(&this->__rw_samples__.m_data[0],filler,this->__n_samples__);
+	 memset_dispatch_ps(&this->__rw_samples__.m_data[0],filler,this->__n_samples__);
 #else 
      std::fill(this->__rw_samples__.m_data,this->__rw_samples__+this->__n_samples__,filler);
 #endif 
@@ -2,7 +2,7 @@
 #include <fstream>
 #include <iomanip>
 #include "GMS_square_waveform.h"
-#include "GMS_sse_memset.h"
+#include "GMS_memops_dispatch.h"
 #if (SQUARE_WAVEFORM_USE_CEPHES) == 0
 #include <cmath>
 #endif
@@ -181,7 +181,7 @@ gms::radiolocation
 {
 #if (INIT_BY_STD_FILL) == 0
      using namespace gms::common;
-	 sse_memset_unroll8x_ps(&this->__sw_samples__.m_data[0],filler,this->__n_samples__);
+	 memset_dispatch_ps(&this->__sw_samples__.m_data[0],filler,this->__n_samples__);
 #else 
      std::fill(this->__sw_samples__.m_data,this->__sw_samples__.m_data+this->__n_samples__,filler);
 #endif